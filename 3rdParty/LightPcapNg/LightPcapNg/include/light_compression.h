@@ -65,6 +65,11 @@ size_t light_write_compressed(struct light_file_t *fd, const void *buf, size_t c
 //Called when the file being read/written is to be closed - this is called first!
 int light_close_compressed(struct light_file_t *fd);
 
+// PCPP patch: compress with worker_count threads (0 compresses on the writing thread) and split the data into
+// independent frames of frame_size uncompressed bytes (0 writes a single frame). Must be called before the first
+// write. Returns 0 on success or -1 if the file isn't compressed or the compression library doesn't support it
+int light_configure_compression(struct light_file_t *fd, int worker_count, size_t frame_size);
+
 #ifdef __cplusplus
 }
 #endif
@@ -40,6 +40,7 @@ extern int(*is_compressed_file)(const char*);
 extern size_t(*read_compressed)(struct light_file_t *, void *, size_t);
 extern size_t(*write_compressed)(struct light_file_t *, const void *, size_t);
 extern int(*close_compressed)(struct light_file_t *);
+extern int(*configure_compression)(struct light_file_t *, int, size_t);  // PCPP patch
 
 #ifdef __cplusplus
 }
@@ -81,6 +81,21 @@ light_pcapng_t *light_pcapng_open_read(const char* file_path, light_boolean read
 //Set compression level to 0 to disable compression!
 light_pcapng_t *light_pcapng_open_write(const char* file_path, light_pcapng_file_info *file_info, int compression_level);
 
+// PCPP patch
+typedef struct _light_compression_options {
+	// 0 to 10, 0 disables compression
+	int compression_level;
+	// the number of threads compressing in the background, 0 compresses on the writing thread
+	int worker_count;
+	// split the data into independent frames of this uncompressed size and end the file with a seek table in the zstd
+	// seekable format. 0 writes a single frame
+	size_t frame_size;
+} light_compression_options;
+
+// PCPP patch: if the compression library doesn't support worker threads the file is compressed on the writing thread
+light_pcapng_t *light_pcapng_open_write_with_options(const char* file_path, light_pcapng_file_info *file_info, const light_compression_options *options);
+// PCPP patch end
+
 light_pcapng_t *light_pcapng_open_append(const char* file_path);
 
 light_pcapng_file_info *light_create_default_file_info();
@@ -93,6 +108,12 @@ light_pcapng_file_info *light_pcang_get_file_info(light_pcapng_t *pcapng);
 
 int light_get_next_packet(light_pcapng_t *pcapng, light_packet_header *packet_header, const uint8_t **packet_data);
 
+// PCPP patch: read the next packet without building a block, by walking the blocks in place in a read-ahead buffer.
+// packet_data and the comment point into that buffer and stay valid until the next call or light_pcapng_close().
+// The comment is only looked up if read_comment is LIGHT_TRUE. Don't mix with light_get_next_packet() on the same file
+int light_get_next_packet_in_place(light_pcapng_t *pcapng, light_packet_header *packet_header, const uint8_t **packet_data, light_boolean read_comment);
+
+// PCPP patch: packets are buffered in memory and reach the file on light_pcapng_flush() or light_pcapng_close()
 void light_write_packet(light_pcapng_t *pcapng, const light_packet_header *packet_header, const uint8_t *packet_data);
 
 void light_pcapng_close(light_pcapng_t *pcapng);
@@ -52,6 +52,9 @@ typedef long light_file_pos_t;
 light_file light_open(const char *file_name, const __read_mode_t mode);
 light_file light_open_compression(const char *file_name, const __read_mode_t mode, int compression_level);
 size_t light_read(light_file fd, void *buf, size_t count);
+// PCPP patch: read at least min_count and at most max_count bytes. Returns the byte count, or -1 if fewer than
+// min_count bytes are left
+size_t light_read_up_to(light_file fd, void *buf, size_t min_count, size_t max_count);
 size_t light_write(light_file fd, const void *buf, size_t count);
 size_t light_size(light_file fd);
 int light_close(light_file fd);
@@ -25,8 +25,13 @@
 #define INCLUDE_LIGHT_ZSTD_COMPRESSION_H_
 #if defined(USE_Z_STD)
 
+#include <stddef.h>
 #include <stdint.h>
 #include <zstd.h>      // presumes zstd library is installed
+#if !defined(_WIN32)
+#include <pthread.h>
+#define LIGHT_ZSTD_READ_AHEAD
+#endif
 
 
 //An ethernet packet should only ever be up to 1500 bytes + some header crap
@@ -45,8 +50,31 @@ struct zstd_compression_t
 	size_t buffer_out_max_size;
 	int compression_level;
 	ZSTD_CCtx* cctx;
+	// PCPP patch
+	// when frame_size isn't 0 the data is split into independent frames of that uncompressed size, and a seek table
+	// in the zstd seekable format (a skippable frame) is written at the end of the file
+	size_t frame_size;
+	size_t frame_uncompressed_size;
+	size_t frame_compressed_size;
+	uint32_t* seek_table;
+	size_t seek_table_count;
+	size_t seek_table_capacity;
+	// PCPP patch end
 };
 
+// PCPP patch
+#define LIGHT_ZSTD_READ_AHEAD_CHUNK_COUNT 4
+#define LIGHT_ZSTD_READ_AHEAD_CHUNK_SIZE (256 * 1024)
+
+// a chunk of decompressed data, filled by the read-ahead thread and consumed by the reading thread
+struct zstd_read_ahead_chunk
+{
+	uint8_t* data;
+	size_t size;
+	int ready;
+};
+// PCPP patch end
+
 struct zstd_decompression_t
 {
 	uint32_t* buffer_in;
@@ -54,9 +82,25 @@ struct zstd_decompression_t
 	size_t buffer_in_max_size;
 	size_t buffer_out_max_size;
 	ZSTD_DCtx* dctx;
-	int outputReady;
 	ZSTD_outBuffer output;
 	ZSTD_inBuffer input;
+	// PCPP patch
+#ifdef LIGHT_ZSTD_READ_AHEAD
+	// once the first read starts the read-ahead thread, only that thread reads the file and decompresses
+	// 0 until the first read, 1 if the thread is running and -1 if reads are synchronous (the thread couldn't be
+	// started or there's a single CPU, where it would only add overhead)
+	int read_ahead_started;
+	pthread_t read_ahead_thread;
+	pthread_mutex_t read_ahead_lock;
+	pthread_cond_t read_ahead_cond;
+	struct zstd_read_ahead_chunk chunks[LIGHT_ZSTD_READ_AHEAD_CHUNK_COUNT];
+	int consumer_chunk;
+	size_t consumer_pos;
+	int producer_chunk;
+	int producer_finished;
+	int stop_requested;
+#endif
+	// PCPP patch end
 };
 
 
@@ -79,5 +123,7 @@ size_t write_zstd_compressed(struct light_file_t *fd, const void *buf, size_t co
 
 int close_zstd_compressed(struct light_file_t *fd);
 
+int configure_zstd_compression(struct light_file_t *fd, int worker_count, size_t frame_size);  // PCPP patch
+
 #endif //USE_Z_STD
 #endif /* INCLUDE_LIGHT_ZSTD_COMPRESSION_H_ */
@@ -94,6 +94,16 @@ size_t light_write_compressed(light_file fd, const void* buf, size_t count)
 	return 0;
 }
 
+// PCPP patch
+int light_configure_compression(light_file fd, int worker_count, size_t frame_size)
+{
+	if (fd->compression_context == NULL || configure_compression == NULL)
+		return -1;
+
+	return configure_compression(fd, worker_count, frame_size);
+}
+// PCPP patch end
+
 int light_close_compressed(light_file fd)
 {
 	int result = 0;
@@ -36,5 +36,6 @@ int (*is_compressed_file)(const char*) = NULL;
 size_t (*read_compressed)(struct light_file_t*, void*, size_t) = NULL;
 size_t (*write_compressed)(struct light_file_t*, const void*, size_t) = NULL;
 int (*close_compressed)(struct light_file_t*) = NULL;
+int (*configure_compression)(struct light_file_t*, int, size_t) = NULL;  // PCPP patch
 
 #endif
\ No newline at end of file
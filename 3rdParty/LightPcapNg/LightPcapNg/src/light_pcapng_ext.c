@@ -37,6 +37,22 @@ struct _light_pcapng_t
 	light_pcapng pcapng;
 	light_pcapng_file_info* file_info;
 	light_file file;
+	// PCPP patch
+	// written packet blocks are serialized into this buffer, which is written to the file in large chunks
+	uint8_t* write_buffer;
+	size_t write_buffer_size;
+	size_t write_buffer_used;
+	// the interface ID of the link type of the last written packet
+	light_boolean has_cached_interface;
+	uint16_t cached_link_type;
+	uint32_t cached_interface_id;
+	// blocks read by light_get_next_packet_in_place() are parsed in place in this buffer, which is filled from the
+	// file in large chunks. Bytes between read_buffer_begin and read_buffer_end weren't parsed yet
+	uint8_t* read_buffer;
+	size_t read_buffer_size;
+	size_t read_buffer_begin;
+	size_t read_buffer_end;
+	// PCPP patch end
 };
 
 static light_pcapng_file_info* __create_file_info(light_pcapng pcapng_head)
@@ -136,33 +152,37 @@ static uint64_t int_pow(uint64_t x, uint8_t y)
 // PCPP patch end
 
 // PCPP patch
-static void __append_interface_block_to_file_info(const light_pcapng interface_block, light_pcapng_file_info* info)
+static void __append_interface_to_file_info(light_pcapng_file_info* info, uint16_t link_type,
+                                            const uint8_t* raw_ts_data)
 {
-	struct _light_interface_description_block* interface_desc_block;
-	light_option ts_resolution_option = NULL;
 	uint32_t ticks_per_sec;
 
 	if (info == NULL || info->interface_block_count >= MAX_SUPPORTED_INTERFACE_BLOCKS)
 		return;
 
-	light_get_block_info(interface_block, LIGHT_INFO_BODY, &interface_desc_block, NULL);
-
-	ts_resolution_option = light_get_option(interface_block, LIGHT_OPTION_IF_TSRESOL);
-	if (ts_resolution_option == NULL)
-	{
+	if (raw_ts_data == NULL)
 		ticks_per_sec = int_pow(10, 6);
-	}
+	else if (*raw_ts_data < 128)
+		ticks_per_sec = int_pow(10, (*raw_ts_data));
 	else
-	{
-		uint8_t* raw_ts_data = (uint8_t*)light_get_option_data(ts_resolution_option);
-		if (*raw_ts_data < 128)
-			ticks_per_sec = int_pow(10, (*raw_ts_data));
-		else
-			ticks_per_sec = int_pow(2, ((*raw_ts_data) - 128));
-	}
+		ticks_per_sec = int_pow(2, ((*raw_ts_data) - 128));
+
 	info->timestamp_ticks_per_second[info->interface_block_count] = ticks_per_sec;
 
-	info->link_types[info->interface_block_count++] = interface_desc_block->link_type;
+	info->link_types[info->interface_block_count++] = link_type;
+}
+
+static void __append_interface_block_to_file_info(const light_pcapng interface_block, light_pcapng_file_info* info)
+{
+	struct _light_interface_description_block* interface_desc_block;
+	light_option ts_resolution_option = NULL;
+
+	light_get_block_info(interface_block, LIGHT_INFO_BODY, &interface_desc_block, NULL);
+
+	ts_resolution_option = light_get_option(interface_block, LIGHT_OPTION_IF_TSRESOL);
+	__append_interface_to_file_info(
+	    info, interface_desc_block->link_type,
+	    ts_resolution_option != NULL ? (const uint8_t*)light_get_option_data(ts_resolution_option) : NULL);
 }
 // PCPP patch end
 
@@ -223,17 +243,37 @@ light_pcapng_t* light_pcapng_open_read(const char* file_path, light_boolean read
 }
 
 light_pcapng_t* light_pcapng_open_write(const char* file_path, light_pcapng_file_info* file_info, int compression_level)
+{
+	// PCPP patch
+	light_compression_options options = { compression_level, 0, 0 };
+	return light_pcapng_open_write_with_options(file_path, file_info, &options);
+	// PCPP patch end
+}
+
+// PCPP patch: the implementation of light_pcapng_open_write(), with compression options
+light_pcapng_t* light_pcapng_open_write_with_options(const char* file_path, light_pcapng_file_info* file_info,
+                                                     const light_compression_options* options)
 {
 	DCHECK_NULLP(file_info, return NULL);
 	DCHECK_NULLP(file_path, return NULL);
+	DCHECK_NULLP(options, return NULL);
 
 	light_pcapng_t* pcapng = calloc(1, sizeof(struct _light_pcapng_t));
 
-	pcapng->file = light_open_compression(file_path, LIGHT_OWRITE, compression_level);
+	pcapng->file = light_open_compression(file_path, LIGHT_OWRITE, options->compression_level);
 	pcapng->file_info = file_info;
 
 	DCHECK_ASSERT_EXP(pcapng->file != NULL, "could not open output file", return NULL);
 
+	// PCPP patch: the options apply from the first frame, so they're set before the section header is written
+	if (pcapng->file->compression_context != NULL && (options->worker_count > 0 || options->frame_size > 0) &&
+	    light_configure_compression(pcapng->file, options->worker_count, options->frame_size) != 0)
+	{
+		PCAPNG_WARNING("compression worker threads aren't supported, compressing on the writing thread");
+		light_configure_compression(pcapng->file, 0, options->frame_size);
+	}
+	// PCPP patch end
+
 	pcapng->pcapng = NULL;
 
 	struct _light_section_header section_header;
@@ -382,6 +422,41 @@ light_pcapng_file_info* light_pcang_get_file_info(light_pcapng_t* pcapng)
 	return pcapng->file_info;
 }
 
+// PCPP patch
+static void __set_enhanced_packet_timestamp(const light_pcapng_file_info* file_info,
+                                            const struct _light_enhanced_packet_block* epb,
+                                            light_packet_header* packet_header)
+{
+	if (epb->interface_id < file_info->interface_block_count)
+	{
+		uint64_t timestamp = epb->timestamp_high;
+		timestamp = timestamp << 32;
+		timestamp += epb->timestamp_low;
+		uint64_t ticks_per_sec = file_info->timestamp_ticks_per_second[epb->interface_id];
+		uint64_t packet_secs = (ticks_per_sec != 0 ? timestamp / ticks_per_sec : 0);
+		if (packet_secs <= MAXIMUM_PACKET_SECONDS_VALUE && packet_secs != 0)
+		{
+			uint64_t ticks = timestamp % ticks_per_sec;
+			packet_header->timestamp.tv_sec = packet_secs;
+			packet_header->timestamp.tv_nsec = (1000000000ul * ticks) / ticks_per_sec;
+		}
+		else
+		{
+			packet_header->timestamp.tv_sec = 0;
+			packet_header->timestamp.tv_nsec = 0;
+		}
+
+		packet_header->data_link = file_info->link_types[epb->interface_id];
+	}
+	else
+	{
+		packet_header->timestamp.tv_sec = 0;
+		packet_header->timestamp.tv_nsec = 0;
+		packet_header->data_link = 0xFFFF;
+	}
+}
+// PCPP patch end
+
 int light_get_next_packet(light_pcapng_t* pcapng, light_packet_header* packet_header, const uint8_t** packet_data)
 {
 	uint32_t type = LIGHT_UNKNOWN_DATA_BLOCK;
@@ -420,35 +495,7 @@ int light_get_next_packet(light_pcapng_t* pcapng, light_packet_header* packet_he
 		packet_header->captured_length = epb->capture_packet_length;
 		packet_header->original_length = epb->original_capture_length;
 
-		/// PCPP patch begin
-		if (epb->interface_id < pcapng->file_info->interface_block_count)
-		{
-			uint64_t timestamp = epb->timestamp_high;
-			timestamp = timestamp << 32;
-			timestamp += epb->timestamp_low;
-			uint64_t ticks_per_sec = pcapng->file_info->timestamp_ticks_per_second[epb->interface_id];
-			uint64_t packet_secs = (ticks_per_sec != 0 ? timestamp / ticks_per_sec : 0);
-			if (packet_secs <= MAXIMUM_PACKET_SECONDS_VALUE && packet_secs != 0)
-			{
-				uint64_t ticks = timestamp % ticks_per_sec;
-				packet_header->timestamp.tv_sec = packet_secs;
-				packet_header->timestamp.tv_nsec = (1000000000ul * ticks) / ticks_per_sec;
-			}
-			else
-			{
-				packet_header->timestamp.tv_sec = 0;
-				packet_header->timestamp.tv_nsec = 0;
-			}
-
-			packet_header->data_link = pcapng->file_info->link_types[epb->interface_id];
-		}
-		else
-		{
-			packet_header->timestamp.tv_sec = 0;
-			packet_header->timestamp.tv_nsec = 0;
-			packet_header->data_link = 0xFFFF;
-		}
-		/// PCPP patch end
+		__set_enhanced_packet_timestamp(pcapng->file_info, epb, packet_header);  // PCPP patch
 
 		*packet_data = (uint8_t*)epb->packet_data;
 	}
@@ -483,31 +530,243 @@ int light_get_next_packet(light_pcapng_t* pcapng, light_packet_header* packet_he
 	return 1;
 }
 
+// PCPP patch
+static const size_t READ_BUFFER_SIZE = 1024 * 1024;
+
+// make sure at least size unparsed bytes are in the read buffer, reading ahead as much as fits
+static light_boolean __fill_read_buffer(light_pcapng_t* pcapng, size_t size)
+{
+	size_t available = pcapng->read_buffer_end - pcapng->read_buffer_begin;
+	if (available >= size)
+		return LIGHT_TRUE;
+
+	// move the partial block to the start of the buffer, then grow it if the block doesn't fit
+	if (pcapng->read_buffer_begin > 0)
+	{
+		memmove(pcapng->read_buffer, pcapng->read_buffer + pcapng->read_buffer_begin, available);
+		pcapng->read_buffer_begin = 0;
+		pcapng->read_buffer_end = available;
+	}
+
+	if (pcapng->read_buffer_size < size)
+	{
+		size_t new_size = size > READ_BUFFER_SIZE ? size : READ_BUFFER_SIZE;
+		uint8_t* new_buffer = realloc(pcapng->read_buffer, new_size);
+		if (new_buffer == NULL)
+			return LIGHT_FALSE;
+
+		pcapng->read_buffer = new_buffer;
+		pcapng->read_buffer_size = new_size;
+	}
+
+	size_t bytes_read = light_read_up_to(pcapng->file, pcapng->read_buffer + pcapng->read_buffer_end,
+	                                     size - available, pcapng->read_buffer_size - pcapng->read_buffer_end);
+	if (bytes_read == (size_t)-1)
+		return LIGHT_FALSE;
+
+	pcapng->read_buffer_end += bytes_read;
+	return LIGHT_TRUE;
+}
+
+// find an option of a block whose options span [options, end)
+static const uint8_t* __find_option_in_place(const uint8_t* options, const uint8_t* end, uint16_t code,
+                                             uint16_t* length)
+{
+	while (options + 2 * sizeof(uint16_t) <= end)
+	{
+		uint16_t option_code, option_length;
+		memcpy(&option_code, options, sizeof(option_code));
+		memcpy(&option_length, options + sizeof(option_code), sizeof(option_length));
+		if (option_code == 0)
+			break;
+
+		const uint8_t* data = options + 2 * sizeof(uint16_t);
+		if ((size_t)(end - data) < option_length)
+			break;
+
+		if (option_code == code)
+		{
+			*length = option_length;
+			return data;
+		}
+
+		size_t padded_length;
+		PADD32(option_length, &padded_length);
+		if ((size_t)(end - data) < padded_length)
+			break;
+		options = data + padded_length;
+	}
+
+	return NULL;
+}
+
+int light_get_next_packet_in_place(light_pcapng_t* pcapng, light_packet_header* packet_header,
+                                   const uint8_t** packet_data, light_boolean read_comment)
+{
+	DCHECK_NULLP(pcapng, return 0);
+
+	*packet_data = NULL;
+	packet_header->comment = NULL;
+	packet_header->comment_length = 0;
+
+	while (1)
+	{
+		if (__fill_read_buffer(pcapng, 2 * sizeof(uint32_t)) == LIGHT_FALSE)
+			return 0;
+
+		uint32_t block_type, block_total_length;
+		const uint8_t* block = pcapng->read_buffer + pcapng->read_buffer_begin;
+		memcpy(&block_type, block, sizeof(block_type));
+		memcpy(&block_total_length, block + sizeof(block_type), sizeof(block_total_length));
+		if (block_total_length < 3 * sizeof(uint32_t) || (block_total_length % 4) != 0)
+			return 0;
+
+		if (__fill_read_buffer(pcapng, block_total_length) == LIGHT_FALSE)
+			return 0;
+
+		// the buffer may have moved
+		block = pcapng->read_buffer + pcapng->read_buffer_begin;
+		uint32_t trailing_length;
+		memcpy(&trailing_length, block + block_total_length - sizeof(uint32_t), sizeof(trailing_length));
+		if (trailing_length != block_total_length)
+			return 0;
+
+		pcapng->read_buffer_begin += block_total_length;
+
+		const uint8_t* body = block + 2 * sizeof(uint32_t);
+		const uint8_t* body_end = block + block_total_length - sizeof(uint32_t);
+		size_t body_length = body_end - body;
+
+		if (block_type == LIGHT_INTERFACE_BLOCK)
+		{
+			if (body_length < sizeof(struct _light_interface_description_block))
+				return 0;
+
+			uint16_t link_type, ts_resolution_length = 0;
+			memcpy(&link_type, body, sizeof(link_type));
+			const uint8_t* ts_resolution =
+			    __find_option_in_place(body + sizeof(struct _light_interface_description_block), body_end,
+			                           LIGHT_OPTION_IF_TSRESOL, &ts_resolution_length);
+			__append_interface_to_file_info(pcapng->file_info, link_type,
+			                                ts_resolution_length > 0 ? ts_resolution : NULL);
+		}
+		else if (block_type == LIGHT_ENHANCED_PACKET_BLOCK)
+		{
+			if (body_length < sizeof(struct _light_enhanced_packet_block))
+				return 0;
+
+			const struct _light_enhanced_packet_block* epb = (const struct _light_enhanced_packet_block*)body;
+			size_t padded_data_length;
+			PADD32(epb->capture_packet_length, &padded_data_length);
+			if (body_length - sizeof(struct _light_enhanced_packet_block) < padded_data_length)
+				return 0;
+
+			packet_header->interface_id = epb->interface_id;
+			packet_header->captured_length = epb->capture_packet_length;
+			packet_header->original_length = epb->original_capture_length;
+			__set_enhanced_packet_timestamp(pcapng->file_info, epb, packet_header);
+			*packet_data = (const uint8_t*)epb->packet_data;
+
+			if (read_comment == LIGHT_TRUE)
+			{
+				const uint8_t* options = (const uint8_t*)epb->packet_data + padded_data_length;
+				uint16_t comment_length = 0;
+				const uint8_t* comment =
+				    __find_option_in_place(options, body_end, LIGHT_OPTION_COMMENT, &comment_length);
+				if (comment != NULL)
+				{
+					packet_header->comment = (char*)comment;
+					packet_header->comment_length = comment_length;
+				}
+			}
+
+			return 1;
+		}
+		else if (block_type == LIGHT_SIMPLE_PACKET_BLOCK)
+		{
+			if (body_length < sizeof(struct _light_simple_packet_block))
+				return 0;
+
+			const struct _light_simple_packet_block* spb = (const struct _light_simple_packet_block*)body;
+			size_t max_data_length = body_length - sizeof(struct _light_simple_packet_block);
+
+			packet_header->interface_id = 0;
+			packet_header->original_length = spb->original_packet_length;
+			// the packet may be truncated to the snapshot length of the interface
+			packet_header->captured_length = spb->original_packet_length < max_data_length
+			                                     ? spb->original_packet_length
+			                                     : (uint32_t)max_data_length;
+			packet_header->timestamp.tv_sec = 0;
+			packet_header->timestamp.tv_nsec = 0;
+			// a simple packet block belongs to the first interface. Like in __set_enhanced_packet_timestamp(), a
+			// packet without an interface gets an invalid link type rather than the one of a previous packet
+			packet_header->data_link =
+			    pcapng->file_info->interface_block_count > 0 ? pcapng->file_info->link_types[0] : 0xFFFF;
+			*packet_data = (const uint8_t*)spb->packet_data;
+			return 1;
+		}
+
+		// any other block (including the header of a new section) doesn't affect the packets
+	}
+}
+// PCPP patch end
+
 static const uint8_t NSEC_PRECISION = 9;
 
-void light_write_packet(light_pcapng_t* pcapng, const light_packet_header* packet_header, const uint8_t* packet_data)
+// PCPP patch
+static const size_t WRITE_BUFFER_SIZE = 1024 * 1024;
+
+static void __flush_write_buffer(light_pcapng_t* pcapng)
 {
-	DCHECK_NULLP(pcapng, return);
-	DCHECK_NULLP(packet_header, return);
-	DCHECK_NULLP(packet_data, return);
-	DCHECK_ASSERT_EXP(__is_open_for_write(pcapng) == LIGHT_TRUE, "file not open for writing", return);
+	if (pcapng->write_buffer_used > 0)
+	{
+		light_write(pcapng->file, pcapng->write_buffer, pcapng->write_buffer_used);
+		pcapng->write_buffer_used = 0;
+	}
+}
+
+static uint8_t* __reserve_write_buffer(light_pcapng_t* pcapng, size_t size)
+{
+	if (pcapng->write_buffer_size - pcapng->write_buffer_used < size)
+	{
+		__flush_write_buffer(pcapng);
+
+		if (pcapng->write_buffer_size < size)
+		{
+			size_t new_size = size > WRITE_BUFFER_SIZE ? size : WRITE_BUFFER_SIZE;
+			uint8_t* new_buffer = realloc(pcapng->write_buffer, new_size);
+			if (new_buffer == NULL)
+				return NULL;
+
+			pcapng->write_buffer = new_buffer;
+			pcapng->write_buffer_size = new_size;
+		}
+	}
+
+	uint8_t* reserved = pcapng->write_buffer + pcapng->write_buffer_used;
+	pcapng->write_buffer_used += size;
+	return reserved;
+}
+
+static uint32_t __get_interface_id(light_pcapng_t* pcapng, uint16_t link_type)
+{
+	if (pcapng->has_cached_interface == LIGHT_TRUE && pcapng->cached_link_type == link_type)
+		return pcapng->cached_interface_id;
 
 	size_t iface_id = 0;
 	for (iface_id = 0; iface_id < pcapng->file_info->interface_block_count; iface_id++)
 	{
-		if (pcapng->file_info->link_types[iface_id] == packet_header->data_link)
+		if (pcapng->file_info->link_types[iface_id] == link_type)
 			break;
 	}
 
-	light_pcapng blocks_to_write = NULL;
-
 	// TODO: most probably, this section should be removed as soon as possibility to write interface blocks
 	// is added, as all this section does is basically creating "mock" interface blocks with default parameters
 	// in case interface ID of packet block to be written does not exist - was not read previously
 	if (iface_id >= pcapng->file_info->interface_block_count)
 	{
 		struct _light_interface_description_block interface_block;
-		interface_block.link_type = packet_header->data_link;
+		interface_block.link_type = link_type;
 		interface_block.reserved = 0;
 		interface_block.snapshot_length = 0;
 
@@ -521,15 +780,47 @@ void light_write_packet(light_pcapng_t* pcapng, const light_packet_header* packe
 		    light_create_option(LIGHT_OPTION_IF_TSRESOL, sizeof(NSEC_PRECISION), (uint8_t*)&NSEC_PRECISION);
 		light_add_option(NULL, iface_block_pcapng, resolution_option, LIGHT_FALSE);
 
-		blocks_to_write = iface_block_pcapng;
+		// the interface block must precede the packets which refer to it
+		__flush_write_buffer(pcapng);
+		light_pcapng_to_file_stream(iface_block_pcapng, pcapng->file);
 		__append_interface_block_to_file_info(iface_block_pcapng, pcapng->file_info);
+		light_pcapng_release(iface_block_pcapng);
 	}
 
-	size_t option_size = sizeof(struct _light_enhanced_packet_block) + packet_header->captured_length;
-	PADD32(option_size, &option_size);
-	uint8_t* epb_memory = calloc(1, option_size);
-	// memset(epb_memory, 0, option_size); should be redundant with calloc
-	struct _light_enhanced_packet_block* epb = (struct _light_enhanced_packet_block*)epb_memory;
+	pcapng->has_cached_interface = LIGHT_TRUE;
+	pcapng->cached_link_type = link_type;
+	pcapng->cached_interface_id = (uint32_t)iface_id;
+	return pcapng->cached_interface_id;
+}
+
+// the enhanced packet block is serialized in place, without allocating a block and its options for every packet
+void light_write_packet(light_pcapng_t* pcapng, const light_packet_header* packet_header, const uint8_t* packet_data)
+{
+	DCHECK_NULLP(pcapng, return);
+	DCHECK_NULLP(packet_header, return);
+	DCHECK_NULLP(packet_data, return);
+	DCHECK_ASSERT_EXP(__is_open_for_write(pcapng) == LIGHT_TRUE, "file not open for writing", return);
+
+	uint32_t iface_id = __get_interface_id(pcapng, packet_header->data_link);
+
+	size_t padded_data_length, padded_comment_length = 0, options_length = 0;
+	PADD32(packet_header->captured_length, &padded_data_length);
+	if (packet_header->comment_length > 0)
+	{
+		PADD32(packet_header->comment_length, &padded_comment_length);
+		// the comment option and the end of options marker
+		options_length = sizeof(uint32_t) + padded_comment_length + sizeof(uint32_t);
+	}
+
+	size_t block_length = 2 * sizeof(uint32_t) + sizeof(struct _light_enhanced_packet_block) + padded_data_length +
+	                      options_length + sizeof(uint32_t);
+	uint32_t* block = (uint32_t*)__reserve_write_buffer(pcapng, block_length);
+	DCHECK_NULLP(block, return);
+
+	block[0] = LIGHT_ENHANCED_PACKET_BLOCK;
+	block[1] = (uint32_t)block_length;
+
+	struct _light_enhanced_packet_block* epb = (struct _light_enhanced_packet_block*)&block[2];
 	epb->interface_id = iface_id;
 
 	uint64_t timestamp, packet_secs = (uint64_t)packet_header->timestamp.tv_sec;
@@ -546,28 +837,26 @@ void light_write_packet(light_pcapng_t* pcapng, const light_packet_header* packe
 	epb->capture_packet_length = packet_header->captured_length;
 	epb->original_capture_length = packet_header->original_length;
 
-	memcpy(epb->packet_data, packet_data, packet_header->captured_length);
-
-	light_pcapng packet_block_pcapng =
-	    light_alloc_block(LIGHT_ENHANCED_PACKET_BLOCK, (const uint32_t*)epb_memory, option_size + 3 * sizeof(uint32_t));
-	free(epb_memory);
+	uint8_t* cursor = (uint8_t*)epb->packet_data;
+	memcpy(cursor, packet_data, packet_header->captured_length);
+	memset(cursor + packet_header->captured_length, 0, padded_data_length - packet_header->captured_length);
+	cursor += padded_data_length;
 
 	if (packet_header->comment_length > 0)
 	{
-		light_option packet_comment_opt =
-		    light_create_option(LIGHT_OPTION_COMMENT, packet_header->comment_length, packet_header->comment);
-		light_add_option(NULL, packet_block_pcapng, packet_comment_opt, LIGHT_FALSE);
+		uint32_t option_header = LIGHT_OPTION_COMMENT | ((uint32_t)packet_header->comment_length << 16);
+		memcpy(cursor, &option_header, sizeof(option_header));
+		cursor += sizeof(option_header);
+		memcpy(cursor, packet_header->comment, packet_header->comment_length);
+		memset(cursor + packet_header->comment_length, 0, padded_comment_length - packet_header->comment_length);
+		cursor += padded_comment_length;
+		memset(cursor, 0, sizeof(uint32_t));
+		cursor += sizeof(uint32_t);
 	}
 
-	if (blocks_to_write == NULL)
-		blocks_to_write = packet_block_pcapng;
-	else
-		light_add_block(blocks_to_write, packet_block_pcapng);
-
-	light_pcapng_to_file_stream(blocks_to_write, pcapng->file);
-
-	light_pcapng_release(blocks_to_write);
+	memcpy(cursor, &block[1], sizeof(uint32_t));
 }
+// PCPP patch end
 
 void light_pcapng_close(light_pcapng_t* pcapng)
 {
@@ -577,15 +866,19 @@ void light_pcapng_close(light_pcapng_t* pcapng)
 	pcapng->pcapng = NULL;
 	if (pcapng->file != NULL)
 	{
+		__flush_write_buffer(pcapng);  // PCPP patch
 		light_flush(pcapng->file);
 		light_close(pcapng->file);
 	}
 	if (pcapng->file_info != NULL)
 		light_free_file_info(pcapng->file_info);
+	free(pcapng->write_buffer);  // PCPP patch
+	free(pcapng->read_buffer);   // PCPP patch
 	free(pcapng);
 }
 
 void light_pcapng_flush(light_pcapng_t* pcapng)
 {
+	__flush_write_buffer(pcapng);  // PCPP patch
 	light_flush(pcapng->file);
 }
\ No newline at end of file
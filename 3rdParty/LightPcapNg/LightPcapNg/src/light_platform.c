@@ -148,6 +148,23 @@ size_t light_read(light_file fd, void* buf, size_t count)
 	}
 }
 
+// PCPP patch
+size_t light_read_up_to(light_file fd, void* buf, size_t min_count, size_t max_count)
+{
+	if (fd->decompression_context == NULL)
+	{
+		size_t bytes_read = fread(buf, 1, max_count, fd->file);
+		return bytes_read < min_count ? -1 : bytes_read;
+	}
+	else
+	{
+		// the decompressor doesn't report short reads, so only the required bytes are read
+		size_t bytes_read = light_read_compressed(fd, buf, min_count);
+		return bytes_read != min_count ? -1 : bytes_read;
+	}
+}
+// PCPP patch end
+
 size_t light_write(light_file fd, const void* buf, size_t count)
 {
 	if (fd->compression_context == NULL)
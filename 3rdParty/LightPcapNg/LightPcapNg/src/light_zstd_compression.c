@@ -30,6 +30,9 @@
 #	include <memory.h>
 #	include <stdlib.h>
 #	include <string.h>
+#	ifdef LIGHT_ZSTD_READ_AHEAD
+#		include <unistd.h>  // PCPP patch
+#	endif
 
 _compression_t* (*get_compression_context_ptr)(int) = &get_zstd_compression_context;
 void (*free_compression_context_ptr)(_compression_t*) = &free_zstd_compression_context;
@@ -39,6 +42,7 @@ int (*is_compressed_file)(const char*) = &is_zstd_compressed_file;
 size_t (*read_compressed)(struct light_file_t*, void*, size_t) = &read_zstd_compressed;
 size_t (*write_compressed)(struct light_file_t*, const void*, size_t) = &write_zstd_compressed;
 int (*close_compressed)(struct light_file_t*) = &close_zstd_compressed;
+int (*configure_compression)(struct light_file_t*, int, size_t) = &configure_zstd_compression;  // PCPP patch
 
 #	if !defined(_MSC_VER) || !defined(max)
 #		define max(a, b)                                                                                              \
@@ -49,6 +53,20 @@ int (*close_compressed)(struct light_file_t*) = &close_zstd_compressed;
 			})
 #	endif  // !defined(_MSC_VER) || !defined(max)
 
+// PCPP patch
+#	if !defined(_MSC_VER) || !defined(min)
+#		define min(a, b) (((a) < (b)) ? (a) : (b))
+#	endif
+// PCPP patch end
+
+// PCPP patch
+// the zstd seekable format stores frame sizes as 32-bit values
+#	define LIGHT_ZSTD_MAX_FRAME_SIZE (1024 * 1024 * 1024)
+#	define LIGHT_ZSTD_SKIPPABLE_MAGIC_NUMBER 0x184D2A5E
+#	define LIGHT_ZSTD_SEEKABLE_MAGIC_NUMBER 0x8F92EAB1
+#	define LIGHT_ZSTD_SEEK_TABLE_FOOTER_SIZE 9
+// PCPP patch end
+
 _compression_t* get_zstd_compression_context(int compression_level)
 {
 	struct zstd_compression_t* context = calloc(1, sizeof(struct zstd_compression_t));
@@ -60,7 +78,10 @@ _compression_t* get_zstd_compression_context(int compression_level)
 	context->buffer_in = malloc(context->buffer_in_max_size);
 	context->buffer_out = malloc(context->buffer_out_max_size);
 	context->compression_level = compression_level * 2;  // Input is scale 0-10 but zstd goes 0 - 20!
-	assert(!ZSTD_isError(ZSTD_CCtx_setParameter(context->cctx, ZSTD_c_compressionLevel, compression_level)));
+	// PCPP patch: the parameter used to be set inside assert(), so release builds always used the default level
+	size_t const result = ZSTD_CCtx_setParameter(context->cctx, ZSTD_c_compressionLevel, compression_level);
+	assert(!ZSTD_isError(result));
+	(void)result;
 
 	return context;
 }
@@ -76,6 +97,8 @@ void free_zstd_compression_context(_compression_t* context)
 		free(context->buffer_out);
 	if (context->buffer_in)
 		free(context->buffer_in);
+	if (context->seek_table)
+		free(context->seek_table);  // PCPP patch
 }
 
 _decompression_t* get_zstd_decompression_context()
@@ -90,19 +113,42 @@ _decompression_t* get_zstd_decompression_context()
 	context->buffer_in = malloc(context->buffer_in_max_size);
 	context->buffer_out = malloc(context->buffer_out_max_size);
 
+	// PCPP patch: output tracks the decompressed bytes in buffer_out which weren't read yet
 	context->output.dst = context->buffer_out;
-	context->output.size = context->buffer_out_max_size;
+	context->output.size = 0;
 	context->output.pos = 0;
-	context->outputReady = 0;
 
 	return context;
 }
 
+// PCPP patch
+#	ifdef LIGHT_ZSTD_READ_AHEAD
+static void __stop_read_ahead(struct zstd_decompression_t* context)
+{
+	pthread_mutex_lock(&context->read_ahead_lock);
+	context->stop_requested = 1;
+	pthread_cond_broadcast(&context->read_ahead_cond);
+	pthread_mutex_unlock(&context->read_ahead_lock);
+
+	pthread_join(context->read_ahead_thread, NULL);
+	pthread_cond_destroy(&context->read_ahead_cond);
+	pthread_mutex_destroy(&context->read_ahead_lock);
+	free(context->chunks[0].data);
+}
+#	endif
+// PCPP patch end
+
 void free_zstd_decompression_context(_decompression_t* context)
 {
 	if (!context)
 		return;
 
+	// PCPP patch: the read-ahead thread uses the file, so it's stopped before the file is closed
+#	ifdef LIGHT_ZSTD_READ_AHEAD
+	if (context->read_ahead_started == 1)
+		__stop_read_ahead(context);
+#	endif
+
 	if (context->dctx)
 		ZSTD_freeDCtx(context->dctx);
 	if (context->buffer_out)
@@ -123,6 +169,165 @@ int is_zstd_compressed_file(const char* file_path)
 	}
 }
 
+// PCPP patch
+// Read and decompress data from the file until dst is full or the file ends. Returns the number of decompressed
+// bytes, a value smaller than capacity means the end of the file (or corrupted data) was reached
+static size_t __decompress_zstd(light_file fd, uint8_t* dst, size_t capacity)
+{
+	struct zstd_decompression_t* context = fd->decompression_context;
+	ZSTD_outBuffer output = { dst, capacity, 0 };
+
+	while (output.pos < output.size)
+	{
+		if (context->input.pos >= context->input.size)
+		{
+			size_t bytes_read_file = fread(context->buffer_in, 1, context->buffer_in_max_size, fd->file);
+			if (bytes_read_file == 0)
+				break;
+
+			context->input.src = context->buffer_in;
+			context->input.size = bytes_read_file;
+			context->input.pos = 0;
+		}
+
+		size_t const result = ZSTD_decompressStream(context->dctx, &output, &context->input);
+		if (ZSTD_isError(result))
+		{
+			// drop the rest of the file, so the caller sees the end of the data
+			fseek(fd->file, 0, SEEK_END);
+			context->input.pos = context->input.size;
+			break;
+		}
+	}
+
+	return output.pos;
+}
+
+#	ifdef LIGHT_ZSTD_READ_AHEAD
+// The read-ahead thread: decompresses the file into the chunks, in order, while the reading thread copies data out
+// of the chunks filled before. It exits when the file ends or when the context is freed
+static void* __zstd_read_ahead_main(void* arg)
+{
+	light_file fd = arg;
+	struct zstd_decompression_t* context = fd->decompression_context;
+
+	while (1)
+	{
+		struct zstd_read_ahead_chunk* chunk = &context->chunks[context->producer_chunk];
+
+		pthread_mutex_lock(&context->read_ahead_lock);
+		while (chunk->ready && !context->stop_requested)
+			pthread_cond_wait(&context->read_ahead_cond, &context->read_ahead_lock);
+		int stop_requested = context->stop_requested;
+		pthread_mutex_unlock(&context->read_ahead_lock);
+
+		if (stop_requested)
+			break;
+
+		size_t size = __decompress_zstd(fd, chunk->data, LIGHT_ZSTD_READ_AHEAD_CHUNK_SIZE);
+
+		pthread_mutex_lock(&context->read_ahead_lock);
+		if (size > 0)
+		{
+			chunk->size = size;
+			chunk->ready = 1;
+			context->producer_chunk = (context->producer_chunk + 1) % LIGHT_ZSTD_READ_AHEAD_CHUNK_COUNT;
+		}
+		if (size < LIGHT_ZSTD_READ_AHEAD_CHUNK_SIZE)
+			context->producer_finished = 1;
+		pthread_cond_broadcast(&context->read_ahead_cond);
+		pthread_mutex_unlock(&context->read_ahead_lock);
+
+		if (size < LIGHT_ZSTD_READ_AHEAD_CHUNK_SIZE)
+			break;
+	}
+
+	return NULL;
+}
+
+static void __start_read_ahead(light_file fd)
+{
+	struct zstd_decompression_t* context = fd->decompression_context;
+	if (sysconf(_SC_NPROCESSORS_ONLN) <= 1)
+	{
+		context->read_ahead_started = -1;
+		return;
+	}
+
+	uint8_t* data = malloc((size_t)LIGHT_ZSTD_READ_AHEAD_CHUNK_COUNT * LIGHT_ZSTD_READ_AHEAD_CHUNK_SIZE);
+	if (data == NULL)
+	{
+		context->read_ahead_started = -1;
+		return;
+	}
+
+	for (int i = 0; i < LIGHT_ZSTD_READ_AHEAD_CHUNK_COUNT; i++)
+	{
+		context->chunks[i].data = data + (size_t)i * LIGHT_ZSTD_READ_AHEAD_CHUNK_SIZE;
+		context->chunks[i].size = 0;
+		context->chunks[i].ready = 0;
+	}
+
+	pthread_mutex_init(&context->read_ahead_lock, NULL);
+	pthread_cond_init(&context->read_ahead_cond, NULL);
+
+	if (pthread_create(&context->read_ahead_thread, NULL, &__zstd_read_ahead_main, fd) != 0)
+	{
+		// fall back to decompressing on the reading thread
+		pthread_cond_destroy(&context->read_ahead_cond);
+		pthread_mutex_destroy(&context->read_ahead_lock);
+		free(data);
+		context->read_ahead_started = -1;
+		return;
+	}
+
+	context->read_ahead_started = 1;
+}
+
+static size_t __read_zstd_read_ahead(light_file fd, void* buf, size_t count)
+{
+	struct zstd_decompression_t* context = fd->decompression_context;
+	size_t bytes_read = 0;
+
+	while (bytes_read < count)
+	{
+		struct zstd_read_ahead_chunk* chunk = &context->chunks[context->consumer_chunk];
+
+		// a chunk the reading thread started consuming stays ready until it's fully consumed
+		if (context->consumer_pos == 0)
+		{
+			pthread_mutex_lock(&context->read_ahead_lock);
+			while (!chunk->ready && !context->producer_finished)
+				pthread_cond_wait(&context->read_ahead_cond, &context->read_ahead_lock);
+			int ready = chunk->ready;
+			pthread_mutex_unlock(&context->read_ahead_lock);
+
+			if (!ready)
+				return EOF;
+		}
+
+		size_t to_copy = min(chunk->size - context->consumer_pos, count - bytes_read);
+		memcpy((uint8_t*)buf + bytes_read, chunk->data + context->consumer_pos, to_copy);
+		context->consumer_pos += to_copy;
+		bytes_read += to_copy;
+
+		if (context->consumer_pos == chunk->size)
+		{
+			pthread_mutex_lock(&context->read_ahead_lock);
+			chunk->ready = 0;
+			pthread_cond_broadcast(&context->read_ahead_cond);
+			pthread_mutex_unlock(&context->read_ahead_lock);
+
+			context->consumer_chunk = (context->consumer_chunk + 1) % LIGHT_ZSTD_READ_AHEAD_CHUNK_COUNT;
+			context->consumer_pos = 0;
+		}
+	}
+
+	return bytes_read;
+}
+#	endif  // LIGHT_ZSTD_READ_AHEAD
+// PCPP patch end
+
 size_t read_zstd_compressed(light_file fd, void* buf, size_t count)
 {
 	// Decompression is a little more complex
@@ -131,95 +336,169 @@ size_t read_zstd_compressed(light_file fd, void* buf, size_t count)
 	// Then reading the selected number of bytes from the buffer
 	// Once whole buffer is consumed we need to read and decompress next chunk from file
 
+	// PCPP patch: where threads are available the file is decompressed by a read-ahead thread
+#	ifdef LIGHT_ZSTD_READ_AHEAD
+	if (fd->decompression_context->read_ahead_started == 0)
+		__start_read_ahead(fd);
+
+	if (fd->decompression_context->read_ahead_started == 1)
+		return __read_zstd_read_ahead(fd, buf, count);
+#	endif
+
+	ZSTD_outBuffer* output = &fd->decompression_context->output;
 	size_t bytes_read = 0;
 
 	while (bytes_read < count)
 	{
-		if (fd->decompression_context->outputReady == 0)
+		// Once the whole decompressed chunk is consumed decompress the next one
+		if (output->pos == output->size)
 		{
-			// Check if we need to grab a new chunk from the actual file
-			// If we read all the input then yes, we need to do that
-			if (fd->decompression_context->input.pos >= fd->decompression_context->input.size)
-			{
-				// Read a decompress a chunk
-				size_t bytes_read_file = fread(fd->decompression_context->buffer_in, 1,
-				                               fd->decompression_context->buffer_in_max_size, fd->file);
-				if (bytes_read_file < fd->decompression_context->buffer_in_max_size && bytes_read_file == 0 &&
-				    feof(fd->file))
-					return EOF;
-				fd->decompression_context->input.src = fd->decompression_context->buffer_in;
-				fd->decompression_context->input.size = bytes_read_file;
-				fd->decompression_context->input.pos = 0;
-			}
-			// Decompress into the output buffer and use this buffer to actually get our results
-			fd->decompression_context->output.dst = fd->decompression_context->buffer_out;
-			fd->decompression_context->output.size = fd->decompression_context->buffer_out_max_size;
-			fd->decompression_context->output.pos = 0;
-
-			size_t const remaining = ZSTD_decompressStream(
-			    fd->decompression_context->dctx, &fd->decompression_context->output, &fd->decompression_context->input);
-			assert(!ZSTD_isError(remaining));
-
-			// Re-use the output class to track our own consumption
-			fd->decompression_context->output.size = fd->decompression_context->output.pos;
-			fd->decompression_context->output.pos = 0;
-			fd->decompression_context->outputReady = 1;
+			output->size = __decompress_zstd(fd, output->dst, fd->decompression_context->buffer_out_max_size);
+			output->pos = 0;
+			if (output->size == 0)
+				return EOF;
 		}
 
-		// Now get bytes from our output buffer
+		size_t to_copy = min(output->size - output->pos, count - bytes_read);
+		memcpy((uint8_t*)buf + bytes_read, (uint8_t*)output->dst + output->pos, to_copy);
+		output->pos += to_copy;
+		bytes_read += to_copy;
+	}
+	// PCPP patch end
 
-		// Case we need everything or less than that which was decoded
-		int needToRead = count - bytes_read;
-		int remaining = (fd->decompression_context->output.size - fd->decompression_context->output.pos);
-		if (needToRead <= remaining)
-		{
-			memcpy((uint8_t*)buf + bytes_read,
-			       (uint8_t*)fd->decompression_context->output.dst + fd->decompression_context->output.pos, needToRead);
-			fd->decompression_context->output.pos += needToRead;
-			bytes_read += needToRead;
-		}
+	return bytes_read;
+}
 
-		// Case we need more than that which was decoded
-		if (needToRead > remaining)
-		{
-			memcpy((uint8_t*)buf + bytes_read,
-			       (uint8_t*)fd->decompression_context->output.dst + fd->decompression_context->output.pos, remaining);
-			bytes_read += remaining;
-			fd->decompression_context->output.pos += remaining;
-		}
+// PCPP patch
+static int __add_zstd_seek_table_entry(struct zstd_compression_t* context)
+{
+	if (context->seek_table_count == context->seek_table_capacity)
+	{
+		size_t new_capacity = context->seek_table_capacity == 0 ? 64 : context->seek_table_capacity * 2;
+		uint32_t* new_table = realloc(context->seek_table, new_capacity * 2 * sizeof(uint32_t));
+		if (new_table == NULL)
+			return -1;
 
-		// We have consumed everything - set next call to decompress a new chunk
-		if (fd->decompression_context->output.pos == fd->decompression_context->output.size)
-			fd->decompression_context->outputReady = 0;
+		context->seek_table = new_table;
+		context->seek_table_capacity = new_capacity;
 	}
 
-	return bytes_read;
+	context->seek_table[2 * context->seek_table_count] = (uint32_t)context->frame_compressed_size;
+	context->seek_table[2 * context->seek_table_count + 1] = (uint32_t)context->frame_uncompressed_size;
+	context->seek_table_count++;
+	return 0;
 }
 
-size_t write_zstd_compressed(light_file fd, const void* buf, size_t count)
+// Compress count bytes and write the output to the file. ZSTD_e_end ends the current frame, which is then added to
+// the seek table. Returns 0 on success or -1 on error
+static int __compress_zstd(light_file fd, const void* buf, size_t count, ZSTD_EndDirective directive)
 {
-	// Do compression here!
-	/* Set the input buffer to what we just read.
-	 * We compress until the input buffer is empty, each time flushing the
-	 * output.
-	 */
+	struct zstd_compression_t* context = fd->compression_context;
 	ZSTD_inBuffer input = { buf, count, 0 };
-	int finished;
+	size_t remaining;
+
 	do
 	{
-		/* Compress into the output buffer and write all of the output to
-		 * the file so we can reuse the buffer next iteration.
-		 */
-		ZSTD_outBuffer output = { fd->compression_context->buffer_out, fd->compression_context->buffer_out_max_size,
-			                      0 };
-		size_t const remaining = ZSTD_compressStream2(fd->compression_context->cctx, &output, &input, ZSTD_e_continue);
-		assert(!ZSTD_isError(remaining));
-		fwrite(output.dst, 1, output.pos, fd->file);
-		/* If we're on the last chunk we're finished when zstd returns 0,
-		 * We're finished when we've consumed all the input.
-		 */
-		finished = (input.pos == input.size);
-	} while (!finished);
+		// With ZSTD_e_end zstd returns 0 once the frame is fully flushed, otherwise we're done when the input
+		// was consumed
+		ZSTD_outBuffer output = { context->buffer_out, context->buffer_out_max_size, 0 };
+		remaining = ZSTD_compressStream2(context->cctx, &output, &input, directive);
+		if (ZSTD_isError(remaining))
+			return -1;
+
+		if (fwrite(output.dst, 1, output.pos, fd->file) != output.pos)
+			return -1;
+
+		context->frame_compressed_size += output.pos;
+	} while (directive == ZSTD_e_end ? remaining != 0 : input.pos < input.size);
+
+	context->frame_uncompressed_size += count;
+
+	if (directive == ZSTD_e_end)
+	{
+		if (context->frame_size != 0 && __add_zstd_seek_table_entry(context) != 0)
+			return -1;
+
+		context->frame_compressed_size = 0;
+		context->frame_uncompressed_size = 0;
+	}
+
+	return 0;
+}
+
+static void __write_le32(uint8_t* dst, uint32_t value)
+{
+	dst[0] = (uint8_t)value;
+	dst[1] = (uint8_t)(value >> 8);
+	dst[2] = (uint8_t)(value >> 16);
+	dst[3] = (uint8_t)(value >> 24);
+}
+
+// Write the seek table in the zstd seekable format: a skippable frame holding the compressed and decompressed size
+// of every frame, so readers can locate the frame holding a given offset without decompressing the whole file
+static int __write_zstd_seek_table(light_file fd)
+{
+	struct zstd_compression_t* context = fd->compression_context;
+	size_t content_size = context->seek_table_count * 8 + LIGHT_ZSTD_SEEK_TABLE_FOOTER_SIZE;
+	uint8_t* table = malloc(8 + content_size);
+	if (table == NULL)
+		return -1;
+
+	uint8_t* pos = table;
+	__write_le32(pos, LIGHT_ZSTD_SKIPPABLE_MAGIC_NUMBER);
+	__write_le32(pos + 4, (uint32_t)content_size);
+	pos += 8;
+	for (size_t i = 0; i < context->seek_table_count; i++, pos += 8)
+	{
+		__write_le32(pos, context->seek_table[2 * i]);
+		__write_le32(pos + 4, context->seek_table[2 * i + 1]);
+	}
+	__write_le32(pos, (uint32_t)context->seek_table_count);
+	pos[4] = 0;  // no checksums
+	__write_le32(pos + 5, LIGHT_ZSTD_SEEKABLE_MAGIC_NUMBER);
+
+	int result = fwrite(table, 1, 8 + content_size, fd->file) == 8 + content_size ? 0 : -1;
+	free(table);
+	return result;
+}
+
+int configure_zstd_compression(light_file fd, int worker_count, size_t frame_size)
+{
+	struct zstd_compression_t* context = fd->compression_context;
+	if (worker_count < 0 || frame_size > LIGHT_ZSTD_MAX_FRAME_SIZE)
+		return -1;
+
+	// fails when zstd was built without multithreading support
+	if (ZSTD_isError(ZSTD_CCtx_setParameter(context->cctx, ZSTD_c_nbWorkers, worker_count)))
+		return -1;
+
+	context->frame_size = frame_size;
+	return 0;
+}
+// PCPP patch end
+
+size_t write_zstd_compressed(light_file fd, const void* buf, size_t count)
+{
+	// PCPP patch: the data is compressed by __compress_zstd(), split at frame boundaries when frames are used
+	struct zstd_compression_t* context = fd->compression_context;
+	size_t bytes_written = 0;
+
+	while (bytes_written < count)
+	{
+		size_t to_write = count - bytes_written;
+		ZSTD_EndDirective directive = ZSTD_e_continue;
+		if (context->frame_size != 0 && to_write >= context->frame_size - context->frame_uncompressed_size)
+		{
+			to_write = context->frame_size - context->frame_uncompressed_size;
+			directive = ZSTD_e_end;
+		}
+
+		if (__compress_zstd(fd, (const uint8_t*)buf + bytes_written, to_write, directive) != 0)
+			return -1;
+
+		bytes_written += to_write;
+	}
+	// PCPP patch end
 
 	return count;
 }
@@ -229,22 +508,21 @@ int close_zstd_compressed(light_file fd)
 	// Wrap up the compression here
 	if (fd->compression_context)
 	{
-		ZSTD_inBuffer input = { 0, 0, 0 };
+		// PCPP patch: end the last frame and, when the data is split into frames, add the seek table
+		struct zstd_compression_t* context = fd->compression_context;
+		int result = 0;
 
-		int remaining = 1;
+		if (context->frame_size == 0 || context->frame_uncompressed_size != 0)
+			result = __compress_zstd(fd, NULL, 0, ZSTD_e_end);
 
-		while (remaining != 0)
-		{
-			ZSTD_outBuffer output = { fd->compression_context->buffer_out, fd->compression_context->buffer_out_max_size,
-				                      0 };
-			remaining = ZSTD_compressStream2(fd->compression_context->cctx, &output, &input, ZSTD_e_end);
-			fwrite(output.dst, 1, output.pos, fd->file);
-		}
+		if (result == 0 && context->frame_size != 0)
+			result = __write_zstd_seek_table(fd);
 
-		return 0;
+		return result;
+		// PCPP patch end
 	}
 
 	return -1;
 }
 
-#endif  // USE_Z_STD
\ No newline at end of file
+#endif  // USE_Z_STD
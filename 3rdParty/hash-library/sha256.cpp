@@ -0,0 +1,288 @@
+// //////////////////////////////////////////////////////////
+// sha256.cpp
+// Copyright (c) 2014,2015 Stephan Brumme. All rights reserved.
+// see http://create.stephan-brumme.com/disclaimer.html
+//
+
+#include "sha256.h"
+
+/// same as reset()
+SHA256::SHA256()
+{
+	reset();
+}
+
+/// restart
+void SHA256::reset()
+{
+	m_numBytes = 0;
+	m_bufferSize = 0;
+
+	// according to FIPS 180-4
+	m_hash[0] = 0x6a09e667;
+	m_hash[1] = 0xbb67ae85;
+	m_hash[2] = 0x3c6ef372;
+	m_hash[3] = 0xa54ff53a;
+	m_hash[4] = 0x510e527f;
+	m_hash[5] = 0x9b05688c;
+	m_hash[6] = 0x1f83d9ab;
+	m_hash[7] = 0x5be0cd19;
+}
+
+namespace
+{
+	// round constants, first 32 bits of the fractional parts of the cube roots of the first 64 primes
+	const uint32_t k[64] = {
+		0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+		0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+		0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+		0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+		0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+		0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+		0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+		0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+	};
+
+	inline uint32_t rotate(uint32_t a, uint32_t c)
+	{
+		return (a >> c) | (a << (32 - c));
+	}
+
+	// mix functions for processBlock()
+	inline uint32_t f1(uint32_t e, uint32_t f, uint32_t g)
+	{
+		uint32_t term1 = rotate(e, 6) ^ rotate(e, 11) ^ rotate(e, 25);
+		uint32_t term2 = (e & f) ^ (~e & g);  // (g ^ (e & (f ^ g)))
+		return term1 + term2;
+	}
+
+	inline uint32_t f2(uint32_t a, uint32_t b, uint32_t c)
+	{
+		uint32_t term1 = rotate(a, 2) ^ rotate(a, 13) ^ rotate(a, 22);
+		uint32_t term2 = ((a | b) & c) | (a & b);  // (a & (b ^ c)) ^ (b & c);
+		return term1 + term2;
+	}
+}  // namespace
+
+/// process 64 bytes
+void SHA256::processBlock(const void* data)
+{
+	// get last hash
+	uint32_t a = m_hash[0];
+	uint32_t b = m_hash[1];
+	uint32_t c = m_hash[2];
+	uint32_t d = m_hash[3];
+	uint32_t e = m_hash[4];
+	uint32_t f = m_hash[5];
+	uint32_t g = m_hash[6];
+	uint32_t h = m_hash[7];
+
+	// data represented as 16x 32-bit words, computations are big endian
+	const uint8_t* bytes = (const uint8_t*)data;
+	uint32_t words[64];
+	int i;
+	for (i = 0; i < 16; i++)
+		words[i] = ((uint32_t)bytes[4 * i] << 24) | ((uint32_t)bytes[4 * i + 1] << 16) |
+		           ((uint32_t)bytes[4 * i + 2] << 8) | (uint32_t)bytes[4 * i + 3];
+
+	// extend to 64 words
+	for (; i < 64; i++)
+	{
+		uint32_t s0 = rotate(words[i - 15], 7) ^ rotate(words[i - 15], 18) ^ (words[i - 15] >> 3);
+		uint32_t s1 = rotate(words[i - 2], 17) ^ rotate(words[i - 2], 19) ^ (words[i - 2] >> 10);
+		words[i] = words[i - 16] + s0 + words[i - 7] + s1;
+	}
+
+	// 64 rounds
+	for (i = 0; i < 64; i++)
+	{
+		uint32_t x = h + f1(e, f, g) + k[i] + words[i];
+		uint32_t y = f2(a, b, c);
+		h = g;
+		g = f;
+		f = e;
+		e = d + x;
+		d = c;
+		c = b;
+		b = a;
+		a = x + y;
+	}
+
+	// update hash
+	m_hash[0] += a;
+	m_hash[1] += b;
+	m_hash[2] += c;
+	m_hash[3] += d;
+	m_hash[4] += e;
+	m_hash[5] += f;
+	m_hash[6] += g;
+	m_hash[7] += h;
+}
+
+/// add arbitrary number of bytes
+void SHA256::add(const void* data, size_t numBytes)
+{
+	const uint8_t* current = (const uint8_t*)data;
+
+	if (m_bufferSize > 0)
+	{
+		while (numBytes > 0 && m_bufferSize < BlockSize)
+		{
+			m_buffer[m_bufferSize++] = *current++;
+			numBytes--;
+		}
+	}
+
+	// full buffer
+	if (m_bufferSize == BlockSize)
+	{
+		processBlock(m_buffer);
+		m_numBytes += BlockSize;
+		m_bufferSize = 0;
+	}
+
+	// no more data ?
+	if (numBytes == 0)
+		return;
+
+	// process full blocks
+	while (numBytes >= BlockSize)
+	{
+		processBlock(current);
+		current += BlockSize;
+		m_numBytes += BlockSize;
+		numBytes -= BlockSize;
+	}
+
+	// keep remaining bytes in buffer
+	while (numBytes > 0)
+	{
+		m_buffer[m_bufferSize++] = *current++;
+		numBytes--;
+	}
+}
+
+/// process final block, less than 64 bytes
+void SHA256::processBuffer()
+{
+	// the input bytes are considered as bits strings, where the first bit is the most significant bit of the byte
+
+	// - append "1" bit to message
+	// - append "0" bits until message length in bit mod 512 is 448
+	// - append length as 64 bit integer
+
+	// number of bits
+	size_t paddedLength = m_bufferSize * 8;
+
+	// plus one bit set to 1 (always appended)
+	paddedLength++;
+
+	// number of bits must be (numBits % 512) = 448
+	size_t lower11Bits = paddedLength & 511;
+	if (lower11Bits <= 448)
+		paddedLength += 448 - lower11Bits;
+	else
+		paddedLength += 512 + 448 - lower11Bits;
+	// convert from bits to bytes
+	paddedLength /= 8;
+
+	// only needed if additional data flows over into a second block
+	unsigned char extra[BlockSize];
+
+	// append a "1" bit, 128 => binary 10000000
+	if (m_bufferSize < BlockSize)
+		m_buffer[m_bufferSize] = 128;
+	else
+		extra[0] = 128;
+
+	size_t i;
+	for (i = m_bufferSize + 1; i < BlockSize; i++)
+		m_buffer[i] = 0;
+	for (; i < paddedLength; i++)
+		extra[i - BlockSize] = 0;
+
+	// add message length in bits as 64 bit number
+	uint64_t msgBits = 8 * (m_numBytes + m_bufferSize);
+	// find right position
+	unsigned char* addLength;
+	if (paddedLength < BlockSize)
+		addLength = m_buffer + paddedLength;
+	else
+		addLength = extra + (paddedLength - BlockSize);
+
+	// must be big endian
+	*addLength++ = (unsigned char)((msgBits >> 56) & 0xFF);
+	*addLength++ = (unsigned char)((msgBits >> 48) & 0xFF);
+	*addLength++ = (unsigned char)((msgBits >> 40) & 0xFF);
+	*addLength++ = (unsigned char)((msgBits >> 32) & 0xFF);
+	*addLength++ = (unsigned char)((msgBits >> 24) & 0xFF);
+	*addLength++ = (unsigned char)((msgBits >> 16) & 0xFF);
+	*addLength++ = (unsigned char)((msgBits >> 8) & 0xFF);
+	*addLength = (unsigned char)(msgBits & 0xFF);
+
+	// process blocks
+	processBlock(m_buffer);
+	// flowed over into a second block ?
+	if (paddedLength > BlockSize)
+		processBlock(extra);
+}
+
+/// return latest hash as 64 hex characters
+std::string SHA256::getHash()
+{
+	// compute hash (as raw bytes)
+	unsigned char rawHash[HashBytes];
+	getHash(rawHash);
+
+	// convert to hex string
+	std::string result;
+	result.reserve(2 * HashBytes);
+	for (int i = 0; i < HashBytes; i++)
+	{
+		static const char dec2hex[16 + 1] = "0123456789abcdef";
+		result += dec2hex[(rawHash[i] >> 4) & 15];
+		result += dec2hex[rawHash[i] & 15];
+	}
+
+	return result;
+}
+
+/// return latest hash as bytes
+void SHA256::getHash(unsigned char buffer[SHA256::HashBytes])
+{
+	// save old hash if buffer is partially filled
+	uint32_t oldHash[HashValues];
+	for (int i = 0; i < HashValues; i++)
+		oldHash[i] = m_hash[i];
+
+	// process remaining bytes
+	processBuffer();
+
+	unsigned char* current = buffer;
+	for (int i = 0; i < HashValues; i++)
+	{
+		*current++ = (m_hash[i] >> 24) & 0xFF;
+		*current++ = (m_hash[i] >> 16) & 0xFF;
+		*current++ = (m_hash[i] >> 8) & 0xFF;
+		*current++ = m_hash[i] & 0xFF;
+
+		// restore old hash
+		m_hash[i] = oldHash[i];
+	}
+}
+
+/// compute SHA256 of a memory block
+std::string SHA256::operator()(const void* data, size_t numBytes)
+{
+	reset();
+	add(data, numBytes);
+	return getHash();
+}
+
+/// compute SHA256 of a string, excluding final zero
+std::string SHA256::operator()(const std::string& text)
+{
+	reset();
+	add(text.c_str(), text.size());
+	return getHash();
+}
@@ -0,0 +1,359 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+/// @file
+/// Bounded lock-free rings for handing packet pointers (such as RawPacket* or MBufRawPacket*) from one thread to
+/// another. SpscRing connects exactly one producer thread to exactly one consumer thread, MpmcRing may be used by any
+/// number of producers and consumers. Both support batch operations which claim several slots at once, so the cost of
+/// the shared index updates is paid once per batch instead of once per packet
+
+/// @namespace pcpp
+/// @brief The main namespace for the PcapPlusPlus lib
+namespace pcpp
+{
+	/// @cond PCPP_INTERNAL
+
+	namespace internal
+	{
+		/// The cache line size assumed when separating fields written by different threads
+		constexpr std::size_t RingCacheLineSize = 64;
+
+		/// Round a ring capacity up to the next power of 2
+		/// @param[in] capacity The requested capacity
+		/// @return The rounded capacity, or 0 if capacity is 0 or too large (an error is printed to log)
+		std::size_t roundUpRingCapacity(std::size_t capacity);
+
+		/// A base class for the classes holding cache line aligned members. Their alignment is larger than the one
+		/// the default operator new guarantees before C++17, so they're allocated with cache line aligned memory.
+		/// Like new (std::nothrow), a new-expression returns nullptr if the allocation fails
+		struct CacheLineAlignedAllocation
+		{
+			static void* operator new(std::size_t size) noexcept;
+			static void operator delete(void* ptr) noexcept;
+		};
+	}  // namespace internal
+
+	/// @endcond
+
+	/// @class SpscRing
+	/// A bounded single-producer single-consumer lock-free ring. One thread may call the push methods and one
+	/// (other) thread may call the pop methods concurrently. Each side keeps a private copy of the other side's index
+	/// and only reads the shared one when the copy says the ring is full (or empty), so in the common case a push or a
+	/// pop touches no cache line written by the other thread. The indices are aligned to separate cache lines.
+	/// @tparam T The element type. Must be trivially copyable; typically a packet pointer
+	template <typename T> class SpscRing : public internal::CacheLineAlignedAllocation
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "SpscRing elements must be trivially copyable");
+
+	public:
+		/// A c'tor for this class
+		/// @param[in] capacity The minimum number of elements the ring can hold. It's rounded up to a power of 2. If
+		/// it's 0 or too large an error is printed to log and the ring is invalid: it holds no elements and every
+		/// push and pop fails
+		explicit SpscRing(std::size_t capacity)
+		    : m_Capacity(internal::roundUpRingCapacity(capacity)), m_Mask(m_Capacity - 1),
+		      m_Buffer(m_Capacity > 0 ? new T[m_Capacity] : nullptr)
+		{}
+
+		SpscRing(const SpscRing&) = delete;
+		SpscRing& operator=(const SpscRing&) = delete;
+
+		/// Push an element. Must only be called from the producer thread
+		/// @param[in] item The element to push
+		/// @return True if the element was pushed, false if the ring is full
+		bool push(const T& item)
+		{
+			return pushBatch(&item, 1) == 1;
+		}
+
+		/// Push up to count elements, in order. Must only be called from the producer thread
+		/// @param[in] items The elements to push
+		/// @param[in] count The number of elements in items
+		/// @return The number of elements pushed, which is less than count if the ring became full
+		std::size_t pushBatch(const T* items, std::size_t count)
+		{
+			std::size_t tail = m_Producer.tail.load(std::memory_order_relaxed);
+			std::size_t freeSlots = m_Capacity - (tail - m_Producer.cachedHead);
+			if (freeSlots < count)
+			{
+				m_Producer.cachedHead = m_Consumer.head.load(std::memory_order_acquire);
+				freeSlots = m_Capacity - (tail - m_Producer.cachedHead);
+			}
+
+			if (count > freeSlots)
+				count = freeSlots;
+
+			for (std::size_t i = 0; i < count; ++i)
+				m_Buffer[(tail + i) & m_Mask] = items[i];
+
+			m_Producer.tail.store(tail + count, std::memory_order_release);
+			return count;
+		}
+
+		/// Pop an element. Must only be called from the consumer thread
+		/// @param[out] item The popped element
+		/// @return True if an element was popped, false if the ring is empty
+		bool pop(T& item)
+		{
+			return popBatch(&item, 1) == 1;
+		}
+
+		/// Pop up to maxCount elements, in the order they were pushed. Must only be called from the consumer thread
+		/// @param[out] items An array of at least maxCount elements to pop into
+		/// @param[in] maxCount The maximum number of elements to pop
+		/// @return The number of elements popped, 0 if the ring is empty
+		std::size_t popBatch(T* items, std::size_t maxCount)
+		{
+			std::size_t head = m_Consumer.head.load(std::memory_order_relaxed);
+			std::size_t available = m_Consumer.cachedTail - head;
+			if (available < maxCount)
+			{
+				m_Consumer.cachedTail = m_Producer.tail.load(std::memory_order_acquire);
+				available = m_Consumer.cachedTail - head;
+			}
+
+			if (maxCount > available)
+				maxCount = available;
+
+			for (std::size_t i = 0; i < maxCount; ++i)
+				items[i] = m_Buffer[(head + i) & m_Mask];
+
+			m_Consumer.head.store(head + maxCount, std::memory_order_release);
+			return maxCount;
+		}
+
+		/// @return The number of elements in the ring. When called concurrently with push or pop the value may
+		/// already be outdated when it's returned
+		std::size_t size() const
+		{
+			std::size_t head = m_Consumer.head.load(std::memory_order_acquire);
+			std::size_t tail = m_Producer.tail.load(std::memory_order_acquire);
+			return tail - head;
+		}
+
+		/// @return True if the ring has no elements. The same remark as in size() applies
+		bool isEmpty() const
+		{
+			return size() == 0;
+		}
+
+		/// @return The maximum number of elements the ring can hold
+		std::size_t capacity() const
+		{
+			return m_Capacity;
+		}
+
+		/// @return True if the ring was created with a valid capacity
+		bool isValid() const
+		{
+			return m_Capacity > 0;
+		}
+
+	private:
+		// each index is written by one side only and lives on its own cache line together with the private copy of
+		// the other side's index
+		struct alignas(internal::RingCacheLineSize) ProducerState
+		{
+			std::atomic<std::size_t> tail{ 0 };
+			std::size_t cachedHead = 0;
+		};
+
+		struct alignas(internal::RingCacheLineSize) ConsumerState
+		{
+			std::atomic<std::size_t> head{ 0 };
+			std::size_t cachedTail = 0;
+		};
+
+		ProducerState m_Producer;
+		ConsumerState m_Consumer;
+		alignas(internal::RingCacheLineSize) const std::size_t m_Capacity;
+		const std::size_t m_Mask;
+		std::unique_ptr<T[]> m_Buffer;
+	};
+
+	/// @class MpmcRing
+	/// A bounded multi-producer multi-consumer lock-free ring, based on Dmitry Vyukov's bounded MPMC queue. Every slot
+	/// has a sequence number which tells producers and consumers whether the slot is free or holds an element for the
+	/// current lap, so a push or a pop only contends on one shared index. It claims slots with a compare-and-swap on
+	/// that index and retries when another thread claimed them first, so under contention an operation may loop a
+	/// few times, but it never blocks on a lock. A slot which another producer claimed but hasn't filled yet reads as
+	/// empty, so a pop returns without it instead of waiting. The batch methods claim a run of consecutive ready slots
+	/// with a single compare-and-swap.
+	/// @tparam T The element type. Must be trivially copyable; typically a packet pointer
+	template <typename T> class MpmcRing : public internal::CacheLineAlignedAllocation
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "MpmcRing elements must be trivially copyable");
+
+	public:
+		/// A c'tor for this class
+		/// @param[in] capacity The minimum number of elements the ring can hold. It's rounded up to a power of 2. If
+		/// it's 0 or too large an error is printed to log and the ring is invalid: it holds no elements and every
+		/// push and pop fails
+		explicit MpmcRing(std::size_t capacity)
+		    : m_Capacity(internal::roundUpRingCapacity(capacity)), m_Mask(m_Capacity - 1),
+		      m_Slots(m_Capacity > 0 ? new Slot[m_Capacity] : nullptr)
+		{
+			for (std::size_t i = 0; i < m_Capacity; ++i)
+				m_Slots[i].sequence.store(i, std::memory_order_relaxed);
+		}
+
+		MpmcRing(const MpmcRing&) = delete;
+		MpmcRing& operator=(const MpmcRing&) = delete;
+
+		/// Push an element. May be called from any thread
+		/// @param[in] item The element to push
+		/// @return True if the element was pushed, false if the ring is full
+		bool push(const T& item)
+		{
+			return pushBatch(&item, 1) == 1;
+		}
+
+		/// Push up to count elements. The elements of one batch are stored in consecutive slots, so consumers see
+		/// them in order, but they may be interleaved with batches of other producers. May be called from any thread
+		/// @param[in] items The elements to push
+		/// @param[in] count The number of elements in items
+		/// @return The number of elements pushed, which is less than count if the ring became full
+		std::size_t pushBatch(const T* items, std::size_t count)
+		{
+			std::size_t pos = m_EnqueuePos.value.load(std::memory_order_relaxed);
+			std::size_t claimed;
+			while (true)
+			{
+				claimed = countReadySlots(pos, count, 0);
+				if (claimed == 0)
+				{
+					// the first slot is either still full (the ring is full) or was claimed by another producer
+					std::size_t currentPos = m_EnqueuePos.value.load(std::memory_order_relaxed);
+					if (currentPos == pos)
+						return 0;
+
+					pos = currentPos;
+					continue;
+				}
+
+				if (m_EnqueuePos.value.compare_exchange_weak(pos, pos + claimed, std::memory_order_relaxed))
+					break;
+			}
+
+			for (std::size_t i = 0; i < claimed; ++i)
+			{
+				Slot& slot = m_Slots[(pos + i) & m_Mask];
+				slot.data = items[i];
+				slot.sequence.store(pos + i + 1, std::memory_order_release);
+			}
+
+			return claimed;
+		}
+
+		/// Pop an element. May be called from any thread
+		/// @param[out] item The popped element
+		/// @return True if an element was popped, false if the ring is empty
+		bool pop(T& item)
+		{
+			return popBatch(&item, 1) == 1;
+		}
+
+		/// Pop up to maxCount elements stored in consecutive slots. May be called from any thread
+		/// @param[out] items An array of at least maxCount elements to pop into
+		/// @param[in] maxCount The maximum number of elements to pop
+		/// @return The number of elements popped, 0 if the ring is empty
+		std::size_t popBatch(T* items, std::size_t maxCount)
+		{
+			std::size_t pos = m_DequeuePos.value.load(std::memory_order_relaxed);
+			std::size_t claimed;
+			while (true)
+			{
+				claimed = countReadySlots(pos, maxCount, 1);
+				if (claimed == 0)
+				{
+					std::size_t currentPos = m_DequeuePos.value.load(std::memory_order_relaxed);
+					if (currentPos == pos)
+						return 0;
+
+					pos = currentPos;
+					continue;
+				}
+
+				if (m_DequeuePos.value.compare_exchange_weak(pos, pos + claimed, std::memory_order_relaxed))
+					break;
+			}
+
+			for (std::size_t i = 0; i < claimed; ++i)
+			{
+				Slot& slot = m_Slots[(pos + i) & m_Mask];
+				items[i] = slot.data;
+				slot.sequence.store(pos + i + m_Capacity, std::memory_order_release);
+			}
+
+			return claimed;
+		}
+
+		/// @return The approximate number of elements in the ring. Elements which are being pushed or popped while
+		/// this method runs may or may not be counted
+		std::size_t size() const
+		{
+			std::size_t dequeuePos = m_DequeuePos.value.load(std::memory_order_acquire);
+			std::size_t enqueuePos = m_EnqueuePos.value.load(std::memory_order_acquire);
+			return enqueuePos > dequeuePos ? enqueuePos - dequeuePos : 0;
+		}
+
+		/// @return True if the ring has no elements. The same remark as in size() applies
+		bool isEmpty() const
+		{
+			return size() == 0;
+		}
+
+		/// @return The maximum number of elements the ring can hold
+		std::size_t capacity() const
+		{
+			return m_Capacity;
+		}
+
+		/// @return True if the ring was created with a valid capacity
+		bool isValid() const
+		{
+			return m_Capacity > 0;
+		}
+
+	private:
+		struct Slot
+		{
+			std::atomic<std::size_t> sequence;
+			T data;
+		};
+
+		struct alignas(internal::RingCacheLineSize) AlignedIndex
+		{
+			std::atomic<std::size_t> value{ 0 };
+		};
+
+		AlignedIndex m_EnqueuePos;
+		AlignedIndex m_DequeuePos;
+		alignas(internal::RingCacheLineSize) const std::size_t m_Capacity;
+		const std::size_t m_Mask;
+		std::unique_ptr<Slot[]> m_Slots;
+
+		// count the consecutive slots starting at pos which are ready for the operation: a slot is free for a
+		// producer at position p when its sequence is p, and holds an element for a consumer when it's p + 1. Once the
+		// claiming compare-and-swap succeeds these slots can't be taken by another thread
+		std::size_t countReadySlots(std::size_t pos, std::size_t maxCount, std::size_t sequenceOffset) const
+		{
+			if (maxCount > m_Capacity)
+				maxCount = m_Capacity;
+
+			std::size_t count = 0;
+			while (count < maxCount &&
+			       m_Slots[(pos + count) & m_Mask].sequence.load(std::memory_order_acquire) ==
+			           pos + count + sequenceOffset)
+			{
+				++count;
+			}
+
+			return count;
+		}
+	};
+}  // namespace pcpp
@@ -109,6 +109,7 @@ namespace pcpp
 		PcapLogModuleKniDevice,          ///< KniDevice module (Pcap++)
 		PcapLogModuleXdpDevice,          ///< XdpDevice module (Pcap++)
 		PcapLogModuleNetworkUtils,       ///< Network Utils module (Pcap++)
+		PcapLogModuleSoftwareRss,        ///< SoftwareRss module (Pcap++)
 		NumOfLogModules
 	};
 
@@ -2,6 +2,7 @@
 
 #include "MacAddress.h"
 
+#include <memory>
 #include <unordered_map>
 #include <vector>
 
@@ -17,6 +18,12 @@ namespace pcpp
 	/// will return "Unknown" as vendor. The class itself currently does not support on-fly modifying the database but
 	/// anyone who wants to add/modify/remove entries, should modify 3rdParty/OUILookup/PCPP_OUIDatabase.json file and
 	/// call to initOUIDatabaseFromJson() function to renew the internal data.
+	///
+	/// Parsing the JSON database takes a noticeable time and memory. Applications that start often can convert it
+	/// once with compileOUIDatabase() and load the result with initOUIDatabaseFromBinary(). The binary database is a
+	/// sorted table of (MAC prefix, mask length, vendor name offset) entries followed by a pool of unique vendor names.
+	/// It's memory-mapped read-only, so loading it takes no parsing and processes using the same file share its
+	/// memory. Lookups are binary searches over the table, trying the longest mask length first
 	class OUILookup
 	{
 	private:
@@ -46,6 +53,10 @@ namespace pcpp
 		/// Internal vendor list for MAC addresses
 		OUIVendorMap vendorMap;
 
+		/// A memory-mapped binary database, shared between copies of this object
+		struct MappedDatabase;
+		std::shared_ptr<const MappedDatabase> mappedDatabase;
+
 		template <typename T> int64_t internalParser(T& jsonData);
 
 	public:
@@ -55,6 +66,19 @@ namespace pcpp
 		/// @return Returns the number of total vendors, negative on errors
 		int64_t initOUIDatabaseFromJson(const std::string& path = "");
 
+		/// Initialise internal OUI database from a binary file created by compileOUIDatabase(). The file is
+		/// memory-mapped and stays mapped until another database is loaded or this object is destroyed
+		/// @param[in] path Path to the binary OUI database
+		/// @return Returns the number of total vendors, negative on errors
+		int64_t initOUIDatabaseFromBinary(const std::string& path);
+
+		/// Convert a JSON OUI database to the binary format loaded by initOUIDatabaseFromBinary(). The binary file
+		/// uses the byte order of the machine that created it and is rejected on machines with a different byte order
+		/// @param[in] jsonPath Path to the JSON OUI database, usually 3rdParty/OUIDataset/PCPP_OUIDataset.json
+		/// @param[in] binaryPath Path of the binary file to create
+		/// @return Returns the number of total vendors written, negative on errors
+		static int64_t compileOUIDatabase(const std::string& jsonPath, const std::string& binaryPath);
+
 		/// Returns the vendor of the MAC address. OUI database should be initialized with initOUIDatabaseFromJson()
 		/// @param[in] addr MAC address to search
 		/// @return Vendor name
@@ -0,0 +1,286 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "LockFreeRing.h"
+
+/// @file
+/// A helper which connects a packet source (for example the callback of a capture device) to a fixed number of
+/// worker threads. Each worker has its own SpscRing which the source pushes packet pointers into, and the worker
+/// drains it in batches
+
+/// @namespace pcpp
+/// @brief The main namespace for the PcapPlusPlus lib
+namespace pcpp
+{
+	/// @cond PCPP_INTERNAL
+
+	namespace internal
+	{
+		/// Check the parameters of a PacketPipeline
+		/// @return True if the worker count and batch size are greater than 0 and there's a worker callback,
+		/// otherwise an error is printed to log and false is returned
+		bool isValidPacketPipelineConfig(uint32_t workerCount, std::size_t maxBatchSize, bool hasWorkerCallback);
+	}  // namespace internal
+
+	/// @endcond
+
+	/// @class PacketPipeline
+	/// Hands packets from one producer thread to N worker threads over per-worker SpscRing rings. The producer
+	/// chooses the worker of each packet (round-robin by default, or explicitly, for example by a flow hash so all
+	/// packets of a flow reach the same worker). Workers call the user callback with batches of packets in the order
+	/// they were pushed to that worker.
+	///
+	/// When a worker's ring is full the pipeline applies backpressure: with BlockWhenFull the producer waits until
+	/// the worker frees a slot, with DropWhenFull the push fails, the packet is counted as dropped and stays owned by
+	/// the caller. Ownership of a pushed packet moves to the worker callback, the pipeline never frees packets.
+	///
+	/// All push methods must be called from the same thread (or from threads synchronized externally). To feed
+	/// workers from several producers, use one pipeline per producer or an MpmcRing directly.
+	/// @tparam T The element type, typically RawPacket* or MBufRawPacket*
+	template <typename T> class PacketPipeline
+	{
+	public:
+		/// The callback a worker calls with each batch of packets it pops
+		/// @param[in] items The packets, in the order they were pushed to this worker
+		/// @param[in] count The number of packets in items
+		/// @param[in] workerIndex The index of the worker, between 0 and the worker count - 1
+		using WorkerCallback = std::function<void(T* items, std::size_t count, uint32_t workerIndex)>;
+
+		/// What a push does when the worker's ring is full
+		enum BackpressurePolicy
+		{
+			/// Wait until the worker frees a slot
+			BlockWhenFull,
+			/// Fail the push and count the packet as dropped
+			DropWhenFull
+		};
+
+		/// A c'tor for this class. The workers aren't started until start() is called. If workerCount, ringCapacity or
+		/// maxBatchSize is 0 or the callback is empty, an error is printed to log and the pipeline is invalid (see
+		/// isValid()): it has no workers and can't be started
+		/// @param[in] workerCount The number of worker threads
+		/// @param[in] ringCapacity The capacity of each worker's ring, rounded up to a power of 2
+		/// @param[in] workerCallback The callback the workers call with each batch of packets
+		/// @param[in] policy What a push does when the worker's ring is full. The default is BlockWhenFull
+		/// @param[in] maxBatchSize The maximum number of packets passed to one callback call. The default is 64
+		PacketPipeline(uint32_t workerCount, std::size_t ringCapacity, WorkerCallback workerCallback,
+		               BackpressurePolicy policy = BlockWhenFull, std::size_t maxBatchSize = 64)
+		    : m_WorkerCallback(std::move(workerCallback)), m_Policy(policy), m_MaxBatchSize(maxBatchSize)
+		{
+			if (!internal::isValidPacketPipelineConfig(workerCount, maxBatchSize, static_cast<bool>(m_WorkerCallback)))
+				return;
+
+			m_Workers.reserve(workerCount);
+			for (uint32_t i = 0; i < workerCount; ++i)
+			{
+				std::unique_ptr<Worker> worker(new Worker(ringCapacity));
+				if (worker == nullptr || !worker->ring.isValid())
+				{
+					m_Workers.clear();
+					return;
+				}
+
+				m_Workers.push_back(std::move(worker));
+			}
+		}
+
+		PacketPipeline(const PacketPipeline&) = delete;
+		PacketPipeline& operator=(const PacketPipeline&) = delete;
+
+		/// A d'tor for this class. Stops the workers if they're running, see stop()
+		~PacketPipeline()
+		{
+			stop();
+		}
+
+		/// Start the worker threads
+		/// @return True if the workers were started, false if they're already running or the pipeline is invalid
+		bool start()
+		{
+			if (m_Running || !isValid())
+				return false;
+
+			m_StopRequested.store(false, std::memory_order_relaxed);
+			for (uint32_t i = 0; i < m_Workers.size(); ++i)
+				m_Workers[i]->thread = std::thread(&PacketPipeline::workerMain, this, i);
+
+			m_Running = true;
+			return true;
+		}
+
+		/// Stop the worker threads. Packets pushed before this call are still passed to the callback before the
+		/// workers exit. Must be called from the producer thread or after the producer stopped pushing
+		void stop()
+		{
+			if (!m_Running)
+				return;
+
+			m_StopRequested.store(true, std::memory_order_release);
+			for (auto& worker : m_Workers)
+				worker->thread.join();
+
+			m_Running = false;
+		}
+
+		/// Push a packet to the next worker in round-robin order
+		/// @param[in] item The packet to push
+		/// @return True if the packet was pushed, false if the pipeline isn't running or the worker's ring is full
+		/// and the policy is DropWhenFull
+		bool push(const T& item)
+		{
+			uint32_t workerIndex = m_NextWorker;
+			if (++m_NextWorker == m_Workers.size())
+				m_NextWorker = 0;
+
+			return push(item, workerIndex);
+		}
+
+		/// Push a packet to a specific worker
+		/// @param[in] item The packet to push
+		/// @param[in] workerIndex The worker index. It's taken modulo the worker count, so a hash may be passed
+		/// @return True if the packet was pushed, false if the pipeline isn't running or the worker's ring is full
+		/// and the policy is DropWhenFull
+		bool push(const T& item, uint32_t workerIndex)
+		{
+			return pushBatch(&item, 1, workerIndex) == 1;
+		}
+
+		/// Push a batch of packets to a specific worker
+		/// @param[in] items The packets to push
+		/// @param[in] count The number of packets in items
+		/// @param[in] workerIndex The worker index. It's taken modulo the worker count, so a hash may be passed
+		/// @return The number of packets pushed. With DropWhenFull the packets which weren't pushed (the tail of the
+		/// batch) are counted as dropped and stay owned by the caller. With BlockWhenFull all packets are pushed
+		/// unless the pipeline isn't running
+		std::size_t pushBatch(const T* items, std::size_t count, uint32_t workerIndex)
+		{
+			if (!m_Running)
+				return 0;
+
+			SpscRing<T>& ring = m_Workers[workerIndex % m_Workers.size()]->ring;
+			std::size_t pushed = ring.pushBatch(items, count);
+			if (pushed == count)
+				return pushed;
+
+			if (m_Policy == DropWhenFull)
+			{
+				m_DroppedCount.fetch_add(count - pushed, std::memory_order_relaxed);
+				return pushed;
+			}
+
+			m_BlockedCount.fetch_add(1, std::memory_order_relaxed);
+			while (pushed < count)
+			{
+				std::size_t newlyPushed = ring.pushBatch(items + pushed, count - pushed);
+				if (newlyPushed == 0)
+					std::this_thread::yield();
+
+				pushed += newlyPushed;
+			}
+
+			return pushed;
+		}
+
+		/// @return True if the pipeline was created with valid parameters
+		bool isValid() const
+		{
+			return !m_Workers.empty();
+		}
+
+		/// @return The number of worker threads, 0 if the pipeline is invalid
+		uint32_t getWorkerCount() const
+		{
+			return static_cast<uint32_t>(m_Workers.size());
+		}
+
+		/// @return True if the workers were started and not stopped yet
+		bool isRunning() const
+		{
+			return m_Running;
+		}
+
+		/// @return The number of packets dropped because a worker's ring was full (DropWhenFull only)
+		uint64_t getDroppedCount() const
+		{
+			return m_DroppedCount.load(std::memory_order_relaxed);
+		}
+
+		/// @return The number of pushes which had to wait for a worker because its ring was full (BlockWhenFull
+		/// only). A growing value means the workers can't keep up with the producer
+		uint64_t getBlockedCount() const
+		{
+			return m_BlockedCount.load(std::memory_order_relaxed);
+		}
+
+		/// @param[in] workerIndex The worker index
+		/// @return The number of packets the worker passed to the callback so far, or 0 if the index is out of range
+		uint64_t getProcessedCount(uint32_t workerIndex) const
+		{
+			if (workerIndex >= m_Workers.size())
+				return 0;
+
+			return m_Workers[workerIndex]->processedCount.load(std::memory_order_relaxed);
+		}
+
+	private:
+		// the worker's ring has cache line aligned members
+		struct Worker : public internal::CacheLineAlignedAllocation
+		{
+			explicit Worker(std::size_t ringCapacity) : ring(ringCapacity)
+			{}
+
+			SpscRing<T> ring;
+			std::thread thread;
+			std::atomic<uint64_t> processedCount{ 0 };
+		};
+
+		// an idle worker spins this many times before yielding, and yields this many times before sleeping
+		static constexpr int IdleSpinCount = 64;
+		static constexpr int IdleYieldCount = 64;
+
+		WorkerCallback m_WorkerCallback;
+		BackpressurePolicy m_Policy;
+		std::size_t m_MaxBatchSize;
+		std::vector<std::unique_ptr<Worker>> m_Workers;
+		uint32_t m_NextWorker = 0;
+		bool m_Running = false;
+		std::atomic<bool> m_StopRequested{ false };
+		std::atomic<uint64_t> m_DroppedCount{ 0 };
+		std::atomic<uint64_t> m_BlockedCount{ 0 };
+
+		void workerMain(uint32_t workerIndex)
+		{
+			Worker& worker = *m_Workers[workerIndex];
+			std::vector<T> batch(m_MaxBatchSize);
+			int idleRounds = 0;
+			while (true)
+			{
+				// read the stop flag before popping, so packets pushed before stop() are drained by the last pop
+				bool stopRequested = m_StopRequested.load(std::memory_order_acquire);
+				std::size_t count = worker.ring.popBatch(batch.data(), m_MaxBatchSize);
+				if (count > 0)
+				{
+					m_WorkerCallback(batch.data(), count, workerIndex);
+					worker.processedCount.fetch_add(count, std::memory_order_relaxed);
+					idleRounds = 0;
+					continue;
+				}
+
+				if (stopRequested)
+					break;
+
+				++idleRounds;
+				if (idleRounds > IdleSpinCount + IdleYieldCount)
+					std::this_thread::sleep_for(std::chrono::microseconds(50));
+				else if (idleRounds > IdleSpinCount)
+					std::this_thread::yield();
+			}
+		}
+	};
+}  // namespace pcpp
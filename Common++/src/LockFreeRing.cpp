@@ -0,0 +1,62 @@
+#define LOG_MODULE CommonLogModuleGenericUtils
+
+#include "LockFreeRing.h"
+#include "Logger.h"
+#include <cstdlib>
+#if defined(_WIN32)
+#	include <malloc.h>
+#endif
+
+namespace pcpp
+{
+	namespace internal
+	{
+		std::size_t roundUpRingCapacity(std::size_t capacity)
+		{
+			if (capacity == 0)
+			{
+				PCPP_LOG_ERROR("Ring capacity must be greater than 0");
+				return 0;
+				// throw std::invalid_argument("Ring capacity must be greater than 0");
+			}
+
+			std::size_t roundedCapacity = 1;
+			while (roundedCapacity < capacity)
+			{
+				roundedCapacity <<= 1;
+				if (roundedCapacity == 0)
+				{
+					PCPP_LOG_ERROR("Ring capacity " << capacity << " is too large");
+					return 0;
+					// throw std::invalid_argument("Ring capacity is too large");
+				}
+			}
+
+			return roundedCapacity;
+		}
+
+		void* CacheLineAlignedAllocation::operator new(std::size_t size) noexcept
+		{
+			void* ptr = nullptr;
+#if defined(_WIN32)
+			ptr = _aligned_malloc(size, RingCacheLineSize);
+#else
+			if (posix_memalign(&ptr, RingCacheLineSize, size) != 0)
+				ptr = nullptr;
+#endif
+			if (ptr == nullptr)
+				PCPP_LOG_ERROR("Cannot allocate " << size << " bytes of cache line aligned memory");
+
+			return ptr;
+		}
+
+		void CacheLineAlignedAllocation::operator delete(void* ptr) noexcept
+		{
+#if defined(_WIN32)
+			_aligned_free(ptr);
+#else
+			free(ptr);
+#endif
+		}
+	}  // namespace internal
+}  // namespace pcpp
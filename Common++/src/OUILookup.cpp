@@ -3,14 +3,192 @@
 
 #include "json.hpp"
 
+#include <algorithm>
+#include <cstring>
 #include <fstream>
+#include <functional>
+
+#if defined(_WIN32)
+#	include <windows.h>
+#else
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
 
 namespace pcpp
 {
+	namespace
+	{
+		constexpr char BinaryOUIMagic[8] = { 'P', 'C', 'P', 'P', 'O', 'U', 'I', '\0' };
+		constexpr uint32_t BinaryOUIVersion = 1;
+		constexpr uint32_t BinaryOUIByteOrderMark = 0x01020304;
+		constexpr size_t BinaryOUIMaxMaskLengths = 8;
+		constexpr uint8_t OUIMaskLength = 24;
+
+#pragma pack(push, 1)
+		/// The header of the binary OUI database. It's followed by the entry table and the vendor name pool
+		struct BinaryOUIHeader
+		{
+			char magic[8];
+			uint32_t version;
+			uint32_t byteOrderMark;
+			uint32_t entryCount;
+			uint32_t stringPoolSize;
+			/// The distinct mask lengths used by the entries in descending order, zero padded
+			uint8_t maskLengths[BinaryOUIMaxMaskLengths];
+		};
+
+		/// A single entry of the binary OUI database. Entries are sorted by (prefix, maskLength)
+		struct BinaryOUIEntry
+		{
+			/// The 48-bit MAC address prefix, with the bits beyond maskLength cleared
+			uint64_t prefix;
+			/// The vendor name offset in the name pool
+			uint32_t nameOffset;
+			uint16_t nameLength;
+			uint8_t maskLength;
+			uint8_t reserved;
+		};
+#pragma pack(pop)
+
+		static_assert(sizeof(BinaryOUIHeader) == 32, "Unexpected binary OUI header size");
+		static_assert(sizeof(BinaryOUIEntry) == 16, "Unexpected binary OUI entry size");
+
+		inline uint64_t prefixMask(uint8_t maskLength)
+		{
+			return (0xffffffffffffULL >> (48 - maskLength)) << (48 - maskLength);
+		}
+
+		inline bool entryLess(const BinaryOUIEntry& entry, uint64_t prefix, uint8_t maskLength)
+		{
+			return entry.prefix < prefix || (entry.prefix == prefix && entry.maskLength < maskLength);
+		}
+	}  // namespace
+
+	struct OUILookup::MappedDatabase
+	{
+		const uint8_t* data = nullptr;
+		size_t size = 0;
+		const BinaryOUIHeader* header = nullptr;
+		const BinaryOUIEntry* entries = nullptr;
+		const char* stringPool = nullptr;
+#if defined(_WIN32)
+		HANDLE fileHandle = INVALID_HANDLE_VALUE;
+		HANDLE mappingHandle = nullptr;
+#endif
+
+		MappedDatabase() = default;
+		MappedDatabase(const MappedDatabase&) = delete;
+		MappedDatabase& operator=(const MappedDatabase&) = delete;
+
+		~MappedDatabase()
+		{
+#if defined(_WIN32)
+			if (data != nullptr)
+				UnmapViewOfFile(data);
+			if (mappingHandle != nullptr)
+				CloseHandle(mappingHandle);
+			if (fileHandle != INVALID_HANDLE_VALUE)
+				CloseHandle(fileHandle);
+#else
+			if (data != nullptr)
+				munmap(const_cast<uint8_t*>(data), size);
+#endif
+		}
+
+		/// Map the file read-only. On failure the object is left empty
+		bool map(const std::string& path)
+		{
+#if defined(_WIN32)
+			fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+			                         FILE_ATTRIBUTE_NORMAL, nullptr);
+			if (fileHandle == INVALID_HANDLE_VALUE)
+				return false;
+
+			LARGE_INTEGER fileSize;
+			if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0)
+				return false;
+
+			mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (mappingHandle == nullptr)
+				return false;
+
+			data = static_cast<const uint8_t*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+			size = static_cast<size_t>(fileSize.QuadPart);
+			return data != nullptr;
+#else
+			int fd = open(path.c_str(), O_RDONLY);
+			if (fd < 0)
+				return false;
+
+			struct stat fileStat;
+			if (fstat(fd, &fileStat) != 0 || fileStat.st_size == 0)
+			{
+				close(fd);
+				return false;
+			}
+
+			void* mapped = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_SHARED, fd, 0);
+			close(fd);
+			if (mapped == MAP_FAILED)
+				return false;
+
+			data = static_cast<const uint8_t*>(mapped);
+			size = static_cast<size_t>(fileStat.st_size);
+			return true;
+#endif
+		}
+
+		/// Validate the header and the table bounds and set the section pointers
+		bool validate()
+		{
+			if (size < sizeof(BinaryOUIHeader))
+				return false;
+
+			header = reinterpret_cast<const BinaryOUIHeader*>(data);
+			if (memcmp(header->magic, BinaryOUIMagic, sizeof(BinaryOUIMagic)) != 0 ||
+			    header->version != BinaryOUIVersion || header->byteOrderMark != BinaryOUIByteOrderMark)
+				return false;
+
+			uint64_t expectedSize = sizeof(BinaryOUIHeader) +
+			                        static_cast<uint64_t>(header->entryCount) * sizeof(BinaryOUIEntry) +
+			                        header->stringPoolSize;
+			if (expectedSize != size)
+				return false;
+
+			entries = reinterpret_cast<const BinaryOUIEntry*>(data + sizeof(BinaryOUIHeader));
+			stringPool = reinterpret_cast<const char*>(entries + header->entryCount);
+			return true;
+		}
+
+		const BinaryOUIEntry* find(uint64_t macAddr) const
+		{
+			const BinaryOUIEntry* end = entries + header->entryCount;
+			for (uint8_t maskLength : header->maskLengths)
+			{
+				if (maskLength == 0)
+					break;
+
+				uint64_t prefix = macAddr & prefixMask(maskLength);
+				const BinaryOUIEntry* found =
+				    std::lower_bound(entries, end, prefix, [maskLength](const BinaryOUIEntry& entry, uint64_t value) {
+					    return entryLess(entry, value, maskLength);
+				    });
+				if (found != end && found->prefix == prefix && found->maskLength == maskLength)
+					return found;
+			}
+
+			return nullptr;
+		}
+	};
+
 	template <typename T> int64_t OUILookup::internalParser(T& jsonData)
 	{
 		// Clear all entries before adding
 		vendorMap.clear();
+		mappedDatabase.reset();
 
 		int64_t ctrRead = 0;
 		nlohmann::json parsedJson = nlohmann::json::parse(jsonData);
@@ -83,9 +261,138 @@ namespace pcpp
 		return internalParser(dataFile);
 	}
 
+	int64_t OUILookup::initOUIDatabaseFromBinary(const std::string& path)
+	{
+		vendorMap.clear();
+		mappedDatabase.reset();
+
+		std::shared_ptr<MappedDatabase> database = std::make_shared<MappedDatabase>();
+		if (!database->map(path))
+		{
+			PCPP_LOG_ERROR("Can't map binary OUI database '" << path << "'");
+			return -1;
+		}
+
+		if (!database->validate())
+		{
+			PCPP_LOG_ERROR("'" << path << "' isn't a valid binary OUI database for this machine");
+			return -1;
+		}
+
+		// verify that all names are inside the pool so lookups don't need to check them
+		const BinaryOUIEntry* entries = database->entries;
+		for (uint32_t i = 0; i < database->header->entryCount; ++i)
+		{
+			if (static_cast<uint64_t>(entries[i].nameOffset) + entries[i].nameLength >
+			    database->header->stringPoolSize)
+			{
+				PCPP_LOG_ERROR("Binary OUI database '" << path << "' has an invalid entry at index " << i);
+				return -1;
+			}
+		}
+
+		int64_t entryCount = database->header->entryCount;
+		mappedDatabase = std::move(database);
+		PCPP_LOG_DEBUG(std::to_string(entryCount) + " vendors mapped successfully");
+		return entryCount;
+	}
+
+	int64_t OUILookup::compileOUIDatabase(const std::string& jsonPath, const std::string& binaryPath)
+	{
+		OUILookup source;
+		if (source.initOUIDatabaseFromJson(jsonPath) < 0)
+			return -1;
+
+		std::vector<BinaryOUIEntry> entries;
+		std::vector<uint8_t> maskLengths;
+		std::string stringPool;
+		std::unordered_map<std::string, uint32_t> nameOffsets;
+
+		auto addEntry = [&](uint64_t prefix, int maskLength, const std::string& name) -> bool {
+			if (maskLength <= 0 || maskLength > 48 || name.size() > UINT16_MAX)
+			{
+				PCPP_LOG_ERROR("Can't compile OUI entry '" << name << "' with mask length " << maskLength);
+				return false;
+			}
+
+			auto nameIter = nameOffsets.find(name);
+			if (nameIter == nameOffsets.end())
+			{
+				nameIter = nameOffsets.emplace(name, static_cast<uint32_t>(stringPool.size())).first;
+				stringPool += name;
+			}
+
+			BinaryOUIEntry entry;
+			entry.maskLength = static_cast<uint8_t>(maskLength);
+			entry.prefix = prefix & prefixMask(entry.maskLength);
+			entry.nameOffset = nameIter->second;
+			entry.nameLength = static_cast<uint16_t>(name.size());
+			entry.reserved = 0;
+			entries.push_back(entry);
+
+			if (std::find(maskLengths.begin(), maskLengths.end(), entry.maskLength) == maskLengths.end())
+				maskLengths.push_back(entry.maskLength);
+			return true;
+		};
+
+		for (const auto& vendor : source.vendorMap)
+		{
+			if (!addEntry(vendor.first << 24, OUIMaskLength, vendor.second.vendorName))
+				return -1;
+
+			for (const auto& filter : vendor.second.maskedFilter)
+			{
+				for (const auto& maskedVendor : filter.vendorMap)
+				{
+					if (!addEntry(maskedVendor.first, filter.mask, maskedVendor.second))
+						return -1;
+				}
+			}
+		}
+
+		if (maskLengths.size() > BinaryOUIMaxMaskLengths)
+		{
+			PCPP_LOG_ERROR("OUI database uses more than " << BinaryOUIMaxMaskLengths << " different mask lengths");
+			return -1;
+		}
+
+		std::sort(entries.begin(), entries.end(), [](const BinaryOUIEntry& first, const BinaryOUIEntry& second) {
+			return entryLess(first, second.prefix, second.maskLength);
+		});
+		std::sort(maskLengths.begin(), maskLengths.end(), std::greater<uint8_t>());
+
+		BinaryOUIHeader header;
+		memset(&header, 0, sizeof(header));
+		memcpy(header.magic, BinaryOUIMagic, sizeof(BinaryOUIMagic));
+		header.version = BinaryOUIVersion;
+		header.byteOrderMark = BinaryOUIByteOrderMark;
+		header.entryCount = static_cast<uint32_t>(entries.size());
+		header.stringPoolSize = static_cast<uint32_t>(stringPool.size());
+		std::copy(maskLengths.begin(), maskLengths.end(), header.maskLengths);
+
+		std::ofstream outFile(binaryPath, std::ios::binary | std::ios::trunc);
+		if (!outFile.is_open())
+		{
+			PCPP_LOG_ERROR(std::string("Can't create binary OUI database: ") + getErrorString(errno));
+			return -1;
+		}
+
+		outFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		outFile.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(BinaryOUIEntry));
+		outFile.write(stringPool.data(), stringPool.size());
+		if (!outFile.good())
+		{
+			PCPP_LOG_ERROR("Failed to write binary OUI database '" << binaryPath << "'");
+			return -1;
+		}
+
+		PCPP_LOG_DEBUG(std::to_string(entries.size()) + " vendors written to binary OUI database");
+		return static_cast<int64_t>(entries.size());
+	}
+
 	std::string OUILookup::getVendorName(const pcpp::MacAddress& addr)
 	{
-		if (vendorMap.empty())
+		if (vendorMap.empty() && mappedDatabase == nullptr)
 		{
 			PCPP_LOG_DEBUG("Vendor map is empty");
 		}
@@ -98,6 +405,17 @@ namespace pcpp
 		                          ((uint64_t)((buffArray)[3]) << 16) + ((uint64_t)((buffArray)[2]) << 24) +
 		                          ((uint64_t)((buffArray)[1]) << 32) + ((uint64_t)((buffArray)[0]) << 40));
 
+		if (mappedDatabase != nullptr)
+		{
+			const BinaryOUIEntry* entry = mappedDatabase->find(macAddr);
+			if (entry == nullptr)
+			{
+				return "Unknown";
+			}
+
+			return std::string(mappedDatabase->stringPool + entry->nameOffset, entry->nameLength);
+		}
+
 		auto itr = vendorMap.find(macAddr >> 24);
 		if (itr == vendorMap.end())
 		{
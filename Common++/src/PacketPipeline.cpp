@@ -0,0 +1,33 @@
+#define LOG_MODULE CommonLogModuleGenericUtils
+
+#include "PacketPipeline.h"
+#include "Logger.h"
+
+namespace pcpp
+{
+	namespace internal
+	{
+		bool isValidPacketPipelineConfig(uint32_t workerCount, std::size_t maxBatchSize, bool hasWorkerCallback)
+		{
+			if (workerCount == 0)
+			{
+				PCPP_LOG_ERROR("Pipeline worker count must be greater than 0");
+				return false;
+			}
+
+			if (maxBatchSize == 0)
+			{
+				PCPP_LOG_ERROR("Pipeline batch size must be greater than 0");
+				return false;
+			}
+
+			if (!hasWorkerCallback)
+			{
+				PCPP_LOG_ERROR("Pipeline worker callback must not be empty");
+				return false;
+			}
+
+			return true;
+		}
+	}  // namespace internal
+}  // namespace pcpp
@@ -1,16 +1,33 @@
 #include <Packet.h>
 #include <PcapFileDevice.h>
+#include <FilterSet.h>
+#include <LockFreeRing.h>
+#include <NativeFilter.h>
+#include <PacketPipeline.h>
+#include <PcapFilter.h>
 #include <PcapPlusPlusVersion.h>
+#include <PacketBuilder.h>
+#include <PacketTemplate.h>
+#include <PacketUtils.h>
+#include <SoftwareRss.h>
 
 #include <EthLayer.h>
 #include <IPv4Layer.h>
 #include <IPv6Layer.h>
+#include <PayloadLayer.h>
+#include <SSLLayer.h>
 #include <TcpLayer.h>
+#include <TLSFingerprintExtractor.h>
 #include <UdpLayer.h>
 
 #include <benchmark/benchmark.h>
 
+#include <atomic>
+#include <bitset>
 #include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
 
 static std::string pcapFileName = "";
 
@@ -55,6 +72,62 @@ static void BM_PcapFileRead(benchmark::State& state)
 }
 BENCHMARK(BM_PcapFileRead);
 
+static void BM_PcapNgFileRead(benchmark::State& state)
+{
+	// Convert the input pcap file to pcapng, outside of the measured loop
+	const std::string pcapngFileName = "benchmark-input.pcapng";
+	{
+		pcpp::PcapFileReaderDevice pcapReader(pcapFileName);
+		pcpp::PcapNgFileWriterDevice pcapngWriter(pcapngFileName);
+		if (!pcapReader.open() || !pcapngWriter.open())
+		{
+			state.SkipWithError("Cannot convert pcap file to pcapng");
+			return;
+		}
+
+		pcpp::RawPacket rawPacket;
+		while (pcapReader.getNextPacket(rawPacket))
+			pcapngWriter.writePacket(rawPacket);
+	}
+
+	pcpp::PcapNgFileReaderDevice reader(pcapngFileName);
+	reader.setZeroCopyMode(state.range(0) != 0);
+	if (!reader.open())
+	{
+		state.SkipWithError("Cannot open pcapng file for reading");
+		return;
+	}
+
+	size_t totalBytes = 0;
+	size_t totalPackets = 0;
+	pcpp::RawPacket rawPacket;
+	for (auto _ : state)
+	{
+		if (!reader.getNextPacket(rawPacket))
+		{
+			if (totalBytes == 0)
+			{
+				state.SkipWithError("Cannot read packet");
+				return;
+			}
+
+			// Rewind the file if it reached the end
+			state.PauseTiming();
+			reader.close();
+			reader.open();
+			state.ResumeTiming();
+			continue;
+		}
+
+		++totalPackets;
+		totalBytes += rawPacket.getRawDataLen();
+	}
+
+	state.SetBytesProcessed(totalBytes);
+	state.SetItemsProcessed(totalPackets);
+}
+BENCHMARK(BM_PcapNgFileRead)->ArgName("ZeroCopy")->Arg(0)->Arg(1);
+
 static void BM_PcapFileWrite(benchmark::State& state)
 {
 	// Open the pcap file for writing
@@ -93,6 +166,50 @@ static void BM_PcapFileWrite(benchmark::State& state)
 }
 BENCHMARK(BM_PcapFileWrite);
 
+static void BM_PcapNgFileWrite(benchmark::State& state)
+{
+	// Open the pcapng file for writing, with or without zstd compression and compression threads
+	int compressionLevel = static_cast<int>(state.range(0));
+	pcpp::PcapNgFileWriterDevice writer("benchmark-output.pcapng", compressionLevel);
+	writer.setCompressionWorkerCount(static_cast<int>(state.range(1)));
+	if (!writer.open())
+	{
+		state.SkipWithError("Cannot open pcapng file for writing");
+		return;
+	}
+
+	pcpp::Packet packet;
+	pcpp::EthLayer ethLayer(pcpp::MacAddress("00:00:00:00:00:00"), pcpp::MacAddress("00:00:00:00:00:00"));
+	pcpp::IPv4Layer ip4Layer(pcpp::IPv4Address("192.168.0.1"), pcpp::IPv4Address("192.168.0.2"));
+	pcpp::TcpLayer tcpLayer(12345, 80);
+
+	packet.addLayer(&ethLayer);
+	packet.addLayer(&ip4Layer);
+	packet.addLayer(&tcpLayer);
+	packet.computeCalculateFields();
+
+	size_t totalBytes = 0;
+	size_t totalPackets = 0;
+	for (auto _ : state)
+	{
+		writer.writePacket(*(packet.getRawPacket()));
+
+		++totalPackets;
+		totalBytes += packet.getRawPacket()->getRawDataLen();
+	}
+
+	// Include writing the buffered packets to the file
+	writer.flush();
+
+	state.SetBytesProcessed(totalBytes);
+	state.SetItemsProcessed(totalPackets);
+}
+BENCHMARK(BM_PcapNgFileWrite)
+    ->ArgNames({ "CompressionLevel", "CompressionWorkers" })
+    ->Args({ 0, 0 })
+    ->Args({ 5, 0 })
+    ->Args({ 5, 4 });
+
 static void BM_PacketParsing(benchmark::State& state)
 {
 	// Open the pcap file for reading
@@ -197,6 +314,807 @@ static void BM_PacketCrafting(benchmark::State& state)
 }
 BENCHMARK(BM_PacketCrafting);
 
+static void BM_PacketTemplateStamping(benchmark::State& state)
+{
+	// Mode 0: stamp the template and patch the source IP and ports, like BM_PacketCrafting randomizes them
+	// Mode 1: also change the payload length of every stamped packet
+	const bool resizePayload = state.range(0) == 1;
+
+	pcpp::Packet packet;
+	packet.addLayer(new pcpp::EthLayer(pcpp::MacAddress("aa:bb:cc:dd:ee:ff"), pcpp::MacAddress("11:22:33:44:55:66")),
+	                true);
+	packet.addLayer(new pcpp::IPv4Layer(pcpp::IPv4Address("10.0.0.1"), pcpp::IPv4Address("10.0.0.2")), true);
+	packet.addLayer(new pcpp::TcpLayer(1000, 80), true);
+	std::vector<uint8_t> payload(64, 0x42);
+	packet.addLayer(new pcpp::PayloadLayer(payload.data(), payload.size()), true);
+
+	pcpp::PacketTemplate packetTemplate(packet);
+	int srcIPField = packetTemplate.addSrcIPField();
+	int srcPortField = packetTemplate.addSrcPortField();
+	int dstPortField = packetTemplate.addDstPortField();
+
+	uint8_t buffer[1500];
+	size_t totalBytes = 0;
+	size_t totalPackets = 0;
+
+	for (auto _ : state)
+	{
+		uint8_t randNum = static_cast<uint8_t>(rand() % 256);
+
+		size_t packetLen = resizePayload ? packetTemplate.stamp(buffer, sizeof(buffer), randNum)
+		                                 : packetTemplate.stamp(buffer, sizeof(buffer));
+		packetTemplate.setField(buffer, packetLen, srcIPField, 0x0a000000u | randNum);
+		packetTemplate.setField(buffer, packetLen, srcPortField, randNum);
+		packetTemplate.setField(buffer, packetLen, dstPortField, randNum);
+		benchmark::DoNotOptimize(buffer);
+
+		++totalPackets;
+		totalBytes += packetLen;
+	}
+
+	state.SetBytesProcessed(totalBytes);
+	state.SetItemsProcessed(totalPackets);
+}
+BENCHMARK(BM_PacketTemplateStamping)->Arg(0)->Arg(1);
+
+static void BM_PacketBuilder(benchmark::State& state)
+{
+	uint8_t buffer[1500];
+	size_t totalBytes = 0;
+	size_t totalPackets = 0;
+
+	for (auto _ : state)
+	{
+		uint8_t randNum = static_cast<uint8_t>(rand() % 256);
+		size_t packetLen;
+
+		// Randomly choose between IPv4 / TCP and IPv6 / UDP, like BM_PacketCrafting
+		if (randNum % 2)
+		{
+			pcpp::PacketBuilder<pcpp::EthLayer, pcpp::IPv4Layer, pcpp::TcpLayer> builder(buffer, sizeof(buffer));
+			builder.getHeader<0>().setSourceMac(pcpp::MacAddress(randNum, randNum, randNum, randNum, randNum, randNum));
+			builder.getHeader<0>().setDestMac(pcpp::MacAddress(randNum, randNum, randNum, randNum, randNum, randNum));
+			builder.getHeader<1>().setSrcIPv4Address(pcpp::IPv4Address(static_cast<uint32_t>(randNum)));
+			builder.getHeader<1>().setDstIPv4Address(pcpp::IPv4Address(static_cast<uint32_t>(randNum)));
+			builder.getHeader<2>().setSrcPort(randNum);
+			builder.getHeader<2>().setDstPort(randNum);
+			packetLen = builder.finalize(0);
+		}
+		else
+		{
+			pcpp::PacketBuilder<pcpp::EthLayer, pcpp::IPv6Layer, pcpp::UdpLayer> builder(buffer, sizeof(buffer));
+			std::array<uint8_t, 16> ip = { randNum, randNum, randNum, randNum, randNum, randNum, randNum, randNum,
+				                           randNum, randNum, randNum, randNum, randNum, randNum, randNum, randNum };
+			builder.getHeader<0>().setSourceMac(pcpp::MacAddress(randNum, randNum, randNum, randNum, randNum, randNum));
+			builder.getHeader<0>().setDestMac(pcpp::MacAddress(randNum, randNum, randNum, randNum, randNum, randNum));
+			builder.getHeader<1>().setSrcIPv6Address(pcpp::IPv6Address(ip));
+			builder.getHeader<1>().setDstIPv6Address(pcpp::IPv6Address(ip));
+			builder.getHeader<2>().setSrcPort(randNum);
+			builder.getHeader<2>().setDstPort(randNum);
+			packetLen = builder.finalize(0);
+		}
+		benchmark::DoNotOptimize(buffer);
+
+		++totalPackets;
+		totalBytes += packetLen;
+	}
+
+	state.SetBytesProcessed(totalBytes);
+	state.SetItemsProcessed(totalPackets);
+}
+BENCHMARK(BM_PacketBuilder);
+
+static bool readAllPackets(std::vector<pcpp::RawPacket>& rawPackets)
+{
+	pcpp::PcapFileReaderDevice reader(pcapFileName);
+	if (!reader.open())
+		return false;
+
+	pcpp::RawPacket rawPacket;
+	while (reader.getNextPacket(rawPacket))
+		rawPackets.push_back(rawPacket);
+
+	return !rawPackets.empty();
+}
+
+static void BM_TLSFingerprintLayer(benchmark::State& state)
+{
+	std::vector<pcpp::RawPacket> rawPackets;
+	if (!readAllPackets(rawPackets))
+	{
+		state.SkipWithError("Cannot read packets from pcap file");
+		return;
+	}
+
+	size_t totalPackets = 0;
+	size_t totalFingerprints = 0;
+	size_t packetIndex = 0;
+	for (auto _ : state)
+	{
+		pcpp::Packet parsedPacket(&rawPackets[packetIndex]);
+		packetIndex = (packetIndex + 1) % rawPackets.size();
+
+		pcpp::SSLHandshakeLayer* handshakeLayer = parsedPacket.getLayerOfType<pcpp::SSLHandshakeLayer>();
+		if (handshakeLayer != nullptr)
+		{
+			pcpp::SSLClientHelloMessage* clientHello =
+			    handshakeLayer->getHandshakeMessageOfType<pcpp::SSLClientHelloMessage>();
+			pcpp::SSLServerHelloMessage* serverHello =
+			    handshakeLayer->getHandshakeMessageOfType<pcpp::SSLServerHelloMessage>();
+			if (clientHello != nullptr)
+			{
+				benchmark::DoNotOptimize(clientHello->generateTLSFingerprint().toMD5());
+				++totalFingerprints;
+			}
+			else if (serverHello != nullptr)
+			{
+				benchmark::DoNotOptimize(serverHello->generateTLSFingerprint().toMD5());
+				++totalFingerprints;
+			}
+		}
+
+		++totalPackets;
+	}
+
+	state.SetItemsProcessed(totalPackets);
+	state.counters["Fingerprints"] = static_cast<double>(totalFingerprints);
+}
+BENCHMARK(BM_TLSFingerprintLayer);
+
+static void BM_TLSFingerprintExtractor(benchmark::State& state)
+{
+	std::vector<pcpp::RawPacket> rawPackets;
+	if (!readAllPackets(rawPackets))
+	{
+		state.SkipWithError("Cannot read packets from pcap file");
+		return;
+	}
+
+	size_t totalPackets = 0;
+	size_t totalFingerprints = 0;
+	size_t packetIndex = 0;
+	pcpp::TLSFingerprint fingerprint;
+	for (auto _ : state)
+	{
+		// parse only up to the TCP layer, the TLS records are walked by the extractor
+		pcpp::Packet parsedPacket(&rawPackets[packetIndex], pcpp::TCP);
+		packetIndex = (packetIndex + 1) % rawPackets.size();
+
+		pcpp::TcpLayer* tcpLayer = parsedPacket.getLayerOfType<pcpp::TcpLayer>();
+		if (tcpLayer != nullptr && tcpLayer->getLayerPayloadSize() > 0 &&
+		    pcpp::TLSFingerprintExtractor::extract(tcpLayer->getLayerPayload(), tcpLayer->getLayerPayloadSize(),
+		                                           fingerprint, state.range(0) != 0))
+		{
+			benchmark::DoNotOptimize(fingerprint);
+			++totalFingerprints;
+		}
+
+		++totalPackets;
+	}
+
+	state.SetItemsProcessed(totalPackets);
+	state.counters["Fingerprints"] = static_cast<double>(totalFingerprints);
+}
+BENCHMARK(BM_TLSFingerprintExtractor)->ArgName("JA4")->Arg(0)->Arg(1);
+
+static void BM_TLSFingerprintExtractorBatch(benchmark::State& state)
+{
+	std::vector<pcpp::RawPacket> rawPackets;
+	if (!readAllPackets(rawPackets))
+	{
+		state.SkipWithError("Cannot read packets from pcap file");
+		return;
+	}
+
+	// collect the TCP payloads once, so only the fingerprinting itself is measured
+	std::vector<const uint8_t*> payloads;
+	std::vector<size_t> payloadLengths;
+	for (auto& rawPacket : rawPackets)
+	{
+		pcpp::Packet parsedPacket(&rawPacket, pcpp::TCP);
+		pcpp::TcpLayer* tcpLayer = parsedPacket.getLayerOfType<pcpp::TcpLayer>();
+		if (tcpLayer != nullptr && tcpLayer->getLayerPayloadSize() > 0)
+		{
+			payloads.push_back(tcpLayer->getLayerPayload());
+			payloadLengths.push_back(tcpLayer->getLayerPayloadSize());
+		}
+	}
+
+	const size_t batchSize = static_cast<size_t>(state.range(0));
+	if (payloads.size() < batchSize)
+	{
+		state.SkipWithError("Not enough TCP payloads in pcap file");
+		return;
+	}
+
+	std::vector<pcpp::TLSFingerprint> results(batchSize);
+	size_t totalPayloads = 0;
+	size_t totalFingerprints = 0;
+	size_t batchStart = 0;
+	for (auto _ : state)
+	{
+		if (batchStart + batchSize > payloads.size())
+			batchStart = 0;
+
+		totalFingerprints += pcpp::TLSFingerprintExtractor::extractBatch(
+		    &payloads[batchStart], &payloadLengths[batchStart], batchSize, results.data());
+		benchmark::DoNotOptimize(results.data());
+
+		batchStart += batchSize;
+		totalPayloads += batchSize;
+	}
+
+	state.SetItemsProcessed(totalPayloads);
+	state.counters["Fingerprints"] = static_cast<double>(totalFingerprints);
+}
+BENCHMARK(BM_TLSFingerprintExtractorBatch)->ArgName("BatchSize")->Arg(32);
+
+// The number of packet references the filter benchmarks iterate over. The packets of the pcap file are repeated
+// until the corpus is filled
+static constexpr size_t FilterCorpusSize = 10000000;
+
+/// The filters matched by the filter benchmarks. The benchmark argument selects IPFilter (0), PortFilter (1) or an
+/// AndFilter composed of both (2)
+struct BenchmarkFilters
+{
+	pcpp::IPFilter ipFilter{ "10.0.0.1", pcpp::SRC_OR_DST };
+	pcpp::PortFilter portFilter{ 443, pcpp::SRC_OR_DST };
+	pcpp::AndFilter compositeFilter{ { &ipFilter, &portFilter } };
+
+	pcpp::GeneralFilter& get(int64_t filterType)
+	{
+		switch (filterType)
+		{
+		case 0:
+			return ipFilter;
+		case 1:
+			return portFilter;
+		default:
+			return compositeFilter;
+		}
+	}
+};
+
+static bool createFilterCorpus(std::vector<pcpp::RawPacket>& rawPackets, std::vector<const pcpp::RawPacket*>& corpus)
+{
+	if (!readAllPackets(rawPackets))
+		return false;
+
+	corpus.reserve(FilterCorpusSize);
+	for (size_t i = 0; i < FilterCorpusSize; ++i)
+		corpus.push_back(&rawPackets[i % rawPackets.size()]);
+
+	return true;
+}
+
+static void BM_GeneralFilterMatch(benchmark::State& state)
+{
+	std::vector<pcpp::RawPacket> rawPackets;
+	std::vector<const pcpp::RawPacket*> corpus;
+	if (!createFilterCorpus(rawPackets, corpus))
+	{
+		state.SkipWithError("Cannot read packets from pcap file");
+		return;
+	}
+
+	BenchmarkFilters filters;
+	pcpp::GeneralFilter& filter = filters.get(state.range(0));
+
+	size_t totalPackets = 0;
+	size_t totalMatches = 0;
+	size_t packetIndex = 0;
+	for (auto _ : state)
+	{
+		if (filter.matchPacketWithFilter(const_cast<pcpp::RawPacket*>(corpus[packetIndex])))
+			++totalMatches;
+
+		packetIndex = (packetIndex + 1) % corpus.size();
+		++totalPackets;
+	}
+
+	state.SetItemsProcessed(totalPackets);
+	state.counters["Matches"] = static_cast<double>(totalMatches);
+}
+BENCHMARK(BM_GeneralFilterMatch)->ArgName("Filter")->Arg(0)->Arg(1)->Arg(2);
+
+static void BM_CompiledFilterMatch(benchmark::State& state)
+{
+	std::vector<pcpp::RawPacket> rawPackets;
+	std::vector<const pcpp::RawPacket*> corpus;
+	if (!createFilterCorpus(rawPackets, corpus))
+	{
+		state.SkipWithError("Cannot read packets from pcap file");
+		return;
+	}
+
+	BenchmarkFilters filters;
+	const pcpp::CompiledBpfFilter compiledFilter =
+	    filters.get(state.range(0)).compile(rawPackets.front().getLinkLayerType());
+	if (!compiledFilter.isValid())
+	{
+		state.SkipWithError("Cannot compile filter");
+		return;
+	}
+
+	size_t totalPackets = 0;
+	size_t totalMatches = 0;
+	size_t packetIndex = 0;
+	for (auto _ : state)
+	{
+		if (compiledFilter.matches(corpus[packetIndex]))
+			++totalMatches;
+
+		packetIndex = (packetIndex + 1) % corpus.size();
+		++totalPackets;
+	}
+
+	state.SetItemsProcessed(totalPackets);
+	state.counters["Matches"] = static_cast<double>(totalMatches);
+}
+BENCHMARK(BM_CompiledFilterMatch)->ArgName("Filter")->Arg(0)->Arg(1)->Arg(2);
+
+static void BM_CompiledFilterMatchBatch(benchmark::State& state)
+{
+	std::vector<pcpp::RawPacket> rawPackets;
+	std::vector<const pcpp::RawPacket*> corpus;
+	if (!createFilterCorpus(rawPackets, corpus))
+	{
+		state.SkipWithError("Cannot read packets from pcap file");
+		return;
+	}
+
+	BenchmarkFilters filters;
+	const pcpp::CompiledBpfFilter compiledFilter =
+	    filters.get(state.range(0)).compile(rawPackets.front().getLinkLayerType());
+	if (!compiledFilter.isValid())
+	{
+		state.SkipWithError("Cannot compile filter");
+		return;
+	}
+
+	constexpr size_t batchSize = 64;
+	std::bitset<batchSize> results;
+	size_t totalPackets = 0;
+	size_t totalMatches = 0;
+	size_t batchStart = 0;
+	for (auto _ : state)
+	{
+		if (batchStart + batchSize > corpus.size())
+			batchStart = 0;
+
+		totalMatches += compiledFilter.matchPackets(&corpus[batchStart], batchSize, results);
+		benchmark::DoNotOptimize(results);
+
+		batchStart += batchSize;
+		totalPackets += batchSize;
+	}
+
+	state.SetItemsProcessed(totalPackets);
+	state.counters["Matches"] = static_cast<double>(totalMatches);
+}
+BENCHMARK(BM_CompiledFilterMatchBatch)->ArgName("Filter")->Arg(0)->Arg(1)->Arg(2);
+
+static void BM_BpfFilterWrapperMatch(benchmark::State& state)
+{
+	std::vector<pcpp::RawPacket> rawPackets;
+	std::vector<const pcpp::RawPacket*> corpus;
+	if (!createFilterCorpus(rawPackets, corpus))
+	{
+		state.SkipWithError("Cannot read packets from pcap file");
+		return;
+	}
+
+	BenchmarkFilters filters;
+	std::string filterStr;
+	filters.get(state.range(0)).parseToString(filterStr);
+
+	pcpp::BpfFilterWrapper bpfWrapper;
+	bpfWrapper.setThreadedCodeEnabled(state.range(1) != 0);
+	if (!bpfWrapper.setFilter(filterStr, rawPackets.front().getLinkLayerType()))
+	{
+		state.SkipWithError("Cannot compile filter");
+		return;
+	}
+
+	size_t totalPackets = 0;
+	size_t totalMatches = 0;
+	size_t packetIndex = 0;
+	for (auto _ : state)
+	{
+		if (bpfWrapper.matchPacketWithFilter(corpus[packetIndex]))
+			++totalMatches;
+
+		packetIndex = (packetIndex + 1) % corpus.size();
+		++totalPackets;
+	}
+
+	state.SetItemsProcessed(totalPackets);
+	state.counters["Matches"] = static_cast<double>(totalMatches);
+}
+BENCHMARK(BM_BpfFilterWrapperMatch)->ArgNames({ "Filter", "ThreadedCode" })->ArgsProduct({ { 0, 1, 2 }, { 0, 1 } });
+
+static void BM_NativeFilterMatch(benchmark::State& state)
+{
+	std::vector<pcpp::RawPacket> rawPackets;
+	std::vector<const pcpp::RawPacket*> corpus;
+	if (!createFilterCorpus(rawPackets, corpus))
+	{
+		state.SkipWithError("Cannot read packets from pcap file");
+		return;
+	}
+
+	BenchmarkFilters filters;
+	const pcpp::NativeFilter nativeFilter(filters.get(state.range(0)));
+	if (!nativeFilter.isValid())
+	{
+		state.SkipWithError("Cannot compile filter");
+		return;
+	}
+
+	size_t totalPackets = 0;
+	size_t totalMatches = 0;
+	size_t packetIndex = 0;
+	for (auto _ : state)
+	{
+		if (nativeFilter.matches(corpus[packetIndex]))
+			++totalMatches;
+
+		packetIndex = (packetIndex + 1) % corpus.size();
+		++totalPackets;
+	}
+
+	state.SetItemsProcessed(totalPackets);
+	state.counters["Matches"] = static_cast<double>(totalMatches);
+}
+BENCHMARK(BM_NativeFilterMatch)->ArgName("Filter")->Arg(0)->Arg(1)->Arg(2);
+
+/// Match every packet with many per-tenant filters (host 10.0.<n>.<n> and port 443). With native filters the flow key
+/// is extracted once per packet and shared by all filters, otherwise a CompiledBpfFilter runs per filter
+static void BM_MultiTenantFilterMatch(benchmark::State& state)
+{
+	std::vector<pcpp::RawPacket> rawPackets;
+	std::vector<const pcpp::RawPacket*> corpus;
+	if (!createFilterCorpus(rawPackets, corpus))
+	{
+		state.SkipWithError("Cannot read packets from pcap file");
+		return;
+	}
+
+	const size_t filterCount = static_cast<size_t>(state.range(0));
+	const bool useNativeFilters = state.range(1) != 0;
+	const pcpp::LinkLayerType linkType = rawPackets.front().getLinkLayerType();
+
+	pcpp::PortFilter portFilter(443, pcpp::SRC_OR_DST);
+	std::vector<std::unique_ptr<pcpp::IPFilter>> ipFilters;
+	std::vector<pcpp::NativeFilter> nativeFilters;
+	std::vector<pcpp::CompiledBpfFilter> compiledFilters;
+	for (size_t i = 0; i < filterCount; ++i)
+	{
+		std::string host = "10.0." + std::to_string(i / 256) + '.' + std::to_string(i % 256);
+		ipFilters.emplace_back(new pcpp::IPFilter(host, pcpp::SRC_OR_DST));
+		pcpp::AndFilter tenantFilter({ ipFilters.back().get(), &portFilter });
+
+		if (useNativeFilters)
+			nativeFilters.emplace_back(tenantFilter);
+		else
+			compiledFilters.push_back(tenantFilter.compile(linkType));
+	}
+
+	size_t totalPackets = 0;
+	size_t totalMatches = 0;
+	size_t packetIndex = 0;
+	pcpp::FilterFlowKey key;
+	for (auto _ : state)
+	{
+		if (useNativeFilters)
+		{
+			key.extract(corpus[packetIndex]);
+			for (const auto& nativeFilter : nativeFilters)
+			{
+				if (nativeFilter.matches(key))
+					++totalMatches;
+			}
+		}
+		else
+		{
+			for (const auto& compiledFilter : compiledFilters)
+			{
+				if (compiledFilter.matches(corpus[packetIndex]))
+					++totalMatches;
+			}
+		}
+
+		packetIndex = (packetIndex + 1) % corpus.size();
+		++totalPackets;
+	}
+
+	state.SetItemsProcessed(totalPackets);
+	state.counters["Matches"] = static_cast<double>(totalMatches);
+}
+BENCHMARK(BM_MultiTenantFilterMatch)->ArgNames({ "Filters", "Native" })->ArgsProduct({ { 1, 16, 256 }, { 0, 1 } });
+
+/// Match every packet with a set of rules: a quarter each of host + port, /24 network, port and port range rules.
+/// With FilterSet the rules are indexed, otherwise the NativeFilter of every rule is matched with a shared flow key
+static void BM_FilterSetMatch(benchmark::State& state)
+{
+	std::vector<pcpp::RawPacket> rawPackets;
+	std::vector<const pcpp::RawPacket*> corpus;
+	if (!createFilterCorpus(rawPackets, corpus))
+	{
+		state.SkipWithError("Cannot read packets from pcap file");
+		return;
+	}
+
+	const size_t ruleCount = static_cast<size_t>(state.range(0));
+	const bool useFilterSet = state.range(1) != 0;
+
+	std::vector<std::unique_ptr<pcpp::GeneralFilter>> filterObjects;
+	pcpp::FilterSet filterSet;
+	std::vector<pcpp::NativeFilter> nativeFilters;
+	for (size_t i = 0; i < ruleCount; ++i)
+	{
+		std::string subnet = "10." + std::to_string(i / 256 % 256) + '.' + std::to_string(i % 256);
+		uint16_t port = static_cast<uint16_t>(1024 + i);
+		pcpp::GeneralFilter* rule = nullptr;
+		switch (i % 4)
+		{
+		case 0:
+		{
+			filterObjects.emplace_back(new pcpp::IPFilter(subnet + ".1", pcpp::SRC_OR_DST));
+			pcpp::GeneralFilter* hostFilter = filterObjects.back().get();
+			filterObjects.emplace_back(new pcpp::PortFilter(443, pcpp::SRC_OR_DST));
+			pcpp::GeneralFilter* portFilter = filterObjects.back().get();
+			filterObjects.emplace_back(new pcpp::AndFilter({ hostFilter, portFilter }));
+			break;
+		}
+		case 1:
+			filterObjects.emplace_back(new pcpp::IPFilter(subnet + ".0", pcpp::SRC_OR_DST, 24));
+			break;
+		case 2:
+			filterObjects.emplace_back(new pcpp::PortFilter(port, pcpp::DST));
+			break;
+		default:
+			filterObjects.emplace_back(new pcpp::PortRangeFilter(port, static_cast<uint16_t>(port + 15), pcpp::SRC));
+			break;
+		}
+
+		rule = filterObjects.back().get();
+		if (useFilterSet)
+			filterSet.addFilter(*rule);
+		else
+			nativeFilters.emplace_back(*rule);
+	}
+
+	size_t totalPackets = 0;
+	size_t totalMatches = 0;
+	size_t packetIndex = 0;
+	std::vector<bool> matchingRules;
+	pcpp::FilterFlowKey key;
+	for (auto _ : state)
+	{
+		if (useFilterSet)
+		{
+			totalMatches += filterSet.matchPacket(corpus[packetIndex], matchingRules);
+		}
+		else
+		{
+			key.extract(corpus[packetIndex]);
+			for (const auto& nativeFilter : nativeFilters)
+			{
+				if (nativeFilter.matches(key))
+					++totalMatches;
+			}
+		}
+
+		packetIndex = (packetIndex + 1) % corpus.size();
+		++totalPackets;
+	}
+
+	state.SetItemsProcessed(totalPackets);
+	state.counters["Matches"] = static_cast<double>(totalMatches);
+}
+BENCHMARK(BM_FilterSetMatch)->ArgNames({ "Rules", "FilterSet" })->ArgsProduct({ { 10, 100, 1000, 10000 }, { 0, 1 } });
+
+/// Push packet pointers from the benchmark thread to a consumer thread through an SpscRing, one by one or in batches.
+/// The time per item is the per-packet handoff cost seen by the producer
+static void BM_SpscRingHandoff(benchmark::State& state)
+{
+	const size_t batchSize = static_cast<size_t>(state.range(0));
+	std::vector<pcpp::RawPacket> rawPackets(batchSize);
+	std::vector<pcpp::RawPacket*> batch;
+	for (auto& rawPacket : rawPackets)
+		batch.push_back(&rawPacket);
+
+	pcpp::SpscRing<pcpp::RawPacket*> ring(1024);
+	std::atomic<bool> stop(false);
+	std::atomic<size_t> consumedPackets(0);
+	std::thread consumer([&]() {
+		pcpp::RawPacket* poppedPackets[64];
+		size_t totalConsumed = 0;
+		while (!stop.load(std::memory_order_relaxed) || !ring.isEmpty())
+		{
+			size_t count = ring.popBatch(poppedPackets, 64);
+			if (count == 0)
+				std::this_thread::yield();
+
+			totalConsumed += count;
+		}
+		consumedPackets = totalConsumed;
+	});
+
+	size_t totalPackets = 0;
+	for (auto _ : state)
+	{
+		size_t pushed = 0;
+		while (pushed < batchSize)
+		{
+			size_t count = ring.pushBatch(batch.data() + pushed, batchSize - pushed);
+			if (count == 0)
+				std::this_thread::yield();
+
+			pushed += count;
+		}
+
+		totalPackets += batchSize;
+	}
+
+	stop = true;
+	consumer.join();
+
+	if (consumedPackets != totalPackets)
+		state.SkipWithError("Consumer didn't receive all packets");
+
+	state.SetItemsProcessed(totalPackets);
+}
+BENCHMARK(BM_SpscRingHandoff)->ArgName("BatchSize")->Arg(1)->Arg(32)->UseRealTime();
+
+/// The same handoff through an MpmcRing, popped by 1 or 2 consumer threads
+static void BM_MpmcRingHandoff(benchmark::State& state)
+{
+	const size_t batchSize = static_cast<size_t>(state.range(0));
+	const int consumerCount = static_cast<int>(state.range(1));
+	std::vector<pcpp::RawPacket> rawPackets(batchSize);
+	std::vector<pcpp::RawPacket*> batch;
+	for (auto& rawPacket : rawPackets)
+		batch.push_back(&rawPacket);
+
+	pcpp::MpmcRing<pcpp::RawPacket*> ring(1024);
+	std::atomic<bool> stop(false);
+	std::atomic<size_t> consumedPackets(0);
+	std::vector<std::thread> consumers;
+	for (int i = 0; i < consumerCount; ++i)
+	{
+		consumers.emplace_back([&]() {
+			pcpp::RawPacket* poppedPackets[64];
+			size_t totalConsumed = 0;
+			while (!stop.load(std::memory_order_relaxed) || !ring.isEmpty())
+			{
+				size_t count = ring.popBatch(poppedPackets, 64);
+				if (count == 0)
+					std::this_thread::yield();
+
+				totalConsumed += count;
+			}
+			consumedPackets += totalConsumed;
+		});
+	}
+
+	size_t totalPackets = 0;
+	for (auto _ : state)
+	{
+		size_t pushed = 0;
+		while (pushed < batchSize)
+		{
+			size_t count = ring.pushBatch(batch.data() + pushed, batchSize - pushed);
+			if (count == 0)
+				std::this_thread::yield();
+
+			pushed += count;
+		}
+
+		totalPackets += batchSize;
+	}
+
+	stop = true;
+	for (auto& consumer : consumers)
+		consumer.join();
+
+	if (consumedPackets != totalPackets)
+		state.SkipWithError("Consumers didn't receive all packets");
+
+	state.SetItemsProcessed(totalPackets);
+}
+BENCHMARK(BM_MpmcRingHandoff)
+    ->ArgNames({ "BatchSize", "Consumers" })
+    ->ArgsProduct({ { 1, 32 }, { 1, 2 } })
+    ->UseRealTime();
+
+/// Dispatch packets round-robin to 1, 2 or 4 PacketPipeline workers, which only count them
+static void BM_PacketPipelineHandoff(benchmark::State& state)
+{
+	const uint32_t workerCount = static_cast<uint32_t>(state.range(0));
+	pcpp::RawPacket rawPacket;
+	std::atomic<size_t> consumedPackets(0);
+	pcpp::PacketPipeline<pcpp::RawPacket*> pipeline(
+	    workerCount, 1024,
+	    [&consumedPackets](pcpp::RawPacket** packets, size_t count, uint32_t workerIndex) {
+		    consumedPackets.fetch_add(count, std::memory_order_relaxed);
+	    });
+	pipeline.start();
+
+	size_t totalPackets = 0;
+	for (auto _ : state)
+	{
+		pipeline.push(&rawPacket);
+		++totalPackets;
+	}
+
+	pipeline.stop();
+
+	if (consumedPackets != totalPackets)
+		state.SkipWithError("Workers didn't receive all packets");
+
+	state.SetItemsProcessed(totalPackets);
+	state.counters["Blocked"] = static_cast<double>(pipeline.getBlockedCount());
+}
+BENCHMARK(BM_PacketPipelineHandoff)->ArgName("Workers")->Arg(1)->Arg(2)->Arg(4)->UseRealTime();
+
+/// Compute a flow hash of every packet: parse it and call hash5Tuple(), or compute the RSS hash from the raw data with
+/// an RssHasher, per packet or in bursts of 32
+static void BM_SoftwareRssHash(benchmark::State& state)
+{
+	std::vector<pcpp::RawPacket> rawPackets;
+	std::vector<const pcpp::RawPacket*> corpus;
+	if (!createFilterCorpus(rawPackets, corpus))
+	{
+		state.SkipWithError("Cannot read packets from pcap file");
+		return;
+	}
+
+	const int mode = static_cast<int>(state.range(0));
+	const size_t burstSize = 32;
+	const pcpp::RssHasher hasher(nullptr, pcpp::RssHasher::MinKeyLength,
+	                             pcpp::RssHasher::NonFragIPv4Tcp | pcpp::RssHasher::NonFragIPv4Udp |
+	                                 pcpp::RssHasher::NonFragIPv6Tcp | pcpp::RssHasher::NonFragIPv6Udp |
+	                                 pcpp::RssHasher::DefaultHashTypes);
+	// the corpus size is a multiple of the burst size
+	uint32_t hashes[burstSize];
+
+	size_t totalPackets = 0;
+	size_t packetIndex = 0;
+	uint32_t hashSum = 0;
+	for (auto _ : state)
+	{
+		if (mode == 2)
+		{
+			hasher.hashBatch(corpus.data() + packetIndex, burstSize, hashes);
+			for (size_t i = 0; i < burstSize; ++i)
+				hashSum += hashes[i];
+
+			packetIndex = (packetIndex + burstSize) % corpus.size();
+			totalPackets += burstSize;
+			continue;
+		}
+
+		if (mode == 1)
+		{
+			hashSum += hasher.hash(corpus[packetIndex]);
+		}
+		else
+		{
+			pcpp::Packet packet(const_cast<pcpp::RawPacket*>(corpus[packetIndex]), pcpp::OsiModelTransportLayer);
+			hashSum += pcpp::hash5Tuple(&packet);
+		}
+
+		packetIndex = (packetIndex + 1) % corpus.size();
+		++totalPackets;
+	}
+
+	benchmark::DoNotOptimize(hashSum);
+	state.SetItemsProcessed(totalPackets);
+}
+BENCHMARK(BM_SoftwareRssHash)->ArgName("Mode")->Arg(0)->Arg(1)->Arg(2);
+
 int main(int argc, char** argv)
 {
 	// Initialize the benchmark
@@ -5,6 +5,7 @@
 #include <typeinfo>
 #include <stdexcept>
 #include <sstream>
+#include <vector>
 #include "PointerVector.h"
 
 /// @file
@@ -107,6 +108,60 @@ namespace pcpp
 		NotApplicable = 255
 	};
 
+	class Asn1Record;
+
+	/// @class Asn1DecodeArena
+	/// A bump allocator which holds all the records created by Asn1Record#decode(const uint8_t*, size_t,
+	/// Asn1DecodeArena&). Instead of allocating every record separately, records are placed in large blocks that are
+	/// kept and reused after reset(), so decoding many messages with the same arena doesn't allocate once the blocks
+	/// are large enough. All records are destroyed when the arena is reset or destroyed
+	class Asn1DecodeArena
+	{
+		friend class Asn1Record;
+		friend class Asn1GenericRecord;
+
+	public:
+		/// The default size of each memory block
+		static constexpr size_t DefaultBlockSize = 4096;
+
+		/// A c'tor for this class
+		/// @param blockSize The size of each memory block. Records larger than this size get a block of their own
+		explicit Asn1DecodeArena(size_t blockSize = DefaultBlockSize);
+
+		~Asn1DecodeArena();
+
+		Asn1DecodeArena(const Asn1DecodeArena&) = delete;
+		Asn1DecodeArena& operator=(const Asn1DecodeArena&) = delete;
+
+		/// Destroy all records decoded into this arena. The memory blocks are kept for the next decode
+		void reset();
+
+		/// @return The number of records currently held by the arena
+		size_t getRecordCount() const
+		{
+			return m_Records.size();
+		}
+
+		/// @return The total size of the memory blocks allocated by the arena
+		size_t getCapacity() const;
+
+	private:
+		struct Block
+		{
+			std::unique_ptr<uint8_t[]> data;
+			size_t size;
+		};
+
+		size_t m_BlockSize;
+		std::vector<Block> m_Blocks;
+		size_t m_CurrentBlock = 0;
+		size_t m_Offset = 0;
+		std::vector<Asn1Record*> m_Records;
+
+		void* allocate(size_t size, size_t alignment);
+		void destroyRecords();
+	};
+
 	/// @class Asn1Record
 	/// Represents an ASN.1 record, as described in ITU-T Recommendation X.680:
 	/// <https://www.itu.int/rec/T-REC-X.680/en>
@@ -123,10 +178,32 @@ namespace pcpp
 		/// an exception is thrown
 		static std::unique_ptr<Asn1Record> decode(const uint8_t* data, size_t dataLen, bool lazy = true);
 
+		/// A static method to decode a byte array into records that are allocated in an Asn1DecodeArena. Decoding is
+		/// always lazy: the value of each record, including the sub-records of constructed records, is decoded on
+		/// first access and the sub-records are placed in the same arena. The byte array must remain valid as long as
+		/// the records are in use, and sub-records must not be removed from their parent
+		/// @param data A byte array to decode
+		/// @param dataLen The byte array length
+		/// @param arena The arena that holds the decoded records
+		/// @return A pointer to the decoded ASN.1 record, owned by the arena and valid until the arena is reset or
+		/// destroyed, or nullptr if the byte stream is not a valid ASN.1 record
+		static Asn1Record* decode(const uint8_t* data, size_t dataLen, Asn1DecodeArena& arena);
+
 		/// Encode this record and convert it to a byte stream
 		/// @return A vector of bytes representing the record
 		std::vector<uint8_t> encode();
 
+		/// Encode this record into a buffer provided by the caller. Records whose value wasn't decoded yet are copied
+		/// as is, and no intermediate byte vectors are created for constructed, octet string, boolean and null
+		/// records
+		/// @param buffer The buffer to write the encoded record to
+		/// @param bufferLen The buffer length. It must be at least getEncodedLength()
+		/// @return The number of bytes written, or 0 if the buffer is too small or the record can't be encoded
+		size_t encode(uint8_t* buffer, size_t bufferLen);
+
+		/// @return The number of bytes needed to encode this record with encode(uint8_t*, size_t)
+		size_t getEncodedLength() const;
+
 		/// @return The ASN.1 tag class
 		Asn1TagClass getTagClass() const
 		{
@@ -190,14 +267,25 @@ namespace pcpp
 
 		uint8_t* m_EncodedValue = nullptr;
 
+		// set if the record was decoded into an arena which owns it
+		Asn1DecodeArena* m_Arena = nullptr;
+
 		Asn1Record() = default;
 
-		static Asn1Record* decodeInternal(const uint8_t* data, size_t dataLen, bool lazy);
+		static Asn1Record* decodeInternal(const uint8_t* data, size_t dataLen, bool lazy,
+		                                  Asn1DecodeArena* arena = nullptr);
 
 		virtual void decodeValue(uint8_t* data, bool lazy) = 0;
 		virtual std::vector<uint8_t> encodeValue() const = 0;
 
-		static Asn1Record* decodeTagAndCreateRecord(const uint8_t* data, size_t dataLen, uint8_t& tagLen);
+		// writes exactly valueLen bytes of the decoded value. The default implementation copies encodeValue()
+		virtual bool encodeValueInto(uint8_t* buffer, size_t valueLen) const;
+		size_t encodeInto(uint8_t* buffer, size_t bufferLen);
+
+		static Asn1Record* decodeTagAndCreateRecord(const uint8_t* data, size_t dataLen, uint8_t& tagLen,
+		                                            Asn1DecodeArena* arena);
+		template <class Asn1RecordType> static Asn1RecordType* createRecord(Asn1DecodeArena* arena);
+		static void destroyRecord(Asn1Record* record);
 		uint8_t decodeLength(const uint8_t* data, size_t dataLen);
 		void decodeValueIfNeeded();
 
@@ -247,6 +335,7 @@ namespace pcpp
 
 		void decodeValue(uint8_t* data, bool lazy) override;
 		std::vector<uint8_t> encodeValue() const override;
+		bool encodeValueInto(uint8_t* buffer, size_t valueLen) const override;
 
 	private:
 		uint8_t* m_Value = nullptr;
@@ -275,6 +364,8 @@ namespace pcpp
 		explicit Asn1ConstructedRecord(Asn1TagClass tagClass, uint8_t tagType,
 		                               const PointerVector<Asn1Record>& subRecords);
 
+		~Asn1ConstructedRecord() override;
+
 		/// @return A reference to the list of sub-records. It's important to note that any modifications made to
 		/// this list will directly affect the internal structure
 		PointerVector<Asn1Record>& getSubRecords()
@@ -288,6 +379,7 @@ namespace pcpp
 
 		void decodeValue(uint8_t* data, bool lazy) override;
 		std::vector<uint8_t> encodeValue() const override;
+		bool encodeValueInto(uint8_t* buffer, size_t valueLen) const override;
 
 		std::vector<std::string> toStringList() override;
 
@@ -516,6 +608,7 @@ namespace pcpp
 	protected:
 		void decodeValue(uint8_t* data, bool lazy) override;
 		std::vector<uint8_t> encodeValue() const override;
+		bool encodeValueInto(uint8_t* buffer, size_t valueLen) const override;
 
 		std::vector<std::string> toStringList() override;
 
@@ -547,6 +640,7 @@ namespace pcpp
 	protected:
 		void decodeValue(uint8_t* data, bool lazy) override;
 		std::vector<uint8_t> encodeValue() const override;
+		bool encodeValueInto(uint8_t* buffer, size_t valueLen) const override;
 
 		std::vector<std::string> toStringList() override;
 
@@ -567,11 +661,15 @@ namespace pcpp
 		Asn1NullRecord();
 
 	protected:
-		void decodeValue(uint8_t* data, bool lazy) override
+		void decodeValue(uint8_t*, bool) override
 		{}
 		std::vector<uint8_t> encodeValue() const override
 		{
 			return {};
 		}
+		bool encodeValueInto(uint8_t*, size_t valueLen) const override
+		{
+			return valueLen == 0;
+		}
 	};
 }  // namespace pcpp
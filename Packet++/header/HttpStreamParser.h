@@ -0,0 +1,309 @@
+#pragma once
+
+#include "HttpLayer.h"
+#include "TcpReassembly.h"
+#include <array>
+#include <string>
+#include <unordered_map>
+
+/// @file
+/// Incremental HTTP/1.x parsing on top of TCP reassembly. HttpRequestLayer and HttpResponseLayer only see the data of
+/// a single packet, so they can't follow message bodies, chunked transfer encoding or pipelined requests. The
+/// pcpp#HttpStreamParser class consumes the in-order data delivered by pcpp#TcpReassembly and reports every HTTP
+/// message of a connection:
+///
+/// - A headers event is emitted once the whole header block of a request or response was received. The start line and
+///   header fields are reported as spans pointing into the TCP data, so a header block which is fully contained in one
+///   TCP segment is never copied. Only header blocks which cross a segment boundary are buffered, up to a configurable
+///   cap
+/// - Message bodies are never buffered. Content-Length and chunked bodies are followed byte by byte, optionally
+///   reporting the body data as it arrives, and a message end event is emitted with the header and body byte counts
+/// - Pipelined requests and responses are handled, including responses that have no body because the request was
+///   HEAD
+///
+/// A typical usage is to pass HttpStreamParser#onTcpMessageReady and HttpStreamParser#onTcpConnectionEnd to
+/// TcpReassembly with the parser as the user cookie:
+///
+/// @code
+/// pcpp::HttpStreamParser parser(onHttpHeaders, nullptr, onHttpMessageEnd);
+/// pcpp::TcpReassembly tcpReassembly(pcpp::HttpStreamParser::onTcpMessageReady, &parser, nullptr,
+///                                   pcpp::HttpStreamParser::onTcpConnectionEnd);
+/// @endcode
+
+/// @namespace pcpp
+/// @brief The main namespace for the PcapPlusPlus lib
+namespace pcpp
+{
+	/// @struct HttpStreamSpan
+	/// A piece of text inside the TCP data (or the header buffer) of HttpStreamParser. It's valid only during the
+	/// callback it was provided in
+	struct HttpStreamSpan
+	{
+		/// A pointer to the text. It isn't null-terminated
+		const char* data = nullptr;
+		/// The text length
+		size_t length = 0;
+
+		/// @return A copy of the text as a string
+		std::string toString() const
+		{
+			return std::string(data, length);
+		}
+
+		/// @param[in] str A null-terminated string
+		/// @return True if the text is equal to str, ignoring case
+		bool equalsIgnoreCase(const char* str) const;
+	};
+
+	/// @struct HttpStreamHeaderField
+	/// A single HTTP header field, e.g "Host: www.example.com"
+	struct HttpStreamHeaderField
+	{
+		/// The field name, e.g "Host"
+		HttpStreamSpan name;
+		/// The field value without leading and trailing white spaces, e.g "www.example.com"
+		HttpStreamSpan value;
+	};
+
+	/// @struct HttpStreamMessageHeaders
+	/// The header of an HTTP request or response, emitted by HttpStreamParser once the header block is complete
+	struct HttpStreamMessageHeaders
+	{
+		/// True for a request, false for a response
+		bool isRequest;
+		/// The HTTP version from the start line
+		HttpVersion version;
+		/// The request method. Relevant for requests only
+		HttpRequestLayer::HttpMethod method;
+		/// The request URI. Relevant for requests only
+		HttpStreamSpan uri;
+		/// The response status code (e.g 200). Relevant for responses only
+		int statusCode;
+		/// The start line, without the line break
+		HttpStreamSpan startLine;
+		/// The whole header block, including the start line and the empty line that ends it
+		HttpStreamSpan rawHeaders;
+		/// The header fields in the order they appear in the message
+		const HttpStreamHeaderField* fields;
+		/// The number of header fields
+		size_t fieldCount;
+		/// True if the message had more than HttpStreamParser#MaxHeaderFields fields and the rest weren't reported
+		bool fieldsTruncated;
+		/// True if the header block was copied because it crossed a TCP segment boundary
+		bool reassembled;
+		/// The connection this message belongs to
+		const ConnectionData* connectionData;
+		/// The timestamp of the TCP segment which contained the first byte of the message
+		std::chrono::time_point<std::chrono::high_resolution_clock> firstByteTimestamp;
+		/// The timestamp of the TCP segment which completed the header block
+		std::chrono::time_point<std::chrono::high_resolution_clock> timestamp;
+
+		/// Find a header field by name, ignoring case
+		/// @param[in] name The field name
+		/// @return A pointer to the first field with this name or nullptr if there is no such field
+		const HttpStreamHeaderField* getField(const char* name) const;
+	};
+
+	/// @struct HttpStreamMessageEnd
+	/// Emitted by HttpStreamParser once an HTTP message (header and body) ends
+	struct HttpStreamMessageEnd
+	{
+		/// True for a request, false for a response
+		bool isRequest;
+		/// The request method. Relevant for requests only
+		HttpRequestLayer::HttpMethod method;
+		/// The response status code. Relevant for responses only
+		int statusCode;
+		/// True if the body used chunked transfer encoding
+		bool chunked;
+		/// False if the message was cut short: the connection ended in the middle of it or bytes were missing in the
+		/// TCP stream
+		bool complete;
+		/// The length of the header block in bytes
+		uint64_t headerLength;
+		/// The number of body bytes, after removing the chunked encoding framing
+		uint64_t bodyLength;
+		/// The number of bytes the message took on the wire, including header, chunk framing and trailers
+		uint64_t messageLength;
+		/// The connection this message belongs to
+		const ConnectionData* connectionData;
+		/// The timestamp of the TCP segment which contained the first byte of the message
+		std::chrono::time_point<std::chrono::high_resolution_clock> firstByteTimestamp;
+		/// The timestamp of the TCP segment which contained the last byte of the message
+		std::chrono::time_point<std::chrono::high_resolution_clock> timestamp;
+	};
+
+	/// @struct HttpStreamParserStats
+	/// Counters collected by HttpStreamParser
+	struct HttpStreamParserStats
+	{
+		/// Number of request headers emitted
+		uint64_t requests = 0;
+		/// Number of response headers emitted
+		uint64_t responses = 0;
+		/// Number of header blocks which had to be buffered because they crossed a TCP segment boundary
+		uint64_t reassembledHeaders = 0;
+		/// Number of messages which ended incomplete
+		uint64_t incompleteMessages = 0;
+		/// Number of connection sides which stopped being parsed because of non-HTTP data or missing bytes
+		uint64_t parseErrors = 0;
+		/// Number of connection sides which stopped being parsed because a header block exceeded the buffer cap
+		uint64_t headerCapExceeded = 0;
+	};
+
+	/// @class HttpStreamParser
+	/// Parses the HTTP/1.x messages of the reassembled TCP stream of each connection. Please refer to the
+	/// documentation at the top of HttpStreamParser.h for more details
+	class HttpStreamParser
+	{
+	public:
+		/// @typedef OnHttpHeaders
+		/// A callback invoked when the header block of a request or response is complete
+		/// @param[in] side The side of the connection the message was sent from, as provided by TcpReassembly
+		/// @param[in] headers The message header
+		/// @param[in] userCookie A pointer to the cookie provided by the user in the c'tor (or nullptr if no cookie
+		/// provided)
+		typedef void (*OnHttpHeaders)(int8_t side, const HttpStreamMessageHeaders& headers, void* userCookie);
+
+		/// @typedef OnHttpBodyData
+		/// A callback invoked for every piece of body data, after removing the chunked encoding framing
+		/// @param[in] side The side of the connection the message was sent from
+		/// @param[in] data A pointer to the body data, valid only during the callback
+		/// @param[in] dataLen The body data length
+		/// @param[in] connectionData The connection the message belongs to
+		/// @param[in] userCookie A pointer to the cookie provided by the user in the c'tor
+		typedef void (*OnHttpBodyData)(int8_t side, const uint8_t* data, size_t dataLen,
+		                               const ConnectionData& connectionData, void* userCookie);
+
+		/// @typedef OnHttpMessageEnd
+		/// A callback invoked when a request or response ends
+		/// @param[in] side The side of the connection the message was sent from
+		/// @param[in] messageEnd The message summary
+		/// @param[in] userCookie A pointer to the cookie provided by the user in the c'tor
+		typedef void (*OnHttpMessageEnd)(int8_t side, const HttpStreamMessageEnd& messageEnd, void* userCookie);
+
+		/// The maximum number of header fields reported for a single message
+		static constexpr size_t MaxHeaderFields = 128;
+
+		/// The default cap on the size of a header block which crosses a TCP segment boundary
+		static constexpr size_t DefaultMaxHeaderBytes = 64 * 1024;
+
+		/// A c'tor for this class
+		/// @param[in] onHeadersCallback The callback to be invoked when a header block is complete. Can be nullptr
+		/// @param[in] userCookie A pointer to an object provided by the user which is passed to the callbacks
+		/// @param[in] onMessageEndCallback The callback to be invoked when a message ends. Can be nullptr
+		/// @param[in] onBodyDataCallback The callback to be invoked for body data. Can be nullptr
+		/// @param[in] maxHeaderBytes The maximum size of a header block buffered per connection side. A connection side
+		/// whose header block is larger stops being parsed
+		explicit HttpStreamParser(OnHttpHeaders onHeadersCallback, void* userCookie = nullptr,
+		                          OnHttpMessageEnd onMessageEndCallback = nullptr,
+		                          OnHttpBodyData onBodyDataCallback = nullptr,
+		                          size_t maxHeaderBytes = DefaultMaxHeaderBytes);
+
+		/// Process a piece of reassembled TCP data. This is usually called from TcpReassembly#OnTcpMessageReady
+		/// @param[in] side The connection side as provided by TcpReassembly
+		/// @param[in] tcpData The TCP data
+		void processTcpData(int8_t side, const TcpStreamData& tcpData);
+
+		/// Release the state kept for a connection. A message whose body is delimited by the connection close ends
+		/// here; any other message in progress is reported as incomplete. This is usually called from
+		/// TcpReassembly#OnTcpConnectionEnd
+		/// @param[in] connectionData The connection to release
+		void closeConnection(const ConnectionData& connectionData);
+
+		/// Release the state of all connections, ending the messages in progress as in closeConnection()
+		void closeAllConnections();
+
+		/// @return The number of connections which currently have parsing state
+		size_t getConnectionCount() const
+		{
+			return m_Connections.size();
+		}
+
+		/// @return The parser counters
+		const HttpStreamParserStats& getStatistics() const
+		{
+			return m_Stats;
+		}
+
+		/// A TcpReassembly#OnTcpMessageReady compatible callback. The user cookie must be a pointer to an
+		/// HttpStreamParser
+		static void onTcpMessageReady(int8_t side, const TcpStreamData& tcpData, void* userCookie);
+
+		/// A TcpReassembly#OnTcpConnectionEnd compatible callback. The user cookie must be a pointer to an
+		/// HttpStreamParser
+		static void onTcpConnectionEnd(const ConnectionData& connectionData,
+		                               TcpReassembly::ConnectionEndReason reason, void* userCookie);
+
+	private:
+		enum ParserState : uint8_t
+		{
+			WaitingForMessage,
+			ReadingHeaders,
+			ReadingBody,
+			ReadingBodyUntilClose,
+			ReadingChunkSize,
+			ReadingChunkData,
+			ReadingChunkDataEnd,
+			ReadingTrailers,
+			Stopped
+		};
+
+		struct SideState
+		{
+			ParserState state = WaitingForMessage;
+			bool isRequest = false;
+			bool chunked = false;
+			bool complete = true;
+			bool chunkSizeHasDigits = false;
+			bool inChunkExtension = false;
+			HttpRequestLayer::HttpMethod method = HttpRequestLayer::HttpMethodUnknown;
+			int statusCode = 0;
+			uint32_t lineLength = 0;
+			uint64_t remainingBytes = 0;
+			uint64_t headerLength = 0;
+			uint64_t bodyLength = 0;
+			uint64_t messageLength = 0;
+			std::chrono::time_point<std::chrono::high_resolution_clock> firstByteTimestamp;
+			std::chrono::time_point<std::chrono::high_resolution_clock> lastTimestamp;
+			// a header block which crossed a segment boundary
+			std::string headerBuffer;
+		};
+
+		struct ConnectionState
+		{
+			SideState sides[2];
+			// one bit per pipelined request whose response has no body (HEAD), oldest request in bit 0
+			uint64_t pendingNoBodyMask = 0;
+			uint8_t pendingRequests = 0;
+		};
+
+		struct SegmentContext
+		{
+			int8_t side;
+			const TcpStreamData* tcpData;
+			ConnectionState* connection;
+			SideState* sideState;
+		};
+
+		OnHttpHeaders m_OnHeaders;
+		OnHttpMessageEnd m_OnMessageEnd;
+		OnHttpBodyData m_OnBodyData;
+		void* m_UserCookie;
+		size_t m_MaxHeaderBytes;
+		std::unordered_map<uint32_t, ConnectionState> m_Connections;
+		std::array<HttpStreamHeaderField, MaxHeaderFields> m_Fields;
+		HttpStreamParserStats m_Stats;
+
+		size_t consumeHeaders(SegmentContext& segment, const char* data, size_t dataLen);
+		void processHeaders(SegmentContext& segment, const char* headers, size_t headersLen, bool reassembled);
+		size_t consumeBody(SegmentContext& segment, const char* data, size_t dataLen);
+		size_t consumeChunkSize(SegmentContext& segment, const char* data, size_t dataLen);
+		size_t consumeLineBreak(SegmentContext& segment, const char* data, size_t dataLen);
+		size_t consumeTrailers(SegmentContext& segment, const char* data, size_t dataLen);
+		void endMessage(int8_t side, SideState& sideState, const ConnectionData& connectionData,
+		                const std::chrono::time_point<std::chrono::high_resolution_clock>& timestamp, bool complete);
+		void endConnection(const ConnectionData& connectionData, ConnectionState& connection);
+		void stopSide(SegmentContext& segment, bool parseError);
+	};
+}  // namespace pcpp
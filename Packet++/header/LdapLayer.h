@@ -378,10 +378,12 @@ namespace pcpp
 		std::string toString() const override;
 
 	protected:
-		std::unique_ptr<Asn1Record> m_Asn1Record;
+		// the records of the message are decoded into an arena owned by the layer, which m_Asn1Record points into
+		std::unique_ptr<Asn1DecodeArena> m_Asn1Arena;
+		Asn1Record* m_Asn1Record = nullptr;
 
-		LdapLayer(std::unique_ptr<Asn1Record> asn1Record, uint8_t* data, size_t dataLen, Layer* prevLayer,
-		          Packet* packet);
+		LdapLayer(std::unique_ptr<Asn1DecodeArena> asn1Arena, Asn1Record* asn1Record, uint8_t* data, size_t dataLen,
+		          Layer* prevLayer, Packet* packet);
 		LdapLayer() = default;
 		void init(uint16_t messageId, LdapOperationType operationType, const std::vector<Asn1Record*>& messageRecords,
 		          const std::vector<LdapControl>& controls);
@@ -397,6 +399,9 @@ namespace pcpp
 		static constexpr int controlTypeIndex = 0;
 		static constexpr int controlValueIndex = 1;
 
+		// holds the records of a typical message in one block, larger messages get more blocks
+		static constexpr size_t asn1ArenaBlockSize = 1024;
+
 		template <typename LdapClass, typename Method, typename ResultType>
 		bool internalTryGet(LdapClass* thisPtr, Method method, ResultType& result)
 		{
@@ -442,9 +447,9 @@ namespace pcpp
 		static constexpr uint8_t referralTagType = 3;
 
 		LdapResponseLayer() = default;
-		LdapResponseLayer(std::unique_ptr<Asn1Record> asn1Record, uint8_t* data, size_t dataLen, Layer* prevLayer,
-		                  Packet* packet)
-		    : LdapLayer(std::move(asn1Record), data, dataLen, prevLayer, packet)
+		LdapResponseLayer(std::unique_ptr<Asn1DecodeArena> asn1Arena, Asn1Record* asn1Record, uint8_t* data,
+		                  size_t dataLen, Layer* prevLayer, Packet* packet)
+		    : LdapLayer(std::move(asn1Arena), asn1Record, data, dataLen, prevLayer, packet)
 		{}
 
 		LdapResponseLayer(uint16_t messageId, LdapOperationType operationType, LdapResultCode resultCode,
@@ -550,9 +555,9 @@ namespace pcpp
 	protected:
 		friend LdapLayer* LdapLayer::parseLdapMessage(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet);
 
-		LdapBindRequestLayer(std::unique_ptr<Asn1Record> asn1Record, uint8_t* data, size_t dataLen, Layer* prevLayer,
-		                     Packet* packet)
-		    : LdapLayer(std::move(asn1Record), data, dataLen, prevLayer, packet)
+		LdapBindRequestLayer(std::unique_ptr<Asn1DecodeArena> asn1Arena, Asn1Record* asn1Record, uint8_t* data,
+		                     size_t dataLen, Layer* prevLayer, Packet* packet)
+		    : LdapLayer(std::move(asn1Arena), asn1Record, data, dataLen, prevLayer, packet)
 		{}
 
 		std::string getExtendedInfoString() const override;
@@ -597,9 +602,9 @@ namespace pcpp
 
 		static constexpr int serverSaslCredentialsTagType = 7;
 
-		LdapBindResponseLayer(std::unique_ptr<Asn1Record> asn1Record, uint8_t* data, size_t dataLen, Layer* prevLayer,
-		                      Packet* packet)
-		    : LdapResponseLayer(std::move(asn1Record), data, dataLen, prevLayer, packet)
+		LdapBindResponseLayer(std::unique_ptr<Asn1DecodeArena> asn1Arena, Asn1Record* asn1Record, uint8_t* data,
+		                      size_t dataLen, Layer* prevLayer, Packet* packet)
+		    : LdapResponseLayer(std::move(asn1Arena), asn1Record, data, dataLen, prevLayer, packet)
 		{}
 	};
 
@@ -631,9 +636,9 @@ namespace pcpp
 	protected:
 		friend LdapLayer* LdapLayer::parseLdapMessage(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet);
 
-		LdapUnbindRequestLayer(std::unique_ptr<Asn1Record> asn1Record, uint8_t* data, size_t dataLen, Layer* prevLayer,
-		                       Packet* packet)
-		    : LdapLayer(std::move(asn1Record), data, dataLen, prevLayer, packet)
+		LdapUnbindRequestLayer(std::unique_ptr<Asn1DecodeArena> asn1Arena, Asn1Record* asn1Record, uint8_t* data,
+		                       size_t dataLen, Layer* prevLayer, Packet* packet)
+		    : LdapLayer(std::move(asn1Arena), asn1Record, data, dataLen, prevLayer, packet)
 		{}
 	};
 
@@ -815,9 +820,9 @@ namespace pcpp
 		static constexpr int filterIndex = 6;
 		static constexpr int attributesIndex = 7;
 
-		LdapSearchRequestLayer(std::unique_ptr<Asn1Record> asn1Record, uint8_t* data, size_t dataLen, Layer* prevLayer,
-		                       Packet* packet)
-		    : LdapLayer(std::move(asn1Record), data, dataLen, prevLayer, packet)
+		LdapSearchRequestLayer(std::unique_ptr<Asn1DecodeArena> asn1Arena, Asn1Record* asn1Record, uint8_t* data,
+		                       size_t dataLen, Layer* prevLayer, Packet* packet)
+		    : LdapLayer(std::move(asn1Arena), asn1Record, data, dataLen, prevLayer, packet)
 		{}
 
 		std::string getExtendedInfoString() const override;
@@ -857,9 +862,9 @@ namespace pcpp
 		static constexpr int attributeTypeIndex = 0;
 		static constexpr int attributeValueIndex = 1;
 
-		LdapSearchResultEntryLayer(std::unique_ptr<Asn1Record> asn1Record, uint8_t* data, size_t dataLen,
-		                           Layer* prevLayer, Packet* packet)
-		    : LdapLayer(std::move(asn1Record), data, dataLen, prevLayer, packet)
+		LdapSearchResultEntryLayer(std::unique_ptr<Asn1DecodeArena> asn1Arena, Asn1Record* asn1Record, uint8_t* data,
+		                           size_t dataLen, Layer* prevLayer, Packet* packet)
+		    : LdapLayer(std::move(asn1Arena), asn1Record, data, dataLen, prevLayer, packet)
 		{}
 	};
 
@@ -890,9 +895,9 @@ namespace pcpp
 	protected:
 		friend LdapLayer* LdapLayer::parseLdapMessage(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet);
 
-		LdapSearchResultDoneLayer(std::unique_ptr<Asn1Record> asn1Record, uint8_t* data, size_t dataLen,
-		                          Layer* prevLayer, Packet* packet)
-		    : LdapResponseLayer(std::move(asn1Record), data, dataLen, prevLayer, packet)
+		LdapSearchResultDoneLayer(std::unique_ptr<Asn1DecodeArena> asn1Arena, Asn1Record* asn1Record, uint8_t* data,
+		                          size_t dataLen, Layer* prevLayer, Packet* packet)
+		    : LdapResponseLayer(std::move(asn1Arena), asn1Record, data, dataLen, prevLayer, packet)
 		{}
 	};
 
@@ -923,9 +928,9 @@ namespace pcpp
 	protected:
 		friend LdapLayer* LdapLayer::parseLdapMessage(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet);
 
-		LdapModifyResponseLayer(std::unique_ptr<Asn1Record> asn1Record, uint8_t* data, size_t dataLen, Layer* prevLayer,
-		                        Packet* packet)
-		    : LdapResponseLayer(std::move(asn1Record), data, dataLen, prevLayer, packet)
+		LdapModifyResponseLayer(std::unique_ptr<Asn1DecodeArena> asn1Arena, Asn1Record* asn1Record, uint8_t* data,
+		                        size_t dataLen, Layer* prevLayer, Packet* packet)
+		    : LdapResponseLayer(std::move(asn1Arena), asn1Record, data, dataLen, prevLayer, packet)
 		{}
 	};
 
@@ -956,9 +961,9 @@ namespace pcpp
 	protected:
 		friend LdapLayer* LdapLayer::parseLdapMessage(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet);
 
-		LdapAddResponseLayer(std::unique_ptr<Asn1Record> asn1Record, uint8_t* data, size_t dataLen, Layer* prevLayer,
-		                     Packet* packet)
-		    : LdapResponseLayer(std::move(asn1Record), data, dataLen, prevLayer, packet)
+		LdapAddResponseLayer(std::unique_ptr<Asn1DecodeArena> asn1Arena, Asn1Record* asn1Record, uint8_t* data,
+		                     size_t dataLen, Layer* prevLayer, Packet* packet)
+		    : LdapResponseLayer(std::move(asn1Arena), asn1Record, data, dataLen, prevLayer, packet)
 		{}
 	};
 
@@ -989,9 +994,9 @@ namespace pcpp
 	protected:
 		friend LdapLayer* LdapLayer::parseLdapMessage(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet);
 
-		LdapDeleteResponseLayer(std::unique_ptr<Asn1Record> asn1Record, uint8_t* data, size_t dataLen, Layer* prevLayer,
-		                        Packet* packet)
-		    : LdapResponseLayer(std::move(asn1Record), data, dataLen, prevLayer, packet)
+		LdapDeleteResponseLayer(std::unique_ptr<Asn1DecodeArena> asn1Arena, Asn1Record* asn1Record, uint8_t* data,
+		                        size_t dataLen, Layer* prevLayer, Packet* packet)
+		    : LdapResponseLayer(std::move(asn1Arena), asn1Record, data, dataLen, prevLayer, packet)
 		{}
 	};
 
@@ -1022,9 +1027,9 @@ namespace pcpp
 	protected:
 		friend LdapLayer* LdapLayer::parseLdapMessage(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet);
 
-		LdapModifyDNResponseLayer(std::unique_ptr<Asn1Record> asn1Record, uint8_t* data, size_t dataLen,
-		                          Layer* prevLayer, Packet* packet)
-		    : LdapResponseLayer(std::move(asn1Record), data, dataLen, prevLayer, packet)
+		LdapModifyDNResponseLayer(std::unique_ptr<Asn1DecodeArena> asn1Arena, Asn1Record* asn1Record, uint8_t* data,
+		                          size_t dataLen, Layer* prevLayer, Packet* packet)
+		    : LdapResponseLayer(std::move(asn1Arena), asn1Record, data, dataLen, prevLayer, packet)
 		{}
 	};
 
@@ -1055,9 +1060,9 @@ namespace pcpp
 	protected:
 		friend LdapLayer* LdapLayer::parseLdapMessage(uint8_t* data, size_t dataLen, Layer* prevLayer, Packet* packet);
 
-		LdapCompareResponseLayer(std::unique_ptr<Asn1Record> asn1Record, uint8_t* data, size_t dataLen,
-		                         Layer* prevLayer, Packet* packet)
-		    : LdapResponseLayer(std::move(asn1Record), data, dataLen, prevLayer, packet)
+		LdapCompareResponseLayer(std::unique_ptr<Asn1DecodeArena> asn1Arena, Asn1Record* asn1Record, uint8_t* data,
+		                         size_t dataLen, Layer* prevLayer, Packet* packet)
+		    : LdapResponseLayer(std::move(asn1Arena), asn1Record, data, dataLen, prevLayer, packet)
 		{}
 	};
 
@@ -128,6 +128,21 @@ namespace pcpp
 		/// @param[in] other The instance to copy from
 		Packet& operator=(const Packet& other);
 
+		/// A move constructor for this class. The raw packet and the layers of the other instance are taken as they
+		/// are, without copying the raw data or parsing it again. The other instance is left without a raw packet or
+		/// layers
+		/// @param[in] other The instance to move from
+		Packet(Packet&& other) noexcept
+		{
+			moveDataFrom(other);
+		}
+
+		/// A move assignment operator. It first frees the layers and the raw packet of this instance the same way the
+		/// assignment operator does, then takes the raw packet and the layers of the other instance the same way the
+		/// move constructor does
+		/// @param[in] other The instance to move from
+		Packet& operator=(Packet&& other) noexcept;
+
 		/// Get a pointer to the Packet's RawPacket
 		/// @return A pointer to the Packet's RawPacket
 		RawPacket* getRawPacket() const
@@ -320,6 +335,8 @@ namespace pcpp
 	private:
 		void copyDataFrom(const Packet& other);
 
+		void moveDataFrom(Packet& other);
+
 		void destructPacketData();
 
 		bool extendLayer(Layer* layer, int offsetInLayer, size_t numOfBytesToExtend);
@@ -0,0 +1,561 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <tuple>
+#include <type_traits>
+#include "EthLayer.h"
+#include "VlanLayer.h"
+#include "IPv4Layer.h"
+#include "IPv6Layer.h"
+#include "TcpLayer.h"
+#include "UdpLayer.h"
+#include "RawPacket.h"
+
+/// @file
+/// A packet builder for a stack of headers known at compile time, for example
+/// PacketBuilder<EthLayer, VlanLayer, IPv4Layer, UdpLayer>. Header offsets are computed at compile time and headers are
+/// written directly into a caller-provided buffer, without creating Layer objects or allocating memory. The built
+/// packet can be parsed with Packet like any other packet
+
+/// @namespace pcpp
+/// @brief The main namespace for the PcapPlusPlus lib
+namespace pcpp
+{
+	/// The field a header uses to identify the protocol of the header after it
+	enum class PacketBuilderNextProtocolField
+	{
+		/// The header has no next protocol field, it must be the last header of the stack
+		None,
+		/// An EtherType field (Ethernet, VLAN)
+		EtherType,
+		/// An IP protocol field (IPv4 protocol, IPv6 next header)
+		IPProtocol
+	};
+
+	/// @class PacketBuilderHeader
+	/// Describes how PacketBuilder writes a header and gives typed access to the header in a packet being built. A
+	/// specialization exists for every layer that can be part of a PacketBuilder stack: EthLayer, VlanLayer,
+	/// IPv4Layer, IPv6Layer, UdpLayer and TcpLayer. Each specialization defines:
+	/// - HeaderLength: the length of the header
+	/// - EtherType / IPProtocol: the value the header before it uses to identify this header, 0 if it can't be
+	///   identified this way
+	/// - NextProtocolField: the field this header uses to identify the header after it
+	/// - init() / finalize(): write the header defaults, and the lengths, next protocol and checksum once the packet
+	///   length is known
+	/// @tparam LayerType The layer the header belongs to, or void for "no header"
+	template <typename LayerType> class PacketBuilderHeader;
+
+	/// @class PacketBuilderHeader<void>
+	/// The header before the first header and after the last one
+	template <> class PacketBuilderHeader<void>
+	{
+	public:
+		static constexpr size_t HeaderLength = 0;
+		static constexpr uint16_t EtherType = 0;
+		static constexpr uint8_t IPProtocol = 0;
+		static constexpr bool IsIP = false;
+	};
+
+	/// @class PacketBuilderHeader<EthLayer>
+	/// An Ethernet II header
+	template <> class PacketBuilderHeader<EthLayer>
+	{
+	public:
+		static constexpr size_t HeaderLength = sizeof(ether_header);
+		static constexpr uint16_t EtherType = 0;
+		static constexpr uint8_t IPProtocol = 0;
+		static constexpr bool IsIP = false;
+		static constexpr PacketBuilderNextProtocolField NextProtocolField = PacketBuilderNextProtocolField::EtherType;
+
+		/// A c'tor that wraps a header in a packet being built
+		/// @param[in] data A pointer to the header
+		explicit PacketBuilderHeader(uint8_t* data) : m_Data(data)
+		{}
+
+		/// @return A pointer to the header
+		ether_header* getHeader() const
+		{
+			return reinterpret_cast<ether_header*>(m_Data);
+		}
+
+		/// Set the source MAC address
+		/// @param[in] sourceMac The source MAC address
+		void setSourceMac(const MacAddress& sourceMac) const
+		{
+			sourceMac.copyTo(getHeader()->srcMac);
+		}
+
+		/// Set the destination MAC address
+		/// @param[in] destMac The destination MAC address
+		void setDestMac(const MacAddress& destMac) const
+		{
+			destMac.copyTo(getHeader()->dstMac);
+		}
+
+		static void init(uint8_t* data);
+		static void finalize(uint8_t* data, size_t length, const uint8_t* prevHeader, uint16_t nextProtocol);
+
+	private:
+		uint8_t* m_Data;
+	};
+
+	/// @class PacketBuilderHeader<VlanLayer>
+	/// An 802.1Q VLAN tag
+	template <> class PacketBuilderHeader<VlanLayer>
+	{
+	public:
+		static constexpr size_t HeaderLength = sizeof(vlan_header);
+		static constexpr uint16_t EtherType = PCPP_ETHERTYPE_VLAN;
+		static constexpr uint8_t IPProtocol = 0;
+		static constexpr bool IsIP = false;
+		static constexpr PacketBuilderNextProtocolField NextProtocolField = PacketBuilderNextProtocolField::EtherType;
+
+		/// A c'tor that wraps a header in a packet being built
+		/// @param[in] data A pointer to the header
+		explicit PacketBuilderHeader(uint8_t* data) : m_Data(data)
+		{}
+
+		/// @return A pointer to the header
+		vlan_header* getHeader() const
+		{
+			return reinterpret_cast<vlan_header*>(m_Data);
+		}
+
+		/// Set the VLAN ID
+		/// @param[in] vlanID The VLAN ID, 12 bits
+		void setVlanID(uint16_t vlanID) const;
+
+		/// Set the priority (PCP)
+		/// @param[in] priority The priority, 3 bits
+		void setPriority(uint8_t priority) const;
+
+		/// Set the CFI (DEI) bit
+		/// @param[in] cfi The CFI bit value
+		void setCFI(bool cfi) const;
+
+		static void init(uint8_t* data);
+		static void finalize(uint8_t* data, size_t length, const uint8_t* prevHeader, uint16_t nextProtocol);
+
+	private:
+		uint8_t* m_Data;
+	};
+
+	/// @class PacketBuilderHeader<IPv4Layer>
+	/// An IPv4 header without options. It's initialized with a TTL of 64
+	template <> class PacketBuilderHeader<IPv4Layer>
+	{
+	public:
+		static constexpr size_t HeaderLength = sizeof(iphdr);
+		static constexpr uint16_t EtherType = PCPP_ETHERTYPE_IP;
+		static constexpr uint8_t IPProtocol = PACKETPP_IPPROTO_IPIP;
+		static constexpr bool IsIP = true;
+		static constexpr PacketBuilderNextProtocolField NextProtocolField =
+		    PacketBuilderNextProtocolField::IPProtocol;
+
+		/// A c'tor that wraps a header in a packet being built
+		/// @param[in] data A pointer to the header
+		explicit PacketBuilderHeader(uint8_t* data) : m_Data(data)
+		{}
+
+		/// @return A pointer to the header
+		iphdr* getHeader() const
+		{
+			return reinterpret_cast<iphdr*>(m_Data);
+		}
+
+		/// Set the source IPv4 address
+		/// @param[in] ipAddr The source address
+		void setSrcIPv4Address(const IPv4Address& ipAddr) const
+		{
+			getHeader()->ipSrc = ipAddr.toInt();
+		}
+
+		/// Set the destination IPv4 address
+		/// @param[in] ipAddr The destination address
+		void setDstIPv4Address(const IPv4Address& ipAddr) const
+		{
+			getHeader()->ipDst = ipAddr.toInt();
+		}
+
+		/// Set the time to live
+		/// @param[in] timeToLive The time to live
+		void setTimeToLive(uint8_t timeToLive) const
+		{
+			getHeader()->timeToLive = timeToLive;
+		}
+
+		/// Set the type of service (DSCP and ECN)
+		/// @param[in] typeOfService The type of service
+		void setTypeOfService(uint8_t typeOfService) const
+		{
+			getHeader()->typeOfService = typeOfService;
+		}
+
+		/// Set the identification field
+		/// @param[in] ipId The identification, in host byte order
+		void setIpId(uint16_t ipId) const;
+
+		static void init(uint8_t* data);
+		static void finalize(uint8_t* data, size_t length, const uint8_t* prevHeader, uint16_t nextProtocol);
+
+	private:
+		uint8_t* m_Data;
+	};
+
+	/// @class PacketBuilderHeader<IPv6Layer>
+	/// An IPv6 header without extensions. It's initialized with a hop limit of 64
+	template <> class PacketBuilderHeader<IPv6Layer>
+	{
+	public:
+		static constexpr size_t HeaderLength = sizeof(ip6_hdr);
+		static constexpr uint16_t EtherType = PCPP_ETHERTYPE_IPV6;
+		static constexpr uint8_t IPProtocol = PACKETPP_IPPROTO_IPV6;
+		static constexpr bool IsIP = true;
+		static constexpr PacketBuilderNextProtocolField NextProtocolField =
+		    PacketBuilderNextProtocolField::IPProtocol;
+
+		/// A c'tor that wraps a header in a packet being built
+		/// @param[in] data A pointer to the header
+		explicit PacketBuilderHeader(uint8_t* data) : m_Data(data)
+		{}
+
+		/// @return A pointer to the header
+		ip6_hdr* getHeader() const
+		{
+			return reinterpret_cast<ip6_hdr*>(m_Data);
+		}
+
+		/// Set the source IPv6 address
+		/// @param[in] ipAddr The source address
+		void setSrcIPv6Address(const IPv6Address& ipAddr) const
+		{
+			ipAddr.copyTo(getHeader()->ipSrc);
+		}
+
+		/// Set the destination IPv6 address
+		/// @param[in] ipAddr The destination address
+		void setDstIPv6Address(const IPv6Address& ipAddr) const
+		{
+			ipAddr.copyTo(getHeader()->ipDst);
+		}
+
+		/// Set the hop limit
+		/// @param[in] hopLimit The hop limit
+		void setHopLimit(uint8_t hopLimit) const
+		{
+			getHeader()->hopLimit = hopLimit;
+		}
+
+		static void init(uint8_t* data);
+		static void finalize(uint8_t* data, size_t length, const uint8_t* prevHeader, uint16_t nextProtocol);
+
+	private:
+		uint8_t* m_Data;
+	};
+
+	/// @class PacketBuilderHeader<UdpLayer>
+	/// A UDP header. It must follow an IPv4 / IPv6 header and be the last header of the stack
+	template <> class PacketBuilderHeader<UdpLayer>
+	{
+	public:
+		static constexpr size_t HeaderLength = sizeof(udphdr);
+		static constexpr uint16_t EtherType = 0;
+		static constexpr uint8_t IPProtocol = PACKETPP_IPPROTO_UDP;
+		static constexpr bool IsIP = false;
+		static constexpr PacketBuilderNextProtocolField NextProtocolField = PacketBuilderNextProtocolField::None;
+
+		/// A c'tor that wraps a header in a packet being built
+		/// @param[in] data A pointer to the header
+		explicit PacketBuilderHeader(uint8_t* data) : m_Data(data)
+		{}
+
+		/// @return A pointer to the header
+		udphdr* getHeader() const
+		{
+			return reinterpret_cast<udphdr*>(m_Data);
+		}
+
+		/// Set the source port
+		/// @param[in] port The source port, in host byte order
+		void setSrcPort(uint16_t port) const;
+
+		/// Set the destination port
+		/// @param[in] port The destination port, in host byte order
+		void setDstPort(uint16_t port) const;
+
+		static void init(uint8_t* data);
+		static void finalize(uint8_t* data, size_t length, const uint8_t* prevHeader, uint16_t nextProtocol);
+
+	private:
+		uint8_t* m_Data;
+	};
+
+	/// @class PacketBuilderHeader<TcpLayer>
+	/// A TCP header without options. It must follow an IPv4 / IPv6 header and be the last header of the stack
+	template <> class PacketBuilderHeader<TcpLayer>
+	{
+	public:
+		static constexpr size_t HeaderLength = sizeof(tcphdr);
+		static constexpr uint16_t EtherType = 0;
+		static constexpr uint8_t IPProtocol = PACKETPP_IPPROTO_TCP;
+		static constexpr bool IsIP = false;
+		static constexpr PacketBuilderNextProtocolField NextProtocolField = PacketBuilderNextProtocolField::None;
+
+		/// A c'tor that wraps a header in a packet being built
+		/// @param[in] data A pointer to the header
+		explicit PacketBuilderHeader(uint8_t* data) : m_Data(data)
+		{}
+
+		/// @return A pointer to the header
+		tcphdr* getHeader() const
+		{
+			return reinterpret_cast<tcphdr*>(m_Data);
+		}
+
+		/// Set the source port
+		/// @param[in] port The source port, in host byte order
+		void setSrcPort(uint16_t port) const;
+
+		/// Set the destination port
+		/// @param[in] port The destination port, in host byte order
+		void setDstPort(uint16_t port) const;
+
+		/// Set the sequence number
+		/// @param[in] sequenceNumber The sequence number, in host byte order
+		void setSequenceNumber(uint32_t sequenceNumber) const;
+
+		/// Set the acknowledgment number
+		/// @param[in] ackNumber The acknowledgment number, in host byte order
+		void setAckNumber(uint32_t ackNumber) const;
+
+		/// Set the window size
+		/// @param[in] windowSize The window size, in host byte order
+		void setWindowSize(uint16_t windowSize) const;
+
+		/// Set the flags byte: FIN = 0x01, SYN = 0x02, RST = 0x04, PSH = 0x08, ACK = 0x10, URG = 0x20, ECE = 0x40,
+		/// CWR = 0x80
+		/// @param[in] flags The flags
+		void setFlags(uint8_t flags) const
+		{
+			m_Data[13] = flags;
+		}
+
+		static void init(uint8_t* data);
+		static void finalize(uint8_t* data, size_t length, const uint8_t* prevHeader, uint16_t nextProtocol);
+
+	private:
+		uint8_t* m_Data;
+	};
+
+	namespace internal
+	{
+		/// The total length of a header stack
+		template <typename... LayerTypes> struct PacketBuilderLength;
+
+		template <> struct PacketBuilderLength<>
+		{
+			static constexpr size_t value = 0;
+		};
+
+		template <typename First, typename... Rest> struct PacketBuilderLength<First, Rest...>
+		{
+			static constexpr size_t value =
+			    PacketBuilderHeader<First>::HeaderLength + PacketBuilderLength<Rest...>::value;
+		};
+
+		/// The offset of a header in a header stack
+		template <size_t Index, typename... LayerTypes> struct PacketBuilderOffset;
+
+		template <typename First, typename... Rest> struct PacketBuilderOffset<0, First, Rest...>
+		{
+			static constexpr size_t value = 0;
+		};
+
+		template <size_t Index, typename First, typename... Rest> struct PacketBuilderOffset<Index, First, Rest...>
+		{
+			static constexpr size_t value =
+			    PacketBuilderHeader<First>::HeaderLength + PacketBuilderOffset<Index - 1, Rest...>::value;
+		};
+
+		/// Check that a PacketBuilder buffer can hold the headers
+		/// @return True if the buffer isn't nullptr and isn't shorter than headerLength, otherwise an error is printed
+		/// to log and false is returned
+		bool isValidPacketBuilderBuffer(const uint8_t* buffer, size_t bufferLen, size_t headerLength);
+	}  // namespace internal
+
+	/// @class PacketBuilder
+	/// Builds packets with a fixed stack of headers in a caller-provided buffer. For example:
+	/// @code
+	/// uint8_t buffer[1518];
+	/// pcpp::PacketBuilder<pcpp::EthLayer, pcpp::IPv4Layer, pcpp::UdpLayer> builder(buffer, sizeof(buffer));
+	/// builder.getHeader<0>().setSourceMac(srcMac);
+	/// builder.getHeader<1>().setSrcIPv4Address(srcIP);
+	/// builder.getHeader<2>().setDstPort(53);
+	/// memcpy(builder.getPayload(), payload, payloadLen);
+	/// size_t packetLen = builder.finalize(payloadLen);
+	/// @endcode
+	/// The c'tor writes the header defaults (zeros, IP versions, header lengths, a TTL / hop limit of 64). The typed
+	/// setters of PacketBuilderHeader write header fields in place, and finalize() writes the next protocol fields,
+	/// lengths and checksums of all headers in a single pass. Unsupported or invalid stacks (for example UDP after
+	/// Ethernet) are compile errors. Nothing is allocated, so a builder can be created for every packet
+	/// @tparam LayerTypes The layers of the header stack, outermost first
+	template <typename... LayerTypes> class PacketBuilder
+	{
+	public:
+		static_assert(sizeof...(LayerTypes) > 0, "A PacketBuilder needs at least one header");
+
+		/// The layer type of a header in the stack
+		template <size_t Index> using LayerAt = typename std::tuple_element<Index, std::tuple<LayerTypes...>>::type;
+
+		/// The number of headers in the stack
+		static constexpr size_t HeaderCount = sizeof...(LayerTypes);
+
+		/// The length of all headers in the stack
+		static constexpr size_t HeaderLength = internal::PacketBuilderLength<LayerTypes...>::value;
+
+		/// @tparam Index The index of a header in the stack
+		/// @return The offset of the header from the start of the packet
+		template <size_t Index> static constexpr size_t getHeaderOffset()
+		{
+			static_assert(Index < HeaderCount, "Header index is out of range");
+			return internal::PacketBuilderOffset<Index, LayerTypes...>::value;
+		}
+
+		/// A c'tor that builds the packet in a buffer and writes the header defaults. If the buffer is nullptr or too
+		/// short for the headers an error is printed to log and the builder is invalid (see isValid()): nothing is
+		/// written and finalize() returns 0
+		/// @param[in] buffer The buffer to build the packet in
+		/// @param[in] bufferLen The buffer length, the maximum packet length
+		PacketBuilder(uint8_t* buffer, size_t bufferLen) : m_Buffer(nullptr), m_BufferLen(0), m_RawPacket(nullptr)
+		{
+			if (!internal::isValidPacketBuilderBuffer(buffer, bufferLen, HeaderLength))
+			{
+				return;
+				// throw std::invalid_argument("Buffer is too short for the packet headers");
+			}
+
+			m_Buffer = buffer;
+			m_BufferLen = bufferLen;
+			initHeaders(std::integral_constant<size_t, 0>());
+		}
+
+		/// A c'tor that builds the packet in the data of a raw packet and writes the header defaults. The current
+		/// raw data length is the maximum packet length, and finalize() trims the raw data to the packet length. Use
+		/// RawPacket#reset() to recycle a raw packet for the next packet. If the raw data is too short for the headers
+		/// the builder is invalid, as with the other c'tor
+		/// @param[in] rawPacket The raw packet to build the packet in
+		explicit PacketBuilder(RawPacket& rawPacket)
+		    : PacketBuilder(const_cast<uint8_t*>(rawPacket.getRawData()),
+		                    static_cast<size_t>(rawPacket.getRawDataLen()))
+		{
+			m_RawPacket = &rawPacket;
+		}
+
+		/// @return True if the builder was created with a buffer that can hold the headers. The headers and payload of
+		/// an invalid builder must not be accessed
+		bool isValid() const
+		{
+			return m_Buffer != nullptr;
+		}
+
+		/// @tparam Index The index of a header in the stack
+		/// @return Typed access to the header
+		template <size_t Index> PacketBuilderHeader<LayerAt<Index>> getHeader() const
+		{
+			return PacketBuilderHeader<LayerAt<Index>>(m_Buffer + getHeaderOffset<Index>());
+		}
+
+		/// @return A pointer to the packet data, or nullptr if the builder is invalid
+		uint8_t* getData() const
+		{
+			return m_Buffer;
+		}
+
+		/// @return A pointer to the payload, right after the last header
+		uint8_t* getPayload() const
+		{
+			return m_Buffer + HeaderLength;
+		}
+
+		/// @return The maximum payload length that fits in the buffer, 0 if the builder is invalid
+		size_t getMaxPayloadLength() const
+		{
+			return isValid() ? m_BufferLen - HeaderLength : 0;
+		}
+
+		/// Write the next protocol fields, lengths and checksums of all headers. Call it after the payload is written
+		/// and the header fields are set. The headers are finalized innermost first, so a checksum covers the final
+		/// values of the headers after it
+		/// @param[in] payloadLength The length of the payload written after the headers
+		/// @return The packet length, or 0 if the builder is invalid, the payload doesn't fit in the buffer or the
+		/// packet is longer than 65535 bytes
+		size_t finalize(size_t payloadLength)
+		{
+			if (!isValid() || payloadLength > getMaxPayloadLength() ||
+			    HeaderLength + payloadLength >= PCPP_MAX_PACKET_SIZE)
+				return 0;
+
+			size_t packetLength = HeaderLength + payloadLength;
+			finalizeHeaders(packetLength, std::integral_constant<size_t, HeaderCount>());
+
+			if (m_RawPacket != nullptr && packetLength < static_cast<size_t>(m_RawPacket->getRawDataLen()))
+				m_RawPacket->removeData(static_cast<int>(packetLength),
+				                        static_cast<size_t>(m_RawPacket->getRawDataLen()) - packetLength);
+
+			return packetLength;
+		}
+
+	private:
+		// the layers with void before the first one and after the last one
+		using Stack = std::tuple<void, LayerTypes..., void>;
+
+		uint8_t* m_Buffer;
+		size_t m_BufferLen;
+		RawPacket* m_RawPacket;
+
+		void initHeaders(std::integral_constant<size_t, HeaderCount>)
+		{}
+
+		template <size_t Index> void initHeaders(std::integral_constant<size_t, Index>)
+		{
+			constexpr size_t offset = getHeaderOffset<Index>();
+			memset(m_Buffer + offset, 0, PacketBuilderHeader<LayerAt<Index>>::HeaderLength);
+			PacketBuilderHeader<LayerAt<Index>>::init(m_Buffer + offset);
+			initHeaders(std::integral_constant<size_t, Index + 1>());
+		}
+
+		void finalizeHeaders(size_t, std::integral_constant<size_t, 0>)
+		{}
+
+		// finalize the first Count headers, last one first
+		template <size_t Count> void finalizeHeaders(size_t packetLength, std::integral_constant<size_t, Count>)
+		{
+			constexpr size_t index = Count - 1;
+			using Header = PacketBuilderHeader<LayerAt<index>>;
+			using PrevHeader = PacketBuilderHeader<typename std::tuple_element<index, Stack>::type>;
+			using NextLayer = typename std::tuple_element<index + 2, Stack>::type;
+			using NextHeader = PacketBuilderHeader<NextLayer>;
+
+			constexpr uint16_t nextProtocol =
+			    Header::NextProtocolField == PacketBuilderNextProtocolField::EtherType ? NextHeader::EtherType
+			    : Header::NextProtocolField == PacketBuilderNextProtocolField::IPProtocol
+			        ? static_cast<uint16_t>(NextHeader::IPProtocol)
+			        : 0;
+			static_assert(std::is_void<NextLayer>::value || nextProtocol != 0,
+			              "A header in the PacketBuilder stack can't follow the header before it");
+			static_assert(Header::IPProtocol == 0 || Header::IsIP || PrevHeader::IsIP,
+			              "TCP / UDP headers must follow an IPv4 / IPv6 header");
+
+			constexpr size_t offset = getHeaderOffset<index>();
+			const uint8_t* prevHeader = index == 0 ? nullptr : m_Buffer + offset - PrevHeader::HeaderLength;
+			Header::finalize(m_Buffer + offset, packetLength - offset, prevHeader, nextProtocol);
+
+			finalizeHeaders(packetLength, std::integral_constant<size_t, index>());
+		}
+	};
+
+	template <typename... LayerTypes> constexpr size_t PacketBuilder<LayerTypes...>::HeaderCount;
+	template <typename... LayerTypes> constexpr size_t PacketBuilder<LayerTypes...>::HeaderLength;
+}  // namespace pcpp
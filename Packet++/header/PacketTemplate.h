@@ -0,0 +1,187 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+#include "IpAddress.h"
+#include "RawPacket.h"
+
+/// @file
+/// A template engine for high-rate traffic generation. A packet is built once with the Packet++ layer API, and
+/// copies of it are stamped into caller buffers. Each copy can then have a declared set of fields (addresses, ports,
+/// sequence numbers, payload bytes) patched and its payload length changed, while lengths and checksums are fixed up
+/// incrementally instead of re-parsing the packet and running computeCalculateFields() on every layer
+
+/// @namespace pcpp
+/// @brief The main namespace for the PcapPlusPlus lib
+namespace pcpp
+{
+	// Forward Declaration
+	class Packet;
+
+	/// @class PacketTemplate
+	/// A packet captured once, with the offsets of its fields and the partial checksums needed to patch copies of it.
+	/// The template tracks the first IPv4 / IPv6 layer of the packet and the TCP or UDP layer right after it:
+	/// - stamp() copies the packet into a buffer. When the requested payload length differs from the template's, the
+	///   payload is truncated or zero-padded and the IPv4 total length, IPv6 payload length, UDP length, IPv4 header
+	///   checksum and TCP / UDP checksum are updated from precomputed sums, in constant time
+	/// - setField() writes a new value into a declared field of a stamped packet and updates the IPv4 header checksum
+	///   and TCP / UDP checksum by the difference between the old and new value (RFC 1624)
+	///
+	/// The headers of other layers, for example the inner IP header of a tunnel, are copied as is; their lengths and
+	/// checksums aren't updated. A UDP checksum of 0 (no checksum, IPv4 only) is kept 0. A template is immutable after
+	/// its fields are declared, so stamping can be done concurrently by multiple threads
+	class PacketTemplate
+	{
+	public:
+		/// A c'tor that captures a packet. computeCalculateFields() is called on the packet first, so the captured
+		/// lengths and checksums are valid. The packet isn't referenced after the c'tor returns
+		/// @param[in,out] packet The packet to capture
+		explicit PacketTemplate(Packet& packet);
+
+		/// Declare a field of the packet that will be patched with setField(). The field may not overlap a length or
+		/// checksum field the template updates, and may not be partly inside the IPv4 header or the bytes the TCP /
+		/// UDP checksum covers
+		/// @param[in] offset The offset of the field from the start of the packet
+		/// @param[in] length The field length in bytes, between 1 and 16
+		/// @return The index of the field, or -1 if the field is invalid
+		int addField(size_t offset, size_t length);
+
+		/// Declare the source IPv4 / IPv6 address as a field
+		/// @return The index of the field, or -1 if the packet has no IPv4 / IPv6 layer
+		int addSrcIPField();
+
+		/// Declare the destination IPv4 / IPv6 address as a field
+		/// @return The index of the field, or -1 if the packet has no IPv4 / IPv6 layer
+		int addDstIPField();
+
+		/// Declare the TCP / UDP source port as a field
+		/// @return The index of the field, or -1 if the packet has no TCP / UDP layer
+		int addSrcPortField();
+
+		/// Declare the TCP / UDP destination port as a field
+		/// @return The index of the field, or -1 if the packet has no TCP / UDP layer
+		int addDstPortField();
+
+		/// Declare the TCP sequence number as a field
+		/// @return The index of the field, or -1 if the packet has no TCP layer
+		int addTcpSequenceNumberField();
+
+		/// Declare a range of payload bytes as a field. The payload is the data after the TCP / UDP header (or after
+		/// the IP header if there's no TCP / UDP layer)
+		/// @param[in] payloadOffset The offset of the field from the start of the payload
+		/// @param[in] length The field length in bytes, between 1 and 16
+		/// @return The index of the field, or -1 if the field is invalid
+		int addPayloadField(size_t payloadOffset, size_t length);
+
+		/// Copy the packet into a buffer
+		/// @param[out] buffer The buffer to write the packet to
+		/// @param[in] bufferLen The buffer length
+		/// @return The packet length, or 0 if the buffer is too small
+		size_t stamp(uint8_t* buffer, size_t bufferLen) const;
+
+		/// Copy the packet into a buffer with a different payload length. Payload bytes beyond the template's payload
+		/// are zeroed
+		/// @param[out] buffer The buffer to write the packet to
+		/// @param[in] bufferLen The buffer length
+		/// @param[in] payloadLength The payload length of the stamped packet
+		/// @return The packet length, or 0 if the buffer is too small, the packet would be longer than 65535 bytes
+		/// from the IP header on or the packet has no payload to resize (no IPv4 / IPv6 layer)
+		size_t stamp(uint8_t* buffer, size_t bufferLen, size_t payloadLength) const;
+
+		/// Write a new value into a field of a stamped packet and update the checksums the field is covered by
+		/// @param[in,out] packetData The stamped packet
+		/// @param[in] packetLen The stamped packet length, as returned by stamp()
+		/// @param[in] fieldIndex The index of the field, as returned when the field was declared
+		/// @param[in] value The new value, as many bytes as the field length, in network byte order
+		/// @return True if the field was written, false if the index is invalid or the field is beyond the end of
+		/// the packet (a payload field of a packet stamped with a shorter payload)
+		bool setField(uint8_t* packetData, size_t packetLen, int fieldIndex, const uint8_t* value) const;
+
+		/// Write a new integer value into a 1, 2 or 4 byte field of a stamped packet, see setField()
+		/// @param[in,out] packetData The stamped packet
+		/// @param[in] packetLen The stamped packet length, as returned by stamp()
+		/// @param[in] fieldIndex The index of the field, as returned when the field was declared
+		/// @param[in] value The new value in host byte order
+		/// @return True if the field was written, false if the index is invalid, the field isn't 1, 2 or 4 bytes
+		/// long or the field is beyond the end of the packet
+		bool setField(uint8_t* packetData, size_t packetLen, int fieldIndex, uint32_t value) const;
+
+		/// Write a new address into an address field of a stamped packet, see setField()
+		/// @param[in,out] packetData The stamped packet
+		/// @param[in] packetLen The stamped packet length, as returned by stamp()
+		/// @param[in] fieldIndex The index of the field, as returned when the field was declared
+		/// @param[in] address The new address. Its length must match the field length
+		/// @return True if the field was written, false if the index is invalid or the address doesn't match the
+		/// field length
+		bool setField(uint8_t* packetData, size_t packetLen, int fieldIndex, const IPAddress& address) const;
+
+		/// @return The captured packet data
+		const uint8_t* getData() const
+		{
+			return m_Data.data();
+		}
+
+		/// @return The captured packet length
+		size_t getDataLen() const
+		{
+			return m_Data.size();
+		}
+
+		/// @return The length of the headers before the payload
+		size_t getHeaderLen() const
+		{
+			return m_HeaderLength;
+		}
+
+		/// @return The payload length of the captured packet
+		size_t getPayloadLen() const
+		{
+			return m_Data.size() - m_HeaderLength;
+		}
+
+		/// @return The link layer type of the captured packet
+		LinkLayerType getLinkLayerType() const
+		{
+			return m_LinkLayerType;
+		}
+
+		/// @return The number of declared fields
+		size_t getFieldCount() const
+		{
+			return m_Fields.size();
+		}
+
+	private:
+		// the maximum length of a field
+		static constexpr size_t MaxFieldLength = 16;
+		// an offset of a header or field the packet doesn't have
+		static constexpr size_t NoOffset = static_cast<size_t>(-1);
+
+		struct Field
+		{
+			uint16_t offset;
+			uint8_t length;
+			bool coveredByIPv4Checksum;
+			bool coveredByTransportChecksum;
+		};
+
+		std::vector<uint8_t> m_Data;
+		LinkLayerType m_LinkLayerType;
+		size_t m_HeaderLength;
+		size_t m_NetworkOffset;
+		size_t m_NetworkHeaderLength;
+		bool m_IsIPv6;
+		size_t m_TransportOffset;
+		bool m_IsUdp;
+		// the offset of the TCP / UDP checksum, NoOffset if there's no transport checksum to update
+		size_t m_TransportChecksumOffset;
+		// the sum of the pseudo header without its length and the transport header with its checksum and length zeroed
+		uint32_t m_TransportHeaderSum;
+		// m_PayloadPrefixSums[i] is the folded sum of the first i 16-bit words of the payload
+		std::vector<uint16_t> m_PayloadPrefixSums;
+		std::vector<Field> m_Fields;
+
+		uint32_t getPayloadSum(size_t payloadLength) const;
+	};
+}  // namespace pcpp
@@ -260,6 +260,7 @@ namespace pcpp
 	protected:
 		uint8_t* m_RawData = nullptr;
 		int m_RawDataLen = 0;
+		size_t m_RawDataCapacity = 0;
 		int m_FrameLength = 0;
 		timespec m_TimeStamp{};  // Zero initialized
 		bool m_DeleteRawDataAtDestructor = true;
@@ -267,6 +268,8 @@ namespace pcpp
 		LinkLayerType m_LinkLayerType = LinkLayerType::LINKTYPE_ETHERNET;
 
 		void copyDataFrom(const RawPacket& other, bool allocateData = true);
+		void moveDataFrom(RawPacket& other);
+		void updateRawDataCapacity();
 
 	public:
 		/// A default constructor that initializes class'es attributes to default value:
@@ -313,11 +316,23 @@ namespace pcpp
 		RawPacket(const RawPacket& other);
 
 		/// Assignment operator overload for this class. When using this operator on an already initialized RawPacket
-		/// instance, the original raw data is freed first if deleteRawDataAtDestructor was set to 'true'.
-		/// Then the other instance is copied to this instance, the same way the copy constructor works
+		/// instance that owns a buffer large enough for the other instance's data, the data is copied into that buffer.
+		/// Otherwise the original raw data is freed first if deleteRawDataAtDestructor was set to 'true' and the other
+		/// instance is copied to this instance, the same way the copy constructor works
 		/// @param[in] other The instance to copy from
 		RawPacket& operator=(const RawPacket& other);
 
+		/// A move constructor that takes the raw data of another instance without copying it. The other instance is
+		/// left without raw data
+		/// @param[in] other The instance to move from
+		RawPacket(RawPacket&& other) noexcept;
+
+		/// A move assignment operator. The original raw data is freed first if deleteRawDataAtDestructor was set to
+		/// 'true', then the raw data of the other instance is taken without copying it. The other instance is left
+		/// without raw data
+		/// @param[in] other The instance to move from
+		RawPacket& operator=(RawPacket&& other) noexcept;
+
 		/// @brief Clones the current packet. Caller is responsible for deallocation of the memory.
 		/// @return A pointer to the new RawPacket object which is a clone of this object
 		virtual RawPacket* clone() const;
@@ -391,6 +406,23 @@ namespace pcpp
 			return m_RawDataLen;
 		}
 
+		/// Get the length of the buffer the raw data is stored in, as far as this instance knows it. It's never
+		/// smaller than the raw data length, and it's larger when the buffer was allocated larger, for example by
+		/// reallocateData(), reset() or the Packet c'tors that get a maximum packet length, or when the raw data was
+		/// shortened since. For raw data set from an external buffer it's the raw data length that was set
+		/// @return The buffer length in bytes
+		size_t getRawDataCapacity() const
+		{
+			return m_RawDataCapacity;
+		}
+
+		/// @return True if the raw data is freed when this instance is cleared or destructed (deleteRawDataAtDestructor
+		/// is 'true'), false if it belongs to someone else, for example after initWithRawData()
+		bool isRawDataOwned() const
+		{
+			return m_DeleteRawDataAtDestructor;
+		}
+
 		/// Get frame length in bytes
 		/// @return frame length in bytes
 		int getFrameLength() const
@@ -428,6 +460,15 @@ namespace pcpp
 		/// @todo set timestamp to a default value as well
 		virtual void clear();
 
+		/// Prepare this instance for new data of up to a certain length, typically to recycle it for another packet.
+		/// The current buffer is kept if this instance owns it (deleteRawDataAtDestructor is 'true') and it's at least
+		/// capacity bytes long, otherwise it's freed if owned and a new buffer is allocated. The raw data length is
+		/// set to capacity and the buffer content is unspecified: write the new data in place, for example with a
+		/// PacketBuilder, and shorten it with removeData()
+		/// @param[in] capacity The buffer length needed
+		/// @return True if the buffer is ready, false otherwise
+		virtual bool reset(size_t capacity);
+
 		/// Append data to the end of current data. This method works without allocating more memory, it just uses
 		/// memcpy() to copy dataToAppend at the end of the current data. This means that the method assumes this memory
 		/// was already allocated by the user. If it isn't the case then this method will cause memory corruption
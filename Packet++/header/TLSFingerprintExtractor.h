@@ -0,0 +1,102 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/// @file
+/// A lightweight TLS fingerprint extractor which works directly on raw TCP payload bytes. Unlike
+/// SSLClientHelloMessage#generateTLSFingerprint() and SSLServerHelloMessage#generateTLSFingerprint() it doesn't
+/// require a parsed SSLHandshakeLayer: the ClientHello / ServerHello message is walked once, in place, and the
+/// digests are written into fixed-size buffers without any heap allocation
+
+/// @namespace pcpp
+/// @brief The main namespace for the PcapPlusPlus lib
+namespace pcpp
+{
+	/// @struct TLSFingerprint
+	/// The result of TLSFingerprintExtractor#extract(). All strings are null-terminated and stored inline
+	struct TLSFingerprint
+	{
+		/// The type of handshake message the fingerprint was extracted from
+		enum MessageType : uint8_t
+		{
+			/// No ClientHello or ServerHello was found
+			NoHelloMessage = 0,
+			/// The fingerprint was extracted from a ClientHello message (JA3 + JA4)
+			ClientHello = 1,
+			/// The fingerprint was extracted from a ServerHello message (JA3S)
+			ServerHello = 2
+		};
+
+		/// The length of an MD5 digest in hex, excluding the null terminator
+		static constexpr size_t JA3DigestLength = 32;
+		/// The length of a JA4 fingerprint (e.g "t13d1516h2_8daaf6152771_e5627efa2ab1"), excluding the null
+		/// terminator
+		static constexpr size_t JA4Length = 36;
+
+		/// The type of handshake message the fingerprint was extracted from
+		MessageType type = NoHelloMessage;
+
+		/// The MD5 of the JA3 string for ClientHello or the JA3S string for ServerHello, as lowercase hex. The value
+		/// is identical to ClientHelloTLSFingerprint#toMD5() / ServerHelloTLSFingerprint#toMD5()
+		char ja3[JA3DigestLength + 1] = {};
+
+		/// The JA4 fingerprint of a ClientHello message. Empty for ServerHello, if JA4 calculation wasn't requested
+		/// or if the message has more cipher suites / extensions than TLSFingerprintExtractor#MaxJA4ListSize
+		char ja4[JA4Length + 1] = {};
+
+		/// Clear all fields
+		void clear()
+		{
+			type = NoHelloMessage;
+			ja3[0] = '\0';
+			ja4[0] = '\0';
+		}
+	};
+
+	/// @class TLSFingerprintExtractor
+	/// Computes JA3 / JA3S and JA4 fingerprints in a single bounds-checked pass over a TCP payload which starts with
+	/// a TLS record. The payload may contain several records; the first ClientHello or ServerHello message found in
+	/// a handshake record is fingerprinted. A message which is truncated by the end of the payload is fingerprinted
+	/// with the data available, the same way SSLHandshakeLayer does it. This class has only static methods and keeps
+	/// no state, so it can be used concurrently from multiple threads
+	class TLSFingerprintExtractor
+	{
+	public:
+		/// The maximum number of cipher suites and extensions that can be sorted for the JA4 calculation. Messages
+		/// exceeding it get a JA3 fingerprint only
+		static constexpr size_t MaxJA4ListSize = 512;
+
+		/// Extract the TLS fingerprint from a single TCP payload
+		/// @param[in] data A pointer to the TCP payload
+		/// @param[in] dataLen The payload length
+		/// @param[out] result The fingerprint. Its type is TLSFingerprint#NoHelloMessage if no fingerprint was found
+		/// @param[in] calcJA4 Whether to also calculate the JA4 fingerprint of a ClientHello message. Default is true
+		/// @return True if a ClientHello or ServerHello message was found and fingerprinted, false otherwise
+		static bool extract(const uint8_t* data, size_t dataLen, TLSFingerprint& result, bool calcJA4 = true);
+
+		/// Extract the TLS fingerprint from a single handshake message, for example a message reassembled by
+		/// TLSStreamDecoder
+		/// @param[in] data A pointer to the handshake message, starting with the 4-byte handshake header
+		/// @param[in] dataLen The message length
+		/// @param[out] result The fingerprint. Its type is TLSFingerprint#NoHelloMessage if the message isn't a
+		/// ClientHello or ServerHello
+		/// @param[in] calcJA4 Whether to also calculate the JA4 fingerprint of a ClientHello message. Default is true
+		/// @return True if the message is a ClientHello or ServerHello message, false otherwise
+		static bool extractFromHandshakeMessage(const uint8_t* data, size_t dataLen, TLSFingerprint& result,
+		                                        bool calcJA4 = true);
+
+		/// Extract TLS fingerprints from a batch of TCP payloads
+		/// @param[in] payloads An array of pointers to TCP payloads
+		/// @param[in] payloadLengths An array of the payload lengths, in the same order as payloads
+		/// @param[in] count The number of payloads in the batch
+		/// @param[out] results An array of at least count elements which the fingerprints are written to
+		/// @param[in] calcJA4 Whether to also calculate the JA4 fingerprint of ClientHello messages. Default is true
+		/// @return The number of payloads in which a ClientHello or ServerHello message was found
+		static size_t extractBatch(const uint8_t* const payloads[], const size_t payloadLengths[], size_t count,
+		                           TLSFingerprint results[], bool calcJA4 = true);
+
+	private:
+		TLSFingerprintExtractor() = delete;
+	};
+}  // namespace pcpp
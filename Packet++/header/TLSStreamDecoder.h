@@ -0,0 +1,199 @@
+#pragma once
+
+#include "SSLCommon.h"
+#include "TcpReassembly.h"
+#include <unordered_map>
+#include <vector>
+
+/// @file
+/// TLS handshake decoding on top of TCP reassembly. SSLLayer only sees the records of a single packet, so handshake
+/// messages that are split across TCP segments (large ClientHello messages, certificate chains) are truncated. The
+/// pcpp#TLSStreamDecoder class consumes the in-order data delivered by pcpp#TcpReassembly and emits every complete
+/// handshake message of a connection:
+///
+/// - Records and handshake messages which are fully contained in one TCP segment are emitted directly from the
+///   segment data, without copying
+/// - Only records and handshake messages which cross a segment (or record) boundary are buffered, and the amount of
+///   buffered data per connection is capped (see pcpp#TLSStreamDecoder#TLSStreamDecoder())
+/// - Decoding of a connection side stops once its handshake becomes encrypted (ChangeCipherSpec or application data
+///   records), when bytes are missing in the TCP stream, when the data isn't TLS, or when the buffer cap is exceeded
+///
+/// A typical usage is to pass TLSStreamDecoder#onTcpMessageReady and TLSStreamDecoder#onTcpConnectionEnd to
+/// TcpReassembly with the decoder as the user cookie:
+///
+/// @code
+/// pcpp::TLSStreamDecoder decoder(onHandshakeMessage);
+/// pcpp::TcpReassembly tcpReassembly(pcpp::TLSStreamDecoder::onTcpMessageReady, &decoder, nullptr,
+///                                   pcpp::TLSStreamDecoder::onTcpConnectionEnd);
+/// @endcode
+
+/// @namespace pcpp
+/// @brief The main namespace for the PcapPlusPlus lib
+namespace pcpp
+{
+	/// @struct TLSHandshakeMessageData
+	/// A complete TLS handshake message emitted by TLSStreamDecoder
+	struct TLSHandshakeMessageData
+	{
+		/// The handshake message type
+		SSLHandshakeType handshakeType;
+		/// A pointer to the message, starting with the 4-byte handshake header. The data is valid only during the
+		/// callback
+		const uint8_t* data;
+		/// The message length including the handshake header
+		size_t dataLen;
+		/// The version of the record which contained the start of the message
+		uint16_t recordVersion;
+		/// True if the message was copied because it crossed a TCP segment or TLS record boundary, false if it points
+		/// directly into the segment data delivered by TcpReassembly
+		bool reassembled;
+		/// The connection this message belongs to
+		const ConnectionData* connectionData;
+		/// The timestamp of the TCP segment which completed the message
+		std::chrono::time_point<std::chrono::high_resolution_clock> timestamp;
+	};
+
+	/// @struct TLSStreamDecoderStats
+	/// Counters collected by TLSStreamDecoder
+	struct TLSStreamDecoderStats
+	{
+		/// Number of handshake messages emitted
+		uint64_t handshakeMessages = 0;
+		/// Number of handshake messages which had to be reassembled (copied) before being emitted
+		uint64_t reassembledHandshakeMessages = 0;
+		/// Number of TLS records that were fully contained in one segment
+		uint64_t zeroCopyRecords = 0;
+		/// Number of TLS records that crossed a segment boundary and were buffered
+		uint64_t bufferedRecords = 0;
+		/// Number of connection sides which stopped being decoded because the per-connection buffer cap was exceeded
+		uint64_t bufferCapExceeded = 0;
+		/// Number of connection sides which stopped being decoded because of non-TLS data or missing bytes
+		uint64_t decodeErrors = 0;
+	};
+
+	/// @class TLSStreamDecoder
+	/// Decodes TLS handshake messages from the reassembled TCP stream of each connection. Please refer to the
+	/// documentation at the top of TLSStreamDecoder.h for more details
+	class TLSStreamDecoder
+	{
+	public:
+		/// @typedef OnHandshakeMessage
+		/// A callback invoked for every complete handshake message
+		/// @param[in] side The side of the connection the message was sent from, as provided by TcpReassembly
+		/// @param[in] message The handshake message
+		/// @param[in] userCookie A pointer to the cookie provided by the user in the c'tor (or nullptr if no cookie
+		/// provided)
+		/// The callback may call closeConnection() or closeAllConnections(). Decoding of the closed connections stops
+		/// right away, and their state is released when the current processTcpData() call returns
+		typedef void (*OnHandshakeMessage)(int8_t side, const TLSHandshakeMessageData& message, void* userCookie);
+
+		/// The default cap on the number of bytes that can be buffered for a single connection
+		static constexpr size_t DefaultMaxBufferedBytesPerConnection = 256 * 1024;
+
+		/// A c'tor for this class
+		/// @param[in] onHandshakeMessageCallback The callback to be invoked for every complete handshake message. This
+		/// parameter is mandatory
+		/// @param[in] userCookie A pointer to an object provided by the user which is passed to the callback
+		/// @param[in] maxBufferedBytesPerConnection The maximum number of partial record / message bytes buffered for
+		/// a connection (both sides). A connection side that needs more stops being decoded
+		explicit TLSStreamDecoder(OnHandshakeMessage onHandshakeMessageCallback, void* userCookie = nullptr,
+		                          size_t maxBufferedBytesPerConnection = DefaultMaxBufferedBytesPerConnection);
+
+		/// Process a piece of reassembled TCP data. This is usually called from TcpReassembly#OnTcpMessageReady
+		/// @param[in] side The connection side as provided by TcpReassembly
+		/// @param[in] tcpData The TCP data
+		void processTcpData(int8_t side, const TcpStreamData& tcpData);
+
+		/// Release the state kept for a connection. This is usually called from TcpReassembly#OnTcpConnectionEnd.
+		/// When called from the handshake message callback the state is released after the current segment is
+		/// processed
+		/// @param[in] connectionData The connection to release
+		void closeConnection(const ConnectionData& connectionData);
+
+		/// Release the state of all connections. When called from the handshake message callback the state is released
+		/// after the current segment is processed
+		void closeAllConnections();
+
+		/// @return The number of connections which currently have decoding state
+		size_t getConnectionCount() const
+		{
+			return m_Connections.size();
+		}
+
+		/// @return The number of bytes currently buffered for a connection, or 0 if the connection isn't known
+		/// @param[in] flowKey The connection flow key (ConnectionData#flowKey)
+		size_t getBufferedBytes(uint32_t flowKey) const;
+
+		/// @return The decoder counters
+		const TLSStreamDecoderStats& getStatistics() const
+		{
+			return m_Stats;
+		}
+
+		/// A TcpReassembly#OnTcpMessageReady compatible callback. The user cookie must be a pointer to a
+		/// TLSStreamDecoder
+		static void onTcpMessageReady(int8_t side, const TcpStreamData& tcpData, void* userCookie);
+
+		/// A TcpReassembly#OnTcpConnectionEnd compatible callback. The user cookie must be a pointer to a
+		/// TLSStreamDecoder
+		static void onTcpConnectionEnd(const ConnectionData& connectionData,
+		                               TcpReassembly::ConnectionEndReason reason, void* userCookie);
+
+	private:
+		enum StopReason
+		{
+			HandshakeEncrypted,
+			DecodeError,
+			BufferCapExceeded
+		};
+
+		struct SideState
+		{
+			// a record which crossed a segment boundary: record header + partial body
+			std::vector<uint8_t> recordBuffer;
+			// a handshake message which crossed a record boundary: handshake header + partial body
+			std::vector<uint8_t> messageBuffer;
+			uint16_t messageRecordVersion = 0;
+			bool stopped = false;
+		};
+
+		struct ConnectionState
+		{
+			SideState sides[2];
+
+			size_t bufferedBytes() const
+			{
+				return sides[0].recordBuffer.size() + sides[0].messageBuffer.size() + sides[1].recordBuffer.size() +
+				       sides[1].messageBuffer.size();
+			}
+		};
+
+		struct SegmentContext
+		{
+			int8_t side;
+			const TcpStreamData* tcpData;
+			ConnectionState* connection;
+			SideState* sideState;
+		};
+
+		OnHandshakeMessage m_OnHandshakeMessage;
+		void* m_UserCookie;
+		size_t m_MaxBufferedBytes;
+		std::unordered_map<uint32_t, ConnectionState> m_Connections;
+		TLSStreamDecoderStats m_Stats;
+		// connections closed from the handshake message callback, released once the segment is processed
+		bool m_InCallback = false;
+		bool m_PendingCloseAll = false;
+		std::vector<uint32_t> m_PendingCloses;
+
+		void decodeTcpData(int8_t side, const TcpStreamData& tcpData);
+		void releasePendingCloses();
+		void processRecord(SegmentContext& ctx, const uint8_t* record, size_t recordLen, bool buffered);
+		void processHandshakeData(SegmentContext& ctx, const uint8_t* data, size_t dataLen, uint16_t recordVersion,
+		                          bool buffered);
+		bool appendToBuffer(SegmentContext& ctx, std::vector<uint8_t>& buffer, const uint8_t* data, size_t dataLen);
+		void emitMessage(SegmentContext& ctx, const uint8_t* data, size_t dataLen, uint16_t recordVersion,
+		                 bool reassembled);
+		void stopSide(SideState& sideState, StopReason reason);
+	};
+}  // namespace pcpp
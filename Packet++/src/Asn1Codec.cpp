@@ -3,6 +3,7 @@
 #include "Asn1Codec.h"
 #include "GeneralUtils.h"
 #include "EndianPortable.h"
+#include "Logger.h"
 #include <unordered_map>
 #include <numeric>
 #include <algorithm>
@@ -11,6 +12,7 @@
 #include <cmath>
 #include <limits>
 #include <cstring>
+#include <new>
 
 #if defined(_WIN32)
 #	undef max
@@ -87,12 +89,101 @@ namespace pcpp
 		return "Unknown";
 	}
 
+	Asn1DecodeArena::Asn1DecodeArena(size_t blockSize) : m_BlockSize(blockSize)
+	{}
+
+	Asn1DecodeArena::~Asn1DecodeArena()
+	{
+		destroyRecords();
+	}
+
+	void Asn1DecodeArena::reset()
+	{
+		destroyRecords();
+		m_CurrentBlock = 0;
+		m_Offset = 0;
+	}
+
+	size_t Asn1DecodeArena::getCapacity() const
+	{
+		size_t capacity = 0;
+		for (const auto& block : m_Blocks)
+		{
+			capacity += block.size;
+		}
+		return capacity;
+	}
+
+	void* Asn1DecodeArena::allocate(size_t size, size_t alignment)
+	{
+		while (m_CurrentBlock < m_Blocks.size())
+		{
+			size_t alignedOffset = (m_Offset + alignment - 1) & ~(alignment - 1);
+			if (alignedOffset + size <= m_Blocks[m_CurrentBlock].size)
+			{
+				m_Offset = alignedOffset + size;
+				return m_Blocks[m_CurrentBlock].data.get() + alignedOffset;
+			}
+
+			m_CurrentBlock++;
+			m_Offset = 0;
+		}
+
+		Block block;
+		block.size = std::max(m_BlockSize, size + alignment);
+		block.data.reset(new uint8_t[block.size]);
+		m_Blocks.push_back(std::move(block));
+		m_CurrentBlock = m_Blocks.size() - 1;
+		m_Offset = size;
+		return m_Blocks.back().data.get();
+	}
+
+	void Asn1DecodeArena::destroyRecords()
+	{
+		// sub-records are always added after their parent, so they are destroyed first
+		for (auto iter = m_Records.rbegin(); iter != m_Records.rend(); ++iter)
+		{
+			(*iter)->~Asn1Record();
+		}
+		m_Records.clear();
+	}
+
 	std::unique_ptr<Asn1Record> Asn1Record::decode(const uint8_t* data, size_t dataLen, bool lazy)
 	{
 		auto record = decodeInternal(data, dataLen, lazy);
 		return std::unique_ptr<Asn1Record>(record);
 	}
 
+	Asn1Record* Asn1Record::decode(const uint8_t* data, size_t dataLen, Asn1DecodeArena& arena)
+	{
+		return decodeInternal(data, dataLen, true, &arena);
+	}
+
+	template <class Asn1RecordType> Asn1RecordType* Asn1Record::createRecord(Asn1DecodeArena* arena)
+	{
+		if (arena == nullptr)
+		{
+			return new Asn1RecordType();
+		}
+
+		auto record = new (arena->allocate(sizeof(Asn1RecordType), alignof(Asn1RecordType))) Asn1RecordType();
+		record->m_Arena = arena;
+		return record;
+	}
+
+	void Asn1Record::destroyRecord(Asn1Record* record)
+	{
+		if (record->m_Arena != nullptr)
+		{
+			// the memory stays in the arena until it's reset
+			record->~Asn1Record();
+		}
+		else
+		{
+			delete record;
+		}
+	}
+
 	uint8_t Asn1Record::encodeTag()
 	{
 		uint8_t tagByte;
@@ -159,6 +250,81 @@ namespace pcpp
 		return result;
 	}
 
+	size_t Asn1Record::getEncodedLength() const
+	{
+		size_t lengthLen = 1;
+		if (m_ValueLength >= 128)
+		{
+			for (auto tempValueLength = m_ValueLength; tempValueLength != 0; tempValueLength >>= 8)
+			{
+				lengthLen++;
+			}
+		}
+
+		return 1 + lengthLen + m_ValueLength;
+	}
+
+	size_t Asn1Record::encode(uint8_t* buffer, size_t bufferLen)
+	{
+		size_t encodedLen = encodeInto(buffer, bufferLen);
+		if (encodedLen == 0)
+		{
+			PCPP_LOG_ERROR("Cannot encode ASN.1 record, the buffer is too small or the record length is inconsistent");
+		}
+
+		return encodedLen;
+	}
+
+	size_t Asn1Record::encodeInto(uint8_t* buffer, size_t bufferLen)
+	{
+		size_t encodedLen = getEncodedLength();
+		if (buffer == nullptr || bufferLen < encodedLen)
+		{
+			return 0;
+		}
+
+		size_t headerLen = encodedLen - m_ValueLength;
+		buffer[0] = encodeTag();
+		if (headerLen == 2)
+		{
+			buffer[1] = static_cast<uint8_t>(m_ValueLength);
+		}
+		else
+		{
+			buffer[1] = 0x80 | static_cast<uint8_t>(headerLen - 2);
+			auto tempValueLength = m_ValueLength;
+			for (size_t i = headerLen - 1; i >= 2; i--)
+			{
+				buffer[i] = tempValueLength & 0xff;
+				tempValueLength >>= 8;
+			}
+		}
+
+		// a value that wasn't decoded yet is already encoded
+		if (m_EncodedValue != nullptr)
+		{
+			memcpy(buffer + headerLen, m_EncodedValue, m_ValueLength);
+		}
+		else if (!encodeValueInto(buffer + headerLen, m_ValueLength))
+		{
+			return 0;
+		}
+
+		return encodedLen;
+	}
+
+	bool Asn1Record::encodeValueInto(uint8_t* buffer, size_t valueLen) const
+	{
+		auto encodedValue = encodeValue();
+		if (encodedValue.size() != valueLen)
+		{
+			return false;
+		}
+
+		std::copy(encodedValue.begin(), encodedValue.end(), buffer);
+		return true;
+	}
+
 	std::vector<uint8_t> Asn1Record::encode()
 	{
 		std::vector<uint8_t> result;
@@ -174,10 +340,14 @@ namespace pcpp
 		return result;
 	}
 
-	Asn1Record* Asn1Record::decodeInternal(const uint8_t* data, size_t dataLen, bool lazy)
+	Asn1Record* Asn1Record::decodeInternal(const uint8_t* data, size_t dataLen, bool lazy, Asn1DecodeArena* arena)
 	{
 		uint8_t tagLen;
-		auto decodedRecord = decodeTagAndCreateRecord(data, dataLen, tagLen);
+		auto decodedRecord = decodeTagAndCreateRecord(data, dataLen, tagLen, arena);
+		if (decodedRecord == nullptr)
+		{
+			return nullptr;
+		}
 
 		uint8_t lengthLen;
 		// try
@@ -191,10 +361,11 @@ namespace pcpp
 		//}
 
 		decodedRecord->m_TotalLength = tagLen + lengthLen + decodedRecord->m_ValueLength;
-		if (decodedRecord->m_TotalLength < decodedRecord->m_ValueLength ||  // check for overflow
+		if (lengthLen == 0 ||
+		    decodedRecord->m_TotalLength < decodedRecord->m_ValueLength ||  // check for overflow
 		    decodedRecord->m_TotalLength > dataLen)
 		{
-			delete decodedRecord;
+			destroyRecord(decodedRecord);
 			return nullptr;
 			// throw std::invalid_argument("Cannot decode ASN.1 record, data doesn't contain the entire record");
 		}
@@ -216,6 +387,11 @@ namespace pcpp
 			decodedRecord->m_EncodedValue = const_cast<uint8_t*>(data) + tagLen + lengthLen;
 		}
 
+		if (arena != nullptr)
+		{
+			arena->m_Records.push_back(decodedRecord);
+		}
+
 		return decodedRecord;
 	}
 
@@ -229,7 +405,8 @@ namespace pcpp
 		return Asn1UniversalTagType::NotApplicable;
 	}
 
-	Asn1Record* Asn1Record::decodeTagAndCreateRecord(const uint8_t* data, size_t dataLen, uint8_t& tagLen)
+	Asn1Record* Asn1Record::decodeTagAndCreateRecord(const uint8_t* data, size_t dataLen, uint8_t& tagLen,
+	                                                 Asn1DecodeArena* arena)
 	{
 		if (dataLen < 1)
 		{
@@ -294,23 +471,23 @@ namespace pcpp
 				{
 				case Asn1UniversalTagType::Sequence:
 				{
-					newRecord = new Asn1SequenceRecord();
+					newRecord = createRecord<Asn1SequenceRecord>(arena);
 					break;
 				}
 				case Asn1UniversalTagType::Set:
 				{
-					newRecord = new Asn1SetRecord();
+					newRecord = createRecord<Asn1SetRecord>(arena);
 					break;
 				}
 				default:
 				{
-					newRecord = new Asn1ConstructedRecord();
+					newRecord = createRecord<Asn1ConstructedRecord>(arena);
 				}
 				}
 			}
 			else
 			{
-				newRecord = new Asn1ConstructedRecord();
+				newRecord = createRecord<Asn1ConstructedRecord>(arena);
 			}
 		}
 		else
@@ -322,38 +499,38 @@ namespace pcpp
 				{
 				case Asn1UniversalTagType::Integer:
 				{
-					newRecord = new Asn1IntegerRecord();
+					newRecord = createRecord<Asn1IntegerRecord>(arena);
 					break;
 				}
 				case Asn1UniversalTagType::Enumerated:
 				{
-					newRecord = new Asn1EnumeratedRecord();
+					newRecord = createRecord<Asn1EnumeratedRecord>(arena);
 					break;
 				}
 				case Asn1UniversalTagType::OctetString:
 				{
-					newRecord = new Asn1OctetStringRecord();
+					newRecord = createRecord<Asn1OctetStringRecord>(arena);
 					break;
 				}
 				case Asn1UniversalTagType::Boolean:
 				{
-					newRecord = new Asn1BooleanRecord();
+					newRecord = createRecord<Asn1BooleanRecord>(arena);
 					break;
 				}
 				case Asn1UniversalTagType::Null:
 				{
-					newRecord = new Asn1NullRecord();
+					newRecord = createRecord<Asn1NullRecord>(arena);
 					break;
 				}
 				default:
 				{
-					newRecord = new Asn1GenericRecord();
+					newRecord = createRecord<Asn1GenericRecord>(arena);
 				}
 				}
 			}
 			else
 			{
-				newRecord = new Asn1GenericRecord();
+				newRecord = createRecord<Asn1GenericRecord>(arena);
 			}
 		}
 
@@ -469,12 +646,22 @@ namespace pcpp
 
 	Asn1GenericRecord::~Asn1GenericRecord()
 	{
-		delete m_Value;
+		// records in an arena point to the decoded data instead of copying it
+		if (m_Arena == nullptr)
+		{
+			delete[] m_Value;
+		}
 	}
 
-	void Asn1GenericRecord::decodeValue(uint8_t* data, bool lazy)
+	void Asn1GenericRecord::decodeValue(uint8_t* data, bool)
 	{
-		delete m_Value;
+		if (m_Arena != nullptr)
+		{
+			m_Value = data;
+			return;
+		}
+
+		delete[] m_Value;
 
 		m_Value = new uint8_t[m_ValueLength];
 		memcpy(m_Value, data, m_ValueLength);
@@ -485,6 +672,15 @@ namespace pcpp
 		return { m_Value, m_Value + m_ValueLength };
 	}
 
+	bool Asn1GenericRecord::encodeValueInto(uint8_t* buffer, size_t valueLen) const
+	{
+		if (valueLen > 0)
+		{
+			memcpy(buffer, m_Value, valueLen);
+		}
+		return true;
+	}
+
 	void Asn1GenericRecord::init(Asn1TagClass tagClass, bool isConstructed, uint8_t tagType, const uint8_t* value,
 	                             size_t valueLen)
 	{
@@ -509,6 +705,18 @@ namespace pcpp
 		init(tagClass, tagType, subRecords.begin(), subRecords.end());
 	}
 
+	Asn1ConstructedRecord::~Asn1ConstructedRecord()
+	{
+		// sub-records in an arena are destroyed by the arena
+		if (m_Arena != nullptr)
+		{
+			while (m_SubRecords.size() > 0)
+			{
+				m_SubRecords.getAndDetach(m_SubRecords.size() - 1).release();
+			}
+		}
+	}
+
 	void Asn1ConstructedRecord::decodeValue(uint8_t* data, bool lazy)
 	{
 		if (!(data || m_ValueLength))
@@ -521,7 +729,13 @@ namespace pcpp
 
 		while (valueLen > 0)
 		{
-			auto subRecord = Asn1Record::decodeInternal(value, valueLen, lazy);
+			auto subRecord = Asn1Record::decodeInternal(value, valueLen, lazy, m_Arena);
+			if (subRecord == nullptr)
+			{
+				PCPP_LOG_DEBUG("Cannot decode ASN.1 sub-record, the rest of the record value is ignored");
+				break;
+			}
+
 			value += subRecord->getTotalLength();
 			valueLen -= subRecord->getTotalLength();
 
@@ -543,6 +757,22 @@ namespace pcpp
 		return result;
 	}
 
+	bool Asn1ConstructedRecord::encodeValueInto(uint8_t* buffer, size_t valueLen) const
+	{
+		size_t offset = 0;
+		for (auto record : m_SubRecords)
+		{
+			size_t encodedLen = record->encodeInto(buffer + offset, valueLen - offset);
+			if (encodedLen == 0)
+			{
+				return false;
+			}
+			offset += encodedLen;
+		}
+
+		return offset == valueLen;
+	}
+
 	std::vector<std::string> Asn1ConstructedRecord::toStringList()
 	{
 		decodeValueIfNeeded();
@@ -677,7 +907,7 @@ namespace pcpp
 		m_TotalLength = m_ValueLength + 2;
 	}
 
-	void Asn1IntegerRecord::decodeValue(uint8_t* data, bool lazy)
+	void Asn1IntegerRecord::decodeValue(uint8_t* data, bool)
 	{
 		m_Value = pcpp::byteArrayToHexString(data, m_ValueLength);
 	}
@@ -717,7 +947,7 @@ namespace pcpp
 		m_IsPrintable = false;
 	}
 
-	void Asn1OctetStringRecord::decodeValue(uint8_t* data, bool lazy)
+	void Asn1OctetStringRecord::decodeValue(uint8_t* data, bool)
 	{
 		auto value = reinterpret_cast<char*>(data);
 
@@ -750,6 +980,28 @@ namespace pcpp
 		return rawValue;
 	}
 
+	bool Asn1OctetStringRecord::encodeValueInto(uint8_t* buffer, size_t valueLen) const
+	{
+		if (m_IsPrintable)
+		{
+			if (m_Value.size() != valueLen)
+			{
+				return false;
+			}
+
+			std::copy(m_Value.begin(), m_Value.end(), buffer);
+			return true;
+		}
+
+		if (m_Value.size() / 2 != valueLen)
+		{
+			return false;
+		}
+
+		hexStringToByteArray(m_Value, buffer, valueLen);
+		return true;
+	}
+
 	std::vector<std::string> Asn1OctetStringRecord::toStringList()
 	{
 		return { Asn1Record::toStringList().front() + ", Value: " + getValue() };
@@ -762,7 +1014,7 @@ namespace pcpp
 		m_TotalLength = 3;
 	}
 
-	void Asn1BooleanRecord::decodeValue(uint8_t* data, bool lazy)
+	void Asn1BooleanRecord::decodeValue(uint8_t* data, bool)
 	{
 		m_Value = data[0] != 0;
 	}
@@ -773,6 +1025,17 @@ namespace pcpp
 		return { byte };
 	}
 
+	bool Asn1BooleanRecord::encodeValueInto(uint8_t* buffer, size_t valueLen) const
+	{
+		if (valueLen != 1)
+		{
+			return false;
+		}
+
+		buffer[0] = (m_Value ? 0xff : 0x00);
+		return true;
+	}
+
 	std::vector<std::string> Asn1BooleanRecord::toStringList()
 	{
 		return { Asn1Record::toStringList().front() + ", Value: " + (getValue() ? "true" : "false") };
@@ -0,0 +1,713 @@
+#define LOG_MODULE PacketLogModuleHttpLayer
+
+#include "HttpStreamParser.h"
+#include "Logger.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace pcpp
+{
+	static inline char toLowerAscii(char c)
+	{
+		return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+	}
+
+	static inline bool isWhiteSpace(char c)
+	{
+		return c == ' ' || c == '\t';
+	}
+
+	static inline bool isDecimalDigit(char c)
+	{
+		return c >= '0' && c <= '9';
+	}
+
+	static int hexDigitValue(char c)
+	{
+		if (c >= '0' && c <= '9')
+			return c - '0';
+		if (c >= 'a' && c <= 'f')
+			return c - 'a' + 10;
+		if (c >= 'A' && c <= 'F')
+			return c - 'A' + 10;
+		return -1;
+	}
+
+	// returns the offset right after the empty line that ends a header block, or 0 if the block isn't complete. The
+	// search starts at searchFrom, which allows continuing a search over a growing buffer
+	static size_t findHeadersEnd(const char* data, size_t dataLen, size_t searchFrom)
+	{
+		size_t offset = searchFrom;
+		while (offset < dataLen)
+		{
+			const char* lineBreak = static_cast<const char*>(memchr(data + offset, '\n', dataLen - offset));
+			if (lineBreak == nullptr)
+				return 0;
+
+			size_t lineBreakOffset = lineBreak - data;
+			if (lineBreakOffset + 1 < dataLen && data[lineBreakOffset + 1] == '\n')
+				return lineBreakOffset + 2;
+			if (lineBreakOffset + 2 < dataLen && data[lineBreakOffset + 1] == '\r' && data[lineBreakOffset + 2] == '\n')
+				return lineBreakOffset + 3;
+
+			offset = lineBreakOffset + 1;
+		}
+
+		return 0;
+	}
+
+	// returns the length of the line starting at data, without the line break, and sets nextLine to the offset after it
+	static size_t getLineLength(const char* data, size_t dataLen, size_t& nextLine)
+	{
+		const char* lineBreak = static_cast<const char*>(memchr(data, '\n', dataLen));
+		size_t lineLen = lineBreak != nullptr ? static_cast<size_t>(lineBreak - data) : dataLen;
+		nextLine = lineBreak != nullptr ? lineLen + 1 : dataLen;
+		if (lineLen > 0 && data[lineLen - 1] == '\r')
+			lineLen--;
+		return lineLen;
+	}
+
+	static HttpStreamSpan trim(const char* data, size_t dataLen)
+	{
+		while (dataLen > 0 && isWhiteSpace(*data))
+		{
+			data++;
+			dataLen--;
+		}
+		while (dataLen > 0 && isWhiteSpace(data[dataLen - 1]))
+			dataLen--;
+
+		HttpStreamSpan result;
+		result.data = data;
+		result.length = dataLen;
+		return result;
+	}
+
+	static bool parseContentLength(const HttpStreamSpan& value, uint64_t& contentLength)
+	{
+		if (value.length == 0)
+			return false;
+
+		uint64_t result = 0;
+		for (size_t i = 0; i < value.length; i++)
+		{
+			char c = value.data[i];
+			if (!isDecimalDigit(c) || result > (std::numeric_limits<uint64_t>::max() - 9) / 10)
+				return false;
+			result = result * 10 + (c - '0');
+		}
+
+		contentLength = result;
+		return true;
+	}
+
+	// the message is chunked if "chunked" is the last transfer coding, e.g "gzip, chunked"
+	static bool isChunkedEncoding(const HttpStreamSpan& value)
+	{
+		static const char chunked[] = "chunked";
+		const size_t chunkedLen = sizeof(chunked) - 1;
+		if (value.length < chunkedLen)
+			return false;
+
+		HttpStreamSpan lastCoding;
+		lastCoding.data = value.data + value.length - chunkedLen;
+		lastCoding.length = chunkedLen;
+		if (!lastCoding.equalsIgnoreCase(chunked))
+			return false;
+
+		return value.length == chunkedLen || value.data[value.length - chunkedLen - 1] == ',' ||
+		       isWhiteSpace(value.data[value.length - chunkedLen - 1]);
+	}
+
+	// ~~~~~~~~~~~~~~
+	// HttpStreamSpan
+	// ~~~~~~~~~~~~~~
+
+	bool HttpStreamSpan::equalsIgnoreCase(const char* str) const
+	{
+		size_t strLen = strlen(str);
+		if (strLen != length)
+			return false;
+
+		for (size_t i = 0; i < length; i++)
+		{
+			if (toLowerAscii(data[i]) != toLowerAscii(str[i]))
+				return false;
+		}
+
+		return true;
+	}
+
+	// ~~~~~~~~~~~~~~~~~~~~~~~~
+	// HttpStreamMessageHeaders
+	// ~~~~~~~~~~~~~~~~~~~~~~~~
+
+	const HttpStreamHeaderField* HttpStreamMessageHeaders::getField(const char* name) const
+	{
+		for (size_t i = 0; i < fieldCount; i++)
+		{
+			if (fields[i].name.equalsIgnoreCase(name))
+				return &fields[i];
+		}
+
+		return nullptr;
+	}
+
+	// ~~~~~~~~~~~~~~~~
+	// HttpStreamParser
+	// ~~~~~~~~~~~~~~~~
+
+	HttpStreamParser::HttpStreamParser(OnHttpHeaders onHeadersCallback, void* userCookie,
+	                                   OnHttpMessageEnd onMessageEndCallback, OnHttpBodyData onBodyDataCallback,
+	                                   size_t maxHeaderBytes)
+	    : m_OnHeaders(onHeadersCallback), m_OnMessageEnd(onMessageEndCallback), m_OnBodyData(onBodyDataCallback),
+	      m_UserCookie(userCookie), m_MaxHeaderBytes(maxHeaderBytes)
+	{}
+
+	void HttpStreamParser::processTcpData(int8_t side, const TcpStreamData& tcpData)
+	{
+		if (side < 0 || side > 1)
+		{
+			PCPP_LOG_ERROR("Invalid connection side: " << (int)side);
+			return;
+		}
+
+		ConnectionState& connection = m_Connections[tcpData.getConnectionData().flowKey];
+		SideState& sideState = connection.sides[side];
+		if (sideState.state == Stopped)
+			return;
+
+		SegmentContext segment = { side, &tcpData, &connection, &sideState };
+		sideState.lastTimestamp = tcpData.getTimeStampPrecise();
+
+		if (tcpData.isBytesMissing())
+		{
+			// missing body bytes can be skipped as long as the message boundaries are known
+			uint64_t missingBytes = tcpData.getMissingByteCount();
+			if (sideState.state == ReadingBodyUntilClose ||
+			    (sideState.state == ReadingBody && missingBytes <= sideState.remainingBytes))
+			{
+				sideState.complete = false;
+				sideState.bodyLength += missingBytes;
+				sideState.messageLength += missingBytes;
+				if (sideState.state == ReadingBody)
+				{
+					sideState.remainingBytes -= missingBytes;
+					if (sideState.remainingBytes == 0)
+						endMessage(side, sideState, tcpData.getConnectionData(), sideState.lastTimestamp, false);
+				}
+			}
+			else
+			{
+				PCPP_LOG_DEBUG("Bytes missing in HTTP stream of flow " << tcpData.getConnectionData().flowKey
+				                                                        << ", stopping to parse side " << (int)side);
+				stopSide(segment, true);
+				return;
+			}
+		}
+
+		const char* data = reinterpret_cast<const char*>(tcpData.getData());
+		size_t dataLen = tcpData.getDataLength();
+
+		while (dataLen > 0 && sideState.state != Stopped)
+		{
+			size_t consumed = 0;
+			switch (sideState.state)
+			{
+			case WaitingForMessage:
+			{
+				// empty lines between messages are ignored
+				if (*data == '\r' || *data == '\n')
+				{
+					consumed = 1;
+					break;
+				}
+
+				sideState.state = ReadingHeaders;
+				sideState.chunked = false;
+				sideState.complete = true;
+				sideState.headerLength = 0;
+				sideState.bodyLength = 0;
+				sideState.messageLength = 0;
+				sideState.firstByteTimestamp = sideState.lastTimestamp;
+				break;
+			}
+			case ReadingHeaders:
+				consumed = consumeHeaders(segment, data, dataLen);
+				break;
+			case ReadingBody:
+			case ReadingBodyUntilClose:
+			case ReadingChunkData:
+				consumed = consumeBody(segment, data, dataLen);
+				break;
+			case ReadingChunkSize:
+				consumed = consumeChunkSize(segment, data, dataLen);
+				break;
+			case ReadingChunkDataEnd:
+				consumed = consumeLineBreak(segment, data, dataLen);
+				break;
+			case ReadingTrailers:
+				consumed = consumeTrailers(segment, data, dataLen);
+				break;
+			case Stopped:
+				return;
+			}
+
+			data += consumed;
+			dataLen -= consumed;
+		}
+	}
+
+	size_t HttpStreamParser::consumeHeaders(SegmentContext& segment, const char* data, size_t dataLen)
+	{
+		std::string& headerBuffer = segment.sideState->headerBuffer;
+
+		// a header block which is fully contained in the segment is parsed in place
+		if (headerBuffer.empty())
+		{
+			size_t headersEnd = findHeadersEnd(data, dataLen, 0);
+			if (headersEnd > 0)
+			{
+				processHeaders(segment, data, headersEnd, false);
+				return headersEnd;
+			}
+		}
+
+		size_t prevSize = headerBuffer.size();
+		size_t bytesToAppend = std::min(dataLen, m_MaxHeaderBytes - prevSize);
+		headerBuffer.append(data, bytesToAppend);
+
+		// the empty line may have started in the previous segment
+		size_t headersEnd = findHeadersEnd(headerBuffer.data(), headerBuffer.size(), prevSize > 2 ? prevSize - 2 : 0);
+		if (headersEnd == 0)
+		{
+			if (headerBuffer.size() >= m_MaxHeaderBytes)
+			{
+				PCPP_LOG_DEBUG("HTTP header block of flow " << segment.tcpData->getConnectionData().flowKey
+				                                            << " exceeded the cap of " << m_MaxHeaderBytes << " bytes");
+				m_Stats.headerCapExceeded++;
+				stopSide(segment, false);
+			}
+
+			return dataLen;
+		}
+
+		// only the part of the segment up to the end of the header block is consumed
+		size_t consumed = headersEnd - prevSize;
+		headerBuffer.resize(headersEnd);
+		m_Stats.reassembledHeaders++;
+		processHeaders(segment, headerBuffer.data(), headersEnd, true);
+		std::string().swap(headerBuffer);
+		return consumed;
+	}
+
+	void HttpStreamParser::processHeaders(SegmentContext& segment, const char* headers, size_t headersLen,
+	                                      bool reassembled)
+	{
+		SideState& sideState = *segment.sideState;
+		ConnectionState& connection = *segment.connection;
+
+		HttpStreamMessageHeaders message;
+		message.version = HttpVersionUnknown;
+		message.method = HttpRequestLayer::HttpMethodUnknown;
+		message.statusCode = 0;
+		message.rawHeaders.data = headers;
+		message.rawHeaders.length = headersLen;
+		message.fields = m_Fields.data();
+		message.fieldCount = 0;
+		message.fieldsTruncated = false;
+		message.reassembled = reassembled;
+		message.connectionData = &segment.tcpData->getConnectionData();
+		message.firstByteTimestamp = sideState.firstByteTimestamp;
+		message.timestamp = sideState.lastTimestamp;
+
+		size_t offset = 0;
+		size_t startLineLen = getLineLength(headers, headersLen, offset);
+		message.startLine.data = headers;
+		message.startLine.length = startLineLen;
+
+		const char httpPrefix[] = "HTTP/";
+		message.isRequest =
+		    startLineLen < sizeof(httpPrefix) - 1 || memcmp(headers, httpPrefix, sizeof(httpPrefix) - 1) != 0;
+		if (message.isRequest)
+		{
+			message.method = HttpRequestFirstLine::parseMethod(headers, startLineLen);
+			const char* uriStart = static_cast<const char*>(memchr(headers, ' ', startLineLen));
+			if (message.method == HttpRequestLayer::HttpMethodUnknown || uriStart == nullptr)
+			{
+				PCPP_LOG_DEBUG("Invalid HTTP request line in flow " << message.connectionData->flowKey);
+				stopSide(segment, true);
+				return;
+			}
+
+			uriStart++;
+			const char* uriEnd = headers + startLineLen;
+			const char* versionStart = uriEnd;
+			while (versionStart > uriStart && *(versionStart - 1) != ' ')
+				versionStart--;
+
+			// HTTP/0.9 request lines have no version
+			if (versionStart > uriStart)
+			{
+				uriEnd = versionStart - 1;
+				message.version =
+				    HttpResponseFirstLine::parseVersion(versionStart, headers + startLineLen - versionStart);
+			}
+
+			message.uri.data = uriStart;
+			message.uri.length = uriEnd - uriStart;
+		}
+		else
+		{
+			// "HTTP/x.y XXX"
+			if (startLineLen < 12 || headers[8] != ' ' || !isDecimalDigit(headers[9]) ||
+			    !isDecimalDigit(headers[10]) || !isDecimalDigit(headers[11]))
+			{
+				PCPP_LOG_DEBUG("Invalid HTTP status line in flow " << message.connectionData->flowKey);
+				stopSide(segment, true);
+				return;
+			}
+
+			message.version = HttpResponseFirstLine::parseVersion(headers, startLineLen);
+			message.statusCode = (headers[9] - '0') * 100 + (headers[10] - '0') * 10 + (headers[11] - '0');
+		}
+
+		bool hasContentLength = false;
+		uint64_t contentLength = 0;
+		bool chunked = false;
+
+		while (offset < headersLen)
+		{
+			size_t nextLine = 0;
+			size_t lineLen = getLineLength(headers + offset, headersLen - offset, nextLine);
+			const char* line = headers + offset;
+			offset += nextLine;
+
+			// the empty line which ends the block
+			if (lineLen == 0)
+				break;
+
+			// obsolete line folding isn't supported, the continuation line is skipped
+			if (isWhiteSpace(line[0]))
+				continue;
+
+			const char* colon = static_cast<const char*>(memchr(line, ':', lineLen));
+			if (colon == nullptr)
+				continue;
+
+			HttpStreamHeaderField field;
+			field.name.data = line;
+			field.name.length = colon - line;
+			field.value = trim(colon + 1, line + lineLen - colon - 1);
+
+			if (field.name.equalsIgnoreCase(PCPP_HTTP_CONTENT_LENGTH_FIELD))
+			{
+				if (!parseContentLength(field.value, contentLength))
+				{
+					PCPP_LOG_DEBUG("Invalid HTTP Content-Length in flow " << message.connectionData->flowKey);
+					stopSide(segment, true);
+					return;
+				}
+				hasContentLength = true;
+			}
+			else if (field.name.equalsIgnoreCase(PCPP_HTTP_TRANSFER_ENCODING_FIELD))
+			{
+				chunked = isChunkedEncoding(field.value);
+			}
+
+			if (message.fieldCount < MaxHeaderFields)
+				m_Fields[message.fieldCount++] = field;
+			else
+				message.fieldsTruncated = true;
+		}
+
+		bool noBody = false;
+		if (message.isRequest)
+		{
+			// remember whether the response to this request has no body. Requests beyond the mask size are assumed to
+			// have a regular response
+			if (connection.pendingRequests < 64)
+			{
+				if (message.method == HttpRequestLayer::HttpHEAD)
+					connection.pendingNoBodyMask |= (uint64_t)1 << connection.pendingRequests;
+				connection.pendingRequests++;
+			}
+			m_Stats.requests++;
+		}
+		else
+		{
+			// 1xx responses are interim, the final response to the same request follows
+			if (message.statusCode >= 200 && connection.pendingRequests > 0)
+			{
+				noBody = (connection.pendingNoBodyMask & 1) != 0;
+				connection.pendingNoBodyMask >>= 1;
+				connection.pendingRequests--;
+			}
+			noBody = noBody || message.statusCode < 200 || message.statusCode == 204 || message.statusCode == 304;
+			m_Stats.responses++;
+		}
+
+		sideState.isRequest = message.isRequest;
+		sideState.method = message.method;
+		sideState.statusCode = message.statusCode;
+		sideState.chunked = chunked && !noBody;
+		sideState.headerLength = headersLen;
+		sideState.messageLength = headersLen;
+
+		if (m_OnHeaders != nullptr)
+			m_OnHeaders(segment.side, message, m_UserCookie);
+
+		bool emptyBody = hasContentLength ? contentLength == 0 : message.isRequest;
+		if (noBody || (!chunked && emptyBody))
+		{
+			endMessage(segment.side, sideState, *message.connectionData, sideState.lastTimestamp, true);
+		}
+		else if (chunked)
+		{
+			sideState.state = ReadingChunkSize;
+			sideState.remainingBytes = 0;
+			sideState.chunkSizeHasDigits = false;
+			sideState.inChunkExtension = false;
+		}
+		else if (hasContentLength)
+		{
+			sideState.state = ReadingBody;
+			sideState.remainingBytes = contentLength;
+		}
+		else
+		{
+			sideState.state = ReadingBodyUntilClose;
+		}
+
+		// after a protocol switch the connection no longer carries HTTP
+		if (message.statusCode == 101)
+		{
+			SideState& otherSide = connection.sides[1 - segment.side];
+			otherSide.state = Stopped;
+			std::string().swap(otherSide.headerBuffer);
+			sideState.state = Stopped;
+		}
+	}
+
+	size_t HttpStreamParser::consumeBody(SegmentContext& segment, const char* data, size_t dataLen)
+	{
+		SideState& sideState = *segment.sideState;
+		bool untilClose = sideState.state == ReadingBodyUntilClose;
+		size_t bodyBytes =
+		    untilClose ? dataLen : static_cast<size_t>(std::min<uint64_t>(dataLen, sideState.remainingBytes));
+
+		if (m_OnBodyData != nullptr && bodyBytes > 0)
+			m_OnBodyData(segment.side, reinterpret_cast<const uint8_t*>(data), bodyBytes,
+			             segment.tcpData->getConnectionData(), m_UserCookie);
+
+		sideState.bodyLength += bodyBytes;
+		sideState.messageLength += bodyBytes;
+		if (untilClose)
+			return bodyBytes;
+
+		sideState.remainingBytes -= bodyBytes;
+		if (sideState.remainingBytes == 0)
+		{
+			if (sideState.state == ReadingChunkData)
+			{
+				sideState.state = ReadingChunkDataEnd;
+				sideState.lineLength = 0;
+			}
+			else
+			{
+				endMessage(segment.side, sideState, segment.tcpData->getConnectionData(), sideState.lastTimestamp,
+				           sideState.complete);
+			}
+		}
+
+		return bodyBytes;
+	}
+
+	size_t HttpStreamParser::consumeChunkSize(SegmentContext& segment, const char* data, size_t dataLen)
+	{
+		SideState& sideState = *segment.sideState;
+		for (size_t i = 0; i < dataLen; i++)
+		{
+			char c = data[i];
+			sideState.messageLength++;
+
+			if (c == '\n' && sideState.chunkSizeHasDigits)
+			{
+				if (sideState.remainingBytes == 0)
+				{
+					sideState.state = ReadingTrailers;
+					sideState.lineLength = 0;
+				}
+				else
+				{
+					sideState.state = ReadingChunkData;
+				}
+				return i + 1;
+			}
+
+			if (sideState.inChunkExtension)
+				continue;
+
+			int digit = hexDigitValue(c);
+			if (digit >= 0 && sideState.remainingBytes <= (std::numeric_limits<uint64_t>::max() >> 4))
+			{
+				sideState.remainingBytes = (sideState.remainingBytes << 4) | static_cast<uint64_t>(digit);
+				sideState.chunkSizeHasDigits = true;
+			}
+			else if (sideState.chunkSizeHasDigits && (c == ';' || c == '\r' || isWhiteSpace(c)))
+			{
+				sideState.inChunkExtension = true;
+			}
+			else
+			{
+				PCPP_LOG_DEBUG("Invalid HTTP chunk size in flow " << segment.tcpData->getConnectionData().flowKey);
+				stopSide(segment, true);
+				return dataLen;
+			}
+		}
+
+		return dataLen;
+	}
+
+	size_t HttpStreamParser::consumeLineBreak(SegmentContext& segment, const char* data, size_t dataLen)
+	{
+		(void)dataLen;
+		SideState& sideState = *segment.sideState;
+		sideState.messageLength++;
+
+		if (*data == '\r' && sideState.lineLength == 0)
+		{
+			sideState.lineLength = 1;
+			return 1;
+		}
+
+		if (*data == '\n')
+		{
+			sideState.state = ReadingChunkSize;
+			sideState.remainingBytes = 0;
+			sideState.chunkSizeHasDigits = false;
+			sideState.inChunkExtension = false;
+			return 1;
+		}
+
+		PCPP_LOG_DEBUG("Invalid HTTP chunk data end in flow " << segment.tcpData->getConnectionData().flowKey);
+		stopSide(segment, true);
+		return 1;
+	}
+
+	size_t HttpStreamParser::consumeTrailers(SegmentContext& segment, const char* data, size_t dataLen)
+	{
+		SideState& sideState = *segment.sideState;
+		for (size_t i = 0; i < dataLen; i++)
+		{
+			char c = data[i];
+			sideState.messageLength++;
+
+			if (c == '\n')
+			{
+				if (sideState.lineLength == 0)
+				{
+					endMessage(segment.side, sideState, segment.tcpData->getConnectionData(), sideState.lastTimestamp,
+					           sideState.complete);
+					return i + 1;
+				}
+				sideState.lineLength = 0;
+			}
+			else if (c != '\r')
+			{
+				sideState.lineLength++;
+			}
+		}
+
+		return dataLen;
+	}
+
+	void HttpStreamParser::endMessage(int8_t side, SideState& sideState, const ConnectionData& connectionData,
+	                                  const std::chrono::time_point<std::chrono::high_resolution_clock>& timestamp,
+	                                  bool complete)
+	{
+		sideState.state = WaitingForMessage;
+		if (!complete)
+			m_Stats.incompleteMessages++;
+
+		if (m_OnMessageEnd == nullptr)
+			return;
+
+		HttpStreamMessageEnd messageEnd;
+		messageEnd.isRequest = sideState.isRequest;
+		messageEnd.method = sideState.method;
+		messageEnd.statusCode = sideState.statusCode;
+		messageEnd.chunked = sideState.chunked;
+		messageEnd.complete = complete;
+		messageEnd.headerLength = sideState.headerLength;
+		messageEnd.bodyLength = sideState.bodyLength;
+		messageEnd.messageLength = sideState.messageLength;
+		messageEnd.connectionData = &connectionData;
+		messageEnd.firstByteTimestamp = sideState.firstByteTimestamp;
+		messageEnd.timestamp = timestamp;
+		m_OnMessageEnd(side, messageEnd, m_UserCookie);
+	}
+
+	void HttpStreamParser::stopSide(SegmentContext& segment, bool parseError)
+	{
+		SideState& sideState = *segment.sideState;
+		if (parseError)
+			m_Stats.parseErrors++;
+
+		// a message whose header was already reported ends incomplete
+		if (sideState.state != WaitingForMessage && sideState.state != ReadingHeaders && sideState.state != Stopped)
+			endMessage(segment.side, sideState, segment.tcpData->getConnectionData(), sideState.lastTimestamp, false);
+
+		sideState.state = Stopped;
+		std::string().swap(sideState.headerBuffer);
+	}
+
+	void HttpStreamParser::endConnection(const ConnectionData& connectionData, ConnectionState& connection)
+	{
+		for (int8_t side = 0; side < 2; side++)
+		{
+			SideState& sideState = connection.sides[side];
+			if (sideState.state == ReadingBodyUntilClose)
+				endMessage(side, sideState, connectionData, sideState.lastTimestamp, sideState.complete);
+			else if (sideState.state != WaitingForMessage && sideState.state != ReadingHeaders &&
+			         sideState.state != Stopped)
+				endMessage(side, sideState, connectionData, sideState.lastTimestamp, false);
+		}
+	}
+
+	void HttpStreamParser::closeConnection(const ConnectionData& connectionData)
+	{
+		auto iter = m_Connections.find(connectionData.flowKey);
+		if (iter == m_Connections.end())
+			return;
+
+		endConnection(connectionData, iter->second);
+		m_Connections.erase(iter);
+	}
+
+	void HttpStreamParser::closeAllConnections()
+	{
+		// the connection data isn't kept, so messages are ended with a connection that holds only the flow key
+		for (auto& connection : m_Connections)
+		{
+			ConnectionData connectionData;
+			connectionData.flowKey = connection.first;
+			endConnection(connectionData, connection.second);
+		}
+
+		m_Connections.clear();
+	}
+
+	void HttpStreamParser::onTcpMessageReady(int8_t side, const TcpStreamData& tcpData, void* userCookie)
+	{
+		static_cast<HttpStreamParser*>(userCookie)->processTcpData(side, tcpData);
+	}
+
+	void HttpStreamParser::onTcpConnectionEnd(const ConnectionData& connectionData,
+	                                          TcpReassembly::ConnectionEndReason reason, void* userCookie)
+	{
+		(void)reason;
+		static_cast<HttpStreamParser*>(userCookie)->closeConnection(connectionData);
+	}
+}  // namespace pcpp
@@ -190,12 +190,10 @@ namespace pcpp
 		init(messageId, operationType, messageRecords, controls);
 	}
 
-	LdapLayer::LdapLayer(std::unique_ptr<Asn1Record> asn1Record, uint8_t* data, size_t dataLen, Layer* prevLayer,
-	                     Packet* packet)
-	    : Layer(data, dataLen, prevLayer, packet, LDAP)
-	{
-		m_Asn1Record = std::move(asn1Record);
-	}
+	LdapLayer::LdapLayer(std::unique_ptr<Asn1DecodeArena> asn1Arena, Asn1Record* asn1Record, uint8_t* data,
+	                     size_t dataLen, Layer* prevLayer, Packet* packet)
+	    : Layer(data, dataLen, prevLayer, packet, LDAP), m_Asn1Arena(std::move(asn1Arena)), m_Asn1Record(asn1Record)
+	{}
 
 	void LdapLayer::init(uint16_t messageId, LdapOperationType operationType,
 	                     const std::vector<Asn1Record*>& messageRecords, const std::vector<LdapControl>& controls)
@@ -242,12 +240,12 @@ namespace pcpp
 
 		Asn1SequenceRecord rootRecord(rootSubRecords);
 
-		auto encodedData = rootRecord.encode();
-		m_DataLen = encodedData.size();
+		m_DataLen = rootRecord.getEncodedLength();
 		m_Data = new uint8_t[m_DataLen];
-		std::copy(encodedData.begin(), encodedData.end(), m_Data);
+		rootRecord.encode(m_Data, m_DataLen);
 		m_Protocol = LDAP;
-		m_Asn1Record = Asn1Record::decode(m_Data, m_DataLen, true);
+		m_Asn1Arena.reset(new Asn1DecodeArena(asn1ArenaBlockSize));
+		m_Asn1Record = Asn1Record::decode(m_Data, m_DataLen, *m_Asn1Arena);
 	}
 
 	std::string LdapLayer::toString() const
@@ -260,37 +258,42 @@ namespace pcpp
 	{
 		// try
 		//{
-		auto asn1Record = Asn1Record::decode(data, dataLen, true);
+		// decode into an arena instead of allocating every record of the message separately
+		std::unique_ptr<Asn1DecodeArena> asn1Arena(new Asn1DecodeArena(asn1ArenaBlockSize));
+		auto asn1Record = Asn1Record::decode(data, dataLen, *asn1Arena);
+		if (asn1Record == nullptr)
+			return nullptr;
+
 		auto operationType = LdapOperationType::fromUintValue(
 		    asn1Record->castAs<Asn1SequenceRecord>()->getSubRecords().at(operationTypeIndex)->getTagType());
 		switch (operationType)
 		{
 		case LdapOperationType::BindRequest:
-			return new LdapBindRequestLayer(std::move(asn1Record), data, dataLen, prevLayer, packet);
+			return new LdapBindRequestLayer(std::move(asn1Arena), asn1Record, data, dataLen, prevLayer, packet);
 		case LdapOperationType::BindResponse:
-			return new LdapBindResponseLayer(std::move(asn1Record), data, dataLen, prevLayer, packet);
+			return new LdapBindResponseLayer(std::move(asn1Arena), asn1Record, data, dataLen, prevLayer, packet);
 		case LdapOperationType::UnbindRequest:
-			return new LdapUnbindRequestLayer(std::move(asn1Record), data, dataLen, prevLayer, packet);
+			return new LdapUnbindRequestLayer(std::move(asn1Arena), asn1Record, data, dataLen, prevLayer, packet);
 		case LdapOperationType::SearchRequest:
-			return new LdapSearchRequestLayer(std::move(asn1Record), data, dataLen, prevLayer, packet);
+			return new LdapSearchRequestLayer(std::move(asn1Arena), asn1Record, data, dataLen, prevLayer, packet);
 		case LdapOperationType::SearchResultEntry:
-			return new LdapSearchResultEntryLayer(std::move(asn1Record), data, dataLen, prevLayer, packet);
+			return new LdapSearchResultEntryLayer(std::move(asn1Arena), asn1Record, data, dataLen, prevLayer, packet);
 		case LdapOperationType::SearchResultDone:
-			return new LdapSearchResultDoneLayer(std::move(asn1Record), data, dataLen, prevLayer, packet);
+			return new LdapSearchResultDoneLayer(std::move(asn1Arena), asn1Record, data, dataLen, prevLayer, packet);
 		case LdapOperationType::ModifyResponse:
-			return new LdapModifyResponseLayer(std::move(asn1Record), data, dataLen, prevLayer, packet);
+			return new LdapModifyResponseLayer(std::move(asn1Arena), asn1Record, data, dataLen, prevLayer, packet);
 		case LdapOperationType::AddResponse:
-			return new LdapAddResponseLayer(std::move(asn1Record), data, dataLen, prevLayer, packet);
+			return new LdapAddResponseLayer(std::move(asn1Arena), asn1Record, data, dataLen, prevLayer, packet);
 		case LdapOperationType::DeleteResponse:
-			return new LdapDeleteResponseLayer(std::move(asn1Record), data, dataLen, prevLayer, packet);
+			return new LdapDeleteResponseLayer(std::move(asn1Arena), asn1Record, data, dataLen, prevLayer, packet);
 		case LdapOperationType::ModifyDNResponse:
-			return new LdapModifyDNResponseLayer(std::move(asn1Record), data, dataLen, prevLayer, packet);
+			return new LdapModifyDNResponseLayer(std::move(asn1Arena), asn1Record, data, dataLen, prevLayer, packet);
 		case LdapOperationType::CompareResponse:
-			return new LdapCompareResponseLayer(std::move(asn1Record), data, dataLen, prevLayer, packet);
+			return new LdapCompareResponseLayer(std::move(asn1Arena), asn1Record, data, dataLen, prevLayer, packet);
 		case LdapOperationType::Unknown:
 			return nullptr;
 		default:
-			return new LdapLayer(std::move(asn1Record), data, dataLen, prevLayer, packet);
+			return new LdapLayer(std::move(asn1Arena), asn1Record, data, dataLen, prevLayer, packet);
 		}
 		//}
 		// catch (...)
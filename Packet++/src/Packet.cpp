@@ -30,7 +30,9 @@ namespace pcpp
 		gettimeofday(&time, nullptr);
 		uint8_t* data = new uint8_t[maxPacketLen];
 		memset(data, 0, maxPacketLen);
-		m_RawPacket = new RawPacket(data, 0, time, true, linkType);
+		// set the whole buffer and remove it so the raw packet knows the buffer length
+		m_RawPacket = new RawPacket(data, maxPacketLen, time, true, linkType);
+		m_RawPacket->removeData(0, maxPacketLen);
 	}
 
 	Packet::Packet(uint8_t* buffer, size_t bufferSize, LinkLayerType linkType)
@@ -40,7 +42,8 @@ namespace pcpp
 		timeval time;
 		gettimeofday(&time, nullptr);
 		memset(buffer, 0, bufferSize);
-		m_RawPacket = new RawPacket(buffer, 0, time, false, linkType);
+		m_RawPacket = new RawPacket(buffer, bufferSize, time, false, linkType);
+		m_RawPacket->removeData(0, bufferSize);
 	}
 
 	void Packet::setRawPacket(RawPacket* rawPacket, bool freeRawPacket, ProtocolTypeFamily parseUntil,
@@ -171,6 +174,38 @@ namespace pcpp
 		return *this;
 	}
 
+	Packet& Packet::operator=(Packet&& other) noexcept
+	{
+		if (this != &other)
+		{
+			destructPacketData();
+
+			moveDataFrom(other);
+		}
+
+		return *this;
+	}
+
+	void Packet::moveDataFrom(Packet& other)
+	{
+		m_RawPacket = other.m_RawPacket;
+		m_FreeRawPacket = other.m_FreeRawPacket;
+		m_MaxPacketLen = other.m_MaxPacketLen;
+		m_CanReallocateData = other.m_CanReallocateData;
+		m_FirstLayer = other.m_FirstLayer;
+		m_LastLayer = other.m_LastLayer;
+
+		// the layers point back to the packet they're in
+		for (Layer* curLayer = m_FirstLayer; curLayer != nullptr; curLayer = curLayer->getNextLayer())
+			curLayer->m_Packet = this;
+
+		other.m_RawPacket = nullptr;
+		other.m_FreeRawPacket = false;
+		other.m_MaxPacketLen = 0;
+		other.m_FirstLayer = nullptr;
+		other.m_LastLayer = nullptr;
+	}
+
 	void Packet::copyDataFrom(const Packet& other)
 	{
 		m_RawPacket = new RawPacket(*(other.m_RawPacket));
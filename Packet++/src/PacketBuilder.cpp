@@ -0,0 +1,207 @@
+#define LOG_MODULE PacketLogModulePacket
+
+#include "PacketBuilder.h"
+#include "PacketUtils.h"
+#include "Logger.h"
+#include "EndianPortable.h"
+
+namespace pcpp
+{
+	namespace
+	{
+		// compute the TCP / UDP checksum of a segment after an IPv4 / IPv6 header, with the checksum field zeroed
+		uint16_t computeTransportChecksum(uint8_t* data, size_t length, const uint8_t* networkHeader, uint8_t protocol)
+		{
+			if ((networkHeader[0] >> 4) == 6)
+			{
+				const ip6_hdr* ipHeader = reinterpret_cast<const ip6_hdr*>(networkHeader);
+				return computePseudoHdrChecksum(data, length, IPAddress::IPv6AddressType, protocol,
+				                                IPv6Address(ipHeader->ipSrc), IPv6Address(ipHeader->ipDst));
+			}
+
+			const iphdr* ipHeader = reinterpret_cast<const iphdr*>(networkHeader);
+			return computePseudoHdrChecksum(data, length, IPAddress::IPv4AddressType, protocol,
+			                                IPv4Address(ipHeader->ipSrc), IPv4Address(ipHeader->ipDst));
+		}
+	}  // namespace
+
+	namespace internal
+	{
+		bool isValidPacketBuilderBuffer(const uint8_t* buffer, size_t bufferLen, size_t headerLength)
+		{
+			if (buffer == nullptr)
+			{
+				PCPP_LOG_ERROR("Packet builder buffer is NULL");
+				return false;
+			}
+
+			if (bufferLen < headerLength)
+			{
+				PCPP_LOG_ERROR("Buffer is too short for the packet headers: " << bufferLen
+				                                                               << " bytes, the headers need "
+				                                                               << headerLength << " bytes");
+				return false;
+			}
+
+			return true;
+		}
+	}  // namespace internal
+
+	/// ================================
+	/// PacketBuilderHeader<EthLayer>
+	/// ================================
+
+	void PacketBuilderHeader<EthLayer>::init(uint8_t*)
+	{}
+
+	void PacketBuilderHeader<EthLayer>::finalize(uint8_t* data, size_t, const uint8_t*, uint16_t nextProtocol)
+	{
+		if (nextProtocol != 0)
+			reinterpret_cast<ether_header*>(data)->etherType = htobe16(nextProtocol);
+	}
+
+	/// ================================
+	/// PacketBuilderHeader<VlanLayer>
+	/// ================================
+
+	void PacketBuilderHeader<VlanLayer>::setVlanID(uint16_t vlanID) const
+	{
+		getHeader()->vlan = htobe16((be16toh(getHeader()->vlan) & (~0xFFF)) | (vlanID & 0xFFF));
+	}
+
+	void PacketBuilderHeader<VlanLayer>::setPriority(uint8_t priority) const
+	{
+		getHeader()->vlan = htobe16((be16toh(getHeader()->vlan) & (~(7 << 13))) | ((priority & 7) << 13));
+	}
+
+	void PacketBuilderHeader<VlanLayer>::setCFI(bool cfi) const
+	{
+		getHeader()->vlan = htobe16((be16toh(getHeader()->vlan) & (~(1 << 12))) | ((cfi & 1) << 12));
+	}
+
+	void PacketBuilderHeader<VlanLayer>::init(uint8_t*)
+	{}
+
+	void PacketBuilderHeader<VlanLayer>::finalize(uint8_t* data, size_t, const uint8_t*, uint16_t nextProtocol)
+	{
+		if (nextProtocol != 0)
+			reinterpret_cast<vlan_header*>(data)->etherType = htobe16(nextProtocol);
+	}
+
+	/// ================================
+	/// PacketBuilderHeader<IPv4Layer>
+	/// ================================
+
+	void PacketBuilderHeader<IPv4Layer>::setIpId(uint16_t ipId) const
+	{
+		getHeader()->ipId = htobe16(ipId);
+	}
+
+	void PacketBuilderHeader<IPv4Layer>::init(uint8_t* data)
+	{
+		iphdr* ipHeader = reinterpret_cast<iphdr*>(data);
+		ipHeader->ipVersion = 4;
+		ipHeader->internetHeaderLength = sizeof(iphdr) / 4;
+		ipHeader->timeToLive = 64;
+	}
+
+	void PacketBuilderHeader<IPv4Layer>::finalize(uint8_t* data, size_t length, const uint8_t*, uint16_t nextProtocol)
+	{
+		iphdr* ipHeader = reinterpret_cast<iphdr*>(data);
+		ipHeader->totalLength = htobe16(static_cast<uint16_t>(length));
+		if (nextProtocol != 0)
+			ipHeader->protocol = static_cast<uint8_t>(nextProtocol);
+
+		ipHeader->headerChecksum = 0;
+		ScalarBuffer<uint16_t> scalar = { reinterpret_cast<uint16_t*>(ipHeader), sizeof(iphdr) };
+		ipHeader->headerChecksum = htobe16(computeChecksum(&scalar, 1));
+	}
+
+	/// ================================
+	/// PacketBuilderHeader<IPv6Layer>
+	/// ================================
+
+	void PacketBuilderHeader<IPv6Layer>::init(uint8_t* data)
+	{
+		ip6_hdr* ipHeader = reinterpret_cast<ip6_hdr*>(data);
+		ipHeader->ipVersion = 6;
+		ipHeader->hopLimit = 64;
+	}
+
+	void PacketBuilderHeader<IPv6Layer>::finalize(uint8_t* data, size_t length, const uint8_t*, uint16_t nextProtocol)
+	{
+		ip6_hdr* ipHeader = reinterpret_cast<ip6_hdr*>(data);
+		ipHeader->payloadLength = htobe16(static_cast<uint16_t>(length - sizeof(ip6_hdr)));
+		if (nextProtocol != 0)
+			ipHeader->nextHeader = static_cast<uint8_t>(nextProtocol);
+	}
+
+	/// ================================
+	/// PacketBuilderHeader<UdpLayer>
+	/// ================================
+
+	void PacketBuilderHeader<UdpLayer>::setSrcPort(uint16_t port) const
+	{
+		getHeader()->portSrc = htobe16(port);
+	}
+
+	void PacketBuilderHeader<UdpLayer>::setDstPort(uint16_t port) const
+	{
+		getHeader()->portDst = htobe16(port);
+	}
+
+	void PacketBuilderHeader<UdpLayer>::init(uint8_t*)
+	{}
+
+	void PacketBuilderHeader<UdpLayer>::finalize(uint8_t* data, size_t length, const uint8_t* prevHeader, uint16_t)
+	{
+		udphdr* udpHeader = reinterpret_cast<udphdr*>(data);
+		udpHeader->length = htobe16(static_cast<uint16_t>(length));
+		udpHeader->headerChecksum = 0;
+		uint16_t checksum = computeTransportChecksum(data, length, prevHeader, PACKETPP_IPPROTO_UDP);
+		// a UDP checksum of 0 means no checksum, so a computed 0 is sent as 0xffff
+		udpHeader->headerChecksum = htobe16(checksum == 0 ? 0xffff : checksum);
+	}
+
+	/// ================================
+	/// PacketBuilderHeader<TcpLayer>
+	/// ================================
+
+	void PacketBuilderHeader<TcpLayer>::setSrcPort(uint16_t port) const
+	{
+		getHeader()->portSrc = htobe16(port);
+	}
+
+	void PacketBuilderHeader<TcpLayer>::setDstPort(uint16_t port) const
+	{
+		getHeader()->portDst = htobe16(port);
+	}
+
+	void PacketBuilderHeader<TcpLayer>::setSequenceNumber(uint32_t sequenceNumber) const
+	{
+		getHeader()->sequenceNumber = htobe32(sequenceNumber);
+	}
+
+	void PacketBuilderHeader<TcpLayer>::setAckNumber(uint32_t ackNumber) const
+	{
+		getHeader()->ackNumber = htobe32(ackNumber);
+	}
+
+	void PacketBuilderHeader<TcpLayer>::setWindowSize(uint16_t windowSize) const
+	{
+		getHeader()->windowSize = htobe16(windowSize);
+	}
+
+	void PacketBuilderHeader<TcpLayer>::init(uint8_t* data)
+	{
+		reinterpret_cast<tcphdr*>(data)->dataOffset = sizeof(tcphdr) / 4;
+	}
+
+	void PacketBuilderHeader<TcpLayer>::finalize(uint8_t* data, size_t length, const uint8_t* prevHeader, uint16_t)
+	{
+		tcphdr* tcpHeader = reinterpret_cast<tcphdr*>(data);
+		tcpHeader->headerChecksum = 0;
+		tcpHeader->headerChecksum =
+		    htobe16(computeTransportChecksum(data, length, prevHeader, PACKETPP_IPPROTO_TCP));
+	}
+}  // namespace pcpp
@@ -0,0 +1,400 @@
+#define LOG_MODULE PacketLogModulePacket
+
+#include "PacketTemplate.h"
+#include "Packet.h"
+#include "IPv4Layer.h"
+#include "IPv6Layer.h"
+#include "TcpLayer.h"
+#include "UdpLayer.h"
+#include "Logger.h"
+#include <algorithm>
+#include <string.h>
+
+namespace pcpp
+{
+	namespace
+	{
+		constexpr size_t IPv4TotalLengthOffset = 2;
+		constexpr size_t IPv4ChecksumOffset = 10;
+		constexpr size_t IPv4SrcAddressOffset = 12;
+		constexpr size_t IPv4DstAddressOffset = 16;
+		constexpr size_t IPv6PayloadLengthOffset = 4;
+		constexpr size_t IPv6SrcAddressOffset = 8;
+		constexpr size_t IPv6DstAddressOffset = 24;
+		constexpr size_t IPv6HeaderLength = 40;
+		constexpr size_t UdpLengthOffset = 4;
+		constexpr size_t UdpChecksumOffset = 6;
+		constexpr size_t TcpSequenceNumberOffset = 4;
+		constexpr size_t TcpChecksumOffset = 16;
+
+		inline uint16_t readBE16(const uint8_t* ptr)
+		{
+			return static_cast<uint16_t>((ptr[0] << 8) | ptr[1]);
+		}
+
+		inline void writeBE16(uint8_t* ptr, uint16_t value)
+		{
+			ptr[0] = static_cast<uint8_t>(value >> 8);
+			ptr[1] = static_cast<uint8_t>(value);
+		}
+
+		inline uint16_t fold(uint32_t sum)
+		{
+			sum = (sum & 0xffff) + (sum >> 16);
+			sum = (sum & 0xffff) + (sum >> 16);
+			return static_cast<uint16_t>(sum);
+		}
+
+		// add bytes to a one's complement sum as big-endian 16-bit words. oddStart is true if the first byte is the low
+		// byte of a word
+		uint32_t addBytes(uint32_t sum, const uint8_t* data, size_t length, bool oddStart = false)
+		{
+			for (size_t i = 0; i < length; ++i)
+				sum += ((i & 1) != oddStart) ? data[i] : static_cast<uint32_t>(data[i]) << 8;
+
+			return sum;
+		}
+
+		// update a checksum after data it covers changed from oldSum to newSum (RFC 1624, eqn. 3)
+		inline void updateChecksum(uint8_t* checksum, uint32_t oldSum, uint32_t newSum, bool isUdp)
+		{
+			uint32_t sum = static_cast<uint16_t>(~readBE16(checksum)) + static_cast<uint16_t>(~fold(oldSum)) +
+			               static_cast<uint32_t>(fold(newSum));
+			uint16_t result = static_cast<uint16_t>(~fold(sum));
+			// a UDP checksum of 0 means no checksum, so a computed 0 is sent as 0xffff
+			writeBE16(checksum, isUdp && result == 0 ? 0xffff : result);
+		}
+
+		// whether [offset, offset + length) and [rangeOffset, rangeOffset + rangeLength) have common bytes
+		inline bool overlaps(size_t offset, size_t length, size_t rangeOffset, size_t rangeLength)
+		{
+			return offset < rangeOffset + rangeLength && rangeOffset < offset + length;
+		}
+
+		// whether [offset, offset + length) is inside [rangeOffset, rangeOffset + rangeLength)
+		inline bool contains(size_t rangeOffset, size_t rangeLength, size_t offset, size_t length)
+		{
+			return offset >= rangeOffset && offset + length <= rangeOffset + rangeLength;
+		}
+	}  // namespace
+
+	constexpr size_t PacketTemplate::MaxFieldLength;
+	constexpr size_t PacketTemplate::NoOffset;
+
+	PacketTemplate::PacketTemplate(Packet& packet)
+	    : m_LinkLayerType(LINKTYPE_ETHERNET), m_HeaderLength(0), m_NetworkOffset(NoOffset), m_NetworkHeaderLength(0),
+	      m_IsIPv6(false), m_TransportOffset(NoOffset), m_IsUdp(false), m_TransportChecksumOffset(NoOffset),
+	      m_TransportHeaderSum(0)
+	{
+		packet.computeCalculateFields();
+
+		const RawPacket* rawPacket = packet.getRawPacketReadOnly();
+		const uint8_t* rawData = rawPacket->getRawData();
+		m_LinkLayerType = rawPacket->getLinkLayerType();
+		m_Data.assign(rawData, rawData + rawPacket->getRawDataLen());
+		m_HeaderLength = m_Data.size();
+
+		Layer* networkLayer = packet.getFirstLayer();
+		while (networkLayer != nullptr && networkLayer->getProtocol() != IPv4 && networkLayer->getProtocol() != IPv6)
+			networkLayer = networkLayer->getNextLayer();
+
+		if (networkLayer == nullptr)
+			return;
+
+		m_NetworkOffset = static_cast<size_t>(networkLayer->getData() - rawData);
+		m_NetworkHeaderLength = networkLayer->getHeaderLen();
+		m_IsIPv6 = networkLayer->getProtocol() == IPv6;
+		m_HeaderLength = m_NetworkOffset + m_NetworkHeaderLength;
+
+		Layer* transportLayer = networkLayer->getNextLayer();
+		if (transportLayer == nullptr || (transportLayer->getProtocol() != TCP && transportLayer->getProtocol() != UDP))
+			return;
+
+		m_TransportOffset = static_cast<size_t>(transportLayer->getData() - rawData);
+		m_IsUdp = transportLayer->getProtocol() == UDP;
+		m_HeaderLength = m_TransportOffset + transportLayer->getHeaderLen();
+
+		size_t checksumOffset = m_TransportOffset + (m_IsUdp ? UdpChecksumOffset : TcpChecksumOffset);
+		if (!m_IsUdp || readBE16(m_Data.data() + checksumOffset) != 0)
+			m_TransportChecksumOffset = checksumOffset;
+
+		// the pseudo header without its length field, and the transport header without its checksum and length
+		const uint8_t* network = m_Data.data() + m_NetworkOffset;
+		uint32_t sum = m_IsIPv6 ? addBytes(0, network + IPv6SrcAddressOffset, 32)
+		                        : addBytes(0, network + IPv4SrcAddressOffset, 8);
+		sum += m_IsUdp ? PACKETPP_IPPROTO_UDP : PACKETPP_IPPROTO_TCP;
+		sum = addBytes(sum, m_Data.data() + m_TransportOffset, m_HeaderLength - m_TransportOffset);
+		sum += static_cast<uint16_t>(~readBE16(m_Data.data() + checksumOffset));
+		if (m_IsUdp)
+			sum += static_cast<uint16_t>(~readBE16(m_Data.data() + m_TransportOffset + UdpLengthOffset));
+		m_TransportHeaderSum = fold(sum);
+
+		// the payload starts at an even offset from the transport header, so its words are aligned with the checksum
+		const uint8_t* payload = m_Data.data() + m_HeaderLength;
+		size_t payloadWords = getPayloadLen() / 2;
+		m_PayloadPrefixSums.resize(payloadWords + 1);
+		m_PayloadPrefixSums[0] = 0;
+		for (size_t i = 0; i < payloadWords; ++i)
+			m_PayloadPrefixSums[i + 1] = fold(m_PayloadPrefixSums[i] + readBE16(payload + i * 2));
+	}
+
+	int PacketTemplate::addField(size_t offset, size_t length)
+	{
+		if (length == 0 || length > MaxFieldLength || offset + length > m_Data.size() || offset > UINT16_MAX)
+		{
+			PCPP_LOG_ERROR("Field of " << length << " bytes at offset " << offset
+			                           << " is empty, too long or beyond the end of the packet");
+			return -1;
+		}
+
+		Field field;
+		field.offset = static_cast<uint16_t>(offset);
+		field.length = static_cast<uint8_t>(length);
+		field.coveredByIPv4Checksum = false;
+		field.coveredByTransportChecksum = false;
+
+		if (m_NetworkOffset != NoOffset)
+		{
+			bool overlapsUpdatedField;
+			if (m_IsIPv6)
+			{
+				overlapsUpdatedField = overlaps(offset, length, m_NetworkOffset + IPv6PayloadLengthOffset, 2);
+			}
+			else
+			{
+				overlapsUpdatedField = overlaps(offset, length, m_NetworkOffset + IPv4TotalLengthOffset, 2) ||
+				                       overlaps(offset, length, m_NetworkOffset + IPv4ChecksumOffset, 2);
+			}
+
+			if (m_TransportOffset != NoOffset)
+			{
+				size_t checksumOffset = m_TransportOffset + (m_IsUdp ? UdpChecksumOffset : TcpChecksumOffset);
+				overlapsUpdatedField = overlapsUpdatedField || overlaps(offset, length, checksumOffset, 2) ||
+				                       (m_IsUdp && overlaps(offset, length, m_TransportOffset + UdpLengthOffset, 2));
+			}
+
+			if (overlapsUpdatedField)
+			{
+				PCPP_LOG_ERROR("Field at offset " << offset << " overlaps a length or checksum field");
+				return -1;
+			}
+
+			if (!m_IsIPv6)
+			{
+				field.coveredByIPv4Checksum = contains(m_NetworkOffset, m_NetworkHeaderLength, offset, length);
+				if (!field.coveredByIPv4Checksum && overlaps(offset, length, m_NetworkOffset, m_NetworkHeaderLength))
+				{
+					PCPP_LOG_ERROR("Field at offset " << offset << " is partly inside the IPv4 header");
+					return -1;
+				}
+			}
+
+			if (m_TransportOffset != NoOffset)
+			{
+				// the addresses are part of the pseudo header
+				size_t addressesOffset = m_NetworkOffset + (m_IsIPv6 ? IPv6SrcAddressOffset : IPv4SrcAddressOffset);
+				size_t addressesLength = m_IsIPv6 ? 32 : 8;
+				size_t transportLength = m_Data.size() - m_TransportOffset;
+				field.coveredByTransportChecksum = contains(addressesOffset, addressesLength, offset, length) ||
+				                                   contains(m_TransportOffset, transportLength, offset, length);
+				if (!field.coveredByTransportChecksum &&
+				    (overlaps(offset, length, addressesOffset, addressesLength) ||
+				     overlaps(offset, length, m_TransportOffset, transportLength)))
+				{
+					PCPP_LOG_ERROR("Field at offset " << offset << " is partly inside the bytes the "
+					                                  << (m_IsUdp ? "UDP" : "TCP") << " checksum covers");
+					return -1;
+				}
+			}
+		}
+
+		m_Fields.push_back(field);
+		return static_cast<int>(m_Fields.size() - 1);
+	}
+
+	int PacketTemplate::addSrcIPField()
+	{
+		if (m_NetworkOffset == NoOffset)
+		{
+			PCPP_LOG_ERROR("Packet template has no IPv4 / IPv6 layer");
+			return -1;
+		}
+
+		return m_IsIPv6 ? addField(m_NetworkOffset + IPv6SrcAddressOffset, 16)
+		                : addField(m_NetworkOffset + IPv4SrcAddressOffset, 4);
+	}
+
+	int PacketTemplate::addDstIPField()
+	{
+		if (m_NetworkOffset == NoOffset)
+		{
+			PCPP_LOG_ERROR("Packet template has no IPv4 / IPv6 layer");
+			return -1;
+		}
+
+		return m_IsIPv6 ? addField(m_NetworkOffset + IPv6DstAddressOffset, 16)
+		                : addField(m_NetworkOffset + IPv4DstAddressOffset, 4);
+	}
+
+	int PacketTemplate::addSrcPortField()
+	{
+		if (m_TransportOffset == NoOffset)
+		{
+			PCPP_LOG_ERROR("Packet template has no TCP / UDP layer");
+			return -1;
+		}
+
+		return addField(m_TransportOffset, 2);
+	}
+
+	int PacketTemplate::addDstPortField()
+	{
+		if (m_TransportOffset == NoOffset)
+		{
+			PCPP_LOG_ERROR("Packet template has no TCP / UDP layer");
+			return -1;
+		}
+
+		return addField(m_TransportOffset + 2, 2);
+	}
+
+	int PacketTemplate::addTcpSequenceNumberField()
+	{
+		if (m_TransportOffset == NoOffset || m_IsUdp)
+		{
+			PCPP_LOG_ERROR("Packet template has no TCP layer");
+			return -1;
+		}
+
+		return addField(m_TransportOffset + TcpSequenceNumberOffset, 4);
+	}
+
+	int PacketTemplate::addPayloadField(size_t payloadOffset, size_t length)
+	{
+		return addField(m_HeaderLength + payloadOffset, length);
+	}
+
+	size_t PacketTemplate::stamp(uint8_t* buffer, size_t bufferLen) const
+	{
+		if (bufferLen < m_Data.size())
+			return 0;
+
+		memcpy(buffer, m_Data.data(), m_Data.size());
+		return m_Data.size();
+	}
+
+	size_t PacketTemplate::stamp(uint8_t* buffer, size_t bufferLen, size_t payloadLength) const
+	{
+		if (payloadLength == getPayloadLen())
+			return stamp(buffer, bufferLen);
+
+		size_t packetLen = m_HeaderLength + payloadLength;
+		if (m_NetworkOffset == NoOffset || packetLen > bufferLen || packetLen - m_NetworkOffset > UINT16_MAX)
+			return 0;
+
+		size_t copiedPayloadLength = std::min(payloadLength, getPayloadLen());
+		memcpy(buffer, m_Data.data(), m_HeaderLength + copiedPayloadLength);
+		if (payloadLength > copiedPayloadLength)
+			memset(buffer + m_HeaderLength + copiedPayloadLength, 0, payloadLength - copiedPayloadLength);
+
+		uint8_t* network = buffer + m_NetworkOffset;
+		if (m_IsIPv6)
+		{
+			uint16_t payloadLen = static_cast<uint16_t>(packetLen - m_NetworkOffset - IPv6HeaderLength);
+			writeBE16(network + IPv6PayloadLengthOffset, payloadLen);
+		}
+		else
+		{
+			uint16_t oldTotalLength = readBE16(network + IPv4TotalLengthOffset);
+			uint16_t newTotalLength = static_cast<uint16_t>(packetLen - m_NetworkOffset);
+			writeBE16(network + IPv4TotalLengthOffset, newTotalLength);
+			updateChecksum(network + IPv4ChecksumOffset, oldTotalLength, newTotalLength, false);
+		}
+
+		if (m_TransportOffset == NoOffset)
+			return packetLen;
+
+		uint16_t transportLength = static_cast<uint16_t>(packetLen - m_TransportOffset);
+		if (m_IsUdp)
+			writeBE16(buffer + m_TransportOffset + UdpLengthOffset, transportLength);
+
+		if (m_TransportChecksumOffset != NoOffset)
+		{
+			// the length is part of the pseudo header, and for UDP also of the header
+			uint32_t sum = m_TransportHeaderSum + transportLength + (m_IsUdp ? transportLength : 0) +
+			               getPayloadSum(copiedPayloadLength);
+			uint16_t checksum = static_cast<uint16_t>(~fold(sum));
+			writeBE16(buffer + m_TransportChecksumOffset, m_IsUdp && checksum == 0 ? 0xffff : checksum);
+		}
+
+		return packetLen;
+	}
+
+	bool PacketTemplate::setField(uint8_t* packetData, size_t packetLen, int fieldIndex, const uint8_t* value) const
+	{
+		if (fieldIndex < 0 || static_cast<size_t>(fieldIndex) >= m_Fields.size())
+			return false;
+
+		const Field& field = m_Fields[fieldIndex];
+		if (field.offset + field.length > packetLen)
+			return false;
+
+		uint8_t* fieldData = packetData + field.offset;
+		if (field.coveredByIPv4Checksum || (field.coveredByTransportChecksum && m_TransportChecksumOffset != NoOffset))
+		{
+			// the checksummed headers start at an even offset from the network header
+			bool oddStart = ((field.offset - m_NetworkOffset) & 1) != 0;
+			uint32_t oldSum = addBytes(0, fieldData, field.length, oddStart);
+			uint32_t newSum = addBytes(0, value, field.length, oddStart);
+
+			if (field.coveredByIPv4Checksum)
+				updateChecksum(packetData + m_NetworkOffset + IPv4ChecksumOffset, oldSum, newSum, false);
+
+			if (field.coveredByTransportChecksum && m_TransportChecksumOffset != NoOffset)
+				updateChecksum(packetData + m_TransportChecksumOffset, oldSum, newSum, m_IsUdp);
+		}
+
+		memcpy(fieldData, value, field.length);
+		return true;
+	}
+
+	bool PacketTemplate::setField(uint8_t* packetData, size_t packetLen, int fieldIndex, uint32_t value) const
+	{
+		if (fieldIndex < 0 || static_cast<size_t>(fieldIndex) >= m_Fields.size())
+			return false;
+
+		size_t length = m_Fields[fieldIndex].length;
+		if (length != 1 && length != 2 && length != 4)
+			return false;
+
+		uint8_t bytes[4];
+		for (size_t i = 0; i < length; ++i)
+			bytes[i] = static_cast<uint8_t>(value >> (8 * (length - 1 - i)));
+
+		return setField(packetData, packetLen, fieldIndex, bytes);
+	}
+
+	bool PacketTemplate::setField(uint8_t* packetData, size_t packetLen, int fieldIndex, const IPAddress& address) const
+	{
+		if (fieldIndex < 0 || static_cast<size_t>(fieldIndex) >= m_Fields.size())
+			return false;
+
+		size_t length = m_Fields[fieldIndex].length;
+		if (address.isIPv4() && length == 4)
+			return setField(packetData, packetLen, fieldIndex, address.getIPv4().toBytes());
+
+		if (address.isIPv6() && length == 16)
+			return setField(packetData, packetLen, fieldIndex, address.getIPv6().toBytes());
+
+		return false;
+	}
+
+	uint32_t PacketTemplate::getPayloadSum(size_t payloadLength) const
+	{
+		uint32_t sum = m_PayloadPrefixSums[payloadLength / 2];
+		if (payloadLength & 1)
+			sum += static_cast<uint32_t>(m_Data[m_HeaderLength + payloadLength - 1]) << 8;
+
+		return sum;
+	}
+}  // namespace pcpp
@@ -3,6 +3,7 @@
 #include "RawPacket.h"
 #include "Logger.h"
 #include "TimespecTimeval.h"
+#include <climits>
 #include <cstring>
 
 namespace pcpp
@@ -24,7 +25,8 @@ namespace pcpp
 
 	RawPacket::RawPacket(const uint8_t* pRawData, int rawDataLen, timespec timestamp, bool deleteRawDataAtDestructor,
 	                     LinkLayerType layerType)
-	    : m_RawData(const_cast<uint8_t*>(pRawData)), m_RawDataLen(rawDataLen), m_FrameLength(rawDataLen),
+	    : m_RawData(const_cast<uint8_t*>(pRawData)), m_RawDataLen(rawDataLen),
+	      m_RawDataCapacity(static_cast<size_t>(rawDataLen)), m_FrameLength(rawDataLen),
 	      m_TimeStamp(timestamp), m_DeleteRawDataAtDestructor(deleteRawDataAtDestructor), m_RawPacketSet(true),
 	      m_LinkLayerType(layerType)
 	{}
@@ -41,12 +43,39 @@ namespace pcpp
 	}
 
 	RawPacket& RawPacket::operator=(const RawPacket& other)
+	{
+		if (this != &other)
+		{
+			// reuse the buffer if it's owned and large enough
+			if (other.m_RawPacketSet && m_RawData != nullptr && m_DeleteRawDataAtDestructor &&
+			    m_RawDataCapacity >= static_cast<size_t>(other.m_RawDataLen))
+			{
+				copyDataFrom(other, false);
+				m_RawDataLen = other.m_RawDataLen;
+			}
+			else
+			{
+				clear();
+
+				copyDataFrom(other, true);
+			}
+		}
+
+		return *this;
+	}
+
+	RawPacket::RawPacket(RawPacket&& other) noexcept
+	{
+		moveDataFrom(other);
+	}
+
+	RawPacket& RawPacket::operator=(RawPacket&& other) noexcept
 	{
 		if (this != &other)
 		{
 			clear();
 
-			copyDataFrom(other, true);
+			moveDataFrom(other);
 		}
 
 		return *this;
@@ -69,6 +98,7 @@ namespace pcpp
 			m_DeleteRawDataAtDestructor = true;
 			m_RawData = new uint8_t[other.m_RawDataLen];
 			m_RawDataLen = other.m_RawDataLen;
+			m_RawDataCapacity = static_cast<size_t>(other.m_RawDataLen);
 		}
 
 		memcpy(m_RawData, other.m_RawData, other.m_RawDataLen);
@@ -77,6 +107,24 @@ namespace pcpp
 		m_RawPacketSet = true;
 	}
 
+	void RawPacket::moveDataFrom(RawPacket& other)
+	{
+		m_RawData = other.m_RawData;
+		m_RawDataLen = other.m_RawDataLen;
+		m_RawDataCapacity = other.m_RawDataCapacity;
+		m_FrameLength = other.m_FrameLength;
+		m_TimeStamp = other.m_TimeStamp;
+		m_DeleteRawDataAtDestructor = other.m_DeleteRawDataAtDestructor;
+		m_RawPacketSet = other.m_RawPacketSet;
+		m_LinkLayerType = other.m_LinkLayerType;
+
+		other.m_RawData = nullptr;
+		other.m_RawDataLen = 0;
+		other.m_RawDataCapacity = 0;
+		other.m_FrameLength = 0;
+		other.m_RawPacketSet = false;
+	}
+
 	bool RawPacket::setRawData(const uint8_t* pRawData, int rawDataLen, timeval timestamp, LinkLayerType layerType,
 	                           int frameLength)
 	{
@@ -91,6 +139,7 @@ namespace pcpp
 		m_FrameLength = (frameLength == -1) ? rawDataLen : frameLength;
 		m_RawData = (uint8_t*)pRawData;
 		m_RawDataLen = rawDataLen;
+		m_RawDataCapacity = static_cast<size_t>(rawDataLen);
 		m_TimeStamp = timestamp;
 		m_RawPacketSet = true;
 		m_LinkLayerType = layerType;
@@ -100,6 +149,8 @@ namespace pcpp
 	bool RawPacket::initWithRawData(const uint8_t* pRawData, int rawDataLen, timespec timestamp,
 	                                LinkLayerType layerType)
 	{
+		// free the current data while this instance still owns it, setRawData() would leak it afterwards
+		clear();
 		m_DeleteRawDataAtDestructor = false;
 		return setRawData(pRawData, rawDataLen, timestamp, layerType);
 	}
@@ -111,15 +162,39 @@ namespace pcpp
 
 		m_RawData = nullptr;
 		m_RawDataLen = 0;
+		m_RawDataCapacity = 0;
 		m_FrameLength = 0;
 		m_RawPacketSet = false;
 	}
 
+	bool RawPacket::reset(size_t capacity)
+	{
+		if (capacity > static_cast<size_t>(INT_MAX))
+		{
+			PCPP_LOG_ERROR("Cannot reset raw packet to a capacity of " << capacity << " bytes");
+			return false;
+		}
+
+		if (m_RawData == nullptr || !m_DeleteRawDataAtDestructor || m_RawDataCapacity < capacity)
+		{
+			clear();
+			m_RawData = new uint8_t[capacity];
+			m_RawDataCapacity = capacity;
+			m_DeleteRawDataAtDestructor = true;
+		}
+
+		m_RawDataLen = static_cast<int>(capacity);
+		m_FrameLength = m_RawDataLen;
+		m_RawPacketSet = true;
+		return true;
+	}
+
 	void RawPacket::appendData(const uint8_t* dataToAppend, size_t dataToAppendLen)
 	{
 		memcpy((uint8_t*)m_RawData + m_RawDataLen, dataToAppend, dataToAppendLen);
 		m_RawDataLen += dataToAppendLen;
 		m_FrameLength = m_RawDataLen;
+		updateRawDataCapacity();
 	}
 
 	void RawPacket::insertData(int atIndex, const uint8_t* dataToInsert, size_t dataToInsertLen)
@@ -137,6 +212,14 @@ namespace pcpp
 
 		m_RawDataLen += dataToInsertLen;
 		m_FrameLength = m_RawDataLen;
+		updateRawDataCapacity();
+	}
+
+	void RawPacket::updateRawDataCapacity()
+	{
+		// data was written past the known buffer length, so the buffer is at least as long as the data
+		if (m_RawDataCapacity < static_cast<size_t>(m_RawDataLen))
+			m_RawDataCapacity = static_cast<size_t>(m_RawDataLen);
 	}
 
 	bool RawPacket::reallocateData(size_t newBufferLength)
@@ -159,6 +242,7 @@ namespace pcpp
 
 		m_DeleteRawDataAtDestructor = true;
 		m_RawData = newBuffer;
+		m_RawDataCapacity = newBufferLength;
 
 		return true;
 	}
@@ -0,0 +1,650 @@
+#include "TLSFingerprintExtractor.h"
+#include "SSLCommon.h"
+#include "md5.h"
+#include "sha256.h"
+#include <algorithm>
+#include <string.h>
+
+namespace pcpp
+{
+	namespace
+	{
+		constexpr uint16_t TLSExtServerName = 0x0000;
+		constexpr uint16_t TLSExtSupportedGroups = 0x000a;
+		constexpr uint16_t TLSExtECPointFormats = 0x000b;
+		constexpr uint16_t TLSExtSignatureAlgorithms = 0x000d;
+		constexpr uint16_t TLSExtALPN = 0x0010;
+		constexpr uint16_t TLSExtSupportedVersions = 0x002b;
+
+		constexpr char HexDigits[] = "0123456789abcdef";
+
+		inline uint16_t readBE16(const uint8_t* ptr)
+		{
+			return static_cast<uint16_t>((ptr[0] << 8) | ptr[1]);
+		}
+
+		inline bool isGrease(uint16_t value)
+		{
+			// all GREASE values have the form 0x?a?a where both bytes are equal
+			return (value & 0x0f0f) == 0x0a0a && (value >> 8) == (value & 0xff);
+		}
+
+		/// A small stack buffer that formats text and feeds it to a hash in chunks, so the fingerprint string is
+		/// never materialized
+		template <typename THash> class HashWriter
+		{
+		public:
+			explicit HashWriter(THash& hash) : m_Hash(hash), m_Len(0)
+			{}
+
+			~HashWriter()
+			{
+				flush();
+			}
+
+			void putChar(char c)
+			{
+				if (m_Len == sizeof(m_Buffer))
+					flush();
+				m_Buffer[m_Len++] = c;
+			}
+
+			void putDecimal(uint32_t value)
+			{
+				char digits[10];
+				int numDigits = 0;
+				do
+				{
+					digits[numDigits++] = static_cast<char>('0' + value % 10);
+					value /= 10;
+				} while (value != 0);
+
+				while (numDigits > 0)
+					putChar(digits[--numDigits]);
+			}
+
+			void putHex16(uint16_t value)
+			{
+				putChar(HexDigits[(value >> 12) & 0xf]);
+				putChar(HexDigits[(value >> 8) & 0xf]);
+				putChar(HexDigits[(value >> 4) & 0xf]);
+				putChar(HexDigits[value & 0xf]);
+			}
+
+			void flush()
+			{
+				if (m_Len > 0)
+					m_Hash.add(m_Buffer, m_Len);
+				m_Len = 0;
+			}
+
+		private:
+			THash& m_Hash;
+			size_t m_Len;
+			char m_Buffer[128];
+		};
+
+		void bytesToHex(const uint8_t* bytes, size_t numOfHexChars, char* out)
+		{
+			for (size_t i = 0; i < numOfHexChars; i++)
+			{
+				uint8_t curByte = bytes[i / 2];
+				out[i] = HexDigits[(i % 2 == 0) ? (curByte >> 4) : (curByte & 0xf)];
+			}
+			out[numOfHexChars] = '\0';
+		}
+
+		/// A bounds-checked view of a ClientHello / ServerHello extension block
+		struct ExtensionView
+		{
+			uint16_t type;
+			const uint8_t* data;
+			size_t len;
+			bool complete;
+		};
+
+		/// Iterates the extensions of a hello message. Stops at the first extension whose header doesn't fit
+		class ExtensionIterator
+		{
+		public:
+			ExtensionIterator(const uint8_t* pos, const uint8_t* end) : m_Pos(pos), m_End(end)
+			{}
+
+			bool next(ExtensionView& ext)
+			{
+				if (static_cast<size_t>(m_End - m_Pos) < 2 * sizeof(uint16_t))
+					return false;
+
+				ext.type = readBE16(m_Pos);
+				size_t extLen = readBE16(m_Pos + sizeof(uint16_t));
+				ext.data = m_Pos + 2 * sizeof(uint16_t);
+				size_t available = static_cast<size_t>(m_End - ext.data);
+				ext.complete = extLen <= available;
+				ext.len = ext.complete ? extLen : available;
+				m_Pos = ext.data + ext.len;
+				return true;
+			}
+
+		private:
+			const uint8_t* m_Pos;
+			const uint8_t* m_End;
+		};
+
+		/// Locate the first ClientHello or ServerHello message in a payload starting with a TLS record. On success
+		/// msgStart points to the message body (after the handshake header) and msgEnd to its end, clipped to the
+		/// record and payload boundaries
+		uint8_t findHelloMessage(const uint8_t* data, size_t dataLen, const uint8_t*& msgStart,
+		                         const uint8_t*& msgEnd)
+		{
+			const uint8_t* payloadEnd = data + dataLen;
+			const uint8_t* recordPos = data;
+			while (static_cast<size_t>(payloadEnd - recordPos) >= sizeof(ssl_tls_record_layer))
+			{
+				uint8_t recordType = recordPos[0];
+				uint16_t recordVersion = readBE16(recordPos + 1);
+				uint16_t recordLen = readBE16(recordPos + 3);
+
+				// only SSLv3 - TLS1.3 records (TLS1.3 uses the TLS1.2 / TLS1.0 record version)
+				if (recordType < SSL_CHANGE_CIPHER_SPEC || recordType > SSL_APPLICATION_DATA ||
+				    (recordVersion & 0xff00) != 0x0300 || recordVersion > 0x0304)
+					return TLSFingerprint::NoHelloMessage;
+
+				const uint8_t* recordData = recordPos + sizeof(ssl_tls_record_layer);
+				const uint8_t* recordEnd =
+				    (static_cast<size_t>(payloadEnd - recordData) < recordLen) ? payloadEnd : recordData + recordLen;
+
+				if (recordType == SSL_HANDSHAKE)
+				{
+					const uint8_t* msgPos = recordData;
+					while (static_cast<size_t>(recordEnd - msgPos) >= sizeof(ssl_tls_handshake_layer))
+					{
+						uint8_t handshakeType = msgPos[0];
+						size_t msgLen = (static_cast<size_t>(msgPos[1]) << 16) | readBE16(msgPos + 2);
+						const uint8_t* body = msgPos + sizeof(ssl_tls_handshake_layer);
+						const uint8_t* bodyEnd =
+						    (static_cast<size_t>(recordEnd - body) < msgLen) ? recordEnd : body + msgLen;
+
+						if (handshakeType == SSL_CLIENT_HELLO || handshakeType == SSL_SERVER_HELLO)
+						{
+							msgStart = body;
+							msgEnd = bodyEnd;
+							return handshakeType == SSL_CLIENT_HELLO ? TLSFingerprint::ClientHello
+							                                         : TLSFingerprint::ServerHello;
+						}
+
+						msgPos = bodyEnd;
+						if (msgPos == recordEnd)
+							break;
+					}
+				}
+
+				if (recordEnd == payloadEnd)
+					break;
+				recordPos = recordEnd;
+			}
+
+			return TLSFingerprint::NoHelloMessage;
+		}
+
+		void writeJA4Version(uint16_t version, char* out)
+		{
+			switch (version)
+			{
+			case 0x0304:
+				out[0] = '1';
+				out[1] = '3';
+				break;
+			case 0x0303:
+				out[0] = '1';
+				out[1] = '2';
+				break;
+			case 0x0302:
+				out[0] = '1';
+				out[1] = '1';
+				break;
+			case 0x0301:
+				out[0] = '1';
+				out[1] = '0';
+				break;
+			case 0x0300:
+				out[0] = 's';
+				out[1] = '3';
+				break;
+			case 0x0002:
+				out[0] = 's';
+				out[1] = '2';
+				break;
+			case 0xfeff:
+				out[0] = 'd';
+				out[1] = '1';
+				break;
+			case 0xfefd:
+				out[0] = 'd';
+				out[1] = '2';
+				break;
+			case 0xfefc:
+				out[0] = 'd';
+				out[1] = '3';
+				break;
+			default:
+				out[0] = '0';
+				out[1] = '0';
+			}
+		}
+
+		inline bool isAlphanumeric(uint8_t c)
+		{
+			return (c >= '0' && c <= '9') || (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z');
+		}
+
+		void writeTwoDigits(size_t value, char* out)
+		{
+			if (value > 99)
+				value = 99;
+			out[0] = static_cast<char>('0' + value / 10);
+			out[1] = static_cast<char>('0' + value % 10);
+		}
+
+		/// Writes the first 12 hex characters of the SHA256 of a comma-separated hex list, or "000000000000" if
+		/// the list is empty
+		void writeTruncatedListHash(const uint16_t* list, size_t listSize, const uint8_t* sigAlgs, size_t sigAlgsLen,
+		                            char* out)
+		{
+			if (listSize == 0)
+			{
+				memset(out, '0', 12);
+				return;
+			}
+
+			SHA256 sha256;
+			{
+				HashWriter<SHA256> writer(sha256);
+				for (size_t i = 0; i < listSize; i++)
+				{
+					if (i > 0)
+						writer.putChar(',');
+					writer.putHex16(list[i]);
+				}
+
+				if (sigAlgs != nullptr && sigAlgsLen > 0)
+				{
+					writer.putChar('_');
+					for (size_t i = 0; i + 1 < sigAlgsLen; i += 2)
+					{
+						if (i > 0)
+							writer.putChar(',');
+						writer.putHex16(readBE16(sigAlgs + i));
+					}
+				}
+			}
+
+			uint8_t digest[SHA256::HashBytes];
+			sha256.getHash(digest);
+			char hex[13];
+			bytesToHex(digest, 12, hex);
+			memcpy(out, hex, 12);
+		}
+
+		void fingerprintClientHello(const uint8_t* msg, const uint8_t* msgEnd, TLSFingerprint& result, bool calcJA4)
+		{
+			// the message may be truncated, so every field is checked against the message length before reading it
+			size_t msgLen = static_cast<size_t>(msgEnd - msg);
+			uint16_t handshakeVersion = (msgLen >= sizeof(uint16_t)) ? readBE16(msg) : 0;
+			size_t offset = sizeof(uint16_t) + 32;  // version + random
+
+			const uint8_t* ciphers = nullptr;
+			size_t ciphersLen = 0;
+			const uint8_t* extStart = nullptr;
+			const uint8_t* extEnd = nullptr;
+			if (offset < msgLen)
+			{
+				offset += sizeof(uint8_t) + msg[offset];  // session ID
+				if (offset + sizeof(uint16_t) <= msgLen)
+				{
+					size_t declaredLen = readBE16(msg + offset);
+					offset += sizeof(uint16_t);
+					ciphers = msg + offset;
+					ciphersLen = std::min(declaredLen, msgLen - offset) & ~static_cast<size_t>(1);
+					offset += declaredLen;
+					if (offset < msgLen)
+					{
+						offset += sizeof(uint8_t) + msg[offset];  // compression methods
+						if (offset + sizeof(uint16_t) <= msgLen)
+						{
+							size_t declaredExtLen = readBE16(msg + offset);
+							offset += sizeof(uint16_t);
+							extStart = msg + offset;
+							extEnd = extStart + std::min(declaredExtLen, msgLen - offset);
+						}
+					}
+				}
+			}
+
+			// JA3: SSLVersion,Ciphers,Extensions,EllipticCurves,EllipticCurvePointFormats
+			MD5 md5;
+			const uint8_t* groupsExt = nullptr;
+			size_t groupsExtLen = 0;
+			const uint8_t* pointFormatsExt = nullptr;
+			size_t pointFormatsExtLen = 0;
+
+			uint16_t ja4Ciphers[TLSFingerprintExtractor::MaxJA4ListSize];
+			size_t ja4CipherCount = 0;
+			uint16_t ja4Extensions[TLSFingerprintExtractor::MaxJA4ListSize];
+			size_t ja4ExtensionCount = 0;
+			size_t ja4TotalExtensionCount = 0;
+			bool ja4Overflow = false;
+			bool hasSNI = false;
+			const uint8_t* alpn = nullptr;
+			size_t alpnLen = 0;
+			const uint8_t* sigAlgs = nullptr;
+			size_t sigAlgsLen = 0;
+			uint16_t highestSupportedVersion = 0;
+
+			{
+				HashWriter<MD5> writer(md5);
+				writer.putDecimal(handshakeVersion);
+				writer.putChar(',');
+
+				bool first = true;
+				for (size_t i = 0; i < ciphersLen; i += sizeof(uint16_t))
+				{
+					uint16_t cipher = readBE16(ciphers + i);
+					if (isGrease(cipher))
+						continue;
+
+					if (!first)
+						writer.putChar('-');
+					writer.putDecimal(cipher);
+					first = false;
+
+					if (ja4CipherCount < TLSFingerprintExtractor::MaxJA4ListSize)
+						ja4Ciphers[ja4CipherCount++] = cipher;
+					else
+						ja4Overflow = true;
+				}
+				writer.putChar(',');
+
+				first = true;
+				if (extStart != nullptr)
+				{
+					ExtensionIterator iter(extStart, extEnd);
+					ExtensionView ext;
+					while (iter.next(ext))
+					{
+						if (isGrease(ext.type))
+							continue;
+
+						if (!first)
+							writer.putChar('-');
+						writer.putDecimal(ext.type);
+						first = false;
+
+						ja4TotalExtensionCount++;
+
+						switch (ext.type)
+						{
+						case TLSExtServerName:
+							hasSNI = true;
+							break;
+						case TLSExtALPN:
+							// ALPN extension: list length (2 bytes), then length-prefixed protocol names
+							if (alpn == nullptr && ext.complete && ext.len > sizeof(uint16_t) + 1)
+							{
+								alpnLen = ext.data[sizeof(uint16_t)];
+								alpn = ext.data + sizeof(uint16_t) + 1;
+								if (alpnLen > ext.len - sizeof(uint16_t) - 1)
+									alpnLen = ext.len - sizeof(uint16_t) - 1;
+							}
+							break;
+						case TLSExtSupportedGroups:
+							if (groupsExt == nullptr && ext.complete)
+							{
+								groupsExt = ext.data;
+								groupsExtLen = ext.len;
+							}
+							break;
+						case TLSExtECPointFormats:
+							if (pointFormatsExt == nullptr && ext.complete)
+							{
+								pointFormatsExt = ext.data;
+								pointFormatsExtLen = ext.len;
+							}
+							break;
+						case TLSExtSignatureAlgorithms:
+							if (sigAlgs == nullptr && ext.complete && ext.len >= sizeof(uint16_t))
+							{
+								sigAlgsLen = std::min(static_cast<size_t>(readBE16(ext.data)),
+								                      ext.len - sizeof(uint16_t));
+								sigAlgs = ext.data + sizeof(uint16_t);
+							}
+							break;
+						case TLSExtSupportedVersions:
+							// ClientHello supported versions: list length (1 byte), then 2-byte versions
+							if (ext.complete && ext.len >= 1)
+							{
+								size_t listLen = std::min(static_cast<size_t>(ext.data[0]), ext.len - 1);
+								for (size_t i = 0; i + 1 < listLen; i += 2)
+								{
+									uint16_t version = readBE16(ext.data + 1 + i);
+									if (!isGrease(version) && version > highestSupportedVersion)
+										highestSupportedVersion = version;
+								}
+							}
+							break;
+						default:
+							break;
+						}
+
+						if (ext.type != TLSExtServerName && ext.type != TLSExtALPN)
+						{
+							if (ja4ExtensionCount < TLSFingerprintExtractor::MaxJA4ListSize)
+								ja4Extensions[ja4ExtensionCount++] = ext.type;
+							else
+								ja4Overflow = true;
+						}
+					}
+				}
+				writer.putChar(',');
+
+				// same validation as TLSSupportedGroupsExtension#getSupportedGroups()
+				if (groupsExt != nullptr && groupsExtLen >= sizeof(uint16_t))
+				{
+					size_t listLen = readBE16(groupsExt);
+					if (listLen == groupsExtLen - sizeof(uint16_t) && listLen % 2 == 0)
+					{
+						first = true;
+						for (size_t i = 0; i < listLen; i += sizeof(uint16_t))
+						{
+							uint16_t group = readBE16(groupsExt + sizeof(uint16_t) + i);
+							if (isGrease(group))
+								continue;
+
+							if (!first)
+								writer.putChar('-');
+							writer.putDecimal(group);
+							first = false;
+						}
+					}
+				}
+				writer.putChar(',');
+
+				// same validation as TLSECPointFormatExtension#getECPointFormatList()
+				if (pointFormatsExt != nullptr && pointFormatsExtLen >= 1)
+				{
+					uint8_t listLen = pointFormatsExt[0];
+					if (listLen == static_cast<uint8_t>(pointFormatsExtLen - 1))
+					{
+						for (size_t i = 0; i < listLen; i++)
+						{
+							if (i > 0)
+								writer.putChar('-');
+							writer.putDecimal(pointFormatsExt[1 + i]);
+						}
+					}
+				}
+			}
+
+			uint8_t digest[MD5::HashBytes];
+			md5.getHash(digest);
+			bytesToHex(digest, TLSFingerprint::JA3DigestLength, result.ja3);
+
+			if (!calcJA4 || ja4Overflow)
+			{
+				result.ja4[0] = '\0';
+				return;
+			}
+
+			// JA4_a: protocol, version, SNI, number of ciphers, number of extensions, first and last ALPN chars
+			char* out = result.ja4;
+			out[0] = 't';
+			writeJA4Version(highestSupportedVersion != 0 ? highestSupportedVersion : handshakeVersion, out + 1);
+			out[3] = hasSNI ? 'd' : 'i';
+			writeTwoDigits(ja4CipherCount, out + 4);
+			writeTwoDigits(ja4TotalExtensionCount, out + 6);
+			if (alpn == nullptr || alpnLen == 0)
+			{
+				out[8] = '0';
+				out[9] = '0';
+			}
+			else if (isAlphanumeric(alpn[0]) && isAlphanumeric(alpn[alpnLen - 1]))
+			{
+				out[8] = static_cast<char>(alpn[0]);
+				out[9] = static_cast<char>(alpn[alpnLen - 1]);
+			}
+			else
+			{
+				out[8] = HexDigits[alpn[0] >> 4];
+				out[9] = HexDigits[alpn[alpnLen - 1] & 0xf];
+			}
+			out[10] = '_';
+
+			// JA4_b: truncated SHA256 of the sorted cipher list
+			std::sort(ja4Ciphers, ja4Ciphers + ja4CipherCount);
+			writeTruncatedListHash(ja4Ciphers, ja4CipherCount, nullptr, 0, out + 11);
+			out[23] = '_';
+
+			// JA4_c: truncated SHA256 of the sorted extension list (without SNI and ALPN) and the signature
+			// algorithms in their original order
+			std::sort(ja4Extensions, ja4Extensions + ja4ExtensionCount);
+			writeTruncatedListHash(ja4Extensions, ja4ExtensionCount, sigAlgs, sigAlgsLen, out + 24);
+			out[TLSFingerprint::JA4Length] = '\0';
+		}
+
+		void fingerprintServerHello(const uint8_t* msg, const uint8_t* msgEnd, TLSFingerprint& result)
+		{
+			size_t msgLen = static_cast<size_t>(msgEnd - msg);
+			uint16_t handshakeVersion = (msgLen >= sizeof(uint16_t)) ? readBE16(msg) : 0;
+			size_t offset = sizeof(uint16_t) + 32;  // version + random
+
+			uint16_t cipherSuite = 0;
+			const uint8_t* extStart = nullptr;
+			const uint8_t* extEnd = nullptr;
+			if (offset < msgLen)
+			{
+				offset += sizeof(uint8_t) + msg[offset];  // session ID
+				if (offset + sizeof(uint16_t) <= msgLen)
+					cipherSuite = readBE16(msg + offset);
+				offset += sizeof(uint16_t) + sizeof(uint8_t);  // cipher suite + compression method
+				if (offset + sizeof(uint16_t) <= msgLen)
+				{
+					size_t declaredExtLen = readBE16(msg + offset);
+					offset += sizeof(uint16_t);
+					extStart = msg + offset;
+					extEnd = extStart + std::min(declaredExtLen, msgLen - offset);
+				}
+			}
+
+			// JA3S: SSLVersion,Cipher,Extensions
+			MD5 md5;
+			{
+				HashWriter<MD5> writer(md5);
+				writer.putDecimal(handshakeVersion);
+				writer.putChar(',');
+				writer.putDecimal(cipherSuite);
+				writer.putChar(',');
+
+				if (extStart != nullptr)
+				{
+					ExtensionIterator iter(extStart, extEnd);
+					ExtensionView ext;
+					bool first = true;
+					while (iter.next(ext))
+					{
+						if (!first)
+							writer.putChar('-');
+						writer.putDecimal(ext.type);
+						first = false;
+					}
+				}
+			}
+
+			uint8_t digest[MD5::HashBytes];
+			md5.getHash(digest);
+			bytesToHex(digest, TLSFingerprint::JA3DigestLength, result.ja3);
+			result.ja4[0] = '\0';
+		}
+
+		bool fingerprintHelloMessage(uint8_t msgType, const uint8_t* msgStart, const uint8_t* msgEnd,
+		                             TLSFingerprint& result, bool calcJA4)
+		{
+			switch (msgType)
+			{
+			case TLSFingerprint::ClientHello:
+				fingerprintClientHello(msgStart, msgEnd, result, calcJA4);
+				break;
+			case TLSFingerprint::ServerHello:
+				fingerprintServerHello(msgStart, msgEnd, result);
+				break;
+			default:
+				return false;
+			}
+
+			result.type = static_cast<TLSFingerprint::MessageType>(msgType);
+			return true;
+		}
+	}  // namespace
+
+	bool TLSFingerprintExtractor::extract(const uint8_t* data, size_t dataLen, TLSFingerprint& result, bool calcJA4)
+	{
+		result.clear();
+		if (data == nullptr)
+			return false;
+
+		const uint8_t* msgStart = nullptr;
+		const uint8_t* msgEnd = nullptr;
+		uint8_t msgType = findHelloMessage(data, dataLen, msgStart, msgEnd);
+		return fingerprintHelloMessage(msgType, msgStart, msgEnd, result, calcJA4);
+	}
+
+	bool TLSFingerprintExtractor::extractFromHandshakeMessage(const uint8_t* data, size_t dataLen,
+	                                                          TLSFingerprint& result, bool calcJA4)
+	{
+		result.clear();
+		if (data == nullptr || dataLen < sizeof(ssl_tls_handshake_layer))
+			return false;
+
+		uint8_t msgType = TLSFingerprint::NoHelloMessage;
+		if (data[0] == SSL_CLIENT_HELLO)
+			msgType = TLSFingerprint::ClientHello;
+		else if (data[0] == SSL_SERVER_HELLO)
+			msgType = TLSFingerprint::ServerHello;
+
+		size_t msgLen = (static_cast<size_t>(data[1]) << 16) | readBE16(data + 2);
+		const uint8_t* msgStart = data + sizeof(ssl_tls_handshake_layer);
+		size_t available = dataLen - sizeof(ssl_tls_handshake_layer);
+		return fingerprintHelloMessage(msgType, msgStart, msgStart + std::min(msgLen, available), result, calcJA4);
+	}
+
+	size_t TLSFingerprintExtractor::extractBatch(const uint8_t* const payloads[], const size_t payloadLengths[],
+	                                             size_t count, TLSFingerprint results[], bool calcJA4)
+	{
+		size_t numOfFingerprints = 0;
+		for (size_t i = 0; i < count; i++)
+		{
+			if (extract(payloads[i], payloadLengths[i], results[i], calcJA4))
+				numOfFingerprints++;
+		}
+
+		return numOfFingerprints;
+	}
+}  // namespace pcpp
@@ -0,0 +1,349 @@
+#define LOG_MODULE PacketLogModuleSSLLayer
+
+#include "TLSStreamDecoder.h"
+#include "Logger.h"
+#include <algorithm>
+
+namespace pcpp
+{
+	// the maximum length of a TLSCiphertext record according to RFC 5246
+	static constexpr size_t MaxTLSRecordLength = 16384 + 2048;
+	// heartbeat records (RFC 6520) aren't part of SSLRecordType but may appear in the stream
+	static constexpr uint8_t TLSRecordTypeHeartbeat = 24;
+
+	static inline uint16_t readBE16(const uint8_t* ptr)
+	{
+		return static_cast<uint16_t>((ptr[0] << 8) | ptr[1]);
+	}
+
+	static inline size_t readHandshakeLength(const uint8_t* handshakeHeader)
+	{
+		return (static_cast<size_t>(handshakeHeader[1]) << 16) | readBE16(handshakeHeader + 2);
+	}
+
+	static bool isValidRecordHeader(const uint8_t* header)
+	{
+		uint8_t recordType = header[0];
+		uint16_t recordVersion = readBE16(header + 1);
+		return recordType >= SSL_CHANGE_CIPHER_SPEC && recordType <= TLSRecordTypeHeartbeat &&
+		       (recordVersion & 0xff00) == 0x0300 && recordVersion <= 0x0304 &&
+		       readBE16(header + 3) <= MaxTLSRecordLength;
+	}
+
+	TLSStreamDecoder::TLSStreamDecoder(OnHandshakeMessage onHandshakeMessageCallback, void* userCookie,
+	                                   size_t maxBufferedBytesPerConnection)
+	    : m_OnHandshakeMessage(onHandshakeMessageCallback), m_UserCookie(userCookie),
+	      m_MaxBufferedBytes(maxBufferedBytesPerConnection)
+	{}
+
+	void TLSStreamDecoder::processTcpData(int8_t side, const TcpStreamData& tcpData)
+	{
+		if (side < 0 || side > 1)
+		{
+			PCPP_LOG_ERROR("Invalid connection side: " << (int)side);
+			return;
+		}
+
+		decodeTcpData(side, tcpData);
+		releasePendingCloses();
+	}
+
+	void TLSStreamDecoder::decodeTcpData(int8_t side, const TcpStreamData& tcpData)
+	{
+		ConnectionState& connection = m_Connections[tcpData.getConnectionData().flowKey];
+		SideState& sideState = connection.sides[side];
+		if (sideState.stopped)
+			return;
+
+		if (tcpData.isBytesMissing())
+		{
+			PCPP_LOG_DEBUG("Bytes missing in TLS stream of flow " << tcpData.getConnectionData().flowKey
+			                                                       << ", stopping to decode side " << (int)side);
+			stopSide(sideState, DecodeError);
+			return;
+		}
+
+		SegmentContext ctx = { side, &tcpData, &connection, &sideState };
+		const uint8_t* data = tcpData.getData();
+		size_t dataLen = tcpData.getDataLength();
+
+		// first complete a record that was started in a previous segment
+		std::vector<uint8_t>& recordBuffer = sideState.recordBuffer;
+		if (!recordBuffer.empty())
+		{
+			if (recordBuffer.size() < sizeof(ssl_tls_record_layer))
+			{
+				size_t headerBytes = std::min(sizeof(ssl_tls_record_layer) - recordBuffer.size(), dataLen);
+				if (!appendToBuffer(ctx, recordBuffer, data, headerBytes))
+					return;
+
+				data += headerBytes;
+				dataLen -= headerBytes;
+				if (recordBuffer.size() < sizeof(ssl_tls_record_layer))
+					return;
+
+				if (!isValidRecordHeader(recordBuffer.data()))
+				{
+					stopSide(sideState, DecodeError);
+					return;
+				}
+			}
+
+			size_t recordLen = sizeof(ssl_tls_record_layer) + readBE16(recordBuffer.data() + 3);
+			size_t bodyBytes = std::min(recordLen - recordBuffer.size(), dataLen);
+			if (!appendToBuffer(ctx, recordBuffer, data, bodyBytes))
+				return;
+
+			data += bodyBytes;
+			dataLen -= bodyBytes;
+			if (recordBuffer.size() < recordLen)
+				return;
+
+			// the record is consumed, so move it out of the record buffer before processing it, otherwise it counts
+			// against the buffer cap when its last handshake message is buffered
+			std::vector<uint8_t> record;
+			record.swap(recordBuffer);
+			m_Stats.bufferedRecords++;
+			processRecord(ctx, record.data(), recordLen, true);
+			if (sideState.stopped)
+				return;
+
+			// keep the allocated buffer for the next record
+			record.clear();
+			recordBuffer.swap(record);
+		}
+
+		// records fully contained in this segment are processed in place
+		while (dataLen > 0)
+		{
+			if (dataLen < sizeof(ssl_tls_record_layer))
+			{
+				appendToBuffer(ctx, recordBuffer, data, dataLen);
+				return;
+			}
+
+			if (!isValidRecordHeader(data))
+			{
+				stopSide(sideState, DecodeError);
+				return;
+			}
+
+			size_t recordLen = sizeof(ssl_tls_record_layer) + readBE16(data + 3);
+			if (recordLen > dataLen)
+			{
+				appendToBuffer(ctx, recordBuffer, data, dataLen);
+				return;
+			}
+
+			m_Stats.zeroCopyRecords++;
+			processRecord(ctx, data, recordLen, false);
+			if (sideState.stopped)
+				return;
+
+			data += recordLen;
+			dataLen -= recordLen;
+		}
+	}
+
+	void TLSStreamDecoder::processRecord(SegmentContext& ctx, const uint8_t* record, size_t recordLen, bool buffered)
+	{
+		switch (record[0])
+		{
+		case SSL_HANDSHAKE:
+			processHandshakeData(ctx, record + sizeof(ssl_tls_record_layer), recordLen - sizeof(ssl_tls_record_layer),
+			                     readBE16(record + 1), buffered);
+			break;
+		case SSL_CHANGE_CIPHER_SPEC:
+		case SSL_APPLICATION_DATA:
+			// the rest of the handshake is encrypted
+			stopSide(*ctx.sideState, HandshakeEncrypted);
+			break;
+		default:
+			break;
+		}
+	}
+
+	void TLSStreamDecoder::processHandshakeData(SegmentContext& ctx, const uint8_t* data, size_t dataLen,
+	                                            uint16_t recordVersion, bool buffered)
+	{
+		SideState& sideState = *ctx.sideState;
+
+		// first complete a handshake message that was started in a previous record
+		std::vector<uint8_t>& messageBuffer = sideState.messageBuffer;
+		if (!messageBuffer.empty())
+		{
+			if (messageBuffer.size() < sizeof(ssl_tls_handshake_layer))
+			{
+				size_t headerBytes = std::min(sizeof(ssl_tls_handshake_layer) - messageBuffer.size(), dataLen);
+				if (!appendToBuffer(ctx, messageBuffer, data, headerBytes))
+					return;
+
+				data += headerBytes;
+				dataLen -= headerBytes;
+				if (messageBuffer.size() < sizeof(ssl_tls_handshake_layer))
+					return;
+			}
+
+			size_t messageLen = sizeof(ssl_tls_handshake_layer) + readHandshakeLength(messageBuffer.data());
+			size_t bodyBytes = std::min(messageLen - messageBuffer.size(), dataLen);
+			if (!appendToBuffer(ctx, messageBuffer, data, bodyBytes))
+				return;
+
+			data += bodyBytes;
+			dataLen -= bodyBytes;
+			if (messageBuffer.size() < messageLen)
+				return;
+
+			emitMessage(ctx, messageBuffer.data(), messageLen, sideState.messageRecordVersion, true);
+			if (sideState.stopped)
+				return;
+
+			messageBuffer.clear();
+		}
+
+		while (dataLen > 0)
+		{
+			if (dataLen >= sizeof(ssl_tls_handshake_layer))
+			{
+				size_t messageLen = sizeof(ssl_tls_handshake_layer) + readHandshakeLength(data);
+				if (messageLen <= dataLen)
+				{
+					emitMessage(ctx, data, messageLen, recordVersion, buffered);
+					if (sideState.stopped)
+						return;
+
+					data += messageLen;
+					dataLen -= messageLen;
+					continue;
+				}
+			}
+
+			// the message continues in the next handshake record
+			sideState.messageRecordVersion = recordVersion;
+			appendToBuffer(ctx, messageBuffer, data, dataLen);
+			return;
+		}
+	}
+
+	bool TLSStreamDecoder::appendToBuffer(SegmentContext& ctx, std::vector<uint8_t>& buffer, const uint8_t* data,
+	                                      size_t dataLen)
+	{
+		if (ctx.connection->bufferedBytes() + dataLen > m_MaxBufferedBytes)
+		{
+			uint32_t flowKey = ctx.tcpData->getConnectionData().flowKey;
+			PCPP_LOG_DEBUG("TLS stream of flow " << flowKey << " exceeded the buffer cap of " << m_MaxBufferedBytes
+			                                     << " bytes");
+			stopSide(*ctx.sideState, BufferCapExceeded);
+			return false;
+		}
+
+		buffer.insert(buffer.end(), data, data + dataLen);
+		return true;
+	}
+
+	void TLSStreamDecoder::emitMessage(SegmentContext& ctx, const uint8_t* data, size_t dataLen,
+	                                   uint16_t recordVersion, bool reassembled)
+	{
+		m_Stats.handshakeMessages++;
+		if (reassembled)
+			m_Stats.reassembledHandshakeMessages++;
+
+		if (m_OnHandshakeMessage == nullptr)
+			return;
+
+		TLSHandshakeMessageData message;
+		message.handshakeType = static_cast<SSLHandshakeType>(data[0]);
+		message.data = data;
+		message.dataLen = dataLen;
+		message.recordVersion = recordVersion;
+		message.reassembled = reassembled;
+		message.connectionData = &ctx.tcpData->getConnectionData();
+		message.timestamp = ctx.tcpData->getTimeStampPrecise();
+		// the callback may close connections, which only stops them until the segment is processed
+		m_InCallback = true;
+		m_OnHandshakeMessage(ctx.side, message, m_UserCookie);
+		m_InCallback = false;
+	}
+
+	void TLSStreamDecoder::stopSide(SideState& sideState, StopReason reason)
+	{
+		if (reason == BufferCapExceeded)
+			m_Stats.bufferCapExceeded++;
+		else if (reason == DecodeError)
+			m_Stats.decodeErrors++;
+
+		sideState.stopped = true;
+		std::vector<uint8_t>().swap(sideState.recordBuffer);
+		std::vector<uint8_t>().swap(sideState.messageBuffer);
+	}
+
+	void TLSStreamDecoder::closeConnection(const ConnectionData& connectionData)
+	{
+		if (!m_InCallback)
+		{
+			m_Connections.erase(connectionData.flowKey);
+			return;
+		}
+
+		// the segment being processed may belong to this connection, so its state must stay valid until it's done
+		auto iter = m_Connections.find(connectionData.flowKey);
+		if (iter == m_Connections.end())
+			return;
+
+		iter->second.sides[0].stopped = true;
+		iter->second.sides[1].stopped = true;
+		m_PendingCloses.push_back(connectionData.flowKey);
+	}
+
+	void TLSStreamDecoder::closeAllConnections()
+	{
+		if (!m_InCallback)
+		{
+			m_Connections.clear();
+			return;
+		}
+
+		for (auto& connection : m_Connections)
+		{
+			connection.second.sides[0].stopped = true;
+			connection.second.sides[1].stopped = true;
+		}
+
+		m_PendingCloseAll = true;
+	}
+
+	void TLSStreamDecoder::releasePendingCloses()
+	{
+		if (m_PendingCloseAll)
+			m_Connections.clear();
+		else
+		{
+			for (auto flowKey : m_PendingCloses)
+				m_Connections.erase(flowKey);
+		}
+
+		m_PendingCloseAll = false;
+		m_PendingCloses.clear();
+	}
+
+	size_t TLSStreamDecoder::getBufferedBytes(uint32_t flowKey) const
+	{
+		auto iter = m_Connections.find(flowKey);
+		if (iter == m_Connections.end())
+			return 0;
+
+		return iter->second.bufferedBytes();
+	}
+
+	void TLSStreamDecoder::onTcpMessageReady(int8_t side, const TcpStreamData& tcpData, void* userCookie)
+	{
+		static_cast<TLSStreamDecoder*>(userCookie)->processTcpData(side, tcpData);
+	}
+
+	void TLSStreamDecoder::onTcpConnectionEnd(const ConnectionData& connectionData,
+	                                          TcpReassembly::ConnectionEndReason reason, void* userCookie)
+	{
+		(void)reason;
+		static_cast<TLSStreamDecoder*>(userCookie)->closeConnection(connectionData);
+	}
+}  // namespace pcpp
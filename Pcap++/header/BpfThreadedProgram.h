@@ -0,0 +1,74 @@
+#pragma once
+
+#include <memory>
+#include <stdint.h>
+
+// Forward Declaration - the program is created by libpcap
+struct bpf_program;
+
+/// @file
+/// A translator which converts a compiled classic BPF program into call-threaded code: every BPF instruction is
+/// decoded once into a pointer to a specialized handler, its operand and pre-resolved jump targets. Running the
+/// program then only calls handlers one after another instead of decoding every instruction on every packet like
+/// libpcap's interpreter does. The translation is portable and doesn't generate machine code, so it works on any
+/// platform and doesn't need executable memory
+
+/// @namespace pcpp
+/// @brief The main namespace for the PcapPlusPlus lib
+namespace pcpp
+{
+	/// @class BpfThreadedProgram
+	/// A classic BPF program translated to threaded code. The result of run() is identical to the result of
+	/// pcap_offline_filter() for the same program and packet. Programs using instructions the translator doesn't
+	/// support (for example Linux-specific extensions) are rejected by translate(), and the caller should keep using
+	/// the interpreter for them. A translated program isn't modified by run(), so it can be run concurrently from
+	/// multiple threads
+	class BpfThreadedProgram
+	{
+	public:
+		/// A c'tor that creates an empty program. Use translate() to load a program into it
+		BpfThreadedProgram();
+
+		~BpfThreadedProgram();
+
+		BpfThreadedProgram(const BpfThreadedProgram&) = delete;
+		BpfThreadedProgram& operator=(const BpfThreadedProgram&) = delete;
+
+		/// Translate a compiled BPF program. The program is validated the same way the kernel and libpcap validate
+		/// BPF programs. On failure the object is left empty
+		/// @param[in] program The program to translate, usually created by pcap_compile()
+		/// @return True if the program was translated successfully, false if it's invalid or uses instructions which
+		/// aren't supported
+		bool translate(const bpf_program* program);
+
+		/// @return True if a program was translated successfully into this object, false otherwise
+		bool isValid() const
+		{
+			return m_Instructions != nullptr;
+		}
+
+		/// @return The number of BPF instructions in the translated program
+		uint32_t getInstructionCount() const
+		{
+			return m_InstructionCount;
+		}
+
+		/// Run the program on a packet
+		/// @param[in] packetData A pointer to the packet data
+		/// @param[in] wireLength The original length of the packet on the wire
+		/// @param[in] captureLength The number of bytes available in packetData
+		/// @return The value returned by the BPF program, which is non-zero if the packet matches. An empty program
+		/// returns 0
+		uint32_t run(const uint8_t* packetData, uint32_t wireLength, uint32_t captureLength) const;
+
+		/// @cond PCPP_INTERNAL
+		struct Instruction;
+		struct State;
+		/// @endcond
+
+	private:
+		std::unique_ptr<Instruction[]> m_Instructions;
+		uint32_t m_InstructionCount;
+		bool m_UsesScratchMemory;
+	};
+}  // namespace pcpp
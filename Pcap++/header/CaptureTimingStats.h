@@ -0,0 +1,273 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <stddef.h>
+#include <stdint.h>
+#ifdef _MSC_VER
+#	include <intrin.h>
+#	include <winsock2.h>
+#else
+#	include <sys/time.h>
+#endif
+
+/// @file
+/// Timing instrumentation of the live capture path: how long packets wait between their capture timestamp and the
+/// user callback, how long the callback runs, how many packets each pcap_dispatch() round returns and how much CPU
+/// time the capture threads use. Values are collected in log-linear (HDR-style) histograms
+
+/// @namespace pcpp
+/// @brief The main namespace for the PcapPlusPlus lib
+namespace pcpp
+{
+	namespace internal
+	{
+		class AtomicTimingHistogram;
+	}
+
+	/// @class TimingHistogram
+	/// A log-linear histogram of non-negative integer values, in the spirit of HdrHistogram. Values below 16 have
+	/// their own bucket; above that every power of 2 range is split into 16 equal buckets, so a value is stored with
+	/// a relative error below 1/16 (6.25%) over the whole 64-bit range, in a fixed array of 976 counters
+	class TimingHistogram
+	{
+	public:
+		/// The number of bits of a value kept below its most significant bit
+		static constexpr uint32_t SubBucketBits = 4;
+		/// The number of buckets each power of 2 range is split into
+		static constexpr uint32_t SubBucketCount = 1 << SubBucketBits;
+		/// The total number of buckets
+		static constexpr size_t BucketCount = (64 - SubBucketBits + 1) * SubBucketCount;
+
+		/// A c'tor that creates an empty histogram
+		TimingHistogram()
+		{
+			reset();
+		}
+
+		/// Add a value to the histogram
+		/// @param[in] value The value to add
+		/// @param[in] count The number of times to add the value. The default is 1
+		void record(uint64_t value, uint64_t count = 1);
+
+		/// Add all values of another histogram to this one
+		/// @param[in] other The histogram to add
+		void merge(const TimingHistogram& other);
+
+		/// Remove all values
+		void reset();
+
+		/// @return The number of values in the histogram
+		uint64_t getCount() const
+		{
+			return m_Count;
+		}
+
+		/// @return The smallest value, or 0 if the histogram is empty
+		uint64_t getMin() const
+		{
+			return m_Count == 0 ? 0 : m_Min;
+		}
+
+		/// @return The largest value, or 0 if the histogram is empty
+		uint64_t getMax() const
+		{
+			return m_Max;
+		}
+
+		/// @return The sum of all values
+		uint64_t getSum() const
+		{
+			return m_Sum;
+		}
+
+		/// @return The average value, or 0 if the histogram is empty
+		double getMean() const
+		{
+			return m_Count == 0 ? 0 : static_cast<double>(m_Sum) / m_Count;
+		}
+
+		/// Get the value below which a given percentage of the values fall
+		/// @param[in] percentile The percentile, between 0 and 100
+		/// @return The highest value equivalent to the bucket holding the percentile (i.e. the result is at most
+		/// 6.25% above the exact value), capped by the maximum. 0 if the histogram is empty
+		uint64_t getValueAtPercentile(double percentile) const;
+
+		/// @return The counters of all buckets
+		const std::array<uint64_t, BucketCount>& getBuckets() const
+		{
+			return m_Buckets;
+		}
+
+		/// @param[in] value A value
+		/// @return The index of the bucket the value is counted in
+		static size_t getBucketIndex(uint64_t value)
+		{
+			if (value < SubBucketCount)
+				return static_cast<size_t>(value);
+
+			uint32_t msb = getMostSignificantBit(value);
+			uint32_t shift = msb - SubBucketBits;
+			return static_cast<size_t>((msb - SubBucketBits + 1) * SubBucketCount +
+			                           ((value >> shift) & (SubBucketCount - 1)));
+		}
+
+		/// @param[in] index A bucket index, smaller than BucketCount
+		/// @return The smallest value counted in the bucket
+		static uint64_t getBucketLowerBound(size_t index);
+
+		/// @param[in] index A bucket index, smaller than BucketCount
+		/// @return The largest value counted in the bucket
+		static uint64_t getBucketUpperBound(size_t index);
+
+	private:
+		friend class internal::AtomicTimingHistogram;
+
+		std::array<uint64_t, BucketCount> m_Buckets;
+		uint64_t m_Count;
+		uint64_t m_Min;
+		uint64_t m_Max;
+		uint64_t m_Sum;
+
+		static uint32_t getMostSignificantBit(uint64_t value)
+		{
+#if defined(_MSC_VER)
+			unsigned long index;
+			_BitScanReverse64(&index, value);
+			return static_cast<uint32_t>(index);
+#else
+			return 63 - static_cast<uint32_t>(__builtin_clzll(value));
+#endif
+		}
+	};
+
+	/// @struct CaptureTimingStats
+	/// A snapshot of the timing statistics of a live capture, merged from all capture threads. See
+	/// PcapLiveDevice#setCaptureTimingEnabled()
+	struct CaptureTimingStats
+	{
+		/// The time in nanoseconds from the packet timestamp to the moment the packet is handed to the user callback
+		/// (or, when capturing to a packet vector, stored in it). It's only meaningful when the timestamp comes from
+		/// the host clock (TimestampProvider::Host or HostHighPrecision); adapter clocks may be unsynchronized
+		TimingHistogram timestampToCallbackNs;
+		/// The time in nanoseconds the user callback ran. In batch mode a value is recorded per callback call, i.e.
+		/// per batch
+		TimingHistogram callbackDurationNs;
+		/// The number of packets each pcap_dispatch() round returned, including empty rounds (read timeouts)
+		TimingHistogram dispatchBatchSize;
+		/// The number of packets with a timestamp later than the host clock when they were handed to the user, which
+		/// usually means the timestamp source isn't synchronized with the host clock. They aren't added to
+		/// timestampToCallbackNs
+		uint64_t futureTimestampCount = 0;
+		/// The CPU time in nanoseconds used by the capture threads while they captured. Not available on Windows
+		uint64_t captureThreadCpuTimeNs = 0;
+		/// The number of capture threads the statistics were merged from
+		uint32_t threadCount = 0;
+	};
+
+	/// @cond PCPP_INTERNAL
+
+	namespace internal
+	{
+		/// @class AtomicTimingHistogram
+		/// A TimingHistogram written by one thread and read by others. Counters are relaxed atomics updated with a
+		/// plain load and store, which is as cheap as a non-atomic increment since there's a single writer
+		class AtomicTimingHistogram
+		{
+		public:
+			AtomicTimingHistogram()
+			{
+				reset();
+			}
+
+			void record(uint64_t value)
+			{
+				increment(m_Buckets[TimingHistogram::getBucketIndex(value)], 1);
+				increment(m_Sum, value);
+				if (value < m_Min.load(std::memory_order_relaxed))
+					m_Min.store(value, std::memory_order_relaxed);
+				if (value > m_Max.load(std::memory_order_relaxed))
+					m_Max.store(value, std::memory_order_relaxed);
+			}
+
+			void addTo(TimingHistogram& histogram) const;
+
+			void reset();
+
+		private:
+			std::array<std::atomic<uint64_t>, TimingHistogram::BucketCount> m_Buckets;
+			std::atomic<uint64_t> m_Min;
+			std::atomic<uint64_t> m_Max;
+			std::atomic<uint64_t> m_Sum;
+
+			static void increment(std::atomic<uint64_t>& counter, uint64_t value)
+			{
+				counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+			}
+		};
+
+		/// @class CaptureTimingRecorder
+		/// The timing statistics of one capture thread. Only that thread records values; any thread may read them
+		class CaptureTimingRecorder
+		{
+		public:
+			/// Whether packet timestamps hold nanoseconds (instead of microseconds) in their tv_usec field
+			bool timestampsInNanoseconds = false;
+
+			/// Mark the start of a capture loop on the calling thread, used to measure its CPU time
+			void beginCapture();
+
+			/// Record the result of a pcap_dispatch() round and update the CPU time of the thread
+			void recordDispatch(int result);
+
+			/// Record the timestamp latency of a packet about to be handed to the user
+			/// @return The time the callback starts, to pass to endCallback()
+			std::chrono::steady_clock::time_point beginCallback(const timeval& timestamp)
+			{
+				recordTimestamp(timestamp, std::chrono::system_clock::now());
+				return std::chrono::steady_clock::now();
+			}
+
+			/// Record the timestamp latency of a packet, relative to a given time
+			void recordTimestamp(const timeval& timestamp, std::chrono::system_clock::time_point now)
+			{
+				int64_t nowNs =
+				    std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count();
+				int64_t timestampNs = static_cast<int64_t>(timestamp.tv_sec) * 1000000000 +
+				                      static_cast<int64_t>(timestamp.tv_usec) * (timestampsInNanoseconds ? 1 : 1000);
+				if (nowNs >= timestampNs)
+					m_TimestampToCallback.record(static_cast<uint64_t>(nowNs - timestampNs));
+				else
+					m_FutureTimestampCount.store(m_FutureTimestampCount.load(std::memory_order_relaxed) + 1,
+					                             std::memory_order_relaxed);
+			}
+
+			/// Record the duration of a callback started at callbackStart
+			void endCallback(std::chrono::steady_clock::time_point callbackStart)
+			{
+				auto duration = std::chrono::steady_clock::now() - callbackStart;
+				m_CallbackDuration.record(
+				    static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count()));
+			}
+
+			/// Add the statistics to a snapshot
+			void addTo(CaptureTimingStats& stats) const;
+
+			/// Clear the statistics. When called while the thread records, values recorded at the same time may be
+			/// kept
+			void reset();
+
+		private:
+			AtomicTimingHistogram m_TimestampToCallback;
+			AtomicTimingHistogram m_CallbackDuration;
+			AtomicTimingHistogram m_DispatchBatchSize;
+			std::atomic<uint64_t> m_FutureTimestampCount{ 0 };
+			std::atomic<uint64_t> m_CpuTimeNs{ 0 };
+			// only used by the recording thread
+			uint64_t m_LastThreadCpuTime = 0;
+		};
+	}  // namespace internal
+
+	/// @endcond
+}  // namespace pcpp
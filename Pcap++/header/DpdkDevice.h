@@ -3,11 +3,13 @@
 // GCOVR_EXCL_START
 
 #include <time.h>
+#include <memory>
 #include <vector>
 #include "MacAddress.h"
 #include "SystemUtils.h"
 #include "Device.h"
 #include "MBufRawPacket.h"
+#include "Packet.h"
 
 /// @file
 /// This file and DpdkDeviceList.h provide PcapPlusPlus C++ wrapper for DPDK (stands for data-plan development kit).
@@ -71,6 +73,7 @@ namespace pcpp
 
 	class DpdkDeviceList;
 	class DpdkDevice;
+	class DpdkPacketBurst;
 
 	/// An enum describing all PMD (poll mode driver) types supported by DPDK. For more info about these PMDs please
 	/// visit the DPDK web-site
@@ -466,6 +469,15 @@ namespace pcpp
 		/// printed to log
 		uint16_t receivePackets(Packet** packetsArr, uint16_t packetsArrLength, uint16_t rxQueueId) const;
 
+		/// Receive a burst of packets into a DpdkPacketBurst. The MBufRawPacket and Packet objects of the burst are
+		/// rebound to the received mbufs instead of being constructed, and the mbufs of the previous burst received
+		/// into it are freed first, so receiving in a loop into the same burst object allocates nothing
+		/// @param[in,out] burst The burst to receive into. Up to DpdkPacketBurst#getCapacity() packets are received
+		/// @param[in] rxQueueId The RX queue to receive packets from
+		/// @return The number of packets received. If an error occurred 0 will be returned and the error will be
+		/// printed to log
+		uint16_t receivePackets(DpdkPacketBurst& burst, uint16_t rxQueueId) const;
+
 		/// Send an array of MBufRawPacket to the network. Please notice the following:<BR>
 		/// - In terms of performance, this is the best method to use for sending packets because out of all sendPackets
 		///   overloads this method requires the least overhead and is almost as efficient as sending the packets
@@ -802,6 +814,83 @@ namespace pcpp
 		mutable DpdkDeviceStats m_PrevStats;
 	};
 
+	/// @class DpdkPacketBurst
+	/// A fixed set of MBufRawPacket and Packet objects owned by the user and reused for every burst received by
+	/// DpdkDevice#receivePackets(DpdkPacketBurst&, uint16_t). Receiving a burst rebinds the objects to the new mbufs
+	/// (and optionally parses the packets) without constructing or destructing them. The mbufs of a burst are freed
+	/// when the next burst is received into the same object, when release() is called or when the object is
+	/// destroyed. A packet whose mbuf was passed to one of the DpdkDevice#sendPackets() methods isn't freed twice.
+	/// This class isn't thread-safe: a burst should be used by a single thread, typically one per RX queue
+	class DpdkPacketBurst
+	{
+		friend class DpdkDevice;
+
+	public:
+		/// A c'tor for this class. If capacity is 0 an error is printed to log and the burst has no packet objects;
+		/// DpdkDevice#receivePackets(DpdkPacketBurst&, uint16_t) rejects it
+		/// @param[in] capacity The maximum number of packets in a burst. The default is 64
+		/// @param[in] parsePackets If true, the Packet objects are parsed on every received burst. Otherwise only the
+		/// MBufRawPacket objects are bound and getPacket() shouldn't be used. The default is true
+		/// @param[in] parseUntilLayer If packets are parsed, parse only up to this OSI layer. The default is to parse
+		/// all layers
+		explicit DpdkPacketBurst(uint16_t capacity = 64, bool parsePackets = true,
+		                         OsiModelLayer parseUntilLayer = OsiModelLayerUnknown);
+
+		/// A d'tor for this class. Frees the mbufs of the current burst
+		~DpdkPacketBurst();
+
+		DpdkPacketBurst(const DpdkPacketBurst&) = delete;
+		DpdkPacketBurst& operator=(const DpdkPacketBurst&) = delete;
+
+		/// @return The maximum number of packets in a burst
+		uint16_t getCapacity() const
+		{
+			return m_Capacity;
+		}
+
+		/// @return The number of packets in the current burst
+		uint16_t size() const
+		{
+			return m_Count;
+		}
+
+		/// @return The raw packets of the current burst, an array of size() objects. This is the same layout as the
+		/// array passed to OnDpdkPacketsArriveCallback
+		MBufRawPacket* getRawPackets()
+		{
+			return m_RawPackets.get();
+		}
+
+		/// @param[in] index The index of a packet, lower than size()
+		/// @return The raw packet at this index
+		MBufRawPacket& getRawPacket(uint16_t index)
+		{
+			return m_RawPackets[index];
+		}
+
+		/// @param[in] index The index of a packet, lower than size()
+		/// @return The parsed packet at this index. Only valid if the burst was created with parsePackets set to true
+		Packet& getPacket(uint16_t index)
+		{
+			return m_Packets[index];
+		}
+
+		/// Free the mbufs of the current burst. The packets of the burst must not be used afterwards
+		void release();
+
+	private:
+		uint16_t m_Capacity;
+		uint16_t m_Count;
+		bool m_ParsePackets;
+		OsiModelLayer m_ParseUntilLayer;
+		std::unique_ptr<rte_mbuf*[]> m_MBufs;
+		std::unique_ptr<MBufRawPacket[]> m_RawPackets;
+		// declared after the raw packets so it's destroyed before them
+		std::unique_ptr<Packet[]> m_Packets;
+
+		void bind(uint16_t count, timespec timestamp);
+	};
+
 }  // namespace pcpp
 
 // GCOVR_EXCL_STOP
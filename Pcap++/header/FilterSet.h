@@ -0,0 +1,153 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+#include "NativeFilter.h"
+#include "PcapFilter.h"
+
+/// @file
+/// A set of many filters (rules) which are matched together against each packet. Instead of running every filter,
+/// the rules are indexed by their most selective field in hash tables and prefix tries, so the cost of matching a
+/// packet depends on the number of rules that could match it rather than on the total number of rules
+
+/// @namespace pcpp
+/// @brief The main namespace for the PcapPlusPlus lib
+namespace pcpp
+{
+	/// @cond PCPP_INTERNAL
+
+	namespace internal
+	{
+		/// @class PrefixTrie
+		/// A binary trie mapping bit prefixes of a big-endian key to rule IDs. A lookup returns the rules of all
+		/// prefixes of the key, i.e. every stored prefix the key falls in
+		class PrefixTrie
+		{
+		public:
+			PrefixTrie();
+
+			/// Add a rule under a prefix
+			/// @param[in] key The prefix bytes, most significant bit first
+			/// @param[in] prefixLength The number of significant bits in key
+			/// @param[in] ruleId The rule to store
+			void insert(const uint8_t* key, uint32_t prefixLength, uint32_t ruleId);
+
+			/// Call a function for each rule stored under a prefix of the key
+			/// @param[in] key The key bytes, most significant bit first
+			/// @param[in] keyLength The number of bits in key
+			/// @param[in] callback A function which is called with each rule ID
+			template <typename Callback> void lookup(const uint8_t* key, uint32_t keyLength, Callback&& callback) const
+			{
+				uint32_t nodeIndex = 0;
+				for (uint32_t bit = 0;; ++bit)
+				{
+					const Node& node = m_Nodes[nodeIndex];
+					for (uint32_t ruleId : node.rules)
+						callback(ruleId);
+
+					if (bit == keyLength)
+						break;
+
+					nodeIndex = node.children[(key[bit / 8] >> (7 - bit % 8)) & 1];
+					if (nodeIndex == 0)
+						break;
+				}
+			}
+
+			/// @return True if no rule was inserted
+			bool isEmpty() const
+			{
+				return m_RuleCount == 0;
+			}
+
+			/// Remove all rules
+			void clear();
+
+		private:
+			struct Node
+			{
+				// 0 means no child, the root is never a child
+				uint32_t children[2] = { 0, 0 };
+				std::vector<uint32_t> rules;
+			};
+
+			std::vector<Node> m_Nodes;
+			size_t m_RuleCount;
+		};
+	}  // namespace internal
+
+	/// @endcond
+
+	/// @class FilterSet
+	/// A set of filters, each identified by the index it was added with, which are matched together against a packet.
+	/// The result is the set of rules that match.
+	///
+	/// Filters are compiled to NativeFilter programs. Each rule is indexed by the necessary condition which fixes the
+	/// most packet bits: an exact IPv4 address or port goes to a hash table, an IP network to a prefix trie and a port
+	/// range to a port trie (the range is split into aligned prefix blocks). Matching a packet extracts its
+	/// FilterFlowKey once, looks up its addresses and ports in these structures and fully evaluates only the
+	/// candidate rules found, plus the rules that couldn't be indexed (for example a NotFilter or an OrFilter at the
+	/// top level). Filters that can't be evaluated natively, such as a BPFStringFilter, are compiled with libpcap and
+	/// run on every packet.
+	///
+	/// Native rules follow the semantics described in FilterFlowKey. A FilterSet isn't modified by matching, so it can
+	/// be used concurrently from multiple threads as long as no filters are added at the same time
+	class FilterSet
+	{
+	public:
+		/// A c'tor that creates an empty filter set
+		/// @param[in] bpfLinkType The link type to compile filters which can't be evaluated natively for. Packets of
+		/// other link types never match these filters. The default value is Ethernet
+		explicit FilterSet(LinkLayerType bpfLinkType = LINKTYPE_ETHERNET);
+
+		/// Add a filter to the set. Changes made to the filter object after it was added don't affect the set
+		/// @param[in] filter The filter to add
+		/// @return The index of the new rule, which is the number of rules added before it, or -1 if the filter is
+		/// invalid. In that case the rule isn't added and an error is printed to log
+		int addFilter(GeneralFilter& filter);
+
+		/// @return The number of rules in the set
+		size_t getRuleCount() const
+		{
+			return m_NativeFilters.size();
+		}
+
+		/// @return The number of rules which are evaluated for every packet because they couldn't be indexed,
+		/// including the rules which are evaluated with BPF
+		size_t getUnindexedRuleCount() const
+		{
+			return m_UnindexedRules.size() + m_BpfRules.size();
+		}
+
+		/// Match a packet with all rules
+		/// @param[in] rawPacket The packet to match
+		/// @param[out] matchingRules Resized to the number of rules. An element is set to true if the rule with the
+		/// same index matches the packet and false otherwise
+		/// @return The number of matching rules
+		size_t matchPacket(const RawPacket* rawPacket, std::vector<bool>& matchingRules) const;
+
+		/// Remove all rules
+		void clear();
+
+	private:
+		struct BpfRule
+		{
+			uint32_t ruleId;
+			CompiledBpfFilter filter;
+		};
+
+		LinkLayerType m_BpfLinkType;
+		std::vector<NativeFilter> m_NativeFilters;
+		std::vector<BpfRule> m_BpfRules;
+		std::vector<uint32_t> m_UnindexedRules;
+		std::unordered_map<uint32_t, std::vector<uint32_t>> m_IPv4AddressRules;
+		std::unordered_map<uint16_t, std::vector<uint32_t>> m_PortRules;
+		internal::PrefixTrie m_IPv4NetworkRules;
+		internal::PrefixTrie m_IPv6NetworkRules;
+		internal::PrefixTrie m_PortRangeRules;
+
+		void indexRule(uint32_t ruleId);
+	};
+}  // namespace pcpp
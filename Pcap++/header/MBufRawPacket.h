@@ -58,6 +58,10 @@ namespace pcpp
 		bool init(struct rte_mempool* mempool);
 		bool initFromRawPacket(const RawPacket* rawPacket, struct rte_mempool* mempool);
 
+	private:
+		// append to or remove from the mbuf data so it's newDataLen bytes long, and point the raw data to it
+		bool resizeMBufData(int newDataLen);
+
 	public:
 		/// A default c'tor for this class. Constructs an instance of this class without an mbuf attached to it. In
 		/// order to allocate an mbuf the user should call the init() method. Without calling init() the instance of
@@ -200,6 +204,14 @@ namespace pcpp
 		/// @return True if new size is larger than current size but smaller than mbuf max size, false otherwise
 		bool reallocateData(size_t newBufferLength);
 
+		/// This overridden method, in contrast to its ancestor RawPacket#reset(), keeps the mbuf already attached and
+		/// only changes its data length to the requested capacity
+		/// @param[in] capacity The buffer length needed
+		/// @return True if the data length was changed, false if MBufRawPacket is not initialized (mbuf is nullptr),
+		/// capacity is larger than mbuf max size or resizing the mbuf failed. In all of these cases an error is printed
+		/// to log
+		bool reset(size_t capacity) override;
+
 		/// Set an indication whether to free the mbuf when done using it or not ("done using it" means setting another
 		/// mbuf or class d'tor). Default value is true.
 		/// @param[in] val The value to set. True means free the mbuf when done using it. Default it True
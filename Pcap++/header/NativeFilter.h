@@ -0,0 +1,227 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+#include "RawPacket.h"
+
+/// @file
+/// A native evaluator for the GeneralFilter class hierarchy. Instead of converting a filter to a BPF string and
+/// running it with libpcap, the filter object tree is compiled into a flat vector of instructions which are evaluated
+/// against a FilterFlowKey: a small structure holding the packet fields filters look at (addresses, ports, protocol,
+/// EtherType, VLAN ID, etc.). The key is extracted once per packet, so many filters can be matched against the same
+/// packet at the cost of one header walk
+
+/// @namespace pcpp
+/// @brief The main namespace for the PcapPlusPlus lib
+namespace pcpp
+{
+	// Forward Declaration - the filters are defined in PcapFilter.h
+	class GeneralFilter;
+
+	/// @struct FilterFlowKey
+	/// The packet fields NativeFilter instructions are evaluated against. The link layer (Ethernet, Linux cooked
+	/// capture or raw IP), VLAN tags, the IPv4 / IPv6 header and the TCP / UDP / SCTP header are parsed directly from
+	/// the packet data, without creating Packet++ layers.
+	///
+	/// Unlike BPF, where "ip", "tcp" or "port" only look past VLAN tags after a "vlan" keyword, the network and
+	/// transport fields are extracted after skipping all VLAN tags, the same way Packet++ parses the packet. As in BPF,
+	/// IPv6 extension headers aren't skipped, other encapsulations such as MPLS or PPPoE aren't parsed and the ports of
+	/// IPv4 fragments other than the first aren't available
+	struct FilterFlowKey
+	{
+		/// The layers found in the packet
+		enum Flags : uint32_t
+		{
+			/// The packet has an Ethernet header, srcMac and dstMac are set
+			HasEthernet = 0x01,
+			/// The packet has at least one VLAN tag, vlanId is set
+			HasVlan = 0x02,
+			/// The packet has an ARP header, arpOpcode is set
+			HasArp = 0x04,
+			/// The packet has an IPv4 header, the IPv4 fields and ipProtocol are set
+			HasIPv4 = 0x08,
+			/// The packet has an IPv6 header, the IPv6 fields and ipProtocol are set
+			HasIPv6 = 0x10,
+			/// The transport header was captured and srcPort and dstPort are set. This flag is set for TCP, UDP and
+			/// SCTP, except for IPv4 fragments other than the first
+			HasPorts = 0x20,
+			/// The link layer has an EtherType (Ethernet or Linux cooked capture) or it's raw IP, etherType is set
+			HasEtherType = 0x40
+		};
+
+		/// A combination of Flags values
+		uint32_t flags = 0;
+		/// The EtherType of the link layer (for Linux cooked capture, the protocol type field). For raw IP link types
+		/// it's derived from the IP version
+		uint16_t etherType = 0;
+		/// The EtherType after all VLAN tags. Equals etherType when the packet has no VLAN tags
+		uint16_t networkEtherType = 0;
+		/// The VLAN ID of the outermost VLAN tag
+		uint16_t vlanId = 0;
+		/// The ARP opcode
+		uint16_t arpOpcode = 0;
+		/// The Ethernet source MAC address
+		uint8_t srcMac[6] = {};
+		/// The Ethernet destination MAC address
+		uint8_t dstMac[6] = {};
+		/// The IPv4 protocol or the IPv6 next header
+		uint8_t ipProtocol = 0;
+		/// The TCP flags byte (TCP only)
+		uint8_t tcpFlags = 0;
+		/// The IPv4 ID
+		uint16_t ipId = 0;
+		/// The IPv4 total length
+		uint16_t ipTotalLength = 0;
+		/// The IPv4 source address in host byte order
+		uint32_t srcIPv4 = 0;
+		/// The IPv4 destination address in host byte order
+		uint32_t dstIPv4 = 0;
+		/// The IPv6 source address
+		uint8_t srcIPv6[16] = {};
+		/// The IPv6 destination address
+		uint8_t dstIPv6[16] = {};
+		/// The transport source port
+		uint16_t srcPort = 0;
+		/// The transport destination port
+		uint16_t dstPort = 0;
+		/// The TCP window size (TCP only)
+		uint16_t tcpWindowSize = 0;
+		/// The UDP length (UDP only)
+		uint16_t udpLength = 0;
+		/// The number of transport header bytes available in the packet
+		uint32_t transportCapturedLength = 0;
+
+		/// Extract the key from packet data. All fields are reset first
+		/// @param[in] data A pointer to the packet data
+		/// @param[in] dataLen The packet data length
+		/// @param[in] linkType The packet link type. Ethernet, Linux cooked capture and the raw IP link types are
+		/// supported; for other link types flags is 0
+		void extract(const uint8_t* data, size_t dataLen, LinkLayerType linkType);
+
+		/// Extract the key from a raw packet. All fields are reset first
+		/// @param[in] rawPacket The packet to extract the key from
+		void extract(const RawPacket* rawPacket)
+		{
+			extract(rawPacket->getRawData(), rawPacket->getRawDataLen(), rawPacket->getLinkLayerType());
+		}
+	};
+
+	/// @class NativeFilter
+	/// A GeneralFilter compiled into a flat instruction vector which is evaluated against a FilterFlowKey without
+	/// libpcap. The instructions are in postfix order: each predicate pushes its result on a bit stack and the
+	/// LogicalAnd, LogicalOr and LogicalNot instructions combine the results on top of it. A compiled filter is
+	/// immutable, so it can be used concurrently by multiple threads.
+	///
+	/// Filters which can't be expressed natively (BPFStringFilter with a non-empty string or user-defined filter
+	/// classes) make the NativeFilter invalid; such filters should be matched with CompiledBpfFilter instead.
+	/// Please note the VLAN semantics described in FilterFlowKey
+	class NativeFilter
+	{
+	public:
+		/// The instruction opcodes
+		enum Opcode : uint8_t
+		{
+			/// Push true
+			MatchAll,
+			/// IPv4 address in a network: direction, bytes[0..3] is the network, value is the prefix length
+			MatchIPv4Network,
+			/// IPv6 address in a network: direction, bytes is the network, value is the prefix length
+			MatchIPv6Network,
+			/// IPv4 ID compared to value with the operator
+			MatchIPv4Id,
+			/// IPv4 total length compared to value with the operator
+			MatchIPv4TotalLength,
+			/// TCP, UDP or SCTP port in the direction equals value
+			MatchPort,
+			/// TCP, UDP or SCTP port in the direction is within [value, value2]
+			MatchPortRange,
+			/// Ethernet MAC address in the direction equals bytes[0..5]
+			MatchMacAddress,
+			/// The link layer EtherType equals value
+			MatchEtherType,
+			/// The packet contains the protocol in value: one of the ProtocolType values supported by ProtoFilter
+			MatchProtocol,
+			/// The low byte of the ARP opcode equals value
+			MatchArpOpcode,
+			/// The outermost VLAN ID equals value
+			MatchVlanId,
+			/// The TCP flags of an IPv4 packet masked with value equal value (if value2 is 0) or are non-zero
+			/// (if value2 is 1)
+			MatchTcpFlags,
+			/// The TCP window size of an IPv4 packet compared to value with the operator
+			MatchTcpWindowSize,
+			/// The UDP length of an IPv4 packet compared to value with the operator
+			MatchUdpLength,
+			/// Pop two results and push their logical AND
+			LogicalAnd,
+			/// Pop two results and push their logical OR
+			LogicalOr,
+			/// Invert the result on top of the stack
+			LogicalNot
+		};
+
+		/// A single instruction
+		struct Instruction
+		{
+			/// The instruction opcode
+			Opcode opcode = MatchAll;
+			/// A Direction value for address and port instructions, a FilterOperator value for comparisons
+			uint8_t modifier = 0;
+			/// The first operand
+			uint32_t value = 0;
+			/// The second operand
+			uint32_t value2 = 0;
+			/// An IPv4 / IPv6 network or a MAC address
+			uint8_t bytes[16] = {};
+		};
+
+		/// The maximum nesting depth of a filter tree that can be compiled
+		static constexpr size_t MaxStackDepth = 64;
+
+		/// A c'tor that creates an invalid filter which matches no packet
+		NativeFilter() : m_IsValid(false)
+		{}
+
+		/// A c'tor that compiles a filter object tree. Use isValid() to check whether compilation succeeded. Changes
+		/// made to the filter objects after compilation don't affect the compiled filter
+		/// @param[in] filter The filter to compile
+		explicit NativeFilter(const GeneralFilter& filter);
+
+		/// @return True if the filter was compiled successfully, false otherwise
+		bool isValid() const
+		{
+			return m_IsValid;
+		}
+
+		/// @return The compiled instructions
+		const std::vector<Instruction>& getInstructions() const
+		{
+			return m_Instructions;
+		}
+
+		/// Match a pre-extracted flow key with the filter
+		/// @param[in] key The key to match
+		/// @return True if the filter matches, false if it doesn't or the filter is invalid
+		bool matches(const FilterFlowKey& key) const;
+
+		/// Extract the flow key of a raw packet and match it with the filter. When several filters are matched
+		/// against the same packet, extract the key once and use matches(const FilterFlowKey&) instead
+		/// @param[in] rawPacket The packet to match
+		/// @return True if the filter matches, false if it doesn't or the filter is invalid
+		bool matches(const RawPacket* rawPacket) const;
+
+		/// Append an instruction to the program. Used by GeneralFilter#appendToNativeFilter() implementations
+		/// @param[in] instruction The instruction to append
+		void appendInstruction(const Instruction& instruction)
+		{
+			m_Instructions.push_back(instruction);
+		}
+
+	private:
+		std::vector<Instruction> m_Instructions;
+		bool m_IsValid;
+
+		bool validate() const;
+	};
+}  // namespace pcpp
@@ -235,11 +235,14 @@ namespace pcpp
 	private:
 		internal::LightPcapNgHandle* m_LightPcapNg;
 		BpfFilterWrapper m_BpfWrapper;
+		bool m_ZeroCopyMode;
 
 		// private copy c'tor
 		PcapNgFileReaderDevice(const PcapNgFileReaderDevice& other);
 		PcapNgFileReaderDevice& operator=(const PcapNgFileReaderDevice& other);
 
+		bool readNextPacket(RawPacket& rawPacket, std::string* packetComment);
+
 	public:
 		/// A constructor for this class that gets the pcap-ng full path file name to open. Notice that after calling
 		/// this constructor the file isn't opened yet, so reading packets will fail. For opening the file call open()
@@ -298,6 +301,24 @@ namespace pcpp
 		/// for some reason (for example: file path does not exist)
 		bool open();
 
+		/// Enable or disable zero-copy reading. The file is always read in large chunks and its blocks are parsed in
+		/// place. By default the data of every packet read is then copied to a buffer owned by the RawPacket. In
+		/// zero-copy mode the RawPacket doesn't own its data, which points into the chunk, and is only valid until
+		/// the next packet is read or the device is closed. Use clone() to keep a packet longer. getNextPackets()
+		/// keeps the packets it reads, so it always copies them, even in this mode. A RawPacket filled in zero-copy
+		/// mode may be reused to read packets after the mode is disabled: it owns the copies again
+		/// @param[in] enabled True to enable zero-copy reading, false to copy every packet (the default)
+		void setZeroCopyMode(bool enabled)
+		{
+			m_ZeroCopyMode = enabled;
+		}
+
+		/// @return True if zero-copy reading is enabled. See setZeroCopyMode()
+		bool isZeroCopyMode() const
+		{
+			return m_ZeroCopyMode;
+		}
+
 		/// Get statistics of packets read so far.
 		/// @param[out] stats The stats struct where stats are returned
 		void getStatistics(PcapStats& stats) const;
@@ -443,6 +464,8 @@ namespace pcpp
 	private:
 		internal::LightPcapNgHandle* m_LightPcapNg;
 		int m_CompressionLevel;
+		int m_CompressionWorkerCount;
+		size_t m_CompressionFrameSize;
 		BpfFilterWrapper m_BpfWrapper;
 
 		// private copy c'tor
@@ -492,6 +515,40 @@ namespace pcpp
 		/// the file
 		bool writePackets(const RawPacketVector& packets) override;
 
+		/// Set the number of threads which compress the file in the background, so the writing thread only hands
+		/// them the data. Only relevant for compressed files (a non-zero compression level and a .zst/.zstd file
+		/// extension). If the zstd library was built without multithreading support the file is compressed on the
+		/// writing thread. Takes effect the next time the file is opened for writing
+		/// @param[in] workerCount The number of compression threads, 0 (the default) compresses on the writing thread
+		void setCompressionWorkerCount(int workerCount)
+		{
+			m_CompressionWorkerCount = workerCount;
+		}
+
+		/// @return The number of compression threads. See setCompressionWorkerCount()
+		int getCompressionWorkerCount() const
+		{
+			return m_CompressionWorkerCount;
+		}
+
+		/// Split a compressed file into independent zstd frames and end it with a seek table in the zstd seekable
+		/// format, so tools supporting that format can decompress any part of the file without decompressing what
+		/// comes before it. Smaller frames make seeking cheaper but compress less well, and worker threads only
+		/// compress a frame in parallel if it's several MB long. Takes effect the next time the file is opened for
+		/// writing
+		/// @param[in] frameSize The uncompressed size of each frame in bytes, up to 1GB. 0 (the default) writes the
+		/// whole file as a single frame
+		void setCompressionFrameSize(size_t frameSize)
+		{
+			m_CompressionFrameSize = frameSize;
+		}
+
+		/// @return The uncompressed size of each frame of a compressed file. See setCompressionFrameSize()
+		size_t getCompressionFrameSize() const
+		{
+			return m_CompressionFrameSize;
+		}
+
 		/// Open the file in a write mode. If file doesn't exist, it will be created. If it does exist it will be
 		/// overwritten, meaning all its current content will be deleted
 		/// @return True if file was opened/created successfully or if file is already opened. False if opening the file
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <bitset>
 #include <string>
 #include <vector>
 #include <memory>
@@ -7,6 +8,7 @@
 #include <stdint.h>
 #include "ArpLayer.h"
 #include "RawPacket.h"
+#include "BpfThreadedProgram.h"
 
 // Forward Declaration - used in GeneralFilter
 struct bpf_program;
@@ -35,6 +37,7 @@ namespace pcpp
 {
 	// Forward Declaration - used in GeneralFilter
 	class RawPacket;
+	class NativeFilter;
 
 	/// An enum that contains direction (source or destination)
 	typedef enum
@@ -75,15 +78,21 @@ namespace pcpp
 	}  // namespace internal
 
 	/// @class BpfFilterWrapper
-	/// A wrapper class for BPF filtering. Enables setting a BPF filter and matching it against a packet
+	/// A wrapper class for BPF filtering. Enables setting a BPF filter and matching it against a packet.
+	/// By default packets are matched by libpcap's BPF interpreter. When threaded code is enabled with
+	/// setThreadedCodeEnabled(), the compiled filter is also translated by BpfThreadedProgram, which matches packets
+	/// faster. Filters the translator doesn't support are still matched by the interpreter
 	class BpfFilterWrapper
 	{
 	private:
 		std::string m_FilterStr;
 		LinkLayerType m_LinkType;
 		std::unique_ptr<bpf_program, internal::BpfProgramDeleter> m_Program;
+		std::unique_ptr<BpfThreadedProgram> m_ThreadedProgram;
+		bool m_UseThreadedCode;
 
 		void freeProgram();
+		void translateProgram();
 
 	public:
 		/// A c'tor for this class
@@ -124,6 +133,113 @@ namespace pcpp
 		/// could not be compiled
 		bool matchPacketWithFilter(const uint8_t* packetData, uint32_t packetDataLength, timespec packetTimestamp,
 		                           uint16_t linkType);
+
+		/// Enable or disable matching packets with threaded code instead of libpcap's BPF interpreter. If a filter
+		/// is already set it's translated right away, otherwise it's translated by the next call to setFilter().
+		/// Threaded code is disabled by default
+		/// @param[in] enabled True to enable threaded code, false to use the interpreter
+		void setThreadedCodeEnabled(bool enabled);
+
+		/// @return True if threaded code was enabled with setThreadedCodeEnabled(), false otherwise
+		bool isThreadedCodeEnabled() const
+		{
+			return m_UseThreadedCode;
+		}
+
+		/// @return True if the current filter is matched with threaded code, false if it's matched by the
+		/// interpreter. The interpreter is used when threaded code is disabled, no filter is set or the filter
+		/// couldn't be translated
+		bool isThreadedCodeActive() const
+		{
+			return m_ThreadedProgram != nullptr;
+		}
+	};
+
+	/// @class CompiledBpfFilter
+	/// An immutable BPF filter compiled once for a specific link type. Unlike BpfFilterWrapper, matching a packet never
+	/// re-compiles or copies the filter and doesn't allocate memory, and all match methods are const. Copies of this
+	/// object share the same compiled program, so one instance can be created up front and used concurrently by
+	/// several threads. Packets whose link type differs from the one the filter was compiled for never match.
+	/// Please note that compiling a filter (the constructor) isn't thread-safe in libpcap versions older than 1.8
+	class CompiledBpfFilter
+	{
+	private:
+		std::string m_FilterStr;
+		LinkLayerType m_LinkType;
+		std::shared_ptr<const bpf_program> m_Program;
+		bool m_IsValid;
+
+	public:
+		/// A c'tor that creates an empty filter which matches all packets
+		CompiledBpfFilter();
+
+		/// A c'tor that compiles a filter in BPF syntax for a specific link type. Use isValid() to check whether
+		/// compilation succeeded
+		/// @param[in] filter A filter in BPF syntax. An empty string creates a filter which matches all packets
+		/// @param[in] linkType The link type of the packets the filter will be matched against. The default is
+		/// LINKTYPE_ETHERNET
+		explicit CompiledBpfFilter(const std::string& filter, LinkLayerType linkType = LINKTYPE_ETHERNET);
+
+		/// @return True if the filter was compiled successfully, false otherwise. An invalid filter matches no packet
+		bool isValid() const
+		{
+			return m_IsValid;
+		}
+
+		/// @return The filter in BPF syntax this object was created with
+		const std::string& getFilter() const
+		{
+			return m_FilterStr;
+		}
+
+		/// @return The link type the filter was compiled for
+		LinkLayerType getLinkType() const
+		{
+			return m_LinkType;
+		}
+
+		/// Match a raw packet with the filter
+		/// @param[in] rawPacket A pointer to the raw packet to match
+		/// @return True if the filter matches the packet (or if it's empty). False if the packet doesn't match, if its
+		/// link type is different than the filter's link type or if the filter is invalid
+		bool matches(const RawPacket* rawPacket) const;
+
+		/// Match packet data with the filter. The data is assumed to be of the filter's link type
+		/// @param[in] packetData A byte stream containing the packet data
+		/// @param[in] packetDataLength The length in [bytes] of the byte stream
+		/// @return True if the filter matches the packet (or if it's empty), false otherwise
+		bool matches(const uint8_t* packetData, uint32_t packetDataLength) const;
+
+		/// Match a batch of raw packets with the filter
+		/// @param[in] rawPackets An array of pointers to raw packets
+		/// @param[in] count The number of packets in the array
+		/// @param[out] results An array of at least count elements. Each element is set to the match result of the
+		/// packet with the same index
+		/// @return The number of packets that matched the filter
+		size_t matchPackets(const RawPacket* const rawPackets[], size_t count, bool results[]) const;
+
+		/// Match a batch of raw packets with the filter and store the results in a bitset
+		/// @param[in] rawPackets An array of pointers to raw packets
+		/// @param[in] count The number of packets in the array. Packets beyond the size of the bitset aren't matched
+		/// @param[out] results A bitset in which bit i is set if packet i matched the filter. Bits which don't
+		/// correspond to a packet are cleared
+		/// @return The number of packets that matched the filter
+		template <size_t N>
+		size_t matchPackets(const RawPacket* const rawPackets[], size_t count, std::bitset<N>& results) const
+		{
+			results.reset();
+			size_t matchCount = 0;
+			for (size_t i = 0; i < count && i < N; ++i)
+			{
+				if (matches(rawPackets[i]))
+				{
+					results.set(i);
+					++matchCount;
+				}
+			}
+
+			return matchCount;
+		}
 	};
 
 	/// @class GeneralFilter
@@ -146,6 +262,25 @@ namespace pcpp
 		/// @return True if a raw packet matches the BPF filter or false otherwise
 		bool matchPacketWithFilter(RawPacket* rawPacket);
 
+		/// Compile the filter into an immutable CompiledBpfFilter. Use it instead of matchPacketWithFilter() when the
+		/// same filter is matched against many packets, since matchPacketWithFilter() converts the filter to a BPF
+		/// string on every call. Changes made to this filter after compilation don't affect the compiled filter
+		/// @param[in] linkType The link type of the packets the filter will be matched against. The default is
+		/// LINKTYPE_ETHERNET
+		/// @return The compiled filter. Use CompiledBpfFilter#isValid() to check whether compilation succeeded
+		CompiledBpfFilter compile(LinkLayerType linkType = LINKTYPE_ETHERNET);
+
+		/// Append the instructions evaluating this filter to a NativeFilter program. This method is called by the
+		/// NativeFilter constructor, there's no need to call it directly. Filter classes which can't be evaluated
+		/// natively don't override it
+		/// @param[in,out] nativeFilter The program to append the instructions to
+		/// @return True if the filter was appended, false if it can't be evaluated natively
+		virtual bool appendToNativeFilter(NativeFilter& nativeFilter) const
+		{
+			(void)nativeFilter;
+			return false;
+		}
+
 		GeneralFilter()
 		{}
 
@@ -172,6 +307,8 @@ namespace pcpp
 		/// content will be overridden If the filter is not valid the result will be an empty string
 		void parseToString(std::string& result) override;
 
+		bool appendToNativeFilter(NativeFilter& nativeFilter) const override;
+
 		/// Verify the filter is valid
 		/// @return True if the filter is valid or false otherwise
 		bool verifyFilter();
@@ -326,6 +463,8 @@ namespace pcpp
 
 		void parseToString(std::string& result) override;
 
+		bool appendToNativeFilter(NativeFilter& nativeFilter) const override;
+
 		/// Set the network to build the filter with.
 		/// @param[in] network The IP Network object to be used when building the filter.
 		void setNetwork(const IPNetwork& network)
@@ -413,6 +552,8 @@ namespace pcpp
 
 		void parseToString(std::string& result) override;
 
+		bool appendToNativeFilter(NativeFilter& nativeFilter) const override;
+
 		/// Set the IP ID to filter
 		/// @param[in] ipID The IP ID to filter
 		void setIpID(uint16_t ipID)
@@ -441,6 +582,8 @@ namespace pcpp
 
 		void parseToString(std::string& result) override;
 
+		bool appendToNativeFilter(NativeFilter& nativeFilter) const override;
+
 		/// Set the total length value
 		/// @param[in] totalLength The total length value to filter
 		void setTotalLength(uint16_t totalLength)
@@ -467,6 +610,8 @@ namespace pcpp
 
 		void parseToString(std::string& result) override;
 
+		bool appendToNativeFilter(NativeFilter& nativeFilter) const override;
+
 		/// Set the port
 		/// @param[in] port The port to create the filter with
 		void setPort(uint16_t port)
@@ -498,6 +643,8 @@ namespace pcpp
 
 		void parseToString(std::string& result) override;
 
+		bool appendToNativeFilter(NativeFilter& nativeFilter) const override;
+
 		/// Set the lower end of the port range
 		/// @param[in] fromPort The lower end of the port range
 		void setFromPort(uint16_t fromPort)
@@ -532,6 +679,8 @@ namespace pcpp
 
 		void parseToString(std::string& result) override;
 
+		bool appendToNativeFilter(NativeFilter& nativeFilter) const override;
+
 		/// Set the MAC address
 		/// @param[in] address The MAC address to use for filtering
 		void setMacAddress(MacAddress address)
@@ -558,6 +707,8 @@ namespace pcpp
 
 		void parseToString(std::string& result) override;
 
+		bool appendToNativeFilter(NativeFilter& nativeFilter) const override;
+
 		/// Set the EtherType value
 		/// @param[in] etherType The EtherType value to create the filter with
 		void setEtherType(uint16_t etherType)
@@ -576,6 +727,12 @@ namespace pcpp
 	protected:
 		std::vector<GeneralFilter*> m_FilterList;
 
+		/// Append the child filters to a NativeFilter program, combined with logical AND or OR
+		/// @param[in,out] nativeFilter The program to append the instructions to
+		/// @param[in] isAnd True to combine the child filters with AND, false to combine them with OR
+		/// @return True if all child filters were appended, false otherwise
+		bool appendChildrenToNativeFilter(NativeFilter& nativeFilter, bool isAnd) const;
+
 	public:
 		/// An empty constructor for this class. Use addFilter() to add filters to the composite filter.
 		CompositeFilter() = default;
@@ -656,6 +813,11 @@ namespace pcpp
 				}
 			}
 		}
+
+		bool appendToNativeFilter(NativeFilter& nativeFilter) const override
+		{
+			return appendChildrenToNativeFilter(nativeFilter, op == CompositeLogicFilterOp::AND);
+		}
 	};
 
 	/// A class for connecting several filters into one filter with logical "and" between them. For example: if the 2
@@ -695,6 +857,8 @@ namespace pcpp
 
 		void parseToString(std::string& result) override;
 
+		bool appendToNativeFilter(NativeFilter& nativeFilter) const override;
+
 		/// Set a filter to create an inverse filter from
 		/// @param[in] filterToInverse A pointer to filter which the created filter be the inverse of
 		void setFilter(GeneralFilter* filterToInverse)
@@ -732,6 +896,8 @@ namespace pcpp
 
 		void parseToString(std::string& result) override;
 
+		bool appendToNativeFilter(NativeFilter& nativeFilter) const override;
+
 		/// Set the protocol to filter with
 		/// @param[in] proto The protocol to filter, only packets matching this protocol will be received. Please note
 		/// not all protocol families are supported. List of supported protocols is found in the class description
@@ -768,6 +934,8 @@ namespace pcpp
 
 		void parseToString(std::string& result) override;
 
+		bool appendToNativeFilter(NativeFilter& nativeFilter) const override;
+
 		/// Set the ARP opcode
 		/// @param[in] opCode The ARP opcode: ::ARP_REQUEST or ::ARP_REPLY
 		void setOpCode(ArpOpcode opCode)
@@ -794,6 +962,8 @@ namespace pcpp
 
 		void parseToString(std::string& result) override;
 
+		bool appendToNativeFilter(NativeFilter& nativeFilter) const override;
+
 		/// Set the VLAN ID of the filter
 		/// @param[in] vlanId The VLAN ID to use for the filter
 		void setVlanID(uint16_t vlanId)
@@ -863,6 +1033,8 @@ namespace pcpp
 		}
 
 		void parseToString(std::string& result) override;
+
+		bool appendToNativeFilter(NativeFilter& nativeFilter) const override;
 	};
 
 	/// @class TcpWindowSizeFilter
@@ -884,6 +1056,8 @@ namespace pcpp
 
 		void parseToString(std::string& result) override;
 
+		bool appendToNativeFilter(NativeFilter& nativeFilter) const override;
+
 		/// Set window-size value
 		/// @param[in] windowSize The window-size value that will be used in the filter
 		void setWindowSize(uint16_t windowSize)
@@ -911,6 +1085,8 @@ namespace pcpp
 
 		void parseToString(std::string& result) override;
 
+		bool appendToNativeFilter(NativeFilter& nativeFilter) const override;
+
 		/// Set length value
 		/// @param[in] length The length value that will be used in the filter
 		void setLength(uint16_t length)
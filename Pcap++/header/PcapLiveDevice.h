@@ -1,10 +1,13 @@
 #pragma once
 
 #include <atomic>
+#include <memory>
+#include <mutex>
 #include <vector>
 #include <thread>
 #include <functional>
 
+#include "CaptureTimingStats.h"
 #include "IpAddress.h"
 #include "PcapDevice.h"
 
@@ -35,6 +38,22 @@ namespace pcpp
 	/// @return True when main thread should stop blocking or false otherwise
 	using OnPacketArrivesStopBlocking = std::function<bool(RawPacket*, PcapLiveDevice*, void*)>;
 
+	/// A callback that is called with a batch of packets captured by PcapLiveDevice in batch mode
+	/// @param[in] packets An array of the captured packets. The packets and their data are owned by the device and
+	/// are reused for the next batch, so they are only valid until the callback returns
+	/// @param[in] packetCount The number of packets in the array
+	/// @param[in] device A pointer to the PcapLiveDevice instance
+	/// @param[in] userCookie A pointer to the object put by the user when packet capturing stared
+	using OnPacketsArriveCallback = std::function<void(RawPacket*, uint32_t, PcapLiveDevice*, void*)>;
+
+	/// A callback that is called when a packet is captured by one of the threads of a fanout capture
+	/// @param[in] packet A pointer to the raw packet
+	/// @param[in] device A pointer to the PcapLiveDevice instance
+	/// @param[in] threadIndex The index of the capture thread that captured the packet, between 0 and the number of
+	/// threads minus 1. The callback is called concurrently from all threads, each thread with its own index
+	/// @param[in] userCookie A pointer to the object put by the user when packet capturing stared
+	using OnFanoutPacketArrivesCallback = std::function<void(RawPacket*, PcapLiveDevice*, uint32_t, void*)>;
+
 	/// A callback that is called periodically for stats collection if user asked to start packet capturing with
 	/// periodic stats collection
 	/// @param[in] stats A reference to the most updated stats
@@ -147,6 +166,24 @@ namespace pcpp
 		void* m_cbOnPacketArrivesBlockingModeUserCookie;
 		RawPacketVector* m_CapturedPackets;
 		bool m_CaptureCallbackMode;
+
+		// batch mode state: the data of the packets of a pcap_dispatch() round is copied into one slab which is reused
+		// by the next rounds, and the packets are handed to the callback from an array which is reused as well
+		struct BatchPacketInfo
+		{
+			size_t dataOffset;
+			uint32_t captureLength;
+			uint32_t frameLength;
+			timeval timestamp;
+		};
+
+		OnPacketsArriveCallback m_cbOnPacketsArrive;
+		void* m_cbOnPacketsArriveUserCookie;
+		bool m_CaptureBatchMode;
+		uint32_t m_BatchSize;
+		std::vector<BatchPacketInfo> m_BatchPacketInfo;
+		std::vector<uint8_t> m_BatchSlab;
+		std::vector<RawPacket> m_BatchPackets;
 		LinkLayerType m_LinkType;
 		bool m_UsePoll;
 
@@ -168,6 +205,8 @@ namespace pcpp
 		static void onPacketArrives(uint8_t* user, const struct pcap_pkthdr* pkthdr, const uint8_t* packet);
 		static void onPacketArrivesNoCallback(uint8_t* user, const struct pcap_pkthdr* pkthdr, const uint8_t* packet);
 		static void onPacketArrivesBlockingMode(uint8_t* user, const struct pcap_pkthdr* pkthdr, const uint8_t* packet);
+		static void onPacketArrivesBatchMode(uint8_t* user, const struct pcap_pkthdr* pkthdr, const uint8_t* packet);
+		void deliverPacketBatch();
 
 	public:
 		/// The type of the live device
@@ -315,6 +354,67 @@ namespace pcpp
 			}
 		};
 
+		/// @struct FanoutConfiguration
+		/// A struct that contains the parameters of a fanout capture (Linux only). In a fanout capture several libpcap
+		/// handles are opened on the same interface and joined to a PACKET_FANOUT group, so the kernel distributes the
+		/// packets between them, and each handle is read by its own capture thread
+		struct FanoutConfiguration
+		{
+			/// The algorithm the kernel uses to distribute packets between the handles of the group
+			enum FanoutMode
+			{
+				/// Packets of the same flow go to the same handle
+				FanoutHash = 0,
+				/// Round-robin between the handles
+				FanoutLoadBalance = 1,
+				/// Each handle receives the packets of the CPU they arrived on
+				FanoutCpu = 2,
+				/// Send to a handle until its buffer is full, then move to the next one
+				FanoutRollover = 3,
+				/// A random handle
+				FanoutRandom = 4,
+				/// Each handle receives the packets of the NIC queue they arrived on
+				FanoutQueueMapping = 5,
+				/// An eBPF program set in ebpfProgramFd selects the handle
+				FanoutEbpf = 7
+			};
+
+			/// The number of handles and capture threads. Must be at least 1
+			uint32_t threadCount;
+
+			/// The ID of the fanout group. It must not be used by other sockets on the machine, except for sockets
+			/// which should share the traffic with this capture
+			uint16_t groupId;
+
+			/// The fanout mode
+			FanoutMode mode;
+
+			/// The file descriptor of a loaded BPF_PROG_TYPE_SOCKET_FILTER program which returns the index of the
+			/// handle to send each packet to. Only used in FanoutEbpf mode
+			int ebpfProgramFd;
+
+			/// Ask the kernel to defragment IP packets before computing the hash, so all fragments of a packet go to
+			/// the same handle. Only relevant in FanoutHash mode
+			bool defragment;
+
+			/// The CPU cores to bind the capture threads to: thread i is bound to coreIds[i % coreIds.size()]. If
+			/// empty, the threads aren't bound to cores
+			std::vector<int> coreIds;
+
+			/// A c'tor for this struct
+			/// @param[in] threadCount The number of handles and capture threads
+			/// @param[in] groupId The ID of the fanout group
+			/// @param[in] mode The fanout mode. Default value is FanoutHash
+			explicit FanoutConfiguration(uint32_t threadCount, uint16_t groupId, FanoutMode mode = FanoutHash)
+			{
+				this->threadCount = threadCount;
+				this->groupId = groupId;
+				this->mode = mode;
+				this->ebpfProgramFd = -1;
+				this->defragment = false;
+			}
+		};
+
 		PcapLiveDevice(const PcapLiveDevice& other) = delete;
 		PcapLiveDevice& operator=(const PcapLiveDevice& other) = delete;
 		/// A destructor for this class
@@ -470,6 +570,59 @@ namespace pcpp
 		/// @remarks This method is planned for conversion to non-virtual in the future, so it should not be overridden.
 		virtual bool startCapture(RawPacketVector& capturedPacketsVector);
 
+		/// Start capturing packets on this network interface (device) in batch mode. Instead of calling a callback for
+		/// each packet, the packets of each libpcap dispatch round (up to batchSize packets) are collected and the
+		/// onPacketsArrive callback is called once with all of them. The packet data is copied into a buffer owned by
+		/// the device and both the buffer and the RawPacket array are reused for the next batches, so no memory is
+		/// allocated per packet once the buffer reached the size of the largest batch. Packets the user needs after
+		/// the callback returns should be copied. The capture is done on a new thread created by this method, like
+		/// startCapture(), and is stopped by calling stopCapture(). This method must be called after the device is
+		/// opened (i.e the open() method was called), otherwise an error will be returned.
+		/// @param[in] onPacketsArrive A callback that is called with each batch of captured packets
+		/// @param[in] onPacketsArriveUserCookie A pointer to a user provided object. This object will be transferred to
+		/// the onPacketsArrive callback each time it is called
+		/// @param[in] batchSize The maximum number of packets in a batch, which is also the size of the RawPacket
+		/// array allocated for the capture. A batch may contain fewer packets if the packet buffer timeout set in
+		/// DeviceConfiguration expires first
+		/// @return True if capture started successfully, false if (relevant log error is printed in any case):
+		/// - Capture is already running
+		/// - Device is not opened
+		/// - The callback is empty or batchSize is 0
+		bool startCaptureBatchMode(OnPacketsArriveCallback onPacketsArrive, void* onPacketsArriveUserCookie,
+		                           uint32_t batchSize);
+
+		/// Start a multi-threaded fanout capture on this network interface (device), Linux only. The device handle and
+		/// threadCount - 1 additional handles, opened with the same DeviceConfiguration as the device, are joined to
+		/// a PACKET_FANOUT group and each of them is read by its own capture thread, optionally bound to a CPU core.
+		/// Each captured packet is delivered to exactly one thread, which calls onPacketArrives with its thread index.
+		/// The capture is stopped by calling stopCapture(), which closes the additional handles so later captures on
+		/// the device see all of its traffic again. The device handle stays in the fanout group until the device is
+		/// closed, as the only member left. Until the device is closed getStatistics() also includes the statistics of
+		/// the additional handles of all fanout captures. A filter set with setFilter() before starting the capture
+		/// applies to all handles. This method must be called after the device is opened (i.e the open() method was
+		/// called), otherwise an error will be returned.
+		/// @param[in] fanoutConfig The fanout configuration
+		/// @param[in] onPacketArrives A callback that is called each time a packet is captured, concurrently from all
+		/// capture threads
+		/// @param[in] onPacketArrivesUserCookie A pointer to a user provided object. This object will be transferred to
+		/// the onPacketArrives callback each time it is called
+		/// @return True if capture started successfully, false if (relevant log error is printed in any case):
+		/// - Capture is already running
+		/// - Device is not opened
+		/// - The platform isn't Linux or the configuration is invalid
+		/// - An additional handle couldn't be opened or a handle couldn't join the fanout group
+		/// - A previous fanout capture joined the device handle to a different group. A socket can't leave a fanout
+		/// group, so the device has to be closed and reopened first
+		bool startFanoutCapture(const FanoutConfiguration& fanoutConfig, OnFanoutPacketArrivesCallback onPacketArrives,
+		                        void* onPacketArrivesUserCookie);
+
+		/// @return The number of capture threads of the last fanout capture, or 0 if no fanout capture with more than
+		/// one thread was started since the device was opened
+		uint32_t getFanoutThreadCount() const
+		{
+			return m_FanoutThreadCount;
+		}
+
 		/// Start capturing packets on this network interface (device) in blocking mode, meaning this method blocks and
 		/// won't return until the user frees the blocking (via onPacketArrives callback) or until a user defined
 		/// timeout expires. Whenever a packets is captured the onPacketArrives callback is called and lets the user
@@ -659,6 +812,44 @@ namespace pcpp
 
 		void getStatistics(IPcapDevice::PcapStats& stats) const override;
 
+		using IPcapDevice::setFilter;
+
+		/// Set a filter for the device, like IPcapDevice#setFilter(). The filter is also set on the additional handles
+		/// of a fanout capture, including handles opened later by startFanoutCapture()
+		/// @param[in] filterAsString The filter to be set in Berkeley Packet Filter (BPF) syntax
+		/// (http://biot.com/capstats/bpf.html)
+		/// @return True if filter set successfully on all handles, false otherwise
+		bool setFilter(std::string filterAsString) override;
+
+		/// Clear the filter currently set on device, including the additional handles of a fanout capture
+		/// @return True if filter was removed successfully or if no filter was set, false otherwise
+		bool clearFilter() override;
+
+		/// Enable or disable the collection of capture timing statistics (see CaptureTimingStats). The setting takes
+		/// effect when the next capture starts. Each capture thread records into its own counters, which
+		/// getCaptureTimingStats() merges. When disabled, which is the default, the capture path only tests a null
+		/// pointer per packet; when enabled it reads the clocks a few times per packet and the thread CPU time once
+		/// per pcap_dispatch() round
+		/// @param[in] enabled True to collect timing statistics, false otherwise
+		void setCaptureTimingEnabled(bool enabled)
+		{
+			m_CaptureTimingEnabled = enabled;
+		}
+
+		/// @return True if timing statistics are collected by captures started from now on
+		bool isCaptureTimingEnabled() const
+		{
+			return m_CaptureTimingEnabled;
+		}
+
+		/// Get the timing statistics of all captures since timing was enabled or last reset. May be called while
+		/// capturing
+		/// @param[out] stats The statistics, merged from all capture threads
+		void getCaptureTimingStats(CaptureTimingStats& stats) const;
+
+		/// Clear the timing statistics. Values recorded while the reset runs may be partially kept
+		void resetCaptureTimingStats();
+
 	protected:
 		/// @brief Called before starting a capture to prepare the device for capturing packets.
 		///
@@ -676,6 +867,31 @@ namespace pcpp
 		bool sendPacketDirect(uint8_t const* packetData, int packetDataLength);
 
 	private:
+		// fanout capture state: the device descriptor is read by m_CaptureThread and each additional descriptor by a
+		// thread in m_FanoutThreads
+		DeviceConfiguration m_DeviceConfig;
+		std::string m_FilterAsString;
+		std::vector<internal::PcapHandle> m_FanoutDescriptors;
+		std::vector<std::thread> m_FanoutThreads;
+		OnFanoutPacketArrivesCallback m_cbOnFanoutPacketArrives;
+		void* m_cbOnFanoutPacketArrivesUserCookie = nullptr;
+		uint32_t m_FanoutThreadCount = 0;
+		// the statistics of the additional descriptors closed by stopCapture(), summed until the device is closed
+		PcapStats m_ClosedFanoutStats = {};
+		// the fanout group the device handle joined, a socket can't leave it until it's closed
+		int m_FanoutGroupId = -1;
+
+		// capture timing state: one recorder per capture thread, created when a capture starts with timing enabled.
+		// m_ActiveTimingRecorder is the recorder of the main capture thread, or nullptr when timing is disabled
+		bool m_CaptureTimingEnabled = false;
+		std::vector<std::unique_ptr<internal::CaptureTimingRecorder>> m_TimingRecorders;
+		mutable std::mutex m_TimingRecordersMutex;
+		internal::CaptureTimingRecorder* m_ActiveTimingRecorder = nullptr;
+
 		bool isNflogDevice() const;
+		void prepareTimingRecorders(uint32_t threadCount);
+		bool joinFanoutGroup(pcap_t* pcapDescriptor, const FanoutConfiguration& fanoutConfig);
+		void fanoutCaptureThreadMain(uint32_t threadIndex, pcap_t* pcapDescriptor, int coreId);
+		void closeFanoutDescriptors();
 	};
 }  // namespace pcpp
@@ -51,6 +51,156 @@ namespace pcpp
 			RecvError = 3
 		};
 
+		/// @typedef OnRxRingPacketsArrive
+		/// The callback that is called by receiveBlock() with the packets of a block of the receive ring
+		/// @param[in] packets An array of the packets in the block. The packet data points directly into the ring and
+		/// is only valid until the callback returns, copy the packets to keep them
+		/// @param[in] packetCount The number of packets in the array
+		/// @param[in] device The device the packets were received on
+		/// @param[in] userCookie A pointer to an object set by the user when calling receiveBlock()
+		typedef void (*OnRxRingPacketsArrive)(RawPacket packets[], uint32_t packetCount, RawSocketDevice* device,
+		                                      void* userCookie);
+
+		/// @struct RxRingConfiguration
+		/// The configuration of a TPACKET_V3 memory-mapped receive ring (Linux only). The kernel writes the received
+		/// frames into fixed-size blocks of a ring shared with the process, and hands a block over when it's full or
+		/// when its timeout expires. Frames are then read from the ring without a system call or a copy per frame
+		struct RxRingConfiguration
+		{
+			/// @enum FanoutMode
+			/// The algorithm used to distribute packets between the sockets of a fanout group
+			enum FanoutMode
+			{
+				/// Packets of the same flow go to the same socket
+				FanoutHash = 0,
+				/// Round-robin between the sockets
+				FanoutLoadBalance = 1,
+				/// Each socket receives the packets of the CPU they arrived on
+				FanoutCpu = 2,
+				/// Send to a socket until its ring is full, then move to the next one
+				FanoutRollover = 3,
+				/// A random socket
+				FanoutRandom = 4,
+				/// Each socket receives the packets of the NIC queue they arrived on
+				FanoutQueueMapping = 5
+			};
+
+			/// The size of each ring block in bytes. It must be a multiple of the page size and large enough to hold
+			/// the largest frame. 0 means the default value of 1MB
+			uint32_t blockSize;
+
+			/// The number of blocks in the ring. 0 means the default value of 64
+			uint32_t blockCount;
+
+			/// The time in milliseconds after which the kernel hands over a block that isn't full. 0 means the
+			/// default value of 10ms
+			uint32_t blockTimeoutMS;
+
+			/// The ID of the fanout group to join (0-65535), or a negative value to receive all packets of the
+			/// interface. All sockets in a group must use the same fanout mode
+			int fanoutGroupId;
+
+			/// The fanout mode of the group, ignored if fanoutGroupId is negative
+			FanoutMode fanoutMode;
+
+			/// A c'tor for this struct. Each parameter has a default value described below.
+			/// @param[in] blockSize The size of each ring block in bytes. The default value is 0 which means 1MB
+			/// @param[in] blockCount The number of blocks in the ring. The default value is 0 which means 64
+			/// @param[in] blockTimeoutMS The block timeout in milliseconds. The default value is 0 which means 10ms
+			/// @param[in] fanoutGroupId The fanout group to join. The default value is -1 which means no fanout
+			/// @param[in] fanoutMode The fanout mode. The default value is FanoutHash
+			explicit RxRingConfiguration(uint32_t blockSize = 0, uint32_t blockCount = 0, uint32_t blockTimeoutMS = 0,
+			                             int fanoutGroupId = -1, FanoutMode fanoutMode = FanoutHash)
+			{
+				this->blockSize = blockSize;
+				this->blockCount = blockCount;
+				this->blockTimeoutMS = blockTimeoutMS;
+				this->fanoutGroupId = fanoutGroupId;
+				this->fanoutMode = fanoutMode;
+			}
+		};
+
+		/// @typedef OnTxBatchSent
+		/// The callback that is called by the batched send methods after each batch is handed to the kernel
+		/// @param[in] batchPacketCount The number of packets in the batch
+		/// @param[in] sentPacketCount The number of packets of the batch the kernel accepted. It's smaller than
+		/// batchPacketCount if the batch was sent partially
+		/// @param[in] device The device the batch was sent on
+		/// @param[in] userCookie The pointer set in TxConfiguration#onBatchSentUserCookie
+		typedef void (*OnTxBatchSent)(uint32_t batchPacketCount, uint32_t sentPacketCount, RawSocketDevice* device,
+		                              void* userCookie);
+
+		/// @struct TxConfiguration
+		/// The configuration of the batched send path used by sendPackets() (Linux only). Packets are handed to the
+		/// kernel in batches, either with one sendmmsg() call per batch or through a PACKET_TX_RING memory-mapped
+		/// transmit ring which is flushed with one send() call per batch
+		struct TxConfiguration
+		{
+			/// The maximum number of packets in a batch. 0 means the default value of 64. It's capped at 1024, the
+			/// maximum sendmmsg() accepts, and at the number of TX ring frames
+			uint32_t batchSize;
+
+			/// Send through a PACKET_TX_RING transmit ring instead of sendmmsg(). The packets are copied into the ring
+			/// and the kernel reads them from there. A TX ring can't be set up on a device opened with a receive ring
+			bool useTxRing;
+
+			/// The size of each TX ring frame in bytes, which limits the size of the packets that can be sent through
+			/// the ring. Must be a power of 2. 0 means the default value of 2048
+			uint32_t txRingFrameSize;
+
+			/// The number of TX ring frames. 0 means the default value of 1024
+			uint32_t txRingFrameCount;
+
+			/// Set PACKET_QDISC_BYPASS on the socket so packets are handed directly to the driver, skipping the
+			/// kernel traffic control layer. Packets may then be dropped if the driver queue is full
+			bool qdiscBypass;
+
+			/// An optional callback to invoke after each batch is sent, or nullptr
+			OnTxBatchSent onBatchSent;
+
+			/// A pointer which is passed to onBatchSent
+			void* onBatchSentUserCookie;
+
+			/// A c'tor for this struct. Each parameter has a default value described below.
+			/// @param[in] batchSize The maximum number of packets in a batch. The default value is 64
+			/// @param[in] useTxRing Whether to send through a TX ring. The default value is false (use sendmmsg())
+			/// @param[in] txRingFrameSize The size of each TX ring frame. The default value is 2048
+			/// @param[in] txRingFrameCount The number of TX ring frames. The default value is 1024
+			/// @param[in] qdiscBypass Whether to bypass the kernel traffic control layer. The default value is false
+			explicit TxConfiguration(uint32_t batchSize = 0, bool useTxRing = false, uint32_t txRingFrameSize = 0,
+			                         uint32_t txRingFrameCount = 0, bool qdiscBypass = false)
+			{
+				this->batchSize = batchSize;
+				this->useTxRing = useTxRing;
+				this->txRingFrameSize = txRingFrameSize;
+				this->txRingFrameCount = txRingFrameCount;
+				this->qdiscBypass = qdiscBypass;
+				this->onBatchSent = nullptr;
+				this->onBatchSentUserCookie = nullptr;
+			}
+		};
+
+		/// @struct TxStats
+		/// Aggregate counters of the batched send methods
+		struct TxStats
+		{
+			/// The number of packets the kernel accepted
+			uint64_t packetsSent;
+			/// The number of bytes in the packets the kernel accepted
+			uint64_t bytesSent;
+			/// The number of packets that weren't sent: non-Ethernet packets, packets which don't fit a TX ring frame
+			/// and packets the kernel rejected
+			uint64_t packetsFailed;
+			/// The number of batches handed to the kernel
+			uint64_t batches;
+			/// The number of batches the kernel accepted only some of the packets of
+			uint64_t partialBatches;
+
+			/// A c'tor for this struct that zeroes all counters
+			TxStats() : packetsSent(0), bytesSent(0), packetsFailed(0), batches(0), partialBatches(0)
+			{}
+		};
+
 		/// A c'tor for this class. This c'tor doesn't create the raw socket, but rather initializes internal
 		/// structures. The actual raw socket creation is done in the open() method. Each raw socket is bound to a
 		/// network interface which means packets will be received and sent from only from this network interface only
@@ -87,6 +237,23 @@ namespace pcpp
 		///    operation returned some error. A log message will be followed specifying the error and error code
 		RecvPacketResult receivePacket(RawPacket& rawPacket, bool blocking = true, double timeout = -1);
 
+		/// Receive the packets of the next block of the receive ring and pass them to a callback without copying them.
+		/// When the callback returns the block is handed back to the kernel. If receivePacket() already read some of
+		/// the packets of the current block, only the remaining packets are passed. This method can only be used if
+		/// the device was opened with open(const RxRingConfiguration&)
+		/// @param[in] onPacketsArrive The callback to invoke with the packets of the block
+		/// @param[in] onPacketsArriveUserCookie A pointer which is passed to the callback
+		/// @param[in] timeoutMS The time in milliseconds to wait for a block. Zero means not to wait and a negative
+		/// value means no timeout. The default value is no timeout
+		/// @return The method returns one on the following values:
+		///  - RawSocketDevice#RecvSuccess is returned if a block was received and passed to the callback
+		///  - RawSocketDevice#RecvTimeout is returned if timeoutMS is positive and expired before a block was ready
+		///  - RawSocketDevice#RecvWouldBlock is returned if timeoutMS is zero and no block is ready
+		///  - RawSocketDevice#RecvError is returned if the device isn't open with a receive ring or waiting for the
+		///    block failed
+		RecvPacketResult receiveBlock(OnRxRingPacketsArrive onPacketsArrive, void* onPacketsArriveUserCookie,
+		                              int timeoutMS = -1);
+
 		/// Receive packets into a packet vector for a certain amount of time. This method starts a timer and invokes
 		/// the receivePacket() method in blocking mode repeatedly until the timeout expires. All packets received
 		/// successfully are put into a packet vector
@@ -115,12 +282,59 @@ namespace pcpp
 		/// corresponding error message printed to log
 		int sendPackets(const RawPacketVector& packetVec);
 
+		/// Send an array of Ethernet packets to the network. On Linux the packets are sent in batches as configured by
+		/// setTxConfiguration(), the same way as sendPackets(const RawPacketVector&). This method is only supported in
+		/// Linux, using it from other platforms will return 0 with an appropriate error log message
+		/// @param[in] rawPacketsArr The array of packets to send. This method treats all packets as read-only
+		/// @param[in] arrLength The length of the array
+		/// @return The number of packets sent successfully. Packets that weren't sent successfully are counted in
+		/// TxStats#packetsFailed and a corresponding debug message is printed to log
+		int sendPackets(const RawPacket* rawPacketsArr, int arrLength);
+
+		/// Configure how sendPackets() sends packets: the batch size, whether to use a PACKET_TX_RING transmit ring
+		/// and whether to bypass the kernel traffic control layer. Without calling this method sendPackets() uses
+		/// sendmmsg() with batches of 64 packets. The configuration is reset when the device is closed. This method is
+		/// only supported in Linux
+		/// @param[in] txConfig The configuration to apply
+		/// @return True if the configuration was applied successfully, false if the device isn't open, the
+		/// configuration is invalid or setting up the socket failed. An error is printed to log in that case and the
+		/// previous configuration stays in effect, unless the TX ring was set up before the failure
+		bool setTxConfiguration(const TxConfiguration& txConfig);
+
+		/// @return True if the device sends packets through a PACKET_TX_RING transmit ring, false otherwise
+		bool isTxRingEnabled() const;
+
+		/// @return The aggregate counters of both sendPackets() overloads, and of sendPacket() when the TX ring is
+		/// used, since the device was created or resetTxStats() was called
+		const TxStats& getTxStats() const
+		{
+			return m_TxStats;
+		}
+
+		/// Reset the counters returned by getTxStats()
+		void resetTxStats()
+		{
+			m_TxStats = TxStats();
+		}
+
 		// overridden methods
 
 		/// Open the device by creating a raw socket and binding it to the network interface specified in the c'tor
 		/// @return True if device was opened successfully, false otherwise with a corresponding error log message
 		bool open() override;
 
+		/// Open the device like open() and set up a TPACKET_V3 memory-mapped receive ring on the socket. Once the ring
+		/// is set up, receivePacket() and receivePackets() read packets from the ring instead of calling recv() for
+		/// each of them, and receiveBlock() can be used to process whole blocks without copying the packets. Sending
+		/// packets isn't affected. This mode is only supported on Linux
+		/// @param[in] rxRingConfig The receive ring configuration
+		/// @return True if the device was opened and the ring was set up successfully, false otherwise with a
+		/// corresponding error log message. On failure the device is left closed
+		bool open(const RxRingConfiguration& rxRingConfig);
+
+		/// @return True if the device is open with a memory-mapped receive ring, false otherwise
+		bool isRxRingEnabled() const;
+
 		/// Close the raw socket
 		void close() override;
 
@@ -135,7 +349,11 @@ namespace pcpp
 		SocketFamily m_SockFamily;
 		void* m_Socket;
 		IPAddress m_InterfaceIP;
+		TxStats m_TxStats;
 
 		RecvPacketResult getError(int& errorCode) const;
+		RecvPacketResult waitForRxRingBlock(int timeoutMS);
+		void releaseRxRingBlock();
+		RecvPacketResult receivePacketFromRxRing(RawPacket& rawPacket, bool blocking, double timeout);
 	};
 }  // namespace pcpp
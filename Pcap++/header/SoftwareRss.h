@@ -0,0 +1,312 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+#include "PacketPipeline.h"
+#include "RawPacket.h"
+
+/// @file
+/// A software implementation of Receive Side Scaling (RSS) for capture sources without NIC RSS, such as pcap file
+/// replays, PcapLiveDevice or RawSocketDevice. RssHasher computes the same Toeplitz hash a NIC (and DPDK's
+/// rte_softrss()) computes, directly from the packet data, and SoftwareRssDispatcher maps the hash to a worker through
+/// a redirection table the way the NIC maps it to an RX queue. With the same key, hash types and redirection table as
+/// the DpdkDevice configuration, offline replays are sharded exactly like production traffic
+
+/// @namespace pcpp
+/// @brief The main namespace for the PcapPlusPlus lib
+namespace pcpp
+{
+	/// @class RssHasher
+	/// Computes RSS hashes of packets. The link layer (Ethernet, Linux cooked capture or raw IP) and VLAN tags are
+	/// skipped, then the hash input is built from the IPv4 / IPv6 header and, for TCP, UDP and SCTP, the ports: source
+	/// address, destination address, source port and destination port, in network byte order, as specified by
+	/// Microsoft RSS. Which packet types are hashed on 4 fields, on 2 fields or not at all is set by a mask of
+	/// HashType values, which have the same values as DpdkDevice::DpdkRssHashFunction.
+	///
+	/// The Toeplitz hash is computed with a lookup table built from the key, one XOR per input byte. A hasher is
+	/// immutable after construction, so it can be used concurrently by multiple threads
+	class RssHasher
+	{
+	public:
+		/// The packet types the hash is computed for. The values are the same as DpdkDevice::DpdkRssHashFunction, so
+		/// a DPDK RSS mask can be used as is. A packet is hashed on its addresses and ports if its L4 type is in the
+		/// mask (for example NonFragIPv4Tcp), otherwise on its addresses only if IPv4 / IPv6 or its specific type
+		/// (FragIPv4, NonFragIPv4Other, ...) is in the mask. Packets that match no type get a hash of 0
+		enum HashType : uint64_t
+		{
+			/// IPv4 packets, hashed on addresses
+			IPv4 = 0x1,
+			/// IPv4 fragments, hashed on addresses
+			FragIPv4 = 0x2,
+			/// Non-fragmented IPv4 TCP packets, hashed on addresses and ports
+			NonFragIPv4Tcp = 0x4,
+			/// Non-fragmented IPv4 UDP packets, hashed on addresses and ports
+			NonFragIPv4Udp = 0x8,
+			/// Non-fragmented IPv4 SCTP packets, hashed on addresses and ports
+			NonFragIPv4Sctp = 0x10,
+			/// Non-fragmented IPv4 packets other than TCP, UDP and SCTP, hashed on addresses
+			NonFragIPv4Other = 0x20,
+			/// IPv6 packets, hashed on addresses
+			IPv6 = 0x40,
+			/// IPv6 fragments, hashed on addresses
+			FragIPv6 = 0x80,
+			/// Non-fragmented IPv6 TCP packets, hashed on addresses and ports
+			NonFragIPv6Tcp = 0x100,
+			/// Non-fragmented IPv6 UDP packets, hashed on addresses and ports
+			NonFragIPv6Udp = 0x200,
+			/// Non-fragmented IPv6 SCTP packets, hashed on addresses and ports
+			NonFragIPv6Sctp = 0x400,
+			/// Non-fragmented IPv6 packets other than TCP, UDP and SCTP, hashed on addresses
+			NonFragIPv6Other = 0x800,
+			/// The types DpdkDevice configures by default on most PMDs
+			DefaultHashTypes = IPv4 | IPv6
+		};
+
+		/// The hash function
+		enum HashFunction
+		{
+			/// The Toeplitz hash of the fields
+			Toeplitz,
+			/// Symmetric Toeplitz: each source / destination pair is replaced by the XOR of the two fields, so both
+			/// directions of a flow get the same hash with any key (DPDK's RTE_ETH_HASH_FUNCTION_SYMMETRIC_TOEPLITZ)
+			SymmetricToeplitz,
+			/// Symmetric Toeplitz: each source / destination pair is sorted, the lower value first
+			/// (DPDK's RTE_ETH_HASH_FUNCTION_SYMMETRIC_TOEPLITZ_SORT)
+			SymmetricToeplitzSort
+		};
+
+		/// The headers the hash is computed from when the packet is tunneled
+		enum HashLevel
+		{
+			/// Always hash the outer headers
+			OuterHeaders,
+			/// Hash the headers of the encapsulated packet for VXLAN, GENEVE, GRE (including NVGRE) and IP-in-IP
+			/// tunnels, and the outer headers for other packets. Only the first encapsulation level is opened
+			InnerHeaders
+		};
+
+		/// The length of the longest hash input: two IPv6 addresses and two ports
+		static constexpr size_t MaxInputLength = 36;
+
+		/// The minimum key length, which covers the longest hash input
+		static constexpr size_t MinKeyLength = MaxInputLength + 4;
+
+		/// A c'tor for this class. If the key is shorter than MinKeyLength an error is printed to log and the hasher is
+		/// invalid (see isValid()): every hash it computes is 0
+		/// @param[in] key The Toeplitz key. If nullptr, the key DpdkDevice uses by default is used (0x6D5A repeated),
+		/// which also makes the Toeplitz hash symmetric
+		/// @param[in] keyLength The key length. Only the first MinKeyLength bytes are used, which is what NICs use
+		/// for the supported inputs. The default is 40
+		/// @param[in] hashTypes A mask of HashType values. The default is DefaultHashTypes
+		/// @param[in] hashFunction The hash function. The default is Toeplitz
+		/// @param[in] hashLevel The headers the hash is computed from. The default is OuterHeaders
+		explicit RssHasher(const uint8_t* key = nullptr, size_t keyLength = MinKeyLength,
+		                   uint64_t hashTypes = DefaultHashTypes, HashFunction hashFunction = Toeplitz,
+		                   HashLevel hashLevel = OuterHeaders);
+
+		/// Compute the RSS hash of packet data
+		/// @param[in] data A pointer to the packet data
+		/// @param[in] dataLen The packet data length
+		/// @param[in] linkType The packet link type. Ethernet, Linux cooked capture and the raw IP link types are
+		/// supported; packets of other link types get a hash of 0
+		/// @return The hash, or 0 if the packet matches none of the configured hash types
+		uint32_t hash(const uint8_t* data, size_t dataLen, LinkLayerType linkType) const;
+
+		/// Compute the RSS hash of a raw packet
+		/// @param[in] rawPacket The packet
+		/// @return The hash, or 0 if the packet matches none of the configured hash types
+		uint32_t hash(const RawPacket* rawPacket) const
+		{
+			return hash(rawPacket->getRawData(), rawPacket->getRawDataLen(), rawPacket->getLinkLayerType());
+		}
+
+		/// Compute the RSS hashes of a burst of packets. The data of the packets a few positions ahead is prefetched
+		/// while the current packet is hashed
+		/// @param[in] rawPackets The packets
+		/// @param[in] count The number of packets
+		/// @param[out] hashes An array of at least count values the hashes are written to
+		void hashBatch(const RawPacket* const* rawPackets, size_t count, uint32_t* hashes) const;
+
+		/// Compute the Toeplitz hash of an input built by the caller, for example the tuple DPDK's rte_softrss()
+		/// is given, converted to network byte order. The hash function and hash types aren't applied
+		/// @param[in] input The input bytes
+		/// @param[in] inputLength The input length, at most MaxInputLength
+		/// @return The hash, or 0 if the input is longer than MaxInputLength
+		uint32_t toeplitzHash(const uint8_t* input, size_t inputLength) const;
+
+		/// @return True if the hasher was created with a valid key
+		bool isValid() const
+		{
+			return !m_Table.empty();
+		}
+
+		/// @return The first MinKeyLength bytes of the key, all zeros if the hasher is invalid
+		const uint8_t* getKey() const
+		{
+			return m_Key;
+		}
+
+		/// @return The mask of HashType values
+		uint64_t getHashTypes() const
+		{
+			return m_HashTypes;
+		}
+
+		/// @return The hash function
+		HashFunction getHashFunction() const
+		{
+			return m_HashFunction;
+		}
+
+		/// @return The headers the hash is computed from
+		HashLevel getHashLevel() const
+		{
+			return m_HashLevel;
+		}
+
+	private:
+		uint8_t m_Key[MinKeyLength];
+		uint64_t m_HashTypes;
+		HashFunction m_HashFunction;
+		HashLevel m_HashLevel;
+		// m_Table[i * 256 + b] is the hash contribution of byte value b at input offset i
+		std::vector<uint32_t> m_Table;
+	};
+
+	/// @class SoftwareRssDispatcher
+	/// Distributes raw packets to a fixed number of worker threads by their RSS hash, so all packets of a flow reach
+	/// the same worker. The worker of a packet is redirectionTable[hash % tableSize], the same lookup a NIC does with
+	/// its RSS redirection table (RETA). The default table maps entry i to worker i % workerCount, which is also how
+	/// DPDK fills the RETA of a port by default, so with the same number of workers as RX queues and the same table
+	/// size the packets are sharded exactly like the NIC shards them.
+	///
+	/// The workers are run by a PacketPipeline: the dispatch methods must be called from a single producer thread and
+	/// ownership of a dispatched packet moves to the worker callback
+	class SoftwareRssDispatcher
+	{
+	public:
+		/// The callback a worker calls with each batch of packets it pops, see PacketPipeline::WorkerCallback
+		using WorkerCallback = PacketPipeline<RawPacket*>::WorkerCallback;
+
+		/// What a dispatch does when the worker's ring is full, see PacketPipeline::BackpressurePolicy
+		using BackpressurePolicy = PacketPipeline<RawPacket*>::BackpressurePolicy;
+
+		/// The redirection table size DpdkDevice's PMDs most commonly use
+		static constexpr uint16_t DefaultRedirectionTableSize = 128;
+
+		/// A c'tor for this class. The workers aren't started until start() is called. If the hasher is invalid,
+		/// workerCount, ringCapacity or redirectionTableSize is 0, redirectionTableSize isn't a power of 2 or the
+		/// callback is empty, an error is printed to log and the dispatcher is invalid (see isValid()): it can't be
+		/// started and dispatches no packets
+		/// @param[in] hasher The hasher, copied into the dispatcher
+		/// @param[in] workerCount The number of worker threads
+		/// @param[in] ringCapacity The capacity of each worker's ring, rounded up to a power of 2
+		/// @param[in] workerCallback The callback the workers call with each batch of packets
+		/// @param[in] policy What a dispatch does when the worker's ring is full. The default is BlockWhenFull
+		/// @param[in] redirectionTableSize The number of entries of the default redirection table. It must be a power
+		/// of 2 because, like a NIC, the dispatcher selects the entry with the low bits of the hash. To reproduce the
+		/// sharding of a NIC, use its RETA size (for example 128 for ixgbe, 512 for i40e). The default is 128
+		SoftwareRssDispatcher(const RssHasher& hasher, uint32_t workerCount, size_t ringCapacity,
+		                      WorkerCallback workerCallback,
+		                      BackpressurePolicy policy = PacketPipeline<RawPacket*>::BlockWhenFull,
+		                      uint16_t redirectionTableSize = DefaultRedirectionTableSize);
+
+		SoftwareRssDispatcher(const SoftwareRssDispatcher&) = delete;
+		SoftwareRssDispatcher& operator=(const SoftwareRssDispatcher&) = delete;
+
+		/// Start the worker threads
+		/// @return True if the workers were started, false if they're already running or the dispatcher is invalid
+		bool start()
+		{
+			return isValid() && m_Pipeline.start();
+		}
+
+		/// Stop the worker threads. Packets dispatched before this call are still passed to the callback, see
+		/// PacketPipeline::stop()
+		void stop()
+		{
+			m_Pipeline.stop();
+		}
+
+		/// @return True if the workers were started and not stopped yet
+		bool isRunning() const
+		{
+			return m_Pipeline.isRunning();
+		}
+
+		/// @return True if the dispatcher was created with a valid hasher and valid parameters
+		bool isValid() const
+		{
+			return !m_RedirectionTable.empty();
+		}
+
+		/// Dispatch a packet to the worker its hash maps to
+		/// @param[in] rawPacket The packet
+		/// @return True if the packet was dispatched, false if the dispatcher isn't running or the worker's ring is
+		/// full and the policy is DropWhenFull. In that case the packet stays owned by the caller
+		bool dispatch(RawPacket* rawPacket)
+		{
+			return isValid() && m_Pipeline.push(rawPacket, getWorkerIndex(m_Hasher.hash(rawPacket)));
+		}
+
+		/// Dispatch a burst of packets. The burst is hashed with RssHasher::hashBatch() and the packets of each worker
+		/// are pushed together, in the order they appear in the burst
+		/// @param[in] rawPackets The packets
+		/// @param[in] count The number of packets
+		/// @param[out] notDispatched If not nullptr, the packets which weren't dispatched (when the policy is
+		/// DropWhenFull or the dispatcher isn't running) are appended to this vector. They stay owned by the caller
+		/// @return The number of packets dispatched
+		size_t dispatchBatch(RawPacket* const* rawPackets, size_t count,
+		                     std::vector<RawPacket*>* notDispatched = nullptr);
+
+		/// @param[in] hash An RSS hash
+		/// @return The index of the worker the hash maps to, or 0 if the dispatcher is invalid. The low bits of the
+		/// hash select the redirection table entry, the same way a NIC indexes its RETA
+		uint32_t getWorkerIndex(uint32_t hash) const
+		{
+			return isValid() ? m_RedirectionTable[hash & (m_RedirectionTable.size() - 1)] : 0;
+		}
+
+		/// Replace the redirection table, for example with the RETA read from a NIC. May only be called while the
+		/// workers aren't running
+		/// @param[in] redirectionTable The worker index of each entry
+		/// @return True if the table was set, false if it's empty or its size isn't a power of 2, an entry isn't a
+		/// valid worker index, the workers are running or the dispatcher is invalid
+		bool setRedirectionTable(const std::vector<uint32_t>& redirectionTable);
+
+		/// @return The redirection table, empty if the dispatcher is invalid
+		const std::vector<uint32_t>& getRedirectionTable() const
+		{
+			return m_RedirectionTable;
+		}
+
+		/// @return The hasher
+		const RssHasher& getHasher() const
+		{
+			return m_Hasher;
+		}
+
+		/// @return The number of worker threads
+		uint32_t getWorkerCount() const
+		{
+			return m_Pipeline.getWorkerCount();
+		}
+
+		/// @return The pipeline running the workers, for its statistics
+		const PacketPipeline<RawPacket*>& getPipeline() const
+		{
+			return m_Pipeline;
+		}
+
+	private:
+		// the number of packets dispatchBatch() hashes and groups at a time
+		static constexpr size_t BatchChunkSize = 64;
+
+		RssHasher m_Hasher;
+		std::vector<uint32_t> m_RedirectionTable;
+		PacketPipeline<RawPacket*> m_Pipeline;
+		// per-worker staging arrays used by dispatchBatch()
+		std::vector<std::vector<RawPacket*>> m_WorkerBatches;
+	};
+}  // namespace pcpp
@@ -3,8 +3,12 @@
 /// @file
 
 #include "Device.h"
+#include <atomic>
 #include <utility>
 #include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
 
 /// @namespace pcpp
 /// @
@@ -27,6 +31,17 @@ namespace pcpp
 		/// @param[in] userCookie A pointer to an object set by the user when receivePackets() started
 		typedef void (*OnPacketsArrive)(RawPacket packets[], uint32_t packetCount, XdpDevice* device, void* userCookie);
 
+		/// @typedef OnQueuePacketsArrive
+		/// The callback that is called by a receive thread whenever packets are received on its queue. See
+		/// startReceiveThreads()
+		/// @param[in] packets An array of the raw packets received
+		/// @param[in] packetCount The number of packets received
+		/// @param[in] queueId The ID of the NIC queue the packets were received on
+		/// @param[in] device The XdpDevice packets are received from
+		/// @param[in] userCookie A pointer to an object set by the user when startReceiveThreads() was called
+		typedef void (*OnQueuePacketsArrive)(RawPacket packets[], uint32_t packetCount, uint32_t queueId,
+		                                     XdpDevice* device, void* userCookie);
+
 		/// @struct XdpDeviceConfiguration
 		/// A struct containing the configuration parameters available for opening an XDP device
 		struct XdpDeviceConfiguration
@@ -44,6 +59,17 @@ namespace pcpp
 				AutoMode = 3
 			};
 
+			/// @enum TimestampMode
+			/// How received packets are timestamped
+			enum TimestampMode
+			{
+				/// All packets of a received batch get the time the batch was read, which saves a clock read per
+				/// packet
+				BatchTimestamp,
+				/// Every packet gets the time it was read
+				PacketTimestamp
+			};
+
 			/// AF_XDP operation mode
 			AttachMode attachMode;
 
@@ -75,6 +101,22 @@ namespace pcpp
 			/// The max number of packets to be received or sent in one batch
 			uint16_t rxTxBatchSize;
 
+			/// The IDs of the NIC queues to bind AF_XDP sockets to, one socket per queue. The NIC spreads the traffic
+			/// between its queues (for example by RSS), so all of them should be listed to see all the traffic. If
+			/// empty, a single socket is bound to queue 0
+			std::vector<uint32_t> queueIds;
+
+			/// If true all queues share a single UMEM of umemNumFrames frames, split evenly between them. Otherwise
+			/// each queue gets its own UMEM of umemNumFrames frames. The default value is false
+			bool sharedUmem;
+
+			/// How received packets are timestamped. The default value is BatchTimestamp
+			TimestampMode timestampMode;
+
+			/// The CPU cores to bind the receive threads to, see startReceiveThreads(): the thread of the i-th queue
+			/// in queueIds is bound to coreIds[i % coreIds.size()]. If empty, the threads aren't bound to cores
+			std::vector<int> coreIds;
+
 			/// A c'tor for this struct. Each parameter has a default value described below.
 			/// @param[in] attachMode AF_XDP operation mode. The default value is auto mode
 			/// @param[in] umemNumFrames Number of UMEM frames to allocate. The default value is 4096
@@ -99,9 +141,28 @@ namespace pcpp
 				this->rxSize = rxSize;
 				this->txSize = txSize;
 				this->rxTxBatchSize = rxTxBatchSize;
+				this->sharedUmem = false;
+				this->timestampMode = BatchTimestamp;
 			}
 		};
 
+		/// @struct XdpTxFrame
+		/// A UMEM frame reserved for building a packet in place and sending it without copying, see
+		/// allocateTxFrames()
+		struct XdpTxFrame
+		{
+			/// The address of the frame in the UMEM
+			uint64_t address;
+			/// A pointer to the frame data, where the packet should be built
+			uint8_t* data;
+			/// The number of bytes available at data
+			uint16_t capacity;
+			/// The length of the packet built in the frame. Must be set before the frame is sent
+			uint16_t length;
+			/// The ID of the queue the frame belongs to
+			uint32_t queueId;
+		};
+
 		/// @struct XdpDeviceStats
 		/// A container for XDP device statistics
 		struct XdpDeviceStats
@@ -140,7 +201,8 @@ namespace pcpp
 			uint64_t txCompletedPacketsPerSec;
 			/// TX packets dropped due to invalid descriptor
 			uint64_t txDroppedInvalidPackets;
-			/// Current RX ring ID
+			/// Current RX ring ID. Ring IDs in device statistics are those of the first queue, see getQueueStatistics()
+			/// for the others
 			uint64_t rxRingId;
 			/// Current TX ring ID
 			uint64_t txRingId;
@@ -179,8 +241,8 @@ namespace pcpp
 		/// Close the device. This method closes the AF_XDP socket and frees the UMEM that was allocated for it.
 		void close() override;
 
-		/// Start receiving packets. In order to use this method the device should be open. Note that this method is
-		/// blocking and will return if:
+		/// Start receiving packets on all queues from the calling thread. In order to use this method the device should
+		/// be open. Note that this method is blocking and will return if:
 		/// - stopReceivePackets() was called from within the user callback
 		/// - timeoutMS passed without receiving any packets
 		/// - Some error occurred (an error log will be printed)
@@ -197,6 +259,26 @@ namespace pcpp
 		/// want to stop receiving packets.
 		void stopReceivePackets();
 
+		/// Start a receive thread per queue, optionally bound to a CPU core (see XdpDeviceConfiguration#coreIds).
+		/// Each thread polls its own AF_XDP socket and calls the callback with the packets received on its queue, so
+		/// the callback is called concurrently from all threads. While the threads run, receivePackets() can't be
+		/// used and packets may only be sent on a queue from the callback of that queue's thread
+		/// @param[in] onPacketsArrive A callback to be called when packets are received
+		/// @param[in] onPacketsArriveUserCookie The callback is invoked with this cookie as a parameter
+		/// @return True if the threads were started, false if the device isn't open, packets are already being
+		/// received or a thread couldn't be started (an error log will be printed)
+		bool startReceiveThreads(OnQueuePacketsArrive onPacketsArrive, void* onPacketsArriveUserCookie);
+
+		/// Stop the receive threads started by startReceiveThreads() and wait for them to exit. Must not be called from
+		/// the callback. Does nothing if the threads aren't running
+		void stopReceiveThreads();
+
+		/// @return True if receive threads were started by startReceiveThreads() and weren't stopped yet
+		bool areReceiveThreadsRunning() const
+		{
+			return !m_ReceiveThreads.empty();
+		}
+
 		/// Send a vector of packet pointers.
 		/// @param[in] packets A vector of packet pointers to send
 		/// @param[in] waitForTxCompletion Wait for confirmation from the kernel that packets were sent. If set to true
@@ -205,7 +287,7 @@ namespace pcpp
 		/// @param[in] waitForTxCompletionTimeoutMS If waitForTxCompletion is set to true, poll the completion ring with
 		/// this timeout. The default value is 5000 ms
 		/// @return True if all packets were sent, or if waitForTxCompletion is true - all sent packets were confirmed.
-		/// Returns false if an error occurred or if poll timed out.
+		/// Returns false if there are more packets than the TX ring size, an error occurred or poll timed out.
 		bool sendPackets(const RawPacketVector& packets, bool waitForTxCompletion = false,
 		                 int waitForTxCompletionTimeoutMS = 5000);
 
@@ -218,19 +300,73 @@ namespace pcpp
 		/// @param[in] waitForTxCompletionTimeoutMS If waitForTxCompletion is set to true, poll the completion ring with
 		/// this timeout. The default value is 5000 ms
 		/// @return True if all packets were sent, or if waitForTxCompletion is true - all sent packets were confirmed.
-		/// Returns false if an error occurred or if poll timed out.
+		/// Returns false if there are more packets than the TX ring size, an error occurred or poll timed out.
 		bool sendPackets(RawPacket packets[], size_t packetCount, bool waitForTxCompletion = false,
 		                 int waitForTxCompletionTimeoutMS = 5000);
 
+		/// Send an array of packets on a specific queue. The other sendPackets() overloads send on the first queue
+		/// @param[in] queueId The ID of the queue to send on, one of XdpDeviceConfiguration#queueIds
+		/// @param[in] packets An array of raw packets to send
+		/// @param[in] packetCount The length of the packet array
+		/// @param[in] waitForTxCompletion Wait for confirmation from the kernel that packets were sent. The default
+		/// value is false
+		/// @param[in] waitForTxCompletionTimeoutMS If waitForTxCompletion is set to true, poll the completion ring with
+		/// this timeout. The default value is 5000 ms
+		/// @return True if all packets were sent, or if waitForTxCompletion is true - all sent packets were confirmed.
+		/// Returns false if the queue doesn't exist, there are more packets than the TX ring size, an error occurred or
+		/// poll timed out.
+		bool sendPackets(uint32_t queueId, RawPacket packets[], size_t packetCount, bool waitForTxCompletion = false,
+		                 int waitForTxCompletionTimeoutMS = 5000);
+
+		/// Allocate free UMEM frames of the first queue to build packets in, so they can be sent by sendTxFrames()
+		/// without copying the packet data. Like sending, this must be done from the thread that uses the queue
+		/// @param[out] frames An array of at least count frames to fill. The length of each frame is set to 0
+		/// @param[in] count The number of frames to allocate
+		/// @return True if all frames were allocated, false if the device isn't open or there aren't enough free
+		/// frames (no frame is allocated in this case)
+		bool allocateTxFrames(XdpTxFrame frames[], uint32_t count);
+
+		/// Allocate free UMEM frames of a specific queue to build packets in. See allocateTxFrames()
+		/// @param[in] queueId The ID of the queue, one of XdpDeviceConfiguration#queueIds
+		/// @param[out] frames An array of at least count frames to fill. The length of each frame is set to 0
+		/// @param[in] count The number of frames to allocate
+		/// @return True if all frames were allocated, false if the device isn't open, the queue doesn't exist or there
+		/// aren't enough free frames (no frame is allocated in this case)
+		bool allocateTxFrames(uint32_t queueId, XdpTxFrame frames[], uint32_t count);
+
+		/// Send packets built in frames allocated by allocateTxFrames(). The frames are owned by the device again once
+		/// this method is called, whether it succeeds or not, and must not be used anymore
+		/// @param[in] frames The frames to send, all allocated from the same queue, with their length set
+		/// @param[in] count The number of frames
+		/// @param[in] waitForTxCompletion Wait for confirmation from the kernel that packets were sent. The default
+		/// value is false
+		/// @param[in] waitForTxCompletionTimeoutMS If waitForTxCompletion is set to true, poll the completion ring with
+		/// this timeout. The default value is 5000 ms
+		/// @return True if all packets were sent, or if waitForTxCompletion is true - all sent packets were confirmed.
+		/// Returns false if the frames are invalid, there are more frames than the TX ring size, an error occurred or
+		/// poll timed out.
+		bool sendTxFrames(const XdpTxFrame frames[], uint32_t count, bool waitForTxCompletion = false,
+		                  int waitForTxCompletionTimeoutMS = 5000);
+
+		/// Return frames allocated by allocateTxFrames() to the device without sending them
+		/// @param[in] frames The frames to free
+		/// @param[in] count The number of frames
+		void freeTxFrames(const XdpTxFrame frames[], uint32_t count);
+
 		/// @return A pointer to the current device configuration. If the device is not open this method returns nullptr
 		XdpDeviceConfiguration* getConfig() const
 		{
 			return m_Config;
 		}
 
-		/// @return Current device statistics
+		/// @return Current device statistics, summed over all queues
 		XdpDeviceStats getStatistics();
 
+		/// @param[in] queueId The ID of a queue, one of XdpDeviceConfiguration#queueIds
+		/// @return Current statistics of the queue. The UMEM frame counts are those of the frames the queue uses. If
+		/// the device isn't open or the queue doesn't exist, zeroed statistics are returned and an error is logged
+		XdpDeviceStats getQueueStatistics(uint32_t queueId);
+
 	private:
 		class XdpUmem
 		{
@@ -249,18 +385,11 @@ namespace pcpp
 				return m_FrameCount;
 			}
 
-			std::pair<bool, std::vector<uint64_t>> allocateFrames(uint32_t count);
-
-			void freeFrame(uint64_t addr);
-
 			const uint8_t* getDataPtr(uint64_t addr) const;
 
-			void setData(uint64_t addr, const uint8_t* data, size_t dataLen);
+			uint8_t* getDataPtr(uint64_t addr);
 
-			inline size_t getFreeFrameCount()
-			{
-				return m_FreeFrames.size();
-			}
+			void setData(uint64_t addr, const uint8_t* data, size_t dataLen);
 
 			inline void* getInfo()
 			{
@@ -272,7 +401,57 @@ namespace pcpp
 			void* m_Buffer;
 			uint16_t m_FrameSize;
 			uint16_t m_FrameCount;
-			std::vector<uint64_t> m_FreeFrames;
+		};
+
+		// a fixed-size stack of the free frames of a range of UMEM frames. It's only used by the thread that uses the
+		// queue it belongs to, so it needs no locking; only the free frame count is read by other threads
+		class XdpFramePool
+		{
+		public:
+			XdpFramePool(uint32_t firstFrame, uint32_t numFrames, uint16_t frameSize);
+
+			inline uint32_t getFrameCount() const
+			{
+				return m_FrameCount;
+			}
+
+			// allocates all the frames or none of them
+			bool allocateFrames(uint64_t frames[], uint32_t count);
+
+			void freeFrames(const uint64_t frames[], uint32_t count);
+
+			void freeFrame(uint64_t addr)
+			{
+				freeFrames(&addr, 1);
+			}
+
+			// may be called from any thread
+			inline size_t getFreeFrameCount() const
+			{
+				return m_FreeFrameCount.load(std::memory_order_relaxed);
+			}
+
+		private:
+			uint64_t m_FrameMask;
+			uint32_t m_FrameCount;
+			uint32_t m_FreeFrameTop;
+			std::unique_ptr<uint64_t[]> m_FreeFrames;
+			std::atomic<size_t> m_FreeFrameCount;
+		};
+
+		// counters written by the thread that uses the queue and read by getStatistics()
+		struct XdpQueueCounters
+		{
+			std::atomic<uint64_t> rxPackets{ 0 };
+			std::atomic<uint64_t> rxBytes{ 0 };
+			std::atomic<uint64_t> rxPollTimeout{ 0 };
+			std::atomic<uint64_t> txSentPackets{ 0 };
+			std::atomic<uint64_t> txSentBytes{ 0 };
+			std::atomic<uint64_t> txCompletedPackets{ 0 };
+			std::atomic<uint64_t> rxRingId{ 0 };
+			std::atomic<uint64_t> txRingId{ 0 };
+			std::atomic<uint64_t> fqRingId{ 0 };
+			std::atomic<uint64_t> cqRingId{ 0 };
 		};
 
 		struct XdpPrevDeviceStats
@@ -285,23 +464,55 @@ namespace pcpp
 			uint64_t txCompletedPackets;
 		};
 
+		// an AF_XDP socket bound to a NIC queue, with its fill and completion rings
+		struct XdpQueue
+		{
+			XdpQueue(uint32_t queueId, XdpUmem* umem, uint32_t firstFrame, uint32_t numFrames, uint32_t maxBatchSize)
+			    : queueId(queueId), umem(umem), framePool(firstFrame, numFrames, umem->getFrameSize()),
+			      frameBatch(new uint64_t[maxBatchSize]), maxBatchSize(maxBatchSize), socketInfo(nullptr), prevStats()
+			{}
+
+			uint32_t queueId;
+			XdpUmem* umem;
+			XdpFramePool framePool;
+			// room for the frames of a fill ring refill or a send, so they don't need an allocation
+			std::unique_ptr<uint64_t[]> frameBatch;
+			// the frames of the packets passed to the receive callback, freed when the callback returns
+			std::vector<uint64_t> receivedFrames;
+			uint32_t maxBatchSize;
+			void* socketInfo;
+			XdpQueueCounters counters;
+			XdpPrevDeviceStats prevStats;
+		};
+
 		std::string m_InterfaceName;
 		XdpDeviceConfiguration* m_Config;
 		bool m_ReceivingPackets;
-		XdpUmem* m_Umem;
-		void* m_SocketInfo;
+		std::vector<std::unique_ptr<XdpUmem>> m_Umems;
+		std::vector<std::unique_ptr<XdpQueue>> m_Queues;
+		std::vector<std::thread> m_ReceiveThreads;
+		std::atomic<bool> m_StopReceiveThreads;
 		XdpDeviceStats m_Stats;
 		XdpPrevDeviceStats m_PrevStats;
 
-		bool sendPackets(const std::function<RawPacket(uint32_t)>& getPacketAt,
-		                 const std::function<uint32_t()>& getPacketCount, bool waitForTxCompletion = false,
-		                 int waitForTxCompletionTimeoutMS = 5000);
-		bool populateFillRing(uint32_t count, uint32_t rxId = 0);
-		bool populateFillRing(const std::vector<uint64_t>& addresses, uint32_t rxId);
-		uint32_t checkCompletionRing();
-		bool configureSocket();
-		bool initUmem();
+		bool sendPackets(XdpQueue& queue, const std::function<const RawPacket&(uint32_t)>& getPacketAt,
+		                 uint32_t packetCount, bool waitForTxCompletion, int waitForTxCompletionTimeoutMS);
+		bool transmitFrames(XdpQueue& queue, const std::function<std::pair<uint64_t, uint32_t>(uint32_t)>& getFrameAt,
+		                    uint32_t frameCount, bool waitForTxCompletion, int waitForTxCompletionTimeoutMS);
+		uint32_t peekReceivedPackets(XdpQueue& queue, std::vector<RawPacket>& receiveBuffer);
+		bool releaseReceivedPackets(XdpQueue& queue, uint32_t count);
+		void receiveThreadMain(XdpQueue* queue, int coreId, OnQueuePacketsArrive onPacketsArrive,
+		                       void* onPacketsArriveUserCookie);
+		bool populateFillRing(XdpQueue& queue, uint32_t count);
+		uint32_t checkCompletionRing(XdpQueue& queue);
+		XdpQueue* getQueue(uint32_t queueId) const;
+		bool configureSocket(XdpQueue& queue);
+		bool initQueues();
 		bool initConfig();
-		bool getSocketStats();
+		void destroyQueues();
+		bool getSocketStats(const XdpQueue& queue, XdpDeviceStats& stats);
+		void collectQueueStats(const XdpQueue& queue, XdpDeviceStats& stats);
+		void collectStats();
+		static void updateRates(XdpDeviceStats& stats, XdpPrevDeviceStats& prevStats);
 	};
 }  // namespace pcpp
@@ -0,0 +1,544 @@
+#define LOG_MODULE PcapLogModuleLiveDevice
+
+#include "BpfThreadedProgram.h"
+#include "Logger.h"
+#include <string.h>
+#if defined(_WIN32)
+#	include <winsock2.h>
+#endif
+#include "pcap.h"
+
+namespace pcpp
+{
+	// the limits libpcap and the kernel enforce on classic BPF programs
+	static constexpr uint32_t MaxBpfInstructions = 4096;
+	static constexpr uint32_t BpfScratchMemoryWords = 16;
+
+	/// The registers and the packet a program runs on
+	struct BpfThreadedProgram::State
+	{
+		uint32_t A;
+		uint32_t X;
+		const uint8_t* packet;
+		uint32_t captureLength;
+		uint32_t wireLength;
+		uint32_t result;
+		uint32_t mem[BpfScratchMemoryWords];
+	};
+
+	/// A decoded instruction. The handler executes the instruction and returns the next instruction to execute, or
+	/// nullptr once the program returned
+	struct BpfThreadedProgram::Instruction
+	{
+		typedef const Instruction* (*Handler)(const Instruction* insn, State& state);
+
+		Handler handler;
+		uint32_t k;
+		const Instruction* jumpTrue;
+		const Instruction* jumpFalse;
+	};
+
+	namespace
+	{
+		typedef BpfThreadedProgram::Instruction Instruction;
+		typedef BpfThreadedProgram::State State;
+
+		enum AluOperation
+		{
+			AluAdd,
+			AluSub,
+			AluMul,
+			AluDiv,
+			AluMod,
+			AluAnd,
+			AluOr,
+			AluXor,
+			AluLsh,
+			AluRsh
+		};
+
+		enum JumpCondition
+		{
+			JumpGreater,
+			JumpGreaterOrEqual,
+			JumpEqual,
+			JumpSet
+		};
+
+		inline uint32_t readBytes(const uint8_t* ptr, uint32_t size)
+		{
+			switch (size)
+			{
+			case 4:
+				return (static_cast<uint32_t>(ptr[0]) << 24) | (static_cast<uint32_t>(ptr[1]) << 16) |
+				       (static_cast<uint32_t>(ptr[2]) << 8) | ptr[3];
+			case 2:
+				return (static_cast<uint32_t>(ptr[0]) << 8) | ptr[1];
+			default:
+				return ptr[0];
+			}
+		}
+
+		inline const Instruction* returnValue(State& state, uint32_t value)
+		{
+			state.result = value;
+			return nullptr;
+		}
+
+		template <uint32_t Size> const Instruction* loadAbsolute(const Instruction* insn, State& state)
+		{
+			if (insn->k > state.captureLength || Size > state.captureLength - insn->k)
+				return returnValue(state, 0);
+
+			state.A = readBytes(state.packet + insn->k, Size);
+			return insn + 1;
+		}
+
+		template <uint32_t Size> const Instruction* loadIndirect(const Instruction* insn, State& state)
+		{
+			if (insn->k > state.captureLength || state.X > state.captureLength - insn->k ||
+			    Size > state.captureLength - insn->k - state.X)
+				return returnValue(state, 0);
+
+			state.A = readBytes(state.packet + insn->k + state.X, Size);
+			return insn + 1;
+		}
+
+		// a load followed by "jeq #k" is the most common pair in compiled filters (EtherType, IP protocol and port
+		// checks), so it's executed by a single handler. The jeq instruction is still translated on its own since
+		// other instructions may jump to it
+		template <uint32_t Size> const Instruction* loadAbsoluteJumpEqual(const Instruction* insn, State& state)
+		{
+			if (insn->k > state.captureLength || Size > state.captureLength - insn->k)
+				return returnValue(state, 0);
+
+			state.A = readBytes(state.packet + insn->k, Size);
+			const Instruction* jump = insn + 1;
+			return state.A == jump->k ? jump->jumpTrue : jump->jumpFalse;
+		}
+
+		const Instruction* loadLength(const Instruction* insn, State& state)
+		{
+			state.A = state.wireLength;
+			return insn + 1;
+		}
+
+		const Instruction* loadImmediate(const Instruction* insn, State& state)
+		{
+			state.A = insn->k;
+			return insn + 1;
+		}
+
+		const Instruction* loadMemory(const Instruction* insn, State& state)
+		{
+			state.A = state.mem[insn->k];
+			return insn + 1;
+		}
+
+		const Instruction* loadXLength(const Instruction* insn, State& state)
+		{
+			state.X = state.wireLength;
+			return insn + 1;
+		}
+
+		const Instruction* loadXImmediate(const Instruction* insn, State& state)
+		{
+			state.X = insn->k;
+			return insn + 1;
+		}
+
+		const Instruction* loadXMemory(const Instruction* insn, State& state)
+		{
+			state.X = state.mem[insn->k];
+			return insn + 1;
+		}
+
+		// "ldxb 4*([k]&0xf)", used to skip the IPv4 header
+		const Instruction* loadXHeaderLength(const Instruction* insn, State& state)
+		{
+			if (insn->k >= state.captureLength)
+				return returnValue(state, 0);
+
+			state.X = (state.packet[insn->k] & 0xf) << 2;
+			return insn + 1;
+		}
+
+		const Instruction* store(const Instruction* insn, State& state)
+		{
+			state.mem[insn->k] = state.A;
+			return insn + 1;
+		}
+
+		const Instruction* storeX(const Instruction* insn, State& state)
+		{
+			state.mem[insn->k] = state.X;
+			return insn + 1;
+		}
+
+		template <AluOperation Operation, bool UseX> const Instruction* alu(const Instruction* insn, State& state)
+		{
+			const uint32_t operand = UseX ? state.X : insn->k;
+			switch (Operation)
+			{
+			case AluAdd:
+				state.A += operand;
+				break;
+			case AluSub:
+				state.A -= operand;
+				break;
+			case AluMul:
+				state.A *= operand;
+				break;
+			case AluDiv:
+				// division by a zero constant is rejected by translate()
+				if (operand == 0)
+					return returnValue(state, 0);
+				state.A /= operand;
+				break;
+			case AluMod:
+				if (operand == 0)
+					return returnValue(state, 0);
+				state.A %= operand;
+				break;
+			case AluAnd:
+				state.A &= operand;
+				break;
+			case AluOr:
+				state.A |= operand;
+				break;
+			case AluXor:
+				state.A ^= operand;
+				break;
+			case AluLsh:
+				state.A = operand < 32 ? state.A << operand : 0;
+				break;
+			case AluRsh:
+				state.A = operand < 32 ? state.A >> operand : 0;
+				break;
+			}
+
+			return insn + 1;
+		}
+
+		const Instruction* aluNegate(const Instruction* insn, State& state)
+		{
+			state.A = 0U - state.A;
+			return insn + 1;
+		}
+
+		const Instruction* jumpAlways(const Instruction* insn, State& state)
+		{
+			(void)state;
+			return insn->jumpTrue;
+		}
+
+		template <JumpCondition Condition, bool UseX> const Instruction* jump(const Instruction* insn, State& state)
+		{
+			const uint32_t operand = UseX ? state.X : insn->k;
+			bool result;
+			switch (Condition)
+			{
+			case JumpGreater:
+				result = state.A > operand;
+				break;
+			case JumpGreaterOrEqual:
+				result = state.A >= operand;
+				break;
+			case JumpEqual:
+				result = state.A == operand;
+				break;
+			default:
+				result = (state.A & operand) != 0;
+				break;
+			}
+
+			return result ? insn->jumpTrue : insn->jumpFalse;
+		}
+
+		const Instruction* returnConstant(const Instruction* insn, State& state)
+		{
+			return returnValue(state, insn->k);
+		}
+
+		const Instruction* returnA(const Instruction* insn, State& state)
+		{
+			(void)insn;
+			return returnValue(state, state.A);
+		}
+
+		const Instruction* transferAToX(const Instruction* insn, State& state)
+		{
+			state.X = state.A;
+			return insn + 1;
+		}
+
+		const Instruction* transferXToA(const Instruction* insn, State& state)
+		{
+			state.A = state.X;
+			return insn + 1;
+		}
+
+		template <AluOperation Operation> Instruction::Handler aluHandler(uint16_t source)
+		{
+			return BPF_SRC(source) == BPF_X ? &alu<Operation, true> : &alu<Operation, false>;
+		}
+
+		template <JumpCondition Condition> Instruction::Handler jumpHandler(uint16_t source)
+		{
+			return BPF_SRC(source) == BPF_X ? &jump<Condition, true> : &jump<Condition, false>;
+		}
+
+		// returns the handler of an instruction, or nullptr if the instruction isn't supported
+		Instruction::Handler getHandler(const bpf_insn& insn)
+		{
+			switch (BPF_CLASS(insn.code))
+			{
+			case BPF_LD:
+				switch (insn.code)
+				{
+				case BPF_LD | BPF_W | BPF_ABS:
+					return &loadAbsolute<4>;
+				case BPF_LD | BPF_H | BPF_ABS:
+					return &loadAbsolute<2>;
+				case BPF_LD | BPF_B | BPF_ABS:
+					return &loadAbsolute<1>;
+				case BPF_LD | BPF_W | BPF_IND:
+					return &loadIndirect<4>;
+				case BPF_LD | BPF_H | BPF_IND:
+					return &loadIndirect<2>;
+				case BPF_LD | BPF_B | BPF_IND:
+					return &loadIndirect<1>;
+				case BPF_LD | BPF_W | BPF_LEN:
+					return &loadLength;
+				case BPF_LD | BPF_IMM:
+					return &loadImmediate;
+				case BPF_LD | BPF_MEM:
+					return &loadMemory;
+				default:
+					return nullptr;
+				}
+			case BPF_LDX:
+				switch (insn.code)
+				{
+				case BPF_LDX | BPF_W | BPF_LEN:
+					return &loadXLength;
+				case BPF_LDX | BPF_W | BPF_IMM:
+					return &loadXImmediate;
+				case BPF_LDX | BPF_W | BPF_MEM:
+					return &loadXMemory;
+				case BPF_LDX | BPF_B | BPF_MSH:
+					return &loadXHeaderLength;
+				default:
+					return nullptr;
+				}
+			case BPF_ST:
+				return &store;
+			case BPF_STX:
+				return &storeX;
+			case BPF_ALU:
+				switch (BPF_OP(insn.code))
+				{
+				case BPF_ADD:
+					return aluHandler<AluAdd>(insn.code);
+				case BPF_SUB:
+					return aluHandler<AluSub>(insn.code);
+				case BPF_MUL:
+					return aluHandler<AluMul>(insn.code);
+				case BPF_DIV:
+					return aluHandler<AluDiv>(insn.code);
+				case BPF_MOD:
+					return aluHandler<AluMod>(insn.code);
+				case BPF_AND:
+					return aluHandler<AluAnd>(insn.code);
+				case BPF_OR:
+					return aluHandler<AluOr>(insn.code);
+				case BPF_XOR:
+					return aluHandler<AluXor>(insn.code);
+				case BPF_LSH:
+					return aluHandler<AluLsh>(insn.code);
+				case BPF_RSH:
+					return aluHandler<AluRsh>(insn.code);
+				case BPF_NEG:
+					return &aluNegate;
+				default:
+					return nullptr;
+				}
+			case BPF_JMP:
+				switch (BPF_OP(insn.code))
+				{
+				case BPF_JA:
+					return &jumpAlways;
+				case BPF_JGT:
+					return jumpHandler<JumpGreater>(insn.code);
+				case BPF_JGE:
+					return jumpHandler<JumpGreaterOrEqual>(insn.code);
+				case BPF_JEQ:
+					return jumpHandler<JumpEqual>(insn.code);
+				case BPF_JSET:
+					return jumpHandler<JumpSet>(insn.code);
+				default:
+					return nullptr;
+				}
+			case BPF_RET:
+				switch (BPF_RVAL(insn.code))
+				{
+				case BPF_K:
+					return &returnConstant;
+				case BPF_A:
+					return &returnA;
+				default:
+					return nullptr;
+				}
+			case BPF_MISC:
+				switch (BPF_MISCOP(insn.code))
+				{
+				case BPF_TAX:
+					return &transferAToX;
+				case BPF_TXA:
+					return &transferXToA;
+				default:
+					return nullptr;
+				}
+			default:
+				return nullptr;
+			}
+		}
+
+		Instruction::Handler getFusedLoadJumpHandler(const bpf_insn& load, const bpf_insn& jump)
+		{
+			if (jump.code != (BPF_JMP | BPF_JEQ | BPF_K))
+				return nullptr;
+
+			switch (load.code)
+			{
+			case BPF_LD | BPF_W | BPF_ABS:
+				return &loadAbsoluteJumpEqual<4>;
+			case BPF_LD | BPF_H | BPF_ABS:
+				return &loadAbsoluteJumpEqual<2>;
+			case BPF_LD | BPF_B | BPF_ABS:
+				return &loadAbsoluteJumpEqual<1>;
+			default:
+				return nullptr;
+			}
+		}
+
+		bool usesScratchMemory(const bpf_insn& insn)
+		{
+			return insn.code == (BPF_LD | BPF_MEM) || insn.code == (BPF_LDX | BPF_W | BPF_MEM) ||
+			       BPF_CLASS(insn.code) == BPF_ST || BPF_CLASS(insn.code) == BPF_STX;
+		}
+	}  // namespace
+
+	BpfThreadedProgram::BpfThreadedProgram() : m_InstructionCount(0), m_UsesScratchMemory(false)
+	{}
+
+	BpfThreadedProgram::~BpfThreadedProgram() = default;
+
+	bool BpfThreadedProgram::translate(const bpf_program* program)
+	{
+		m_Instructions.reset();
+		m_InstructionCount = 0;
+		m_UsesScratchMemory = false;
+
+		if (program == nullptr || program->bf_insns == nullptr || program->bf_len == 0 ||
+		    program->bf_len > MaxBpfInstructions)
+		{
+			PCPP_LOG_DEBUG("Cannot translate an empty or too long BPF program");
+			return false;
+		}
+
+		const uint32_t count = program->bf_len;
+		const bpf_insn* insns = program->bf_insns;
+		if (BPF_CLASS(insns[count - 1].code) != BPF_RET)
+		{
+			PCPP_LOG_DEBUG("BPF program doesn't end with a return instruction");
+			return false;
+		}
+
+		std::unique_ptr<Instruction[]> translated(new Instruction[count]);
+		bool usesMemory = false;
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			const bpf_insn& insn = insns[i];
+			Instruction& result = translated[i];
+			result.handler = getHandler(insn);
+			result.k = insn.k;
+			result.jumpTrue = nullptr;
+			result.jumpFalse = nullptr;
+
+			if (result.handler == nullptr)
+			{
+				PCPP_LOG_DEBUG("Unsupported BPF instruction 0x" << std::hex << insn.code << " at index " << std::dec
+				                                                << i);
+				return false;
+			}
+
+			if (usesScratchMemory(insn))
+			{
+				if (insn.k >= BpfScratchMemoryWords)
+				{
+					PCPP_LOG_DEBUG("Invalid BPF scratch memory index at index " << i);
+					return false;
+				}
+				usesMemory = true;
+			}
+
+			if (BPF_CLASS(insn.code) == BPF_ALU && (BPF_OP(insn.code) == BPF_DIV || BPF_OP(insn.code) == BPF_MOD) &&
+			    BPF_SRC(insn.code) == BPF_K && insn.k == 0)
+			{
+				PCPP_LOG_DEBUG("BPF division by zero at index " << i);
+				return false;
+			}
+
+			if (BPF_CLASS(insn.code) == BPF_JMP)
+			{
+				// jumps are relative to the next instruction and can only go forward
+				uint64_t trueTarget = static_cast<uint64_t>(i) + 1 + (BPF_OP(insn.code) == BPF_JA ? insn.k : insn.jt);
+				uint64_t falseTarget = static_cast<uint64_t>(i) + 1 + insn.jf;
+				if (trueTarget >= count || (BPF_OP(insn.code) != BPF_JA && falseTarget >= count))
+				{
+					PCPP_LOG_DEBUG("BPF jump out of the program at index " << i);
+					return false;
+				}
+
+				result.jumpTrue = &translated[trueTarget];
+				if (BPF_OP(insn.code) != BPF_JA)
+					result.jumpFalse = &translated[falseTarget];
+			}
+		}
+
+		for (uint32_t i = 0; i + 1 < count; ++i)
+		{
+			Instruction::Handler fusedHandler = getFusedLoadJumpHandler(insns[i], insns[i + 1]);
+			if (fusedHandler != nullptr)
+				translated[i].handler = fusedHandler;
+		}
+
+		m_Instructions = std::move(translated);
+		m_InstructionCount = count;
+		m_UsesScratchMemory = usesMemory;
+		return true;
+	}
+
+	uint32_t BpfThreadedProgram::run(const uint8_t* packetData, uint32_t wireLength, uint32_t captureLength) const
+	{
+		if (m_Instructions == nullptr)
+			return 0;
+
+		State state;
+		state.A = 0;
+		state.X = 0;
+		state.packet = packetData;
+		state.captureLength = captureLength;
+		state.wireLength = wireLength;
+		state.result = 0;
+		if (m_UsesScratchMemory)
+			memset(state.mem, 0, sizeof(state.mem));
+
+		const Instruction* insn = m_Instructions.get();
+		while (insn != nullptr)
+			insn = insn->handler(insn, state);
+
+		return state.result;
+	}
+}  // namespace pcpp
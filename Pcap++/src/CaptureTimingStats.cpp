@@ -0,0 +1,183 @@
+#include "CaptureTimingStats.h"
+#include <limits>
+#if !defined(_WIN32)
+#	include <time.h>
+#endif
+
+namespace pcpp
+{
+	namespace
+	{
+		/// @return The CPU time used by the calling thread in nanoseconds, or 0 if it isn't available
+		uint64_t getThreadCpuTimeNs()
+		{
+#if !defined(_WIN32)
+			timespec cpuTime;
+			if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpuTime) == 0)
+				return static_cast<uint64_t>(cpuTime.tv_sec) * 1000000000 + static_cast<uint64_t>(cpuTime.tv_nsec);
+#endif
+			return 0;
+		}
+	}  // namespace
+
+	void TimingHistogram::record(uint64_t value, uint64_t count)
+	{
+		if (count == 0)
+			return;
+
+		m_Buckets[getBucketIndex(value)] += count;
+		m_Count += count;
+		m_Sum += value * count;
+		if (value < m_Min)
+			m_Min = value;
+		if (value > m_Max)
+			m_Max = value;
+	}
+
+	void TimingHistogram::merge(const TimingHistogram& other)
+	{
+		if (other.m_Count == 0)
+			return;
+
+		for (size_t i = 0; i < BucketCount; ++i)
+			m_Buckets[i] += other.m_Buckets[i];
+
+		m_Count += other.m_Count;
+		m_Sum += other.m_Sum;
+		if (other.m_Min < m_Min)
+			m_Min = other.m_Min;
+		if (other.m_Max > m_Max)
+			m_Max = other.m_Max;
+	}
+
+	void TimingHistogram::reset()
+	{
+		m_Buckets.fill(0);
+		m_Count = 0;
+		m_Min = std::numeric_limits<uint64_t>::max();
+		m_Max = 0;
+		m_Sum = 0;
+	}
+
+	uint64_t TimingHistogram::getValueAtPercentile(double percentile) const
+	{
+		if (m_Count == 0)
+			return 0;
+
+		if (percentile < 0)
+			percentile = 0;
+		else if (percentile > 100)
+			percentile = 100;
+
+		// the rank of the value, counting from 1, so the 0th percentile is the smallest value
+		uint64_t rank = static_cast<uint64_t>(percentile / 100 * static_cast<double>(m_Count) + 0.5);
+		if (rank == 0)
+			rank = 1;
+
+		uint64_t seen = 0;
+		for (size_t i = 0; i < BucketCount; ++i)
+		{
+			seen += m_Buckets[i];
+			if (seen >= rank)
+			{
+				uint64_t upperBound = getBucketUpperBound(i);
+				return upperBound < m_Max ? upperBound : m_Max;
+			}
+		}
+
+		return m_Max;
+	}
+
+	uint64_t TimingHistogram::getBucketLowerBound(size_t index)
+	{
+		if (index < SubBucketCount)
+			return index;
+
+		size_t group = index / SubBucketCount;
+		uint64_t subBucket = index % SubBucketCount;
+		return (SubBucketCount + subBucket) << (group - 1);
+	}
+
+	uint64_t TimingHistogram::getBucketUpperBound(size_t index)
+	{
+		if (index + 1 >= BucketCount)
+			return std::numeric_limits<uint64_t>::max();
+
+		return getBucketLowerBound(index + 1) - 1;
+	}
+
+	namespace internal
+	{
+		void AtomicTimingHistogram::addTo(TimingHistogram& histogram) const
+		{
+			// the total is summed from the buckets rather than kept in its own counter, so it always matches them even
+			// while the recording thread is running
+			uint64_t count = 0;
+			for (size_t i = 0; i < TimingHistogram::BucketCount; ++i)
+			{
+				uint64_t bucketCount = m_Buckets[i].load(std::memory_order_relaxed);
+				histogram.m_Buckets[i] += bucketCount;
+				count += bucketCount;
+			}
+
+			if (count == 0)
+				return;
+
+			histogram.m_Count += count;
+			histogram.m_Sum += m_Sum.load(std::memory_order_relaxed);
+			uint64_t minValue = m_Min.load(std::memory_order_relaxed);
+			uint64_t maxValue = m_Max.load(std::memory_order_relaxed);
+			if (minValue < histogram.m_Min)
+				histogram.m_Min = minValue;
+			if (maxValue > histogram.m_Max)
+				histogram.m_Max = maxValue;
+		}
+
+		void AtomicTimingHistogram::reset()
+		{
+			for (auto& bucket : m_Buckets)
+				bucket.store(0, std::memory_order_relaxed);
+
+			m_Min.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+			m_Max.store(0, std::memory_order_relaxed);
+			m_Sum.store(0, std::memory_order_relaxed);
+		}
+
+		void CaptureTimingRecorder::beginCapture()
+		{
+			m_LastThreadCpuTime = getThreadCpuTimeNs();
+		}
+
+		void CaptureTimingRecorder::recordDispatch(int result)
+		{
+			if (result >= 0)
+				m_DispatchBatchSize.record(static_cast<uint64_t>(result));
+
+			// only the time between the dispatch rounds of this capture is counted, not the time the thread spent
+			// before it (a blocking mode capture runs on the user's thread)
+			uint64_t threadCpuTime = getThreadCpuTimeNs();
+			m_CpuTimeNs.store(m_CpuTimeNs.load(std::memory_order_relaxed) + (threadCpuTime - m_LastThreadCpuTime),
+			                  std::memory_order_relaxed);
+			m_LastThreadCpuTime = threadCpuTime;
+		}
+
+		void CaptureTimingRecorder::addTo(CaptureTimingStats& stats) const
+		{
+			m_TimestampToCallback.addTo(stats.timestampToCallbackNs);
+			m_CallbackDuration.addTo(stats.callbackDurationNs);
+			m_DispatchBatchSize.addTo(stats.dispatchBatchSize);
+			stats.futureTimestampCount += m_FutureTimestampCount.load(std::memory_order_relaxed);
+			stats.captureThreadCpuTimeNs += m_CpuTimeNs.load(std::memory_order_relaxed);
+			stats.threadCount++;
+		}
+
+		void CaptureTimingRecorder::reset()
+		{
+			m_TimestampToCallback.reset();
+			m_CallbackDuration.reset();
+			m_DispatchBatchSize.reset();
+			m_FutureTimestampCount.store(0, std::memory_order_relaxed);
+			m_CpuTimeNs.store(0, std::memory_order_relaxed);
+		}
+	}  // namespace internal
+}  // namespace pcpp
@@ -547,11 +547,11 @@ namespace pcpp
 			m_PMDType = PMD_IXGBEVF;
 		else if (m_PMDName == "librte_pmd_mlx4")
 			m_PMDType = PMD_MLX4;
-		else if (m_PMDName == "eth_null")
+		else if (m_PMDName == "eth_null" || m_PMDName == "net_null")
 			m_PMDType = PMD_NULL;
-		else if (m_PMDName == "eth_pcap")
+		else if (m_PMDName == "eth_pcap" || m_PMDName == "net_pcap")
 			m_PMDType = PMD_PCAP;
-		else if (m_PMDName == "eth_ring")
+		else if (m_PMDName == "eth_ring" || m_PMDName == "net_ring")
 			m_PMDType = PMD_RING;
 		else if (m_PMDName == "rte_virtio_pmd")
 			m_PMDType = PMD_VIRTIO;
@@ -590,6 +590,7 @@ namespace pcpp
 		case PMD_IGBVF:
 		case PMD_I40EVF:
 		case PMD_IXGBEVF:
+		case PMD_NULL:
 		case PMD_PCAP:
 		case PMD_RING:
 		case PMD_VIRTIO:
@@ -772,7 +773,6 @@ namespace pcpp
 	int DpdkDevice::dpdkCaptureThreadMain(void* ptr)
 	{
 		DpdkDevice* pThis = (DpdkDevice*)ptr;
-		struct rte_mbuf* mBufArray[MAX_BURST_SIZE];
 
 		if (pThis == nullptr)
 		{
@@ -785,9 +785,12 @@ namespace pcpp
 
 		int queueId = pThis->m_CoreConfiguration[coreId].RxQueueId;
 
+		// the raw packets are constructed once and rebound to the mbufs of every burst
+		DpdkPacketBurst burst(MAX_BURST_SIZE, false);
+
 		while (likely(!pThis->m_StopThread))
 		{
-			uint32_t numOfPktsReceived = rte_eth_rx_burst(pThis->m_Id, queueId, mBufArray, MAX_BURST_SIZE);
+			uint16_t numOfPktsReceived = rte_eth_rx_burst(pThis->m_Id, queueId, burst.m_MBufs.get(), MAX_BURST_SIZE);
 
 			if (unlikely(numOfPktsReceived == 0))
 				continue;
@@ -795,17 +798,15 @@ namespace pcpp
 			timespec time;
 			clock_gettime(CLOCK_REALTIME, &time);
 
+			burst.bind(numOfPktsReceived, time);
+
 			if (likely(pThis->m_OnPacketsArriveCallback != nullptr))
 			{
-				MBufRawPacket rawPackets[MAX_BURST_SIZE];
-				for (uint32_t index = 0; index < numOfPktsReceived; ++index)
-				{
-					rawPackets[index].setMBuf(mBufArray[index], time);
-				}
-
-				pThis->m_OnPacketsArriveCallback(rawPackets, numOfPktsReceived, coreId, pThis,
+				pThis->m_OnPacketsArriveCallback(burst.getRawPackets(), numOfPktsReceived, coreId, pThis,
 				                                 pThis->m_OnPacketsArriveUserCookie);
 			}
+
+			burst.release();
 		}
 
 		PCPP_LOG_DEBUG("Exiting capture thread " << coreId);
@@ -1025,6 +1026,48 @@ namespace pcpp
 		return packetsReceived;
 	}
 
+	uint16_t DpdkDevice::receivePackets(DpdkPacketBurst& burst, uint16_t rxQueueId) const
+	{
+		if (unlikely(!m_DeviceOpened))
+		{
+			PCPP_LOG_ERROR("Device not opened");
+			return 0;
+		}
+
+		if (unlikely(!m_StopThread))
+		{
+			PCPP_LOG_ERROR("DpdkDevice capture mode is currently running. Cannot receive packets in parallel");
+			return 0;
+		}
+
+		if (unlikely(rxQueueId >= m_TotalAvailableRxQueues))
+		{
+			PCPP_LOG_ERROR("RX queue ID #" << rxQueueId << " not available for this device");
+			return 0;
+		}
+
+		if (unlikely(burst.m_Capacity == 0))
+		{
+			PCPP_LOG_ERROR("Cannot receive packets into a packet burst with capacity 0");
+			return 0;
+		}
+
+		burst.release();
+
+		uint16_t packetsReceived = rte_eth_rx_burst(m_Id, rxQueueId, burst.m_MBufs.get(), burst.m_Capacity);
+		if (unlikely(!packetsReceived))
+		{
+			return 0;
+		}
+
+		timespec time;
+		clock_gettime(CLOCK_REALTIME, &time);
+
+		burst.bind(packetsReceived, time);
+
+		return packetsReceived;
+	}
+
 	uint16_t DpdkDevice::flushTxBuffer(bool flushOnlyIfTimeoutExpired, uint16_t txQueueId)
 	{
 		bool flush = true;
@@ -1573,6 +1616,59 @@ namespace pcpp
 		return result;
 	}
 
+	/// =====================
+	/// Class DpdkPacketBurst
+	/// =====================
+
+	DpdkPacketBurst::DpdkPacketBurst(uint16_t capacity, bool parsePackets, OsiModelLayer parseUntilLayer)
+	    : m_Capacity(capacity), m_Count(0), m_ParsePackets(parsePackets), m_ParseUntilLayer(parseUntilLayer)
+	{
+		if (capacity == 0)
+		{
+			PCPP_LOG_ERROR("Packet burst capacity must be greater than 0");
+			return;
+			// throw std::invalid_argument("Packet burst capacity must be greater than 0");
+		}
+
+		m_MBufs.reset(new rte_mbuf*[capacity]);
+		m_RawPackets.reset(new MBufRawPacket[capacity]);
+		if (parsePackets)
+		{
+			m_Packets.reset(new Packet[capacity]);
+		}
+	}
+
+	DpdkPacketBurst::~DpdkPacketBurst()
+	{
+		release();
+	}
+
+	void DpdkPacketBurst::bind(uint16_t count, timespec timestamp)
+	{
+		for (uint16_t index = 0; index < count; ++index)
+		{
+			m_RawPackets[index].setMBuf(m_MBufs[index], timestamp);
+			if (m_ParsePackets)
+			{
+				m_Packets[index].setRawPacket(&m_RawPackets[index], false, UnknownProtocol, m_ParseUntilLayer);
+			}
+		}
+
+		m_Count = count;
+	}
+
+	void DpdkPacketBurst::release()
+	{
+		for (uint16_t index = 0; index < m_Count; ++index)
+		{
+			// frees the mbuf unless it was handed over to DPDK by a send method
+			m_RawPackets[index].clear();
+			m_RawPackets[index].setFreeMbuf(true);
+		}
+
+		m_Count = 0;
+	}
+
 }  // namespace pcpp
 
 // GCOVR_EXCL_STOP
@@ -0,0 +1,308 @@
+#define LOG_MODULE PcapLogModuleLiveDevice
+
+#include "FilterSet.h"
+#include "Logger.h"
+#include <string.h>
+
+namespace pcpp
+{
+	namespace internal
+	{
+		PrefixTrie::PrefixTrie() : m_Nodes(1), m_RuleCount(0)
+		{}
+
+		void PrefixTrie::insert(const uint8_t* key, uint32_t prefixLength, uint32_t ruleId)
+		{
+			uint32_t nodeIndex = 0;
+			for (uint32_t bit = 0; bit < prefixLength; ++bit)
+			{
+				uint8_t branch = (key[bit / 8] >> (7 - bit % 8)) & 1;
+				uint32_t childIndex = m_Nodes[nodeIndex].children[branch];
+				if (childIndex == 0)
+				{
+					// m_Nodes may reallocate, so the parent is looked up again after adding the child
+					childIndex = static_cast<uint32_t>(m_Nodes.size());
+					m_Nodes.emplace_back();
+					m_Nodes[nodeIndex].children[branch] = childIndex;
+				}
+
+				nodeIndex = childIndex;
+			}
+
+			m_Nodes[nodeIndex].rules.push_back(ruleId);
+			++m_RuleCount;
+		}
+
+		void PrefixTrie::clear()
+		{
+			m_Nodes.clear();
+			m_Nodes.emplace_back();
+			m_RuleCount = 0;
+		}
+	}  // namespace internal
+
+	namespace
+	{
+		constexpr uint32_t PortBits = 16;
+
+		inline void toBytes(uint32_t value, uint8_t* bytes)
+		{
+			bytes[0] = static_cast<uint8_t>(value >> 24);
+			bytes[1] = static_cast<uint8_t>(value >> 16);
+			bytes[2] = static_cast<uint8_t>(value >> 8);
+			bytes[3] = static_cast<uint8_t>(value);
+		}
+
+		inline void toBytes(uint16_t value, uint8_t* bytes)
+		{
+			bytes[0] = static_cast<uint8_t>(value >> 8);
+			bytes[1] = static_cast<uint8_t>(value);
+		}
+
+		/// The number of packet bits an indexable instruction fixes, which is used to pick the most selective one.
+		/// 0 means the instruction can't be used as an index
+		uint32_t getSelectivity(const NativeFilter::Instruction& insn)
+		{
+			switch (insn.opcode)
+			{
+			case NativeFilter::MatchIPv4Network:
+			case NativeFilter::MatchIPv6Network:
+				return insn.value;
+			case NativeFilter::MatchPort:
+				return insn.value <= 0xffff ? PortBits : 0;
+			case NativeFilter::MatchPortRange:
+			{
+				if (insn.value > insn.value2)
+					return PortBits;
+
+				uint32_t fixedBits = PortBits;
+				for (uint32_t rangeSize = insn.value2 - insn.value + 1; rangeSize > 1; rangeSize >>= 1)
+					--fixedBits;
+				return fixedBits;
+			}
+			default:
+				return 0;
+			}
+		}
+
+		/// Find the most selective instruction which must match for the whole program to match, i.e. a predicate
+		/// which is only combined with others by LogicalAnd. Returns the instruction count if there's none
+		size_t findIndexInstruction(const std::vector<NativeFilter::Instruction>& instructions)
+		{
+			// for every stack entry, the best necessary predicate of the sub-expression and its selectivity
+			struct Entry
+			{
+				size_t instructionIndex;
+				uint32_t selectivity;
+			};
+
+			const Entry none = { instructions.size(), 0 };
+			std::vector<Entry> stack;
+			for (size_t i = 0; i < instructions.size(); ++i)
+			{
+				switch (instructions[i].opcode)
+				{
+				case NativeFilter::LogicalAnd:
+				{
+					Entry right = stack.back();
+					stack.pop_back();
+					if (right.selectivity > stack.back().selectivity)
+						stack.back() = right;
+					break;
+				}
+				case NativeFilter::LogicalOr:
+					stack.pop_back();
+					stack.back() = none;
+					break;
+				case NativeFilter::LogicalNot:
+					stack.back() = none;
+					break;
+				default:
+				{
+					uint32_t selectivity = getSelectivity(instructions[i]);
+					stack.push_back(selectivity > 0 ? Entry{ i, selectivity } : none);
+					break;
+				}
+				}
+			}
+
+			return stack.empty() ? instructions.size() : stack.back().instructionIndex;
+		}
+	}  // namespace
+
+	FilterSet::FilterSet(LinkLayerType bpfLinkType) : m_BpfLinkType(bpfLinkType)
+	{}
+
+	int FilterSet::addFilter(GeneralFilter& filter)
+	{
+		uint32_t ruleId = static_cast<uint32_t>(m_NativeFilters.size());
+
+		NativeFilter nativeFilter(filter);
+		if (nativeFilter.isValid())
+		{
+			m_NativeFilters.push_back(nativeFilter);
+			indexRule(ruleId);
+			return static_cast<int>(ruleId);
+		}
+
+		CompiledBpfFilter bpfFilter = filter.compile(m_BpfLinkType);
+		if (!bpfFilter.isValid())
+		{
+			PCPP_LOG_ERROR("Cannot add filter to the filter set");
+			return -1;
+		}
+
+		// BPF rules keep an invalid native filter so rule IDs stay aligned with m_NativeFilters
+		m_NativeFilters.emplace_back();
+		m_BpfRules.push_back({ ruleId, bpfFilter });
+		return static_cast<int>(ruleId);
+	}
+
+	void FilterSet::indexRule(uint32_t ruleId)
+	{
+		const std::vector<NativeFilter::Instruction>& instructions = m_NativeFilters[ruleId].getInstructions();
+		size_t indexInstruction = findIndexInstruction(instructions);
+		if (indexInstruction == instructions.size())
+		{
+			m_UnindexedRules.push_back(ruleId);
+			return;
+		}
+
+		const NativeFilter::Instruction& insn = instructions[indexInstruction];
+		switch (insn.opcode)
+		{
+		case NativeFilter::MatchIPv4Network:
+			if (insn.value == 32)
+			{
+				uint32_t address = (static_cast<uint32_t>(insn.bytes[0]) << 24) |
+				                   (static_cast<uint32_t>(insn.bytes[1]) << 16) |
+				                   (static_cast<uint32_t>(insn.bytes[2]) << 8) | insn.bytes[3];
+				m_IPv4AddressRules[address].push_back(ruleId);
+			}
+			else
+			{
+				m_IPv4NetworkRules.insert(insn.bytes, insn.value, ruleId);
+			}
+			break;
+		case NativeFilter::MatchIPv6Network:
+			m_IPv6NetworkRules.insert(insn.bytes, insn.value, ruleId);
+			break;
+		case NativeFilter::MatchPort:
+			m_PortRules[static_cast<uint16_t>(insn.value)].push_back(ruleId);
+			break;
+		case NativeFilter::MatchPortRange:
+		{
+			// split the range into aligned power-of-two blocks, each of them is a prefix of the port. An empty range
+			// inserts nothing, so the rule never becomes a candidate, which is correct since it can't match
+			uint32_t port = insn.value;
+			while (port <= insn.value2)
+			{
+				uint32_t blockBits = 0;
+				while (blockBits < PortBits && (port & ((1U << (blockBits + 1)) - 1)) == 0 &&
+				       port + (1U << (blockBits + 1)) - 1 <= insn.value2)
+				{
+					++blockBits;
+				}
+
+				uint8_t portBytes[2];
+				toBytes(static_cast<uint16_t>(port), portBytes);
+				m_PortRangeRules.insert(portBytes, PortBits - blockBits, ruleId);
+				port += 1U << blockBits;
+			}
+			break;
+		}
+		default:
+			m_UnindexedRules.push_back(ruleId);
+			break;
+		}
+	}
+
+	size_t FilterSet::matchPacket(const RawPacket* rawPacket, std::vector<bool>& matchingRules) const
+	{
+		matchingRules.assign(m_NativeFilters.size(), false);
+		if (rawPacket == nullptr)
+			return 0;
+
+		FilterFlowKey key;
+		key.extract(rawPacket);
+
+		size_t matchCount = 0;
+		auto evaluateRule = [&](uint32_t ruleId) {
+			// a rule may be found through both the source and the destination of the packet
+			if (!matchingRules[ruleId] && m_NativeFilters[ruleId].matches(key))
+			{
+				matchingRules[ruleId] = true;
+				++matchCount;
+			}
+		};
+
+		auto evaluateRules = [&](const std::vector<uint32_t>& ruleIds) {
+			for (uint32_t ruleId : ruleIds)
+				evaluateRule(ruleId);
+		};
+
+		if ((key.flags & FilterFlowKey::HasIPv4) != 0)
+		{
+			for (uint32_t address : { key.srcIPv4, key.dstIPv4 })
+			{
+				auto iter = m_IPv4AddressRules.find(address);
+				if (iter != m_IPv4AddressRules.end())
+					evaluateRules(iter->second);
+
+				if (!m_IPv4NetworkRules.isEmpty())
+				{
+					uint8_t addressBytes[4];
+					toBytes(address, addressBytes);
+					m_IPv4NetworkRules.lookup(addressBytes, 32, evaluateRule);
+				}
+			}
+		}
+		else if ((key.flags & FilterFlowKey::HasIPv6) != 0 && !m_IPv6NetworkRules.isEmpty())
+		{
+			m_IPv6NetworkRules.lookup(key.srcIPv6, 128, evaluateRule);
+			m_IPv6NetworkRules.lookup(key.dstIPv6, 128, evaluateRule);
+		}
+
+		if ((key.flags & FilterFlowKey::HasPorts) != 0)
+		{
+			for (uint16_t port : { key.srcPort, key.dstPort })
+			{
+				auto iter = m_PortRules.find(port);
+				if (iter != m_PortRules.end())
+					evaluateRules(iter->second);
+
+				if (!m_PortRangeRules.isEmpty())
+				{
+					uint8_t portBytes[2];
+					toBytes(port, portBytes);
+					m_PortRangeRules.lookup(portBytes, PortBits, evaluateRule);
+				}
+			}
+		}
+
+		evaluateRules(m_UnindexedRules);
+
+		for (const auto& bpfRule : m_BpfRules)
+		{
+			if (bpfRule.filter.matches(rawPacket))
+			{
+				matchingRules[bpfRule.ruleId] = true;
+				++matchCount;
+			}
+		}
+
+		return matchCount;
+	}
+
+	void FilterSet::clear()
+	{
+		m_NativeFilters.clear();
+		m_BpfRules.clear();
+		m_UnindexedRules.clear();
+		m_IPv4AddressRules.clear();
+		m_PortRules.clear();
+		m_IPv4NetworkRules.clear();
+		m_IPv6NetworkRules.clear();
+		m_PortRangeRules.clear();
+	}
+}  // namespace pcpp
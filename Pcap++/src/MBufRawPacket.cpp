@@ -147,22 +147,8 @@ namespace pcpp
 		}
 
 		// adjust the size of the mbuf to the new data
-		if (m_RawDataLen < other.m_RawDataLen)
-		{
-			if (rte_pktmbuf_append(m_MBuf, other.m_RawDataLen - m_RawDataLen) == nullptr)
-			{
-				PCPP_LOG_ERROR("Couldn't append " << (other.m_RawDataLen - m_RawDataLen) << " bytes to mbuf");
-				return *this;
-			}
-		}
-		else if (m_RawDataLen > other.m_RawDataLen)
-		{
-			if (rte_pktmbuf_adj(m_MBuf, m_RawDataLen - other.m_RawDataLen) == nullptr)
-			{
-				PCPP_LOG_ERROR("Couldn't remove " << m_RawDataLen - other.m_RawDataLen << " bytes to mbuf");
-				return *this;
-			}
-		}
+		if (!resizeMBufData(other.m_RawDataLen))
+			return *this;
 
 		m_RawPacketSet = false;
 
@@ -196,25 +182,9 @@ namespace pcpp
 		}
 
 		// adjust the size of the mbuf to the new data
-		if (m_RawDataLen < rawDataLen)
-		{
-			if (rte_pktmbuf_append(m_MBuf, rawDataLen - m_RawDataLen) == nullptr)
-			{
-				PCPP_LOG_ERROR("Couldn't append " << (rawDataLen - m_RawDataLen) << " bytes to mbuf");
-				return false;
-			}
-		}
-		else if (m_RawDataLen > rawDataLen)
-		{
-			if (rte_pktmbuf_adj(m_MBuf, m_RawDataLen - rawDataLen) == nullptr)
-			{
-				PCPP_LOG_ERROR("Couldn't remove " << (m_RawDataLen - rawDataLen) << " bytes to mbuf");
-				return false;
-			}
-		}
+		if (!resizeMBufData(rawDataLen))
+			return false;
 
-		m_RawData = rte_pktmbuf_mtod(m_MBuf, uint8_t*);
-		m_RawDataLen = rte_pktmbuf_pkt_len(m_MBuf);
 		memcpy(m_RawData, pRawData, m_RawDataLen);
 		delete[] pRawData;
 		m_TimeStamp = timestamp;
@@ -322,11 +292,62 @@ namespace pcpp
 		return true;
 	}
 
+	bool MBufRawPacket::reset(size_t capacity)
+	{
+		if (m_MBuf == nullptr)
+		{
+			PCPP_LOG_ERROR("MBufRawPacket not initialized. Please call the init() method");
+			return false;
+		}
+
+		if (capacity > static_cast<size_t>(m_MbufDataSize))
+		{
+			PCPP_LOG_ERROR("Cannot reset mBuf raw packet to a size larger than mBuf data. mBuf max length: "
+			               << m_MbufDataSize << "; requested length: " << capacity);
+			return false;
+		}
+
+		if (!resizeMBufData(static_cast<int>(capacity)))
+			return false;
+
+		m_FrameLength = m_RawDataLen;
+		m_RawPacketSet = true;
+		return true;
+	}
+
+	bool MBufRawPacket::resizeMBufData(int newDataLen)
+	{
+		if (m_RawDataLen < newDataLen)
+		{
+			if (rte_pktmbuf_append(m_MBuf, newDataLen - m_RawDataLen) == nullptr)
+			{
+				PCPP_LOG_ERROR("Couldn't append " << (newDataLen - m_RawDataLen) << " bytes to mbuf");
+				return false;
+			}
+		}
+		else if (m_RawDataLen > newDataLen)
+		{
+			if (rte_pktmbuf_adj(m_MBuf, m_RawDataLen - newDataLen) == nullptr)
+			{
+				PCPP_LOG_ERROR("Couldn't remove " << (m_RawDataLen - newDataLen) << " bytes to mbuf");
+				return false;
+			}
+		}
+
+		m_RawData = rte_pktmbuf_mtod(m_MBuf, uint8_t*);
+		m_RawDataLen = rte_pktmbuf_pkt_len(m_MBuf);
+		m_RawDataCapacity = static_cast<size_t>(m_RawDataLen) + rte_pktmbuf_tailroom(m_MBuf);
+		return true;
+	}
+
 	void MBufRawPacket::setMBuf(struct rte_mbuf* mBuf, timespec timestamp)
 	{
 		if (m_MBuf != nullptr && m_FreeMbuf)
 			rte_pktmbuf_free(m_MBuf);
 
+		// setRawData() clears the packet, which would free the previous mbuf again
+		m_MBuf = nullptr;
+
 		if (mBuf == nullptr)
 		{
 			PCPP_LOG_ERROR("mbuf to set is nullptr");
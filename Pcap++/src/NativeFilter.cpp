@@ -0,0 +1,445 @@
+#define LOG_MODULE PcapLogModuleLiveDevice
+
+#include "NativeFilter.h"
+#include "PcapFilter.h"
+#include "Logger.h"
+#include "IPv4Layer.h"
+#include <string.h>
+
+namespace pcpp
+{
+	namespace
+	{
+		constexpr uint16_t EtherTypeIPv4 = 0x0800;
+		constexpr uint16_t EtherTypeIPv6 = 0x86dd;
+		constexpr uint16_t EtherTypeArp = 0x0806;
+		constexpr uint16_t EtherTypeVlan = 0x8100;
+		constexpr uint16_t EtherTypeQinQ = 0x88a8;
+		constexpr uint16_t EtherTypeVlan9100 = 0x9100;
+		constexpr uint8_t IpProtocolSctp = 132;
+		constexpr size_t EthernetHeaderLength = 14;
+		constexpr size_t SllHeaderLength = 16;
+		constexpr size_t VlanTagLength = 4;
+		constexpr size_t MaxVlanTags = 8;
+		constexpr size_t IPv4MinHeaderLength = 20;
+		constexpr size_t IPv6HeaderLength = 40;
+		constexpr size_t ArpOpcodeOffset = 6;
+
+		inline uint16_t readBE16(const uint8_t* ptr)
+		{
+			return static_cast<uint16_t>((ptr[0] << 8) | ptr[1]);
+		}
+
+		inline uint32_t readBE32(const uint8_t* ptr)
+		{
+			return (static_cast<uint32_t>(ptr[0]) << 24) | (static_cast<uint32_t>(ptr[1]) << 16) |
+			       (static_cast<uint32_t>(ptr[2]) << 8) | ptr[3];
+		}
+
+		inline bool isVlanEtherType(uint16_t etherType)
+		{
+			return etherType == EtherTypeVlan || etherType == EtherTypeQinQ || etherType == EtherTypeVlan9100;
+		}
+
+		inline bool compare(uint32_t fieldValue, uint8_t op, uint32_t value)
+		{
+			switch (op)
+			{
+			case EQUALS:
+				return fieldValue == value;
+			case NOT_EQUALS:
+				return fieldValue != value;
+			case GREATER_THAN:
+				return fieldValue > value;
+			case GREATER_OR_EQUAL:
+				return fieldValue >= value;
+			case LESS_THAN:
+				return fieldValue < value;
+			case LESS_OR_EQUAL:
+				return fieldValue <= value;
+			default:
+				return false;
+			}
+		}
+
+		template <typename SrcMatch, typename DstMatch>
+		inline bool matchDirection(uint8_t direction, const SrcMatch& srcMatch, const DstMatch& dstMatch)
+		{
+			switch (direction)
+			{
+			case SRC:
+				return srcMatch();
+			case DST:
+				return dstMatch();
+			default:
+				return srcMatch() || dstMatch();
+			}
+		}
+
+		bool ipv6InNetwork(const uint8_t* address, const uint8_t* network, uint32_t prefixLength)
+		{
+			uint32_t fullBytes = prefixLength / 8;
+			if (memcmp(address, network, fullBytes) != 0)
+				return false;
+
+			uint32_t remainingBits = prefixLength % 8;
+			if (remainingBits == 0)
+				return true;
+
+			uint8_t mask = static_cast<uint8_t>(0xff << (8 - remainingBits));
+			return (address[fullBytes] & mask) == (network[fullBytes] & mask);
+		}
+
+		bool matchProtocol(const FilterFlowKey& key, uint32_t protocol)
+		{
+			const bool isIP = (key.flags & (FilterFlowKey::HasIPv4 | FilterFlowKey::HasIPv6)) != 0;
+			switch (protocol)
+			{
+			case TCP:
+				return isIP && key.ipProtocol == PACKETPP_IPPROTO_TCP;
+			case UDP:
+				return isIP && key.ipProtocol == PACKETPP_IPPROTO_UDP;
+			case ICMP:
+				return (key.flags & FilterFlowKey::HasIPv4) != 0 && key.ipProtocol == PACKETPP_IPPROTO_ICMP;
+			case VLAN:
+				return (key.flags & FilterFlowKey::HasVlan) != 0;
+			case IPv4:
+				return (key.flags & FilterFlowKey::HasIPv4) != 0;
+			case IPv6:
+				return (key.flags & FilterFlowKey::HasIPv6) != 0;
+			case ARP:
+				return (key.flags & FilterFlowKey::HasArp) != 0;
+			case Ethernet:
+				return (key.flags & FilterFlowKey::HasEthernet) != 0;
+			case GRE:
+				return isIP && key.ipProtocol == PACKETPP_IPPROTO_GRE;
+			case IGMP:
+				return isIP && key.ipProtocol == PACKETPP_IPPROTO_IGMP;
+			default:
+				return true;
+			}
+		}
+
+		// BPF "tcp[]" and "udp[]" expressions only apply to IPv4
+		inline bool isIPv4Transport(const FilterFlowKey& key, uint8_t ipProtocol, uint32_t minCapturedLength)
+		{
+			return (key.flags & FilterFlowKey::HasIPv4) != 0 && key.ipProtocol == ipProtocol &&
+			       key.transportCapturedLength >= minCapturedLength;
+		}
+
+		bool evaluate(const NativeFilter::Instruction& insn, const FilterFlowKey& key)
+		{
+			switch (insn.opcode)
+			{
+			case NativeFilter::MatchAll:
+				return true;
+			case NativeFilter::MatchIPv4Network:
+			{
+				if ((key.flags & FilterFlowKey::HasIPv4) == 0)
+					return false;
+
+				uint32_t mask = insn.value == 0 ? 0 : 0xffffffffU << (32 - insn.value);
+				uint32_t network = readBE32(insn.bytes) & mask;
+				return matchDirection(
+				    insn.modifier, [&]() { return (key.srcIPv4 & mask) == network; },
+				    [&]() { return (key.dstIPv4 & mask) == network; });
+			}
+			case NativeFilter::MatchIPv6Network:
+				if ((key.flags & FilterFlowKey::HasIPv6) == 0)
+					return false;
+
+				return matchDirection(
+				    insn.modifier, [&]() { return ipv6InNetwork(key.srcIPv6, insn.bytes, insn.value); },
+				    [&]() { return ipv6InNetwork(key.dstIPv6, insn.bytes, insn.value); });
+			case NativeFilter::MatchIPv4Id:
+				return (key.flags & FilterFlowKey::HasIPv4) != 0 && compare(key.ipId, insn.modifier, insn.value);
+			case NativeFilter::MatchIPv4TotalLength:
+				return (key.flags & FilterFlowKey::HasIPv4) != 0 &&
+				       compare(key.ipTotalLength, insn.modifier, insn.value);
+			case NativeFilter::MatchPort:
+				if ((key.flags & FilterFlowKey::HasPorts) == 0)
+					return false;
+
+				return matchDirection(
+				    insn.modifier, [&]() { return key.srcPort == insn.value; },
+				    [&]() { return key.dstPort == insn.value; });
+			case NativeFilter::MatchPortRange:
+				if ((key.flags & FilterFlowKey::HasPorts) == 0)
+					return false;
+
+				return matchDirection(
+				    insn.modifier, [&]() { return key.srcPort >= insn.value && key.srcPort <= insn.value2; },
+				    [&]() { return key.dstPort >= insn.value && key.dstPort <= insn.value2; });
+			case NativeFilter::MatchMacAddress:
+				if ((key.flags & FilterFlowKey::HasEthernet) == 0)
+					return false;
+
+				return matchDirection(
+				    insn.modifier, [&]() { return memcmp(key.srcMac, insn.bytes, 6) == 0; },
+				    [&]() { return memcmp(key.dstMac, insn.bytes, 6) == 0; });
+			case NativeFilter::MatchEtherType:
+				return (key.flags & FilterFlowKey::HasEtherType) != 0 && key.etherType == insn.value;
+			case NativeFilter::MatchProtocol:
+				return matchProtocol(key, insn.value);
+			case NativeFilter::MatchArpOpcode:
+				return (key.flags & FilterFlowKey::HasArp) != 0 && (key.arpOpcode & 0xff) == insn.value;
+			case NativeFilter::MatchVlanId:
+				return (key.flags & FilterFlowKey::HasVlan) != 0 && key.vlanId == insn.value;
+			case NativeFilter::MatchTcpFlags:
+			{
+				if (!isIPv4Transport(key, PACKETPP_IPPROTO_TCP, 14))
+					return false;
+
+				uint8_t maskedFlags = key.tcpFlags & insn.value;
+				return insn.value2 == 0 ? maskedFlags == insn.value : maskedFlags != 0;
+			}
+			case NativeFilter::MatchTcpWindowSize:
+				return isIPv4Transport(key, PACKETPP_IPPROTO_TCP, 16) &&
+				       compare(key.tcpWindowSize, insn.modifier, insn.value);
+			case NativeFilter::MatchUdpLength:
+				return isIPv4Transport(key, PACKETPP_IPPROTO_UDP, 6) &&
+				       compare(key.udpLength, insn.modifier, insn.value);
+			default:
+				return false;
+			}
+		}
+
+		void extractTransport(FilterFlowKey& key, const uint8_t* data, size_t dataLen)
+		{
+			key.transportCapturedLength = static_cast<uint32_t>(dataLen);
+			if (key.ipProtocol != PACKETPP_IPPROTO_TCP && key.ipProtocol != PACKETPP_IPPROTO_UDP &&
+			    key.ipProtocol != IpProtocolSctp)
+				return;
+
+			if (dataLen < 4)
+				return;
+
+			key.flags |= FilterFlowKey::HasPorts;
+			key.srcPort = readBE16(data);
+			key.dstPort = readBE16(data + 2);
+
+			if (key.ipProtocol == PACKETPP_IPPROTO_TCP)
+			{
+				if (dataLen >= 14)
+					key.tcpFlags = data[13];
+				if (dataLen >= 16)
+					key.tcpWindowSize = readBE16(data + 14);
+			}
+			else if (key.ipProtocol == PACKETPP_IPPROTO_UDP && dataLen >= 6)
+			{
+				key.udpLength = readBE16(data + 4);
+			}
+		}
+
+		void extractNetwork(FilterFlowKey& key, const uint8_t* data, size_t dataLen, uint16_t etherType)
+		{
+			switch (etherType)
+			{
+			case EtherTypeIPv4:
+			{
+				if (dataLen < IPv4MinHeaderLength || (data[0] >> 4) != 4)
+					return;
+
+				size_t headerLength = static_cast<size_t>(data[0] & 0x0f) * 4;
+				key.flags |= FilterFlowKey::HasIPv4;
+				key.ipTotalLength = readBE16(data + 2);
+				key.ipId = readBE16(data + 4);
+				key.ipProtocol = data[9];
+				key.srcIPv4 = readBE32(data + 12);
+				key.dstIPv4 = readBE32(data + 16);
+
+				// only the first fragment carries the transport header
+				bool isFirstFragment = (readBE16(data + 6) & 0x1fff) == 0;
+				if (isFirstFragment && headerLength >= IPv4MinHeaderLength && headerLength <= dataLen)
+					extractTransport(key, data + headerLength, dataLen - headerLength);
+				break;
+			}
+			case EtherTypeIPv6:
+			{
+				if (dataLen < IPv6HeaderLength || (data[0] >> 4) != 6)
+					return;
+
+				key.flags |= FilterFlowKey::HasIPv6;
+				key.ipProtocol = data[6];
+				memcpy(key.srcIPv6, data + 8, sizeof(key.srcIPv6));
+				memcpy(key.dstIPv6, data + 24, sizeof(key.dstIPv6));
+				extractTransport(key, data + IPv6HeaderLength, dataLen - IPv6HeaderLength);
+				break;
+			}
+			case EtherTypeArp:
+			{
+				if (dataLen < ArpOpcodeOffset + 2)
+					return;
+
+				key.flags |= FilterFlowKey::HasArp;
+				key.arpOpcode = readBE16(data + ArpOpcodeOffset);
+				break;
+			}
+			default:
+				break;
+			}
+		}
+	}  // namespace
+
+	void FilterFlowKey::extract(const uint8_t* data, size_t dataLen, LinkLayerType linkType)
+	{
+		*this = FilterFlowKey();
+		if (data == nullptr)
+			return;
+
+		size_t offset;
+		switch (linkType)
+		{
+		case LINKTYPE_ETHERNET:
+			if (dataLen < EthernetHeaderLength)
+				return;
+
+			flags |= HasEthernet | HasEtherType;
+			memcpy(dstMac, data, sizeof(dstMac));
+			memcpy(srcMac, data + 6, sizeof(srcMac));
+			etherType = readBE16(data + 12);
+			offset = EthernetHeaderLength;
+			break;
+		case LINKTYPE_LINUX_SLL:
+			if (dataLen < SllHeaderLength)
+				return;
+
+			flags |= HasEtherType;
+			etherType = readBE16(data + 14);
+			offset = SllHeaderLength;
+			break;
+		case LINKTYPE_RAW:
+		case LINKTYPE_DLT_RAW1:
+		case LINKTYPE_DLT_RAW2:
+		case LINKTYPE_IPV4:
+		case LINKTYPE_IPV6:
+		{
+			if (dataLen == 0)
+				return;
+
+			// there's no EtherType, the network layer is identified by the IP version the same way BPF does
+			uint8_t ipVersion = data[0] >> 4;
+			if (ipVersion != 4 && ipVersion != 6)
+				return;
+
+			flags |= HasEtherType;
+			etherType = ipVersion == 6 ? EtherTypeIPv6 : EtherTypeIPv4;
+			networkEtherType = etherType;
+			extractNetwork(*this, data, dataLen, networkEtherType);
+			return;
+		}
+		default:
+			return;
+		}
+
+		networkEtherType = etherType;
+		for (size_t i = 0; i < MaxVlanTags && isVlanEtherType(networkEtherType); ++i)
+		{
+			if (dataLen < offset + VlanTagLength)
+				return;
+
+			if ((flags & HasVlan) == 0)
+			{
+				flags |= HasVlan;
+				vlanId = readBE16(data + offset) & 0x0fff;
+			}
+
+			networkEtherType = readBE16(data + offset + 2);
+			offset += VlanTagLength;
+		}
+
+		extractNetwork(*this, data + offset, dataLen - offset, networkEtherType);
+	}
+
+	constexpr size_t NativeFilter::MaxStackDepth;
+
+	NativeFilter::NativeFilter(const GeneralFilter& filter) : m_IsValid(false)
+	{
+		if (!filter.appendToNativeFilter(*this))
+		{
+			PCPP_LOG_DEBUG("Filter can't be evaluated natively");
+			m_Instructions.clear();
+			return;
+		}
+
+		if (!validate())
+		{
+			PCPP_LOG_ERROR("Native filter is nested deeper than " << MaxStackDepth << " levels or malformed");
+			m_Instructions.clear();
+			return;
+		}
+
+		m_IsValid = true;
+	}
+
+	bool NativeFilter::validate() const
+	{
+		size_t depth = 0;
+		for (const auto& insn : m_Instructions)
+		{
+			switch (insn.opcode)
+			{
+			case LogicalAnd:
+			case LogicalOr:
+				if (depth < 2)
+					return false;
+				--depth;
+				break;
+			case LogicalNot:
+				if (depth < 1)
+					return false;
+				break;
+			default:
+				if (++depth > MaxStackDepth)
+					return false;
+				break;
+			}
+		}
+
+		return depth == 1;
+	}
+
+	bool NativeFilter::matches(const FilterFlowKey& key) const
+	{
+		if (!m_IsValid)
+			return false;
+
+		// the results are kept in a bit stack, the lowest bit is the top of the stack
+		uint64_t stack = 0;
+		for (const auto& insn : m_Instructions)
+		{
+			switch (insn.opcode)
+			{
+			case LogicalAnd:
+			{
+				uint64_t top = stack & 1;
+				stack >>= 1;
+				stack &= ~static_cast<uint64_t>(1) | top;
+				break;
+			}
+			case LogicalOr:
+			{
+				uint64_t top = stack & 1;
+				stack >>= 1;
+				stack |= top;
+				break;
+			}
+			case LogicalNot:
+				stack ^= 1;
+				break;
+			default:
+				stack = (stack << 1) | (evaluate(insn, key) ? 1 : 0);
+				break;
+			}
+		}
+
+		return (stack & 1) != 0;
+	}
+
+	bool NativeFilter::matches(const RawPacket* rawPacket) const
+	{
+		FilterFlowKey key;
+		key.extract(rawPacket);
+		return matches(key);
+	}
+}  // namespace pcpp
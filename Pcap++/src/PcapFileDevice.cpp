@@ -6,6 +6,7 @@
 #include "Logger.h"
 #include "TimespecTimeval.h"
 #include "pcap.h"
+#include <algorithm>
 #include <fstream>
 #include "EndianPortable.h"
 
@@ -28,6 +29,9 @@ namespace pcpp
 		{
 			return reinterpret_cast<light_pcapng_t*>(pcapngHandle);
 		}
+
+		/// The zstd seekable format stores the size of each frame in 32 bits
+		constexpr size_t MaxCompressionFrameSize = 1024 * 1024 * 1024;
 	}  // namespace
 
 	template <typename T, size_t N> constexpr size_t ARRAY_SIZE(T (&)[N])
@@ -135,6 +139,11 @@ namespace pcpp
 			bool packetRead = getNextPacket(*newPacket);
 			if (packetRead)
 			{
+				// a zero-copy read points into the reader's buffer, which the next read reuses, so the vector gets
+				// a copy the packet owns
+				if (!newPacket->isRawDataOwned())
+					*newPacket = RawPacket(*newPacket);
+
 				packetVec.pushBack(newPacket);
 			}
 			else
@@ -378,6 +387,7 @@ namespace pcpp
 	PcapNgFileReaderDevice::PcapNgFileReaderDevice(const std::string& fileName) : IFileReaderDevice(fileName)
 	{
 		m_LightPcapNg = nullptr;
+		m_ZeroCopyMode = false;
 	}
 
 	bool PcapNgFileReaderDevice::open()
@@ -405,9 +415,21 @@ namespace pcpp
 	}
 
 	bool PcapNgFileReaderDevice::getNextPacket(RawPacket& rawPacket, std::string& packetComment)
+	{
+		return readNextPacket(rawPacket, &packetComment);
+	}
+
+	bool PcapNgFileReaderDevice::getNextPacket(RawPacket& rawPacket)
+	{
+		// the comment isn't looked up at all when it isn't requested
+		return readNextPacket(rawPacket, nullptr);
+	}
+
+	bool PcapNgFileReaderDevice::readNextPacket(RawPacket& rawPacket, std::string* packetComment)
 	{
 		rawPacket.clear();
-		packetComment = "";
+		if (packetComment != nullptr)
+			packetComment->clear();
 
 		if (m_LightPcapNg == nullptr)
 		{
@@ -415,53 +437,61 @@ namespace pcpp
 			return false;
 		}
 
-		light_packet_header pktHeader;
+		light_packet_header pktHeader = {};
 		const uint8_t* pktData = nullptr;
+		light_boolean readComment = packetComment != nullptr ? LIGHT_TRUE : LIGHT_FALSE;
 
-		if (!light_get_next_packet(toLightPcapNgT(m_LightPcapNg), &pktHeader, &pktData))
+		do
 		{
-			PCPP_LOG_DEBUG("Packet could not be read. Probably end-of-file");
-			return false;
-		}
-
-		while (!m_BpfWrapper.matchPacketWithFilter(pktData, pktHeader.captured_length, pktHeader.timestamp,
-		                                           pktHeader.data_link))
-		{
-			if (!light_get_next_packet(toLightPcapNgT(m_LightPcapNg), &pktHeader, &pktData))
+			if (!light_get_next_packet_in_place(toLightPcapNgT(m_LightPcapNg), &pktHeader, &pktData, readComment))
 			{
 				PCPP_LOG_DEBUG("Packet could not be read. Probably end-of-file");
 				return false;
 			}
-		}
+		} while (!m_BpfWrapper.matchPacketWithFilter(pktData, pktHeader.captured_length, pktHeader.timestamp,
+		                                             pktHeader.data_link));
 
-		uint8_t* myPacketData = new uint8_t[pktHeader.captured_length];
-		memcpy(myPacketData, pktData, pktHeader.captured_length);
 		const LinkLayerType linkType = static_cast<LinkLayerType>(pktHeader.data_link);
 		if (linkType == LinkLayerType::LINKTYPE_INVALID)
 		{
 			PCPP_LOG_ERROR("Link layer type of raw packet could not be determined");
 		}
 
-		if (!rawPacket.setRawData(myPacketData, pktHeader.captured_length, pktHeader.timestamp, linkType,
-		                          pktHeader.original_length))
+		if (m_ZeroCopyMode)
 		{
-			PCPP_LOG_ERROR("Couldn't set data to raw packet");
-			return false;
+			// the packet doesn't own its data, which belongs to the read-ahead buffer of the file. Its previous data
+			// was freed by clear() above
+			rawPacket.initWithRawData(pktData, pktHeader.captured_length, pktHeader.timestamp, linkType);
+			if (pktHeader.original_length != pktHeader.captured_length)
+			{
+				rawPacket.setRawData(pktData, pktHeader.captured_length, pktHeader.timestamp, linkType,
+				                     pktHeader.original_length);
+			}
+		}
+		else
+		{
+			// a raw packet filled in zero-copy mode before doesn't own its data, give it back an owning state so the
+			// copy below is freed with it
+			if (!rawPacket.isRawDataOwned())
+				rawPacket = RawPacket();
+
+			uint8_t* myPacketData = new uint8_t[pktHeader.captured_length];
+			memcpy(myPacketData, pktData, pktHeader.captured_length);
+			if (!rawPacket.setRawData(myPacketData, pktHeader.captured_length, pktHeader.timestamp, linkType,
+			                          pktHeader.original_length))
+			{
+				PCPP_LOG_ERROR("Couldn't set data to raw packet");
+				return false;
+			}
 		}
 
-		if (pktHeader.comment != nullptr && pktHeader.comment_length > 0)
-			packetComment = std::string(pktHeader.comment, pktHeader.comment_length);
+		if (packetComment != nullptr && pktHeader.comment != nullptr && pktHeader.comment_length > 0)
+			*packetComment = std::string(pktHeader.comment, pktHeader.comment_length);
 
 		m_NumOfPacketsRead++;
 		return true;
 	}
 
-	bool PcapNgFileReaderDevice::getNextPacket(RawPacket& rawPacket)
-	{
-		std::string temp;
-		return getNextPacket(rawPacket, temp);
-	}
-
 	void PcapNgFileReaderDevice::getStatistics(PcapStats& stats) const
 	{
 		stats.packetsRecv = m_NumOfPacketsRead;
@@ -849,6 +879,8 @@ namespace pcpp
 	{
 		m_LightPcapNg = nullptr;
 		m_CompressionLevel = compressionLevel;
+		m_CompressionWorkerCount = 0;
+		m_CompressionFrameSize = 0;
 	}
 
 	bool PcapNgFileWriterDevice::writePacket(RawPacket const& packet, const std::string& comment)
@@ -951,7 +983,17 @@ namespace pcpp
 			                              metadata->captureApplication.c_str(), metadata->comment.c_str());
 		}
 
-		m_LightPcapNg = toLightPcapNgHandle(light_pcapng_open_write(m_FileName.c_str(), info, m_CompressionLevel));
+		if (m_CompressionFrameSize > MaxCompressionFrameSize)
+		{
+			PCPP_LOG_ERROR("Compression frame size " << m_CompressionFrameSize << " is larger than the maximum of "
+			                                         << MaxCompressionFrameSize);
+			light_free_file_info(info);
+			return false;
+		}
+
+		light_compression_options options = { m_CompressionLevel, std::max(m_CompressionWorkerCount, 0),
+			                                  m_CompressionFrameSize };
+		m_LightPcapNg = toLightPcapNgHandle(light_pcapng_open_write_with_options(m_FileName.c_str(), info, &options));
 		if (m_LightPcapNg == nullptr)
 		{
 			PCPP_LOG_ERROR("Error opening file writer device for file '"
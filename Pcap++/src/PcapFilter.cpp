@@ -1,11 +1,15 @@
 #define LOG_MODULE PcapLogModuleLiveDevice
 
 #include "PcapFilter.h"
+#include "NativeFilter.h"
 #include "Logger.h"
 #include "IPv4Layer.h"
 #include "PcapUtils.h"
 #include <sstream>
+#include <algorithm>
 #include <array>
+#include <cstdlib>
+#include <cstring>
 #if defined(_WIN32)
 #	include <winsock2.h>
 #endif
@@ -22,12 +26,20 @@ namespace pcpp
 		std::string filterStr;
 		parseToString(filterStr);
 
-		if (!m_BpfWrapper.setFilter(filterStr))
+		// compile for the packet's link type right away so the wrapper doesn't compile the filter twice
+		if (!m_BpfWrapper.setFilter(filterStr, rawPacket->getLinkLayerType()))
 			return false;
 
 		return m_BpfWrapper.matchPacketWithFilter(rawPacket);
 	}
 
+	CompiledBpfFilter GeneralFilter::compile(LinkLayerType linkType)
+	{
+		std::string filterStr;
+		parseToString(filterStr);
+		return CompiledBpfFilter(filterStr, linkType);
+	}
+
 	namespace internal
 	{
 		void BpfProgramDeleter::operator()(bpf_program* ptr) const noexcept
@@ -37,16 +49,24 @@ namespace pcpp
 		}
 	}  // namespace internal
 
-	BpfFilterWrapper::BpfFilterWrapper() : m_LinkType(LinkLayerType::LINKTYPE_ETHERNET)
+	BpfFilterWrapper::BpfFilterWrapper() : m_LinkType(LinkLayerType::LINKTYPE_ETHERNET), m_UseThreadedCode(false)
 	{}
 
 	BpfFilterWrapper::BpfFilterWrapper(const BpfFilterWrapper& other) : BpfFilterWrapper()
 	{
+		m_UseThreadedCode = other.m_UseThreadedCode;
 		setFilter(other.m_FilterStr, other.m_LinkType);
 	}
 
 	BpfFilterWrapper& BpfFilterWrapper::operator=(const BpfFilterWrapper& other)
 	{
+		if (m_UseThreadedCode != other.m_UseThreadedCode)
+		{
+			// force re-compilation so the program is translated (or not) according to the new setting
+			freeProgram();
+			m_UseThreadedCode = other.m_UseThreadedCode;
+		}
+
 		setFilter(other.m_FilterStr, other.m_LinkType);
 		return *this;
 	}
@@ -79,6 +99,7 @@ namespace pcpp
 			m_Program = std::unique_ptr<bpf_program, internal::BpfProgramDeleter>(newProg.release());
 			m_FilterStr = filter;
 			m_LinkType = linkType;
+			translateProgram();
 		}
 
 		return true;
@@ -86,10 +107,37 @@ namespace pcpp
 
 	void BpfFilterWrapper::freeProgram()
 	{
+		m_ThreadedProgram = nullptr;
 		m_Program = nullptr;
 		m_FilterStr.clear();
 	}
 
+	void BpfFilterWrapper::translateProgram()
+	{
+		m_ThreadedProgram = nullptr;
+		if (!m_UseThreadedCode || m_Program == nullptr)
+			return;
+
+		std::unique_ptr<BpfThreadedProgram> threadedProgram(new BpfThreadedProgram());
+		if (!threadedProgram->translate(m_Program.get()))
+		{
+			PCPP_LOG_DEBUG("Filter '" << m_FilterStr
+			                          << "' can't be translated to threaded code, using the interpreter");
+			return;
+		}
+
+		m_ThreadedProgram = std::move(threadedProgram);
+	}
+
+	void BpfFilterWrapper::setThreadedCodeEnabled(bool enabled)
+	{
+		if (enabled == m_UseThreadedCode)
+			return;
+
+		m_UseThreadedCode = enabled;
+		translateProgram();
+	}
+
 	bool BpfFilterWrapper::matchPacketWithFilter(const RawPacket* rawPacket)
 	{
 		return matchPacketWithFilter(rawPacket->getRawData(), rawPacket->getRawDataLen(),
@@ -102,11 +150,16 @@ namespace pcpp
 		if (m_FilterStr.empty())
 			return true;
 
-		if (!setFilter(std::string(m_FilterStr), static_cast<LinkLayerType>(linkType)))
+		// the filter only needs to be re-compiled when the link type changes. A copy of the filter string is needed
+		// in that case since setFilter() overwrites it
+		if (linkType != m_LinkType && !setFilter(std::string(m_FilterStr), static_cast<LinkLayerType>(linkType)))
 		{
 			return false;
 		}
 
+		if (m_ThreadedProgram != nullptr)
+			return m_ThreadedProgram->run(packetData, packetDataLength, packetDataLength) != 0;
+
 		struct pcap_pkthdr pktHdr;
 		pktHdr.caplen = packetDataLength;
 		pktHdr.len = packetDataLength;
@@ -115,6 +168,70 @@ namespace pcpp
 		return (pcap_offline_filter(m_Program.get(), &pktHdr, packetData) != 0);
 	}
 
+	CompiledBpfFilter::CompiledBpfFilter() : m_LinkType(LinkLayerType::LINKTYPE_ETHERNET), m_IsValid(true)
+	{}
+
+	CompiledBpfFilter::CompiledBpfFilter(const std::string& filter, LinkLayerType linkType)
+	    : m_FilterStr(filter), m_LinkType(linkType), m_IsValid(false)
+	{
+		if (filter.empty())
+		{
+			m_IsValid = true;
+			return;
+		}
+
+		auto pcap = std::unique_ptr<pcap_t, internal::PcapCloseDeleter>(pcap_open_dead(linkType, DEFAULT_SNAPLEN));
+		if (pcap == nullptr)
+		{
+			PCPP_LOG_ERROR("Couldn't compile BPF filter '" << filter << "': pcap_open_dead failed");
+			return;
+		}
+
+		std::unique_ptr<bpf_program> newProg = std::unique_ptr<bpf_program>(new bpf_program);
+		if (pcap_compile(pcap.get(), newProg.get(), filter.c_str(), 1, 0) < 0)
+		{
+			PCPP_LOG_ERROR("Couldn't compile BPF filter '" << filter << "': " << pcap_geterr(pcap.get()));
+			return;
+		}
+
+		m_Program = std::shared_ptr<bpf_program>(newProg.release(), internal::BpfProgramDeleter());
+		m_IsValid = true;
+	}
+
+	bool CompiledBpfFilter::matches(const RawPacket* rawPacket) const
+	{
+		if (rawPacket->getLinkLayerType() != m_LinkType)
+			return false;
+
+		return matches(rawPacket->getRawData(), static_cast<uint32_t>(rawPacket->getRawDataLen()));
+	}
+
+	bool CompiledBpfFilter::matches(const uint8_t* packetData, uint32_t packetDataLength) const
+	{
+		if (m_Program == nullptr)
+			return m_IsValid;
+
+		// the BPF machine doesn't look at the timestamp
+		struct pcap_pkthdr pktHdr = {};
+		pktHdr.caplen = packetDataLength;
+		pktHdr.len = packetDataLength;
+
+		return (pcap_offline_filter(m_Program.get(), &pktHdr, packetData) != 0);
+	}
+
+	size_t CompiledBpfFilter::matchPackets(const RawPacket* const rawPackets[], size_t count, bool results[]) const
+	{
+		size_t matchCount = 0;
+		for (size_t i = 0; i < count; ++i)
+		{
+			results[i] = matches(rawPackets[i]);
+			if (results[i])
+				++matchCount;
+		}
+
+		return matchCount;
+	}
+
 	void BPFStringFilter::parseToString(std::string& result)
 	{
 		result = m_FilterStr;
@@ -377,4 +494,168 @@ namespace pcpp
 		stream << m_Length;
 		result = "udp[4:2] " + parseOperator() + ' ' + stream.str();
 	}
+
+	// Native filter instructions, see NativeFilter.h for the evaluation semantics
+
+	static NativeFilter::Instruction createNativeInstruction(NativeFilter::Opcode opcode, uint8_t modifier,
+	                                                         uint32_t value, uint32_t value2 = 0)
+	{
+		NativeFilter::Instruction insn;
+		insn.opcode = opcode;
+		insn.modifier = modifier;
+		insn.value = value;
+		insn.value2 = value2;
+		return insn;
+	}
+
+	bool BPFStringFilter::appendToNativeFilter(NativeFilter& nativeFilter) const
+	{
+		// arbitrary BPF strings can't be evaluated natively, only the empty filter which matches all packets
+		if (!m_FilterStr.empty())
+			return false;
+
+		nativeFilter.appendInstruction(createNativeInstruction(NativeFilter::MatchAll, 0, 0));
+		return true;
+	}
+
+	bool IPFilter::appendToNativeFilter(NativeFilter& nativeFilter) const
+	{
+		IPAddress networkPrefix = m_Network.getNetworkPrefix();
+		NativeFilter::Instruction insn;
+		if (networkPrefix.isIPv4())
+		{
+			insn = createNativeInstruction(NativeFilter::MatchIPv4Network, getDir(), m_Network.getPrefixLen());
+			memcpy(insn.bytes, networkPrefix.getIPv4().toBytes(), 4);
+		}
+		else
+		{
+			insn = createNativeInstruction(NativeFilter::MatchIPv6Network, getDir(), m_Network.getPrefixLen());
+			memcpy(insn.bytes, networkPrefix.getIPv6().toBytes(), 16);
+		}
+
+		nativeFilter.appendInstruction(insn);
+		return true;
+	}
+
+	bool IPv4IDFilter::appendToNativeFilter(NativeFilter& nativeFilter) const
+	{
+		nativeFilter.appendInstruction(createNativeInstruction(NativeFilter::MatchIPv4Id, getOperator(), m_IpID));
+		return true;
+	}
+
+	bool IPv4TotalLengthFilter::appendToNativeFilter(NativeFilter& nativeFilter) const
+	{
+		nativeFilter.appendInstruction(
+		    createNativeInstruction(NativeFilter::MatchIPv4TotalLength, getOperator(), m_TotalLength));
+		return true;
+	}
+
+	bool PortFilter::appendToNativeFilter(NativeFilter& nativeFilter) const
+	{
+		uint32_t port = static_cast<uint32_t>(strtoul(m_Port.c_str(), nullptr, 10));
+		nativeFilter.appendInstruction(createNativeInstruction(NativeFilter::MatchPort, getDir(), port));
+		return true;
+	}
+
+	bool PortRangeFilter::appendToNativeFilter(NativeFilter& nativeFilter) const
+	{
+		// libpcap swaps the ports of a reversed range
+		nativeFilter.appendInstruction(createNativeInstruction(NativeFilter::MatchPortRange, getDir(),
+		                                                       std::min(m_FromPort, m_ToPort),
+		                                                       std::max(m_FromPort, m_ToPort)));
+		return true;
+	}
+
+	bool MacAddressFilter::appendToNativeFilter(NativeFilter& nativeFilter) const
+	{
+		NativeFilter::Instruction insn = createNativeInstruction(NativeFilter::MatchMacAddress, getDir(), 0);
+		m_MacAddress.copyTo(insn.bytes);
+		nativeFilter.appendInstruction(insn);
+		return true;
+	}
+
+	bool EtherTypeFilter::appendToNativeFilter(NativeFilter& nativeFilter) const
+	{
+		nativeFilter.appendInstruction(createNativeInstruction(NativeFilter::MatchEtherType, 0, m_EtherType));
+		return true;
+	}
+
+	bool CompositeFilter::appendChildrenToNativeFilter(NativeFilter& nativeFilter, bool isAnd) const
+	{
+		// an empty composite filter is parsed to an empty string, which matches all packets
+		if (m_FilterList.empty())
+		{
+			nativeFilter.appendInstruction(createNativeInstruction(NativeFilter::MatchAll, 0, 0));
+			return true;
+		}
+
+		for (auto it = m_FilterList.cbegin(); it != m_FilterList.cend(); ++it)
+		{
+			if (*it == nullptr || !(*it)->appendToNativeFilter(nativeFilter))
+				return false;
+
+			if (it != m_FilterList.cbegin())
+			{
+				nativeFilter.appendInstruction(
+				    createNativeInstruction(isAnd ? NativeFilter::LogicalAnd : NativeFilter::LogicalOr, 0, 0));
+			}
+		}
+
+		return true;
+	}
+
+	bool NotFilter::appendToNativeFilter(NativeFilter& nativeFilter) const
+	{
+		if (m_FilterToInverse == nullptr || !m_FilterToInverse->appendToNativeFilter(nativeFilter))
+			return false;
+
+		nativeFilter.appendInstruction(createNativeInstruction(NativeFilter::LogicalNot, 0, 0));
+		return true;
+	}
+
+	bool ProtoFilter::appendToNativeFilter(NativeFilter& nativeFilter) const
+	{
+		nativeFilter.appendInstruction(createNativeInstruction(NativeFilter::MatchProtocol, 0, m_ProtoFamily));
+		return true;
+	}
+
+	bool ArpFilter::appendToNativeFilter(NativeFilter& nativeFilter) const
+	{
+		// the BPF filter compares "arp[7]", which is the low byte of the opcode
+		nativeFilter.appendInstruction(
+		    createNativeInstruction(NativeFilter::MatchArpOpcode, 0, static_cast<uint32_t>(m_OpCode)));
+		return true;
+	}
+
+	bool VlanFilter::appendToNativeFilter(NativeFilter& nativeFilter) const
+	{
+		nativeFilter.appendInstruction(createNativeInstruction(NativeFilter::MatchVlanId, 0, m_VlanID));
+		return true;
+	}
+
+	bool TcpFlagsFilter::appendToNativeFilter(NativeFilter& nativeFilter) const
+	{
+		if (m_TcpFlagsBitMask == 0)
+		{
+			nativeFilter.appendInstruction(createNativeInstruction(NativeFilter::MatchAll, 0, 0));
+			return true;
+		}
+
+		nativeFilter.appendInstruction(createNativeInstruction(NativeFilter::MatchTcpFlags, 0, m_TcpFlagsBitMask,
+		                                                       m_MatchOption == MatchOneAtLeast ? 1 : 0));
+		return true;
+	}
+
+	bool TcpWindowSizeFilter::appendToNativeFilter(NativeFilter& nativeFilter) const
+	{
+		nativeFilter.appendInstruction(
+		    createNativeInstruction(NativeFilter::MatchTcpWindowSize, getOperator(), m_WindowSize));
+		return true;
+	}
+
+	bool UdpLengthFilter::appendToNativeFilter(NativeFilter& nativeFilter) const
+	{
+		nativeFilter.appendInstruction(createNativeInstruction(NativeFilter::MatchUdpLength, getOperator(), m_Length));
+		return true;
+	}
 }  // namespace pcpp
\ No newline at end of file
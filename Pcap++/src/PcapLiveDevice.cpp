@@ -38,6 +38,12 @@
 #	include <poll.h>
 #	include <pcap/pcap.h>
 #endif  // if defined(_WIN32)
+#if defined(__linux__)
+#	include <linux/if_packet.h>
+#	include <pthread.h>
+#	include <sched.h>
+#	include <sys/socket.h>
+#endif
 #if defined(__APPLE__)
 #	include <net/if_dl.h>
 #	include <sys/sysctl.h>
@@ -89,6 +95,17 @@ namespace pcpp
 		}
 	}
 
+	// run a pcap_dispatch() round and record its result when capture timing statistics are collected
+	static int dispatchPackets(pcap_t* pcapDescriptor, int count, pcap_handler callback, uint8_t* user,
+	                           internal::CaptureTimingRecorder* timingRecorder)
+	{
+		int result = pcap_dispatch(pcapDescriptor, count, callback, user);
+		if (timingRecorder != nullptr)
+			timingRecorder->recordDispatch(result);
+
+		return result;
+	}
+
 	static int getPcapTimestampProvider(const PcapLiveDevice::TimestampProvider timestampProvider)
 	{
 #ifdef HAS_TIMESTAMP_TYPES_ENABLED
@@ -339,6 +356,10 @@ namespace pcpp
 		m_cbOnPacketArrivesUserCookie = nullptr;
 		m_CaptureCallbackMode = true;
 		m_CapturedPackets = nullptr;
+		m_cbOnPacketsArrive = nullptr;
+		m_cbOnPacketsArriveUserCookie = nullptr;
+		m_CaptureBatchMode = false;
+		m_BatchSize = 0;
 		if (calculateMacAddress)
 		{
 			setDeviceMacAddress();
@@ -357,8 +378,18 @@ namespace pcpp
 
 		RawPacket rawPacket(packet, pkthdr->caplen, pkthdr->ts, false, pThis->getLinkType());
 
-		if (pThis->m_cbOnPacketArrives != nullptr)
-			pThis->m_cbOnPacketArrives(&rawPacket, pThis, pThis->m_cbOnPacketArrivesUserCookie);
+		if (pThis->m_cbOnPacketArrives == nullptr)
+			return;
+
+		internal::CaptureTimingRecorder* timingRecorder = pThis->m_ActiveTimingRecorder;
+		std::chrono::steady_clock::time_point callbackStart;
+		if (timingRecorder != nullptr)
+			callbackStart = timingRecorder->beginCallback(pkthdr->ts);
+
+		pThis->m_cbOnPacketArrives(&rawPacket, pThis, pThis->m_cbOnPacketArrivesUserCookie);
+
+		if (timingRecorder != nullptr)
+			timingRecorder->endCallback(callbackStart);
 	}
 
 	void PcapLiveDevice::onPacketArrivesNoCallback(uint8_t* user, const struct pcap_pkthdr* pkthdr,
@@ -375,6 +406,9 @@ namespace pcpp
 		memcpy(packetData, packet, pkthdr->caplen);
 		RawPacket* rawPacketPtr = new RawPacket(packetData, pkthdr->caplen, pkthdr->ts, true, pThis->getLinkType());
 		pThis->m_CapturedPackets->pushBack(rawPacketPtr);
+
+		if (pThis->m_ActiveTimingRecorder != nullptr)
+			pThis->m_ActiveTimingRecorder->recordTimestamp(pkthdr->ts, std::chrono::system_clock::now());
 	}
 
 	void PcapLiveDevice::onPacketArrivesBlockingMode(uint8_t* user, const struct pcap_pkthdr* pkthdr,
@@ -389,10 +423,324 @@ namespace pcpp
 
 		RawPacket rawPacket(packet, pkthdr->caplen, pkthdr->ts, false, pThis->getLinkType());
 
-		if (pThis->m_cbOnPacketArrivesBlockingMode != nullptr)
-			if (pThis->m_cbOnPacketArrivesBlockingMode(&rawPacket, pThis,
-			                                           pThis->m_cbOnPacketArrivesBlockingModeUserCookie))
-				pThis->m_StopThread = true;
+		if (pThis->m_cbOnPacketArrivesBlockingMode == nullptr)
+			return;
+
+		internal::CaptureTimingRecorder* timingRecorder = pThis->m_ActiveTimingRecorder;
+		std::chrono::steady_clock::time_point callbackStart;
+		if (timingRecorder != nullptr)
+			callbackStart = timingRecorder->beginCallback(pkthdr->ts);
+
+		if (pThis->m_cbOnPacketArrivesBlockingMode(&rawPacket, pThis, pThis->m_cbOnPacketArrivesBlockingModeUserCookie))
+			pThis->m_StopThread = true;
+
+		if (timingRecorder != nullptr)
+			timingRecorder->endCallback(callbackStart);
+	}
+
+	void PcapLiveDevice::onPacketArrivesBatchMode(uint8_t* user, const struct pcap_pkthdr* pkthdr,
+	                                              const uint8_t* packet)
+	{
+		PcapLiveDevice* pThis = reinterpret_cast<PcapLiveDevice*>(user);
+		if (pThis == nullptr)
+		{
+			PCPP_LOG_ERROR("Unable to extract PcapLiveDevice instance");
+			return;
+		}
+
+		// the slab may be reallocated while the batch is collected, so only the data offset is kept until the batch
+		// is delivered
+		BatchPacketInfo packetInfo;
+		packetInfo.dataOffset = pThis->m_BatchSlab.size();
+		packetInfo.captureLength = pkthdr->caplen;
+		packetInfo.frameLength = pkthdr->len;
+		packetInfo.timestamp = pkthdr->ts;
+		pThis->m_BatchSlab.insert(pThis->m_BatchSlab.end(), packet, packet + pkthdr->caplen);
+		pThis->m_BatchPacketInfo.push_back(packetInfo);
+	}
+
+	void PcapLiveDevice::deliverPacketBatch()
+	{
+		uint32_t packetCount = static_cast<uint32_t>(m_BatchPacketInfo.size());
+		if (packetCount > 0)
+		{
+			for (uint32_t i = 0; i < packetCount; i++)
+			{
+				const BatchPacketInfo& packetInfo = m_BatchPacketInfo[i];
+				RawPacket& rawPacket = m_BatchPackets[i];
+				const uint8_t* data = m_BatchSlab.data() + packetInfo.dataOffset;
+				timespec timestamp;
+				timestamp.tv_sec = packetInfo.timestamp.tv_sec;
+				timestamp.tv_nsec = packetInfo.timestamp.tv_usec * 1000;
+
+				// the packets don't own their data, which belongs to the slab
+				rawPacket.initWithRawData(data, packetInfo.captureLength, timestamp, getLinkType());
+				if (packetInfo.frameLength != packetInfo.captureLength)
+				{
+					rawPacket.setRawData(data, packetInfo.captureLength, timestamp, getLinkType(),
+					                     packetInfo.frameLength);
+				}
+			}
+
+			if (m_ActiveTimingRecorder == nullptr)
+			{
+				m_cbOnPacketsArrive(m_BatchPackets.data(), packetCount, this, m_cbOnPacketsArriveUserCookie);
+			}
+			else
+			{
+				auto now = std::chrono::system_clock::now();
+				for (uint32_t i = 0; i < packetCount; i++)
+					m_ActiveTimingRecorder->recordTimestamp(m_BatchPacketInfo[i].timestamp, now);
+
+				auto callbackStart = std::chrono::steady_clock::now();
+				m_cbOnPacketsArrive(m_BatchPackets.data(), packetCount, this, m_cbOnPacketsArriveUserCookie);
+				m_ActiveTimingRecorder->endCallback(callbackStart);
+			}
+		}
+
+		// clear() keeps the capacity, so the next batches don't allocate
+		m_BatchPacketInfo.clear();
+		m_BatchSlab.clear();
+	}
+
+	namespace
+	{
+		// the state a fanout capture thread passes to its pcap_dispatch() callback
+		struct FanoutThreadContext
+		{
+			PcapLiveDevice* device;
+			uint32_t threadIndex;
+			LinkLayerType linkType;
+			const OnFanoutPacketArrivesCallback* onPacketArrives;
+			void* onPacketArrivesUserCookie;
+			internal::CaptureTimingRecorder* timingRecorder;
+		};
+
+		void onFanoutPacketArrives(uint8_t* user, const struct pcap_pkthdr* pkthdr, const uint8_t* packet)
+		{
+			FanoutThreadContext* threadContext = reinterpret_cast<FanoutThreadContext*>(user);
+			RawPacket rawPacket(packet, pkthdr->caplen, pkthdr->ts, false, threadContext->linkType);
+			if (*threadContext->onPacketArrives == nullptr)
+				return;
+
+			std::chrono::steady_clock::time_point callbackStart;
+			if (threadContext->timingRecorder != nullptr)
+				callbackStart = threadContext->timingRecorder->beginCallback(pkthdr->ts);
+
+			(*threadContext->onPacketArrives)(&rawPacket, threadContext->device, threadContext->threadIndex,
+			                                  threadContext->onPacketArrivesUserCookie);
+
+			if (threadContext->timingRecorder != nullptr)
+				threadContext->timingRecorder->endCallback(callbackStart);
+		}
+	}  // namespace
+
+	void PcapLiveDevice::fanoutCaptureThreadMain(uint32_t threadIndex, pcap_t* pcapDescriptor, int coreId)
+	{
+		PCPP_LOG_DEBUG("Started fanout capture thread " << threadIndex << " for device '" << m_InterfaceDetails.name
+		                                                << "'");
+
+#if defined(__linux__)
+		if (coreId >= 0)
+		{
+			cpu_set_t cpuSet;
+			CPU_ZERO(&cpuSet);
+			CPU_SET(coreId, &cpuSet);
+			int err = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet);
+			if (err != 0)
+				PCPP_LOG_ERROR("Cannot bind fanout capture thread " << threadIndex << " to core " << coreId
+				                                                    << ": errno=" << err);
+		}
+#else
+		(void)coreId;
+#endif
+
+		internal::CaptureTimingRecorder* timingRecorder =
+		    m_ActiveTimingRecorder != nullptr ? m_TimingRecorders[threadIndex].get() : nullptr;
+		if (timingRecorder != nullptr)
+			timingRecorder->beginCapture();
+
+		FanoutThreadContext threadContext = { this,
+			                                  threadIndex,
+			                                  m_LinkType,
+			                                  &m_cbOnFanoutPacketArrives,
+			                                  m_cbOnFanoutPacketArrivesUserCookie,
+			                                  timingRecorder };
+		while (!m_StopThread)
+		{
+			if (dispatchPackets(pcapDescriptor, -1, onFanoutPacketArrives, reinterpret_cast<uint8_t*>(&threadContext),
+			                    timingRecorder) == -1)
+			{
+				PCPP_LOG_ERROR("pcap_dispatch returned an error in fanout capture thread "
+				               << threadIndex << ": " << pcap_geterr(pcapDescriptor));
+				break;
+			}
+		}
+
+		PCPP_LOG_DEBUG("Ended fanout capture thread " << threadIndex << " for device '" << m_InterfaceDetails.name
+		                                              << "'");
+	}
+
+	bool PcapLiveDevice::joinFanoutGroup(pcap_t* pcapDescriptor, const FanoutConfiguration& fanoutConfig)
+	{
+#if defined(__linux__)
+		int fd = pcap_get_selectable_fd(pcapDescriptor);
+		if (fd < 0)
+		{
+			PCPP_LOG_ERROR("Cannot get the socket of a pcap handle of device '" << m_InterfaceDetails.name << "'");
+			return false;
+		}
+
+		int fanoutType = static_cast<int>(fanoutConfig.mode);
+		if (fanoutConfig.defragment)
+			fanoutType |= PACKET_FANOUT_FLAG_DEFRAG;
+
+		int fanoutArg = fanoutConfig.groupId | (fanoutType << 16);
+		if (setsockopt(fd, SOL_PACKET, PACKET_FANOUT, &fanoutArg, sizeof(fanoutArg)) < 0)
+		{
+			PCPP_LOG_ERROR("Cannot join fanout group " << fanoutConfig.groupId << " on device '"
+			                                           << m_InterfaceDetails.name << "': " << strerror(errno));
+			return false;
+		}
+
+		return true;
+#else
+		(void)pcapDescriptor;
+		(void)fanoutConfig;
+		return false;
+#endif
+	}
+
+	bool PcapLiveDevice::startFanoutCapture(const FanoutConfiguration& fanoutConfig,
+	                                        OnFanoutPacketArrivesCallback onPacketArrives,
+	                                        void* onPacketArrivesUserCookie)
+	{
+#if defined(__linux__)
+
+		if (!m_DeviceOpened || m_PcapDescriptor == nullptr)
+		{
+			PCPP_LOG_ERROR("Device '" << m_InterfaceDetails.name << "' not opened");
+			return false;
+		}
+
+		if (captureActive())
+		{
+			PCPP_LOG_ERROR("Device '" << m_InterfaceDetails.name << "' already capturing traffic");
+			return false;
+		}
+
+		if (fanoutConfig.threadCount == 0 || onPacketArrives == nullptr)
+		{
+			PCPP_LOG_ERROR("Fanout capture requires a callback and at least 1 thread");
+			return false;
+		}
+
+		if (fanoutConfig.mode == FanoutConfiguration::FanoutEbpf && fanoutConfig.ebpfProgramFd < 0)
+		{
+			PCPP_LOG_ERROR("Fanout eBPF mode requires an eBPF program");
+			return false;
+		}
+
+		if (isNflogDevice())
+		{
+			PCPP_LOG_ERROR("Fanout capture isn't supported on NFLOG devices");
+			return false;
+		}
+
+		std::vector<internal::PcapHandle> fanoutDescriptors;
+		for (uint32_t i = 1; i < fanoutConfig.threadCount; i++)
+		{
+			internal::PcapHandle pcapDescriptor = doOpen(m_DeviceConfig);
+			if (pcapDescriptor == nullptr)
+			{
+				PCPP_LOG_ERROR("Cannot open fanout handle " << i << " on device '" << m_InterfaceDetails.name << "'");
+				return false;
+			}
+
+			if (!m_FilterAsString.empty() && !pcapDescriptor.setFilter(m_FilterAsString))
+			{
+				PCPP_LOG_ERROR("Cannot set the device filter on fanout handle " << i);
+				return false;
+			}
+
+			fanoutDescriptors.push_back(std::move(pcapDescriptor));
+		}
+
+		// the device handle is the first member of the group. A socket can't leave a fanout group, so the device
+		// handle stays in it until the device is closed and a later fanout capture can only reuse the same group
+		if (m_FanoutGroupId >= 0 && m_FanoutGroupId != fanoutConfig.groupId)
+		{
+			PCPP_LOG_ERROR("Device '" << m_InterfaceDetails.name << "' is already in fanout group " << m_FanoutGroupId
+			                          << ", close and reopen the device to use another group");
+			return false;
+		}
+
+		bool joinDeviceHandle = (m_FanoutGroupId < 0);
+		if (joinDeviceHandle && !joinFanoutGroup(m_PcapDescriptor.get(), fanoutConfig))
+			return false;
+
+		m_FanoutGroupId = fanoutConfig.groupId;
+
+		if (joinDeviceHandle && fanoutConfig.mode == FanoutConfiguration::FanoutEbpf)
+		{
+#	if defined(PACKET_FANOUT_DATA)
+			int fd = pcap_get_selectable_fd(m_PcapDescriptor.get());
+			if (setsockopt(fd, SOL_PACKET, PACKET_FANOUT_DATA, &fanoutConfig.ebpfProgramFd,
+			               sizeof(fanoutConfig.ebpfProgramFd)) < 0)
+			{
+				PCPP_LOG_ERROR("Cannot attach the eBPF program to fanout group " << fanoutConfig.groupId << ": "
+				                                                                 << strerror(errno));
+				return false;
+			}
+#	else
+			PCPP_LOG_ERROR("Fanout eBPF mode isn't supported by the kernel headers");
+			return false;
+#	endif
+		}
+
+		for (auto& pcapDescriptor : fanoutDescriptors)
+		{
+			if (!joinFanoutGroup(pcapDescriptor.get(), fanoutConfig))
+				return false;
+		}
+
+		prepareCapture(true, false);
+		prepareTimingRecorders(fanoutConfig.threadCount);
+
+		m_FanoutDescriptors = std::move(fanoutDescriptors);
+		m_FanoutThreadCount = fanoutConfig.threadCount > 1 ? fanoutConfig.threadCount : 0;
+		m_cbOnFanoutPacketArrives = std::move(onPacketArrives);
+		m_cbOnFanoutPacketArrivesUserCookie = onPacketArrivesUserCookie;
+
+		auto getCoreId = [&fanoutConfig](uint32_t threadIndex) {
+			return fanoutConfig.coreIds.empty() ? -1
+			                                    : fanoutConfig.coreIds[threadIndex % fanoutConfig.coreIds.size()];
+		};
+
+		m_CaptureThread = std::thread(&pcpp::PcapLiveDevice::fanoutCaptureThreadMain, this, 0,
+		                              m_PcapDescriptor.get(), getCoreId(0));
+		for (uint32_t i = 1; i < fanoutConfig.threadCount; i++)
+		{
+			m_FanoutThreads.emplace_back(&pcpp::PcapLiveDevice::fanoutCaptureThreadMain, this, i,
+			                             m_FanoutDescriptors[i - 1].get(), getCoreId(i));
+		}
+
+		m_CaptureThreadStarted = true;
+
+		PCPP_LOG_DEBUG("Successfully created " << fanoutConfig.threadCount << " fanout capture threads for device '"
+		                                       << m_InterfaceDetails.name << "'");
+
+		return true;
+
+#else
+
+		(void)fanoutConfig;
+		(void)onPacketArrives;
+		(void)onPacketArrivesUserCookie;
+		PCPP_LOG_ERROR("Fanout capture is only supported on Linux");
+		return false;
+
+#endif
 	}
 
 	void PcapLiveDevice::captureThreadMain()
@@ -400,11 +748,34 @@ namespace pcpp
 		PCPP_LOG_DEBUG("Started capture thread for device '" << m_InterfaceDetails.name << "'");
 		m_CaptureThreadStarted = true;
 
-		if (m_CaptureCallbackMode)
+		if (m_ActiveTimingRecorder != nullptr)
+			m_ActiveTimingRecorder->beginCapture();
+
+		if (m_CaptureBatchMode)
+		{
+			while (!m_StopThread)
+			{
+				// the count limits a round to the size of the packet array
+				int result = dispatchPackets(m_PcapDescriptor.get(), static_cast<int>(m_BatchSize),
+				                             onPacketArrivesBatchMode, reinterpret_cast<uint8_t*>(this),
+				                             m_ActiveTimingRecorder);
+
+				// packets collected before pcap_breakloop() stopped the round are delivered as well
+				deliverPacketBatch();
+
+				if (result == -1)
+				{
+					PCPP_LOG_ERROR("pcap_dispatch returned an error: " << m_PcapDescriptor.getLastError());
+					m_StopThread = true;
+				}
+			}
+		}
+		else if (m_CaptureCallbackMode)
 		{
 			while (!m_StopThread)
 			{
-				if (pcap_dispatch(m_PcapDescriptor.get(), -1, onPacketArrives, reinterpret_cast<uint8_t*>(this)) == -1)
+				if (dispatchPackets(m_PcapDescriptor.get(), -1, onPacketArrives, reinterpret_cast<uint8_t*>(this),
+				                    m_ActiveTimingRecorder) == -1)
 				{
 					PCPP_LOG_ERROR("pcap_dispatch returned an error: " << m_PcapDescriptor.getLastError());
 					m_StopThread = true;
@@ -415,8 +786,8 @@ namespace pcpp
 		{
 			while (!m_StopThread)
 			{
-				if (pcap_dispatch(m_PcapDescriptor.get(), 100, onPacketArrivesNoCallback,
-				                  reinterpret_cast<uint8_t*>(this)) == -1)
+				if (dispatchPackets(m_PcapDescriptor.get(), 100, onPacketArrivesNoCallback,
+				                    reinterpret_cast<uint8_t*>(this), m_ActiveTimingRecorder) == -1)
 				{
 					PCPP_LOG_ERROR("pcap_dispatch returned an error: " << m_PcapDescriptor.getLastError());
 					m_StopThread = true;
@@ -590,6 +961,7 @@ namespace pcpp
 
 		PCPP_LOG_DEBUG("Device '" << m_InterfaceDetails.name << "' opened");
 		m_PcapDescriptor = std::move(pcapDescriptor);
+		m_DeviceConfig = config;
 		// The send descriptor is held as a raw pointer as it can sometimes be the same as the receive descriptor
 		m_PcapSendDescriptor = pcapSendDescriptor.release();
 		m_DeviceOpened = true;
@@ -628,6 +1000,11 @@ namespace pcpp
 
 		bool sameDescriptor = (m_PcapDescriptor.get() == m_PcapSendDescriptor);
 		m_PcapDescriptor.reset();
+		m_FanoutDescriptors.clear();
+		m_FilterAsString.clear();
+		m_FanoutThreadCount = 0;
+		m_ClosedFanoutStats = {};
+		m_FanoutGroupId = -1;
 		PCPP_LOG_DEBUG("Receive pcap descriptor closed");
 		if (!sameDescriptor)
 		{
@@ -675,6 +1052,7 @@ namespace pcpp
 		// try
 		//{
 		prepareCapture(true, onStatsUpdate != nullptr);
+		prepareTimingRecorders(1);
 		//}
 		// catch (std::exception const& ex)
 		//{
@@ -683,6 +1061,7 @@ namespace pcpp
 		//}
 
 		m_CaptureCallbackMode = true;
+		m_CaptureBatchMode = false;
 		m_cbOnPacketArrives = std::move(onPacketArrives);
 		m_cbOnPacketArrivesUserCookie = onPacketArrivesUserCookie;
 
@@ -727,6 +1106,7 @@ namespace pcpp
 		// try
 		//{
 		prepareCapture(true, false);
+		prepareTimingRecorders(1);
 		//}
 		// catch (const std::exception& ex)
 		//{
@@ -738,6 +1118,7 @@ namespace pcpp
 		m_CapturedPackets->clear();
 
 		m_CaptureCallbackMode = false;
+		m_CaptureBatchMode = false;
 		m_CaptureThread = std::thread(&pcpp::PcapLiveDevice::captureThreadMain, this);
 		// Wait thread to be start
 		// C++20 = m_CaptureThreadStarted.wait(true);
@@ -752,6 +1133,54 @@ namespace pcpp
 		return true;
 	}
 
+	bool PcapLiveDevice::startCaptureBatchMode(OnPacketsArriveCallback onPacketsArrive,
+	                                           void* onPacketsArriveUserCookie, uint32_t batchSize)
+	{
+		if (!m_DeviceOpened || m_PcapDescriptor == nullptr)
+		{
+			PCPP_LOG_ERROR("Device '" << m_InterfaceDetails.name << "' not opened");
+			return false;
+		}
+
+		if (captureActive())
+		{
+			PCPP_LOG_ERROR("Device '" << m_InterfaceDetails.name << "' already capturing traffic");
+			return false;
+		}
+
+		if (onPacketsArrive == nullptr || batchSize == 0)
+		{
+			PCPP_LOG_ERROR("Batch capture requires a callback and a batch size larger than 0");
+			return false;
+		}
+
+		prepareCapture(true, false);
+		prepareTimingRecorders(1);
+
+		m_CaptureBatchMode = true;
+		m_cbOnPacketsArrive = std::move(onPacketsArrive);
+		m_cbOnPacketsArriveUserCookie = onPacketsArriveUserCookie;
+		m_BatchSize = batchSize;
+		m_BatchPacketInfo.clear();
+		m_BatchPacketInfo.reserve(batchSize);
+		m_BatchSlab.clear();
+		if (m_BatchPackets.size() < batchSize)
+			m_BatchPackets.resize(batchSize);
+
+		m_CaptureThread = std::thread(&pcpp::PcapLiveDevice::captureThreadMain, this);
+		// Wait thread to be start
+		// C++20 = m_CaptureThreadStarted.wait(true);
+		while (m_CaptureThreadStarted != true)
+		{
+			std::this_thread::yield();
+		}
+
+		PCPP_LOG_DEBUG("Successfully created batch capture thread for device '"
+		               << m_InterfaceDetails.name << "'. Thread id: " << m_CaptureThread.get_id());
+
+		return true;
+	}
+
 	int PcapLiveDevice::startCaptureBlockingMode(OnPacketArrivesStopBlocking onPacketArrives, void* userCookie,
 	                                             const double timeout)
 	{
@@ -770,6 +1199,7 @@ namespace pcpp
 		// try
 		//{
 		prepareCapture(false, false);
+		prepareTimingRecorders(1);
 		//}
 		// catch (const std::exception& ex)
 		//{
@@ -785,6 +1215,9 @@ namespace pcpp
 		m_CaptureThreadStarted = true;
 		m_StopThread = false;
 
+		if (m_ActiveTimingRecorder != nullptr)
+			m_ActiveTimingRecorder->beginCapture();
+
 		const int64_t timeoutMs = timeout * 1000;  // timeout unit is seconds, let's change it to milliseconds
 		auto startTime = std::chrono::steady_clock::now();
 		auto currentTime = startTime;
@@ -802,8 +1235,8 @@ namespace pcpp
 		{
 			while (!m_StopThread)
 			{
-				if (pcap_dispatch(m_PcapDescriptor.get(), -1, onPacketArrivesBlockingMode,
-				                  reinterpret_cast<uint8_t*>(this)) == -1)
+				if (dispatchPackets(m_PcapDescriptor.get(), -1, onPacketArrivesBlockingMode,
+				                    reinterpret_cast<uint8_t*>(this), m_ActiveTimingRecorder) == -1)
 				{
 					PCPP_LOG_ERROR("pcap_dispatch returned an error: " << m_PcapDescriptor.getLastError());
 					shouldReturnError = true;
@@ -830,8 +1263,8 @@ namespace pcpp
 
 					if (ready > 0)
 					{
-						if (pcap_dispatch(m_PcapDescriptor.get(), -1, onPacketArrivesBlockingMode,
-						                  reinterpret_cast<uint8_t*>(this)) == -1)
+						if (dispatchPackets(m_PcapDescriptor.get(), -1, onPacketArrivesBlockingMode,
+						                    reinterpret_cast<uint8_t*>(this), m_ActiveTimingRecorder) == -1)
 						{
 							PCPP_LOG_ERROR("pcap_dispatch returned an error: " << m_PcapDescriptor.getLastError());
 							shouldReturnError = true;
@@ -852,8 +1285,8 @@ namespace pcpp
 				}
 				else
 				{
-					if (pcap_dispatch(m_PcapDescriptor.get(), -1, onPacketArrivesBlockingMode,
-					                  reinterpret_cast<uint8_t*>(this)) == -1)
+					if (dispatchPackets(m_PcapDescriptor.get(), -1, onPacketArrivesBlockingMode,
+					                    reinterpret_cast<uint8_t*>(this), m_ActiveTimingRecorder) == -1)
 					{
 						PCPP_LOG_ERROR("pcap_dispatch returned an error: " << m_PcapDescriptor.getLastError());
 						shouldReturnError = true;
@@ -887,8 +1320,15 @@ namespace pcpp
 		if (m_cbOnPacketArrivesBlockingMode != nullptr)
 			return;
 
-		if (m_CaptureThread.get_id() != std::thread::id{} && m_CaptureThread.get_id() == std::this_thread::get_id())
+		// joining the calling thread would terminate the application
+		std::thread::id currentThreadId = std::this_thread::get_id();
+		bool calledFromCaptureThread = (m_CaptureThread.get_id() == currentThreadId);
+		for (const auto& fanoutThread : m_FanoutThreads)
+			calledFromCaptureThread = calledFromCaptureThread || (fanoutThread.get_id() == currentThreadId);
+
+		if (calledFromCaptureThread)
 		{
+			PCPP_LOG_ERROR("Cannot stop capture from a capture thread of device '" << m_InterfaceDetails.name << "'");
 			return;
 			// throw std::runtime_error("Cannot stop capture from the capture thread itself");
 		}
@@ -897,8 +1337,14 @@ namespace pcpp
 		if (m_CaptureThreadStarted)
 		{
 			pcap_breakloop(m_PcapDescriptor.get());
+			for (auto& pcapDescriptor : m_FanoutDescriptors)
+				pcap_breakloop(pcapDescriptor.get());
 			PCPP_LOG_DEBUG("Stopping capture thread, waiting for it to join...");
 			m_CaptureThread.join();
+			for (auto& fanoutThread : m_FanoutThreads)
+				fanoutThread.join();
+			m_FanoutThreads.clear();
+			closeFanoutDescriptors();
 			m_CaptureThreadStarted = false;
 			PCPP_LOG_DEBUG("Capture thread stopped for device '" << m_InterfaceDetails.name << "'");
 		}
@@ -926,6 +1372,112 @@ namespace pcpp
 		{
 			PCPP_LOG_ERROR("Error getting statistics from live device '" << m_InterfaceDetails.name << "'");
 		}
+
+		stats.packetsRecv += m_ClosedFanoutStats.packetsRecv;
+		stats.packetsDrop += m_ClosedFanoutStats.packetsDrop;
+		stats.packetsDropByInterface += m_ClosedFanoutStats.packetsDropByInterface;
+
+		for (const auto& pcapDescriptor : m_FanoutDescriptors)
+		{
+			PcapStats handleStats;
+			if (!pcapDescriptor.getStatistics(handleStats))
+			{
+				PCPP_LOG_ERROR("Error getting statistics from a fanout handle of live device '"
+				               << m_InterfaceDetails.name << "'");
+				continue;
+			}
+
+			stats.packetsRecv += handleStats.packetsRecv;
+			stats.packetsDrop += handleStats.packetsDrop;
+			stats.packetsDropByInterface += handleStats.packetsDropByInterface;
+		}
+	}
+
+	void PcapLiveDevice::closeFanoutDescriptors()
+	{
+		// the statistics of a handle are lost when it's closed, so they're kept until the device is closed
+		for (const auto& pcapDescriptor : m_FanoutDescriptors)
+		{
+			PcapStats handleStats;
+			if (!pcapDescriptor.getStatistics(handleStats))
+				continue;
+
+			m_ClosedFanoutStats.packetsRecv += handleStats.packetsRecv;
+			m_ClosedFanoutStats.packetsDrop += handleStats.packetsDrop;
+			m_ClosedFanoutStats.packetsDropByInterface += handleStats.packetsDropByInterface;
+		}
+
+		// closing the additional handles leaves the device handle as the only member of the fanout group, so it
+		// receives all of the traffic again
+		m_FanoutDescriptors.clear();
+	}
+
+	bool PcapLiveDevice::setFilter(std::string filterAsString)
+	{
+		if (!IPcapDevice::setFilter(filterAsString))
+			return false;
+
+		m_FilterAsString = filterAsString;
+		for (auto& pcapDescriptor : m_FanoutDescriptors)
+		{
+			if (!pcapDescriptor.setFilter(filterAsString))
+				return false;
+		}
+
+		return true;
+	}
+
+	bool PcapLiveDevice::clearFilter()
+	{
+		if (!IPcapDevice::clearFilter())
+			return false;
+
+		m_FilterAsString.clear();
+		for (auto& pcapDescriptor : m_FanoutDescriptors)
+		{
+			if (!pcapDescriptor.clearFilter())
+				return false;
+		}
+
+		return true;
+	}
+
+	void PcapLiveDevice::prepareTimingRecorders(uint32_t threadCount)
+	{
+		if (!m_CaptureTimingEnabled)
+		{
+			m_ActiveTimingRecorder = nullptr;
+			return;
+		}
+
+		bool timestampsInNanoseconds = false;
+#if defined(PCAP_TSTAMP_PRECISION_NANO)
+		timestampsInNanoseconds = pcap_get_tstamp_precision(m_PcapDescriptor.get()) == PCAP_TSTAMP_PRECISION_NANO;
+#endif
+
+		std::lock_guard<std::mutex> lock(m_TimingRecordersMutex);
+		while (m_TimingRecorders.size() < threadCount)
+			m_TimingRecorders.emplace_back(new internal::CaptureTimingRecorder());
+
+		for (auto& timingRecorder : m_TimingRecorders)
+			timingRecorder->timestampsInNanoseconds = timestampsInNanoseconds;
+
+		m_ActiveTimingRecorder = m_TimingRecorders.front().get();
+	}
+
+	void PcapLiveDevice::getCaptureTimingStats(CaptureTimingStats& stats) const
+	{
+		stats = CaptureTimingStats();
+		std::lock_guard<std::mutex> lock(m_TimingRecordersMutex);
+		for (const auto& timingRecorder : m_TimingRecorders)
+			timingRecorder->addTo(stats);
+	}
+
+	void PcapLiveDevice::resetCaptureTimingStats()
+	{
+		std::lock_guard<std::mutex> lock(m_TimingRecordersMutex);
+		for (auto& timingRecorder : m_TimingRecorders)
+			timingRecorder->reset();
 	}
 
 	bool PcapLiveDevice::doMtuCheck(int packetPayloadLength) const
@@ -6,10 +6,13 @@
 #	include <errno.h>
 #	include <unistd.h>
 #	include <netinet/if_ether.h>
-#	include <netpacket/packet.h>
+#	include <linux/if_packet.h>
 #	include <ifaddrs.h>
 #	include <net/if.h>
+#	include <poll.h>
+#	include <sys/mman.h>
 #endif
+#include <vector>
 #include "Logger.h"
 #include "IpUtils.h"
 #include "SystemUtils.h"
@@ -56,6 +59,14 @@ namespace pcpp
 
 #endif  // defined(_WIN32)
 
+#if defined(__linux__)
+#	define TX_DEFAULT_BATCH_SIZE 64
+// the maximum number of messages sendmmsg() sends in one call (UIO_MAXIOV)
+#	define TX_MAX_BATCH_SIZE 1024
+#	define TX_RING_DEFAULT_FRAME_SIZE 2048
+#	define TX_RING_DEFAULT_FRAME_COUNT 1024
+#endif
+
 	struct SocketContainer
 	{
 #if defined(_WIN32)
@@ -64,9 +75,295 @@ namespace pcpp
 		int fd;
 		int interfaceIndex;
 		std::string interfaceName;
+
+		// TPACKET_V3 receive ring, only set if the device was opened with a RxRingConfiguration
+		uint8_t* rxRing = nullptr;
+		size_t rxRingSize = 0;
+		uint32_t rxBlockSize = 0;
+		uint32_t rxBlockCount = 0;
+		uint32_t rxCurrentBlock = 0;
+		// the frames of the current block which weren't read yet. The block is owned by the process until all of
+		// them are read
+		uint32_t rxFramesLeft = 0;
+		const uint8_t* rxNextFrame = nullptr;
+		std::vector<RawPacket> rxBlockPackets;
+
+		// batched send state
+		uint32_t txBatchSize = TX_DEFAULT_BATCH_SIZE;
+		RawSocketDevice::OnTxBatchSent onTxBatchSent = nullptr;
+		void* onTxBatchSentUserCookie = nullptr;
+		std::vector<mmsghdr> txMessages;
+		std::vector<iovec> txIovecs;
+		std::vector<sockaddr_ll> txAddresses;
+		std::vector<uint32_t> txFrameIndexes;
+
+		// PACKET_TX_RING transmit ring (TPACKET_V2), only set if enabled with setTxConfiguration()
+		uint8_t* txRing = nullptr;
+		size_t txRingSize = 0;
+		uint32_t txFrameSize = 0;
+		uint32_t txFrameCount = 0;
+		uint32_t txCurrentFrame = 0;
 #endif
 	};
 
+#if defined(__linux__)
+#	define RX_RING_DEFAULT_BLOCK_SIZE (1 << 20)
+#	define RX_RING_DEFAULT_BLOCK_COUNT 64
+#	define RX_RING_DEFAULT_BLOCK_TIMEOUT_MS 10
+// frames have a variable size in TPACKET_V3, the frame size is only used by the kernel to validate the ring
+#	define RX_RING_FRAME_SIZE 2048
+
+	static tpacket_block_desc* getRxRingBlock(const SocketContainer* sockContainer, uint32_t blockIndex)
+	{
+		return reinterpret_cast<tpacket_block_desc*>(sockContainer->rxRing +
+		                                             static_cast<size_t>(blockIndex) * sockContainer->rxBlockSize);
+	}
+
+	static bool isRxRingBlockReady(const tpacket_block_desc* block)
+	{
+		return (__atomic_load_n(&block->hdr.bh1.block_status, __ATOMIC_ACQUIRE) & TP_STATUS_USER) != 0;
+	}
+
+	static void setRxRingFrame(RawPacket& rawPacket, const tpacket3_hdr* frame)
+	{
+		const uint8_t* data = reinterpret_cast<const uint8_t*>(frame) + frame->tp_mac;
+		timespec timestamp;
+		timestamp.tv_sec = frame->tp_sec;
+		timestamp.tv_nsec = frame->tp_nsec;
+
+		// the packet doesn't own the data, which belongs to the ring
+		rawPacket.initWithRawData(data, static_cast<int>(frame->tp_snaplen), timestamp, LINKTYPE_ETHERNET);
+		if (frame->tp_len != frame->tp_snaplen)
+		{
+			rawPacket.setRawData(data, static_cast<int>(frame->tp_snaplen), timestamp, LINKTYPE_ETHERNET,
+			                     static_cast<int>(frame->tp_len));
+		}
+	}
+
+// the packet data of a TPACKET_V2 TX frame starts right after the aligned frame header
+#	define TX_RING_DATA_OFFSET (TPACKET2_HDRLEN - sizeof(sockaddr_ll))
+
+	static tpacket2_hdr* getTxRingFrame(const SocketContainer* sockContainer, uint32_t frameIndex)
+	{
+		return reinterpret_cast<tpacket2_hdr*>(sockContainer->txRing +
+		                                       static_cast<size_t>(frameIndex) * sockContainer->txFrameSize);
+	}
+
+	static uint32_t getTxRingFrameStatus(const tpacket2_hdr* frame)
+	{
+		return __atomic_load_n(&frame->tp_status, __ATOMIC_ACQUIRE);
+	}
+
+	static void setTxRingFrameStatus(tpacket2_hdr* frame, uint32_t status)
+	{
+		__atomic_store_n(&frame->tp_status, status, __ATOMIC_RELEASE);
+	}
+
+	// the same check Packet does when parsing the first layer as EthLayer, without creating the layer
+	static bool isEthernetPacket(const RawPacket* rawPacket)
+	{
+		return rawPacket->getLinkLayerType() == LINKTYPE_ETHERNET &&
+		       EthLayer::isDataValid(rawPacket->getRawData(), rawPacket->getRawDataLen());
+	}
+
+	// wait until the kernel is done with a TX ring frame. Returns false if the frame didn't become available
+	static bool waitForTxRingFrame(const SocketContainer* sockContainer, tpacket2_hdr* frame)
+	{
+		for (int attempt = 0; attempt < 100; attempt++)
+		{
+			uint32_t status = getTxRingFrameStatus(frame);
+			if (status == TP_STATUS_AVAILABLE)
+				return true;
+
+			if (status == TP_STATUS_WRONG_FORMAT)
+			{
+				setTxRingFrameStatus(frame, TP_STATUS_AVAILABLE);
+				return true;
+			}
+
+			// a frame left in TP_STATUS_SEND_REQUEST by a failed send() is flushed again
+			if (status == TP_STATUS_SEND_REQUEST)
+				::send(sockContainer->fd, nullptr, 0, MSG_DONTWAIT);
+
+			pollfd pollFd;
+			pollFd.fd = sockContainer->fd;
+			pollFd.events = POLLOUT;
+			pollFd.revents = 0;
+			poll(&pollFd, 1, 10);
+		}
+
+		return false;
+	}
+
+	// hand a batch of TX ring frames to the kernel and count the frames it accepted
+	static uint32_t flushTxRingBatch(SocketContainer* sockContainer, uint32_t batchLength, uint64_t& bytesSent)
+	{
+		// without MSG_DONTWAIT send() returns after the kernel processed all frames of the batch
+		int result;
+		do
+		{
+			result = ::send(sockContainer->fd, nullptr, 0, 0);
+		} while (result < 0 && errno == EINTR);
+
+		if (result < 0)
+			PCPP_LOG_DEBUG("Failed to flush TX ring. Error was: '" << strerror(errno) << "'");
+
+		uint32_t sentCount = 0;
+		for (uint32_t i = 0; i < batchLength; i++)
+		{
+			tpacket2_hdr* frame = getTxRingFrame(sockContainer, sockContainer->txFrameIndexes[i]);
+			uint32_t status = getTxRingFrameStatus(frame);
+			if (status == TP_STATUS_WRONG_FORMAT || (result < 0 && status == TP_STATUS_SEND_REQUEST))
+			{
+				// the frame is given up, so it can be reused right away
+				setTxRingFrameStatus(frame, TP_STATUS_AVAILABLE);
+				continue;
+			}
+
+			sentCount++;
+			bytesSent += frame->tp_len;
+		}
+
+		return sentCount;
+	}
+
+	// hand a batch of messages to the kernel with sendmmsg(). A message the kernel rejects is skipped and the rest of
+	// the batch is sent with another call
+	static uint32_t sendMessageBatch(SocketContainer* sockContainer, uint32_t batchLength, uint64_t& bytesSent)
+	{
+		uint32_t sentCount = 0;
+		uint32_t offset = 0;
+		while (offset < batchLength)
+		{
+			int result = sendmmsg(sockContainer->fd, &sockContainer->txMessages[offset], batchLength - offset, 0);
+			if (result < 0)
+			{
+				if (errno == EINTR)
+					continue;
+
+				PCPP_LOG_DEBUG("Failed to send packet. Error was: '" << strerror(errno) << "'");
+				offset++;
+				continue;
+			}
+
+			for (int i = 0; i < result; i++)
+				bytesSent += sockContainer->txMessages[offset + i].msg_len;
+
+			sentCount += static_cast<uint32_t>(result);
+			offset += static_cast<uint32_t>(result);
+		}
+
+		return sentCount;
+	}
+
+	// send packets in batches with sendmmsg() or through the TX ring. packetAt(i) returns the i-th packet
+	template <typename PacketAccessor>
+	static int sendPacketBatches(SocketContainer* sockContainer, RawSocketDevice::TxStats& txStats,
+	                             RawSocketDevice* device, size_t packetCount, PacketAccessor packetAt)
+	{
+		uint32_t batchSize = sockContainer->txBatchSize;
+		if (sockContainer->txMessages.size() < batchSize)
+		{
+			sockContainer->txMessages.resize(batchSize);
+			sockContainer->txIovecs.resize(batchSize);
+			sockContainer->txAddresses.resize(batchSize);
+			sockContainer->txFrameIndexes.resize(batchSize);
+		}
+
+		int sendCount = 0;
+		size_t packetIndex = 0;
+		while (packetIndex < packetCount)
+		{
+			uint32_t batchLength = 0;
+			while (batchLength < batchSize && packetIndex < packetCount)
+			{
+				const RawPacket* rawPacket = packetAt(packetIndex++);
+				if (!isEthernetPacket(rawPacket))
+				{
+					PCPP_LOG_DEBUG("Can't send non-Ethernet packets");
+					txStats.packetsFailed++;
+					continue;
+				}
+
+				const uint8_t* data = rawPacket->getRawData();
+				size_t dataLen = static_cast<size_t>(rawPacket->getRawDataLen());
+
+				if (sockContainer->txRing != nullptr)
+				{
+					if (dataLen > sockContainer->txFrameSize - TX_RING_DATA_OFFSET)
+					{
+						PCPP_LOG_DEBUG("Packet of " << dataLen << " bytes doesn't fit a TX ring frame");
+						txStats.packetsFailed++;
+						continue;
+					}
+
+					tpacket2_hdr* frame = getTxRingFrame(sockContainer, sockContainer->txCurrentFrame);
+					if (!waitForTxRingFrame(sockContainer, frame))
+					{
+						PCPP_LOG_DEBUG("TX ring frame wasn't released by the kernel");
+						txStats.packetsFailed++;
+						continue;
+					}
+
+					memcpy(reinterpret_cast<uint8_t*>(frame) + TX_RING_DATA_OFFSET, data, dataLen);
+					frame->tp_len = static_cast<uint32_t>(dataLen);
+					setTxRingFrameStatus(frame, TP_STATUS_SEND_REQUEST);
+
+					sockContainer->txFrameIndexes[batchLength] = sockContainer->txCurrentFrame;
+					sockContainer->txCurrentFrame = (sockContainer->txCurrentFrame + 1) % sockContainer->txFrameCount;
+				}
+				else
+				{
+					sockaddr_ll& addr = sockContainer->txAddresses[batchLength];
+					memset(&addr, 0, sizeof(addr));
+					addr.sll_family = PF_PACKET;
+					addr.sll_protocol = htobe16(ETH_P_ALL);
+					addr.sll_halen = 6;
+					addr.sll_ifindex = sockContainer->interfaceIndex;
+					memcpy(addr.sll_addr, data, 6);
+
+					iovec& iov = sockContainer->txIovecs[batchLength];
+					iov.iov_base = const_cast<uint8_t*>(data);
+					iov.iov_len = dataLen;
+
+					mmsghdr& message = sockContainer->txMessages[batchLength];
+					memset(&message, 0, sizeof(message));
+					message.msg_hdr.msg_name = &addr;
+					message.msg_hdr.msg_namelen = sizeof(addr);
+					message.msg_hdr.msg_iov = &iov;
+					message.msg_hdr.msg_iovlen = 1;
+				}
+
+				batchLength++;
+			}
+
+			if (batchLength == 0)
+				break;
+
+			uint32_t sentCount = sockContainer->txRing != nullptr
+			                         ? flushTxRingBatch(sockContainer, batchLength, txStats.bytesSent)
+			                         : sendMessageBatch(sockContainer, batchLength, txStats.bytesSent);
+
+			txStats.batches++;
+			txStats.packetsSent += sentCount;
+			txStats.packetsFailed += batchLength - sentCount;
+			if (sentCount < batchLength)
+			{
+				txStats.partialBatches++;
+				PCPP_LOG_DEBUG("Batch of " << batchLength << " packets was sent partially: " << sentCount
+				                           << " packets were sent");
+			}
+
+			if (sockContainer->onTxBatchSent != nullptr)
+				sockContainer->onTxBatchSent(batchLength, sentCount, device, sockContainer->onTxBatchSentUserCookie);
+
+			sendCount += static_cast<int>(sentCount);
+		}
+
+		return sendCount;
+	}
+#endif  // defined(__linux__)
+
 	RawSocketDevice::RawSocketDevice(const IPAddress& interfaceIP) : IDevice(), m_Socket(nullptr)
 	{
 #if defined(_WIN32)
@@ -151,6 +448,9 @@ namespace pcpp
 			return RecvError;
 		}
 
+		if (isRxRingEnabled())
+			return receivePacketFromRxRing(rawPacket, blocking, timeout);
+
 		int fd = ((SocketContainer*)m_Socket)->fd;
 		char* buffer = new char[RAW_SOCKET_BUFFER_LEN];
 		memset(buffer, 0, RAW_SOCKET_BUFFER_LEN);
@@ -278,6 +578,18 @@ namespace pcpp
 			return false;
 		}
 
+		// once a TX ring is set up the kernel only sends the packets in the ring
+		if (isTxRingEnabled())
+		{
+			if (sendPackets(rawPacket, 1) != 1)
+			{
+				PCPP_LOG_ERROR("Failed to send packet through the TX ring");
+				return false;
+			}
+
+			return true;
+		}
+
 		int fd = ((SocketContainer*)m_Socket)->fd;
 
 		sockaddr_ll addr;
@@ -323,50 +635,165 @@ namespace pcpp
 			return 0;
 		}
 
-		int fd = ((SocketContainer*)m_Socket)->fd;
+		return sendPacketBatches((SocketContainer*)m_Socket, m_TxStats, this, packetVec.size(),
+		                         [&packetVec](size_t index) -> const RawPacket* { return packetVec.at(index); });
 
-		sockaddr_ll addr;
-		memset(&addr, 0, sizeof(struct sockaddr_ll));
-		addr.sll_family = htobe16(PF_PACKET);
-		addr.sll_protocol = htobe16(ETH_P_ALL);
-		addr.sll_halen = 6;
-		addr.sll_ifindex = ((SocketContainer*)m_Socket)->interfaceIndex;
+#else
 
-		int sendCount = 0;
+		PCPP_LOG_ERROR("Raw socket are not supported on this platform");
+		return false;
+
+#endif
+	}
+
+	int RawSocketDevice::sendPackets(const RawPacket* rawPacketsArr, int arrLength)
+	{
+#if defined(__linux__)
+
+		if (!isOpened())
+		{
+			PCPP_LOG_ERROR("Device is not open");
+			return 0;
+		}
+
+		if (rawPacketsArr == nullptr || arrLength <= 0)
+			return 0;
+
+		return sendPacketBatches((SocketContainer*)m_Socket, m_TxStats, this, static_cast<size_t>(arrLength),
+		                         [rawPacketsArr](size_t index) { return &rawPacketsArr[index]; });
+
+#else
+
+		(void)rawPacketsArr;
+		(void)arrLength;
+		PCPP_LOG_ERROR("Sending packets with raw socket is only supported on Linux");
+		return 0;
+
+#endif
+	}
+
+	bool RawSocketDevice::setTxConfiguration(const TxConfiguration& txConfig)
+	{
+#if defined(__linux__)
+
+		if (!isOpened())
+		{
+			PCPP_LOG_ERROR("Device is not open");
+			return false;
+		}
+
+		SocketContainer* sockContainer = (SocketContainer*)m_Socket;
 
-		for (RawPacketVector::ConstVectorIterator iter = packetVec.begin(); iter != packetVec.end(); iter++)
+		uint32_t batchSize = txConfig.batchSize != 0 ? txConfig.batchSize : TX_DEFAULT_BATCH_SIZE;
+		if (batchSize > TX_MAX_BATCH_SIZE)
+			batchSize = TX_MAX_BATCH_SIZE;
+
+		uint32_t frameSize = txConfig.txRingFrameSize != 0 ? txConfig.txRingFrameSize : TX_RING_DEFAULT_FRAME_SIZE;
+		uint32_t frameCount = txConfig.txRingFrameCount != 0 ? txConfig.txRingFrameCount : TX_RING_DEFAULT_FRAME_COUNT;
+
+		if (txConfig.useTxRing && sockContainer->txRing == nullptr)
 		{
-			Packet packet(*iter, OsiModelDataLinkLayer);
-			if (!packet.isPacketOfType(pcpp::Ethernet))
+			if (isRxRingEnabled())
 			{
-				PCPP_LOG_DEBUG("Can't send non-Ethernet packets");
-				continue;
+				PCPP_LOG_ERROR("A TX ring can't be set up on a device opened with a receive ring");
+				return false;
 			}
 
-			EthLayer* ethLayer = packet.getLayerOfType<EthLayer>();
-			MacAddress dstMac = ethLayer->getDestMac();
-			dstMac.copyTo((uint8_t*)&(addr.sll_addr));
+			if ((frameSize & (frameSize - 1)) != 0 || frameSize <= TX_RING_DATA_OFFSET)
+			{
+				PCPP_LOG_ERROR("TX ring frame size must be a power of 2 larger than " << TX_RING_DATA_OFFSET);
+				return false;
+			}
 
-			if (::sendto(fd, (*iter)->getRawData(), (*iter)->getRawDataLen(), 0, (struct sockaddr*)&addr,
-			             sizeof(addr)) == -1)
+			// frames are laid out back to back in blocks of at least a page
+			uint32_t blockSize = frameSize;
+			long pageSize = sysconf(_SC_PAGESIZE);
+			while (pageSize > 0 && blockSize < static_cast<uint32_t>(pageSize))
+				blockSize <<= 1;
+			uint32_t framesPerBlock = blockSize / frameSize;
+			uint32_t blockCount = (frameCount + framesPerBlock - 1) / framesPerBlock;
+			frameCount = blockCount * framesPerBlock;
+
+			int version = TPACKET_V2;
+			if (setsockopt(sockContainer->fd, SOL_PACKET, PACKET_VERSION, &version, sizeof(version)) < 0)
 			{
-				PCPP_LOG_DEBUG("Failed to send packet. Error was: '" << strerror(errno) << "'");
-				continue;
+				PCPP_LOG_ERROR("Cannot set TPACKET_V2 on raw socket: " << strerror(errno));
+				return false;
+			}
+
+			// mark malformed frames with TP_STATUS_WRONG_FORMAT and go on with the next ones instead of failing
+			int discardMalformed = 1;
+			if (setsockopt(sockContainer->fd, SOL_PACKET, PACKET_LOSS, &discardMalformed, sizeof(discardMalformed)) < 0)
+			{
+				PCPP_LOG_ERROR("Cannot set PACKET_LOSS on raw socket: " << strerror(errno));
+				return false;
+			}
+
+			tpacket_req ringRequest;
+			memset(&ringRequest, 0, sizeof(ringRequest));
+			ringRequest.tp_block_size = blockSize;
+			ringRequest.tp_block_nr = blockCount;
+			ringRequest.tp_frame_size = frameSize;
+			ringRequest.tp_frame_nr = frameCount;
+			if (setsockopt(sockContainer->fd, SOL_PACKET, PACKET_TX_RING, &ringRequest, sizeof(ringRequest)) < 0)
+			{
+				PCPP_LOG_ERROR("Cannot set up TX ring on raw socket: " << strerror(errno));
+				return false;
+			}
+
+			size_t ringSize = static_cast<size_t>(blockSize) * blockCount;
+			void* ring = mmap(nullptr, ringSize, PROT_READ | PROT_WRITE, MAP_SHARED, sockContainer->fd, 0);
+			if (ring == MAP_FAILED)
+			{
+				PCPP_LOG_ERROR("Cannot map TX ring: " << strerror(errno));
+				return false;
 			}
 
-			sendCount++;
+			sockContainer->txRing = static_cast<uint8_t*>(ring);
+			sockContainer->txRingSize = ringSize;
+			sockContainer->txFrameSize = frameSize;
+			sockContainer->txFrameCount = frameCount;
+			sockContainer->txCurrentFrame = 0;
+		}
+		else if (!txConfig.useTxRing && sockContainer->txRing != nullptr)
+		{
+			PCPP_LOG_ERROR("The TX ring can't be removed from an open device");
+			return false;
 		}
 
-		return sendCount;
+		if (sockContainer->txRing != nullptr && batchSize > sockContainer->txFrameCount)
+			batchSize = sockContainer->txFrameCount;
+
+		int qdiscBypass = txConfig.qdiscBypass ? 1 : 0;
+		if (setsockopt(sockContainer->fd, SOL_PACKET, PACKET_QDISC_BYPASS, &qdiscBypass, sizeof(qdiscBypass)) < 0)
+		{
+			PCPP_LOG_ERROR("Cannot set PACKET_QDISC_BYPASS on raw socket: " << strerror(errno));
+			return false;
+		}
+
+		sockContainer->txBatchSize = batchSize;
+		sockContainer->onTxBatchSent = txConfig.onBatchSent;
+		sockContainer->onTxBatchSentUserCookie = txConfig.onBatchSentUserCookie;
+		return true;
 
 #else
 
-		PCPP_LOG_ERROR("Raw socket are not supported on this platform");
+		(void)txConfig;
+		PCPP_LOG_ERROR("Batched send is only supported on Linux");
 		return false;
 
 #endif
 	}
 
+	bool RawSocketDevice::isTxRingEnabled() const
+	{
+#if defined(__linux__)
+		return m_Socket != nullptr && m_DeviceOpened && ((SocketContainer*)m_Socket)->txRing != nullptr;
+#else
+		return false;
+#endif
+	}
+
 	bool RawSocketDevice::open()
 	{
 #if defined(_WIN32)
@@ -532,6 +959,273 @@ namespace pcpp
 		PCPP_LOG_ERROR("Raw socket are not supported on this platform");
 		return false;
 
+#endif
+	}
+
+	bool RawSocketDevice::open(const RxRingConfiguration& rxRingConfig)
+	{
+#if defined(__linux__) && !(defined(__ANDROID_API__) && __ANDROID_API__ < 24)
+
+		uint32_t blockSize = rxRingConfig.blockSize != 0 ? rxRingConfig.blockSize : RX_RING_DEFAULT_BLOCK_SIZE;
+		uint32_t blockCount = rxRingConfig.blockCount != 0 ? rxRingConfig.blockCount : RX_RING_DEFAULT_BLOCK_COUNT;
+		uint32_t blockTimeoutMS =
+		    rxRingConfig.blockTimeoutMS != 0 ? rxRingConfig.blockTimeoutMS : RX_RING_DEFAULT_BLOCK_TIMEOUT_MS;
+
+		long pageSize = sysconf(_SC_PAGESIZE);
+		if (pageSize <= 0 || blockSize % static_cast<uint32_t>(pageSize) != 0 || blockSize < RX_RING_FRAME_SIZE)
+		{
+			PCPP_LOG_ERROR("Receive ring block size must be a multiple of the page size (" << pageSize << ")");
+			return false;
+		}
+
+		if (rxRingConfig.fanoutGroupId > 0xffff)
+		{
+			PCPP_LOG_ERROR("Fanout group ID must be between 0 and 65535");
+			return false;
+		}
+
+		if (!open())
+			return false;
+
+		SocketContainer* sockContainer = (SocketContainer*)m_Socket;
+		int fd = sockContainer->fd;
+
+		int version = TPACKET_V3;
+		if (setsockopt(fd, SOL_PACKET, PACKET_VERSION, &version, sizeof(version)) < 0)
+		{
+			PCPP_LOG_ERROR("Cannot set TPACKET_V3 on raw socket: " << strerror(errno));
+			close();
+			return false;
+		}
+
+		tpacket_req3 ringRequest;
+		memset(&ringRequest, 0, sizeof(ringRequest));
+		ringRequest.tp_block_size = blockSize;
+		ringRequest.tp_block_nr = blockCount;
+		ringRequest.tp_frame_size = RX_RING_FRAME_SIZE;
+		ringRequest.tp_frame_nr = (blockSize / RX_RING_FRAME_SIZE) * blockCount;
+		ringRequest.tp_retire_blk_tov = blockTimeoutMS;
+		ringRequest.tp_feature_req_word = TP_FT_REQ_FILL_RXHASH;
+		if (setsockopt(fd, SOL_PACKET, PACKET_RX_RING, &ringRequest, sizeof(ringRequest)) < 0)
+		{
+			PCPP_LOG_ERROR("Cannot set up receive ring on raw socket: " << strerror(errno));
+			close();
+			return false;
+		}
+
+		size_t ringSize = static_cast<size_t>(blockSize) * blockCount;
+		void* ring = mmap(nullptr, ringSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_LOCKED, fd, 0);
+		if (ring == MAP_FAILED)
+		{
+			// locking the ring in memory may exceed RLIMIT_MEMLOCK, it's only an optimization
+			ring = mmap(nullptr, ringSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		}
+
+		if (ring == MAP_FAILED)
+		{
+			PCPP_LOG_ERROR("Cannot map receive ring: " << strerror(errno));
+			close();
+			return false;
+		}
+
+		sockContainer->rxRing = static_cast<uint8_t*>(ring);
+		sockContainer->rxRingSize = ringSize;
+		sockContainer->rxBlockSize = blockSize;
+		sockContainer->rxBlockCount = blockCount;
+
+		if (rxRingConfig.fanoutGroupId >= 0)
+		{
+			int fanoutArg = (rxRingConfig.fanoutGroupId & 0xffff) | (static_cast<int>(rxRingConfig.fanoutMode) << 16);
+			if (setsockopt(fd, SOL_PACKET, PACKET_FANOUT, &fanoutArg, sizeof(fanoutArg)) < 0)
+			{
+				PCPP_LOG_ERROR("Cannot join fanout group " << rxRingConfig.fanoutGroupId << ": " << strerror(errno));
+				close();
+				return false;
+			}
+		}
+
+		return true;
+
+#else
+
+		(void)rxRingConfig;
+		PCPP_LOG_ERROR("Receive rings are only supported on Linux");
+		return false;
+
+#endif
+	}
+
+	bool RawSocketDevice::isRxRingEnabled() const
+	{
+#if defined(__linux__)
+		return m_Socket != nullptr && m_DeviceOpened && ((SocketContainer*)m_Socket)->rxRing != nullptr;
+#else
+		return false;
+#endif
+	}
+
+	RawSocketDevice::RecvPacketResult RawSocketDevice::waitForRxRingBlock(int timeoutMS)
+	{
+#if defined(__linux__)
+
+		SocketContainer* sockContainer = (SocketContainer*)m_Socket;
+		if (sockContainer->rxFramesLeft > 0)
+			return RecvSuccess;
+
+		auto start = std::chrono::steady_clock::now();
+		while (true)
+		{
+			tpacket_block_desc* block = getRxRingBlock(sockContainer, sockContainer->rxCurrentBlock);
+			if (isRxRingBlockReady(block))
+			{
+				sockContainer->rxFramesLeft = block->hdr.bh1.num_pkts;
+				sockContainer->rxNextFrame =
+				    reinterpret_cast<const uint8_t*>(block) + block->hdr.bh1.offset_to_first_pkt;
+				if (sockContainer->rxFramesLeft > 0)
+					break;
+
+				// an empty block is handed back right away
+				releaseRxRingBlock();
+				continue;
+			}
+
+			int pollTimeoutMS = timeoutMS;
+			if (timeoutMS > 0)
+			{
+				auto elapsedMS = std::chrono::duration_cast<std::chrono::milliseconds>(
+				                     std::chrono::steady_clock::now() - start)
+				                     .count();
+				if (elapsedMS >= timeoutMS)
+					return RecvTimeout;
+				pollTimeoutMS = static_cast<int>(timeoutMS - elapsedMS);
+			}
+			else if (timeoutMS == 0)
+			{
+				return RecvWouldBlock;
+			}
+
+			pollfd pollFd;
+			pollFd.fd = sockContainer->fd;
+			pollFd.events = POLLIN | POLLERR;
+			pollFd.revents = 0;
+			if (poll(&pollFd, 1, pollTimeoutMS) < 0 && errno != EINTR)
+			{
+				PCPP_LOG_ERROR("poll() on receive ring failed: " << strerror(errno));
+				return RecvError;
+			}
+		}
+
+		return RecvSuccess;
+
+#else
+
+		(void)timeoutMS;
+		return RecvError;
+
+#endif
+	}
+
+	void RawSocketDevice::releaseRxRingBlock()
+	{
+#if defined(__linux__)
+		SocketContainer* sockContainer = (SocketContainer*)m_Socket;
+		tpacket_block_desc* block = getRxRingBlock(sockContainer, sockContainer->rxCurrentBlock);
+		__atomic_store_n(&block->hdr.bh1.block_status, TP_STATUS_KERNEL, __ATOMIC_RELEASE);
+
+		sockContainer->rxFramesLeft = 0;
+		sockContainer->rxNextFrame = nullptr;
+		sockContainer->rxCurrentBlock = (sockContainer->rxCurrentBlock + 1) % sockContainer->rxBlockCount;
+#endif
+	}
+
+	RawSocketDevice::RecvPacketResult RawSocketDevice::receivePacketFromRxRing(RawPacket& rawPacket, bool blocking,
+	                                                                           double timeout)
+	{
+#if defined(__linux__)
+
+		// as with recv(), a zero or negative timeout in blocking mode means waiting indefinitely
+		int timeoutMS = -1;
+		if (!blocking)
+			timeoutMS = 0;
+		else if (timeout > 0)
+			timeoutMS = timeout * 1000 < 1 ? 1 : static_cast<int>(timeout * 1000);
+		RecvPacketResult result = waitForRxRingBlock(timeoutMS);
+		if (result != RecvSuccess)
+			return result;
+
+		SocketContainer* sockContainer = (SocketContainer*)m_Socket;
+		const tpacket3_hdr* frame = reinterpret_cast<const tpacket3_hdr*>(sockContainer->rxNextFrame);
+		const uint8_t* frameData = sockContainer->rxNextFrame + frame->tp_mac;
+
+		// the ring memory is returned to the kernel, so the packet gets its own copy
+		uint8_t* buffer = new uint8_t[frame->tp_snaplen];
+		memcpy(buffer, frameData, frame->tp_snaplen);
+		timespec timestamp;
+		timestamp.tv_sec = frame->tp_sec;
+		timestamp.tv_nsec = frame->tp_nsec;
+		rawPacket.setRawData(buffer, static_cast<int>(frame->tp_snaplen), timestamp, LINKTYPE_ETHERNET,
+		                     static_cast<int>(frame->tp_len));
+
+		sockContainer->rxNextFrame += frame->tp_next_offset;
+		if (--sockContainer->rxFramesLeft == 0)
+			releaseRxRingBlock();
+
+		return RecvSuccess;
+
+#else
+
+		(void)rawPacket;
+		(void)blocking;
+		(void)timeout;
+		return RecvError;
+
+#endif
+	}
+
+	RawSocketDevice::RecvPacketResult RawSocketDevice::receiveBlock(OnRxRingPacketsArrive onPacketsArrive,
+	                                                                void* onPacketsArriveUserCookie, int timeoutMS)
+	{
+		if (!isRxRingEnabled())
+		{
+			PCPP_LOG_ERROR("Device is not open with a receive ring");
+			return RecvError;
+		}
+
+#if defined(__linux__)
+
+		RecvPacketResult result = waitForRxRingBlock(timeoutMS);
+		if (result != RecvSuccess)
+			return result;
+
+		SocketContainer* sockContainer = (SocketContainer*)m_Socket;
+		uint32_t packetCount = sockContainer->rxFramesLeft;
+		std::vector<RawPacket>& packets = sockContainer->rxBlockPackets;
+		if (packets.size() < packetCount)
+			packets.resize(packetCount);
+
+		const uint8_t* frameBytes = sockContainer->rxNextFrame;
+		for (uint32_t i = 0; i < packetCount; ++i)
+		{
+			const tpacket3_hdr* frame = reinterpret_cast<const tpacket3_hdr*>(frameBytes);
+			setRxRingFrame(packets[i], frame);
+			frameBytes += frame->tp_next_offset;
+		}
+
+		onPacketsArrive(packets.data(), packetCount, this, onPacketsArriveUserCookie);
+
+		// the callback may have closed the device
+		if (isRxRingEnabled())
+			releaseRxRingBlock();
+
+		return RecvSuccess;
+
+#else
+
+		(void)onPacketsArrive;
+		(void)onPacketsArriveUserCookie;
+		(void)timeoutMS;
+		return RecvError;
+
 #endif
 	}
 
@@ -543,6 +1237,10 @@ namespace pcpp
 #if defined(_WIN32)
 			closesocket(sockContainer->fd);
 #elif defined(__linux__)
+			if (sockContainer->rxRing != nullptr)
+				munmap(sockContainer->rxRing, sockContainer->rxRingSize);
+			if (sockContainer->txRing != nullptr)
+				munmap(sockContainer->txRing, sockContainer->txRingSize);
 			::close(sockContainer->fd);
 #endif
 			delete sockContainer;
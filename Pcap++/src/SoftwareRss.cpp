@@ -0,0 +1,604 @@
+#define LOG_MODULE PcapLogModuleSoftwareRss
+
+#include "SoftwareRss.h"
+#include "Logger.h"
+#include <algorithm>
+#include <string.h>
+
+namespace pcpp
+{
+	namespace
+	{
+		constexpr uint16_t EtherTypeIPv4 = 0x0800;
+		constexpr uint16_t EtherTypeIPv6 = 0x86dd;
+		constexpr uint16_t EtherTypeVlan = 0x8100;
+		constexpr uint16_t EtherTypeQinQ = 0x88a8;
+		constexpr uint16_t EtherTypeVlan9100 = 0x9100;
+		constexpr uint16_t EtherTypeTransparentEthernet = 0x6558;
+		constexpr uint8_t IpProtocolIPv4 = 4;
+		constexpr uint8_t IpProtocolTcp = 6;
+		constexpr uint8_t IpProtocolUdp = 17;
+		constexpr uint8_t IpProtocolIPv6 = 41;
+		constexpr uint8_t IpProtocolGre = 47;
+		constexpr uint8_t IpProtocolSctp = 132;
+		constexpr uint8_t IPv6HopByHop = 0;
+		constexpr uint8_t IPv6Routing = 43;
+		constexpr uint8_t IPv6Fragment = 44;
+		constexpr uint8_t IPv6Authentication = 51;
+		constexpr uint8_t IPv6DestinationOptions = 60;
+		constexpr uint16_t VxlanPort = 4789;
+		constexpr uint16_t GenevePort = 6081;
+		constexpr size_t EthernetHeaderLength = 14;
+		constexpr size_t SllHeaderLength = 16;
+		constexpr size_t VlanTagLength = 4;
+		constexpr size_t MaxVlanTags = 8;
+		constexpr size_t IPv4MinHeaderLength = 20;
+		constexpr size_t IPv6HeaderLength = 40;
+		constexpr size_t MaxIPv6ExtensionHeaders = 8;
+		constexpr size_t UdpHeaderLength = 8;
+		constexpr size_t VxlanHeaderLength = 8;
+		constexpr size_t GeneveHeaderLength = 8;
+		constexpr size_t GreHeaderLength = 4;
+		// the number of packets ahead whose data hashBatch() prefetches
+		constexpr size_t PrefetchDistance = 4;
+
+		// the key DpdkDevice configures by default
+		const uint8_t DefaultRssKey[RssHasher::MinKeyLength] = {
+			0x6D, 0x5A, 0x6D, 0x5A, 0x6D, 0x5A, 0x6D, 0x5A, 0x6D, 0x5A, 0x6D, 0x5A, 0x6D, 0x5A,
+			0x6D, 0x5A, 0x6D, 0x5A, 0x6D, 0x5A, 0x6D, 0x5A, 0x6D, 0x5A, 0x6D, 0x5A, 0x6D, 0x5A,
+			0x6D, 0x5A, 0x6D, 0x5A, 0x6D, 0x5A, 0x6D, 0x5A, 0x6D, 0x5A, 0x6D, 0x5A,
+		};
+
+		inline uint16_t readBE16(const uint8_t* ptr)
+		{
+			return static_cast<uint16_t>((ptr[0] << 8) | ptr[1]);
+		}
+
+		inline bool isVlanEtherType(uint16_t etherType)
+		{
+			return etherType == EtherTypeVlan || etherType == EtherTypeQinQ || etherType == EtherTypeVlan9100;
+		}
+
+		inline void prefetch(const void* ptr)
+		{
+#if defined(__GNUC__) || defined(__clang__)
+			__builtin_prefetch(ptr);
+#else
+			(void)ptr;
+#endif
+		}
+
+		/// The packet fields the hash input is built from. The addresses and ports point into the packet data
+		struct RssHeaders
+		{
+			uint8_t ipVersion = 0;
+			uint8_t ipProtocol = 0;
+			bool isFragment = false;
+			const uint8_t* srcAddress = nullptr;
+			const uint8_t* dstAddress = nullptr;
+			// the source and destination ports, nullptr if the packet has none or they weren't captured
+			const uint8_t* ports = nullptr;
+		};
+
+		bool parseNetwork(const uint8_t* data, size_t dataLen, uint16_t etherType, bool openTunnels,
+		                  RssHeaders& headers);
+
+		bool parseEthernet(const uint8_t* data, size_t dataLen, bool openTunnels, RssHeaders& headers)
+		{
+			if (dataLen < EthernetHeaderLength)
+				return false;
+
+			return parseNetwork(data + EthernetHeaderLength, dataLen - EthernetHeaderLength, readBE16(data + 12),
+			                    openTunnels, headers);
+		}
+
+		// parse the encapsulated packet of a tunnel, leaving headers unchanged if it isn't IPv4 / IPv6
+		void parseTunnel(const uint8_t* payload, size_t payloadLen, RssHeaders& headers)
+		{
+			RssHeaders inner;
+			bool parsed = false;
+			switch (headers.ipProtocol)
+			{
+			case IpProtocolIPv4:
+				parsed = parseNetwork(payload, payloadLen, EtherTypeIPv4, false, inner);
+				break;
+			case IpProtocolIPv6:
+				parsed = parseNetwork(payload, payloadLen, EtherTypeIPv6, false, inner);
+				break;
+			case IpProtocolGre:
+			{
+				if (payloadLen < GreHeaderLength)
+					return;
+
+				// version 0 only; the checksum, key and sequence number fields are 4 bytes each when present
+				uint16_t flags = readBE16(payload);
+				if ((flags & 0x0007) != 0)
+					return;
+
+				size_t greLength = GreHeaderLength + ((flags & 0x8000) ? 4 : 0) + ((flags & 0x2000) ? 4 : 0) +
+				                   ((flags & 0x1000) ? 4 : 0);
+				if (payloadLen < greLength)
+					return;
+
+				uint16_t protocol = readBE16(payload + 2);
+				if (protocol == EtherTypeTransparentEthernet)
+					parsed = parseEthernet(payload + greLength, payloadLen - greLength, false, inner);
+				else
+					parsed = parseNetwork(payload + greLength, payloadLen - greLength, protocol, false, inner);
+				break;
+			}
+			case IpProtocolUdp:
+			{
+				if (headers.ports == nullptr || payloadLen < UdpHeaderLength)
+					return;
+
+				uint16_t dstPort = readBE16(headers.ports + 2);
+				const uint8_t* udpPayload = payload + UdpHeaderLength;
+				size_t udpPayloadLen = payloadLen - UdpHeaderLength;
+				if (dstPort == VxlanPort)
+				{
+					if (udpPayloadLen < VxlanHeaderLength)
+						return;
+
+					parsed = parseEthernet(udpPayload + VxlanHeaderLength, udpPayloadLen - VxlanHeaderLength, false,
+					                       inner);
+				}
+				else if (dstPort == GenevePort)
+				{
+					if (udpPayloadLen < GeneveHeaderLength)
+						return;
+
+					size_t geneveLength = GeneveHeaderLength + (udpPayload[0] & 0x3f) * 4;
+					if (udpPayloadLen < geneveLength)
+						return;
+
+					uint16_t protocol = readBE16(udpPayload + 2);
+					if (protocol == EtherTypeTransparentEthernet)
+						parsed = parseEthernet(udpPayload + geneveLength, udpPayloadLen - geneveLength, false, inner);
+					else
+						parsed = parseNetwork(udpPayload + geneveLength, udpPayloadLen - geneveLength, protocol,
+						                      false, inner);
+				}
+				break;
+			}
+			default:
+				break;
+			}
+
+			if (parsed)
+				headers = inner;
+		}
+
+		bool parseNetwork(const uint8_t* data, size_t dataLen, uint16_t etherType, bool openTunnels,
+		                  RssHeaders& headers)
+		{
+			for (size_t i = 0; i < MaxVlanTags && isVlanEtherType(etherType); ++i)
+			{
+				if (dataLen < VlanTagLength)
+					return false;
+
+				etherType = readBE16(data + 2);
+				data += VlanTagLength;
+				dataLen -= VlanTagLength;
+			}
+
+			const uint8_t* payload;
+			size_t payloadLen;
+			bool isFirstFragment = true;
+			if (etherType == EtherTypeIPv4)
+			{
+				if (dataLen < IPv4MinHeaderLength || (data[0] >> 4) != 4)
+					return false;
+
+				size_t headerLength = (data[0] & 0x0f) * 4;
+				if (headerLength < IPv4MinHeaderLength || headerLength > dataLen)
+					return false;
+
+				// an Ethernet trailer isn't part of the IP payload
+				size_t totalLength = readBE16(data + 2);
+				if (totalLength >= headerLength && totalLength < dataLen)
+					dataLen = totalLength;
+
+				uint16_t fragmentField = readBE16(data + 6);
+				headers.ipVersion = 4;
+				headers.ipProtocol = data[9];
+				headers.isFragment = (fragmentField & 0x3fff) != 0;
+				headers.srcAddress = data + 12;
+				headers.dstAddress = data + 16;
+				isFirstFragment = (fragmentField & 0x1fff) == 0;
+				payload = data + headerLength;
+				payloadLen = dataLen - headerLength;
+			}
+			else if (etherType == EtherTypeIPv6)
+			{
+				if (dataLen < IPv6HeaderLength || (data[0] >> 4) != 6)
+					return false;
+
+				headers.ipVersion = 6;
+				headers.srcAddress = data + 8;
+				headers.dstAddress = data + 24;
+
+				uint8_t nextHeader = data[6];
+				payload = data + IPv6HeaderLength;
+				payloadLen = dataLen - IPv6HeaderLength;
+				for (size_t i = 0; i < MaxIPv6ExtensionHeaders; ++i)
+				{
+					size_t extensionLength;
+					if (nextHeader == IPv6HopByHop || nextHeader == IPv6Routing ||
+					    nextHeader == IPv6DestinationOptions)
+					{
+						if (payloadLen < 2)
+							break;
+						extensionLength = (payload[1] + 1) * 8;
+					}
+					else if (nextHeader == IPv6Fragment)
+					{
+						if (payloadLen < 8)
+							break;
+						uint16_t fragmentField = readBE16(payload + 2);
+						headers.isFragment = true;
+						isFirstFragment = (fragmentField & 0xfff8) == 0;
+						extensionLength = 8;
+					}
+					else if (nextHeader == IPv6Authentication)
+					{
+						if (payloadLen < 2)
+							break;
+						extensionLength = (payload[1] + 2) * 4;
+					}
+					else
+					{
+						break;
+					}
+
+					if (payloadLen < extensionLength)
+					{
+						payloadLen = 0;
+						break;
+					}
+
+					nextHeader = payload[0];
+					payload += extensionLength;
+					payloadLen -= extensionLength;
+				}
+
+				headers.ipProtocol = nextHeader;
+			}
+			else
+			{
+				return false;
+			}
+
+			bool hasPorts = headers.ipProtocol == IpProtocolTcp || headers.ipProtocol == IpProtocolUdp ||
+			                headers.ipProtocol == IpProtocolSctp;
+			if (hasPorts && isFirstFragment && payloadLen >= 4)
+				headers.ports = payload;
+
+			if (openTunnels && !headers.isFragment)
+				parseTunnel(payload, payloadLen, headers);
+
+			return true;
+		}
+
+		bool parsePacket(const uint8_t* data, size_t dataLen, LinkLayerType linkType, bool openTunnels,
+		                 RssHeaders& headers)
+		{
+			if (data == nullptr)
+				return false;
+
+			switch (linkType)
+			{
+			case LINKTYPE_ETHERNET:
+				return parseEthernet(data, dataLen, openTunnels, headers);
+			case LINKTYPE_LINUX_SLL:
+				if (dataLen < SllHeaderLength)
+					return false;
+
+				return parseNetwork(data + SllHeaderLength, dataLen - SllHeaderLength, readBE16(data + 14),
+				                    openTunnels, headers);
+			case LINKTYPE_RAW:
+			case LINKTYPE_DLT_RAW1:
+			case LINKTYPE_DLT_RAW2:
+			case LINKTYPE_IPV4:
+			case LINKTYPE_IPV6:
+				if (dataLen == 0)
+					return false;
+
+				return parseNetwork(data, dataLen, (data[0] >> 4) == 6 ? EtherTypeIPv6 : EtherTypeIPv4, openTunnels,
+				                    headers);
+			default:
+				return false;
+			}
+		}
+
+		// write a source / destination field pair to the hash input, transformed by the symmetric hash functions
+		void writeFieldPair(uint8_t* input, const uint8_t* src, const uint8_t* dst, size_t fieldLength,
+		                    RssHasher::HashFunction hashFunction)
+		{
+			switch (hashFunction)
+			{
+			case RssHasher::SymmetricToeplitz:
+				for (size_t i = 0; i < fieldLength; ++i)
+				{
+					input[i] = src[i] ^ dst[i];
+					input[fieldLength + i] = input[i];
+				}
+				return;
+			case RssHasher::SymmetricToeplitzSort:
+				if (memcmp(src, dst, fieldLength) > 0)
+				{
+					const uint8_t* temp = src;
+					src = dst;
+					dst = temp;
+				}
+				break;
+			default:
+				break;
+			}
+
+			memcpy(input, src, fieldLength);
+			memcpy(input + fieldLength, dst, fieldLength);
+		}
+	}  // namespace
+
+	/// ===============
+	/// Class RssHasher
+	/// ===============
+
+	constexpr size_t RssHasher::MaxInputLength;
+	constexpr size_t RssHasher::MinKeyLength;
+
+	RssHasher::RssHasher(const uint8_t* key, size_t keyLength, uint64_t hashTypes, HashFunction hashFunction,
+	                     HashLevel hashLevel)
+	    : m_Key(), m_HashTypes(hashTypes), m_HashFunction(hashFunction), m_HashLevel(hashLevel)
+	{
+		if (key == nullptr)
+		{
+			key = DefaultRssKey;
+			keyLength = sizeof(DefaultRssKey);
+		}
+
+		if (keyLength < MinKeyLength)
+		{
+			PCPP_LOG_ERROR("RSS key must be at least " << MinKeyLength << " bytes long, got " << keyLength);
+			return;
+			// throw std::invalid_argument("RSS key must be at least 40 bytes long");
+		}
+
+		memcpy(m_Key, key, MinKeyLength);
+
+		// each input bit at offset i * 8 + j contributes the 32-bit window of the key starting at the same bit offset
+		m_Table.resize(MaxInputLength * 256);
+		for (size_t i = 0; i < MaxInputLength; ++i)
+		{
+			uint64_t keyBits = (static_cast<uint64_t>(m_Key[i]) << 32) | (static_cast<uint64_t>(m_Key[i + 1]) << 24) |
+			                   (static_cast<uint64_t>(m_Key[i + 2]) << 16) |
+			                   (static_cast<uint64_t>(m_Key[i + 3]) << 8) | m_Key[i + 4];
+
+			uint32_t windows[8];
+			for (int bit = 0; bit < 8; ++bit)
+				windows[bit] = static_cast<uint32_t>(keyBits >> (8 - bit));
+
+			for (int value = 0; value < 256; ++value)
+			{
+				uint32_t result = 0;
+				for (int bit = 0; bit < 8; ++bit)
+				{
+					if (value & (0x80 >> bit))
+						result ^= windows[bit];
+				}
+
+				m_Table[i * 256 + value] = result;
+			}
+		}
+	}
+
+	uint32_t RssHasher::toeplitzHash(const uint8_t* input, size_t inputLength) const
+	{
+		if (inputLength > MaxInputLength || !isValid())
+			return 0;
+
+		uint32_t result = 0;
+		const uint32_t* table = m_Table.data();
+		for (size_t i = 0; i < inputLength; ++i, table += 256)
+			result ^= table[input[i]];
+
+		return result;
+	}
+
+	uint32_t RssHasher::hash(const uint8_t* data, size_t dataLen, LinkLayerType linkType) const
+	{
+		if (!isValid())
+			return 0;
+
+		RssHeaders headers;
+		if (!parsePacket(data, dataLen, linkType, m_HashLevel == InnerHeaders, headers))
+			return 0;
+
+		// the type a NIC classifies the packet as, and the type hashed on addresses only
+		bool isIPv4 = headers.ipVersion == 4;
+		uint64_t l4Type = 0;
+		uint64_t l3Type = 0;
+		if (headers.isFragment)
+		{
+			l3Type = isIPv4 ? FragIPv4 : FragIPv6;
+		}
+		else
+		{
+			switch (headers.ipProtocol)
+			{
+			case IpProtocolTcp:
+				l4Type = isIPv4 ? NonFragIPv4Tcp : NonFragIPv6Tcp;
+				break;
+			case IpProtocolUdp:
+				l4Type = isIPv4 ? NonFragIPv4Udp : NonFragIPv6Udp;
+				break;
+			case IpProtocolSctp:
+				l4Type = isIPv4 ? NonFragIPv4Sctp : NonFragIPv6Sctp;
+				break;
+			default:
+				break;
+			}
+
+			if (l4Type == 0)
+				l3Type = isIPv4 ? NonFragIPv4Other : NonFragIPv6Other;
+		}
+
+		bool hashPorts = (m_HashTypes & l4Type) != 0 && headers.ports != nullptr;
+		if (!hashPorts && (m_HashTypes & (l3Type | (isIPv4 ? IPv4 : IPv6))) == 0)
+			return 0;
+
+		uint8_t input[MaxInputLength];
+		size_t addressLength = isIPv4 ? 4 : 16;
+		writeFieldPair(input, headers.srcAddress, headers.dstAddress, addressLength, m_HashFunction);
+		size_t inputLength = addressLength * 2;
+		if (hashPorts)
+		{
+			writeFieldPair(input + inputLength, headers.ports, headers.ports + 2, 2, m_HashFunction);
+			inputLength += 4;
+		}
+
+		return toeplitzHash(input, inputLength);
+	}
+
+	void RssHasher::hashBatch(const RawPacket* const* rawPackets, size_t count, uint32_t* hashes) const
+	{
+		for (size_t i = 0; i < count && i < PrefetchDistance; ++i)
+			prefetch(rawPackets[i]->getRawData());
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			if (i + PrefetchDistance < count)
+				prefetch(rawPackets[i + PrefetchDistance]->getRawData());
+
+			hashes[i] = hash(rawPackets[i]);
+		}
+	}
+
+	/// ===========================
+	/// Class SoftwareRssDispatcher
+	/// ===========================
+
+	constexpr uint16_t SoftwareRssDispatcher::DefaultRedirectionTableSize;
+	constexpr size_t SoftwareRssDispatcher::BatchChunkSize;
+
+	SoftwareRssDispatcher::SoftwareRssDispatcher(const RssHasher& hasher, uint32_t workerCount, size_t ringCapacity,
+	                                             WorkerCallback workerCallback, BackpressurePolicy policy,
+	                                             uint16_t redirectionTableSize)
+	    : m_Hasher(hasher), m_Pipeline(workerCount, ringCapacity, std::move(workerCallback), policy)
+	{
+		// an empty redirection table marks the dispatcher as invalid
+		if (!m_Hasher.isValid())
+		{
+			PCPP_LOG_ERROR("Cannot create a software RSS dispatcher with an invalid hasher");
+			return;
+		}
+
+		if (redirectionTableSize == 0)
+		{
+			PCPP_LOG_ERROR("Redirection table size must be greater than 0");
+			return;
+			// throw std::invalid_argument("Redirection table size must be greater than 0");
+		}
+
+		if ((redirectionTableSize & (redirectionTableSize - 1)) != 0)
+		{
+			PCPP_LOG_ERROR("Redirection table size must be a power of 2, got " << redirectionTableSize);
+			return;
+			// throw std::invalid_argument("Redirection table size must be a power of 2");
+		}
+
+		// the pipeline printed the reason to log
+		if (!m_Pipeline.isValid())
+			return;
+
+		m_RedirectionTable.resize(redirectionTableSize);
+		for (uint16_t i = 0; i < redirectionTableSize; ++i)
+			m_RedirectionTable[i] = i % workerCount;
+
+		m_WorkerBatches.resize(workerCount);
+		for (auto& batch : m_WorkerBatches)
+			batch.reserve(BatchChunkSize);
+	}
+
+	size_t SoftwareRssDispatcher::dispatchBatch(RawPacket* const* rawPackets, size_t count,
+	                                            std::vector<RawPacket*>* notDispatched)
+	{
+		if (!isValid())
+		{
+			if (notDispatched != nullptr)
+				notDispatched->insert(notDispatched->end(), rawPackets, rawPackets + count);
+
+			return 0;
+		}
+
+		size_t dispatched = 0;
+		uint32_t hashes[BatchChunkSize];
+		for (size_t chunkStart = 0; chunkStart < count; chunkStart += BatchChunkSize)
+		{
+			size_t chunkSize = std::min(BatchChunkSize, count - chunkStart);
+			RawPacket* const* chunk = rawPackets + chunkStart;
+			m_Hasher.hashBatch(chunk, chunkSize, hashes);
+
+			for (size_t i = 0; i < chunkSize; ++i)
+				m_WorkerBatches[getWorkerIndex(hashes[i])].push_back(chunk[i]);
+
+			for (uint32_t workerIndex = 0; workerIndex < m_WorkerBatches.size(); ++workerIndex)
+			{
+				std::vector<RawPacket*>& batch = m_WorkerBatches[workerIndex];
+				if (batch.empty())
+					continue;
+
+				size_t pushed = m_Pipeline.pushBatch(batch.data(), batch.size(), workerIndex);
+				dispatched += pushed;
+				if (notDispatched != nullptr && pushed < batch.size())
+					notDispatched->insert(notDispatched->end(), batch.begin() + pushed, batch.end());
+
+				batch.clear();
+			}
+		}
+
+		return dispatched;
+	}
+
+	bool SoftwareRssDispatcher::setRedirectionTable(const std::vector<uint32_t>& redirectionTable)
+	{
+		if (!isValid())
+		{
+			PCPP_LOG_ERROR("Cannot set the redirection table of an invalid dispatcher");
+			return false;
+		}
+
+		if (m_Pipeline.isRunning())
+		{
+			PCPP_LOG_ERROR("Cannot set the redirection table while the workers are running");
+			return false;
+		}
+
+		if (redirectionTable.empty())
+		{
+			PCPP_LOG_ERROR("Redirection table must not be empty");
+			return false;
+		}
+
+		if ((redirectionTable.size() & (redirectionTable.size() - 1)) != 0)
+		{
+			PCPP_LOG_ERROR("Redirection table size must be a power of 2, got " << redirectionTable.size());
+			return false;
+		}
+
+		for (uint32_t workerIndex : redirectionTable)
+		{
+			if (workerIndex >= m_Pipeline.getWorkerCount())
+			{
+				PCPP_LOG_ERROR("Redirection table entry " << workerIndex << " isn't a valid worker index, there are "
+				                                          << m_Pipeline.getWorkerCount() << " workers");
+				return false;
+			}
+		}
+
+		m_RedirectionTable = redirectionTable;
+		return true;
+	}
+
+}  // namespace pcpp
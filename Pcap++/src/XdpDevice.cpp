@@ -14,6 +14,9 @@
 #include <functional>
 #include <algorithm>
 #include <poll.h>
+#include <pthread.h>
+#include <sched.h>
+#include <system_error>
 
 namespace pcpp
 {
@@ -29,6 +32,8 @@ namespace pcpp
 	{
 		struct xsk_ring_cons rx;
 		struct xsk_ring_prod tx;
+		struct xsk_ring_prod fq;
+		struct xsk_ring_cons cq;
 		struct xsk_socket* xsk;
 	};
 
@@ -37,6 +42,26 @@ namespace pcpp
 #define DEFAULT_COMPLETION_RING_SIZE XSK_RING_PROD__DEFAULT_NUM_DESCS
 #define DEFAULT_BATCH_SIZE 64
 #define IS_POWER_OF_TWO(num) (num && ((num & (num - 1)) == 0))
+#define RECEIVE_THREAD_POLL_TIMEOUT_MS 100
+
+	namespace
+	{
+		// queue counters are only written by the thread that uses the queue, so a load and a store are enough
+		void incrementCounter(std::atomic<uint64_t>& counter, uint64_t value)
+		{
+			counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+		}
+
+		void setCounter(std::atomic<uint64_t>& counter, uint64_t value)
+		{
+			counter.store(value, std::memory_order_relaxed);
+		}
+
+		uint64_t getCounter(const std::atomic<uint64_t>& counter)
+		{
+			return counter.load(std::memory_order_relaxed);
+		}
+	}  // namespace
 
 	XdpDevice::XdpUmem::XdpUmem(uint16_t numFrames, uint16_t frameSize, uint32_t fillRingSize,
 	                            uint32_t completionRingSize)
@@ -60,23 +85,21 @@ namespace pcpp
 		int ret = xsk_umem__create(&umem->umem, m_Buffer, bufferSize, &umem->fq, &umem->cq, &cfg);
 		if (ret)
 		{
+			delete umem;
+			free(m_Buffer);
 			throw std::runtime_error("Could not allocate UMEM - xsk_umem__create() returned " + std::to_string(ret));
 		}
 
 		m_UmemInfo = umem;
-
-		for (uint16_t i = 0; i < numFrames; i++)
-		{
-			m_FreeFrames.push_back(i * frameSize);
-		}
-
 		m_FrameSize = frameSize;
 		m_FrameCount = numFrames;
 	}
 
 	XdpDevice::XdpUmem::~XdpUmem()
 	{
-		xsk_umem__delete(static_cast<xsk_umem_info*>(m_UmemInfo)->umem);
+		auto umemInfo = static_cast<xsk_umem_info*>(m_UmemInfo);
+		xsk_umem__delete(umemInfo->umem);
+		delete umemInfo;
 		free(m_Buffer);
 	}
 
@@ -85,40 +108,62 @@ namespace pcpp
 		return static_cast<const uint8_t*>(xsk_umem__get_data(m_Buffer, addr));
 	}
 
+	uint8_t* XdpDevice::XdpUmem::getDataPtr(uint64_t addr)
+	{
+		return static_cast<uint8_t*>(xsk_umem__get_data(m_Buffer, addr));
+	}
+
 	void XdpDevice::XdpUmem::setData(uint64_t addr, const uint8_t* data, size_t dataLen)
 	{
 		auto dataPtr = static_cast<uint8_t*>(xsk_umem__get_data(m_Buffer, addr));
 		memcpy(dataPtr, data, dataLen);
 	}
 
-	std::pair<bool, std::vector<uint64_t>> XdpDevice::XdpUmem::allocateFrames(uint32_t count)
+	XdpDevice::XdpFramePool::XdpFramePool(uint32_t firstFrame, uint32_t numFrames, uint16_t frameSize)
+	    : m_FrameMask(~static_cast<uint64_t>(frameSize - 1)), m_FrameCount(numFrames), m_FreeFrameTop(numFrames),
+	      m_FreeFrames(new uint64_t[numFrames]), m_FreeFrameCount(numFrames)
 	{
-		if (m_FreeFrames.size() < count)
+		for (uint32_t i = 0; i < numFrames; i++)
 		{
-			PCPP_LOG_ERROR("Not enough frames to allocate. Requested: " << count
-			                                                            << ", available: " << m_FreeFrames.size());
-			return { false, {} };
+			m_FreeFrames[i] = static_cast<uint64_t>(firstFrame + i) * frameSize;
 		}
+	}
 
-		std::vector<uint64_t> result;
-		for (uint32_t i = 0; i < count; i++)
+	bool XdpDevice::XdpFramePool::allocateFrames(uint64_t frames[], uint32_t count)
+	{
+		if (m_FreeFrameTop < count)
 		{
-			result.push_back(m_FreeFrames.back());
-			m_FreeFrames.pop_back();
+			PCPP_LOG_ERROR("Not enough frames to allocate. Requested: " << count << ", available: " << m_FreeFrameTop);
+			return false;
 		}
 
-		return { true, result };
+		m_FreeFrameTop -= count;
+		memcpy(frames, &m_FreeFrames[m_FreeFrameTop], count * sizeof(uint64_t));
+		m_FreeFrameCount.store(m_FreeFrameTop, std::memory_order_relaxed);
+		return true;
 	}
 
-	void XdpDevice::XdpUmem::freeFrame(uint64_t addr)
+	void XdpDevice::XdpFramePool::freeFrames(const uint64_t frames[], uint32_t count)
 	{
-		auto frame = (uint64_t)((addr / m_FrameSize) * m_FrameSize);
-		m_FreeFrames.push_back(frame);
+		if (count > m_FrameCount - m_FreeFrameTop)
+		{
+			PCPP_LOG_ERROR("Cannot free " << count << " frames, only " << m_FrameCount - m_FreeFrameTop
+			                              << " are allocated");
+			return;
+		}
+
+		// the frame size is the page size, so the mask rounds an address inside a frame down to the frame start
+		for (uint32_t i = 0; i < count; i++)
+		{
+			m_FreeFrames[m_FreeFrameTop++] = frames[i] & m_FrameMask;
+		}
+
+		m_FreeFrameCount.store(m_FreeFrameTop, std::memory_order_relaxed);
 	}
 
 	XdpDevice::XdpDevice(std::string interfaceName)
-	    : m_InterfaceName(std::move(interfaceName)), m_Config(nullptr), m_ReceivingPackets(false), m_Umem(nullptr),
-	      m_SocketInfo(nullptr)
+	    : m_InterfaceName(std::move(interfaceName)), m_Config(nullptr), m_ReceivingPackets(false),
+	      m_StopReceiveThreads(false)
 	{
 		memset(&m_Stats, 0, sizeof(m_Stats));
 		memset(&m_PrevStats, 0, sizeof(m_PrevStats));
@@ -137,23 +182,33 @@ namespace pcpp
 			return false;
 		}
 
-		auto socketInfo = static_cast<xsk_socket_info*>(m_SocketInfo);
+		if (areReceiveThreadsRunning())
+		{
+			PCPP_LOG_ERROR("Packets are being received by receive threads");
+			return false;
+		}
 
 		m_ReceivingPackets = true;
-		uint32_t rxId = 0;
 
-		pollfd pollFds[1];
-		pollFds[0] = { .fd = xsk_socket__fd(socketInfo->xsk), .events = POLLIN };
+		std::vector<pollfd> pollFds;
+		for (const auto& queue : m_Queues)
+		{
+			auto socketInfo = static_cast<xsk_socket_info*>(queue->socketInfo);
+			pollFds.push_back({ .fd = xsk_socket__fd(socketInfo->xsk), .events = POLLIN });
+		}
 
 		std::vector<RawPacket> receiveBuffer;
 		while (m_ReceivingPackets)
 		{
-			checkCompletionRing();
+			for (const auto& queue : m_Queues)
+			{
+				checkCompletionRing(*queue);
+			}
 
-			auto pollResult = poll(pollFds, 1, timeoutMS);
+			auto pollResult = poll(pollFds.data(), pollFds.size(), timeoutMS);
 			if (pollResult == 0 && timeoutMS != 0)
 			{
-				m_Stats.rxPollTimeout++;
+				incrementCounter(m_Queues.front()->counters.rxPollTimeout, 1);
 				m_ReceivingPackets = false;
 				return true;
 			}
@@ -169,60 +224,93 @@ namespace pcpp
 				return true;
 			}
 
-			uint32_t receivedPacketsCount = xsk_ring_cons__peek(&socketInfo->rx, m_Config->rxTxBatchSize, &rxId);
-
-			if (receivedPacketsCount == 0)
+			for (size_t i = 0; i < m_Queues.size() && m_ReceivingPackets; i++)
 			{
-				continue;
+				XdpQueue& queue = *m_Queues[i];
+				uint32_t receivedPacketsCount = peekReceivedPackets(queue, receiveBuffer);
+				if (receivedPacketsCount == 0)
+				{
+					continue;
+				}
+
+				onPacketsArrive(receiveBuffer.data(), receivedPacketsCount, this, onPacketsArriveUserCookie);
+
+				if (!releaseReceivedPackets(queue, receivedPacketsCount))
+				{
+					m_ReceivingPackets = false;
+				}
 			}
+		}
 
-			m_Stats.rxPackets += receivedPacketsCount;
+		return true;
+	}
 
-			// Reserves at least enough memory to hold all the received packets. No-op if capacity is enough.
-			// May hold more memory than needed if a previous cycle has reserved more already.
-			receiveBuffer.reserve(receivedPacketsCount);
+	void XdpDevice::stopReceivePackets()
+	{
+		m_ReceivingPackets = false;
+	}
 
-			for (uint32_t i = 0; i < receivedPacketsCount; i++)
-			{
-				uint64_t addr = xsk_ring_cons__rx_desc(&socketInfo->rx, rxId + i)->addr;
-				uint32_t len = xsk_ring_cons__rx_desc(&socketInfo->rx, rxId + i)->len;
+	uint32_t XdpDevice::peekReceivedPackets(XdpQueue& queue, std::vector<RawPacket>& receiveBuffer)
+	{
+		auto socketInfo = static_cast<xsk_socket_info*>(queue.socketInfo);
 
-				auto data = m_Umem->getDataPtr(addr);
-				timespec ts;
-				clock_gettime(CLOCK_REALTIME, &ts);
-				// Initializes the RawPacket directly into the buffer.
-				receiveBuffer.emplace_back(data, static_cast<int>(len), ts, false);
+		// Clears the receive buffer of the previous batch.
+		receiveBuffer.clear();
+		queue.receivedFrames.clear();
 
-				m_Stats.rxBytes += len;
+		uint32_t rxId = 0;
+		uint32_t receivedPacketsCount = xsk_ring_cons__peek(&socketInfo->rx, m_Config->rxTxBatchSize, &rxId);
+		if (receivedPacketsCount == 0)
+		{
+			return 0;
+		}
 
-				m_Umem->freeFrame(addr);
-			}
+		// Reserves at least enough memory to hold all the received packets. No-op if capacity is enough.
+		// May hold more memory than needed if a previous cycle has reserved more already.
+		receiveBuffer.reserve(receivedPacketsCount);
+		queue.receivedFrames.reserve(receivedPacketsCount);
 
-			onPacketsArrive(receiveBuffer.data(), receiveBuffer.size(), this, onPacketsArriveUserCookie);
+		bool timestampPerPacket = m_Config->timestampMode == XdpDeviceConfiguration::PacketTimestamp;
+		timespec ts;
+		clock_gettime(CLOCK_REALTIME, &ts);
 
-			xsk_ring_cons__release(&socketInfo->rx, receivedPacketsCount);
-			m_Stats.rxRingId = rxId + receivedPacketsCount;
+		uint64_t receivedBytes = 0;
+		for (uint32_t i = 0; i < receivedPacketsCount; i++)
+		{
+			const struct xdp_desc* rxDesc = xsk_ring_cons__rx_desc(&socketInfo->rx, rxId + i);
 
-			if (!populateFillRing(receivedPacketsCount, rxId))
+			if (timestampPerPacket && i > 0)
 			{
-				m_ReceivingPackets = false;
+				clock_gettime(CLOCK_REALTIME, &ts);
 			}
 
-			// Clears the receive buffer.
-			receiveBuffer.clear();
+			// Initializes the RawPacket directly into the buffer.
+			receiveBuffer.emplace_back(queue.umem->getDataPtr(rxDesc->addr), static_cast<int>(rxDesc->len), ts,
+			                           false);
+			receivedBytes += rxDesc->len;
+
+			// the frame is freed by releaseReceivedPackets() once the callback is done with the packet, so a send
+			// from the callback can't allocate it and overwrite the packet data
+			queue.receivedFrames.push_back(rxDesc->addr);
 		}
 
-		return true;
+		incrementCounter(queue.counters.rxPackets, receivedPacketsCount);
+		incrementCounter(queue.counters.rxBytes, receivedBytes);
+		setCounter(queue.counters.rxRingId, rxId + receivedPacketsCount);
+
+		return receivedPacketsCount;
 	}
 
-	void XdpDevice::stopReceivePackets()
+	bool XdpDevice::releaseReceivedPackets(XdpQueue& queue, uint32_t count)
 	{
-		m_ReceivingPackets = false;
+		auto socketInfo = static_cast<xsk_socket_info*>(queue.socketInfo);
+		xsk_ring_cons__release(&socketInfo->rx, count);
+		queue.framePool.freeFrames(queue.receivedFrames.data(), static_cast<uint32_t>(queue.receivedFrames.size()));
+		queue.receivedFrames.clear();
+		return populateFillRing(queue, count);
 	}
 
-	bool XdpDevice::sendPackets(const std::function<RawPacket(uint32_t)>& getPacketAt,
-	                            const std::function<uint32_t()>& getPacketCount, bool waitForTxCompletion,
-	                            int waitForTxCompletionTimeoutMS)
+	bool XdpDevice::startReceiveThreads(OnQueuePacketsArrive onPacketsArrive, void* onPacketsArriveUserCookie)
 	{
 		if (!m_DeviceOpened)
 		{
@@ -230,66 +318,186 @@ namespace pcpp
 			return false;
 		}
 
-		auto socketInfo = static_cast<xsk_socket_info*>(m_SocketInfo);
+		if (m_ReceivingPackets || areReceiveThreadsRunning())
+		{
+			PCPP_LOG_ERROR("Packets are already being received");
+			return false;
+		}
+
+		m_StopReceiveThreads = false;
+		const std::vector<int>& coreIds = m_Config->coreIds;
+		for (size_t i = 0; i < m_Queues.size(); i++)
+		{
+			int coreId = coreIds.empty() ? -1 : coreIds[i % coreIds.size()];
+			try
+			{
+				m_ReceiveThreads.emplace_back(&XdpDevice::receiveThreadMain, this, m_Queues[i].get(), coreId,
+				                              onPacketsArrive, onPacketsArriveUserCookie);
+			}
+			catch (const std::system_error& e)
+			{
+				PCPP_LOG_ERROR("Cannot start the receive thread of queue " << m_Queues[i]->queueId << ": " << e.what());
+				stopReceiveThreads();
+				return false;
+			}
+		}
 
-		checkCompletionRing();
+		return true;
+	}
 
-		uint32_t txId = 0;
-		uint32_t packetCount = getPacketCount();
+	void XdpDevice::stopReceiveThreads()
+	{
+		if (m_ReceiveThreads.empty())
+		{
+			return;
+		}
 
-		auto frameResponse = m_Umem->allocateFrames(packetCount);
-		if (!frameResponse.first)
+		m_StopReceiveThreads = true;
+		for (auto& thread : m_ReceiveThreads)
 		{
-			return false;
+			thread.join();
+		}
+
+		m_ReceiveThreads.clear();
+	}
+
+	void XdpDevice::receiveThreadMain(XdpQueue* queue, int coreId, OnQueuePacketsArrive onPacketsArrive,
+	                                  void* onPacketsArriveUserCookie)
+	{
+		if (coreId >= 0)
+		{
+			cpu_set_t cpuSet;
+			CPU_ZERO(&cpuSet);
+			CPU_SET(coreId, &cpuSet);
+			int err = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet);
+			if (err != 0)
+				PCPP_LOG_ERROR("Cannot bind the receive thread of queue " << queue->queueId << " to core " << coreId
+				                                                          << ": errno=" << err);
 		}
 
-		if (xsk_ring_prod__reserve(&socketInfo->tx, packetCount, &txId) < packetCount)
+		auto socketInfo = static_cast<xsk_socket_info*>(queue->socketInfo);
+
+		pollfd pollFds[1];
+		pollFds[0] = { .fd = xsk_socket__fd(socketInfo->xsk), .events = POLLIN };
+
+		std::vector<RawPacket> receiveBuffer;
+		while (!m_StopReceiveThreads.load(std::memory_order_relaxed))
 		{
-			for (auto frame : frameResponse.second)
+			checkCompletionRing(*queue);
+
+			// the timeout only bounds the time it takes to notice stopReceiveThreads()
+			auto pollResult = poll(pollFds, 1, RECEIVE_THREAD_POLL_TIMEOUT_MS);
+			if (pollResult < 0)
+			{
+				if (errno == EINTR)
+				{
+					continue;
+				}
+
+				PCPP_LOG_ERROR("poll() returned an error on queue " << queue->queueId << ": " << errno);
+				return;
+			}
+
+			uint32_t receivedPacketsCount = peekReceivedPackets(*queue, receiveBuffer);
+			if (receivedPacketsCount == 0)
+			{
+				continue;
+			}
+
+			onPacketsArrive(receiveBuffer.data(), receivedPacketsCount, queue->queueId, this,
+			                onPacketsArriveUserCookie);
+
+			if (!releaseReceivedPackets(*queue, receivedPacketsCount))
 			{
-				m_Umem->freeFrame(frame);
+				return;
 			}
-			PCPP_LOG_ERROR("Cannot reserve " << packetCount << " tx slots");
+		}
+	}
+
+	bool XdpDevice::sendPackets(XdpQueue& queue, const std::function<const RawPacket&(uint32_t)>& getPacketAt,
+	                            uint32_t packetCount, bool waitForTxCompletion, int waitForTxCompletionTimeoutMS)
+	{
+		checkCompletionRing(queue);
+
+		// the TX ring can't take more packets than its size, so don't copy them into UMEM frames first
+		if (packetCount > m_Config->txSize)
+		{
+			PCPP_LOG_ERROR("Cannot send " << packetCount << " packets, more than the TX ring size (" << m_Config->txSize
+			                              << ")");
 			return false;
 		}
 
 		for (uint32_t i = 0; i < packetCount; i++)
 		{
-			if (getPacketAt(i).getRawDataLen() > m_Umem->getFrameSize())
+			if (getPacketAt(i).getRawDataLen() > queue.umem->getFrameSize())
 			{
 				PCPP_LOG_ERROR("Cannot send packets with data length (" << getPacketAt(i).getRawDataLen()
 				                                                        << ") greater than UMEM frame size ("
-				                                                        << m_Umem->getFrameSize() << ")");
+				                                                        << queue.umem->getFrameSize() << ")");
 				return false;
 			}
 		}
 
-		uint64_t sentBytes = 0;
+		uint64_t* frames = queue.frameBatch.get();
+		if (!queue.framePool.allocateFrames(frames, packetCount))
+		{
+			return false;
+		}
+
 		for (uint32_t i = 0; i < packetCount; i++)
 		{
-			uint64_t frame = frameResponse.second[i];
-			m_Umem->setData(frame, getPacketAt(i).getRawData(), getPacketAt(i).getRawDataLen());
+			const RawPacket& packet = getPacketAt(i);
+			queue.umem->setData(frames[i], packet.getRawData(), packet.getRawDataLen());
+		}
+
+		auto getFrameAt = [&](uint32_t i) {
+			return std::make_pair(frames[i], static_cast<uint32_t>(getPacketAt(i).getRawDataLen()));
+		};
+		return transmitFrames(queue, getFrameAt, packetCount, waitForTxCompletion, waitForTxCompletionTimeoutMS);
+	}
+
+	bool XdpDevice::transmitFrames(XdpQueue& queue,
+	                               const std::function<std::pair<uint64_t, uint32_t>(uint32_t)>& getFrameAt,
+	                               uint32_t frameCount, bool waitForTxCompletion, int waitForTxCompletionTimeoutMS)
+	{
+		auto socketInfo = static_cast<xsk_socket_info*>(queue.socketInfo);
+
+		uint32_t txId = 0;
+		if (xsk_ring_prod__reserve(&socketInfo->tx, frameCount, &txId) < frameCount)
+		{
+			for (uint32_t i = 0; i < frameCount; i++)
+			{
+				queue.framePool.freeFrame(getFrameAt(i).first);
+			}
+			PCPP_LOG_ERROR("Cannot reserve " << frameCount << " tx slots");
+			return false;
+		}
+
+		uint64_t sentBytes = 0;
+		for (uint32_t i = 0; i < frameCount; i++)
+		{
+			auto frame = getFrameAt(i);
 
 			struct xdp_desc* txDesc = xsk_ring_prod__tx_desc(&socketInfo->tx, txId + i);
-			txDesc->addr = frame;
-			txDesc->len = getPacketAt(i).getRawDataLen();
+			txDesc->addr = frame.first;
+			txDesc->len = frame.second;
 
 			sentBytes += txDesc->len;
 		}
 
-		xsk_ring_prod__submit(&socketInfo->tx, packetCount);
-		m_Stats.txSentPackets += packetCount;
-		m_Stats.txSentBytes += sentBytes;
-		m_Stats.txRingId = txId + packetCount;
+		xsk_ring_prod__submit(&socketInfo->tx, frameCount);
+		incrementCounter(queue.counters.txSentPackets, frameCount);
+		incrementCounter(queue.counters.txSentBytes, sentBytes);
+		setCounter(queue.counters.txRingId, txId + frameCount);
 
 		if (waitForTxCompletion)
 		{
-			uint32_t completedPackets = checkCompletionRing();
+			uint32_t completedPackets = checkCompletionRing(queue);
 
 			pollfd pollFds[1];
 			pollFds[0] = { .fd = xsk_socket__fd(socketInfo->xsk), .events = POLLOUT };
 
-			while (completedPackets < packetCount)
+			while (completedPackets < frameCount)
 			{
 				auto pollResult = poll(pollFds, 1, waitForTxCompletionTimeoutMS);
 				if (pollResult == 0 && waitForTxCompletionTimeoutMS != 0)
@@ -303,7 +511,7 @@ namespace pcpp
 					return false;
 				}
 
-				completedPackets += checkCompletionRing();
+				completedPackets += checkCompletionRing(queue);
 			}
 		}
 
@@ -313,94 +521,245 @@ namespace pcpp
 	bool XdpDevice::sendPackets(const RawPacketVector& packets, bool waitForTxCompletion,
 	                            int waitForTxCompletionTimeoutMS)
 	{
-		return sendPackets([&](uint32_t i) { return *packets.at(static_cast<int>(i)); },
-		                   [&]() { return packets.size(); }, waitForTxCompletion, waitForTxCompletionTimeoutMS);
+		if (!m_DeviceOpened)
+		{
+			PCPP_LOG_ERROR("Device is not open");
+			return false;
+		}
+
+		return sendPackets(
+		    *m_Queues.front(), [&](uint32_t i) -> const RawPacket& { return *packets.at(static_cast<int>(i)); },
+		    static_cast<uint32_t>(packets.size()), waitForTxCompletion, waitForTxCompletionTimeoutMS);
 	}
 
 	bool XdpDevice::sendPackets(RawPacket packets[], size_t packetCount, bool waitForTxCompletion,
 	                            int waitForTxCompletionTimeoutMS)
 	{
-		return sendPackets([&](uint32_t i) { return packets[i]; }, [&]() { return static_cast<uint32_t>(packetCount); },
-		                   waitForTxCompletion, waitForTxCompletionTimeoutMS);
+		if (!m_DeviceOpened)
+		{
+			PCPP_LOG_ERROR("Device is not open");
+			return false;
+		}
+
+		return sendPackets(
+		    *m_Queues.front(), [&](uint32_t i) -> const RawPacket& { return packets[i]; },
+		    static_cast<uint32_t>(packetCount), waitForTxCompletion, waitForTxCompletionTimeoutMS);
+	}
+
+	bool XdpDevice::sendPackets(uint32_t queueId, RawPacket packets[], size_t packetCount, bool waitForTxCompletion,
+	                            int waitForTxCompletionTimeoutMS)
+	{
+		if (!m_DeviceOpened)
+		{
+			PCPP_LOG_ERROR("Device is not open");
+			return false;
+		}
+
+		XdpQueue* queue = getQueue(queueId);
+		if (queue == nullptr)
+		{
+			PCPP_LOG_ERROR("Queue " << queueId << " isn't used by the device");
+			return false;
+		}
+
+		return sendPackets(
+		    *queue, [&](uint32_t i) -> const RawPacket& { return packets[i]; }, static_cast<uint32_t>(packetCount),
+		    waitForTxCompletion, waitForTxCompletionTimeoutMS);
+	}
+
+	bool XdpDevice::allocateTxFrames(XdpTxFrame frames[], uint32_t count)
+	{
+		if (!m_DeviceOpened)
+		{
+			PCPP_LOG_ERROR("Device is not open");
+			return false;
+		}
+
+		return allocateTxFrames(m_Queues.front()->queueId, frames, count);
+	}
+
+	bool XdpDevice::allocateTxFrames(uint32_t queueId, XdpTxFrame frames[], uint32_t count)
+	{
+		if (!m_DeviceOpened)
+		{
+			PCPP_LOG_ERROR("Device is not open");
+			return false;
+		}
+
+		XdpQueue* queue = getQueue(queueId);
+		if (queue == nullptr)
+		{
+			PCPP_LOG_ERROR("Queue " << queueId << " isn't used by the device");
+			return false;
+		}
+
+		// frames of packets sent earlier are reclaimed first
+		checkCompletionRing(*queue);
+
+		if (queue->framePool.getFreeFrameCount() < count)
+		{
+			PCPP_LOG_ERROR("Not enough frames to allocate. Requested: "
+			               << count << ", available: " << queue->framePool.getFreeFrameCount());
+			return false;
+		}
+
+		uint64_t* addresses = queue->frameBatch.get();
+		for (uint32_t first = 0; first < count; first += queue->maxBatchSize)
+		{
+			uint32_t batchCount = std::min(count - first, queue->maxBatchSize);
+			queue->framePool.allocateFrames(addresses, batchCount);
+			for (uint32_t i = 0; i < batchCount; i++)
+			{
+				XdpTxFrame& frame = frames[first + i];
+				frame.address = addresses[i];
+				frame.data = queue->umem->getDataPtr(addresses[i]);
+				frame.capacity = queue->umem->getFrameSize();
+				frame.length = 0;
+				frame.queueId = queueId;
+			}
+		}
+
+		return true;
 	}
 
-	bool XdpDevice::populateFillRing(uint32_t count, uint32_t rxId)
+	bool XdpDevice::sendTxFrames(const XdpTxFrame frames[], uint32_t count, bool waitForTxCompletion,
+	                             int waitForTxCompletionTimeoutMS)
 	{
-		auto frameResponse = m_Umem->allocateFrames(count);
-		if (!frameResponse.first)
+		if (!m_DeviceOpened)
+		{
+			PCPP_LOG_ERROR("Device is not open");
+			return false;
+		}
+
+		if (count == 0)
+		{
+			return true;
+		}
+
+		XdpQueue* queue = getQueue(frames[0].queueId);
+		if (queue == nullptr)
+		{
+			PCPP_LOG_ERROR("Queue " << frames[0].queueId << " isn't used by the device");
+			return false;
+		}
+
+		if (count > m_Config->txSize)
 		{
+			PCPP_LOG_ERROR("Cannot send " << count << " frames, more than the TX ring size (" << m_Config->txSize
+			                              << ")");
+			freeTxFrames(frames, count);
 			return false;
 		}
 
-		bool result = populateFillRing(frameResponse.second, rxId);
-		if (!result)
+		for (uint32_t i = 0; i < count; i++)
 		{
-			for (auto frame : frameResponse.second)
+			if (frames[i].queueId != queue->queueId || frames[i].length > frames[i].capacity)
 			{
-				m_Umem->freeFrame(frame);
+				PCPP_LOG_ERROR("Frame " << i << " belongs to another queue or its length (" << frames[i].length
+				                        << ") exceeds its capacity (" << frames[i].capacity << ")");
+				freeTxFrames(frames, count);
+				return false;
 			}
 		}
 
-		return result;
+		auto getFrameAt = [&](uint32_t i) {
+			return std::make_pair(frames[i].address, static_cast<uint32_t>(frames[i].length));
+		};
+		return transmitFrames(*queue, getFrameAt, count, waitForTxCompletion, waitForTxCompletionTimeoutMS);
 	}
 
-	bool XdpDevice::populateFillRing(const std::vector<uint64_t>& addresses, uint32_t rxId)
+	void XdpDevice::freeTxFrames(const XdpTxFrame frames[], uint32_t count)
 	{
-		auto umem = static_cast<xsk_umem_info*>(m_Umem->getInfo());
-		auto count = static_cast<uint32_t>(addresses.size());
+		// frames of a closed device were freed with it
+		if (!m_DeviceOpened)
+		{
+			return;
+		}
 
-		uint32_t ret = xsk_ring_prod__reserve(&umem->fq, count, &rxId);
+		for (uint32_t i = 0; i < count; i++)
+		{
+			XdpQueue* queue = getQueue(frames[i].queueId);
+			if (queue != nullptr)
+			{
+				queue->framePool.freeFrame(frames[i].address);
+			}
+		}
+	}
+
+	bool XdpDevice::populateFillRing(XdpQueue& queue, uint32_t count)
+	{
+		uint64_t* frames = queue.frameBatch.get();
+		if (!queue.framePool.allocateFrames(frames, count))
+		{
+			return false;
+		}
+
+		auto socketInfo = static_cast<xsk_socket_info*>(queue.socketInfo);
+
+		uint32_t fqId = 0;
+		uint32_t ret = xsk_ring_prod__reserve(&socketInfo->fq, count, &fqId);
 		if (ret != count)
 		{
 			PCPP_LOG_ERROR("xsk_ring_prod__reserve returned: " << ret << "; expected: " << count);
+			queue.framePool.freeFrames(frames, count);
 			return false;
 		}
 
 		for (uint32_t i = 0; i < count; i++)
 		{
-			*xsk_ring_prod__fill_addr(&umem->fq, rxId + i) = addresses[i];
+			*xsk_ring_prod__fill_addr(&socketInfo->fq, fqId + i) = frames[i];
 		}
 
-		xsk_ring_prod__submit(&umem->fq, count);
-		m_Stats.fqRingId = rxId + count;
+		xsk_ring_prod__submit(&socketInfo->fq, count);
+		setCounter(queue.counters.fqRingId, fqId + count);
 
 		return true;
 	}
 
-	uint32_t XdpDevice::checkCompletionRing()
+	uint32_t XdpDevice::checkCompletionRing(XdpQueue& queue)
 	{
 		uint32_t cqId = 0;
-		auto umemInfo = static_cast<xsk_umem_info*>(m_Umem->getInfo());
-
-		auto socketInfo = static_cast<xsk_socket_info*>(m_SocketInfo);
+		auto socketInfo = static_cast<xsk_socket_info*>(queue.socketInfo);
 		if (xsk_ring_prod__needs_wakeup(&socketInfo->tx))
 		{
 			sendto(xsk_socket__fd(socketInfo->xsk), nullptr, 0, MSG_DONTWAIT, nullptr, 0);
 		}
 
-		uint32_t completedCount = xsk_ring_cons__peek(&umemInfo->cq, m_Config->rxTxBatchSize, &cqId);
+		uint32_t completedCount = xsk_ring_cons__peek(&socketInfo->cq, m_Config->rxTxBatchSize, &cqId);
 
 		if (completedCount)
 		{
 			for (uint32_t i = 0; i < completedCount; i++)
 			{
-				uint64_t addr = *xsk_ring_cons__comp_addr(&umemInfo->cq, cqId + i);
-				m_Umem->freeFrame(addr);
+				queue.framePool.freeFrame(*xsk_ring_cons__comp_addr(&socketInfo->cq, cqId + i));
 			}
 
-			xsk_ring_cons__release(&umemInfo->cq, completedCount);
-			m_Stats.cqRingId = cqId + completedCount;
+			xsk_ring_cons__release(&socketInfo->cq, completedCount);
+			setCounter(queue.counters.cqRingId, cqId + completedCount);
+			incrementCounter(queue.counters.txCompletedPackets, completedCount);
 		}
 
-		m_Stats.txCompletedPackets += completedCount;
 		return completedCount;
 	}
 
-	bool XdpDevice::configureSocket()
+	XdpDevice::XdpQueue* XdpDevice::getQueue(uint32_t queueId) const
+	{
+		for (const auto& queue : m_Queues)
+		{
+			if (queue->queueId == queueId)
+			{
+				return queue.get();
+			}
+		}
+
+		return nullptr;
+	}
+
+	bool XdpDevice::configureSocket(XdpQueue& queue)
 	{
 		auto socketInfo = new xsk_socket_info();
 
-		auto umemInfo = static_cast<xsk_umem_info*>(m_Umem->getInfo());
+		auto umemInfo = static_cast<xsk_umem_info*>(queue.umem->getInfo());
 
 		struct xsk_socket_config xskConfig;
 		xskConfig.rx_size = m_Config->txSize;
@@ -419,26 +778,80 @@ namespace pcpp
 			xskConfig.xdp_flags = XDP_FLAGS_DRV_MODE;
 		}
 
-		int ret = xsk_socket__create(&socketInfo->xsk, m_InterfaceName.c_str(), 0, umemInfo->umem, &socketInfo->rx,
-		                             &socketInfo->tx, &xskConfig);
+		// Every socket has its own fill and completion rings: the first socket of a UMEM takes over the rings
+		// created with it, the next ones (on a shared UMEM) get new rings
+		int ret = xsk_socket__create_shared(&socketInfo->xsk, m_InterfaceName.c_str(), queue.queueId, umemInfo->umem,
+		                                    &socketInfo->rx, &socketInfo->tx, &socketInfo->fq, &socketInfo->cq,
+		                                    &xskConfig);
 		if (ret)
 		{
-			PCPP_LOG_ERROR("xsk_socket__create returned an error: " << ret);
+			PCPP_LOG_ERROR("xsk_socket__create_shared returned an error for queue " << queue.queueId << ": " << ret);
 			delete socketInfo;
 			return false;
 		}
 
-		m_SocketInfo = socketInfo;
+		queue.socketInfo = socketInfo;
 		return true;
 	}
 
-	bool XdpDevice::initUmem()
+	bool XdpDevice::initQueues()
 	{
-		m_Umem = new XdpUmem(m_Config->umemNumFrames, m_Config->umemFrameSize, m_Config->fillRingSize,
-		                     m_Config->completionRingSize);
+		const std::vector<uint32_t>& queueIds = m_Config->queueIds;
+		auto queueCount = static_cast<uint32_t>(queueIds.size());
+		// fill ring refills are at most a batch (which is at most the TX ring size), sends at most the TX ring size
+		uint32_t maxBatchSize = std::max(m_Config->fillRingSize, m_Config->txSize);
+
+		if (m_Config->sharedUmem)
+		{
+			m_Umems.emplace_back(new XdpUmem(m_Config->umemNumFrames, m_Config->umemFrameSize,
+			                                 m_Config->fillRingSize, m_Config->completionRingSize));
+			uint32_t framesPerQueue = m_Config->umemNumFrames / queueCount;
+			for (uint32_t i = 0; i < queueCount; i++)
+			{
+				m_Queues.emplace_back(new XdpQueue(queueIds[i], m_Umems.front().get(), i * framesPerQueue,
+				                                   framesPerQueue, maxBatchSize));
+			}
+		}
+		else
+		{
+			for (uint32_t i = 0; i < queueCount; i++)
+			{
+				m_Umems.emplace_back(new XdpUmem(m_Config->umemNumFrames, m_Config->umemFrameSize,
+				                                 m_Config->fillRingSize, m_Config->completionRingSize));
+				m_Queues.emplace_back(
+				    new XdpQueue(queueIds[i], m_Umems.back().get(), 0, m_Config->umemNumFrames, maxBatchSize));
+			}
+		}
+
+		for (const auto& queue : m_Queues)
+		{
+			if (!(configureSocket(*queue) &&
+			      populateFillRing(*queue, std::min(m_Config->fillRingSize, queue->framePool.getFrameCount() / 2))))
+			{
+				return false;
+			}
+		}
+
 		return true;
 	}
 
+	void XdpDevice::destroyQueues()
+	{
+		// sockets must be deleted before the UMEMs they use
+		for (const auto& queue : m_Queues)
+		{
+			auto socketInfo = static_cast<xsk_socket_info*>(queue->socketInfo);
+			if (socketInfo != nullptr)
+			{
+				xsk_socket__delete(socketInfo->xsk);
+				delete socketInfo;
+			}
+		}
+
+		m_Queues.clear();
+		m_Umems.clear();
+	}
+
 	bool XdpDevice::initConfig()
 	{
 		if (!m_Config)
@@ -454,6 +867,7 @@ namespace pcpp
 		uint32_t rxSize = m_Config->rxSize ? m_Config->rxSize : XSK_RING_CONS__DEFAULT_NUM_DESCS;
 		uint32_t txSize = m_Config->txSize ? m_Config->txSize : XSK_RING_PROD__DEFAULT_NUM_DESCS;
 		uint32_t batchSize = m_Config->rxTxBatchSize ? m_Config->rxTxBatchSize : DEFAULT_BATCH_SIZE;
+		std::vector<uint32_t> queueIds = m_Config->queueIds.empty() ? std::vector<uint32_t>{ 0 } : m_Config->queueIds;
 
 		if (frameSize != getpagesize())
 		{
@@ -468,33 +882,44 @@ namespace pcpp
 			return false;
 		}
 
-		if (fillRingSize > numFrames)
+		std::vector<uint32_t> sortedQueueIds = queueIds;
+		std::sort(sortedQueueIds.begin(), sortedQueueIds.end());
+		if (std::adjacent_find(sortedQueueIds.begin(), sortedQueueIds.end()) != sortedQueueIds.end())
+		{
+			PCPP_LOG_ERROR("Queue IDs must be unique");
+			return false;
+		}
+
+		// with a shared UMEM every queue gets an equal share of the frames
+		uint32_t queueFrames = m_Config->sharedUmem ? numFrames / static_cast<uint32_t>(queueIds.size()) : numFrames;
+
+		if (fillRingSize > queueFrames)
 		{
 			PCPP_LOG_ERROR("Fill ring size (" << fillRingSize
-			                                  << ") must be lower or equal to the total number of UMEM frames ("
-			                                  << numFrames << ")");
+			                                  << ") must be lower or equal to the number of UMEM frames per queue ("
+			                                  << queueFrames << ")");
 			return false;
 		}
 
-		if (completionRingSize > numFrames)
+		if (completionRingSize > queueFrames)
 		{
-			PCPP_LOG_ERROR("Completion ring size (" << completionRingSize
-			                                        << ") must be lower or equal to the total number of UMEM frames ("
-			                                        << numFrames << ")");
+			PCPP_LOG_ERROR("Completion ring size ("
+			               << completionRingSize << ") must be lower or equal to the number of UMEM frames per queue ("
+			               << queueFrames << ")");
 			return false;
 		}
 
-		if (rxSize > numFrames)
+		if (rxSize > queueFrames)
 		{
-			PCPP_LOG_ERROR("RX size (" << rxSize << ") must be lower or equal to the total number of UMEM frames ("
-			                           << numFrames << ")");
+			PCPP_LOG_ERROR("RX size (" << rxSize << ") must be lower or equal to the number of UMEM frames per queue ("
+			                           << queueFrames << ")");
 			return false;
 		}
 
-		if (txSize > numFrames)
+		if (txSize > queueFrames)
 		{
-			PCPP_LOG_ERROR("TX size (" << txSize << ") must be lower or equal to the total number of UMEM frames ("
-			                           << numFrames << ")");
+			PCPP_LOG_ERROR("TX size (" << txSize << ") must be lower or equal to the number of UMEM frames per queue ("
+			                           << queueFrames << ")");
 			return false;
 		}
 
@@ -511,6 +936,7 @@ namespace pcpp
 		m_Config->rxSize = rxSize;
 		m_Config->txSize = txSize;
 		m_Config->rxTxBatchSize = batchSize;
+		m_Config->queueIds = queueIds;
 
 		return true;
 	}
@@ -523,15 +949,9 @@ namespace pcpp
 			return false;
 		}
 
-		if (!(initConfig() && initUmem() &&
-		      populateFillRing(std::min(m_Config->fillRingSize, static_cast<uint32_t>(m_Config->umemNumFrames / 2))) &&
-		      configureSocket()))
+		if (!(initConfig() && initQueues()))
 		{
-			if (m_Umem)
-			{
-				delete m_Umem;
-				m_Umem = nullptr;
-			}
+			destroyQueues();
 			if (m_Config)
 			{
 				delete m_Config;
@@ -557,19 +977,19 @@ namespace pcpp
 	{
 		if (m_DeviceOpened)
 		{
-			auto socketInfo = static_cast<xsk_socket_info*>(m_SocketInfo);
-			xsk_socket__delete(socketInfo->xsk);
+			stopReceiveThreads();
+			// the statistics of a closed device keep the counters it had when it was closed
+			collectStats();
+			destroyQueues();
 			m_DeviceOpened = false;
-			delete m_Umem;
 			delete m_Config;
 			m_Config = nullptr;
-			m_Umem = nullptr;
 		}
 	}
 
-	bool XdpDevice::getSocketStats()
+	bool XdpDevice::getSocketStats(const XdpQueue& queue, XdpDeviceStats& stats)
 	{
-		auto socketInfo = static_cast<xsk_socket_info*>(m_SocketInfo);
+		auto socketInfo = static_cast<xsk_socket_info*>(queue.socketInfo);
 		int fd = xsk_socket__fd(socketInfo->xsk);
 
 		struct xdp_statistics socketStats;
@@ -589,30 +1009,84 @@ namespace pcpp
 			return false;
 		}
 
-		m_Stats.rxDroppedInvalidPackets = socketStats.rx_invalid_descs;
-		m_Stats.rxDroppedRxRingFullPackets = socketStats.rx_ring_full;
-		m_Stats.rxDroppedFillRingPackets = socketStats.rx_fill_ring_empty_descs;
-		m_Stats.rxDroppedTotalPackets = m_Stats.rxDroppedFillRingPackets + m_Stats.rxDroppedRxRingFullPackets +
-		                                m_Stats.rxDroppedInvalidPackets + socketStats.rx_dropped;
-		m_Stats.txDroppedInvalidPackets = socketStats.tx_invalid_descs;
+		stats.rxDroppedInvalidPackets += socketStats.rx_invalid_descs;
+		stats.rxDroppedRxRingFullPackets += socketStats.rx_ring_full;
+		stats.rxDroppedFillRingPackets += socketStats.rx_fill_ring_empty_descs;
+		stats.rxDroppedTotalPackets += socketStats.rx_fill_ring_empty_descs + socketStats.rx_ring_full +
+		                               socketStats.rx_invalid_descs + socketStats.rx_dropped;
+		stats.txDroppedInvalidPackets += socketStats.tx_invalid_descs;
 
 		return true;
 	}
 
-#define nanosec_gap(begin, end) ((end.tv_sec - begin.tv_sec) * 1000000000.0 + (end.tv_nsec - begin.tv_nsec))
+	void XdpDevice::collectQueueStats(const XdpQueue& queue, XdpDeviceStats& stats)
+	{
+		const XdpQueueCounters& counters = queue.counters;
+		stats.rxPackets += getCounter(counters.rxPackets);
+		stats.rxBytes += getCounter(counters.rxBytes);
+		stats.rxPollTimeout += getCounter(counters.rxPollTimeout);
+		stats.txSentPackets += getCounter(counters.txSentPackets);
+		stats.txSentBytes += getCounter(counters.txSentBytes);
+		stats.txCompletedPackets += getCounter(counters.txCompletedPackets);
+		stats.rxRingId = getCounter(counters.rxRingId);
+		stats.txRingId = getCounter(counters.txRingId);
+		stats.fqRingId = getCounter(counters.fqRingId);
+		stats.cqRingId = getCounter(counters.cqRingId);
+
+		size_t freeFrames = queue.framePool.getFreeFrameCount();
+		stats.umemFreeFrames += freeFrames;
+		stats.umemAllocatedFrames += queue.framePool.getFrameCount() - freeFrames;
+
+		getSocketStats(queue, stats);
+	}
 
-	XdpDevice::XdpDeviceStats XdpDevice::getStatistics()
+	void XdpDevice::collectStats()
 	{
-		timespec timestamp;
-		clock_gettime(CLOCK_MONOTONIC, &timestamp);
+		XdpDeviceStats stats;
+		memset(&stats, 0, sizeof(stats));
 
-		m_Stats.timestamp = timestamp;
+		for (const auto& queue : m_Queues)
+		{
+			collectQueueStats(*queue, stats);
+		}
 
+		// ring IDs of different queues can't be added up, so the ones of the first queue are reported
+		const XdpQueueCounters& counters = m_Queues.front()->counters;
+		stats.rxRingId = getCounter(counters.rxRingId);
+		stats.txRingId = getCounter(counters.txRingId);
+		stats.fqRingId = getCounter(counters.fqRingId);
+		stats.cqRingId = getCounter(counters.cqRingId);
+
+		stats.timestamp = m_Stats.timestamp;
+		m_Stats = stats;
+	}
+
+#define nanosec_gap(begin, end) ((end.tv_sec - begin.tv_sec) * 1000000000.0 + (end.tv_nsec - begin.tv_nsec))
+
+	void XdpDevice::updateRates(XdpDeviceStats& stats, XdpPrevDeviceStats& prevStats)
+	{
+		double secsElapsed = (double)nanosec_gap(prevStats.timestamp, stats.timestamp) / 1000000000.0;
+		stats.rxPacketsPerSec = static_cast<uint64_t>((stats.rxPackets - prevStats.rxPackets) / secsElapsed);
+		stats.rxBytesPerSec = static_cast<uint64_t>((stats.rxBytes - prevStats.rxBytes) / secsElapsed);
+		stats.txSentPacketsPerSec =
+		    static_cast<uint64_t>((stats.txSentPackets - prevStats.txSentPackets) / secsElapsed);
+		stats.txSentBytesPerSec = static_cast<uint64_t>((stats.txSentBytes - prevStats.txSentBytes) / secsElapsed);
+		stats.txCompletedPacketsPerSec =
+		    static_cast<uint64_t>((stats.txCompletedPackets - prevStats.txCompletedPackets) / secsElapsed);
+
+		prevStats.timestamp = stats.timestamp;
+		prevStats.rxPackets = stats.rxPackets;
+		prevStats.rxBytes = stats.rxBytes;
+		prevStats.txSentPackets = stats.txSentPackets;
+		prevStats.txSentBytes = stats.txSentBytes;
+		prevStats.txCompletedPackets = stats.txCompletedPackets;
+	}
+
+	XdpDevice::XdpDeviceStats XdpDevice::getStatistics()
+	{
 		if (m_DeviceOpened)
 		{
-			getSocketStats();
-			m_Stats.umemFreeFrames = m_Umem->getFreeFrameCount();
-			m_Stats.umemAllocatedFrames = m_Umem->getFrameCount() - m_Stats.umemFreeFrames;
+			collectStats();
 		}
 		else
 		{
@@ -620,24 +1094,35 @@ namespace pcpp
 			m_Stats.umemAllocatedFrames = 0;
 		}
 
-		double secsElapsed = (double)nanosec_gap(m_PrevStats.timestamp, timestamp) / 1000000000.0;
-		m_Stats.rxPacketsPerSec = static_cast<uint64_t>((m_Stats.rxPackets - m_PrevStats.rxPackets) / secsElapsed);
-		m_Stats.rxBytesPerSec = static_cast<uint64_t>((m_Stats.rxBytes - m_PrevStats.rxBytes) / secsElapsed);
-		m_Stats.txSentPacketsPerSec =
-		    static_cast<uint64_t>((m_Stats.txSentPackets - m_PrevStats.txSentPackets) / secsElapsed);
-		m_Stats.txSentBytesPerSec =
-		    static_cast<uint64_t>((m_Stats.txSentBytes - m_PrevStats.txSentBytes) / secsElapsed);
-		m_Stats.txCompletedPacketsPerSec =
-		    static_cast<uint64_t>((m_Stats.txCompletedPackets - m_PrevStats.txCompletedPackets) / secsElapsed);
-
-		m_PrevStats.timestamp = timestamp;
-		m_PrevStats.rxPackets = m_Stats.rxPackets;
-		m_PrevStats.rxBytes = m_Stats.rxBytes;
-		m_PrevStats.txSentPackets = m_Stats.txSentPackets;
-		m_PrevStats.txSentBytes = m_Stats.txSentBytes;
-		m_PrevStats.txCompletedPackets = m_Stats.txCompletedPackets;
+		clock_gettime(CLOCK_MONOTONIC, &m_Stats.timestamp);
+		updateRates(m_Stats, m_PrevStats);
 
 		return m_Stats;
 	}
 
+	XdpDevice::XdpDeviceStats XdpDevice::getQueueStatistics(uint32_t queueId)
+	{
+		XdpDeviceStats stats;
+		memset(&stats, 0, sizeof(stats));
+
+		if (!m_DeviceOpened)
+		{
+			PCPP_LOG_ERROR("Device is not open");
+			return stats;
+		}
+
+		XdpQueue* queue = getQueue(queueId);
+		if (queue == nullptr)
+		{
+			PCPP_LOG_ERROR("Queue " << queueId << " isn't used by the device");
+			return stats;
+		}
+
+		collectQueueStats(*queue, stats);
+		clock_gettime(CLOCK_MONOTONIC, &stats.timestamp);
+		updateRates(stats, queue->prevStats);
+
+		return stats;
+	}
+
 }  // namespace pcpp
@@ -59,6 +59,10 @@ PTF_TEST_CASE(ResizeLayerTest);
 PTF_TEST_CASE(PrintPacketAndLayersTest);
 PTF_TEST_CASE(ProtocolFamilyMembershipTest);
 PTF_TEST_CASE(PacketParseLayerLimitTest);
+PTF_TEST_CASE(PacketTemplateTest);
+PTF_TEST_CASE(PacketBuilderTest);
+PTF_TEST_CASE(MoveAndRecycleRawPacketTest);
+PTF_TEST_CASE(MovePacketTest);
 
 // Implemented in HttpTests.cpp
 PTF_TEST_CASE(HttpRequestParseMethodTest);
@@ -71,6 +75,7 @@ PTF_TEST_CASE(HttpResponseLayerParsingTest);
 PTF_TEST_CASE(HttpResponseLayerCreationTest);
 PTF_TEST_CASE(HttpResponseLayerEditTest);
 PTF_TEST_CASE(HttpMalformedResponseTest);
+PTF_TEST_CASE(HttpStreamParserTest);
 
 // Implemented in PPPoETests.cpp
 PTF_TEST_CASE(PPPoESessionLayerParsingTest);
@@ -132,6 +137,8 @@ PTF_TEST_CASE(TLS1_3ParsingTest);
 PTF_TEST_CASE(TLSCipherSuiteTest);
 PTF_TEST_CASE(ClientHelloTLSFingerprintTest);
 PTF_TEST_CASE(ServerHelloTLSFingerprintTest);
+PTF_TEST_CASE(TLSFingerprintExtractorTest);
+PTF_TEST_CASE(TLSStreamDecoderTest);
 
 // Implemented in IgmpTests.cpp
 PTF_TEST_CASE(IgmpParsingTest);
@@ -262,6 +269,7 @@ PTF_TEST_CASE(SmtpEditTests);
 // Implemented in Asn1Tests.cpp
 PTF_TEST_CASE(Asn1DecodingTest);
 PTF_TEST_CASE(Asn1EncodingTest);
+PTF_TEST_CASE(Asn1ArenaDecodingTest);
 
 // Implemented in LdapTests.cpp
 PTF_TEST_CASE(LdapParsingTest);
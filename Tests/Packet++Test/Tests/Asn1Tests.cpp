@@ -2,9 +2,11 @@
 #include "Asn1Codec.h"
 #include "RawPacket.h"
 #include "GeneralUtils.h"
+#include "Logger.h"
 #include <functional>
 #include <cstring>
 #include <sstream>
+#include <vector>
 
 PTF_TEST_CASE(Asn1DecodingTest)
 {
@@ -736,3 +738,89 @@ PTF_TEST_CASE(Asn1EncodingTest)
 		PTF_ASSERT_BUF_COMPARE(encodedValue.data(), data, dataLen);
 	}
 }  // Asn1EncodingTest
+
+PTF_TEST_CASE(Asn1ArenaDecodingTest)
+{
+	// an LDAP-like message: a sequence with a message ID and a constructed application record
+	pcpp::Asn1IntegerRecord messageIdRecord(6);
+	pcpp::Asn1OctetStringRecord baseObjectRecord("cn=admin,dc=example,dc=com");
+	pcpp::Asn1EnumeratedRecord scopeRecord(2);
+	pcpp::Asn1BooleanRecord typesOnlyRecord(true);
+	pcpp::Asn1GenericRecord filterRecord(pcpp::Asn1TagClass::ContextSpecific, false, 7, "objectclass");
+	pcpp::Asn1NullRecord nullRecord;
+	pcpp::Asn1OctetStringRecord longRecord(std::string(300, 'a'));
+	pcpp::Asn1SetRecord attributesRecord({ &longRecord, &nullRecord });
+	pcpp::Asn1ConstructedRecord operationRecord(
+	    pcpp::Asn1TagClass::Application, 3,
+	    { &baseObjectRecord, &scopeRecord, &typesOnlyRecord, &filterRecord, &attributesRecord });
+	pcpp::Asn1SequenceRecord rootRecord({ &messageIdRecord, &operationRecord });
+
+	auto encoded = rootRecord.encode();
+	PTF_ASSERT_EQUAL(rootRecord.getEncodedLength(), encoded.size());
+
+	// streaming encode of records built by the user
+	std::vector<uint8_t> buffer(encoded.size());
+	PTF_ASSERT_EQUAL(rootRecord.encode(buffer.data(), buffer.size()), encoded.size());
+	PTF_ASSERT_BUF_COMPARE(buffer.data(), encoded.data(), encoded.size());
+
+	pcpp::Logger::getInstance().suppressLogs();
+	PTF_ASSERT_EQUAL(rootRecord.encode(buffer.data(), buffer.size() - 1), 0);
+	pcpp::Logger::getInstance().enableLogs();
+
+	// a small block size makes the arena use more than one block
+	pcpp::Asn1DecodeArena arena(256);
+	auto expected = pcpp::Asn1Record::decode(encoded.data(), encoded.size(), false);
+	PTF_ASSERT_NOT_NULL(expected);
+
+	for (int iteration = 0; iteration < 3; iteration++)
+	{
+		auto record = pcpp::Asn1Record::decode(encoded.data(), encoded.size(), arena);
+		PTF_ASSERT_NOT_NULL(record);
+		PTF_ASSERT_EQUAL(arena.getRecordCount(), 1);
+		PTF_ASSERT_EQUAL(record->getTotalLength(), encoded.size());
+
+		// a record which wasn't decoded yet is copied as is
+		std::fill(buffer.begin(), buffer.end(), 0);
+		PTF_ASSERT_EQUAL(record->encode(buffer.data(), buffer.size()), encoded.size());
+		PTF_ASSERT_BUF_COMPARE(buffer.data(), encoded.data(), encoded.size());
+
+		// sub-records are decoded into the arena on first access
+		auto& subRecords = record->castAs<pcpp::Asn1SequenceRecord>()->getSubRecords();
+		PTF_ASSERT_EQUAL(subRecords.size(), 2);
+		PTF_ASSERT_EQUAL(arena.getRecordCount(), 3);
+		PTF_ASSERT_EQUAL(subRecords.at(0)->castAs<pcpp::Asn1IntegerRecord>()->getIntValue<uint32_t>(), 6);
+
+		auto operation = subRecords.at(1)->castAs<pcpp::Asn1ConstructedRecord>();
+		PTF_ASSERT_EQUAL(operation->getTagClass(), pcpp::Asn1TagClass::Application, enumclass);
+		PTF_ASSERT_EQUAL(operation->getSubRecords().size(), 5);
+		PTF_ASSERT_EQUAL(operation->getSubRecords().at(0)->castAs<pcpp::Asn1OctetStringRecord>()->getValue(),
+		                 "cn=admin,dc=example,dc=com");
+		PTF_ASSERT_TRUE(operation->getSubRecords().at(2)->castAs<pcpp::Asn1BooleanRecord>()->getValue());
+		auto filter = operation->getSubRecords().at(3)->castAs<pcpp::Asn1GenericRecord>();
+		PTF_ASSERT_EQUAL(std::string(reinterpret_cast<const char*>(filter->getValue()), filter->getValueLength()),
+		                 "objectclass");
+
+		// the fully decoded tree is identical to a regular decode and is encoded from the decoded values
+		PTF_ASSERT_EQUAL(record->toString(), expected->toString());
+		PTF_ASSERT_EQUAL(arena.getRecordCount(), 10);
+		std::fill(buffer.begin(), buffer.end(), 0);
+		PTF_ASSERT_EQUAL(record->encode(buffer.data(), buffer.size()), encoded.size());
+		PTF_ASSERT_BUF_COMPARE(buffer.data(), encoded.data(), encoded.size());
+
+		arena.reset();
+		PTF_ASSERT_EQUAL(arena.getRecordCount(), 0);
+	}
+
+	// the blocks are reused after reset
+	size_t capacity = arena.getCapacity();
+	PTF_ASSERT_GREATER_THAN(capacity, 256);
+	auto record = pcpp::Asn1Record::decode(encoded.data(), encoded.size(), arena);
+	PTF_ASSERT_NOT_NULL(record);
+	record->toString();
+	PTF_ASSERT_EQUAL(arena.getCapacity(), capacity);
+
+	// invalid records
+	PTF_ASSERT_NULL(pcpp::Asn1Record::decode(encoded.data(), 10, arena));
+	PTF_ASSERT_NULL(pcpp::Asn1Record::decode(encoded.data(), 0, arena));
+	PTF_ASSERT_EQUAL(arena.getRecordCount(), 10);
+}  // Asn1ArenaDecodingTest
@@ -9,6 +9,8 @@
 #include "Packet.h"
 #include "OUILookup.h"
 #include "SystemUtils.h"
+#include "Logger.h"
+#include <cstdio>
 
 PTF_TEST_CASE(OUILookup)
 {
@@ -25,6 +27,39 @@ PTF_TEST_CASE(OUILookup)
 	PTF_ASSERT_EQUAL(lookupEngineJson.getVendorName("68:79:12:4f:ff:ff"), "McDonald's Corporation");
 	// Short
 	PTF_ASSERT_EQUAL(lookupEngineJson.getVendorName("00:08:55:01:01:01"), "NASA-Goddard Space Flight Center");
+
+	// compile the JSON database to the binary format and verify both give the same results
+	const std::string binaryDatabasePath = "PacketExamples/PCPP_OUIDataset.bin";
+	int64_t compiledCount =
+	    pcpp::OUILookup::compileOUIDatabase("../../3rdParty/OUIDataset/PCPP_OUIDataset.json", binaryDatabasePath);
+	PTF_ASSERT_GREATER_THAN(compiledCount, 0);
+
+	pcpp::OUILookup lookupEngineBinary;
+	PTF_ASSERT_EQUAL(lookupEngineBinary.initOUIDatabaseFromBinary(binaryDatabasePath), compiledCount);
+	std::remove(binaryDatabasePath.c_str());
+
+	PTF_ASSERT_EQUAL(lookupEngineBinary.getVendorName("aa:aa:aa:aa:aa:aa"), "Unknown");
+	PTF_ASSERT_EQUAL(lookupEngineBinary.getVendorName("70:B3:D5:2A:B0:00"), "NASA Johnson Space Center");
+	PTF_ASSERT_EQUAL(lookupEngineBinary.getVendorName("70:B3:D5:2A:BF:FF"), "NASA Johnson Space Center");
+	PTF_ASSERT_EQUAL(lookupEngineBinary.getVendorName("68:79:12:40:00:00"), "McDonald's Corporation");
+	PTF_ASSERT_EQUAL(lookupEngineBinary.getVendorName("68:79:12:4f:ff:ff"), "McDonald's Corporation");
+	PTF_ASSERT_EQUAL(lookupEngineBinary.getVendorName("00:08:55:01:01:01"), "NASA-Goddard Space Flight Center");
+
+	const char* sampleMacs[] = { "00:00:00:00:00:00", "00:1b:21:12:34:56", "70:b3:d5:00:00:01", "70:b3:d5:ff:ff:ff",
+		                         "68:79:12:50:00:00", "fc:fb:fb:01:02:03", "ff:ff:ff:ff:ff:ff", "8c:1f:64:a0:00:00" };
+	for (const auto& mac : sampleMacs)
+	{
+		PTF_ASSERT_EQUAL(lookupEngineBinary.getVendorName(mac), lookupEngineJson.getVendorName(mac));
+	}
+
+	// a copy shares the mapped database, which stays valid after the original is re-initialized
+	pcpp::OUILookup lookupEngineCopy = lookupEngineBinary;
+	pcpp::Logger::getInstance().suppressLogs();
+	PTF_ASSERT_LOWER_THAN(lookupEngineBinary.initOUIDatabaseFromBinary("PacketExamples/ArpPacket.dat"), 0);
+	PTF_ASSERT_LOWER_THAN(lookupEngineBinary.initOUIDatabaseFromBinary("PacketExamples/NoSuchFile.bin"), 0);
+	pcpp::Logger::getInstance().enableLogs();
+	PTF_ASSERT_EQUAL(lookupEngineBinary.getVendorName("00:08:55:01:01:01"), "Unknown");
+	PTF_ASSERT_EQUAL(lookupEngineCopy.getVendorName("00:08:55:01:01:01"), "NASA-Goddard Space Flight Center");
 }
 
 PTF_TEST_CASE(EthPacketCreation)
@@ -7,9 +7,12 @@
 #include "IPv4Layer.h"
 #include "TcpLayer.h"
 #include "HttpLayer.h"
+#include "HttpStreamParser.h"
 #include "PayloadLayer.h"
 #include "SystemUtils.h"
 #include <iostream>
+#include <algorithm>
+#include <vector>
 PTF_TEST_CASE(HttpRequestParseMethodTest)
 {
 	PTF_ASSERT_EQUAL(pcpp::HttpRequestFirstLine::parseMethod(nullptr, 0),
@@ -549,3 +552,202 @@ PTF_TEST_CASE(HttpMalformedResponseTest)
 		index++;
 	}
 }  // HttpMalformedResponseTest
+
+struct HttpStreamParserTestMessage
+{
+	bool isRequest;
+	int statusCode;
+	std::string method;
+	std::string uri;
+	std::string host;
+	bool chunked;
+	bool complete;
+	uint64_t headerLength;
+	uint64_t bodyLength;
+	uint64_t messageLength;
+	std::string body;
+};
+
+struct HttpStreamParserTestResults
+{
+	std::vector<HttpStreamParserTestMessage> messages[2];
+	size_t reassembledHeaders = 0;
+};
+
+static void httpStreamParserTestOnHeaders(int8_t side, const pcpp::HttpStreamMessageHeaders& headers,
+                                          void* userCookie)
+{
+	auto results = static_cast<HttpStreamParserTestResults*>(userCookie);
+	HttpStreamParserTestMessage message = {};
+	message.isRequest = headers.isRequest;
+	message.statusCode = headers.statusCode;
+	if (headers.isRequest)
+	{
+		message.method = headers.startLine.toString().substr(0, headers.startLine.toString().find(' '));
+		message.uri = headers.uri.toString();
+	}
+	const pcpp::HttpStreamHeaderField* hostField = headers.getField("host");
+	if (hostField != nullptr)
+		message.host = hostField->value.toString();
+	if (headers.reassembled)
+		results->reassembledHeaders++;
+	results->messages[side].push_back(message);
+}
+
+static void httpStreamParserTestOnBodyData(int8_t side, const uint8_t* data, size_t dataLen,
+                                           const pcpp::ConnectionData& connectionData, void* userCookie)
+{
+	(void)connectionData;
+	auto results = static_cast<HttpStreamParserTestResults*>(userCookie);
+	results->messages[side].back().body.append(reinterpret_cast<const char*>(data), dataLen);
+}
+
+static void httpStreamParserTestOnMessageEnd(int8_t side, const pcpp::HttpStreamMessageEnd& messageEnd,
+                                             void* userCookie)
+{
+	auto results = static_cast<HttpStreamParserTestResults*>(userCookie);
+	HttpStreamParserTestMessage& message = results->messages[side].back();
+	message.chunked = messageEnd.chunked;
+	message.complete = messageEnd.complete;
+	message.headerLength = messageEnd.headerLength;
+	message.bodyLength = messageEnd.bodyLength;
+	message.messageLength = messageEnd.messageLength;
+}
+
+static void feedHttpStreamParser(pcpp::HttpStreamParser& parser, const pcpp::ConnectionData& connData, int8_t side,
+                                 const std::string& stream, size_t segmentSize, size_t missingBytes = 0)
+{
+	for (size_t offset = 0; offset < stream.size(); offset += segmentSize)
+	{
+		size_t len = std::min(segmentSize, stream.size() - offset);
+		pcpp::TcpStreamData tcpData(reinterpret_cast<const uint8_t*>(stream.data()) + offset, len,
+		                            offset == 0 ? missingBytes : 0, connData,
+		                            std::chrono::high_resolution_clock::now());
+		parser.processTcpData(side, tcpData);
+	}
+}
+
+PTF_TEST_CASE(HttpStreamParserTest)
+{
+	// pipelined requests: GET, HEAD and POST with a body
+	const std::string clientStream = "GET /index.html HTTP/1.1\r\nHost: www.example.com\r\n\r\n"
+	                                 "HEAD /big HTTP/1.1\r\nHOST:  www.example.com \r\n\r\n"
+	                                 "POST /form HTTP/1.1\r\nContent-Length: 5\r\n\r\nhello";
+
+	// the responses: a regular body, a HEAD response whose Content-Length must be ignored, an interim response and a
+	// chunked body with extensions and trailers
+	const std::string serverStream = "HTTP/1.1 200 OK\r\nContent-Length: 3\r\n\r\nabc"
+	                                 "HTTP/1.1 200 OK\r\nContent-Length: 100\r\n\r\n"
+	                                 "HTTP/1.1 100 Continue\r\n\r\n"
+	                                 "HTTP/1.1 201 Created\r\nTransfer-Encoding: gzip, Chunked\r\n\r\n"
+	                                 "4;name=value\r\nWiki\r\n5\r\npedia\r\n0\r\nX-Trailer: 1\r\n\r\n";
+
+	pcpp::ConnectionData connData;
+	connData.flowKey = 0x1234;
+
+	const size_t segmentSizes[] = { 1, 2, 5, 13, 64, 1000 };
+	for (auto segmentSize : segmentSizes)
+	{
+		HttpStreamParserTestResults results;
+		pcpp::HttpStreamParser parser(httpStreamParserTestOnHeaders, &results, httpStreamParserTestOnMessageEnd,
+		                              httpStreamParserTestOnBodyData);
+		feedHttpStreamParser(parser, connData, 0, clientStream, segmentSize);
+		feedHttpStreamParser(parser, connData, 1, serverStream, segmentSize);
+
+		const std::vector<HttpStreamParserTestMessage>& requests = results.messages[0];
+		PTF_ASSERT_EQUAL(requests.size(), 3);
+		PTF_ASSERT_EQUAL(requests[0].method, "GET");
+		PTF_ASSERT_EQUAL(requests[0].uri, "/index.html");
+		PTF_ASSERT_EQUAL(requests[0].host, "www.example.com");
+		PTF_ASSERT_TRUE(requests[0].complete);
+		PTF_ASSERT_EQUAL(requests[0].bodyLength, 0);
+		PTF_ASSERT_EQUAL(requests[1].method, "HEAD");
+		PTF_ASSERT_EQUAL(requests[1].host, "www.example.com");
+		PTF_ASSERT_EQUAL(requests[2].method, "POST");
+		PTF_ASSERT_EQUAL(requests[2].body, "hello");
+		PTF_ASSERT_EQUAL(requests[2].bodyLength, 5);
+		PTF_ASSERT_EQUAL(requests[2].messageLength, requests[2].headerLength + 5);
+
+		const std::vector<HttpStreamParserTestMessage>& responses = results.messages[1];
+		PTF_ASSERT_EQUAL(responses.size(), 4);
+		PTF_ASSERT_EQUAL(responses[0].statusCode, 200);
+		PTF_ASSERT_EQUAL(responses[0].body, "abc");
+		PTF_ASSERT_EQUAL(responses[1].statusCode, 200);
+		PTF_ASSERT_EQUAL(responses[1].bodyLength, 0);
+		PTF_ASSERT_TRUE(responses[1].complete);
+		PTF_ASSERT_EQUAL(responses[2].statusCode, 100);
+		PTF_ASSERT_EQUAL(responses[3].statusCode, 201);
+		PTF_ASSERT_TRUE(responses[3].chunked);
+		PTF_ASSERT_TRUE(responses[3].complete);
+		PTF_ASSERT_EQUAL(responses[3].body, "Wikipedia");
+		PTF_ASSERT_EQUAL(responses[3].bodyLength, 9);
+
+		uint64_t totalLength = 0;
+		for (const auto& response : responses)
+			totalLength += response.messageLength;
+		PTF_ASSERT_EQUAL(totalLength, serverStream.size());
+
+		PTF_ASSERT_EQUAL(parser.getStatistics().requests, 3);
+		PTF_ASSERT_EQUAL(parser.getStatistics().responses, 4);
+		PTF_ASSERT_EQUAL(parser.getStatistics().parseErrors, 0);
+		if (segmentSize < 64)
+			PTF_ASSERT_GREATER_THAN(results.reassembledHeaders, 0);
+		if (segmentSize == 1000)
+			PTF_ASSERT_EQUAL(results.reassembledHeaders, 0);
+	}
+
+	// a response body delimited by the connection close
+	{
+		HttpStreamParserTestResults results;
+		pcpp::HttpStreamParser parser(httpStreamParserTestOnHeaders, &results, httpStreamParserTestOnMessageEnd);
+		feedHttpStreamParser(parser, connData, 0, "GET / HTTP/1.0\r\n\r\n", 100);
+		feedHttpStreamParser(parser, connData, 1, "HTTP/1.0 200 OK\r\n\r\nsome data", 10);
+		PTF_ASSERT_EQUAL(results.messages[1].size(), 1);
+		PTF_ASSERT_EQUAL(results.messages[1][0].bodyLength, 0);
+		PTF_ASSERT_EQUAL(parser.getConnectionCount(), 1);
+		parser.closeConnection(connData);
+		PTF_ASSERT_EQUAL(parser.getConnectionCount(), 0);
+		PTF_ASSERT_TRUE(results.messages[1][0].complete);
+		PTF_ASSERT_EQUAL(results.messages[1][0].bodyLength, 9);
+	}
+
+	// a body cut by the connection close, and missing bytes inside a body
+	{
+		HttpStreamParserTestResults results;
+		pcpp::HttpStreamParser parser(httpStreamParserTestOnHeaders, &results, httpStreamParserTestOnMessageEnd);
+		feedHttpStreamParser(parser, connData, 1, "HTTP/1.1 200 OK\r\nContent-Length: 10\r\n\r\n01234", 100);
+		feedHttpStreamParser(parser, connData, 1, "9HTTP/1.1 204 No Content\r\n\r\n", 100, 4);
+		feedHttpStreamParser(parser, connData, 1, "HTTP/1.1 200 OK\r\nContent-Length: 10\r\n\r\n0123", 100);
+		parser.closeAllConnections();
+		PTF_ASSERT_EQUAL(results.messages[1].size(), 3);
+		PTF_ASSERT_FALSE(results.messages[1][0].complete);
+		PTF_ASSERT_EQUAL(results.messages[1][0].bodyLength, 10);
+		PTF_ASSERT_EQUAL(results.messages[1][1].statusCode, 204);
+		PTF_ASSERT_TRUE(results.messages[1][1].complete);
+		PTF_ASSERT_FALSE(results.messages[1][2].complete);
+		PTF_ASSERT_EQUAL(results.messages[1][2].bodyLength, 4);
+		PTF_ASSERT_EQUAL(parser.getStatistics().incompleteMessages, 2);
+	}
+
+	// non-HTTP data, invalid chunk sizes and header blocks exceeding the cap stop the parsing of a side
+	{
+		HttpStreamParserTestResults results;
+		pcpp::HttpStreamParser parser(httpStreamParserTestOnHeaders, &results, httpStreamParserTestOnMessageEnd,
+		                              nullptr, 32);
+		feedHttpStreamParser(parser, connData, 0, "\x16\x03\x01\x02\x05hello\r\n\r\n", 100);
+		feedHttpStreamParser(parser, connData, 0, clientStream, 100);
+		PTF_ASSERT_EQUAL(results.messages[0].size(), 0);
+		PTF_ASSERT_EQUAL(parser.getStatistics().parseErrors, 1);
+
+		feedHttpStreamParser(parser, connData, 1, "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\nzz\r\n", 100);
+		PTF_ASSERT_EQUAL(results.messages[1].size(), 1);
+		PTF_ASSERT_FALSE(results.messages[1][0].complete);
+		PTF_ASSERT_EQUAL(parser.getStatistics().parseErrors, 2);
+
+		pcpp::ConnectionData otherConnData;
+		otherConnData.flowKey = 0x5678;
+		feedHttpStreamParser(parser, otherConnData, 0, clientStream, 10);
+		PTF_ASSERT_EQUAL(parser.getStatistics().headerCapExceeded, 1);
+		PTF_ASSERT_EQUAL(parser.getStatistics().requests, 0);
+	}
+}  // HttpStreamParserTest
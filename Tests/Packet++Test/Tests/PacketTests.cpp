@@ -16,6 +16,8 @@
 #include "HttpLayer.h"
 #include "SSLLayer.h"
 #include "RadiusLayer.h"
+#include "PacketBuilder.h"
+#include "PacketTemplate.h"
 #include "PacketTrailerLayer.h"
 #include "PayloadLayer.h"
 #include "GeneralUtils.h"
@@ -1082,3 +1084,388 @@ PTF_TEST_CASE(PacketParseLayerLimitTest)
 	pcpp::Packet packet1(&rawPacket1, pcpp::OsiModelTransportLayer);
 	PTF_ASSERT_EQUAL(packet1.getLastLayer()->getOsiModelLayer(), pcpp::OsiModelTransportLayer);
 }
+
+// checks that the lengths, next protocols and checksums of a packet are the ones computeCalculateFields() would set
+static bool areCalculatedFieldsValid(const uint8_t* data, size_t dataLen)
+{
+	uint8_t* dataCopy = new uint8_t[dataLen];
+	memcpy(dataCopy, data, dataLen);
+	timeval time;
+	gettimeofday(&time, nullptr);
+	pcpp::RawPacket rawPacket(dataCopy, dataLen, time, true);
+	pcpp::Packet packet(&rawPacket);
+	packet.computeCalculateFields();
+	return memcmp(rawPacket.getRawData(), data, dataLen) == 0;
+}
+
+PTF_TEST_CASE(PacketTemplateTest)
+{
+	// IPv4 / TCP template
+	// ~~~~~~~~~~~~~~~~~~~
+
+	pcpp::EthLayer ethLayer(pcpp::MacAddress("aa:aa:aa:aa:aa:aa"), pcpp::MacAddress("bb:bb:bb:bb:bb:bb"));
+	pcpp::IPv4Layer ip4Layer(pcpp::IPv4Address("1.1.1.1"), pcpp::IPv4Address("20.20.20.20"));
+	ip4Layer.getIPv4Header()->timeToLive = 64;
+	pcpp::TcpLayer tcpLayer(12345, 80);
+	tcpLayer.getTcpHeader()->ackFlag = 1;
+	uint8_t payload[] = { 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b };
+	pcpp::PayloadLayer payloadLayer(payload, sizeof(payload));
+
+	pcpp::Packet tcpPacket(100);
+	PTF_ASSERT_TRUE(tcpPacket.addLayer(&ethLayer));
+	PTF_ASSERT_TRUE(tcpPacket.addLayer(&ip4Layer));
+	PTF_ASSERT_TRUE(tcpPacket.addLayer(&tcpLayer));
+	PTF_ASSERT_TRUE(tcpPacket.addLayer(&payloadLayer));
+
+	pcpp::PacketTemplate tcpTemplate(tcpPacket);
+	PTF_ASSERT_EQUAL(tcpTemplate.getDataLen(), 65);
+	PTF_ASSERT_EQUAL(tcpTemplate.getHeaderLen(), 54);
+	PTF_ASSERT_EQUAL(tcpTemplate.getPayloadLen(), 11);
+	PTF_ASSERT_EQUAL(tcpTemplate.getLinkLayerType(), pcpp::LINKTYPE_ETHERNET, enum);
+	PTF_ASSERT_TRUE(areCalculatedFieldsValid(tcpTemplate.getData(), tcpTemplate.getDataLen()));
+
+	int srcIPField = tcpTemplate.addSrcIPField();
+	int ttlField = tcpTemplate.addField(22, 1);
+	int dstPortField = tcpTemplate.addDstPortField();
+	int seqField = tcpTemplate.addTcpSequenceNumberField();
+	int payloadField = tcpTemplate.addPayloadField(3, 3);
+	PTF_ASSERT_EQUAL(srcIPField, 0);
+	PTF_ASSERT_EQUAL(ttlField, 1);
+	PTF_ASSERT_EQUAL(dstPortField, 2);
+	PTF_ASSERT_EQUAL(seqField, 3);
+	PTF_ASSERT_EQUAL(payloadField, 4);
+
+	pcpp::Logger::getInstance().suppressLogs();
+	// the IPv4 checksum, the TCP checksum, partly in the IPv4 header, beyond the end of the packet, too long
+	PTF_ASSERT_EQUAL(tcpTemplate.addField(24, 2), -1);
+	PTF_ASSERT_EQUAL(tcpTemplate.addField(50, 1), -1);
+	PTF_ASSERT_EQUAL(tcpTemplate.addField(33, 2), -1);
+	PTF_ASSERT_EQUAL(tcpTemplate.addField(64, 2), -1);
+	PTF_ASSERT_EQUAL(tcpTemplate.addPayloadField(0, 17), -1);
+	PTF_ASSERT_EQUAL(tcpTemplate.addField(0, 0), -1);
+	pcpp::Logger::getInstance().enableLogs();
+	PTF_ASSERT_EQUAL(tcpTemplate.getFieldCount(), 5);
+
+	uint8_t buffer[1500];
+	PTF_ASSERT_EQUAL(tcpTemplate.stamp(buffer, 64), 0);
+	PTF_ASSERT_EQUAL(tcpTemplate.stamp(buffer, sizeof(buffer)), 65);
+	PTF_ASSERT_BUF_COMPARE(buffer, tcpTemplate.getData(), 65);
+
+	uint8_t payloadFieldValue[] = { 0xaa, 0xbb, 0xcc };
+	PTF_ASSERT_TRUE(tcpTemplate.setField(buffer, 65, srcIPField, pcpp::IPAddress("10.0.0.1")));
+	PTF_ASSERT_TRUE(tcpTemplate.setField(buffer, 65, ttlField, 1));
+	PTF_ASSERT_TRUE(tcpTemplate.setField(buffer, 65, dstPortField, 443));
+	PTF_ASSERT_TRUE(tcpTemplate.setField(buffer, 65, seqField, 0xdeadbeef));
+	PTF_ASSERT_TRUE(tcpTemplate.setField(buffer, 65, payloadField, payloadFieldValue));
+	PTF_ASSERT_FALSE(tcpTemplate.setField(buffer, 65, 5, 1));
+	PTF_ASSERT_FALSE(tcpTemplate.setField(buffer, 65, srcIPField, pcpp::IPAddress("2001:db8::1")));
+	PTF_ASSERT_TRUE(areCalculatedFieldsValid(buffer, 65));
+
+	{
+		uint8_t* dataCopy = new uint8_t[65];
+		memcpy(dataCopy, buffer, 65);
+		timeval time;
+		gettimeofday(&time, nullptr);
+		pcpp::RawPacket rawPacket(dataCopy, 65, time, true);
+		pcpp::Packet stampedPacket(&rawPacket);
+		auto stampedIPLayer = stampedPacket.getLayerOfType<pcpp::IPv4Layer>();
+		auto stampedTcpLayer = stampedPacket.getLayerOfType<pcpp::TcpLayer>();
+		PTF_ASSERT_NOT_NULL(stampedIPLayer);
+		PTF_ASSERT_NOT_NULL(stampedTcpLayer);
+		PTF_ASSERT_EQUAL(stampedIPLayer->getSrcIPv4Address(), pcpp::IPv4Address("10.0.0.1"));
+		PTF_ASSERT_EQUAL(stampedIPLayer->getIPv4Header()->timeToLive, 1);
+		PTF_ASSERT_EQUAL(stampedTcpLayer->getDstPort(), 443);
+		PTF_ASSERT_EQUAL(be32toh(stampedTcpLayer->getTcpHeader()->sequenceNumber), 0xdeadbeef);
+		PTF_ASSERT_BUF_COMPARE(stampedTcpLayer->getLayerPayload() + 3, payloadFieldValue, 3);
+	}
+
+	// resize the payload: odd and even lengths, shorter and longer than the template's
+	for (size_t payloadLength : { 0, 4, 7, 10, 12, 25, 1400 })
+	{
+		size_t packetLen = tcpTemplate.stamp(buffer, sizeof(buffer), payloadLength);
+		PTF_ASSERT_EQUAL(packetLen, 54 + payloadLength);
+		PTF_ASSERT_TRUE(areCalculatedFieldsValid(buffer, packetLen));
+		PTF_ASSERT_TRUE(tcpTemplate.setField(buffer, packetLen, dstPortField, 8080));
+		PTF_ASSERT_EQUAL(tcpTemplate.setField(buffer, packetLen, payloadField, payloadFieldValue), payloadLength >= 6);
+		PTF_ASSERT_TRUE(areCalculatedFieldsValid(buffer, packetLen));
+	}
+
+	PTF_ASSERT_EQUAL(tcpTemplate.stamp(buffer, sizeof(buffer), 1500), 0);
+
+	// IPv6 / UDP template
+	// ~~~~~~~~~~~~~~~~~~~
+
+	pcpp::EthLayer ethLayer2(pcpp::MacAddress("aa:aa:aa:aa:aa:aa"), pcpp::MacAddress("bb:bb:bb:bb:bb:bb"));
+	pcpp::IPv6Layer ip6Layer(pcpp::IPv6Address("2001:db8::1"), pcpp::IPv6Address("2001:db8::2"));
+	pcpp::UdpLayer udpLayer(5000, 53);
+	pcpp::PayloadLayer payloadLayer2(payload, 9);
+
+	pcpp::Packet udpPacket(100);
+	PTF_ASSERT_TRUE(udpPacket.addLayer(&ethLayer2));
+	PTF_ASSERT_TRUE(udpPacket.addLayer(&ip6Layer));
+	PTF_ASSERT_TRUE(udpPacket.addLayer(&udpLayer));
+	PTF_ASSERT_TRUE(udpPacket.addLayer(&payloadLayer2));
+
+	pcpp::PacketTemplate udpTemplate(udpPacket);
+	PTF_ASSERT_EQUAL(udpTemplate.getHeaderLen(), 62);
+	PTF_ASSERT_EQUAL(udpTemplate.getPayloadLen(), 9);
+
+	int dstIPField = udpTemplate.addDstIPField();
+	int srcPortField = udpTemplate.addSrcPortField();
+	PTF_ASSERT_EQUAL(dstIPField, 0);
+	PTF_ASSERT_EQUAL(srcPortField, 1);
+	pcpp::Logger::getInstance().suppressLogs();
+	// the IPv6 payload length, the UDP length, no TCP layer
+	PTF_ASSERT_EQUAL(udpTemplate.addField(18, 2), -1);
+	PTF_ASSERT_EQUAL(udpTemplate.addField(58, 2), -1);
+	PTF_ASSERT_EQUAL(udpTemplate.addTcpSequenceNumberField(), -1);
+	pcpp::Logger::getInstance().enableLogs();
+
+	for (size_t payloadLength : { 0, 1, 9, 100, 1001 })
+	{
+		size_t packetLen = udpTemplate.stamp(buffer, sizeof(buffer), payloadLength);
+		PTF_ASSERT_EQUAL(packetLen, 62 + payloadLength);
+		PTF_ASSERT_TRUE(udpTemplate.setField(buffer, packetLen, dstIPField, pcpp::IPAddress("fe80::1234:5678")));
+		PTF_ASSERT_TRUE(udpTemplate.setField(buffer, packetLen, srcPortField, 5000 + payloadLength));
+		PTF_ASSERT_FALSE(udpTemplate.setField(buffer, packetLen, dstIPField, pcpp::IPAddress("10.0.0.1")));
+		PTF_ASSERT_TRUE(areCalculatedFieldsValid(buffer, packetLen));
+	}
+}  // PacketTemplateTest
+
+PTF_TEST_CASE(PacketBuilderTest)
+{
+	using EthVlanIPv4UdpBuilder = pcpp::PacketBuilder<pcpp::EthLayer, pcpp::VlanLayer, pcpp::IPv4Layer, pcpp::UdpLayer>;
+	PTF_ASSERT_EQUAL(EthVlanIPv4UdpBuilder::HeaderCount, 4);
+	PTF_ASSERT_EQUAL(EthVlanIPv4UdpBuilder::HeaderLength, 46);
+	PTF_ASSERT_EQUAL(EthVlanIPv4UdpBuilder::getHeaderOffset<1>(), 14);
+	PTF_ASSERT_EQUAL(EthVlanIPv4UdpBuilder::getHeaderOffset<3>(), 38);
+
+	uint8_t payload[] = { 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b };
+	uint8_t buffer[1500];
+	memset(buffer, 0xff, sizeof(buffer));
+
+	// Ethernet / VLAN / IPv4 / UDP
+	// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+	EthVlanIPv4UdpBuilder udpBuilder(buffer, sizeof(buffer));
+	PTF_ASSERT_EQUAL(udpBuilder.getPayload(), buffer + 46, ptr);
+	PTF_ASSERT_EQUAL(udpBuilder.getMaxPayloadLength(), 1454);
+	udpBuilder.getHeader<0>().setSourceMac(pcpp::MacAddress("aa:aa:aa:aa:aa:aa"));
+	udpBuilder.getHeader<0>().setDestMac(pcpp::MacAddress("bb:bb:bb:bb:bb:bb"));
+	udpBuilder.getHeader<1>().setVlanID(666);
+	udpBuilder.getHeader<1>().setPriority(5);
+	udpBuilder.getHeader<2>().setSrcIPv4Address(pcpp::IPv4Address("1.1.1.1"));
+	udpBuilder.getHeader<2>().setDstIPv4Address(pcpp::IPv4Address("20.20.20.20"));
+	udpBuilder.getHeader<2>().setIpId(1234);
+	udpBuilder.getHeader<3>().setSrcPort(5000);
+	udpBuilder.getHeader<3>().setDstPort(53);
+	memcpy(udpBuilder.getPayload(), payload, sizeof(payload));
+	PTF_ASSERT_EQUAL(udpBuilder.finalize(1455), 0);
+	PTF_ASSERT_EQUAL(udpBuilder.finalize(sizeof(payload)), 57);
+	PTF_ASSERT_TRUE(areCalculatedFieldsValid(buffer, 57));
+
+	{
+		timeval time;
+		gettimeofday(&time, nullptr);
+		pcpp::RawPacket rawPacket(buffer, 57, time, false);
+		pcpp::Packet packet(&rawPacket);
+		PTF_ASSERT_TRUE(packet.isPacketOfType(pcpp::VLAN));
+		auto vlanLayer = packet.getLayerOfType<pcpp::VlanLayer>();
+		auto ipLayer = packet.getLayerOfType<pcpp::IPv4Layer>();
+		auto udpLayer = packet.getLayerOfType<pcpp::UdpLayer>();
+		PTF_ASSERT_NOT_NULL(vlanLayer);
+		PTF_ASSERT_NOT_NULL(ipLayer);
+		PTF_ASSERT_NOT_NULL(udpLayer);
+		PTF_ASSERT_EQUAL(packet.getLayerOfType<pcpp::EthLayer>()->getSourceMac(),
+		                 pcpp::MacAddress("aa:aa:aa:aa:aa:aa"));
+		PTF_ASSERT_EQUAL(vlanLayer->getVlanID(), 666);
+		PTF_ASSERT_EQUAL(vlanLayer->getPriority(), 5);
+		PTF_ASSERT_EQUAL(ipLayer->getDstIPv4Address(), pcpp::IPv4Address("20.20.20.20"));
+		PTF_ASSERT_EQUAL(ipLayer->getIPv4Header()->timeToLive, 64);
+		PTF_ASSERT_EQUAL(be16toh(ipLayer->getIPv4Header()->ipId), 1234);
+		PTF_ASSERT_EQUAL(udpLayer->getSrcPort(), 5000);
+		PTF_ASSERT_EQUAL(udpLayer->getLayerPayloadSize(), sizeof(payload));
+		PTF_ASSERT_BUF_COMPARE(udpLayer->getLayerPayload(), payload, sizeof(payload));
+	}
+
+	// Ethernet / IPv6 / TCP
+	// ~~~~~~~~~~~~~~~~~~~~~
+
+	pcpp::PacketBuilder<pcpp::EthLayer, pcpp::IPv6Layer, pcpp::TcpLayer> tcpBuilder(buffer, sizeof(buffer));
+	tcpBuilder.getHeader<1>().setSrcIPv6Address(pcpp::IPv6Address("2001:db8::1"));
+	tcpBuilder.getHeader<1>().setDstIPv6Address(pcpp::IPv6Address("2001:db8::2"));
+	tcpBuilder.getHeader<2>().setSrcPort(12345);
+	tcpBuilder.getHeader<2>().setDstPort(80);
+	tcpBuilder.getHeader<2>().setSequenceNumber(0xdeadbeef);
+	tcpBuilder.getHeader<2>().setFlags(0x12);
+	tcpBuilder.getHeader<2>().setWindowSize(1024);
+	memcpy(tcpBuilder.getPayload(), payload, sizeof(payload));
+	PTF_ASSERT_EQUAL(tcpBuilder.finalize(sizeof(payload)), 85);
+	PTF_ASSERT_TRUE(areCalculatedFieldsValid(buffer, 85));
+
+	{
+		timeval time;
+		gettimeofday(&time, nullptr);
+		pcpp::RawPacket rawPacket(buffer, 85, time, false);
+		pcpp::Packet packet(&rawPacket);
+		auto tcpLayer = packet.getLayerOfType<pcpp::TcpLayer>();
+		PTF_ASSERT_NOT_NULL(tcpLayer);
+		PTF_ASSERT_NOT_NULL(packet.getLayerOfType<pcpp::IPv6Layer>());
+		PTF_ASSERT_EQUAL(tcpLayer->getDstPort(), 80);
+		PTF_ASSERT_EQUAL(be32toh(tcpLayer->getTcpHeader()->sequenceNumber), 0xdeadbeef);
+		PTF_ASSERT_EQUAL(tcpLayer->getTcpHeader()->synFlag, 1);
+		PTF_ASSERT_EQUAL(tcpLayer->getTcpHeader()->ackFlag, 1);
+		PTF_ASSERT_EQUAL(tcpLayer->getLayerPayloadSize(), sizeof(payload));
+	}
+
+	// Ethernet / IPv4 / IPv4 / UDP in a raw packet
+	// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+	timeval time;
+	gettimeofday(&time, nullptr);
+	pcpp::RawPacket rawPacket(new uint8_t[200], 200, time, true);
+	pcpp::PacketBuilder<pcpp::EthLayer, pcpp::IPv4Layer, pcpp::IPv4Layer, pcpp::UdpLayer> tunnelBuilder(rawPacket);
+	tunnelBuilder.getHeader<1>().setSrcIPv4Address(pcpp::IPv4Address("10.0.0.1"));
+	tunnelBuilder.getHeader<1>().setDstIPv4Address(pcpp::IPv4Address("10.0.0.2"));
+	tunnelBuilder.getHeader<2>().setSrcIPv4Address(pcpp::IPv4Address("192.168.0.1"));
+	tunnelBuilder.getHeader<2>().setDstIPv4Address(pcpp::IPv4Address("192.168.0.2"));
+	tunnelBuilder.getHeader<3>().setDstPort(4000);
+	memset(tunnelBuilder.getPayload(), 0x42, 7);
+	PTF_ASSERT_EQUAL(tunnelBuilder.finalize(7), 69);
+	PTF_ASSERT_EQUAL(rawPacket.getRawDataLen(), 69);
+	PTF_ASSERT_TRUE(areCalculatedFieldsValid(rawPacket.getRawData(), 69));
+
+	pcpp::Packet tunnelPacket(&rawPacket);
+	auto outerIPLayer = tunnelPacket.getLayerOfType<pcpp::IPv4Layer>();
+	auto innerIPLayer = tunnelPacket.getNextLayerOfType<pcpp::IPv4Layer>(outerIPLayer);
+	PTF_ASSERT_NOT_NULL(innerIPLayer);
+	PTF_ASSERT_EQUAL(innerIPLayer->getSrcIPv4Address(), pcpp::IPv4Address("192.168.0.1"));
+	PTF_ASSERT_NOT_NULL(tunnelPacket.getLayerOfType<pcpp::UdpLayer>());
+
+	uint8_t shortBuffer[40];
+	using EthIPv4UdpBuilder = pcpp::PacketBuilder<pcpp::EthLayer, pcpp::IPv4Layer, pcpp::UdpLayer>;
+	pcpp::Logger::getInstance().suppressLogs();
+	EthIPv4UdpBuilder shortBufferBuilder(shortBuffer, sizeof(shortBuffer));
+	EthIPv4UdpBuilder nullBufferBuilder(nullptr, 1518);
+	pcpp::Logger::getInstance().enableLogs();
+	PTF_ASSERT_FALSE(shortBufferBuilder.isValid());
+	PTF_ASSERT_FALSE(nullBufferBuilder.isValid());
+	PTF_ASSERT_EQUAL(shortBufferBuilder.getMaxPayloadLength(), 0);
+	PTF_ASSERT_EQUAL(shortBufferBuilder.finalize(0), 0);
+}  // PacketBuilderTest
+
+PTF_TEST_CASE(MoveAndRecycleRawPacketTest)
+{
+	timeval time;
+	gettimeofday(&time, nullptr);
+
+	READ_FILE_AND_CREATE_PACKET(1, "PacketExamples/TcpPacketWithOptions3.dat");
+	READ_FILE_AND_CREATE_PACKET(2, "PacketExamples/TwoHttpRequests1.dat");
+	const uint8_t* rawData1 = rawPacket1.getRawData();
+	int rawDataLen1 = rawPacket1.getRawDataLen();
+	PTF_ASSERT_EQUAL(rawPacket1.getRawDataCapacity(), rawDataLen1);
+
+	// move a raw packet
+	pcpp::RawPacket movedRawPacket(std::move(rawPacket1));
+	PTF_ASSERT_EQUAL(movedRawPacket.getRawData(), rawData1, ptr);
+	PTF_ASSERT_EQUAL(movedRawPacket.getRawDataLen(), rawDataLen1);
+	PTF_ASSERT_TRUE(movedRawPacket.isPacketSet());
+	PTF_ASSERT_NULL(rawPacket1.getRawData());
+	PTF_ASSERT_EQUAL(rawPacket1.getRawDataLen(), 0);
+	PTF_ASSERT_FALSE(rawPacket1.isPacketSet());
+
+	pcpp::RawPacket assignedRawPacket(rawPacket2);
+	assignedRawPacket = std::move(movedRawPacket);
+	PTF_ASSERT_EQUAL(assignedRawPacket.getRawData(), rawData1, ptr);
+	PTF_ASSERT_EQUAL(assignedRawPacket.getRawDataLen(), rawDataLen1);
+	PTF_ASSERT_NULL(movedRawPacket.getRawData());
+
+	// a copy into a raw packet with a large enough buffer reuses the buffer
+	pcpp::RawPacket recycledRawPacket;
+	PTF_ASSERT_TRUE(recycledRawPacket.reset(1500));
+	const uint8_t* recycledBuffer = recycledRawPacket.getRawData();
+	PTF_ASSERT_EQUAL(recycledRawPacket.getRawDataLen(), 1500);
+	recycledRawPacket = rawPacket2;
+	PTF_ASSERT_EQUAL(recycledRawPacket.getRawData(), recycledBuffer, ptr);
+	PTF_ASSERT_EQUAL(recycledRawPacket.getRawDataLen(), rawPacket2.getRawDataLen());
+	PTF_ASSERT_EQUAL(recycledRawPacket.getRawDataCapacity(), 1500);
+	PTF_ASSERT_BUF_COMPARE(recycledRawPacket.getRawData(), rawPacket2.getRawData(), rawPacket2.getRawDataLen());
+
+	// reset keeps the buffer if it's large enough
+	PTF_ASSERT_TRUE(recycledRawPacket.reset(100));
+	PTF_ASSERT_EQUAL(recycledRawPacket.getRawData(), recycledBuffer, ptr);
+	PTF_ASSERT_EQUAL(recycledRawPacket.getRawDataLen(), 100);
+	PTF_ASSERT_TRUE(recycledRawPacket.reset(2000));
+	PTF_ASSERT_EQUAL(recycledRawPacket.getRawDataLen(), 2000);
+	PTF_ASSERT_EQUAL(recycledRawPacket.getRawDataCapacity(), 2000);
+
+	// a buffer the raw packet doesn't own is never reused
+	uint8_t externalBuffer[200];
+	pcpp::RawPacket externalRawPacket(externalBuffer, sizeof(externalBuffer), time, false);
+	PTF_ASSERT_TRUE(externalRawPacket.reset(100));
+	PTF_ASSERT_NOT_EQUAL(externalRawPacket.getRawData(), externalBuffer, ptr);
+
+	// initWithRawData() frees the buffer the raw packet owns before pointing it to data it doesn't own
+	timespec externalTime = { time.tv_sec, time.tv_usec * 1000 };
+	PTF_ASSERT_TRUE(externalRawPacket.isRawDataOwned());
+	PTF_ASSERT_TRUE(externalRawPacket.initWithRawData(externalBuffer, sizeof(externalBuffer), externalTime));
+	PTF_ASSERT_FALSE(externalRawPacket.isRawDataOwned());
+	PTF_ASSERT_EQUAL(externalRawPacket.getRawData(), externalBuffer, ptr);
+
+	// recycle a raw packet for a PacketBuilder
+	PTF_ASSERT_TRUE(recycledRawPacket.reset(1500));
+	pcpp::PacketBuilder<pcpp::EthLayer, pcpp::IPv4Layer, pcpp::UdpLayer> builder(recycledRawPacket);
+	PTF_ASSERT_EQUAL(builder.finalize(10), 52);
+	PTF_ASSERT_EQUAL(recycledRawPacket.getRawDataLen(), 52);
+	PTF_ASSERT_EQUAL(recycledRawPacket.getRawDataCapacity(), 2000);
+
+	// the capacity is the buffer length of a packet created with a maximum length, and grows with appended data
+	pcpp::Packet newPacket(100);
+	PTF_ASSERT_EQUAL(newPacket.getRawPacket()->getRawDataLen(), 0);
+	PTF_ASSERT_EQUAL(newPacket.getRawPacket()->getRawDataCapacity(), 100);
+	pcpp::RawPacket appendedRawPacket(externalBuffer, 100, time, false);
+	appendedRawPacket.appendData(externalBuffer, 50);
+	PTF_ASSERT_EQUAL(appendedRawPacket.getRawDataCapacity(), 150);
+}  // MoveAndRecycleRawPacketTest
+
+PTF_TEST_CASE(MovePacketTest)
+{
+	timeval time;
+	gettimeofday(&time, nullptr);
+
+	READ_FILE_AND_CREATE_PACKET(1, "PacketExamples/TcpPacketWithOptions3.dat");
+	READ_FILE_AND_CREATE_PACKET(2, "PacketExamples/TwoHttpRequests1.dat");
+
+	pcpp::Packet packet(new pcpp::RawPacket(rawPacket1), true);
+	pcpp::RawPacket* rawPacket = packet.getRawPacket();
+	pcpp::Layer* firstLayer = packet.getFirstLayer();
+	pcpp::Layer* lastLayer = packet.getLastLayer();
+
+	// the layers are taken as they are, without parsing the packet again
+	pcpp::Packet movedPacket(std::move(packet));
+	PTF_ASSERT_EQUAL(movedPacket.getRawPacket(), rawPacket, ptr);
+	PTF_ASSERT_EQUAL(movedPacket.getFirstLayer(), firstLayer, ptr);
+	PTF_ASSERT_EQUAL(movedPacket.getLastLayer(), lastLayer, ptr);
+	PTF_ASSERT_NULL(packet.getRawPacket());
+	PTF_ASSERT_NULL(packet.getFirstLayer());
+
+	// the layers of the moved packet extend the moved packet's data
+	pcpp::TcpLayer* tcpLayer = movedPacket.getLayerOfType<pcpp::TcpLayer>();
+	PTF_ASSERT_NOT_NULL(tcpLayer);
+	size_t tcpHeaderLen = tcpLayer->getHeaderLen();
+	int rawDataLen = rawPacket->getRawDataLen();
+	PTF_ASSERT_TRUE(
+	    tcpLayer->addTcpOption(pcpp::TcpOptionBuilder(pcpp::TcpOptionBuilder::NopEolOptionEnumType::Nop)).isNotNull());
+	PTF_ASSERT_EQUAL(tcpLayer->getHeaderLen(), tcpHeaderLen + 4);
+	PTF_ASSERT_EQUAL(movedPacket.getRawPacket()->getRawDataLen(), rawDataLen + 4);
+
+	pcpp::Packet assignedPacket(&rawPacket2);
+	assignedPacket = std::move(movedPacket);
+	PTF_ASSERT_EQUAL(assignedPacket.getRawPacket(), rawPacket, ptr);
+	PTF_ASSERT_EQUAL(assignedPacket.getFirstLayer(), firstLayer, ptr);
+	PTF_ASSERT_NULL(movedPacket.getRawPacket());
+	PTF_ASSERT_TRUE(assignedPacket.isPacketOfType(pcpp::TCP));
+	assignedPacket.computeCalculateFields();
+	PTF_ASSERT_EQUAL(assignedPacket.getLayerOfType<pcpp::IPv4Layer>()->getIPv4Header()->totalLength,
+	                 htobe16(rawDataLen + 4 - 14));
+}  // MovePacketTest
@@ -4,6 +4,11 @@
 #include "Packet.h"
 #include "SSLLayer.h"
 #include "SystemUtils.h"
+#include "TLSFingerprintExtractor.h"
+#include "TLSStreamDecoder.h"
+#include "TcpLayer.h"
+#include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <sstream>
 
@@ -753,3 +758,276 @@ PTF_TEST_CASE(ServerHelloTLSFingerprintTest)
 	PTF_ASSERT_EQUAL(tlsFingerprint.toString(), "771,49195,23-65281-11-35-16");
 	PTF_ASSERT_EQUAL(tlsFingerprint.toMD5(), "eca9b8f0f3eae50309eaf901cb822d9b");
 }  // ServerHelloTLSFingerprintTest
+
+PTF_TEST_CASE(TLSFingerprintExtractorTest)
+{
+	timeval time;
+	gettimeofday(&time, nullptr);
+
+	READ_FILE_AND_CREATE_PACKET(1, "PacketExamples/tls1_3_client_hello1.dat");
+	READ_FILE_AND_CREATE_PACKET(2, "PacketExamples/tls_grease.dat");
+	READ_FILE_AND_CREATE_PACKET(3, "PacketExamples/SSL-MultipleRecords1.dat");
+	READ_FILE_AND_CREATE_PACKET(4, "PacketExamples/tls_server_hello.dat");
+	READ_FILE_AND_CREATE_PACKET(5, "PacketExamples/SSL-ClientHello1.dat");
+	READ_FILE_AND_CREATE_PACKET(6, "PacketExamples/SSL-MultipleAppData.dat");
+
+	pcpp::Packet packets[] = {
+		pcpp::Packet(&rawPacket1), pcpp::Packet(&rawPacket2), pcpp::Packet(&rawPacket3),
+		pcpp::Packet(&rawPacket4), pcpp::Packet(&rawPacket5), pcpp::Packet(&rawPacket6)
+	};
+	const size_t numOfPackets = sizeof(packets) / sizeof(packets[0]);
+
+	const uint8_t* payloads[numOfPackets];
+	size_t payloadLengths[numOfPackets];
+	for (size_t i = 0; i < numOfPackets; i++)
+	{
+		pcpp::TcpLayer* tcpLayer = packets[i].getLayerOfType<pcpp::TcpLayer>();
+		PTF_ASSERT_NOT_NULL(tcpLayer);
+		payloads[i] = tcpLayer->getLayerPayload();
+		payloadLengths[i] = tcpLayer->getLayerPayloadSize();
+	}
+
+	// the JA3 digests must be identical to the ones generated from the parsed handshake layer
+	pcpp::TLSFingerprint fingerprint;
+	PTF_ASSERT_TRUE(pcpp::TLSFingerprintExtractor::extract(payloads[0], payloadLengths[0], fingerprint));
+	PTF_ASSERT_EQUAL(fingerprint.type, pcpp::TLSFingerprint::ClientHello, enum);
+	PTF_ASSERT_EQUAL(std::string(fingerprint.ja3), "a66e498c488aa0523759691248cdfb01");
+	PTF_ASSERT_EQUAL(std::string(fingerprint.ja4), "t00d041000_16476d049b0b_78f1d400d464");
+
+	PTF_ASSERT_TRUE(pcpp::TLSFingerprintExtractor::extract(payloads[1], payloadLengths[1], fingerprint));
+	PTF_ASSERT_EQUAL(fingerprint.type, pcpp::TLSFingerprint::ClientHello, enum);
+	PTF_ASSERT_EQUAL(std::string(fingerprint.ja3), "b32309a26951912be7dba376398abc3b");
+	PTF_ASSERT_EQUAL(std::string(fingerprint.ja4), "t13d1515h2_8daaf6152771_de4a06bb82e3");
+
+	PTF_ASSERT_TRUE(pcpp::TLSFingerprintExtractor::extract(payloads[2], payloadLengths[2], fingerprint));
+	PTF_ASSERT_EQUAL(fingerprint.type, pcpp::TLSFingerprint::ServerHello, enum);
+	PTF_ASSERT_EQUAL(std::string(fingerprint.ja3), "554786d4c84f8a7953b7e453c6371067");
+	PTF_ASSERT_EQUAL(std::string(fingerprint.ja4), "");
+
+	PTF_ASSERT_TRUE(pcpp::TLSFingerprintExtractor::extract(payloads[3], payloadLengths[3], fingerprint));
+	PTF_ASSERT_EQUAL(fingerprint.type, pcpp::TLSFingerprint::ServerHello, enum);
+	PTF_ASSERT_EQUAL(std::string(fingerprint.ja3), "eca9b8f0f3eae50309eaf901cb822d9b");
+
+	// JA4 calculation can be skipped
+	PTF_ASSERT_TRUE(pcpp::TLSFingerprintExtractor::extract(payloads[4], payloadLengths[4], fingerprint, false));
+	PTF_ASSERT_EQUAL(std::string(fingerprint.ja4), "");
+
+	// no hello message in application data
+	PTF_ASSERT_FALSE(pcpp::TLSFingerprintExtractor::extract(payloads[5], payloadLengths[5], fingerprint));
+	PTF_ASSERT_EQUAL(fingerprint.type, pcpp::TLSFingerprint::NoHelloMessage, enum);
+
+	// compare the batch API with the handshake layer for all packets
+	pcpp::TLSFingerprint results[numOfPackets];
+	PTF_ASSERT_EQUAL(pcpp::TLSFingerprintExtractor::extractBatch(payloads, payloadLengths, numOfPackets, results), 5);
+	for (size_t i = 0; i < numOfPackets; i++)
+	{
+		pcpp::SSLHandshakeLayer* handshakeLayer = packets[i].getLayerOfType<pcpp::SSLHandshakeLayer>();
+		pcpp::SSLClientHelloMessage* clientHello =
+		    handshakeLayer ? handshakeLayer->getHandshakeMessageOfType<pcpp::SSLClientHelloMessage>() : nullptr;
+		pcpp::SSLServerHelloMessage* serverHello =
+		    handshakeLayer ? handshakeLayer->getHandshakeMessageOfType<pcpp::SSLServerHelloMessage>() : nullptr;
+		if (clientHello != nullptr)
+		{
+			PTF_ASSERT_EQUAL(results[i].type, pcpp::TLSFingerprint::ClientHello, enum);
+			PTF_ASSERT_EQUAL(std::string(results[i].ja3), clientHello->generateTLSFingerprint().toMD5());
+		}
+		else if (serverHello != nullptr)
+		{
+			PTF_ASSERT_EQUAL(results[i].type, pcpp::TLSFingerprint::ServerHello, enum);
+			PTF_ASSERT_EQUAL(std::string(results[i].ja3), serverHello->generateTLSFingerprint().toMD5());
+		}
+		else
+		{
+			PTF_ASSERT_EQUAL(results[i].type, pcpp::TLSFingerprint::NoHelloMessage, enum);
+		}
+	}
+
+	// truncated and malformed payloads must not be read out of bounds
+	for (size_t len = 0; len < payloadLengths[1]; len++)
+	{
+		pcpp::TLSFingerprintExtractor::extract(payloads[1], len, fingerprint);
+	}
+
+	uint8_t garbage[] = { 0x16, 0x03, 0x01, 0xff, 0xff, 0x01, 0xff, 0xff, 0xff, 0x03, 0x03 };
+	PTF_ASSERT_TRUE(pcpp::TLSFingerprintExtractor::extract(garbage, sizeof(garbage), fingerprint));
+	PTF_ASSERT_EQUAL(fingerprint.type, pcpp::TLSFingerprint::ClientHello, enum);
+	PTF_ASSERT_FALSE(pcpp::TLSFingerprintExtractor::extract(nullptr, 0, fingerprint));
+}  // TLSFingerprintExtractorTest
+
+struct TLSStreamDecoderTestResults
+{
+	std::vector<pcpp::SSLHandshakeType> types;
+	std::vector<std::vector<uint8_t>> messages;
+	std::vector<std::string> ja3;
+	size_t reassembled = 0;
+	pcpp::TLSStreamDecoder* decoderToClose = nullptr;
+};
+
+static void tlsStreamDecoderTestCallback(int8_t side, const pcpp::TLSHandshakeMessageData& message, void* userCookie)
+{
+	(void)side;
+	auto results = static_cast<TLSStreamDecoderTestResults*>(userCookie);
+	results->types.push_back(message.handshakeType);
+	results->messages.push_back(std::vector<uint8_t>(message.data, message.data + message.dataLen));
+	if (message.reassembled)
+		results->reassembled++;
+
+	if (results->decoderToClose != nullptr)
+		results->decoderToClose->closeConnection(*message.connectionData);
+
+	pcpp::TLSFingerprint fingerprint;
+	if (pcpp::TLSFingerprintExtractor::extractFromHandshakeMessage(message.data, message.dataLen, fingerprint))
+		results->ja3.push_back(fingerprint.ja3);
+}
+
+static void feedTLSStreamDecoder(pcpp::TLSStreamDecoder& decoder, const pcpp::ConnectionData& connData,
+                                 const uint8_t* data, size_t dataLen, size_t segmentSize)
+{
+	for (size_t offset = 0; offset < dataLen; offset += segmentSize)
+	{
+		size_t len = std::min(segmentSize, dataLen - offset);
+		pcpp::TcpStreamData tcpData(data + offset, len, 0, connData, std::chrono::high_resolution_clock::now());
+		decoder.processTcpData(0, tcpData);
+	}
+}
+
+PTF_TEST_CASE(TLSStreamDecoderTest)
+{
+	timeval time;
+	gettimeofday(&time, nullptr);
+
+	READ_FILE_AND_CREATE_PACKET(1, "PacketExamples/SSL-MultipleRecords3.dat");
+	READ_FILE_AND_CREATE_PACKET(2, "PacketExamples/tls_grease.dat");
+	pcpp::Packet serverPacket(&rawPacket1);
+	pcpp::Packet clientPacket(&rawPacket2);
+
+	pcpp::TcpLayer* serverTcpLayer = serverPacket.getLayerOfType<pcpp::TcpLayer>();
+	pcpp::TcpLayer* clientTcpLayer = clientPacket.getLayerOfType<pcpp::TcpLayer>();
+	PTF_ASSERT_NOT_NULL(serverTcpLayer);
+	PTF_ASSERT_NOT_NULL(clientTcpLayer);
+
+	// the server side stream: ServerHello, Certificate, ServerKeyExchange, CertificateRequest, ServerHelloDone
+	std::vector<uint8_t> serverStream(serverTcpLayer->getLayerPayload(),
+	                                  serverTcpLayer->getLayerPayload() + serverTcpLayer->getLayerPayloadSize());
+
+	pcpp::ConnectionData connData;
+	connData.flowKey = 0x1234;
+
+	// the whole stream in one segment is decoded in place
+	TLSStreamDecoderTestResults wholeResults;
+	pcpp::TLSStreamDecoder wholeDecoder(tlsStreamDecoderTestCallback, &wholeResults);
+	feedTLSStreamDecoder(wholeDecoder, connData, serverStream.data(), serverStream.size(), serverStream.size());
+	PTF_ASSERT_EQUAL(wholeResults.types.size(), 5);
+	PTF_ASSERT_EQUAL(wholeResults.types[0], pcpp::SSL_SERVER_HELLO, enum);
+	PTF_ASSERT_EQUAL(wholeResults.types[1], pcpp::SSL_CERTIFICATE, enum);
+	PTF_ASSERT_EQUAL(wholeResults.types[4], pcpp::SSL_SERVER_DONE, enum);
+	PTF_ASSERT_EQUAL(wholeResults.messages[1].size(), 4966);
+	PTF_ASSERT_EQUAL(wholeResults.reassembled, 0);
+
+	pcpp::SSLHandshakeLayer* handshakeLayer = serverPacket.getLayerOfType<pcpp::SSLHandshakeLayer>();
+	PTF_ASSERT_NOT_NULL(handshakeLayer);
+	pcpp::SSLServerHelloMessage* serverHelloMessage =
+	    handshakeLayer->getHandshakeMessageOfType<pcpp::SSLServerHelloMessage>();
+	PTF_ASSERT_NOT_NULL(serverHelloMessage);
+	PTF_ASSERT_EQUAL(wholeResults.ja3.size(), 1);
+	PTF_ASSERT_EQUAL(wholeResults.ja3[0], serverHelloMessage->generateTLSFingerprint().toMD5());
+	PTF_ASSERT_EQUAL(wholeDecoder.getStatistics().bufferedRecords, 0);
+	PTF_ASSERT_EQUAL(wholeDecoder.getBufferedBytes(connData.flowKey), 0);
+
+	// the same stream split into small segments must produce exactly the same messages
+	const size_t segmentSizes[] = { 1, 3, 7, 64, 100 };
+	for (auto segmentSize : segmentSizes)
+	{
+		TLSStreamDecoderTestResults splitResults;
+		pcpp::TLSStreamDecoder splitDecoder(tlsStreamDecoderTestCallback, &splitResults);
+		feedTLSStreamDecoder(splitDecoder, connData, serverStream.data(), serverStream.size(), segmentSize);
+		PTF_ASSERT_EQUAL(splitResults.types.size(), wholeResults.types.size());
+		PTF_ASSERT_TRUE(splitResults.messages == wholeResults.messages);
+		PTF_ASSERT_TRUE(splitResults.ja3 == wholeResults.ja3);
+		PTF_ASSERT_GREATER_THAN(splitResults.reassembled, 0);
+		PTF_ASSERT_GREATER_THAN(splitDecoder.getStatistics().bufferedRecords, 0);
+	}
+
+	// a ClientHello split across segments gets the same fingerprint as the complete payload
+	pcpp::TLSFingerprint expectedFingerprint;
+	PTF_ASSERT_TRUE(pcpp::TLSFingerprintExtractor::extract(
+	    clientTcpLayer->getLayerPayload(), clientTcpLayer->getLayerPayloadSize(), expectedFingerprint));
+	TLSStreamDecoderTestResults clientResults;
+	pcpp::TLSStreamDecoder clientDecoder(tlsStreamDecoderTestCallback, &clientResults);
+	feedTLSStreamDecoder(clientDecoder, connData, clientTcpLayer->getLayerPayload(),
+	                     clientTcpLayer->getLayerPayloadSize(), 50);
+	PTF_ASSERT_EQUAL(clientResults.types.size(), 1);
+	PTF_ASSERT_EQUAL(clientResults.types[0], pcpp::SSL_CLIENT_HELLO, enum);
+	PTF_ASSERT_EQUAL(clientResults.reassembled, 1);
+	PTF_ASSERT_EQUAL(clientResults.ja3.size(), 1);
+	PTF_ASSERT_EQUAL(clientResults.ja3[0], std::string(expectedFingerprint.ja3));
+
+	// a record that needs more than the buffer cap stops the decoding of the connection side
+	TLSStreamDecoderTestResults cappedResults;
+	pcpp::TLSStreamDecoder cappedDecoder(tlsStreamDecoderTestCallback, &cappedResults, 32);
+	feedTLSStreamDecoder(cappedDecoder, connData, clientTcpLayer->getLayerPayload(),
+	                     clientTcpLayer->getLayerPayloadSize(), 20);
+	PTF_ASSERT_EQUAL(cappedResults.types.size(), 0);
+	PTF_ASSERT_EQUAL(cappedDecoder.getStatistics().bufferCapExceeded, 1);
+	PTF_ASSERT_EQUAL(cappedDecoder.getBufferedBytes(connData.flowKey), 0);
+
+	// a record that was buffered and processed doesn't count against the cap when its handshake message continues in
+	// the next record: a 100 bytes message in a 65 bytes record split across segments and a 45 bytes record
+	std::vector<uint8_t> splitMessageStream = { 0x16, 0x03, 0x03, 0x00, 60, pcpp::SSL_CERTIFICATE, 0x00, 0x00, 96 };
+	splitMessageStream.resize(65, 0xab);
+	const uint8_t secondRecordHeader[] = { 0x16, 0x03, 0x03, 0x00, 40 };
+	splitMessageStream.insert(splitMessageStream.end(), secondRecordHeader,
+	                          secondRecordHeader + sizeof(secondRecordHeader));
+	splitMessageStream.resize(110, 0xcd);
+	TLSStreamDecoderTestResults splitMessageResults;
+	pcpp::TLSStreamDecoder splitMessageDecoder(tlsStreamDecoderTestCallback, &splitMessageResults, 120);
+	feedTLSStreamDecoder(splitMessageDecoder, connData, splitMessageStream.data(), 65, 30);
+	feedTLSStreamDecoder(splitMessageDecoder, connData, splitMessageStream.data() + 65, 45, 45);
+	PTF_ASSERT_EQUAL(splitMessageDecoder.getStatistics().bufferCapExceeded, 0);
+	PTF_ASSERT_EQUAL(splitMessageResults.types.size(), 1);
+	PTF_ASSERT_EQUAL(splitMessageResults.types[0], pcpp::SSL_CERTIFICATE, enum);
+	PTF_ASSERT_EQUAL(splitMessageResults.messages[0].size(), 100);
+	PTF_ASSERT_EQUAL(splitMessageDecoder.getBufferedBytes(connData.flowKey), 0);
+
+	// closing the connection from the callback stops decoding it, and its state is released after the segment
+	TLSStreamDecoderTestResults closingResults;
+	pcpp::TLSStreamDecoder closingDecoder(tlsStreamDecoderTestCallback, &closingResults);
+	closingResults.decoderToClose = &closingDecoder;
+	feedTLSStreamDecoder(closingDecoder, connData, serverStream.data(), serverStream.size(), serverStream.size());
+	PTF_ASSERT_EQUAL(closingResults.types.size(), 1);
+	PTF_ASSERT_EQUAL(closingResults.types[0], pcpp::SSL_SERVER_HELLO, enum);
+	PTF_ASSERT_EQUAL(closingDecoder.getConnectionCount(), 0);
+
+	// the same with a message reassembled from small segments
+	TLSStreamDecoderTestResults closingSplitResults;
+	pcpp::TLSStreamDecoder closingSplitDecoder(tlsStreamDecoderTestCallback, &closingSplitResults);
+	closingSplitResults.decoderToClose = &closingSplitDecoder;
+	feedTLSStreamDecoder(closingSplitDecoder, connData, clientTcpLayer->getLayerPayload(),
+	                     clientTcpLayer->getLayerPayloadSize(), 50);
+	PTF_ASSERT_EQUAL(closingSplitResults.types.size(), 1);
+	PTF_ASSERT_EQUAL(closingSplitResults.reassembled, 1);
+	PTF_ASSERT_EQUAL(closingSplitDecoder.getConnectionCount(), 0);
+
+	// non-TLS data and missing bytes stop the decoding
+	TLSStreamDecoderTestResults errorResults;
+	pcpp::TLSStreamDecoder errorDecoder(tlsStreamDecoderTestCallback, &errorResults);
+	const char* httpRequest = "GET / HTTP/1.1\r\n\r\n";
+	feedTLSStreamDecoder(errorDecoder, connData, reinterpret_cast<const uint8_t*>(httpRequest), strlen(httpRequest),
+	                     strlen(httpRequest));
+	feedTLSStreamDecoder(errorDecoder, connData, serverStream.data(), serverStream.size(), serverStream.size());
+	PTF_ASSERT_EQUAL(errorResults.types.size(), 0);
+
+	pcpp::ConnectionData otherConnData;
+	otherConnData.flowKey = 0x5678;
+	pcpp::TcpStreamData missingBytesData(serverStream.data(), serverStream.size(), 10, otherConnData,
+	                                     std::chrono::high_resolution_clock::now());
+	errorDecoder.processTcpData(1, missingBytesData);
+	PTF_ASSERT_EQUAL(errorResults.types.size(), 0);
+	PTF_ASSERT_EQUAL(errorDecoder.getStatistics().decodeErrors, 2);
+	PTF_ASSERT_EQUAL(errorDecoder.getConnectionCount(), 2);
+
+	errorDecoder.closeConnection(connData);
+	PTF_ASSERT_EQUAL(errorDecoder.getConnectionCount(), 1);
+	errorDecoder.closeAllConnections();
+	PTF_ASSERT_EQUAL(errorDecoder.getConnectionCount(), 0);
+}  // TLSStreamDecoderTest
@@ -161,6 +161,10 @@ int main(int argc, char* argv[])
 	PTF_RUN_TEST(PrintPacketAndLayersTest, "packet;print");
 	PTF_RUN_TEST(ProtocolFamilyMembershipTest, "packet");
 	PTF_RUN_TEST(PacketParseLayerLimitTest, "packet");
+	PTF_RUN_TEST(PacketTemplateTest, "packet;template");
+	PTF_RUN_TEST(PacketBuilderTest, "packet;builder");
+	PTF_RUN_TEST(MoveAndRecycleRawPacketTest, "packet;move");
+	PTF_RUN_TEST(MovePacketTest, "packet;move");
 
 	PTF_RUN_TEST(HttpRequestParseMethodTest, "http");
 	PTF_RUN_TEST(HttpRequestLayerParsingTest, "http");
@@ -172,6 +176,7 @@ int main(int argc, char* argv[])
 	PTF_RUN_TEST(HttpResponseLayerCreationTest, "http");
 	PTF_RUN_TEST(HttpResponseLayerEditTest, "http");
 	PTF_RUN_TEST(HttpMalformedResponseTest, "http");
+	PTF_RUN_TEST(HttpStreamParserTest, "http");
 
 	PTF_RUN_TEST(PPPoESessionLayerParsingTest, "pppoe");
 	PTF_RUN_TEST(PPPoESessionLayerCreationTest, "pppoe");
@@ -211,6 +216,8 @@ int main(int argc, char* argv[])
 	PTF_RUN_TEST(TLSCipherSuiteTest, "ssl");
 	PTF_RUN_TEST(ClientHelloTLSFingerprintTest, "ssl");
 	PTF_RUN_TEST(ServerHelloTLSFingerprintTest, "ssl");
+	PTF_RUN_TEST(TLSFingerprintExtractorTest, "ssl");
+	PTF_RUN_TEST(TLSStreamDecoderTest, "ssl");
 
 	PTF_RUN_TEST(SllPacketParsingTest, "sll");
 	PTF_RUN_TEST(SllPacketCreationTest, "sll");
@@ -332,6 +339,7 @@ int main(int argc, char* argv[])
 
 	PTF_RUN_TEST(Asn1DecodingTest, "asn1");
 	PTF_RUN_TEST(Asn1EncodingTest, "asn1");
+	PTF_RUN_TEST(Asn1ArenaDecodingTest, "asn1");
 
 	PTF_RUN_TEST(LdapParsingTest, "ldap");
 	PTF_RUN_TEST(LdapCreationTest, "ldap");
@@ -15,6 +15,11 @@ PTF_TEST_CASE(TestIPNetwork);
 // Implemented in ObjectPoolTests.cpp
 PTF_TEST_CASE(TestObjectPool);
 
+// Implemented in LockFreeRingTests.cpp
+PTF_TEST_CASE(TestSpscRing);
+PTF_TEST_CASE(TestMpmcRing);
+PTF_TEST_CASE(TestPacketPipeline);
+
 // Implemented in LoggerTests.cpp
 PTF_TEST_CASE(TestLogger);
 PTF_TEST_CASE(TestLoggerMultiThread);
@@ -29,6 +34,9 @@ PTF_TEST_CASE(TestPcapFileAppend);
 PTF_TEST_CASE(TestPcapNgFileReadWrite);
 PTF_TEST_CASE(TestPcapNgFileReadWriteAdv);
 PTF_TEST_CASE(TestPcapNgFileTooManyInterfaces);
+PTF_TEST_CASE(TestPcapNgFileWriteBuffered);
+PTF_TEST_CASE(TestPcapNgFileWriteCompressedFrames);
+PTF_TEST_CASE(TestPcapNgFileReadZeroCopy);
 PTF_TEST_CASE(TestPcapFileReadLinkTypeIPv6);
 PTF_TEST_CASE(TestPcapFileReadLinkTypeIPv4);
 PTF_TEST_CASE(TestSolarisSnoopFileRead);
@@ -44,6 +52,10 @@ PTF_TEST_CASE(TestPcapLiveDeviceNoNetworking);
 PTF_TEST_CASE(TestPcapLiveDeviceStatsMode);
 PTF_TEST_CASE(TestPcapLiveDeviceBlockingMode);
 PTF_TEST_CASE(TestPcapLiveDeviceWithLambda);
+PTF_TEST_CASE(TestPcapLiveDeviceBatchMode);
+PTF_TEST_CASE(TestPcapLiveDeviceFanout);
+PTF_TEST_CASE(TestTimingHistogram);
+PTF_TEST_CASE(TestPcapLiveDeviceCaptureTiming);
 PTF_TEST_CASE(TestPcapLiveDeviceBlockingModeWithLambda);
 PTF_TEST_CASE(TestPcapLiveDeviceSpecialCfg);
 PTF_TEST_CASE(TestWinPcapLiveDevice);
@@ -58,6 +70,10 @@ PTF_TEST_CASE(TestPcapFiltersLive);
 PTF_TEST_CASE(TestPcapFilters_General_BPFStr);
 PTF_TEST_CASE(TestPcapFiltersOffline);
 PTF_TEST_CASE(TestPcapFilters_LinkLayer);
+PTF_TEST_CASE(TestPcapFilters_Compiled);
+PTF_TEST_CASE(TestPcapFilters_ThreadedCode);
+PTF_TEST_CASE(TestPcapFilters_Native);
+PTF_TEST_CASE(TestPcapFilters_FilterSet);
 
 // Implemented in PacketParsingTests.cpp
 PTF_TEST_CASE(TestHttpRequestParsing);
@@ -118,6 +134,12 @@ PTF_TEST_CASE(TestKniDeviceSendReceive);
 
 // Implemented in RawSocketTests.cpp
 PTF_TEST_CASE(TestRawSockets);
+PTF_TEST_CASE(TestRawSocketsRxRing);
+PTF_TEST_CASE(TestRawSocketsBatchedSend);
+
+// Implemented in SoftwareRssTests.cpp
+PTF_TEST_CASE(TestRssHasher);
+PTF_TEST_CASE(TestSoftwareRssDispatcher);
 
 // Implemented in SystemUtilsTests.cpp
 PTF_TEST_CASE(TestSystemCoreUtils);
@@ -126,4 +148,5 @@ PTF_TEST_CASE(TestSystemCoreUtils);
 PTF_TEST_CASE(TestXdpDeviceReceivePackets);
 PTF_TEST_CASE(TestXdpDeviceSendPackets);
 PTF_TEST_CASE(TestXdpDeviceNonDefaultConfig);
+PTF_TEST_CASE(TestXdpDeviceReceiveThreads);
 PTF_TEST_CASE(TestXdpDeviceInvalidConfig);
@@ -625,18 +625,24 @@ PTF_TEST_CASE(TestDpdkDeviceWorkerThreads)
 	size_t mBufRawPacketArrLen = 32;
 	pcpp::Packet* packetArr[32] = {};
 	size_t packetArrLen = 32;
+	pcpp::DpdkPacketBurst packetBurst(32);
 
 	// negative tests
 	// --------------
 	pcpp::Logger::getInstance().suppressLogs();
+	pcpp::DpdkPacketBurst zeroCapacityBurst(0);
+	PTF_ASSERT_EQUAL(zeroCapacityBurst.getCapacity(), 0);
 	PTF_ASSERT_EQUAL(dev->receivePackets(rawPacketVec, 0), 0);
 	PTF_ASSERT_EQUAL(dev->receivePackets(packetArr, packetArrLen, 0), 0);
 	PTF_ASSERT_EQUAL(dev->receivePackets(mBufRawPacketArr, mBufRawPacketArrLen, 0), 0);
+	PTF_ASSERT_EQUAL(dev->receivePackets(packetBurst, 0), 0);
 
 	PTF_ASSERT_TRUE(dev->open());
 	PTF_ASSERT_EQUAL(dev->receivePackets(rawPacketVec, dev->getTotalNumOfRxQueues() + 1), 0);
 	PTF_ASSERT_EQUAL(dev->receivePackets(packetArr, packetArrLen, dev->getTotalNumOfRxQueues() + 1), 0);
 	PTF_ASSERT_EQUAL(dev->receivePackets(mBufRawPacketArr, mBufRawPacketArrLen, dev->getTotalNumOfRxQueues() + 1), 0);
+	PTF_ASSERT_EQUAL(dev->receivePackets(packetBurst, dev->getTotalNumOfRxQueues() + 1), 0);
+	PTF_ASSERT_EQUAL(dev->receivePackets(zeroCapacityBurst, 0), 0);
 
 	DpdkPacketData packetData;
 	mBufRawPacketArrLen = 32;
@@ -645,6 +651,7 @@ PTF_TEST_CASE(TestDpdkDeviceWorkerThreads)
 	PTF_ASSERT_EQUAL(dev->receivePackets(rawPacketVec, 0), 0);
 	PTF_ASSERT_EQUAL(dev->receivePackets(packetArr, packetArrLen, 0), 0);
 	PTF_ASSERT_EQUAL(dev->receivePackets(mBufRawPacketArr, mBufRawPacketArrLen, 0), 0);
+	PTF_ASSERT_EQUAL(dev->receivePackets(packetBurst, 0), 0);
 	pcpp::Logger::getInstance().enableLogs();
 	dev->stopCapture();
 	dev->close();
@@ -746,6 +753,39 @@ PTF_TEST_CASE(TestDpdkDeviceWorkerThreads)
 			delete packetArr[i];
 	}
 
+	// receive packets to a reusable packet burst
+	// ------------------------------------------
+	numOfAttempts = 0;
+	uint16_t burstPacketCount = 0;
+	while (numOfAttempts < 20 && burstPacketCount == 0)
+	{
+		for (int rxQueueId = 0; rxQueueId < numOfRxQueues && burstPacketCount == 0; ++rxQueueId)
+		{
+			burstPacketCount = dev->receivePackets(packetBurst, rxQueueId);
+		}
+
+		if (burstPacketCount == 0)
+		{
+			std::this_thread::sleep_for(std::chrono::seconds(1));
+			numOfAttempts++;
+		}
+	}
+
+	PTF_ASSERT_LOWER_THAN(numOfAttempts, 20);
+	PTF_ASSERT_EQUAL(packetBurst.size(), burstPacketCount);
+	for (uint16_t i = 0; i < burstPacketCount; i++)
+	{
+		PTF_ASSERT_NOT_NULL(packetBurst.getRawPacket(i).getMBuf());
+		PTF_ASSERT_EQUAL(packetBurst.getPacket(i).getRawPacket(), &packetBurst.getRawPacket(i), ptr);
+		PTF_ASSERT_NOT_NULL(packetBurst.getPacket(i).getFirstLayer());
+	}
+	PTF_PRINT_VERBOSE("Captured " << burstPacketCount << " packets in " << numOfAttempts
+	                              << " attempts using a packet burst");
+
+	packetBurst.release();
+	PTF_ASSERT_EQUAL(packetBurst.size(), 0);
+	PTF_ASSERT_NULL(packetBurst.getRawPacket(0).getMBuf());
+
 	// test worker threads
 	// -------------------
 	std::mutex queueMutexArr[numOfRxQueues];
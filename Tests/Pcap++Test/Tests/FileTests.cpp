@@ -3,8 +3,11 @@
 #include "Packet.h"
 #include "PcapFileDevice.h"
 #include "../Common/PcapFileNamesDef.h"
+#include <algorithm>
 #include <array>
 #include <fstream>
+#include <memory>
+#include <vector>
 
 class FileReaderTeardown
 {
@@ -842,6 +845,177 @@ PTF_TEST_CASE(TestPcapNgFileTooManyInterfaces)
 	readerDev.close();
 }  // TestPcapNgFileTooManyInterfaces
 
+PTF_TEST_CASE(TestPcapNgFileWriteBuffered)
+{
+	// more than the writer's 1MB output buffer, with two link types and comments on some of the packets
+	const int packetCount = 2000;
+	std::vector<uint8_t> data(1500);
+	for (size_t i = 0; i < data.size(); i++)
+		data[i] = static_cast<uint8_t>(i * 7);
+
+	auto getPacketLength = [](int index) { return 60 + (index * 37) % 1400; };
+
+	pcpp::PcapNgFileWriterDevice writerDev(EXAMPLE_PCAPNG_WRITE_PATH);
+	PTF_ASSERT_TRUE(writerDev.open());
+	for (int i = 0; i < packetCount; i++)
+	{
+		timespec timestamp = { 1000 + i, i * 13 };
+		pcpp::LinkLayerType linkType = (i % 50 == 0) ? pcpp::LINKTYPE_RAW : pcpp::LINKTYPE_ETHERNET;
+		pcpp::RawPacket rawPacket(data.data(), getPacketLength(i), timestamp, false, linkType);
+		std::string comment = (i % 10 == 0) ? "comment " + std::to_string(i) : std::string();
+		PTF_ASSERT_TRUE(writerDev.writePacket(rawPacket, comment));
+	}
+
+	// flush() makes all buffered packets visible to a reader
+	writerDev.flush();
+	{
+		pcpp::PcapNgFileReaderDevice readerDev(EXAMPLE_PCAPNG_WRITE_PATH);
+		PTF_ASSERT_TRUE(readerDev.open());
+		pcpp::RawPacketVector packets;
+		PTF_ASSERT_EQUAL(readerDev.getNextPackets(packets), packetCount);
+	}
+
+	writerDev.close();
+
+	pcpp::PcapNgFileReaderDevice readerDev(EXAMPLE_PCAPNG_WRITE_PATH);
+	PTF_ASSERT_TRUE(readerDev.open());
+	pcpp::RawPacket rawPacket;
+	std::string comment;
+	int readCount = 0;
+	while (readerDev.getNextPacket(rawPacket, comment))
+	{
+		PTF_ASSERT_EQUAL(rawPacket.getRawDataLen(), getPacketLength(readCount));
+		PTF_ASSERT_BUF_COMPARE(rawPacket.getRawData(), data.data(), rawPacket.getRawDataLen());
+		PTF_ASSERT_EQUAL(rawPacket.getPacketTimeStamp().tv_sec, 1000 + readCount);
+		PTF_ASSERT_EQUAL(rawPacket.getPacketTimeStamp().tv_nsec, readCount * 13);
+		PTF_ASSERT_EQUAL(rawPacket.getLinkLayerType(),
+		                 (readCount % 50 == 0) ? pcpp::LINKTYPE_RAW : pcpp::LINKTYPE_ETHERNET, enum);
+		PTF_ASSERT_EQUAL(comment, (readCount % 10 == 0) ? "comment " + std::to_string(readCount) : std::string());
+		readCount++;
+	}
+
+	PTF_ASSERT_EQUAL(readCount, packetCount);
+	readerDev.close();
+}  // TestPcapNgFileWriteBuffered
+
+PTF_TEST_CASE(TestPcapNgFileWriteCompressedFrames)
+{
+	pcpp::PcapNgFileWriterDevice writerDev(EXAMPLE_PCAPNG_ZSTD_WRITE_PATH, 5);
+	PTF_ASSERT_EQUAL(writerDev.getCompressionWorkerCount(), 0);
+	PTF_ASSERT_EQUAL(writerDev.getCompressionFrameSize(), 0);
+
+	// frames are limited to 1GB
+	writerDev.setCompressionFrameSize(static_cast<size_t>(2) * 1024 * 1024 * 1024);
+	pcpp::Logger::getInstance().suppressLogs();
+	PTF_ASSERT_FALSE(writerDev.open());
+	pcpp::Logger::getInstance().enableLogs();
+
+	// small frames, so the file is split into many of them, and frames end in the middle of packet blocks
+	writerDev.setCompressionWorkerCount(2);
+	writerDev.setCompressionFrameSize(10000);
+	PTF_ASSERT_EQUAL(writerDev.getCompressionWorkerCount(), 2);
+	PTF_ASSERT_EQUAL(writerDev.getCompressionFrameSize(), 10000);
+	PTF_ASSERT_TRUE(writerDev.open());
+
+	pcpp::PcapNgFileReaderDevice readerDev(EXAMPLE_PCAPNG_PATH);
+	PTF_ASSERT_TRUE(readerDev.open());
+	pcpp::RawPacketVector packets;
+	int packetCount = readerDev.getNextPackets(packets);
+	readerDev.close();
+	PTF_ASSERT_GREATER_THAN(packetCount, 0);
+	PTF_ASSERT_TRUE(writerDev.writePackets(packets));
+	writerDev.close();
+
+	// when the library is built with zstd the file ends with a seek table in the zstd seekable format
+	std::ifstream compressedFile(EXAMPLE_PCAPNG_ZSTD_WRITE_PATH, std::ios::binary);
+	std::vector<uint8_t> compressedData((std::istreambuf_iterator<char>(compressedFile)),
+	                                    std::istreambuf_iterator<char>());
+	compressedFile.close();
+	const std::array<uint8_t, 4> zstdMagic = { 0x28, 0xb5, 0x2f, 0xfd };
+	const std::array<uint8_t, 4> seekableMagic = { 0xb1, 0xea, 0x92, 0x8f };
+	PTF_ASSERT_GREATER_THAN(compressedData.size(), 4);
+	if (std::equal(zstdMagic.begin(), zstdMagic.end(), compressedData.begin()))
+	{
+		PTF_ASSERT_BUF_COMPARE(compressedData.data() + compressedData.size() - 4, seekableMagic.data(), 4);
+	}
+
+	pcpp::PcapNgFileReaderDevice compressedReaderDev(EXAMPLE_PCAPNG_ZSTD_WRITE_PATH);
+	PTF_ASSERT_TRUE(compressedReaderDev.open());
+	pcpp::RawPacket rawPacket;
+	int readCount = 0;
+	for (auto packet : packets)
+	{
+		PTF_ASSERT_TRUE(compressedReaderDev.getNextPacket(rawPacket));
+		PTF_ASSERT_EQUAL(rawPacket.getRawDataLen(), packet->getRawDataLen());
+		PTF_ASSERT_BUF_COMPARE(rawPacket.getRawData(), packet->getRawData(), packet->getRawDataLen());
+		PTF_ASSERT_EQUAL(rawPacket.getPacketTimeStamp().tv_nsec, packet->getPacketTimeStamp().tv_nsec);
+		readCount++;
+	}
+
+	PTF_ASSERT_FALSE(compressedReaderDev.getNextPacket(rawPacket));
+	PTF_ASSERT_EQUAL(readCount, packetCount);
+	compressedReaderDev.close();
+}  // TestPcapNgFileWriteCompressedFrames
+
+PTF_TEST_CASE(TestPcapNgFileReadZeroCopy)
+{
+	// a zero-copy reader returns the same packets as a copying reader, including timestamps, link types of several
+	// interfaces and comments
+	for (const char* fileName : { EXAMPLE_PCAPNG_PATH, EXAMPLE2_PCAPNG_PATH })
+	{
+		pcpp::PcapNgFileReaderDevice copyReaderDev(fileName);
+		pcpp::PcapNgFileReaderDevice zeroCopyReaderDev(fileName);
+		PTF_ASSERT_FALSE(zeroCopyReaderDev.isZeroCopyMode());
+		zeroCopyReaderDev.setZeroCopyMode(true);
+		PTF_ASSERT_TRUE(zeroCopyReaderDev.isZeroCopyMode());
+		PTF_ASSERT_TRUE(copyReaderDev.open());
+		PTF_ASSERT_TRUE(zeroCopyReaderDev.open());
+		PTF_ASSERT_EQUAL(zeroCopyReaderDev.getOS(), copyReaderDev.getOS());
+
+		pcpp::RawPacket copiedPacket;
+		pcpp::RawPacket zeroCopyPacket;
+		std::string copiedComment;
+		std::string zeroCopyComment;
+		int packetCount = 0;
+		while (copyReaderDev.getNextPacket(copiedPacket, copiedComment))
+		{
+			PTF_ASSERT_TRUE(zeroCopyReaderDev.getNextPacket(zeroCopyPacket, zeroCopyComment));
+			PTF_ASSERT_EQUAL(zeroCopyPacket.getRawDataLen(), copiedPacket.getRawDataLen());
+			PTF_ASSERT_EQUAL(zeroCopyPacket.getFrameLength(), copiedPacket.getFrameLength());
+			PTF_ASSERT_BUF_COMPARE(zeroCopyPacket.getRawData(), copiedPacket.getRawData(),
+			                       copiedPacket.getRawDataLen());
+			PTF_ASSERT_EQUAL(zeroCopyPacket.getPacketTimeStamp().tv_sec, copiedPacket.getPacketTimeStamp().tv_sec);
+			PTF_ASSERT_EQUAL(zeroCopyPacket.getPacketTimeStamp().tv_nsec, copiedPacket.getPacketTimeStamp().tv_nsec);
+			PTF_ASSERT_EQUAL(zeroCopyPacket.getLinkLayerType(), copiedPacket.getLinkLayerType(), enum);
+			PTF_ASSERT_EQUAL(zeroCopyComment, copiedComment);
+			packetCount++;
+		}
+
+		PTF_ASSERT_FALSE(zeroCopyReaderDev.getNextPacket(zeroCopyPacket));
+		PTF_ASSERT_GREATER_THAN(packetCount, 0);
+
+		pcpp::IPcapDevice::PcapStats readerStatistics;
+		zeroCopyReaderDev.getStatistics(readerStatistics);
+		PTF_ASSERT_EQUAL(readerStatistics.packetsRecv, static_cast<uint64_t>(packetCount));
+	}
+
+	// a packet which must outlive the next read is cloned
+	pcpp::PcapNgFileReaderDevice readerDev(EXAMPLE2_PCAPNG_PATH);
+	readerDev.setZeroCopyMode(true);
+	PTF_ASSERT_TRUE(readerDev.open());
+	pcpp::RawPacket rawPacket;
+	PTF_ASSERT_TRUE(readerDev.getNextPacket(rawPacket));
+	std::unique_ptr<pcpp::RawPacket> firstPacket(rawPacket.clone());
+	std::vector<uint8_t> firstPacketData(rawPacket.getRawData(), rawPacket.getRawData() + rawPacket.getRawDataLen());
+	while (readerDev.getNextPacket(rawPacket))
+	{
+	}
+
+	readerDev.close();
+	PTF_ASSERT_EQUAL(firstPacket->getRawDataLen(), static_cast<int>(firstPacketData.size()));
+	PTF_ASSERT_BUF_COMPARE(firstPacket->getRawData(), firstPacketData.data(), firstPacketData.size());
+}  // TestPcapNgFileReadZeroCopy
+
 PTF_TEST_CASE(TestPcapFileReadLinkTypeIPv6)
 {
 	pcpp::PcapFileReaderDevice readerDev(EXAMPLE_LINKTYPE_IPV6);
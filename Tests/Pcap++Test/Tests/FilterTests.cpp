@@ -1,6 +1,7 @@
 #include "../TestDefinition.h"
 #include "EndianPortable.h"
 #include "SystemUtils.h"
+#include "Logger.h"
 #include "EthLayer.h"
 #include "VlanLayer.h"
 #include "IPv4Layer.h"
@@ -10,6 +11,8 @@
 #include "Packet.h"
 #include "PcapLiveDeviceList.h"
 #include "PcapFileDevice.h"
+#include "NativeFilter.h"
+#include "FilterSet.h"
 #include "../Common/GlobalTestArgs.h"
 #include "../Common/PcapFileNamesDef.h"
 #include "../Common/TestUtils.h"
@@ -891,3 +894,399 @@ PTF_TEST_CASE(TestPcapFilters_LinkLayer)
 	PTF_ASSERT_EQUAL(validCounter, 62);
 	rawPacketVec.clear();
 }  // TestPcapFilters_LinkLayer
+
+PTF_TEST_CASE(TestPcapFilters_Compiled)
+{
+	pcpp::RawPacketVector rawPacketVec;
+	pcpp::PcapFileReaderDevice fileReaderDev(EXAMPLE_PCAP_PATH);
+	PTF_ASSERT_TRUE(fileReaderDev.open());
+	fileReaderDev.getNextPackets(rawPacketVec);
+	fileReaderDev.close();
+
+	std::vector<const pcpp::RawPacket*> rawPackets(rawPacketVec.begin(), rawPacketVec.end());
+
+	pcpp::IPFilter ipFilter("10.0.0.6", pcpp::SRC);
+	pcpp::ProtoFilter protoFilter(pcpp::UDP);
+	pcpp::AndFilter andFilter({ &ipFilter, &protoFilter });
+
+	pcpp::CompiledBpfFilter compiledFilter = andFilter.compile();
+	PTF_ASSERT_TRUE(compiledFilter.isValid());
+	PTF_ASSERT_EQUAL(compiledFilter.getFilter(), "(ip and src net 10.0.0.6/32) and (udp)");
+	PTF_ASSERT_EQUAL(compiledFilter.getLinkType(), pcpp::LINKTYPE_ETHERNET, enum);
+
+	// the compiled filter gives the same results as the filter object
+	int matchCount = 0;
+	for (const auto& rawPacket : rawPackets)
+	{
+		bool isMatch = compiledFilter.matches(rawPacket);
+		PTF_ASSERT_EQUAL(isMatch, andFilter.matchPacketWithFilter(const_cast<pcpp::RawPacket*>(rawPacket)));
+		if (isMatch)
+			++matchCount;
+	}
+	PTF_ASSERT_EQUAL(matchCount, 69);
+
+	// changing the filter object doesn't affect the compiled filter
+	protoFilter.setProto(pcpp::TCP);
+	PTF_ASSERT_EQUAL(compiledFilter.getFilter(), "(ip and src net 10.0.0.6/32) and (udp)");
+
+	// batch matching, a copy shares the compiled program
+	pcpp::CompiledBpfFilter compiledFilterCopy = compiledFilter;
+	std::unique_ptr<bool[]> results(new bool[rawPackets.size()]);
+	PTF_ASSERT_EQUAL(compiledFilterCopy.matchPackets(rawPackets.data(), rawPackets.size(), results.get()), 69);
+	for (size_t i = 0; i < rawPackets.size(); ++i)
+	{
+		PTF_ASSERT_EQUAL(results[i], compiledFilter.matches(rawPackets[i]));
+	}
+
+	std::bitset<64> resultBits;
+	size_t batchMatchCount = compiledFilter.matchPackets(rawPackets.data(), rawPackets.size(), resultBits);
+	PTF_ASSERT_EQUAL(batchMatchCount, resultBits.count());
+	for (size_t i = 0; i < resultBits.size(); ++i)
+	{
+		PTF_ASSERT_EQUAL(resultBits.test(i), results[i]);
+	}
+
+	// packets of a different link type never match
+	pcpp::CompiledBpfFilter rawIpFilter("udp", pcpp::LINKTYPE_DLT_RAW1);
+	PTF_ASSERT_TRUE(rawIpFilter.isValid());
+	PTF_ASSERT_EQUAL(rawIpFilter.matchPackets(rawPackets.data(), rawPackets.size(), results.get()), 0);
+
+	// empty and invalid filters
+	pcpp::CompiledBpfFilter emptyFilter;
+	PTF_ASSERT_TRUE(emptyFilter.isValid());
+	PTF_ASSERT_EQUAL(emptyFilter.matchPackets(rawPackets.data(), rawPackets.size(), results.get()),
+	                 rawPackets.size());
+
+	pcpp::Logger::getInstance().suppressLogs();
+	pcpp::CompiledBpfFilter invalidFilter("This is not a valid filter");
+	pcpp::Logger::getInstance().enableLogs();
+	PTF_ASSERT_FALSE(invalidFilter.isValid());
+	PTF_ASSERT_FALSE(invalidFilter.matches(rawPackets.front()));
+
+	rawPacketVec.clear();
+}  // TestPcapFilters_Compiled
+
+PTF_TEST_CASE(TestPcapFilters_ThreadedCode)
+{
+	// filters exercising absolute / indirect loads, the IPv4 header length instruction, ALU operations, scratch
+	// memory and the packet length
+	const std::vector<std::string> filters = {
+		"ip",
+		"vlan 118",
+		"host 10.0.0.6",
+		"tcp port 80",
+		"udp and src net 10.0.0.0/8",
+		"tcp[tcpflags] & (tcp-syn|tcp-fin) != 0",
+		"ip[2:2] / 4 - 10 > 100 or ip[8] % 3 == 1",
+		"ip6 and tcp",
+		"greater 500",
+		"ip[0] & 0xf != 5 or (ip[6:2] & 0x1fff) << 1 > 0",
+		"gre",
+		"igmp",
+	};
+
+	const std::vector<std::string> pcapFiles = { EXAMPLE_PCAP_PATH, EXAMPLE_PCAP_VLAN, EXAMPLE_PCAP_GRE,
+		                                         EXAMPLE_PCAP_IGMP, SLL_PCAP_PATH,     RAW_IP_PCAP_PATH };
+
+	for (const auto& pcapFile : pcapFiles)
+	{
+		pcpp::RawPacketVector rawPacketVec;
+		pcpp::PcapFileReaderDevice fileReaderDev(pcapFile);
+		PTF_ASSERT_TRUE(fileReaderDev.open());
+		fileReaderDev.getNextPackets(rawPacketVec);
+		fileReaderDev.close();
+		PTF_ASSERT_GREATER_THAN(rawPacketVec.size(), 0);
+
+		pcpp::LinkLayerType linkType = rawPacketVec.front()->getLinkLayerType();
+		for (const auto& filter : filters)
+		{
+			pcpp::BpfFilterWrapper interpreter;
+			pcpp::BpfFilterWrapper threadedCode;
+			threadedCode.setThreadedCodeEnabled(true);
+
+			pcpp::Logger::getInstance().suppressLogs();
+			bool isValidFilter = interpreter.setFilter(filter, linkType);
+			pcpp::Logger::getInstance().enableLogs();
+			if (!isValidFilter)
+			{
+				// some filters don't apply to all link types
+				continue;
+			}
+
+			PTF_ASSERT_TRUE(threadedCode.setFilter(filter, linkType));
+			PTF_ASSERT_TRUE(threadedCode.isThreadedCodeActive());
+			PTF_ASSERT_FALSE(interpreter.isThreadedCodeActive());
+
+			for (const auto& rawPacket : rawPacketVec)
+			{
+				PTF_ASSERT_EQUAL(threadedCode.matchPacketWithFilter(rawPacket),
+				                 interpreter.matchPacketWithFilter(rawPacket));
+			}
+		}
+	}
+
+	// enabling and disabling threaded code after a filter is set, and copying a wrapper
+	pcpp::BpfFilterWrapper bpfWrapper;
+	PTF_ASSERT_TRUE(bpfWrapper.setFilter("tcp port 80"));
+	PTF_ASSERT_FALSE(bpfWrapper.isThreadedCodeActive());
+	bpfWrapper.setThreadedCodeEnabled(true);
+	PTF_ASSERT_TRUE(bpfWrapper.isThreadedCodeEnabled());
+	PTF_ASSERT_TRUE(bpfWrapper.isThreadedCodeActive());
+
+	pcpp::BpfFilterWrapper bpfWrapperCopy(bpfWrapper);
+	PTF_ASSERT_TRUE(bpfWrapperCopy.isThreadedCodeActive());
+
+	bpfWrapper.setThreadedCodeEnabled(false);
+	PTF_ASSERT_FALSE(bpfWrapper.isThreadedCodeActive());
+	bpfWrapperCopy = bpfWrapper;
+	PTF_ASSERT_FALSE(bpfWrapperCopy.isThreadedCodeEnabled());
+	PTF_ASSERT_FALSE(bpfWrapperCopy.isThreadedCodeActive());
+}  // TestPcapFilters_ThreadedCode
+
+PTF_TEST_CASE(TestPcapFilters_Native)
+{
+	pcpp::IPFilter ipSrcFilter("10.0.0.6", pcpp::SRC);
+	pcpp::IPFilter ipNetFilter("10.0.0.0", pcpp::SRC_OR_DST, 8);
+	pcpp::IPFilter ipv6NetFilter("2001:db8::", pcpp::DST, 32);
+	pcpp::PortFilter portFilter(80, pcpp::SRC_OR_DST);
+	pcpp::PortRangeFilter portRangeFilter(1000, 60000, pcpp::DST);
+	pcpp::ProtoFilter tcpFilter(pcpp::TCP);
+	pcpp::ProtoFilter udpFilter(pcpp::UDP);
+	pcpp::ProtoFilter ipv4Filter(pcpp::IPv4);
+	pcpp::ProtoFilter ipv6Filter(pcpp::IPv6);
+	pcpp::ProtoFilter arpProtoFilter(pcpp::ARP);
+	pcpp::ProtoFilter igmpFilter(pcpp::IGMP);
+	pcpp::ArpFilter arpReplyFilter(pcpp::ARP_REPLY);
+	pcpp::EtherTypeFilter etherTypeFilter(PCPP_ETHERTYPE_IP);
+	pcpp::TcpFlagsFilter synOrFinFilter(pcpp::TcpFlagsFilter::tcpSyn | pcpp::TcpFlagsFilter::tcpFin,
+	                                    pcpp::TcpFlagsFilter::MatchOneAtLeast);
+	pcpp::TcpFlagsFilter synAckFilter(pcpp::TcpFlagsFilter::tcpSyn | pcpp::TcpFlagsFilter::tcpAck,
+	                                  pcpp::TcpFlagsFilter::MatchAll);
+	pcpp::IPv4IDFilter ipIdFilter(0x8000, pcpp::GREATER_THAN);
+	pcpp::IPv4TotalLengthFilter totalLengthFilter(100, pcpp::LESS_OR_EQUAL);
+	pcpp::TcpWindowSizeFilter windowSizeFilter(8192, pcpp::GREATER_OR_EQUAL);
+	pcpp::UdpLengthFilter udpLengthFilter(100, pcpp::LESS_THAN);
+	pcpp::AndFilter ipUdpFilter({ &ipSrcFilter, &udpFilter });
+	pcpp::NotFilter notTcpFilter(&tcpFilter);
+	pcpp::OrFilter orFilter({ &ipUdpFilter, &synOrFinFilter, &arpProtoFilter });
+	pcpp::AndFilter nestedFilter({ &orFilter, &notTcpFilter, &totalLengthFilter });
+	pcpp::AndFilter emptyFilter;
+
+	const std::vector<pcpp::GeneralFilter*> filters = {
+		&ipSrcFilter,      &ipNetFilter,       &ipv6NetFilter,    &portFilter,      &portRangeFilter, &tcpFilter,
+		&udpFilter,        &ipv4Filter,        &ipv6Filter,       &arpProtoFilter,  &igmpFilter,      &arpReplyFilter,
+		&etherTypeFilter,  &synOrFinFilter,    &synAckFilter,     &ipIdFilter,      &totalLengthFilter,
+		&windowSizeFilter, &udpLengthFilter,   &ipUdpFilter,      &notTcpFilter,    &orFilter,        &nestedFilter,
+		&emptyFilter,
+	};
+
+	// the native filters give the same results as BPF for packets without VLAN tags
+	const std::vector<std::string> pcapFiles = { EXAMPLE_PCAP_PATH, EXAMPLE_PCAP_IGMP, SLL_PCAP_PATH,
+		                                         RAW_IP_PCAP_PATH };
+
+	for (const auto& pcapFile : pcapFiles)
+	{
+		pcpp::RawPacketVector rawPacketVec;
+		pcpp::PcapFileReaderDevice fileReaderDev(pcapFile);
+		PTF_ASSERT_TRUE(fileReaderDev.open());
+		fileReaderDev.getNextPackets(rawPacketVec);
+		fileReaderDev.close();
+		PTF_ASSERT_GREATER_THAN(rawPacketVec.size(), 0);
+
+		// the key is extracted once per packet and matched with all filters
+		pcpp::LinkLayerType linkType = rawPacketVec.front()->getLinkLayerType();
+		std::vector<pcpp::FilterFlowKey> keys(rawPacketVec.size());
+		for (size_t i = 0; i < rawPacketVec.size(); ++i)
+		{
+			keys[i].extract(rawPacketVec.at(i));
+		}
+
+		for (const auto& filter : filters)
+		{
+			pcpp::Logger::getInstance().suppressLogs();
+			pcpp::CompiledBpfFilter compiledFilter = filter->compile(linkType);
+			pcpp::Logger::getInstance().enableLogs();
+			if (!compiledFilter.isValid())
+			{
+				// some filters don't apply to all link types
+				continue;
+			}
+
+			pcpp::NativeFilter nativeFilter(*filter);
+			PTF_ASSERT_TRUE(nativeFilter.isValid());
+
+			for (size_t i = 0; i < rawPacketVec.size(); ++i)
+			{
+				PTF_ASSERT_EQUAL(nativeFilter.matches(keys[i]), compiledFilter.matches(rawPacketVec.at(i)));
+			}
+		}
+	}
+
+	// known match count, same as in TestPcapFilters_Compiled
+	pcpp::RawPacketVector rawPacketVec;
+	pcpp::PcapFileReaderDevice fileReaderDev(EXAMPLE_PCAP_PATH);
+	PTF_ASSERT_TRUE(fileReaderDev.open());
+	fileReaderDev.getNextPackets(rawPacketVec);
+	fileReaderDev.close();
+
+	pcpp::NativeFilter ipUdpNativeFilter(ipUdpFilter);
+	PTF_ASSERT_TRUE(ipUdpNativeFilter.isValid());
+	PTF_ASSERT_EQUAL(ipUdpNativeFilter.getInstructions().size(), 3);
+	int matchCount = 0;
+	for (const auto& rawPacket : rawPacketVec)
+	{
+		if (ipUdpNativeFilter.matches(rawPacket))
+			++matchCount;
+	}
+	PTF_ASSERT_EQUAL(matchCount, 69);
+
+	// changing the filter object doesn't affect the native filter
+	udpFilter.setProto(pcpp::TCP);
+	matchCount = 0;
+	for (const auto& rawPacket : rawPacketVec)
+	{
+		if (ipUdpNativeFilter.matches(rawPacket))
+			++matchCount;
+	}
+	PTF_ASSERT_EQUAL(matchCount, 69);
+	udpFilter.setProto(pcpp::UDP);
+
+	// VLAN tagged packets: the VLAN filters behave like BPF, while the network and transport fields are looked up
+	// after the VLAN tags like Packet++ does
+	rawPacketVec.clear();
+	pcpp::PcapFileReaderDevice vlanReaderDev(EXAMPLE_PCAP_VLAN);
+	PTF_ASSERT_TRUE(vlanReaderDev.open());
+	vlanReaderDev.getNextPackets(rawPacketVec);
+	vlanReaderDev.close();
+
+	pcpp::VlanFilter vlanFilter(118);
+	pcpp::ProtoFilter vlanProtoFilter(pcpp::VLAN);
+	pcpp::MacAddressFilter macAddrFilter(pcpp::MacAddress("00:13:c3:df:ae:18"), pcpp::DST);
+	for (const auto& filter : std::vector<pcpp::GeneralFilter*>{ &vlanFilter, &vlanProtoFilter, &macAddrFilter })
+	{
+		pcpp::CompiledBpfFilter compiledFilter = filter->compile();
+		PTF_ASSERT_TRUE(compiledFilter.isValid());
+		pcpp::NativeFilter nativeFilter(*filter);
+		PTF_ASSERT_TRUE(nativeFilter.isValid());
+		for (const auto& rawPacket : rawPacketVec)
+		{
+			PTF_ASSERT_EQUAL(nativeFilter.matches(rawPacket), compiledFilter.matches(rawPacket));
+		}
+	}
+
+	pcpp::NativeFilter nativeTcpFilter(tcpFilter);
+	for (const auto& rawPacket : rawPacketVec)
+	{
+		pcpp::Packet packet(rawPacket);
+		PTF_ASSERT_EQUAL(nativeTcpFilter.matches(rawPacket), packet.isPacketOfType(pcpp::TCP));
+	}
+
+	// filters that can't be evaluated natively
+	pcpp::BPFStringFilter bpfStringFilter("udp port 53");
+	pcpp::NativeFilter bpfStringNativeFilter(bpfStringFilter);
+	PTF_ASSERT_FALSE(bpfStringNativeFilter.isValid());
+	PTF_ASSERT_FALSE(bpfStringNativeFilter.matches(rawPacketVec.front()));
+
+	pcpp::AndFilter unsupportedAndFilter({ &ipSrcFilter, &bpfStringFilter });
+	PTF_ASSERT_FALSE(pcpp::NativeFilter(unsupportedAndFilter).isValid());
+
+	pcpp::NotFilter emptyNotFilter(nullptr);
+	PTF_ASSERT_FALSE(pcpp::NativeFilter(emptyNotFilter).isValid());
+
+	pcpp::NativeFilter defaultFilter;
+	PTF_ASSERT_FALSE(defaultFilter.isValid());
+
+	// filters nested deeper than the maximum depth are rejected
+	std::vector<std::unique_ptr<pcpp::AndFilter>> deepFilters;
+	pcpp::GeneralFilter* deepFilter = &ipv4Filter;
+	for (size_t i = 0; i < pcpp::NativeFilter::MaxStackDepth; ++i)
+	{
+		deepFilters.emplace_back(new pcpp::AndFilter({ &ipv4Filter, deepFilter }));
+		deepFilter = deepFilters.back().get();
+	}
+	pcpp::Logger::getInstance().suppressLogs();
+	pcpp::NativeFilter deepNativeFilter(*deepFilter);
+	pcpp::Logger::getInstance().enableLogs();
+	PTF_ASSERT_FALSE(deepNativeFilter.isValid());
+}  // TestPcapFilters_Native
+
+PTF_TEST_CASE(TestPcapFilters_FilterSet)
+{
+	pcpp::RawPacketVector rawPacketVec;
+	pcpp::PcapFileReaderDevice fileReaderDev(EXAMPLE_PCAP_PATH);
+	PTF_ASSERT_TRUE(fileReaderDev.open());
+	fileReaderDev.getNextPackets(rawPacketVec);
+	fileReaderDev.close();
+
+	pcpp::IPFilter hostFilter("10.0.0.6", pcpp::SRC);
+	pcpp::IPFilter networkFilter("212.199.202.0", pcpp::SRC_OR_DST, 24);
+	pcpp::PortFilter portFilter(80, pcpp::DST);
+	pcpp::PortRangeFilter portRangeFilter(1024, 3000, pcpp::SRC_OR_DST);
+	pcpp::PortRangeFilter reversedPortRangeFilter(443, 80, pcpp::SRC);
+	pcpp::ProtoFilter udpFilter(pcpp::UDP);
+	pcpp::AndFilter hostUdpFilter({ &hostFilter, &udpFilter });
+	pcpp::AndFilter networkPortFilter({ &networkFilter, &portFilter, &udpFilter });
+	pcpp::OrFilter orFilter({ &hostFilter, &portFilter });
+	pcpp::NotFilter notFilter(&networkFilter);
+	pcpp::BPFStringFilter bpfStringFilter("udp port 53");
+
+	const std::vector<pcpp::GeneralFilter*> filters = {
+		&hostFilter, &networkFilter,     &portFilter,        &portRangeFilter, &reversedPortRangeFilter,
+		&udpFilter,  &hostUdpFilter,     &networkPortFilter, &orFilter,        &notFilter,
+		&bpfStringFilter,
+	};
+
+	pcpp::FilterSet filterSet;
+	std::vector<pcpp::CompiledBpfFilter> compiledFilters;
+	for (size_t i = 0; i < filters.size(); ++i)
+	{
+		PTF_ASSERT_EQUAL(filterSet.addFilter(*filters[i]), static_cast<int>(i));
+		compiledFilters.push_back(filters[i]->compile());
+		PTF_ASSERT_TRUE(compiledFilters.back().isValid());
+	}
+
+	PTF_ASSERT_EQUAL(filterSet.getRuleCount(), filters.size());
+	// udpFilter, orFilter, notFilter and the BPF string filter can't be indexed
+	PTF_ASSERT_EQUAL(filterSet.getUnindexedRuleCount(), 4);
+
+	// invalid filters aren't added
+	pcpp::BPFStringFilter invalidFilter("This is not a valid filter");
+	pcpp::Logger::getInstance().suppressLogs();
+	PTF_ASSERT_EQUAL(filterSet.addFilter(invalidFilter), -1);
+	pcpp::Logger::getInstance().enableLogs();
+	PTF_ASSERT_EQUAL(filterSet.getRuleCount(), filters.size());
+
+	// the filter set gives the same results as matching each filter separately
+	std::vector<bool> matchingRules;
+	std::vector<int> ruleMatchCount(filters.size(), 0);
+	for (const auto& rawPacket : rawPacketVec)
+	{
+		size_t matchCount = filterSet.matchPacket(rawPacket, matchingRules);
+		PTF_ASSERT_EQUAL(matchingRules.size(), filters.size());
+
+		size_t expectedMatchCount = 0;
+		for (size_t i = 0; i < filters.size(); ++i)
+		{
+			bool isMatch = compiledFilters[i].matches(rawPacket);
+			PTF_ASSERT_EQUAL(isMatch, matchingRules[i]);
+			if (isMatch)
+			{
+				++expectedMatchCount;
+				++ruleMatchCount[i];
+			}
+		}
+		PTF_ASSERT_EQUAL(matchCount, expectedMatchCount);
+	}
+	PTF_ASSERT_EQUAL(ruleMatchCount[6], 69);
+
+	// every indexed rule matched at least one packet, so the lookups were exercised
+	for (size_t i = 0; i < 5; ++i)
+	{
+		PTF_ASSERT_GREATER_THAN(ruleMatchCount[i], 0);
+	}
+
+	filterSet.clear();
+	PTF_ASSERT_EQUAL(filterSet.getRuleCount(), 0);
+	PTF_ASSERT_EQUAL(filterSet.matchPacket(rawPacketVec.front(), matchingRules), 0);
+	PTF_ASSERT_TRUE(matchingRules.empty());
+}  // TestPcapFilters_FilterSet
@@ -12,6 +12,7 @@
 #include "../Common/TestUtils.h"
 #include "../Common/PcapFileNamesDef.h"
 #include <array>
+#include <atomic>
 #include <vector>
 #include <iterator>
 #include <algorithm>
@@ -611,6 +612,273 @@ PTF_TEST_CASE(TestPcapLiveDeviceWithLambda)
 	PTF_ASSERT_GREATER_OR_EQUAL_THAN(numOfTimeStatsWereInvoked, totalSleepTime - 2);
 }  // TestPcapLiveDeviceWithLambda
 
+PTF_TEST_CASE(TestPcapLiveDeviceBatchMode)
+{
+	pcpp::PcapLiveDevice* liveDev = nullptr;
+	pcpp::IPv4Address ipToSearch(PcapTestGlobalArgs.ipToSendReceivePackets.c_str());
+	liveDev = pcpp::PcapLiveDeviceList::getInstance().getDeviceByIp(ipToSearch);
+	PTF_ASSERT_NOT_NULL(liveDev);
+
+	struct BatchStats
+	{
+		int batchCount = 0;
+		int packetCount = 0;
+		uint32_t maxBatchSize = 0;
+		int invalidPacketCount = 0;
+	};
+
+	auto packetsArriveLambda = [](pcpp::RawPacket* packets, uint32_t packetCount, pcpp::PcapLiveDevice* pDevice,
+	                              void* userCookie) {
+		BatchStats* batchStats = static_cast<BatchStats*>(userCookie);
+		batchStats->batchCount++;
+		batchStats->packetCount += packetCount;
+		batchStats->maxBatchSize = std::max(batchStats->maxBatchSize, packetCount);
+		for (uint32_t i = 0; i < packetCount; i++)
+		{
+			if (!packets[i].isPacketSet() || packets[i].getFrameLength() < packets[i].getRawDataLen())
+				batchStats->invalidPacketCount++;
+		}
+	};
+
+	BatchStats batchStats;
+
+	pcpp::Logger::getInstance().suppressLogs();
+	PTF_ASSERT_FALSE(liveDev->startCaptureBatchMode(packetsArriveLambda, &batchStats, 8));
+	pcpp::Logger::getInstance().enableLogs();
+
+	PTF_ASSERT_TRUE(liveDev->open());
+	DeviceTeardown devTeardown(liveDev);
+
+	pcpp::Logger::getInstance().suppressLogs();
+	PTF_ASSERT_FALSE(liveDev->startCaptureBatchMode(packetsArriveLambda, &batchStats, 0));
+	PTF_ASSERT_FALSE(liveDev->startCaptureBatchMode(nullptr, &batchStats, 8));
+	pcpp::Logger::getInstance().enableLogs();
+
+	PTF_ASSERT_TRUE(liveDev->startCaptureBatchMode(packetsArriveLambda, &batchStats, 8));
+	PTF_ASSERT_TRUE(liveDev->captureActive());
+
+	pcpp::Logger::getInstance().suppressLogs();
+	PTF_ASSERT_FALSE(liveDev->startCaptureBatchMode(packetsArriveLambda, &batchStats, 8));
+	pcpp::Logger::getInstance().enableLogs();
+
+	int totalSleepTime = 0;
+	while (totalSleepTime <= 20)
+	{
+		std::this_thread::sleep_for(std::chrono::seconds(2));
+		totalSleepTime += 2;
+		if (batchStats.packetCount > 0)
+			break;
+	}
+
+	PTF_PRINT_VERBOSE("Total sleep time: " << totalSleepTime << " secs");
+
+	liveDev->stopCapture();
+	PTF_ASSERT_FALSE(liveDev->captureActive());
+	PTF_ASSERT_GREATER_THAN(batchStats.batchCount, 0);
+	PTF_ASSERT_GREATER_OR_EQUAL_THAN(batchStats.packetCount, batchStats.batchCount);
+	PTF_ASSERT_LOWER_OR_EQUAL_THAN(batchStats.maxBatchSize, 8);
+	PTF_ASSERT_EQUAL(batchStats.invalidPacketCount, 0);
+
+	// the device can switch back to per-packet capture
+	int packetCount = 0;
+	PTF_ASSERT_TRUE(liveDev->startCapture(packetArrives, &packetCount));
+	liveDev->stopCapture();
+}  // TestPcapLiveDeviceBatchMode
+
+PTF_TEST_CASE(TestPcapLiveDeviceFanout)
+{
+	pcpp::PcapLiveDevice* liveDev = nullptr;
+	pcpp::IPv4Address ipToSearch(PcapTestGlobalArgs.ipToSendReceivePackets.c_str());
+	liveDev = pcpp::PcapLiveDeviceList::getInstance().getDeviceByIp(ipToSearch);
+	PTF_ASSERT_NOT_NULL(liveDev);
+
+	struct FanoutStats
+	{
+		std::atomic<int> packetCount[2];
+		std::atomic<int> invalidThreadIndexCount;
+
+		FanoutStats() : packetCount{ { 0 }, { 0 } }, invalidThreadIndexCount(0)
+		{}
+	};
+
+	auto packetArrivesLambda = [](pcpp::RawPacket* rawPacket, pcpp::PcapLiveDevice* pDevice, uint32_t threadIndex,
+	                              void* userCookie) {
+		FanoutStats* fanoutStats = static_cast<FanoutStats*>(userCookie);
+		if (threadIndex < 2)
+			fanoutStats->packetCount[threadIndex]++;
+		else
+			fanoutStats->invalidThreadIndexCount++;
+	};
+
+	FanoutStats fanoutStats;
+	pcpp::PcapLiveDevice::FanoutConfiguration fanoutConfig(2, 0x4321);
+
+	pcpp::Logger::getInstance().suppressLogs();
+	PTF_ASSERT_FALSE(liveDev->startFanoutCapture(fanoutConfig, packetArrivesLambda, &fanoutStats));
+	pcpp::Logger::getInstance().enableLogs();
+
+	PTF_ASSERT_TRUE(liveDev->open());
+	DeviceTeardown devTeardown(liveDev);
+
+#if defined(__linux__)
+	pcpp::PcapLiveDevice::FanoutConfiguration badFanoutConfig(0, 0x4321);
+	pcpp::PcapLiveDevice::FanoutConfiguration ebpfFanoutConfig(2, 0x4321,
+	                                                           pcpp::PcapLiveDevice::FanoutConfiguration::FanoutEbpf);
+	pcpp::Logger::getInstance().suppressLogs();
+	PTF_ASSERT_FALSE(liveDev->startFanoutCapture(badFanoutConfig, packetArrivesLambda, &fanoutStats));
+	PTF_ASSERT_FALSE(liveDev->startFanoutCapture(ebpfFanoutConfig, packetArrivesLambda, &fanoutStats));
+	PTF_ASSERT_FALSE(liveDev->startFanoutCapture(fanoutConfig, nullptr, &fanoutStats));
+	pcpp::Logger::getInstance().enableLogs();
+
+	PTF_ASSERT_TRUE(liveDev->startFanoutCapture(fanoutConfig, packetArrivesLambda, &fanoutStats));
+	PTF_ASSERT_TRUE(liveDev->captureActive());
+	PTF_ASSERT_EQUAL(liveDev->getFanoutThreadCount(), 2);
+
+	pcpp::Logger::getInstance().suppressLogs();
+	PTF_ASSERT_FALSE(liveDev->startFanoutCapture(fanoutConfig, packetArrivesLambda, &fanoutStats));
+	pcpp::Logger::getInstance().enableLogs();
+
+	int totalSleepTime = 0;
+	while (totalSleepTime <= 20)
+	{
+		std::this_thread::sleep_for(std::chrono::seconds(2));
+		totalSleepTime += 2;
+		if (fanoutStats.packetCount[0] + fanoutStats.packetCount[1] > 0)
+			break;
+	}
+
+	PTF_PRINT_VERBOSE("Total sleep time: " << totalSleepTime << " secs");
+	PTF_PRINT_VERBOSE("Packets per thread: " << fanoutStats.packetCount[0] << ", " << fanoutStats.packetCount[1]);
+
+	liveDev->stopCapture();
+	PTF_ASSERT_FALSE(liveDev->captureActive());
+	PTF_ASSERT_GREATER_THAN(fanoutStats.packetCount[0] + fanoutStats.packetCount[1], 0);
+	PTF_ASSERT_EQUAL(fanoutStats.invalidThreadIndexCount.load(), 0);
+	PTF_ASSERT_EQUAL(liveDev->getFanoutThreadCount(), 2);
+
+	// the statistics of all fanout handles are summed until the device is closed
+	pcpp::IPcapDevice::PcapStats statistics;
+	liveDev->getStatistics(statistics);
+	PTF_ASSERT_GREATER_OR_EQUAL_THAN(statistics.packetsRecv,
+	                                 (uint64_t)(fanoutStats.packetCount[0] + fanoutStats.packetCount[1]));
+
+	liveDev->close();
+	PTF_ASSERT_EQUAL(liveDev->getFanoutThreadCount(), 0);
+#else
+	pcpp::Logger::getInstance().suppressLogs();
+	PTF_ASSERT_FALSE(liveDev->startFanoutCapture(fanoutConfig, packetArrivesLambda, &fanoutStats));
+	pcpp::Logger::getInstance().enableLogs();
+#endif
+}  // TestPcapLiveDeviceFanout
+
+PTF_TEST_CASE(TestTimingHistogram)
+{
+	pcpp::TimingHistogram histogram;
+	PTF_ASSERT_EQUAL(histogram.getCount(), 0);
+	PTF_ASSERT_EQUAL(histogram.getMin(), 0);
+	PTF_ASSERT_EQUAL(histogram.getValueAtPercentile(50), 0);
+
+	// small values have exact buckets, larger ones are split into 16 buckets per power of 2
+	PTF_ASSERT_EQUAL(pcpp::TimingHistogram::getBucketIndex(15), 15);
+	PTF_ASSERT_EQUAL(pcpp::TimingHistogram::getBucketIndex(16), 16);
+	PTF_ASSERT_EQUAL(pcpp::TimingHistogram::getBucketIndex(31), 31);
+	PTF_ASSERT_EQUAL(pcpp::TimingHistogram::getBucketIndex(32), 32);
+	PTF_ASSERT_EQUAL(pcpp::TimingHistogram::getBucketIndex(33), 32);
+	PTF_ASSERT_EQUAL(pcpp::TimingHistogram::getBucketIndex(UINT64_MAX), pcpp::TimingHistogram::BucketCount - 1);
+	for (uint64_t value : { 17ULL, 1000ULL, 123456789ULL, 1ULL << 40 })
+	{
+		size_t index = pcpp::TimingHistogram::getBucketIndex(value);
+		PTF_ASSERT_LOWER_OR_EQUAL_THAN(pcpp::TimingHistogram::getBucketLowerBound(index), value);
+		PTF_ASSERT_GREATER_OR_EQUAL_THAN(pcpp::TimingHistogram::getBucketUpperBound(index), value);
+		PTF_ASSERT_EQUAL(pcpp::TimingHistogram::getBucketIndex(pcpp::TimingHistogram::getBucketUpperBound(index)),
+		                 index);
+		PTF_ASSERT_EQUAL(pcpp::TimingHistogram::getBucketIndex(pcpp::TimingHistogram::getBucketLowerBound(index)),
+		                 index);
+	}
+
+	for (uint64_t value = 1; value <= 1000; value++)
+		histogram.record(value * 1000);
+
+	PTF_ASSERT_EQUAL(histogram.getCount(), 1000);
+	PTF_ASSERT_EQUAL(histogram.getMin(), 1000);
+	PTF_ASSERT_EQUAL(histogram.getMax(), 1000000);
+	PTF_ASSERT_EQUAL(histogram.getSum(), 500500000);
+
+	// percentiles are within the bucket precision of the exact value
+	uint64_t median = histogram.getValueAtPercentile(50);
+	PTF_ASSERT_GREATER_OR_EQUAL_THAN(median, 500000);
+	PTF_ASSERT_LOWER_OR_EQUAL_THAN(median, 500000 + 500000 / 16);
+	PTF_ASSERT_EQUAL(histogram.getValueAtPercentile(100), 1000000);
+	PTF_ASSERT_LOWER_OR_EQUAL_THAN(histogram.getValueAtPercentile(0), 1000 + 1000 / 16);
+
+	pcpp::TimingHistogram other;
+	other.record(5, 3);
+	histogram.merge(other);
+	PTF_ASSERT_EQUAL(histogram.getCount(), 1003);
+	PTF_ASSERT_EQUAL(histogram.getMin(), 5);
+	PTF_ASSERT_EQUAL(histogram.getValueAtPercentile(0.1), 5);
+
+	histogram.reset();
+	PTF_ASSERT_EQUAL(histogram.getCount(), 0);
+	PTF_ASSERT_EQUAL(histogram.getMax(), 0);
+}  // TestTimingHistogram
+
+PTF_TEST_CASE(TestPcapLiveDeviceCaptureTiming)
+{
+	pcpp::PcapLiveDevice* liveDev = nullptr;
+	pcpp::IPv4Address ipToSearch(PcapTestGlobalArgs.ipToSendReceivePackets.c_str());
+	liveDev = pcpp::PcapLiveDeviceList::getInstance().getDeviceByIp(ipToSearch);
+	PTF_ASSERT_NOT_NULL(liveDev);
+	PTF_ASSERT_TRUE(liveDev->open());
+	DeviceTeardown devTeardown(liveDev);
+
+	// timing is disabled by default and nothing is recorded
+	PTF_ASSERT_FALSE(liveDev->isCaptureTimingEnabled());
+	int packetCount = 0;
+	PTF_ASSERT_EQUAL(liveDev->startCaptureBlockingMode(packetArrivesBlockingModeNoTimeoutPacketCount, &packetCount, 5),
+	                 -1);
+	pcpp::CaptureTimingStats timingStats;
+	liveDev->getCaptureTimingStats(timingStats);
+	PTF_ASSERT_EQUAL(timingStats.threadCount, 0);
+	PTF_ASSERT_EQUAL(timingStats.callbackDurationNs.getCount(), 0);
+
+	liveDev->setCaptureTimingEnabled(true);
+	PTF_ASSERT_TRUE(liveDev->isCaptureTimingEnabled());
+	packetCount = 0;
+	PTF_ASSERT_TRUE(liveDev->startCapture(packetArrives, &packetCount));
+	int totalSleepTime = 0;
+	while (totalSleepTime <= 20)
+	{
+		std::this_thread::sleep_for(std::chrono::seconds(2));
+		totalSleepTime += 2;
+		if (packetCount > 0)
+			break;
+	}
+
+	liveDev->stopCapture();
+
+	liveDev->getCaptureTimingStats(timingStats);
+	PTF_PRINT_VERBOSE("Timestamp to callback p50/p99: " << timingStats.timestampToCallbackNs.getValueAtPercentile(50)
+	                                                    << " / "
+	                                                    << timingStats.timestampToCallbackNs.getValueAtPercentile(99)
+	                                                    << " ns, capture thread CPU time: "
+	                                                    << timingStats.captureThreadCpuTimeNs << " ns");
+	PTF_ASSERT_EQUAL(timingStats.threadCount, 1);
+	PTF_ASSERT_GREATER_THAN(packetCount, 0);
+	PTF_ASSERT_EQUAL(timingStats.callbackDurationNs.getCount(), (uint64_t)packetCount);
+	PTF_ASSERT_EQUAL(timingStats.timestampToCallbackNs.getCount() + timingStats.futureTimestampCount,
+	                 (uint64_t)packetCount);
+	PTF_ASSERT_GREATER_THAN(timingStats.dispatchBatchSize.getCount(), 0);
+	PTF_ASSERT_EQUAL(timingStats.dispatchBatchSize.getSum(), (uint64_t)packetCount);
+
+	liveDev->resetCaptureTimingStats();
+	liveDev->getCaptureTimingStats(timingStats);
+	PTF_ASSERT_EQUAL(timingStats.threadCount, 1);
+	PTF_ASSERT_EQUAL(timingStats.callbackDurationNs.getCount(), 0);
+	PTF_ASSERT_EQUAL(timingStats.captureThreadCpuTimeNs, 0);
+	liveDev->setCaptureTimingEnabled(false);
+}  // TestPcapLiveDeviceCaptureTiming
+
 PTF_TEST_CASE(TestPcapLiveDeviceBlockingModeWithLambda)
 {
 	auto packetArrivesBlockingModeNoTimeoutLambda = [](pcpp::RawPacket* rawPacket, pcpp::PcapLiveDevice* dev,
@@ -0,0 +1,260 @@
+#include "../TestDefinition.h"
+
+#include "LockFreeRing.h"
+#include "Logger.h"
+#include "PacketPipeline.h"
+#include "RawPacket.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+PTF_TEST_CASE(TestSpscRing)
+{
+	{
+		pcpp::Logger::getInstance().suppressLogs();
+		pcpp::SpscRing<int> invalidRing(0);
+		pcpp::Logger::getInstance().enableLogs();
+		PTF_ASSERT_FALSE(invalidRing.isValid());
+		PTF_ASSERT_EQUAL(invalidRing.capacity(), 0);
+		int item = 1;
+		PTF_ASSERT_FALSE(invalidRing.push(item));
+		PTF_ASSERT_FALSE(invalidRing.pop(item));
+	}
+
+	{
+		pcpp::SpscRing<int> ring(5);
+		PTF_ASSERT_EQUAL(ring.capacity(), 8);
+		PTF_ASSERT_TRUE(ring.isEmpty());
+
+		int item = 0;
+		PTF_ASSERT_FALSE(ring.pop(item));
+
+		for (int i = 0; i < 8; i++)
+			PTF_ASSERT_TRUE(ring.push(i));
+		PTF_ASSERT_FALSE(ring.push(8));
+		PTF_ASSERT_EQUAL(ring.size(), 8);
+
+		PTF_ASSERT_TRUE(ring.pop(item));
+		PTF_ASSERT_EQUAL(item, 0);
+
+		// a batch is truncated to the free slots and wraps around the end of the buffer
+		int batch[4] = { 100, 101, 102, 103 };
+		PTF_ASSERT_EQUAL(ring.pushBatch(batch, 4), 1);
+
+		int popped[16];
+		PTF_ASSERT_EQUAL(ring.popBatch(popped, 16), 8);
+		for (int i = 0; i < 7; i++)
+			PTF_ASSERT_EQUAL(popped[i], i + 1);
+		PTF_ASSERT_EQUAL(popped[7], 100);
+		PTF_ASSERT_TRUE(ring.isEmpty());
+		PTF_ASSERT_EQUAL(ring.popBatch(popped, 16), 0);
+	}
+
+	{
+		// concurrent handoff of RawPacket pointers keeps the push order
+		const int packetCount = 100000;
+		std::vector<pcpp::RawPacket> packets(16);
+		pcpp::SpscRing<pcpp::RawPacket*> ring(64);
+		int outOfOrderCount = 0;
+
+		std::thread consumer([&]() {
+			pcpp::RawPacket* batch[32];
+			int expected = 0;
+			while (expected < packetCount)
+			{
+				std::size_t count = ring.popBatch(batch, 32);
+				for (std::size_t i = 0; i < count; i++, expected++)
+				{
+					if (batch[i] != &packets[expected % packets.size()])
+						outOfOrderCount++;
+				}
+			}
+		});
+
+		for (int i = 0; i < packetCount;)
+		{
+			if (ring.push(&packets[i % packets.size()]))
+				i++;
+		}
+
+		consumer.join();
+		PTF_ASSERT_EQUAL(outOfOrderCount, 0);
+		PTF_ASSERT_TRUE(ring.isEmpty());
+	}
+}  // TestSpscRing
+
+PTF_TEST_CASE(TestMpmcRing)
+{
+	{
+		pcpp::Logger::getInstance().suppressLogs();
+		pcpp::MpmcRing<int> invalidRing(0);
+		pcpp::Logger::getInstance().enableLogs();
+		PTF_ASSERT_FALSE(invalidRing.isValid());
+		PTF_ASSERT_EQUAL(invalidRing.capacity(), 0);
+		int item = 1;
+		PTF_ASSERT_FALSE(invalidRing.push(item));
+		PTF_ASSERT_FALSE(invalidRing.pop(item));
+	}
+
+	{
+		pcpp::MpmcRing<int> ring(4);
+		PTF_ASSERT_EQUAL(ring.capacity(), 4);
+
+		int batch[6] = { 0, 1, 2, 3, 4, 5 };
+		PTF_ASSERT_EQUAL(ring.pushBatch(batch, 6), 4);
+		PTF_ASSERT_FALSE(ring.push(6));
+		PTF_ASSERT_EQUAL(ring.size(), 4);
+
+		int popped[6];
+		PTF_ASSERT_EQUAL(ring.popBatch(popped, 3), 3);
+		for (int i = 0; i < 3; i++)
+			PTF_ASSERT_EQUAL(popped[i], i);
+
+		PTF_ASSERT_EQUAL(ring.pushBatch(batch + 4, 2), 2);
+		PTF_ASSERT_EQUAL(ring.popBatch(popped, 6), 3);
+		PTF_ASSERT_EQUAL(popped[0], 3);
+		PTF_ASSERT_EQUAL(popped[1], 4);
+		PTF_ASSERT_EQUAL(popped[2], 5);
+		PTF_ASSERT_TRUE(ring.isEmpty());
+	}
+
+	{
+		// every element pushed by several producers is popped exactly once by several consumers
+		const int producerCount = 3;
+		const int consumerCount = 3;
+		const int itemsPerProducer = 50000;
+		pcpp::MpmcRing<int> ring(128);
+		std::vector<std::atomic<int>> seen(producerCount * itemsPerProducer);
+		for (auto& counter : seen)
+			counter = 0;
+		std::atomic<int> poppedCount(0);
+
+		std::vector<std::thread> threads;
+		for (int p = 0; p < producerCount; p++)
+		{
+			threads.emplace_back([&, p]() {
+				int batch[8];
+				for (int i = 0; i < itemsPerProducer;)
+				{
+					int batchSize = std::min(8, itemsPerProducer - i);
+					for (int j = 0; j < batchSize; j++)
+						batch[j] = p * itemsPerProducer + i + j;
+					i += static_cast<int>(ring.pushBatch(batch, batchSize));
+				}
+			});
+		}
+
+		for (int c = 0; c < consumerCount; c++)
+		{
+			threads.emplace_back([&]() {
+				int batch[8];
+				while (poppedCount < producerCount * itemsPerProducer)
+				{
+					std::size_t count = ring.popBatch(batch, 8);
+					for (std::size_t i = 0; i < count; i++)
+						seen[batch[i]]++;
+					poppedCount += static_cast<int>(count);
+				}
+			});
+		}
+
+		for (auto& thread : threads)
+			thread.join();
+
+		int wrongCount = 0;
+		for (auto& counter : seen)
+		{
+			if (counter != 1)
+				wrongCount++;
+		}
+
+		PTF_ASSERT_EQUAL(wrongCount, 0);
+		PTF_ASSERT_TRUE(ring.isEmpty());
+	}
+}  // TestMpmcRing
+
+PTF_TEST_CASE(TestPacketPipeline)
+{
+	using Pipeline = pcpp::PacketPipeline<pcpp::RawPacket*>;
+
+	auto nullCallback = [](pcpp::RawPacket** items, std::size_t count, uint32_t workerIndex) {};
+	{
+		pcpp::Logger::getInstance().suppressLogs();
+		Pipeline noWorkersPipeline(0, 16, nullCallback);
+		Pipeline noCallbackPipeline(2, 16, nullptr);
+		Pipeline noRingPipeline(2, 0, nullCallback);
+		pcpp::Logger::getInstance().enableLogs();
+		PTF_ASSERT_FALSE(noWorkersPipeline.isValid());
+		PTF_ASSERT_FALSE(noCallbackPipeline.isValid());
+		PTF_ASSERT_FALSE(noRingPipeline.isValid());
+		PTF_ASSERT_EQUAL(noRingPipeline.getWorkerCount(), 0);
+		PTF_ASSERT_FALSE(noRingPipeline.start());
+		PTF_ASSERT_FALSE(noRingPipeline.push(nullptr));
+	}
+
+	std::vector<pcpp::RawPacket> packets(1000);
+
+	{
+		// every packet reaches the worker it was pushed to, in order
+		const uint32_t workerCount = 4;
+		std::vector<std::vector<pcpp::RawPacket*>> received(workerCount);
+		std::atomic<int> wrongWorkerCount(0);
+		Pipeline pipeline(workerCount, 8, [&](pcpp::RawPacket** items, std::size_t count, uint32_t workerIndex) {
+			for (std::size_t i = 0; i < count; i++)
+			{
+				if ((items[i] - packets.data()) % workerCount != workerIndex)
+					wrongWorkerCount++;
+				received[workerIndex].push_back(items[i]);
+			}
+		});
+
+		PTF_ASSERT_FALSE(pipeline.push(&packets[0]));
+		PTF_ASSERT_TRUE(pipeline.start());
+		PTF_ASSERT_FALSE(pipeline.start());
+		PTF_ASSERT_TRUE(pipeline.isRunning());
+
+		for (std::size_t i = 0; i < packets.size(); i++)
+			PTF_ASSERT_TRUE(pipeline.push(&packets[i], static_cast<uint32_t>(i)));
+
+		pipeline.stop();
+		PTF_ASSERT_FALSE(pipeline.isRunning());
+		PTF_ASSERT_EQUAL(wrongWorkerCount.load(), 0);
+		PTF_ASSERT_EQUAL(pipeline.getDroppedCount(), 0);
+
+		for (uint32_t w = 0; w < workerCount; w++)
+		{
+			PTF_ASSERT_EQUAL(received[w].size(), packets.size() / workerCount);
+			PTF_ASSERT_EQUAL(pipeline.getProcessedCount(w), packets.size() / workerCount);
+			for (std::size_t i = 0; i < received[w].size(); i++)
+				PTF_ASSERT_EQUAL(received[w][i], &packets[i * workerCount + w]);
+		}
+	}
+
+	{
+		// with DropWhenFull a stalled worker makes the pushes fail instead of blocking the producer
+		std::atomic<bool> release(false);
+		std::atomic<int> processed(0);
+		Pipeline pipeline(
+		    1, 4,
+		    [&](pcpp::RawPacket** items, std::size_t count, uint32_t workerIndex) {
+			    while (!release)
+				    std::this_thread::yield();
+			    processed += static_cast<int>(count);
+		    },
+		    Pipeline::DropWhenFull, 1);
+
+		PTF_ASSERT_TRUE(pipeline.start());
+		int pushed = 0;
+		for (int i = 0; i < 100; i++)
+		{
+			if (pipeline.push(&packets[i]))
+				pushed++;
+		}
+
+		release = true;
+		pipeline.stop();
+		PTF_ASSERT_LOWER_THAN(pushed, 100);
+		PTF_ASSERT_EQUAL(pipeline.getDroppedCount(), static_cast<uint64_t>(100 - pushed));
+		PTF_ASSERT_EQUAL(processed.load(), pushed);
+	}
+}  // TestPacketPipeline
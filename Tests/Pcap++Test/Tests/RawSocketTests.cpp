@@ -5,6 +5,7 @@
 #include "Packet.h"
 #include "RawSocketDevice.h"
 #include "PcapFileDevice.h"
+#include <chrono>
 
 extern PcapTestArgs PcapTestGlobalArgs;
 
@@ -159,3 +160,219 @@ PTF_TEST_CASE(TestRawSockets)
 		pcpp::Logger::getInstance().enableLogs();
 	}
 }  // TestRawSockets
+
+static void rxRingPacketsArrive(pcpp::RawPacket packets[], uint32_t packetCount, pcpp::RawSocketDevice* device,
+                                void* userCookie)
+{
+	(void)device;
+	int* ethPacketCount = static_cast<int*>(userCookie);
+	for (uint32_t i = 0; i < packetCount; i++)
+	{
+		pcpp::Packet parsedPacket(&packets[i]);
+		if (parsedPacket.isPacketOfType(pcpp::Ethernet))
+			(*ethPacketCount)++;
+	}
+}
+
+PTF_TEST_CASE(TestRawSocketsRxRing)
+{
+	pcpp::IPAddress ipAddr = pcpp::IPAddress(PcapTestGlobalArgs.ipToSendReceivePackets);
+	pcpp::RawSocketDevice rawSock(ipAddr);
+	pcpp::RawSocketDevice::RxRingConfiguration rxRingConfig;
+
+#if !defined(__linux__)
+	pcpp::Logger::getInstance().suppressLogs();
+	PTF_ASSERT_FALSE(rawSock.open(rxRingConfig));
+	PTF_ASSERT_FALSE(rawSock.isRxRingEnabled());
+	pcpp::Logger::getInstance().enableLogs();
+	PTF_TEST_CASE_PASSED;
+#endif
+
+	// invalid block size
+	pcpp::Logger::getInstance().suppressLogs();
+	PTF_ASSERT_FALSE(rawSock.open(pcpp::RawSocketDevice::RxRingConfiguration(1000)));
+	PTF_ASSERT_FALSE(rawSock.isOpened());
+	pcpp::Logger::getInstance().enableLogs();
+
+	PTF_ASSERT_TRUE(rawSock.open(rxRingConfig));
+	PTF_ASSERT_TRUE(rawSock.isRxRingEnabled());
+
+	// generate traffic from another socket so the test doesn't depend on the traffic on the interface
+	pcpp::RawSocketDevice senderSock(ipAddr);
+	PTF_ASSERT_TRUE(senderSock.open());
+	PTF_ASSERT_FALSE(senderSock.isRxRingEnabled());
+
+	pcpp::PcapFileReaderDevice readerDev(EXAMPLE2_PCAP_PATH);
+	PTF_ASSERT_TRUE(readerDev.open());
+	pcpp::RawPacketVector packetVec;
+	readerDev.getNextPackets(packetVec, 100);
+	PTF_ASSERT_EQUAL(senderSock.sendPackets(packetVec), (int)packetVec.size());
+
+	// receive single packets from the ring
+	for (int i = 0; i < 4; i++)
+	{
+		pcpp::RawPacket rawPacket;
+		PTF_ASSERT_EQUAL(rawSock.receivePacket(rawPacket, true, 20), pcpp::RawSocketDevice::RecvSuccess, enum);
+		PTF_ASSERT_GREATER_OR_EQUAL_THAN(rawPacket.getFrameLength(), rawPacket.getRawDataLen());
+		pcpp::Packet parsedPacket(&rawPacket);
+		PTF_ASSERT_TRUE(parsedPacket.isPacketOfType(pcpp::Ethernet));
+	}
+
+	// receive whole blocks
+	PTF_ASSERT_EQUAL(senderSock.sendPackets(packetVec), (int)packetVec.size());
+	int ethPacketCount = 0;
+	PTF_ASSERT_EQUAL(rawSock.receiveBlock(rxRingPacketsArrive, &ethPacketCount, 20000),
+	                 pcpp::RawSocketDevice::RecvSuccess, enum);
+	PTF_ASSERT_GREATER_THAN(ethPacketCount, 0);
+
+	// drain the ring, then receiving non-blocking should eventually return RecvWouldBlock
+	pcpp::RawSocketDevice::RecvPacketResult res = pcpp::RawSocketDevice::RecvSuccess;
+	for (int i = 0; i < 10000 && res == pcpp::RawSocketDevice::RecvSuccess; i++)
+		res = rawSock.receiveBlock(rxRingPacketsArrive, &ethPacketCount, 0);
+	PTF_NON_CRITICAL_EQUAL(res, pcpp::RawSocketDevice::RecvWouldBlock, enum);
+
+	rawSock.close();
+	PTF_ASSERT_FALSE(rawSock.isRxRingEnabled());
+	pcpp::Logger::getInstance().suppressLogs();
+	PTF_ASSERT_EQUAL(rawSock.receiveBlock(rxRingPacketsArrive, &ethPacketCount, 0),
+	                 pcpp::RawSocketDevice::RecvError, enum);
+	pcpp::Logger::getInstance().enableLogs();
+
+	// two sockets in the same fanout group share the traffic
+	pcpp::RawSocketDevice::RxRingConfiguration fanoutConfig;
+	fanoutConfig.fanoutGroupId = 4242;
+	fanoutConfig.fanoutMode = pcpp::RawSocketDevice::RxRingConfiguration::FanoutLoadBalance;
+	pcpp::RawSocketDevice fanoutSock1(ipAddr);
+	pcpp::RawSocketDevice fanoutSock2(ipAddr);
+	PTF_ASSERT_TRUE(fanoutSock1.open(fanoutConfig));
+	PTF_ASSERT_TRUE(fanoutSock2.open(fanoutConfig));
+
+	PTF_ASSERT_EQUAL(senderSock.sendPackets(packetVec), (int)packetVec.size());
+	int fanoutPacketCount1 = 0;
+	int fanoutPacketCount2 = 0;
+	PTF_ASSERT_EQUAL(fanoutSock1.receiveBlock(rxRingPacketsArrive, &fanoutPacketCount1, 20000),
+	                 pcpp::RawSocketDevice::RecvSuccess, enum);
+	PTF_ASSERT_EQUAL(fanoutSock2.receiveBlock(rxRingPacketsArrive, &fanoutPacketCount2, 20000),
+	                 pcpp::RawSocketDevice::RecvSuccess, enum);
+	PTF_ASSERT_GREATER_THAN(fanoutPacketCount1, 0);
+	PTF_ASSERT_GREATER_THAN(fanoutPacketCount2, 0);
+}  // TestRawSocketsRxRing
+
+static void txBatchSent(uint32_t batchPacketCount, uint32_t sentPacketCount, pcpp::RawSocketDevice* device,
+                        void* userCookie)
+{
+	(void)device;
+	(void)sentPacketCount;
+	int* packetCount = static_cast<int*>(userCookie);
+	*packetCount += static_cast<int>(batchPacketCount);
+}
+
+PTF_TEST_CASE(TestRawSocketsBatchedSend)
+{
+	pcpp::IPAddress ipAddr = pcpp::IPAddress(PcapTestGlobalArgs.ipToSendReceivePackets);
+	pcpp::RawSocketDevice rawSock(ipAddr);
+
+#if !defined(__linux__)
+	pcpp::Logger::getInstance().suppressLogs();
+	pcpp::RawPacket rawPacket;
+	PTF_ASSERT_EQUAL(rawSock.sendPackets(&rawPacket, 1), 0);
+	PTF_ASSERT_FALSE(rawSock.setTxConfiguration(pcpp::RawSocketDevice::TxConfiguration()));
+	pcpp::Logger::getInstance().enableLogs();
+	PTF_TEST_CASE_PASSED;
+#endif
+
+	pcpp::PcapFileReaderDevice readerDev(EXAMPLE2_PCAP_PATH);
+	PTF_ASSERT_TRUE(readerDev.open());
+	pcpp::RawPacketVector packetVec;
+	readerDev.getNextPackets(packetVec, 100);
+	PTF_ASSERT_EQUAL(packetVec.size(), 100);
+
+	// raw sockets only send Ethernet packets
+	std::vector<pcpp::RawPacket> packetArr;
+	for (const auto& rawPacket : packetVec)
+	{
+		pcpp::Packet parsedPacket(rawPacket);
+		if (parsedPacket.isPacketOfType(pcpp::Ethernet))
+			packetArr.push_back(*rawPacket);
+	}
+	int ethPacketCount = (int)packetArr.size();
+	PTF_ASSERT_GREATER_THAN(ethPacketCount, 0);
+
+	// a non-Ethernet packet is counted as failed and doesn't stop the batch
+	pcpp::RawPacket nonEthPacket(packetArr[0].getRawData(), 10, packetArr[0].getPacketTimeStamp(), false);
+	packetArr.push_back(nonEthPacket);
+
+	pcpp::Logger::getInstance().suppressLogs();
+	PTF_ASSERT_EQUAL(rawSock.sendPackets(packetArr.data(), (int)packetArr.size()), 0);
+	PTF_ASSERT_FALSE(rawSock.setTxConfiguration(pcpp::RawSocketDevice::TxConfiguration()));
+	pcpp::Logger::getInstance().enableLogs();
+
+	PTF_ASSERT_TRUE(rawSock.open());
+	PTF_ASSERT_FALSE(rawSock.isTxRingEnabled());
+
+	// the modes to compare: default sendmmsg() batches, batches of 1 packet, large batches and the TX ring
+	std::vector<pcpp::RawSocketDevice::TxConfiguration> txConfigs = {
+		pcpp::RawSocketDevice::TxConfiguration(), pcpp::RawSocketDevice::TxConfiguration(1),
+		pcpp::RawSocketDevice::TxConfiguration(256), pcpp::RawSocketDevice::TxConfiguration(64, true, 2048, 256)
+	};
+
+	const int rounds = 200;
+	for (auto& txConfig : txConfigs)
+	{
+		pcpp::RawSocketDevice txSock(ipAddr);
+		PTF_ASSERT_TRUE(txSock.open());
+		int callbackPacketCount = 0;
+		txConfig.onBatchSent = txBatchSent;
+		txConfig.onBatchSentUserCookie = &callbackPacketCount;
+		PTF_ASSERT_TRUE(txSock.setTxConfiguration(txConfig));
+		PTF_ASSERT_EQUAL(txSock.isTxRingEnabled(), txConfig.useTxRing);
+
+		auto start = std::chrono::steady_clock::now();
+		int sentCount = 0;
+		for (int i = 0; i < rounds; i++)
+			sentCount += txSock.sendPackets(packetArr.data(), (int)packetArr.size());
+		double elapsedSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		PTF_PRINT_VERBOSE("Batch size " << txConfig.batchSize << ", TX ring " << txConfig.useTxRing << ": "
+		                                << (elapsedSec > 0 ? sentCount / elapsedSec : 0) << " packets/sec");
+
+		const pcpp::RawSocketDevice::TxStats& txStats = txSock.getTxStats();
+		PTF_ASSERT_EQUAL(sentCount, ethPacketCount * rounds);
+		PTF_ASSERT_EQUAL(txStats.packetsSent, (uint64_t)sentCount);
+		PTF_ASSERT_EQUAL(txStats.packetsFailed, (uint64_t)rounds);
+		PTF_ASSERT_EQUAL(txStats.partialBatches, 0);
+		PTF_ASSERT_GREATER_THAN(txStats.bytesSent, txStats.packetsSent);
+		PTF_ASSERT_EQUAL(callbackPacketCount, sentCount);
+
+		// the vector overload uses the same path
+		PTF_ASSERT_EQUAL(txSock.sendPackets(packetVec), ethPacketCount);
+		PTF_ASSERT_EQUAL(txSock.getTxStats().packetsSent, (uint64_t)(sentCount + ethPacketCount));
+
+		// a single packet is sent through the TX ring if it's used
+		PTF_ASSERT_TRUE(txSock.sendPacket(packetVec.at(0)));
+
+		txSock.resetTxStats();
+		PTF_ASSERT_EQUAL(txSock.getTxStats().packetsSent, 0);
+	}
+
+	// packets larger than a TX ring frame aren't sent
+	pcpp::RawSocketDevice ringSock(ipAddr);
+	PTF_ASSERT_TRUE(ringSock.open());
+	pcpp::RawSocketDevice::TxConfiguration smallFrames(0, true, 128, 64);
+	PTF_ASSERT_TRUE(ringSock.setTxConfiguration(smallFrames));
+	int ringSentCount = ringSock.sendPackets(packetArr.data(), (int)packetArr.size());
+	PTF_ASSERT_LOWER_THAN(ringSentCount, ethPacketCount);
+	PTF_ASSERT_EQUAL(ringSock.getTxStats().packetsSent, (uint64_t)ringSentCount);
+	PTF_ASSERT_EQUAL(ringSock.getTxStats().packetsSent + ringSock.getTxStats().packetsFailed, packetArr.size());
+
+	// invalid configurations
+	pcpp::Logger::getInstance().suppressLogs();
+	PTF_ASSERT_FALSE(ringSock.setTxConfiguration(pcpp::RawSocketDevice::TxConfiguration()));
+	pcpp::RawSocketDevice badRingSock(ipAddr);
+	PTF_ASSERT_TRUE(badRingSock.open());
+	PTF_ASSERT_FALSE(badRingSock.setTxConfiguration(pcpp::RawSocketDevice::TxConfiguration(0, true, 1000)));
+	pcpp::RawSocketDevice rxRingSock(ipAddr);
+	PTF_ASSERT_TRUE(rxRingSock.open(pcpp::RawSocketDevice::RxRingConfiguration()));
+	PTF_ASSERT_FALSE(rxRingSock.setTxConfiguration(pcpp::RawSocketDevice::TxConfiguration(0, true)));
+	pcpp::Logger::getInstance().enableLogs();
+}  // TestRawSocketsBatchedSend
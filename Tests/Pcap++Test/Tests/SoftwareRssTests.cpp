@@ -0,0 +1,322 @@
+#include "../TestDefinition.h"
+#include "EndianPortable.h"
+#include "EthLayer.h"
+#include "VlanLayer.h"
+#include "IPv4Layer.h"
+#include "IPv6Layer.h"
+#include "TcpLayer.h"
+#include "UdpLayer.h"
+#include "GreLayer.h"
+#include "VxlanLayer.h"
+#include "ArpLayer.h"
+#include "Packet.h"
+#include "Logger.h"
+#include "SoftwareRss.h"
+#include <string>
+#include <vector>
+
+// the key of the Microsoft RSS verification suite, which NIC datasheets and DPDK's rte_softrss() tests use
+static const uint8_t MicrosoftRssKey[40] = { 0x6d, 0x5a, 0x56, 0xda, 0x25, 0x5b, 0x0e, 0xc2, 0x41, 0x67,
+	                                         0x25, 0x3d, 0x43, 0xa3, 0x8f, 0xb0, 0xd0, 0xca, 0x2b, 0xcb,
+	                                         0xae, 0x7b, 0x30, 0xb4, 0x77, 0xcb, 0x2d, 0xa3, 0x80, 0x30,
+	                                         0xf2, 0x0c, 0x6a, 0x42, 0xb7, 0x3b, 0xbe, 0xac, 0x01, 0xfa };
+
+static pcpp::RawPacket createPacket(const std::vector<pcpp::Layer*>& layers, bool isFragment = false)
+{
+	pcpp::Packet packet(100);
+	for (auto layer : layers)
+		packet.addLayer(layer, true);
+
+	packet.computeCalculateFields();
+	if (isFragment)
+		packet.getLayerOfType<pcpp::IPv4Layer>()->getIPv4Header()->fragmentOffset = htobe16(0x2000);
+
+	return *packet.getRawPacket();
+}
+
+static pcpp::RawPacket createTcpPacket(const std::string& srcIP, const std::string& dstIP, uint16_t srcPort,
+                                       uint16_t dstPort, bool isFragment = false)
+{
+	pcpp::Layer* networkLayer;
+	if (pcpp::IPAddress(srcIP).isIPv4())
+		networkLayer = new pcpp::IPv4Layer(pcpp::IPv4Address(srcIP), pcpp::IPv4Address(dstIP));
+	else
+		networkLayer = new pcpp::IPv6Layer(pcpp::IPv6Address(srcIP), pcpp::IPv6Address(dstIP));
+
+	return createPacket({ new pcpp::EthLayer(pcpp::MacAddress("00:11:22:33:44:55"),
+	                                         pcpp::MacAddress("66:77:88:99:aa:bb")),
+	                      networkLayer, new pcpp::TcpLayer(srcPort, dstPort) },
+	                    isFragment);
+}
+
+PTF_TEST_CASE(TestRssHasher)
+{
+	{
+		pcpp::Logger::getInstance().suppressLogs();
+		pcpp::RssHasher shortKeyHasher(MicrosoftRssKey, 39);
+		pcpp::Logger::getInstance().enableLogs();
+		PTF_ASSERT_FALSE(shortKeyHasher.isValid());
+		uint8_t input[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+		PTF_ASSERT_EQUAL(shortKeyHasher.toeplitzHash(input, sizeof(input)), 0);
+	}
+
+	// the IPv4 and IPv6 vectors of the Microsoft RSS verification suite: hash on addresses and on addresses + ports
+	struct RssTestVector
+	{
+		std::string srcIP;
+		std::string dstIP;
+		uint16_t srcPort;
+		uint16_t dstPort;
+		uint32_t addressHash;
+		uint32_t addressAndPortHash;
+	};
+
+	std::vector<RssTestVector> testVectors = {
+		{ "66.9.149.187", "161.142.100.80", 2794, 1766, 0x323e8fc2, 0x51ccc178 },
+		{ "199.92.111.2", "65.69.140.83", 14230, 4739, 0xd718262a, 0xc626b0ea },
+		{ "24.19.198.95", "12.22.207.184", 12898, 38024, 0xd2d0a5de, 0x5c2b394a },
+		{ "38.27.205.30", "209.142.163.6", 48228, 2217, 0x82989176, 0xafc7327f },
+		{ "153.39.163.191", "202.188.127.2", 44251, 1303, 0x5d1809c5, 0x10e828a2 },
+		{ "3ffe:2501:200:1fff::7", "3ffe:2501:200:3::1", 2794, 1766, 0x2cc18cd5, 0x40207d3d },
+		{ "3ffe:501:8::260:97ff:fe40:efab", "ff02::1", 14230, 4739, 0x0f0c461c, 0xdde51bbf },
+		{ "3ffe:1900:4545:3:200:f8ff:fe21:67cf", "fe80::200:f8ff:fe21:67cf", 44251, 38024, 0x4b61e985, 0x02d1feef }
+	};
+
+	uint64_t tcpHashTypes = pcpp::RssHasher::NonFragIPv4Tcp | pcpp::RssHasher::NonFragIPv6Tcp;
+	pcpp::RssHasher addressHasher(MicrosoftRssKey, 40, pcpp::RssHasher::IPv4 | pcpp::RssHasher::IPv6);
+	pcpp::RssHasher portHasher(MicrosoftRssKey, 40, tcpHashTypes);
+
+	for (const auto& testVector : testVectors)
+	{
+		pcpp::RawPacket rawPacket =
+		    createTcpPacket(testVector.srcIP, testVector.dstIP, testVector.srcPort, testVector.dstPort);
+		PTF_ASSERT_EQUAL(addressHasher.hash(&rawPacket), testVector.addressHash);
+		PTF_ASSERT_EQUAL(portHasher.hash(&rawPacket), testVector.addressAndPortHash);
+	}
+
+	// the raw Toeplitz hash of a tuple built by the caller
+	{
+		uint8_t input[12] = { 66, 9, 149, 187, 161, 142, 100, 80, 0x0a, 0xea, 0x06, 0xe6 };
+		PTF_ASSERT_EQUAL(portHasher.toeplitzHash(input, 8), 0x323e8fc2);
+		PTF_ASSERT_EQUAL(portHasher.toeplitzHash(input, 12), 0x51ccc178);
+		PTF_ASSERT_EQUAL(portHasher.toeplitzHash(input, pcpp::RssHasher::MaxInputLength + 1), 0);
+	}
+
+	pcpp::RawPacket tcpPacket = createTcpPacket("66.9.149.187", "161.142.100.80", 2794, 1766);
+	pcpp::RawPacket reverseTcpPacket = createTcpPacket("161.142.100.80", "66.9.149.187", 1766, 2794);
+
+	// packet types not in the mask aren't hashed, and only L4 types in the mask are hashed on ports
+	{
+		pcpp::RssHasher udpHasher(MicrosoftRssKey, 40, pcpp::RssHasher::NonFragIPv4Udp);
+		PTF_ASSERT_EQUAL(udpHasher.hash(&tcpPacket), 0);
+
+		pcpp::RssHasher otherHasher(MicrosoftRssKey, 40, pcpp::RssHasher::NonFragIPv4Other);
+		PTF_ASSERT_EQUAL(otherHasher.hash(&tcpPacket), 0);
+
+		pcpp::RssHasher mixedHasher(MicrosoftRssKey, 40, pcpp::RssHasher::NonFragIPv4Udp | pcpp::RssHasher::IPv4);
+		PTF_ASSERT_EQUAL(mixedHasher.hash(&tcpPacket), 0x323e8fc2);
+
+		pcpp::RawPacket fragment = createTcpPacket("66.9.149.187", "161.142.100.80", 2794, 1766, true);
+		PTF_ASSERT_EQUAL(portHasher.hash(&fragment), 0);
+		pcpp::RssHasher fragmentHasher(MicrosoftRssKey, 40, tcpHashTypes | pcpp::RssHasher::FragIPv4);
+		PTF_ASSERT_EQUAL(fragmentHasher.hash(&fragment), 0x323e8fc2);
+
+		pcpp::RawPacket arpPacket =
+		    createPacket({ new pcpp::EthLayer(pcpp::MacAddress("00:11:22:33:44:55"), pcpp::MacAddress::Broadcast),
+		                   new pcpp::ArpLayer(pcpp::ArpRequest(pcpp::MacAddress("00:11:22:33:44:55"),
+		                                                       pcpp::IPv4Address("10.0.0.1"),
+		                                                       pcpp::IPv4Address("10.0.0.2"))) });
+		PTF_ASSERT_EQUAL(portHasher.hash(&arpPacket), 0);
+	}
+
+	// VLAN tags are skipped
+	{
+		pcpp::RawPacket vlanPacket =
+		    createPacket({ new pcpp::EthLayer(pcpp::MacAddress("00:11:22:33:44:55"),
+		                                      pcpp::MacAddress("66:77:88:99:aa:bb")),
+		                   new pcpp::VlanLayer(100, false, 0), new pcpp::VlanLayer(200, false, 0),
+		                   new pcpp::IPv4Layer(pcpp::IPv4Address("66.9.149.187"), pcpp::IPv4Address("161.142.100.80")),
+		                   new pcpp::TcpLayer(2794, 1766) });
+		PTF_ASSERT_EQUAL(portHasher.hash(&vlanPacket), 0x51ccc178);
+	}
+
+	// the default key is the symmetric key DpdkDevice uses, so both directions of a flow get the same hash
+	{
+		pcpp::RssHasher defaultHasher(nullptr, 0, tcpHashTypes);
+		PTF_ASSERT_EQUAL(defaultHasher.getKey()[0], 0x6d);
+		PTF_ASSERT_EQUAL(defaultHasher.getKey()[1], 0x5a);
+		PTF_ASSERT_EQUAL(defaultHasher.hash(&tcpPacket), defaultHasher.hash(&reverseTcpPacket));
+		PTF_ASSERT_NOT_EQUAL(portHasher.hash(&tcpPacket), portHasher.hash(&reverseTcpPacket));
+	}
+
+	// symmetric hash functions make any key symmetric
+	{
+		pcpp::RssHasher xorHasher(MicrosoftRssKey, 40, tcpHashTypes, pcpp::RssHasher::SymmetricToeplitz);
+		PTF_ASSERT_EQUAL(xorHasher.hash(&tcpPacket), xorHasher.hash(&reverseTcpPacket));
+		uint8_t xorInput[12] = { 66 ^ 161, 9 ^ 142, 149 ^ 100, 187 ^ 80, 66 ^ 161,   9 ^ 142,
+			                     149 ^ 100, 187 ^ 80, 0x0a ^ 0x06, 0xea ^ 0xe6, 0x0a ^ 0x06, 0xea ^ 0xe6 };
+		PTF_ASSERT_EQUAL(xorHasher.hash(&tcpPacket), xorHasher.toeplitzHash(xorInput, 12));
+
+		pcpp::RssHasher sortHasher(MicrosoftRssKey, 40, tcpHashTypes, pcpp::RssHasher::SymmetricToeplitzSort);
+		PTF_ASSERT_EQUAL(sortHasher.hash(&tcpPacket), sortHasher.hash(&reverseTcpPacket));
+		uint8_t sortedInput[12] = { 66, 9, 149, 187, 161, 142, 100, 80, 0x06, 0xe6, 0x0a, 0xea };
+		PTF_ASSERT_EQUAL(sortHasher.hash(&tcpPacket), sortHasher.toeplitzHash(sortedInput, 12));
+	}
+
+	// tunnels: the inner headers are hashed only with InnerHeaders
+	{
+		pcpp::RssHasher innerHasher(MicrosoftRssKey, 40, tcpHashTypes | pcpp::RssHasher::NonFragIPv4Udp |
+		                                                     pcpp::RssHasher::IPv4,
+		                            pcpp::RssHasher::Toeplitz, pcpp::RssHasher::InnerHeaders);
+		pcpp::RssHasher outerHasher(MicrosoftRssKey, 40, innerHasher.getHashTypes());
+
+		pcpp::RawPacket vxlanPacket = createPacket(
+		    { new pcpp::EthLayer(pcpp::MacAddress("00:11:22:33:44:55"), pcpp::MacAddress("66:77:88:99:aa:bb")),
+		      new pcpp::IPv4Layer(pcpp::IPv4Address("10.0.0.1"), pcpp::IPv4Address("10.0.0.2")),
+		      new pcpp::UdpLayer(50000, 4789), new pcpp::VxlanLayer(1000),
+		      new pcpp::EthLayer(pcpp::MacAddress("00:11:22:33:44:55"), pcpp::MacAddress("66:77:88:99:aa:bb")),
+		      new pcpp::IPv4Layer(pcpp::IPv4Address("66.9.149.187"), pcpp::IPv4Address("161.142.100.80")),
+		      new pcpp::TcpLayer(2794, 1766) });
+		PTF_ASSERT_EQUAL(innerHasher.hash(&vxlanPacket), 0x51ccc178);
+		PTF_ASSERT_NOT_EQUAL(outerHasher.hash(&vxlanPacket), 0x51ccc178);
+		PTF_ASSERT_NOT_EQUAL(outerHasher.hash(&vxlanPacket), 0);
+
+		pcpp::RawPacket grePacket = createPacket(
+		    { new pcpp::EthLayer(pcpp::MacAddress("00:11:22:33:44:55"), pcpp::MacAddress("66:77:88:99:aa:bb")),
+		      new pcpp::IPv4Layer(pcpp::IPv4Address("10.0.0.1"), pcpp::IPv4Address("10.0.0.2")), new pcpp::GREv0Layer(),
+		      new pcpp::IPv6Layer(pcpp::IPv6Address("3ffe:2501:200:1fff::7"), pcpp::IPv6Address("3ffe:2501:200:3::1")),
+		      new pcpp::TcpLayer(2794, 1766) });
+		PTF_ASSERT_EQUAL(innerHasher.hash(&grePacket), 0x40207d3d);
+		PTF_ASSERT_NOT_EQUAL(outerHasher.hash(&grePacket), 0x40207d3d);
+
+		// a packet without a tunnel is hashed on its outer headers
+		PTF_ASSERT_EQUAL(innerHasher.hash(&tcpPacket), 0x51ccc178);
+	}
+
+	// batch hashing gives the same hashes as hashing each packet
+	{
+		std::vector<pcpp::RawPacket> rawPackets;
+		for (const auto& testVector : testVectors)
+			rawPackets.push_back(
+			    createTcpPacket(testVector.srcIP, testVector.dstIP, testVector.srcPort, testVector.dstPort));
+
+		std::vector<const pcpp::RawPacket*> rawPacketPtrs;
+		for (const auto& rawPacket : rawPackets)
+			rawPacketPtrs.push_back(&rawPacket);
+
+		std::vector<uint32_t> hashes(rawPackets.size());
+		portHasher.hashBatch(rawPacketPtrs.data(), rawPacketPtrs.size(), hashes.data());
+		for (size_t i = 0; i < testVectors.size(); i++)
+			PTF_ASSERT_EQUAL(hashes[i], testVectors[i].addressAndPortHash);
+	}
+}  // TestRssHasher
+
+PTF_TEST_CASE(TestSoftwareRssDispatcher)
+{
+	pcpp::RssHasher hasher(MicrosoftRssKey, 40,
+	                       pcpp::RssHasher::NonFragIPv4Tcp | pcpp::RssHasher::IPv4 | pcpp::RssHasher::IPv6);
+	auto nullCallback = [](pcpp::RawPacket** items, std::size_t count, uint32_t workerIndex) {};
+
+	{
+		pcpp::Logger::getInstance().suppressLogs();
+		pcpp::SoftwareRssDispatcher noWorkersDispatcher(hasher, 0, 16, nullCallback);
+		pcpp::SoftwareRssDispatcher noTableDispatcher(hasher, 2, 16, nullCallback,
+		                                              pcpp::PacketPipeline<pcpp::RawPacket*>::BlockWhenFull, 0);
+		pcpp::SoftwareRssDispatcher invalidHasherDispatcher(pcpp::RssHasher(MicrosoftRssKey, 39), 2, 16,
+		                                                    nullCallback);
+		pcpp::SoftwareRssDispatcher nonPowerOf2TableDispatcher(
+		    hasher, 2, 16, nullCallback, pcpp::PacketPipeline<pcpp::RawPacket*>::BlockWhenFull, 100);
+		pcpp::Logger::getInstance().enableLogs();
+		PTF_ASSERT_FALSE(noWorkersDispatcher.isValid());
+		PTF_ASSERT_FALSE(noTableDispatcher.isValid());
+		PTF_ASSERT_FALSE(nonPowerOf2TableDispatcher.isValid());
+		PTF_ASSERT_FALSE(invalidHasherDispatcher.isValid());
+		PTF_ASSERT_FALSE(noTableDispatcher.start());
+
+		pcpp::RawPacket rawPacket = createTcpPacket("10.0.0.1", "10.0.0.2", 1000, 2000);
+		pcpp::RawPacket* rawPacketPtr = &rawPacket;
+		std::vector<pcpp::RawPacket*> notDispatched;
+		PTF_ASSERT_FALSE(noTableDispatcher.dispatch(rawPacketPtr));
+		PTF_ASSERT_EQUAL(noTableDispatcher.dispatchBatch(&rawPacketPtr, 1, &notDispatched), 0);
+		PTF_ASSERT_EQUAL(notDispatched.size(), 1);
+	}
+
+	// 64 flows, 20 packets each, interleaved
+	const int flowCount = 64;
+	const int packetsPerFlow = 20;
+	std::vector<pcpp::RawPacket> rawPackets;
+	for (int i = 0; i < packetsPerFlow; i++)
+	{
+		for (int flow = 0; flow < flowCount; flow++)
+			rawPackets.push_back(createTcpPacket("10.0.0." + std::to_string(flow + 1), "10.1.0.1",
+			                                     static_cast<uint16_t>(10000 + flow), 80));
+	}
+
+	std::vector<pcpp::RawPacket*> rawPacketPtrs;
+	for (auto& rawPacket : rawPackets)
+		rawPacketPtrs.push_back(&rawPacket);
+
+	const uint32_t workerCount = 4;
+	std::vector<std::vector<pcpp::RawPacket*>> received(workerCount);
+	pcpp::SoftwareRssDispatcher dispatcher(hasher, workerCount, 64,
+	                                       [&](pcpp::RawPacket** items, std::size_t count, uint32_t workerIndex) {
+		                                       received[workerIndex].insert(received[workerIndex].end(), items,
+		                                                                    items + count);
+	                                       });
+
+	// the default redirection table maps entry i to worker i % workerCount, as DPDK fills a port's RETA
+	PTF_ASSERT_EQUAL(dispatcher.getWorkerCount(), workerCount);
+	PTF_ASSERT_EQUAL(dispatcher.getRedirectionTable().size(), pcpp::SoftwareRssDispatcher::DefaultRedirectionTableSize);
+	for (uint32_t hash = 0; hash < 1000; hash++)
+		PTF_ASSERT_EQUAL(dispatcher.getWorkerIndex(hash), (hash & 127) % workerCount);
+
+	pcpp::Logger::getInstance().suppressLogs();
+	PTF_ASSERT_FALSE(dispatcher.setRedirectionTable({}));
+	PTF_ASSERT_FALSE(dispatcher.setRedirectionTable({ 0, 1, 4 }));
+	PTF_ASSERT_FALSE(dispatcher.setRedirectionTable({ 0, 1, 2 }));
+	pcpp::Logger::getInstance().enableLogs();
+
+	// packets can't be dispatched before the workers start
+	std::vector<pcpp::RawPacket*> notDispatched;
+	PTF_ASSERT_FALSE(dispatcher.dispatch(rawPacketPtrs[0]));
+	PTF_ASSERT_EQUAL(dispatcher.dispatchBatch(rawPacketPtrs.data(), 10, &notDispatched), 0);
+	PTF_ASSERT_EQUAL(notDispatched.size(), 10);
+
+	PTF_ASSERT_TRUE(dispatcher.start());
+	pcpp::Logger::getInstance().suppressLogs();
+	PTF_ASSERT_FALSE(dispatcher.setRedirectionTable({ 0, 1 }));
+	pcpp::Logger::getInstance().enableLogs();
+
+	// half of the packets one by one, half in bursts
+	size_t half = rawPacketPtrs.size() / 2;
+	for (size_t i = 0; i < half; i++)
+		PTF_ASSERT_TRUE(dispatcher.dispatch(rawPacketPtrs[i]));
+	PTF_ASSERT_EQUAL(dispatcher.dispatchBatch(rawPacketPtrs.data() + half, rawPacketPtrs.size() - half),
+	                 rawPacketPtrs.size() - half);
+	dispatcher.stop();
+
+	// every packet reached the worker its hash maps to, in the dispatch order
+	size_t receivedCount = 0;
+	for (uint32_t workerIndex = 0; workerIndex < workerCount; workerIndex++)
+	{
+		receivedCount += received[workerIndex].size();
+		pcpp::RawPacket* previous = nullptr;
+		for (auto rawPacket : received[workerIndex])
+		{
+			PTF_ASSERT_EQUAL(dispatcher.getWorkerIndex(hasher.hash(rawPacket)), workerIndex);
+			PTF_ASSERT_TRUE(previous == nullptr || previous < rawPacket);
+			previous = rawPacket;
+		}
+	}
+	PTF_ASSERT_EQUAL(receivedCount, rawPackets.size());
+
+	// a custom redirection table sends every flow to the workers in the table
+	received = std::vector<std::vector<pcpp::RawPacket*>>(workerCount);
+	PTF_ASSERT_TRUE(dispatcher.setRedirectionTable({ 2, 3 }));
+	PTF_ASSERT_TRUE(dispatcher.start());
+	PTF_ASSERT_EQUAL(dispatcher.dispatchBatch(rawPacketPtrs.data(), rawPacketPtrs.size()), rawPacketPtrs.size());
+	dispatcher.stop();
+	PTF_ASSERT_EQUAL(received[0].size(), 0);
+	PTF_ASSERT_EQUAL(received[1].size(), 0);
+	PTF_ASSERT_EQUAL(received[2].size() + received[3].size(), rawPackets.size());
+}  // TestSoftwareRssDispatcher
@@ -5,6 +5,9 @@
 #include "PcapFileDevice.h"
 #include "Packet.h"
 #include "Logger.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
 
 extern PcapTestArgs PcapTestGlobalArgs;
 
@@ -163,11 +166,66 @@ PTF_TEST_CASE(TestXdpDeviceSendPackets)
 	stats = device.getStatistics();
 	PTF_ASSERT_NOT_EQUAL(stats.txSentPackets, stats.txCompletedPackets);
 
+	// build the packets directly in UMEM frames
+	std::vector<pcpp::XdpDevice::XdpTxFrame> frames(packets.size());
+	uint64_t freeFramesBefore = device.getStatistics().umemFreeFrames;
+	PTF_ASSERT_TRUE(device.allocateTxFrames(frames.data(), frames.size()));
+	PTF_ASSERT_LOWER_OR_EQUAL_THAN(device.getStatistics().umemFreeFrames, freeFramesBefore - frames.size());
+	for (size_t i = 0; i < frames.size(); i++)
+	{
+		const pcpp::RawPacket* packet = packets.at(static_cast<int>(i));
+		PTF_ASSERT_GREATER_OR_EQUAL_THAN(frames[i].capacity, packet->getRawDataLen());
+		memcpy(frames[i].data, packet->getRawData(), packet->getRawDataLen());
+		frames[i].length = static_cast<uint16_t>(packet->getRawDataLen());
+	}
+
+	uint64_t sentBytesBefore = device.getStatistics().txSentBytes;
+	PTF_ASSERT_TRUE(device.sendTxFrames(frames.data(), frames.size(), true));
+	stats = device.getStatistics();
+	PTF_ASSERT_EQUAL(stats.txSentPackets, 45);
+	PTF_ASSERT_EQUAL(stats.txSentBytes - sentBytesBefore, 4808);
+
+	// unsent frames are returned to the device
+	freeFramesBefore = device.getStatistics().umemFreeFrames;
+	PTF_ASSERT_TRUE(device.allocateTxFrames(frames.data(), 2));
+	device.freeTxFrames(frames.data(), 2);
+	PTF_ASSERT_GREATER_OR_EQUAL_THAN(device.getStatistics().umemFreeFrames, freeFramesBefore);
+
+	pcpp::Logger::getInstance().suppressLogs();
+	PTF_ASSERT_FALSE(device.allocateTxFrames(frames.data(), 100000));
+	pcpp::Logger::getInstance().enableLogs();
+
 	device.close();
 
 	pcpp::Logger::getInstance().suppressLogs();
 	PTF_ASSERT_FALSE(device.sendPackets(packets));
+	PTF_ASSERT_FALSE(device.allocateTxFrames(frames.data(), 1));
+	pcpp::Logger::getInstance().enableLogs();
+
+	// a batch larger than the TX ring is rejected before copying it, even if the fill ring is larger
+	auto config = pcpp::XdpDevice::XdpDeviceConfiguration();
+	config.txSize = 64;
+	PTF_ASSERT_TRUE(device.open(config));
+	PTF_ASSERT_GREATER_THAN(device.getConfig()->fillRingSize, config.txSize);
+
+	pcpp::RawPacketVector largeBatch;
+	for (uint32_t i = 0; i <= config.txSize; i++)
+	{
+		largeBatch.pushBack(new pcpp::RawPacket(*packets.front()));
+	}
+
+	freeFramesBefore = device.getStatistics().umemFreeFrames;
+	std::vector<pcpp::XdpDevice::XdpTxFrame> largeBatchFrames(largeBatch.size());
+	PTF_ASSERT_TRUE(device.allocateTxFrames(largeBatchFrames.data(), largeBatchFrames.size()));
+	pcpp::Logger::getInstance().suppressLogs();
+	PTF_ASSERT_FALSE(device.sendPackets(largeBatch));
+	PTF_ASSERT_FALSE(device.sendTxFrames(largeBatchFrames.data(), largeBatchFrames.size()));
 	pcpp::Logger::getInstance().enableLogs();
+	stats = device.getStatistics();
+	PTF_ASSERT_EQUAL(stats.txSentPackets, 0);
+	PTF_ASSERT_EQUAL(stats.umemFreeFrames, freeFramesBefore);
+
+	device.close();
 #else
 	PTF_SKIP_TEST("XDP not configured");
 #endif
@@ -215,6 +273,78 @@ PTF_TEST_CASE(TestXdpDeviceNonDefaultConfig)
 #endif
 }  // TestXdpDeviceNonDefaultConfig
 
+PTF_TEST_CASE(TestXdpDeviceReceiveThreads)
+{
+#ifdef USE_XDP
+	std::string devName = getDeviceName();
+	PTF_ASSERT_FALSE(devName.empty());
+	pcpp::XdpDevice device(devName);
+
+	pcpp::Logger::getInstance().suppressLogs();
+	PTF_ASSERT_FALSE(device.startReceiveThreads(nullptr, nullptr));
+	pcpp::Logger::getInstance().enableLogs();
+
+	auto config = pcpp::XdpDevice::XdpDeviceConfiguration();
+	config.queueIds = { 0 };
+	config.sharedUmem = true;
+	config.timestampMode = pcpp::XdpDevice::XdpDeviceConfiguration::PacketTimestamp;
+	config.coreIds = { 0 };
+	PTF_ASSERT_TRUE(device.open(config));
+	PTF_ASSERT_EQUAL(device.getConfig()->queueIds.size(), 1);
+
+	struct ThreadPacketData
+	{
+		std::atomic<int> packetCount{ 0 };
+		std::atomic<int> wrongQueueCount{ 0 };
+	} packetData;
+
+	auto onPacketsArrive = [](pcpp::RawPacket packets[], uint32_t packetCount, uint32_t queueId,
+	                          pcpp::XdpDevice* device, void* userCookie) -> void {
+		auto packetData = static_cast<ThreadPacketData*>(userCookie);
+		if (queueId != 0)
+		{
+			packetData->wrongQueueCount++;
+		}
+		packetData->packetCount += static_cast<int>(packetCount);
+	};
+
+	PTF_ASSERT_TRUE(device.startReceiveThreads(onPacketsArrive, &packetData));
+	PTF_ASSERT_TRUE(device.areReceiveThreadsRunning());
+
+	pcpp::Logger::getInstance().suppressLogs();
+	PTF_ASSERT_FALSE(device.startReceiveThreads(onPacketsArrive, &packetData));
+	PTF_ASSERT_FALSE(device.receivePackets(
+	    [](pcpp::RawPacket packets[], uint32_t packetCount, pcpp::XdpDevice* device, void* userCookie) {}, nullptr));
+	pcpp::Logger::getInstance().enableLogs();
+
+	for (int i = 0; i < 200 && packetData.packetCount < 5; i++)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(100));
+	}
+
+	device.stopReceiveThreads();
+	PTF_ASSERT_FALSE(device.areReceiveThreadsRunning());
+
+	PTF_ASSERT_GREATER_OR_EQUAL_THAN(packetData.packetCount.load(), 5);
+	PTF_ASSERT_EQUAL(packetData.wrongQueueCount.load(), 0);
+
+	auto queueStats = device.getQueueStatistics(0);
+	auto stats = device.getStatistics();
+	PTF_ASSERT_EQUAL(queueStats.rxPackets, static_cast<uint64_t>(packetData.packetCount.load()));
+	PTF_ASSERT_EQUAL(stats.rxPackets, queueStats.rxPackets);
+	PTF_ASSERT_EQUAL(stats.rxRingId, queueStats.rxRingId);
+
+	pcpp::Logger::getInstance().suppressLogs();
+	stats = device.getQueueStatistics(1);
+	PTF_ASSERT_EQUAL(stats.rxPackets, 0);
+	pcpp::Logger::getInstance().enableLogs();
+
+	device.close();
+#else
+	PTF_SKIP_TEST("XDP not configured");
+#endif
+}  // TestXdpDeviceReceiveThreads
+
 PTF_TEST_CASE(TestXdpDeviceInvalidConfig)
 {
 #ifdef USE_XDP
@@ -284,6 +414,19 @@ PTF_TEST_CASE(TestXdpDeviceInvalidConfig)
 
 	PTF_ASSERT_FALSE(device.open(config));
 
+	// Queue IDs aren't unique
+	config = pcpp::XdpDevice::XdpDeviceConfiguration();
+	config.queueIds = { 0, 1, 0 };
+
+	PTF_ASSERT_FALSE(device.open(config));
+
+	// A shared UMEM split between 4 queues has less frames per queue than the ring sizes
+	config = pcpp::XdpDevice::XdpDeviceConfiguration();
+	config.queueIds = { 0, 1, 2, 3 };
+	config.sharedUmem = true;
+
+	PTF_ASSERT_FALSE(device.open(config));
+
 	pcpp::Logger::getInstance().enableLogs();
 #else
 	PTF_SKIP_TEST("XDP not configured");
@@ -212,6 +212,13 @@ int main(int argc, char* argv[])
 
 	PTF_RUN_TEST(TestObjectPool, "no_network");
 
+	PTF_RUN_TEST(TestSpscRing, "no_network;ring;skip_mem_leak_check");
+	PTF_RUN_TEST(TestMpmcRing, "no_network;ring;skip_mem_leak_check");
+	PTF_RUN_TEST(TestPacketPipeline, "no_network;ring;skip_mem_leak_check");
+
+	PTF_RUN_TEST(TestRssHasher, "no_network;rss");
+	PTF_RUN_TEST(TestSoftwareRssDispatcher, "no_network;rss;skip_mem_leak_check");
+
 	PTF_RUN_TEST(TestLogger, "no_network;logger");
 	PTF_RUN_TEST(TestLoggerMultiThread, "no_network;logger;skip_mem_leak_check");
 
@@ -224,6 +231,9 @@ int main(int argc, char* argv[])
 	PTF_RUN_TEST(TestPcapNgFileReadWrite, "no_network;pcap;pcapng");
 	PTF_RUN_TEST(TestPcapNgFileReadWriteAdv, "no_network;pcap;pcapng");
 	PTF_RUN_TEST(TestPcapNgFileTooManyInterfaces, "no_network;pcap;pcapng");
+	PTF_RUN_TEST(TestPcapNgFileWriteBuffered, "no_network;pcap;pcapng");
+	PTF_RUN_TEST(TestPcapNgFileWriteCompressedFrames, "no_network;pcap;pcapng");
+	PTF_RUN_TEST(TestPcapNgFileReadZeroCopy, "no_network;pcap;pcapng");
 	PTF_RUN_TEST(TestPcapNgFilePrecision, "no_network;pcapng");
 	PTF_RUN_TEST(TestPcapFileReadLinkTypeIPv6, "no_network;pcap");
 	PTF_RUN_TEST(TestPcapFileReadLinkTypeIPv4, "no_network;pcap");
@@ -238,6 +248,10 @@ int main(int argc, char* argv[])
 	PTF_RUN_TEST(TestPcapLiveDeviceStatsMode, "live_device");
 	PTF_RUN_TEST(TestPcapLiveDeviceBlockingMode, "live_device");
 	PTF_RUN_TEST(TestPcapLiveDeviceWithLambda, "live_device");
+	PTF_RUN_TEST(TestPcapLiveDeviceBatchMode, "live_device");
+	PTF_RUN_TEST(TestPcapLiveDeviceFanout, "live_device");
+	PTF_RUN_TEST(TestTimingHistogram, "no_network;live_device");
+	PTF_RUN_TEST(TestPcapLiveDeviceCaptureTiming, "live_device");
 	PTF_RUN_TEST(TestPcapLiveDeviceBlockingModeWithLambda, "live_device");
 	PTF_RUN_TEST(TestPcapLiveDeviceSpecialCfg, "live_device");
 	PTF_RUN_TEST(TestWinPcapLiveDevice, "live_device;winpcap");
@@ -251,6 +265,10 @@ int main(int argc, char* argv[])
 	PTF_RUN_TEST(TestPcapFilters_General_BPFStr, "no_network;filters;skip_mem_leak_check");
 	PTF_RUN_TEST(TestPcapFiltersOffline, "no_network;filters");
 	PTF_RUN_TEST(TestPcapFilters_LinkLayer, "no_network;filters;skip_mem_leak_check");
+	PTF_RUN_TEST(TestPcapFilters_Compiled, "no_network;filters;skip_mem_leak_check");
+	PTF_RUN_TEST(TestPcapFilters_ThreadedCode, "no_network;filters;skip_mem_leak_check");
+	PTF_RUN_TEST(TestPcapFilters_Native, "no_network;filters;skip_mem_leak_check");
+	PTF_RUN_TEST(TestPcapFilters_FilterSet, "no_network;filters;skip_mem_leak_check");
 
 	PTF_RUN_TEST(TestHttpRequestParsing, "no_network;http");
 	PTF_RUN_TEST(TestHttpResponseParsing, "no_network;http");
@@ -304,12 +322,15 @@ int main(int argc, char* argv[])
 	PTF_RUN_TEST(TestIPv4MalformedFragment, "no_network;ip_frag");
 
 	PTF_RUN_TEST(TestRawSockets, "raw_sockets");
+	PTF_RUN_TEST(TestRawSocketsRxRing, "raw_sockets");
+	PTF_RUN_TEST(TestRawSocketsBatchedSend, "raw_sockets");
 
 	PTF_RUN_TEST(TestSystemCoreUtils, "no_network;system_utils");
 
 	PTF_RUN_TEST(TestXdpDeviceReceivePackets, "xdp");
 	PTF_RUN_TEST(TestXdpDeviceSendPackets, "xdp");
 	PTF_RUN_TEST(TestXdpDeviceNonDefaultConfig, "xdp");
+	PTF_RUN_TEST(TestXdpDeviceReceiveThreads, "xdp");
 	PTF_RUN_TEST(TestXdpDeviceInvalidConfig, "xdp");
 
 	PTF_END_RUNNING_TESTS;